@@ -112,6 +112,53 @@ typedef enum clblasSide_ {
                                Hermitian or triangular matrix on the right. */
 } clblasSide;
 
+/** Indicates how a vector of a GEMM epilogue is applied to matrix C. */
+typedef enum clblasEpilogueVector_ {
+    clblasEpilogueNone,       /**< The vector is not used. */
+    clblasEpiloguePerRow,     /**< One element per row of C. */
+    clblasEpiloguePerColumn   /**< One element per column of C. */
+} clblasEpilogueVector;
+
+/** Elementwise activation applied by a GEMM epilogue. */
+typedef enum clblasActivation_ {
+    clblasActivationNone,     /**< Identity. */
+    clblasActivationReLU,     /**< max(x, 0). */
+    clblasActivationGELU      /**< x * Phi(x), with the exact normal CDF. */
+} clblasActivation;
+
+/**
+ * @brief Operations fused into the write of matrix C by clblasSgemmEx()
+ *        and clblasDgemmEx().
+ *
+ * Each element of C is computed as
+ * \f$ C_{ij} \leftarrow clamp(act(\alpha s \sum_k op(A)_{ik} op(B)_{kj}
+ *     + \beta C_{ij} + b)) \f$
+ * where \b s and \b b are the elements of the scale and bias vectors for
+ * row \b i or column \b j. Rows and columns refer to C as laid out by the
+ * \b order argument. Vectors are buffer objects with elements of the GEMM
+ * precision and unit increment.
+ */
+typedef struct clblasEpilogue_ {
+    clblasEpilogueVector biasMode;  /**< How the bias vector is applied. */
+    cl_mem bias;                    /**< Bias vector. */
+    size_t offBias;                 /**< Offset of the bias vector in elements. */
+    clblasEpilogueVector scaleMode; /**< How the per-channel alpha scale is applied. */
+    cl_mem scale;                   /**< Scale vector multiplying alpha. */
+    size_t offScale;                /**< Offset of the scale vector in elements. */
+    clblasActivation activation;    /**< Elementwise activation. */
+    cl_bool clamp;                  /**< Clamp results to [clampMin, clampMax]. */
+    cl_double clampMin;             /**< Lower clamping bound. */
+    cl_double clampMax;             /**< Upper clamping bound. */
+} clblasEpilogue;
+
+/**
+ * @brief Element types of the matrices of clblasGemmEx().
+ */
+typedef enum clblasDataType_ {
+    clblasDataHalf,     /**< cl_half, IEEE 754 binary16. */
+    clblasDataFloat     /**< cl_float. */
+} clblasDataType;
+
 /**
  *   @brief clblas error codes definition, incorporating OpenCL error
  *   definitions.
@@ -212,6 +259,131 @@ clblasSetup(void);
 void
 clblasTeardown(void);
 
+/**
+ * @brief Release the internal resources held for an OpenCL context.
+ *
+ * Kernels built for the context, the workspace buffers kept for reuse and
+ * the scratch images created in it are released, so that the context can
+ * be freed once the application releases it. They are otherwise held
+ * until clblasTeardown is called. Later calls on the context rebuild what
+ * they need.
+ *
+ * @param[in] context   The context whose resources are released.
+ *
+ * @note No clblas call may be in progress on the context, and all the
+ *       commands they enqueued must have completed.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasNotInitialized if clblasSetup() was not called;
+ *   - \b clblasInvalidContext if \b context is NULL.
+ *
+ * @ingroup INIT
+ */
+clblasStatus
+clblasReleaseContextResources(cl_context context);
+
+/**
+ * @brief Measure the characteristics of a device.
+ *
+ * Kernels of devices the library has no tuning for are sized after the
+ * cache sizes and the bandwidth measured by microbenchmarks. They take a
+ * while, so they are only run by this function; the library otherwise
+ * uses generic defaults. Call it once per device, after clblasSetup and
+ * before the BLAS calls.
+ *
+ * The profile is kept until clblasTeardown is called. It is also stored
+ * on disk and reused by later runs, with the same device and driver
+ * version, if \b CLBLAS_PROFILE_PATH names a folder for it or the binary
+ * cache is enabled with \b CLBLAS_CACHE_PATH.
+ *
+ * @param[in] device    The device to measure.
+ *
+ * @return
+ *   - \b clblasSuccess on success, or if the device was measured already;
+ *   - \b clblasNotInitialized if clblasSetup() was not called;
+ *   - \b clblasInvalidDevice if \b device is NULL;
+ *   - \b clblasOutOfResources if the measurement failed.
+ *
+ * @ingroup INIT
+ */
+clblasStatus
+clblasProfileDevice(cl_device_id device);
+
+/*@}*/
+
+/**
+ * @defgroup STATISTICS Runtime statistics
+ */
+/*@{*/
+
+/**
+ * @brief Counters of the work done by the library for one function in
+ *        one precision.
+ *
+ * The work done by a call, including the calls of other functions it is
+ * made of, is accounted to the function called. Work done outside of any
+ * call is reported as the function "other".
+ */
+typedef struct clblasStatistics {
+    const char *function;           /**< Precision letter and name of the
+                                         function, e.g. "sgemm" */
+    cl_ulong calls;                 /**< Number of calls */
+    cl_ulong kernelLaunches;        /**< Kernels enqueued */
+    cl_ulong kernelCacheHits;       /**< Generated kernels found in the
+                                         kernel cache */
+    cl_ulong kernelCacheMisses;     /**< Generated kernels not found in the
+                                         kernel cache */
+    cl_ulong binaryCacheHits;       /**< Programs loaded from the binary cache
+                                         or a kernel pack */
+    cl_ulong binaryCacheMisses;     /**< Programs not found there */
+    cl_ulong programBuilds;         /**< Programs built, from source or from
+                                         a binary */
+    cl_double buildMilliseconds;    /**< Total time spent building them */
+    cl_ulong generatorInvocations;  /**< Kernels sources generated */
+    cl_ulong temporaryBytes;        /**< Bytes of device memory allocated
+                                         for temporary buffers */
+    cl_double meanEnqueueMicroseconds; /**< Mean host time of a call, from
+                                            its start until it returns */
+} clblasStatistics;
+
+/**
+ * @brief Get the runtime statistics of the library.
+ *
+ * The counters are kept per thread and summed here, so that they cost no
+ * synchronization while the library runs. They count from the start of the
+ * process, or from the last call to clblasResetStatistics(), and are kept
+ * across clblasTeardown(). Only the functions and precisions with non zero
+ * counters are reported.
+ *
+ * @param[out] stats    Array receiving the counters. May be NULL if
+ *                      \b *count is 0.
+ * @param[in,out] count On input, the number of elements of \b stats;
+ *                      on output, the number of functions and precisions
+ *                      with counters, which may exceed the input value.
+ *                      The strings pointed to by the \b function fields
+ *                      stay valid until the process exits.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if \b count is NULL, or if \b stats is NULL
+ *     and \b *count is not 0.
+ *
+ * @ingroup STATISTICS
+ */
+clblasStatus
+clblasGetStatistics(clblasStatistics *stats, size_t *count);
+
+/**
+ * @brief Reset the runtime statistics to zero.
+ *
+ * @returns always \b clblasSuccess.
+ *
+ * @ingroup STATISTICS
+ */
+clblasStatus
+clblasResetStatistics(void);
+
 /*@}*/
 
 /**
@@ -7638,45 +7810,46 @@ clblasZgemm(
 /*@}*/
 
 /**
- * @defgroup TRMM TRMM - Triangular matrix-matrix multiplication
+ * @defgroup GEMM64 GEMM64 - General matrix-matrix multiplication with 64-bit
+ *                           sizes and offsets
  * @ingroup BLAS3
  */
 /*@{*/
 
 /**
- * @brief Multiplying a matrix by a triangular matrix with float elements.
- *        Extended version.
- *
- * Matrix-triangular matrix products:
- *   - \f$ B \leftarrow \alpha A B \f$
- *   - \f$ B \leftarrow \alpha A^T B \f$
- *   - \f$ B \leftarrow \alpha B A \f$
- *   - \f$ B \leftarrow \alpha B A^T \f$
+ * @brief Matrix-matrix product of general rectangular matrices with float
+ *        elements, taking sizes, offsets and leading dimensions as 64-bit
+ *        integers.
  *
- * where \b T is an upper or lower triangular matrix.
+ * Computes the same product as clblasSgemm(). Matrices may hold more than
+ * 4G elements, and start beyond the first 4G elements of their buffer
+ * objects; kernels with 64-bit index arithmetic are chosen for such
+ * problems only, others run the regular kernels. \b M, \b N, \b K and the
+ * leading dimensions must still be less than 2^32.
  *
  * @param[in] order     Row/column order.
- * @param[in] side      The side of triangular matrix.
- * @param[in] uplo      The triangle in matrix being referenced.
  * @param[in] transA    How matrix \b A is to be transposed.
- * @param[in] diag      Specify whether matrix is unit triangular.
- * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
  * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
  * @param[in] alpha     The factor of matrix \b A.
  * @param[in] A         Buffer object storing matrix \b A.
  * @param[in] offA      Offset of the first element of the matrix \b A in the
  *                      buffer object. Counted in elements.
- * @param[in] lda       Leading dimension of matrix \b A. It cannot be less
- *                      than \b M when the \b side parameter is set to
- *                      \b clblasLeft,\n or less than \b N when it is set
- *                      to \b clblasRight.
- * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
  * @param[in] offB      Offset of the first element of the matrix \b B in the
  *                      buffer object. Counted in elements.
- * @param[in] ldb       Leading dimension of matrix \b B. It cannot be less
- *                      than \b N when the \b order parameter is set to
- *                      \b clblasRowMajor,\n or not less than \b M
- *                      when it is set to \b clblasColumnMajor.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
  * @param[in] numCommandQueues    Number of OpenCL command queues in which the
  *                                task is to be performed.
  * @param[in] commandQueues       OpenCL command queues.
@@ -7687,28 +7860,32 @@ clblasZgemm(
  *
  * @return
  *   - \b clblasSuccess on success;
- *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
- *        of the respective buffer object;
- *   - the same error codes as clblasStrmm() otherwise.
+ *   - \b clblasInvalidValue if an argument doesn't fit in size_t on the host;
+ *   - \b clblasNotImplemented if \b M, \b N, \b K or a leading dimension
+ *        is 2^32 or more;
+ *   - the same error codes as clblasSgemm() otherwise.
  *
- * @ingroup TRMM
+ * @ingroup GEMM64
  */
 clblasStatus
-clblasStrmm(
+clblasSgemm_64(
     clblasOrder order,
-    clblasSide side,
-    clblasUplo uplo,
     clblasTranspose transA,
-    clblasDiag diag,
-    size_t M,
-    size_t N,
+    clblasTranspose transB,
+    cl_ulong M,
+    cl_ulong N,
+    cl_ulong K,
     cl_float alpha,
     const cl_mem A,
-    size_t offA,
-    size_t lda,
-    cl_mem B,
-    size_t offB,
-    size_t ldb,
+    cl_ulong offA,
+    cl_ulong lda,
+    const cl_mem B,
+    cl_ulong offB,
+    cl_ulong ldb,
+    cl_float beta,
+    cl_mem C,
+    cl_ulong offC,
+    cl_ulong ldc,
     cl_uint numCommandQueues,
     cl_command_queue *commandQueues,
     cl_uint numEventsInWaitList,
@@ -7716,40 +7893,35 @@ clblasStrmm(
     cl_event *events);
 
 /**
- * @example example_strmm.c
- * This is an example of how to use the @ref clblasStrmmEx function.
- */
-
-/**
- * @brief Multiplying a matrix by a triangular matrix with double elements.
- *        Extended version.
- *
- * Matrix-triangular matrix products:
- *   - \f$ B \leftarrow \alpha A B \f$
- *   - \f$ B \leftarrow \alpha A^T B \f$
- *   - \f$ B \leftarrow \alpha B A \f$
- *   - \f$ B \leftarrow \alpha B A^T \f$
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        double elements, taking sizes, offsets and leading dimensions
+ *        as 64-bit integers.
  *
- * where \b T is an upper or lower triangular matrix.
+ * Computes the same product as clblasDgemm().
  *
  * @param[in] order     Row/column order.
- * @param[in] side      The side of triangular matrix.
- * @param[in] uplo      The triangle in matrix being referenced.
  * @param[in] transA    How matrix \b A is to be transposed.
- * @param[in] diag      Specify whether matrix is unit triangular.
- * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
  * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
  * @param[in] alpha     The factor of matrix \b A.
  * @param[in] A         Buffer object storing matrix \b A.
  * @param[in] offA      Offset of the first element of the matrix \b A in the
  *                      buffer object. Counted in elements.
- * @param[in] lda       Leading dimension of matrix \b A. For detailed
- *                      description, see clblasStrmm().
- * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
  * @param[in] offB      Offset of the first element of the matrix \b B in the
  *                      buffer object. Counted in elements.
- * @param[in] ldb       Leading dimension of matrix \b B. For detailed
- *                      description, see clblasStrmm().
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
  * @param[in] numCommandQueues    Number of OpenCL command queues in which the
  *                                task is to be performed.
  * @param[in] commandQueues       OpenCL command queues.
@@ -7759,31 +7931,29 @@ clblasStrmm(
  *                       a particular kernel execution instance.
  *
  * @return
- *   - \b clblasSuccess on success;
- *   - \b clblasInvalidDevice if a target device does not support floating
- *     point arithmetic with double precision;
- *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
- *        of the respective buffer object;
- *   - the same error codes as the clblasStrmm() function otherwise.
+ *   - the same error codes as clblasSgemm_64() and clblasDgemm().
  *
- * @ingroup TRMM
+ * @ingroup GEMM64
  */
 clblasStatus
-clblasDtrmm(
+clblasDgemm_64(
     clblasOrder order,
-    clblasSide side,
-    clblasUplo uplo,
     clblasTranspose transA,
-    clblasDiag diag,
-    size_t M,
-    size_t N,
+    clblasTranspose transB,
+    cl_ulong M,
+    cl_ulong N,
+    cl_ulong K,
     cl_double alpha,
     const cl_mem A,
-    size_t offA,
-    size_t lda,
-    cl_mem B,
-    size_t offB,
-    size_t ldb,
+    cl_ulong offA,
+    cl_ulong lda,
+    const cl_mem B,
+    cl_ulong offB,
+    cl_ulong ldb,
+    cl_double beta,
+    cl_mem C,
+    cl_ulong offC,
+    cl_ulong ldc,
     cl_uint numCommandQueues,
     cl_command_queue *commandQueues,
     cl_uint numEventsInWaitList,
@@ -7791,34 +7961,35 @@ clblasDtrmm(
     cl_event *events);
 
 /**
- * @brief Multiplying a matrix by a triangular matrix with float complex
- *        elements. Extended version.
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        float complex elements, taking sizes, offsets and leading dimensions
+ *        as 64-bit integers.
  *
- * Matrix-triangular matrix products:
- *   - \f$ B \leftarrow \alpha A B \f$
- *   - \f$ B \leftarrow \alpha A^T B \f$
- *   - \f$ B \leftarrow \alpha B A \f$
- *   - \f$ B \leftarrow \alpha B A^T \f$
+ * Computes the same product as clblasCgemm().
  *
- * where \b T is an upper or lower triangular matrix.
  * @param[in] order     Row/column order.
- * @param[in] side      The side of triangular matrix.
- * @param[in] uplo      The triangle in matrix being referenced.
  * @param[in] transA    How matrix \b A is to be transposed.
- * @param[in] diag      Specify whether matrix is unit triangular.
- * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
  * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
  * @param[in] alpha     The factor of matrix \b A.
  * @param[in] A         Buffer object storing matrix \b A.
  * @param[in] offA      Offset of the first element of the matrix \b A in the
  *                      buffer object. Counted in elements.
- * @param[in] lda       Leading dimension of matrix \b A. For detailed
- *                      description, see clblasStrmm().
- * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
  * @param[in] offB      Offset of the first element of the matrix \b B in the
  *                      buffer object. Counted in elements.
- * @param[in] ldb       Leading dimension of matrix \b B. For detailed
- *                      description, see clblasStrmm().
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
  * @param[in] numCommandQueues    Number of OpenCL command queues in which the
  *                                task is to be performed.
  * @param[in] commandQueues       OpenCL command queues.
@@ -7828,29 +7999,29 @@ clblasDtrmm(
  *                       a particular kernel execution instance.
  *
  * @return
- *   - \b clblasSuccess on success;
- *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
- *        of the respective buffer object;
- *   - the same error codes as clblasStrmm() otherwise.
+ *   - the same error codes as clblasSgemm_64() and clblasCgemm().
  *
- * @ingroup TRMM
+ * @ingroup GEMM64
  */
 clblasStatus
-clblasCtrmm(
+clblasCgemm_64(
     clblasOrder order,
-    clblasSide side,
-    clblasUplo uplo,
     clblasTranspose transA,
-    clblasDiag diag,
-    size_t M,
-    size_t N,
+    clblasTranspose transB,
+    cl_ulong M,
+    cl_ulong N,
+    cl_ulong K,
     FloatComplex alpha,
     const cl_mem A,
-    size_t offA,
-    size_t lda,
-    cl_mem B,
-    size_t offB,
-    size_t ldb,
+    cl_ulong offA,
+    cl_ulong lda,
+    const cl_mem B,
+    cl_ulong offB,
+    cl_ulong ldb,
+    FloatComplex beta,
+    cl_mem C,
+    cl_ulong offC,
+    cl_ulong ldc,
     cl_uint numCommandQueues,
     cl_command_queue *commandQueues,
     cl_uint numEventsInWaitList,
@@ -7858,35 +8029,35 @@ clblasCtrmm(
     cl_event *events);
 
 /**
- * @brief Multiplying a matrix by a triangular matrix with double complex
- *        elements. Extended version.
- *
- * Matrix-triangular matrix products:
- *   - \f$ B \leftarrow \alpha A B \f$
- *   - \f$ B \leftarrow \alpha A^T B \f$
- *   - \f$ B \leftarrow \alpha B A \f$
- *   - \f$ B \leftarrow \alpha B A^T \f$
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        double complex elements, taking sizes, offsets and leading dimensions
+ *        as 64-bit integers.
  *
- * where \b T is an upper or lower triangular matrix.
+ * Computes the same product as clblasZgemm().
  *
  * @param[in] order     Row/column order.
- * @param[in] side      The side of triangular matrix.
- * @param[in] uplo      The triangle in matrix being referenced.
  * @param[in] transA    How matrix \b A is to be transposed.
- * @param[in] diag      Specify whether matrix is unit triangular.
- * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
  * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
  * @param[in] alpha     The factor of matrix \b A.
  * @param[in] A         Buffer object storing matrix \b A.
  * @param[in] offA      Offset of the first element of the matrix \b A in the
  *                      buffer object. Counted in elements.
- * @param[in] lda       Leading dimension of matrix \b A. For detailed
- *                      description, see clblasStrmm().
- * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
  * @param[in] offB      Offset of the first element of the matrix \b B in the
  *                      buffer object. Counted in elements.
- * @param[in] ldb       Leading dimension of matrix \b B. For detailed
- *                      description, see clblasStrmm().
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
  * @param[in] numCommandQueues    Number of OpenCL command queues in which the
  *                                task is to be performed.
  * @param[in] commandQueues       OpenCL command queues.
@@ -7896,9 +8067,864 @@ clblasCtrmm(
  *                       a particular kernel execution instance.
  *
  * @return
- *   - \b clblasSuccess on success;
- *   - \b clblasInvalidDevice if a target device does not support floating
- *     point arithmetic with double precision;
+ *   - the same error codes as clblasSgemm_64() and clblasZgemm().
+ *
+ * @ingroup GEMM64
+ */
+clblasStatus
+clblasZgemm_64(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    cl_ulong M,
+    cl_ulong N,
+    cl_ulong K,
+    DoubleComplex alpha,
+    const cl_mem A,
+    cl_ulong offA,
+    cl_ulong lda,
+    const cl_mem B,
+    cl_ulong offB,
+    cl_ulong ldb,
+    DoubleComplex beta,
+    cl_mem C,
+    cl_ulong offC,
+    cl_ulong ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/*@}*/
+
+/**
+ * @defgroup GEMMOOC GEMMOOC - General matrix-matrix multiplication of
+ *                             matrices in host memory
+ * @ingroup BLAS3
+ */
+/*@{*/
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with float
+ *        elements stored in host memory.
+ *
+ * Computes the same product as clblasSgemm() for matrices that need not
+ * fit in device memory or in a single buffer object. Blocks of \b C and
+ * panels of \b A and \b B are streamed through device buffers. With two
+ * command queues, the transfers are enqueued on the second one so that
+ * they overlap the multiplications run on the first one.
+ *
+ * The device memory used is limited to half of the global memory of the
+ * device, or to the number of megabytes set by the AMD_CLBLAS_GEMM_OOC_MB
+ * environment variable. The call returns once \b C is written.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Host memory storing matrix \b A.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Host memory storing matrix \b B.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Host memory storing matrix \b C.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues; at most
+ *                                two are used.
+ * @param[in] commandQueues       OpenCL command queues of the same device.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if no command queue is given;
+ *   - \b clblasInvalidMatA, \b clblasInvalidMatB or \b clblasInvalidMatC
+ *        if a matrix pointer is NULL;
+ *   - \b clblasInvalidLeadDimA, \b clblasInvalidLeadDimB or
+ *        \b clblasInvalidLeadDimC if a leading dimension is too small;
+ *   - the error codes of the buffer allocations, transfers and
+ *     clblasSgemm() otherwise.
+ *
+ * @ingroup GEMMOOC
+ */
+clblasStatus
+clblasSgemmOutOfCore(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_float alpha,
+    const cl_float *A,
+    size_t lda,
+    const cl_float *B,
+    size_t ldb,
+    cl_float beta,
+    cl_float *C,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        double elements stored in host memory.
+ *
+ * Computes the same product as clblasDgemm(); see clblasSgemmOutOfCore().
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Host memory storing matrix \b A.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Host memory storing matrix \b B.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Host memory storing matrix \b C.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues; at most
+ *                                two are used.
+ * @param[in] commandQueues       OpenCL command queues of the same device.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ *
+ * @return
+ *   - the same error codes as clblasSgemmOutOfCore() and clblasDgemm().
+ *
+ * @ingroup GEMMOOC
+ */
+clblasStatus
+clblasDgemmOutOfCore(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_double alpha,
+    const cl_double *A,
+    size_t lda,
+    const cl_double *B,
+    size_t ldb,
+    cl_double beta,
+    cl_double *C,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        float complex elements stored in host memory.
+ *
+ * Computes the same product as clblasCgemm(); see clblasSgemmOutOfCore().
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Host memory storing matrix \b A.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Host memory storing matrix \b B.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Host memory storing matrix \b C.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues; at most
+ *                                two are used.
+ * @param[in] commandQueues       OpenCL command queues of the same device.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ *
+ * @return
+ *   - the same error codes as clblasSgemmOutOfCore() and clblasCgemm().
+ *
+ * @ingroup GEMMOOC
+ */
+clblasStatus
+clblasCgemmOutOfCore(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    FloatComplex alpha,
+    const FloatComplex *A,
+    size_t lda,
+    const FloatComplex *B,
+    size_t ldb,
+    FloatComplex beta,
+    FloatComplex *C,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        double complex elements stored in host memory.
+ *
+ * Computes the same product as clblasZgemm(); see clblasSgemmOutOfCore().
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Host memory storing matrix \b A.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Host memory storing matrix \b B.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Host memory storing matrix \b C.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues; at most
+ *                                two are used.
+ * @param[in] commandQueues       OpenCL command queues of the same device.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ *
+ * @return
+ *   - the same error codes as clblasSgemmOutOfCore() and clblasZgemm().
+ *
+ * @ingroup GEMMOOC
+ */
+clblasStatus
+clblasZgemmOutOfCore(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    DoubleComplex alpha,
+    const DoubleComplex *A,
+    size_t lda,
+    const DoubleComplex *B,
+    size_t ldb,
+    DoubleComplex beta,
+    DoubleComplex *C,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList);
+
+/*@}*/
+
+/**
+ * @defgroup GEMMEX GEMMEX - General matrix-matrix multiplication with a
+ *                           fused epilogue
+ * @ingroup BLAS3
+ */
+/*@{*/
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with float
+ *        elements followed by a fused epilogue.
+ *
+ * Computes the same product as clblasSgemm() and applies the operations
+ * described by \b epilogue while C is written, so that C is read and
+ * written once. The epilogue kernels are built on the first call for
+ * each kind of epilogue.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] epilogue  Operations applied to C. If it is NULL, the call is
+ *                      the same as clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if the epilogue modes are invalid or
+ *        \b clampMin exceeds \b clampMax;
+ *   - \b clblasInvalidVecX or \b clblasInsufficientMemVecX if the bias
+ *        vector is not a valid memory object or is too small;
+ *   - \b clblasInvalidVecY or \b clblasInsufficientMemVecY if the scale
+ *        vector is not a valid memory object or is too small;
+ *   - the same error codes as clblasSgemm() otherwise.
+ *
+ * @ingroup GEMMEX
+ */
+clblasStatus
+clblasSgemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_float alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_float beta,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    const clblasEpilogue *epilogue,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with double
+ *        elements followed by a fused epilogue.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] epilogue  Operations applied to C. If it is NULL, the call is
+ *                      the same as clblasDgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidDevice if a target device does not support floating
+ *        point arithmetic with double precision;
+ *   - the same error codes as the clblasSgemmEx() function otherwise.
+ *
+ * @ingroup GEMMEX
+ */
+clblasStatus
+clblasDgemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_double alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_double beta,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    const clblasEpilogue *epilogue,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/*@}*/
+
+/**
+ * @defgroup HGEMM HGEMM - Half precision general matrix-matrix multiplication
+ * @ingroup BLAS3
+ */
+/*@{*/
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with half
+ *        precision elements.
+ *
+ * Computes the same products as clblasSgemm() for matrices of cl_half
+ * elements. On devices supporting the \b cl_khr_fp16 extension the
+ * products are accumulated in half precision. Other devices only convert
+ * halves while loading and storing them, and accumulate in single precision.
+ * Setting the AMD_CLBLAS_HALF_ARITHMETIC environment variable to 0 selects
+ * the single precision accumulation on every device.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - the same error codes as clblasSgemm() otherwise.
+ *
+ * @ingroup HGEMM
+ */
+clblasStatus
+clblasHgemm(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_float alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_float beta,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with
+ *        separately chosen element types.
+ *
+ * Computes the same products as clblasSgemm(). Matrices \b A and \b B
+ * have elements of type \b typeAB, matrix \b C has elements of type
+ * \b typeC. Supported combinations are:
+ *   - clblasDataHalf inputs and a clblasDataFloat result, with products
+ *     accumulated in single precision;
+ *   - clblasDataHalf inputs and result, which is clblasHgemm();
+ *   - clblasDataFloat inputs and result, which is clblasSgemm().
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] transB    How matrix \b B is to be transposed.
+ * @param[in] M         Number of rows in matrix \b A.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] K         Number of columns in matrix \b A and rows in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] B         Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] beta      The factor of matrix \b C.
+ * @param[out] C        Buffer object storing matrix \b C.
+ * @param[in] offC      Offset of the first element of the matrix \b C in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldc       Leading dimension of matrix \b C. For detailed description,
+ *                      see clblasSgemm().
+ * @param[in] typeAB    Element type of matrices \b A and \b B.
+ * @param[in] typeC     Element type of matrix \b C.
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if \b typeAB or \b typeC is not a valid type;
+ *   - \b clblasNotImplemented if the combination of types is not supported;
+ *   - the same error codes as clblasSgemm() otherwise.
+ *
+ * @ingroup HGEMM
+ */
+clblasStatus
+clblasGemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_float alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_float beta,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    clblasDataType typeAB,
+    clblasDataType typeC,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/*@}*/
+
+/**
+ * @defgroup TRMM TRMM - Triangular matrix-matrix multiplication
+ * @ingroup BLAS3
+ */
+/*@{*/
+
+/**
+ * @brief Multiplying a matrix by a triangular matrix with float elements.
+ *        Extended version.
+ *
+ * Matrix-triangular matrix products:
+ *   - \f$ B \leftarrow \alpha A B \f$
+ *   - \f$ B \leftarrow \alpha A^T B \f$
+ *   - \f$ B \leftarrow \alpha B A \f$
+ *   - \f$ B \leftarrow \alpha B A^T \f$
+ *
+ * where \b T is an upper or lower triangular matrix.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] side      The side of triangular matrix.
+ * @param[in] uplo      The triangle in matrix being referenced.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] diag      Specify whether matrix is unit triangular.
+ * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. It cannot be less
+ *                      than \b M when the \b side parameter is set to
+ *                      \b clblasLeft,\n or less than \b N when it is set
+ *                      to \b clblasRight.
+ * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. It cannot be less
+ *                      than \b N when the \b order parameter is set to
+ *                      \b clblasRowMajor,\n or not less than \b M
+ *                      when it is set to \b clblasColumnMajor.
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
+ *        of the respective buffer object;
+ *   - the same error codes as clblasStrmm() otherwise.
+ *
+ * @ingroup TRMM
+ */
+clblasStatus
+clblasStrmm(
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    cl_float alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @example example_strmm.c
+ * This is an example of how to use the @ref clblasStrmmEx function.
+ */
+
+/**
+ * @brief Multiplying a matrix by a triangular matrix with double elements.
+ *        Extended version.
+ *
+ * Matrix-triangular matrix products:
+ *   - \f$ B \leftarrow \alpha A B \f$
+ *   - \f$ B \leftarrow \alpha A^T B \f$
+ *   - \f$ B \leftarrow \alpha B A \f$
+ *   - \f$ B \leftarrow \alpha B A^T \f$
+ *
+ * where \b T is an upper or lower triangular matrix.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] side      The side of triangular matrix.
+ * @param[in] uplo      The triangle in matrix being referenced.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] diag      Specify whether matrix is unit triangular.
+ * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed
+ *                      description, see clblasStrmm().
+ * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed
+ *                      description, see clblasStrmm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidDevice if a target device does not support floating
+ *     point arithmetic with double precision;
+ *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
+ *        of the respective buffer object;
+ *   - the same error codes as the clblasStrmm() function otherwise.
+ *
+ * @ingroup TRMM
+ */
+clblasStatus
+clblasDtrmm(
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    cl_double alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Multiplying a matrix by a triangular matrix with float complex
+ *        elements. Extended version.
+ *
+ * Matrix-triangular matrix products:
+ *   - \f$ B \leftarrow \alpha A B \f$
+ *   - \f$ B \leftarrow \alpha A^T B \f$
+ *   - \f$ B \leftarrow \alpha B A \f$
+ *   - \f$ B \leftarrow \alpha B A^T \f$
+ *
+ * where \b T is an upper or lower triangular matrix.
+ * @param[in] order     Row/column order.
+ * @param[in] side      The side of triangular matrix.
+ * @param[in] uplo      The triangle in matrix being referenced.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] diag      Specify whether matrix is unit triangular.
+ * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed
+ *                      description, see clblasStrmm().
+ * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed
+ *                      description, see clblasStrmm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
+ *        of the respective buffer object;
+ *   - the same error codes as clblasStrmm() otherwise.
+ *
+ * @ingroup TRMM
+ */
+clblasStatus
+clblasCtrmm(
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    FloatComplex alpha,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Multiplying a matrix by a triangular matrix with double complex
+ *        elements. Extended version.
+ *
+ * Matrix-triangular matrix products:
+ *   - \f$ B \leftarrow \alpha A B \f$
+ *   - \f$ B \leftarrow \alpha A^T B \f$
+ *   - \f$ B \leftarrow \alpha B A \f$
+ *   - \f$ B \leftarrow \alpha B A^T \f$
+ *
+ * where \b T is an upper or lower triangular matrix.
+ *
+ * @param[in] order     Row/column order.
+ * @param[in] side      The side of triangular matrix.
+ * @param[in] uplo      The triangle in matrix being referenced.
+ * @param[in] transA    How matrix \b A is to be transposed.
+ * @param[in] diag      Specify whether matrix is unit triangular.
+ * @param[in] M         Number of rows in matrix \b B.
+ * @param[in] N         Number of columns in matrix \b B.
+ * @param[in] alpha     The factor of matrix \b A.
+ * @param[in] A         Buffer object storing matrix \b A.
+ * @param[in] offA      Offset of the first element of the matrix \b A in the
+ *                      buffer object. Counted in elements.
+ * @param[in] lda       Leading dimension of matrix \b A. For detailed
+ *                      description, see clblasStrmm().
+ * @param[out] B        Buffer object storing matrix \b B.
+ * @param[in] offB      Offset of the first element of the matrix \b B in the
+ *                      buffer object. Counted in elements.
+ * @param[in] ldb       Leading dimension of matrix \b B. For detailed
+ *                      description, see clblasStrmm().
+ * @param[in] numCommandQueues    Number of OpenCL command queues in which the
+ *                                task is to be performed.
+ * @param[in] commandQueues       OpenCL command queues.
+ * @param[in] numEventsInWaitList Number of events in the event wait list.
+ * @param[in] eventWaitList       Event wait list.
+ * @param[in] events     Event objects per each command queue that identify
+ *                       a particular kernel execution instance.
+ *
+ * @return
+ *   - \b clblasSuccess on success;
+ *   - \b clblasInvalidDevice if a target device does not support floating
+ *     point arithmetic with double precision;
  *   - \b clblasInvalidValue if either \b offA or \b offB exceeds the size
  *        of the respective buffer object;
  *   - the same error codes as the clblasStrmm() function otherwise.
@@ -9644,6 +10670,261 @@ clblasZher2k(
     cl_event *events);
 /*@}*/
 
+/**
+ * @defgroup SVM SVM - Functions taking shared virtual memory pointers
+ *
+ * These functions are equivalent to their buffer based counterparts except
+ * that matrices and vectors are passed as pointers allocated with
+ * clSVMAlloc() rather than as buffer objects. Offsets are counted in
+ * elements from the passed pointers. The pointers are bound to kernels
+ * with clSetKernelArgSVMPointer(), so the data are shared between the
+ * host and the device without wrapping them into buffers or copying.
+ *
+ * Since the library can't query the size of an SVM allocation, it is not
+ * checked that the vectors and matrices fit into the memory passed.
+ * If the library is built against OpenCL headers older than 2.0, these
+ * functions return \b clblasNotImplemented.
+ */
+/*@{*/
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with float
+ *        elements stored in shared virtual memory.
+ *
+ * @param[in] A          SVM pointer to matrix \b A.
+ * @param[in] B          SVM pointer to matrix \b B.
+ * @param[out] C         SVM pointer to matrix \b C.
+ *
+ * The rest of arguments and the return values are the same as for
+ * clblasSgemm() except that \b clblasInvalidMemObject is returned if
+ * either \b A, \b B, or \b C is NULL.
+ */
+clblasStatus
+clblasSgemmSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_float alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *B,
+    size_t offB,
+    size_t ldb,
+    cl_float beta,
+    void *C,
+    size_t offC,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Matrix-matrix product of general rectangular matrices with double
+ *        elements stored in shared virtual memory.
+ *
+ * See clblasSgemmSVM().
+ */
+clblasStatus
+clblasDgemmSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    cl_double alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *B,
+    size_t offB,
+    size_t ldb,
+    cl_double beta,
+    void *C,
+    size_t offC,
+    size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Matrix-vector product with a general rectangular matrix and
+ *        float elements stored in shared virtual memory.
+ *
+ * @param[in] A          SVM pointer to matrix \b A.
+ * @param[in] x          SVM pointer to vector \b X.
+ * @param[out] y         SVM pointer to vector \b Y.
+ *
+ * The rest of arguments and the return values are the same as for
+ * clblasSgemv() except that \b clblasInvalidMemObject is returned if
+ * either \b A, \b x, or \b y is NULL.
+ */
+clblasStatus
+clblasSgemvSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    cl_float alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *x,
+    size_t offx,
+    int incx,
+    cl_float beta,
+    void *y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Matrix-vector product with a general rectangular matrix and
+ *        double elements stored in shared virtual memory.
+ *
+ * See clblasSgemvSVM().
+ */
+clblasStatus
+clblasDgemvSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    cl_double alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *x,
+    size_t offx,
+    int incx,
+    cl_double beta,
+    void *y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Scale vector X of float elements and add to Y, both stored in
+ *        shared virtual memory.
+ *
+ * @param[in] X          SVM pointer to vector \b X.
+ * @param[out] Y         SVM pointer to vector \b Y.
+ *
+ * The rest of arguments and the return values are the same as for
+ * clblasSaxpy() except that \b clblasInvalidMemObject is returned if
+ * either \b X or \b Y is NULL.
+ */
+clblasStatus
+clblasSaxpySVM(
+    size_t N,
+    cl_float alpha,
+    const void *X,
+    size_t offx,
+    int incx,
+    void *Y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Scale vector X of double elements and add to Y, both stored in
+ *        shared virtual memory.
+ *
+ * See clblasSaxpySVM().
+ */
+clblasStatus
+clblasDaxpySVM(
+    size_t N,
+    cl_double alpha,
+    const void *X,
+    size_t offx,
+    int incx,
+    void *Y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Dot product of two vectors containing float elements stored in
+ *        shared virtual memory.
+ *
+ * @param[out] dotProduct  SVM pointer to the result.
+ * @param[in] X            SVM pointer to vector \b X.
+ * @param[in] Y            SVM pointer to vector \b Y.
+ * @param[in] scratchBuff  SVM pointer to temporary memory of at least
+ *                         \b N elements.
+ *
+ * The rest of arguments and the return values are the same as for
+ * clblasSdot() except that \b clblasInvalidMemObject is returned if
+ * any of the pointers is NULL.
+ */
+clblasStatus
+clblasSdotSVM(
+    size_t N,
+    void *dotProduct,
+    size_t offDP,
+    const void *X,
+    size_t offx,
+    int incx,
+    const void *Y,
+    size_t offy,
+    int incy,
+    void *scratchBuff,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+/**
+ * @brief Dot product of two vectors containing double elements stored in
+ *        shared virtual memory.
+ *
+ * See clblasSdotSVM().
+ */
+clblasStatus
+clblasDdotSVM(
+    size_t N,
+    void *dotProduct,
+    size_t offDP,
+    const void *X,
+    size_t offx,
+    int incx,
+    const void *Y,
+    size_t offy,
+    int incy,
+    void *scratchBuff,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+/*@}*/
+
 /**
  * @brief Helper function to compute leading dimension and size of a matrix
  *
@@ -154,6 +154,16 @@ public:
                                              cl_int & err,
                                              const char * options = 0);
 
+    // Build a cl_program from a text, unless the kernel pack or the cache
+    // on the disk have the binary of the kernel 'name' for the text and
+    // the options
+    static cl_program buildProgramFromSourceCached(const char * name,
+                                                   const char * source,
+                                                   cl_context context,
+                                                   cl_device_id device,
+                                                   cl_int & err,
+                                                   const char * options = 0);
+
     // Build a cl_program from binary
     static cl_program buildProgramFromBinary(const char * data,
                                              size_t data_size,
@@ -166,6 +176,12 @@ public:
     // and dump on the disk
     cl_int populateCache();
 
+    // Get the cache folder of the device and its driver version, creating
+    // it if necessary. The folder is under root if it is given, under the
+    // binary cache otherwise; the latter fails if the cache is disabled
+    static cl_int deviceCachePath(cl_device_id device, std::string & path,
+                                  const char * root = NULL);
+
 private:
 
     // Serialize variants and compute the checksum to load the file from cache
@@ -197,6 +213,9 @@ private:
     // clGetDeviceInfo
     cl_int retrieveDeviceAndDriverInfo();
 
+    // Kernel name given at the construction
+    std::string m_kernel_name;
+
     // Cache entry name 
     std::string m_cache_entry_name;
 
@@ -37,6 +37,16 @@ do {                                                    \
     (karg)->typeSize = sizeof(val);                     \
 } while (0)
 
+/*
+ * Problem memory objects are SVM pointers for the SVM calls; the argument
+ * is then bound with clSetKernelArgSVMPointer()
+ */
+#define INIT_MEM_KARG(karg, mem, svm)                   \
+do {                                                    \
+    INIT_KARG(karg, mem);                               \
+    (karg)->isSVM = (svm) ? 1 : 0;                      \
+} while (0)
+
 enum {
     MAX_KERNEL_ARGS = 32,
     MAX_ARG_SIZE = sizeof(cl_double2),
@@ -79,6 +89,7 @@ typedef struct KernelArg {
     void *hostBuf;          // host buffer for using with OpenCL memory objects
     size_t hostBufLen;
     MemobjDir dir;
+    int isSVM;              // 'arg.mem' is an SVM pointer, not a memory object
 } KernelArg;
 
 typedef struct KernelDesc {
@@ -40,7 +40,8 @@ typedef enum DataType {
     TYPE_DOUBLE,            /**< double float precision type */
     TYPE_COMPLEX_FLOAT,     /**< single float precision complex type */
     TYPE_COMPLEX_DOUBLE,    /**< double float precision complex type */
-    TYPE_UNSIGNED_INT       /**< Unsigned int, for output buffer for iAMAX routine */
+    TYPE_UNSIGNED_INT,      /**< Unsigned int, for output buffer for iAMAX routine */
+    TYPE_HALF               /**< half precision storage type, for HGEMM */
 } DataType;
 
 /*@}*/
@@ -32,13 +32,16 @@ extern "C" {
 typedef enum DeviceVendor {
     VENDOR_UNKNOWN,
     VENDOR_AMD,
-    VENDOR_NVIDIA
+    VENDOR_NVIDIA,
+    VENDOR_INTEL
 } DeviceVendor;
 
 typedef enum DeviceFamily {
     DEVICE_FAMILY_UNKNOWN,
     GPU_FAMILY_EVERGREEN,
-    GPU_FAMILY_FERMI
+    GPU_FAMILY_FERMI,
+    /* any CPU device, whoever implements the OpenCL runtime */
+    CPU_FAMILY_GENERIC
 } DeviceFamily;
 
 typedef enum DeviceChip {
@@ -76,6 +79,19 @@ typedef struct TargetDevice {
     DeviceHwInfo hwInfo;
 } TargetDevice;
 
+/*
+ * Device characteristics measured with microbenchmarks
+ */
+typedef struct DeviceProfile {
+    cl_ulong l1CacheSize;
+    cl_ulong l2CacheSize;
+    cl_uint l1CacheAssoc;
+    double globalBandwidth;     /* GB/s */
+    unsigned int loadVecLen;    /* floats per load giving the best bandwidth */
+    double ldsBandwidth;        /* GB/s */
+    double launchLatency;       /* microseconds */
+} DeviceProfile;
+
 cl_int
 identifyDevice(TargetDevice *target);
 
@@ -93,6 +109,23 @@ cl_ulong deviceL1CacheSize     (cl_device_id device, cl_ulong l2CacheSize,
 cl_uint  deviceL1CacheAssoc    (cl_device_id device, cl_ulong l1CacheSize,
                                 cl_int *error);
 size_t  deviceMaxWorkgroupSize (cl_device_id device, cl_int *error);
+cl_uint  deviceSIMDWidth       (cl_device_id device, cl_int *error);
+
+double   deviceGlobalBandwidth (cl_device_id device, unsigned int vecLen,
+                                cl_int *error);
+double   deviceLDSBandwidth    (cl_device_id device, cl_int *error);
+double   deviceLaunchLatency   (cl_device_id device, cl_int *error);
+
+cl_int
+characterizeDevice(cl_device_id device, DeviceProfile *profile);
+
+/*
+ * Profile of the device, measured by clblasProfileDevice() or stored on
+ * disk, see device_profile.cc. Returns NULL if the device has not been
+ * characterized; the measurement is never run from here.
+ */
+const DeviceProfile*
+getDeviceProfile(cl_device_id device);
 
 #ifdef __cplusplus
 }       /* extern "C" { */
@@ -165,6 +165,12 @@ availKernelCacheSize(struct KernelCache *kcache);
 void
 cleanKernelCache(struct KernelCache *kcache);
 
+/*
+ * Remove all kernels built for the context 'context' from the cache
+ */
+void
+removeContextKernels(struct KernelCache *kcache, cl_context context);
+
 size_t
 fullKernelSize(struct Kernel *kern);
 
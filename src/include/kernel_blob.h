@@ -0,0 +1,213 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Compressed kernel binaries embedded into the library
+ *
+ * The generators (tplgen, OCLBinaryGenerator and the AutoGemm precompiler)
+ * store the device binaries compressed. A blob starts with a 12 byte
+ * header: the magic "CLBZ", the size of the binary and the size of the
+ * compressed data, both 32 bit little endian. The data are LZ77 sequences:
+ *
+ *   - a token, literal count in the high nibble and match length minus
+ *     KERNEL_BLOB_MIN_MATCH in the low one;
+ *   - if a nibble is 15, bytes added to it up to and including the first
+ *     one that isn't 255;
+ *   - the literals;
+ *   - unless the binary is complete, the 16 bit little endian distance
+ *     back to the match, then the match length extension.
+ *
+ * The library decodes a blob the first time its kernel is built. Anything
+ * without the magic, e.g. a binary loaded from the on-disk cache, is
+ * passed through unchanged.
+ */
+
+#ifndef KERNEL_BLOB_H_
+#define KERNEL_BLOB_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KERNEL_BLOB_MAGIC "CLBZ"
+#define KERNEL_BLOB_HEADER_SIZE 12
+#define KERNEL_BLOB_MIN_MATCH 4
+#define KERNEL_BLOB_MAX_DISTANCE 65535
+
+/* upper bound of the size of a blob with 'size' bytes of binary */
+#define KERNEL_BLOB_BOUND(size) \
+    (KERNEL_BLOB_HEADER_SIZE + (size) + (size) / 255 + 16)
+
+/*
+ * Section the blobs are put into, so that the pages of the kernels which
+ * are never built are never touched
+ */
+#define KERNEL_BLOB_SECTION_NAME ".clblas_kernels"
+#if defined(__GNUC__) && defined(__ELF__)
+#define KERNEL_BLOB_SECTION __attribute__((section(KERNEL_BLOB_SECTION_NAME)))
+#else
+#define KERNEL_BLOB_SECTION
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef KERNEL_BLOB_ENCODER
+
+void kernelBlobSetup(void);
+void kernelBlobTeardown(void);
+
+/*
+ * Get the device binary of an embedded kernel. If 'data' is a blob, it's
+ * decoded once and '*size' is updated to the size of the binary; the
+ * binary stays valid until clblasTeardown(). Returns NULL if the blob is
+ * corrupted or memory is exhausted.
+ */
+const unsigned char*
+kernelBlobData(const void *data, size_t *size);
+
+#else   /* KERNEL_BLOB_ENCODER */
+
+/*
+ * Encoder, compiled into the generators only
+ */
+
+#define KERNEL_BLOB_HASH_BITS 16
+
+static unsigned int
+kernelBlobRead32(const unsigned char *p)
+{
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+           ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void
+kernelBlobWrite32(unsigned char *p, size_t v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)((v >> 8) & 0xFF);
+    p[2] = (unsigned char)((v >> 16) & 0xFF);
+    p[3] = (unsigned char)((v >> 24) & 0xFF);
+}
+
+static unsigned char*
+kernelBlobPutLength(unsigned char *op, size_t len)
+{
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (unsigned char)len;
+
+    return op;
+}
+
+/* a sequence with 'matchLen' equal to 0 ends the blob */
+static unsigned char*
+kernelBlobPutSequence(
+    unsigned char *op,
+    const unsigned char *literals,
+    size_t nrLiterals,
+    size_t distance,
+    size_t matchLen)
+{
+    unsigned char *token = op++;
+    size_t extra = 0;
+
+    *token = (unsigned char)(((nrLiterals < 15) ? nrLiterals : 15) << 4);
+    if (nrLiterals >= 15) {
+        op = kernelBlobPutLength(op, nrLiterals - 15);
+    }
+    memcpy(op, literals, nrLiterals);
+    op += nrLiterals;
+
+    if (matchLen) {
+        extra = matchLen - KERNEL_BLOB_MIN_MATCH;
+        *op++ = (unsigned char)(distance & 0xFF);
+        *op++ = (unsigned char)((distance >> 8) & 0xFF);
+        *token |= (unsigned char)((extra < 15) ? extra : 15);
+        if (extra >= 15) {
+            op = kernelBlobPutLength(op, extra - 15);
+        }
+    }
+
+    return op;
+}
+
+/*
+ * Compress 'size' bytes of 'src' into 'dst', which must hold at least
+ * KERNEL_BLOB_BOUND(size) bytes. Returns the blob size, or 0 if out of
+ * memory.
+ */
+static size_t
+kernelBlobEncode(const unsigned char *src, size_t size, unsigned char *dst)
+{
+    /* last position + 1 of a sequence of 4 bytes with the given hash */
+    size_t *table;
+    size_t pos = 0;
+    size_t anchor = 0;
+    unsigned char *op = dst + KERNEL_BLOB_HEADER_SIZE;
+
+    table = (size_t*)calloc((size_t)1 << KERNEL_BLOB_HASH_BITS, sizeof(size_t));
+    if (table == NULL) {
+        return 0;
+    }
+
+    while (pos + KERNEL_BLOB_MIN_MATCH <= size) {
+        unsigned int seq = kernelBlobRead32(src + pos);
+        unsigned int hash = (seq * 2654435761U) >> (32 - KERNEL_BLOB_HASH_BITS);
+        size_t cand = table[hash];
+
+        table[hash] = pos + 1;
+        if (cand && (pos - (cand - 1) <= KERNEL_BLOB_MAX_DISTANCE) &&
+            (kernelBlobRead32(src + cand - 1) == seq)) {
+
+            size_t ref = cand - 1;
+            size_t len = KERNEL_BLOB_MIN_MATCH;
+
+            while ((pos + len < size) && (src[ref + len] == src[pos + len])) {
+                len++;
+            }
+            op = kernelBlobPutSequence(op, src + anchor, pos - anchor,
+                                       pos - ref, len);
+            pos += len;
+            anchor = pos;
+        }
+        else {
+            pos++;
+        }
+    }
+    if (anchor < size) {
+        op = kernelBlobPutSequence(op, src + anchor, size - anchor, 0, 0);
+    }
+    free(table);
+
+    memcpy(dst, KERNEL_BLOB_MAGIC, 4);
+    kernelBlobWrite32(dst + 4, size);
+    kernelBlobWrite32(dst + 8, op - dst - KERNEL_BLOB_HEADER_SIZE);
+
+    return op - dst;
+}
+
+#endif  /* KERNEL_BLOB_ENCODER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* KERNEL_BLOB_H_ */
@@ -41,6 +41,7 @@ void *debugCalloc(size_t size, const char *file, int line);
 void *debugRealloc(void *ptr, size_t size, const char *file, int line);
 void debugFree(void *ptr);
 void printMallocStatistics(void);
+unsigned long getMallocTraceCount(void);
 void printMemLeaksInfo(void);
 void releaseMallocTrace(void);
 
@@ -56,6 +57,11 @@ static __inline void printMallocStatistics(void)
     /* do nothing */
 }
 
+static __inline unsigned long getMallocTraceCount(void)
+{
+    return 0;
+}
+
 static __inline void printMemLeaksInfo(void)
 {
     /* do nothing */
@@ -94,6 +94,30 @@ kernelSelectionDataFiji = {
   ]
 }
 
+################################################################################
+# CPU devices: register-blocked kernels without local memory staging (the
+# "_CPU" family), since a CPU only emulates local memory in cache and pays
+# for every barrier. Small work groups with large micro tiles keep the work
+# items few and give the device compiler room to vectorize. A single tile
+# per precision serves every size, the row, column and corner kernels
+# taking the edges, so that the family stays a few hundred kernels; a CPU
+# gains little from a tile per size range.
+################################################################################
+kernelSelectionDataCPU = {
+  "s":[
+    [    0, [  4,  4,  4,  4], [ [  4,  4,  4,  4] ] ],
+    ],
+  "d":[
+    [    0, [  4,  4,  4,  4], [ [  4,  4,  4,  4] ] ],
+    ],
+  "c":[
+    [    0, [  4,  4,  2,  2], [ [  4,  4,  2,  2] ] ],
+    ],
+  "z":[
+    [    0, [  4,  4,  2,  2], [ [  4,  4,  2,  2] ] ],
+    ],
+  }
+
 kernelSelectionData = kernelSelectionDataHawaii
 def setArchitecture(architecture):
   global kernelSelectionData, kernelSelectionDataHawaii, kernelSelectionDataFiji
@@ -116,13 +140,104 @@ transposes = { "s":["N", "T"], "d":["N", "T"], \
 
 unrolls = { "s":[16, 8, 1], "d":[8, 1], "c":[8, 1], "z":[8, 1] }
 
+# unrolls of the "_CPU" family
+unrollsCPU = { "s":[8, 1], "d":[8, 1], "c":[8, 1], "z":[8, 1] }
+
 betas = [ 0, 1 ]
 
-def getTilesForPrecision(precision):
-  # valid tiles for this precision
+################################################################################
+# Fused epilogue kernels for clblasSgemmEx and clblasDgemmEx; a single tile
+# per precision, with an unroll of 1 covering any K
+################################################################################
+epiloguePrecisions = ["s", "d"]
+
+# [ workGroupNumRows, workGroupNumCols, microTileNumRows, microTileNumCols ]
+epilogueTile = { "s":[ 16, 16, 4, 4 ], "d":[ 16, 16, 4, 4 ] }
+
+epilogueUnrolls = { "s":[16, 1], "d":[8, 1] }
+
+def getEpilogueTilesForPrecision(precision):
+  if precision not in epiloguePrecisions:
+    return []
+  return makeFixedTiles(epilogueTile[precision], epilogueUnrolls[precision])
+
+################################################################################
+# 64-bit index kernels for matrices whose element offsets or extents don't fit
+# in 32 bits; offsets are passed as ulong and index products are computed in
+# ulong. Chosen only when the problem needs them
+################################################################################
+index64Precisions = ["s", "d", "c", "z"]
+
+# [ workGroupNumRows, workGroupNumCols, microTileNumRows, microTileNumCols ]
+index64Tile = { "s":[ 16, 16, 4, 4 ], "d":[ 16, 16, 4, 4 ], \
+    "c":[ 16, 16, 2, 2 ], "z":[ 16, 16, 2, 2 ] }
+
+index64Unrolls = { "s":[16, 1], "d":[8, 1], "c":[8, 1], "z":[8, 1] }
+
+def getIndex64TilesForPrecision(precision):
+  if precision not in index64Precisions:
+    return []
+  return makeFixedTiles(index64Tile[precision], index64Unrolls[precision])
+
+################################################################################
+# Triangular kernels for SYRK, HERK, SYR2K and HER2K; work groups are launched
+# only for the macro tiles on one side of the diagonal, so macro tiles must be
+# square. Elements of diagonal tiles outside the triangle are masked. The
+# rank-2k variants of SYR2K and HER2K ("_TRI2K") use the same tiles
+################################################################################
+triangularPrecisions = ["s", "d", "c", "z"]
+
+# [ workGroupNumRows, workGroupNumCols, microTileNumRows, microTileNumCols ]
+triangularTile = { "s":[ 16, 16, 4, 4 ], "d":[ 16, 16, 4, 4 ], \
+    "c":[ 16, 16, 2, 2 ], "z":[ 16, 16, 2, 2 ] }
+
+triangularUnrolls = { "s":[16, 8, 1], "d":[8, 1], "c":[8, 1], "z":[8, 1] }
+
+def getTriangularTilesForPrecision(precision):
+  if precision not in triangularPrecisions:
+    return []
+  return makeFixedTiles(triangularTile[precision], triangularUnrolls[precision])
+
+################################################################################
+# Half precision kernels for clblasHgemm ("h": half A, B and C) and
+# clblasGemmEx ("hs": half A and B, float C). Halves are converted with
+# vload_half/vstore_half and multiplied in float; "h" kernels built with
+# -DHALF_ARITHMETIC compute in half on devices with cl_khr_fp16
+################################################################################
+halfPrecisions = ["h", "hs"]
+
+halfTransposes = { "h":["N", "T"], "hs":["N", "T"] }
+
+# [ workGroupNumRows, workGroupNumCols, microTileNumRows, microTileNumCols ]
+halfTile = { "h":[ 16, 16, 4, 4 ], "hs":[ 16, 16, 4, 4 ] }
+
+halfUnrolls = { "h":[16, 1], "hs":[16, 1] }
+
+def getHalfTilesForPrecision(precision):
+  if precision not in halfPrecisions:
+    return []
+  return makeFixedTiles(halfTile[precision], halfUnrolls[precision])
+
+# one tile per unroll, for families chosen by K alone
+def makeFixedTiles(tileParams, unrollList):
   tiles = []
   tile = KernelParameters.TileParameters()
-  for sizeData in kernelSelectionData[precision]:
+  tile.workGroupNumRows = tileParams[0]
+  tile.workGroupNumCols = tileParams[1]
+  tile.microTileNumRows = tileParams[2]
+  tile.microTileNumCols = tileParams[3]
+  tile.macroTileNumRows = tile.workGroupNumRows*tile.microTileNumRows
+  tile.macroTileNumCols = tile.workGroupNumCols*tile.microTileNumCols
+  for unroll in unrollList:
+    tile.unroll = unroll
+    tiles.append( copy.copy(tile) )
+  return tiles
+
+def getTilesForSelectionData(selectionData, unrollDict, precision):
+  # valid tiles of a selection table for this precision
+  tiles = []
+  tile = KernelParameters.TileParameters()
+  for sizeData in selectionData[precision]:
     fallbackTile = sizeData[1]
     validTiles = sizeData[2]
     # add valid tiles
@@ -135,7 +250,7 @@ def getTilesForPrecision(precision):
       tile.macroTileNumRows = tile.workGroupNumRows*tile.microTileNumRows
       tile.macroTileNumCols = tile.workGroupNumCols*tile.microTileNumCols
       #print(tile.getName())
-      for unroll in unrolls[precision]:
+      for unroll in unrollDict[precision]:
         tile.unroll = unroll
         if tile.isValid():
           tiles.append( copy.copy(tile) )
@@ -149,7 +264,7 @@ def getTilesForPrecision(precision):
     tile.microTileNumCols = fallbackTile[3]
     tile.macroTileNumRows = tile.workGroupNumRows*tile.microTileNumRows
     tile.macroTileNumCols = tile.workGroupNumCols*tile.microTileNumCols
-    for unroll in unrolls[precision]:
+    for unroll in unrollDict[precision]:
       tile.unroll = unroll
       if tile.isValid():
         tiles.append( copy.copy(tile) )
@@ -161,6 +276,14 @@ def getTilesForPrecision(precision):
   tiles.sort()
   return tiles
 
+def getTilesForPrecision(precision):
+  return getTilesForSelectionData(kernelSelectionData, unrolls, precision)
+
+# tiles of the "_CPU" family
+def getCPUTilesForPrecision(precision):
+  return getTilesForSelectionData(kernelSelectionDataCPU, unrollsCPU,
+      precision)
+
 def getTransposeChoices():
   singleTransposes = []
   for precision in precisions:
@@ -41,6 +41,10 @@
 #endif
 
 #include "CL/opencl.h"
+
+#define KERNEL_BLOB_ENCODER
+#include <kernel_blob.h>
+
 //#include "naive_blas.cpp"
 //using namespace NaiveBlas;
 #include "AutoGemmIncludes/AutoGemmKernelsToPreCompile.h"
@@ -402,6 +406,14 @@ void compileKernelAndWriteToFile(
   cl_int status = getKernelBinaryFromSource(context, source, buildOptions, kernelBinary, &kernelBinarySize);
   
   if (status == CL_SUCCESS) {
+    // compress binary, the library decodes it the first time the kernel is built
+    char *blob = new char[KERNEL_BLOB_BOUND(kernelBinarySize)];
+    size_t blobSize = kernelBlobEncode((unsigned char *)*kernelBinary, kernelBinarySize, (unsigned char *)blob);
+    if (blobSize == 0) {
+      printf("AutoGemm-PreCompile: failed to compress %s\n", stringName);
+      exit(-1);
+    }
+
     // write binary to file
     std::ofstream kernelFile;
     std::string fullFilePath;
@@ -409,17 +421,19 @@ void compileKernelAndWriteToFile(
     fullFilePath += fileName;
     kernelFile.open(fullFilePath.c_str(), std::ios::out);
     kernelFile << "/* AutoGemm Pre-Compiled kernel binary */" << std::endl << std::endl;
+    kernelFile << "#include <kernel_blob.h>" << std::endl << std::endl;
     kernelFile << "#define " << preprocessorName << std::endl << std::endl;
     
-    kernelFile << "char " << stringName << "Array[" << kernelBinarySize << "] = {" << std::endl;
+    kernelFile << "KERNEL_BLOB_SECTION const char " << stringName << "Array[" << blobSize << "] = {" << std::endl;
     //kernelFile << "unsigned char *" << stringName << " = {" << std::endl;
     //kernelFile << "unsigned char " << stringName << "[] = {" << std::endl;
     
-    writeBinaryToStream( kernelFile, *kernelBinary, kernelBinarySize );
+    writeBinaryToStream( kernelFile, blob, blobSize );
     kernelFile << "};" << std::endl;
-    kernelFile << "unsigned char *" << stringName << " = " << "reinterpret_cast<unsigned char *>(" << stringName << "Array);" << std::endl;
-    kernelFile << "size_t " << stringName << "Size = " << kernelBinarySize << ";" << std::endl;
+    kernelFile << "unsigned char *" << stringName << " = " << "(unsigned char *)" << stringName << "Array;" << std::endl;
+    kernelFile << "size_t " << stringName << "Size = " << blobSize << ";" << std::endl;
     kernelFile.close();
+    delete[] blob;
 
     // add file to include
     includeFile << "#include \"AutoGemmKernelBinaries/" << fileName << "\"" << std::endl;
@@ -49,9 +49,10 @@ def getAutoGemmHeader():
       " ******************************************************************************/\n\n"
       )
 
-hostDataChar = { "s":"s", "d":"d", "c":"c", "z":"z" }
+hostDataChar = { "s":"s", "d":"d", "c":"c", "z":"z", "h":"h", "hs":"hs" }
 hostDataType = { "s":"float", "d":"double", "c":"float2", "z":"double2" }
-openclDataType = { "s":"float", "d":"double", "c":"float2", "z":"double2" }
+hostPrecisionType = { "s":"float", "d":"double", "c":"FloatComplex", "z":"DoubleComplex" }
+openclDataType = { "s":"float", "d":"double", "c":"float2", "z":"double2", "h":"half", "hs":"half" }
 
 precisionInt = { "s":0, "d":1, "c":2, "z":3 }
 orderInt = { "clblasRowMajor":0, "clblasColumnMajor":1 }
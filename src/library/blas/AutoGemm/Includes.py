@@ -473,6 +473,58 @@ def writeIncludes():
               clKernelIncludes.addKernel(kernel)
               cppKernelEnumeration.addKernel(kernel)
 
+  # fused epilogue, 64-bit index and triangular variants, whose extra or
+  # wider arguments keep them out of the kernel enumeration, half precision
+  # kernels and the register-blocked kernels of CPU devices
+  epilogueKernel = KernelParameters.KernelParameters()
+  epilogueKernel.epilogue = True
+  index64Kernel = KernelParameters.KernelParameters()
+  index64Kernel.index64 = True
+  triangularKernel = KernelParameters.KernelParameters()
+  triangularKernel.triangular = True
+  rank2kKernel = KernelParameters.KernelParameters()
+  rank2kKernel.triangular = True
+  rank2kKernel.rank2k = True
+  cpuKernel = KernelParameters.KernelParameters()
+  cpuKernel.cpu = True
+  families = [ \
+      ( epilogueKernel, AutoGemmParameters.epiloguePrecisions, \
+        AutoGemmParameters.transposes, \
+        AutoGemmParameters.getEpilogueTilesForPrecision ), \
+      ( index64Kernel, AutoGemmParameters.index64Precisions, \
+        AutoGemmParameters.transposes, \
+        AutoGemmParameters.getIndex64TilesForPrecision ), \
+      ( triangularKernel, AutoGemmParameters.triangularPrecisions, \
+        AutoGemmParameters.transposes, \
+        AutoGemmParameters.getTriangularTilesForPrecision ), \
+      ( rank2kKernel, AutoGemmParameters.triangularPrecisions, \
+        AutoGemmParameters.transposes, \
+        AutoGemmParameters.getTriangularTilesForPrecision ), \
+      ( KernelParameters.KernelParameters(), AutoGemmParameters.halfPrecisions, \
+        AutoGemmParameters.halfTransposes, \
+        AutoGemmParameters.getHalfTilesForPrecision ), \
+      ( cpuKernel, AutoGemmParameters.precisions, \
+        AutoGemmParameters.transposes, \
+        AutoGemmParameters.getCPUTilesForPrecision ) ]
+  for (kernel, precisions, transposes, getTiles) in families:
+    for precision in precisions:
+      kernel.precision = precision
+      for order in AutoGemmParameters.orders:
+        kernel.order = order
+        for transA in transposes[precision]:
+          kernel.transA = transA
+          for transB in transposes[precision]:
+            kernel.transB = transB
+            for beta in AutoGemmParameters.betas:
+              kernel.beta = beta
+              for tile in getTiles(precision):
+                kernel.useTile(tile)
+                kernelSourceIncludes.addKernel(kernel)
+                kernelBinaryIncludes.addKernel(kernel)
+                kernelSourceBuildOptions.addKernel(kernel)
+                kernelBinaryBuildOptions.addKernel(kernel)
+                clKernelIncludes.addKernel(kernel)
+
   # save written files
   kernelSourceIncludes.writeToFile()
   kernelBinaryIncludes.writeToFile()
@@ -32,6 +32,23 @@ def makeOpenCLKernelString(kernel):
     kStr += endLine
     kStr += "#pragma OPENCL EXTENSION cl_khr_fp64 : enable" + endLine
 
+  ####################################
+  # Half precision: A and B (and C of "h" kernels) are stored as halves and
+  # multiplied in COMPUTE_TYPE_STR
+  half = kernel.precision in AutoGemmParameters.halfPrecisions
+  if half:
+    kStr += endLine
+    kStr += "#ifdef HALF_ARITHMETIC" + endLine
+    kStr += "#pragma OPENCL EXTENSION cl_khr_fp16 : enable" + endLine
+    kStr += "#endif" + endLine
+    cType = "C_TYPE_STR"
+    scalarType = "float"
+    computeType = "COMPUTE_TYPE_STR"
+  else:
+    cType = "DATA_TYPE_STR"
+    scalarType = "DATA_TYPE_STR"
+    computeType = "DATA_TYPE_STR"
+
   ####################################
   # kernel parameters
   kStr += endLine
@@ -65,29 +82,41 @@ def makeOpenCLKernelString(kernel):
   # A
   kStr += endLine
   kStr += "/* global memory indices */" + endLine
+  # 64-bit kernels widen the products so matrices may exceed 4G elements
+  wide = "(ulong)" if kernel.index64 else ""
+  # rank-2k kernels swap the operands between their two sweeps over k
+  (opA, opB, ldOpA, ldOpB) = getOperandNames(kernel)
   if (kernel.order=="clblasColumnMajor")==(kernel.transA=="N"):
-    kStr += "#define GET_GLOBAL_INDEX_A(ROW,COL) ((COL)*lda+(ROW))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_A(ROW,COL) (%s(COL)*%s+(ROW))%s" % (wide, ldOpA, endLine)
   else:
-    kStr += "#define GET_GLOBAL_INDEX_A(ROW,COL) ((ROW)*lda+(COL))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_A(ROW,COL) (%s(ROW)*%s+(COL))%s" % (wide, ldOpA, endLine)
   # B
   if (kernel.order=="clblasColumnMajor")==(kernel.transB=="N"):
-    kStr += "#define GET_GLOBAL_INDEX_B(ROW,COL) ((COL)*ldb+(ROW))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_B(ROW,COL) (%s(COL)*%s+(ROW))%s" % (wide, ldOpB, endLine)
   else:
-    kStr += "#define GET_GLOBAL_INDEX_B(ROW,COL) ((ROW)*ldb+(COL))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_B(ROW,COL) (%s(ROW)*%s+(COL))%s" % (wide, ldOpB, endLine)
   # C
   if (kernel.order=="clblasColumnMajor"):
-    kStr += "#define GET_GLOBAL_INDEX_C(ROW,COL) ((COL)*ldc+(ROW))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_C(ROW,COL) (%s(COL)*ldc+(ROW))%s" % (wide, endLine)
   else:
-    kStr += "#define GET_GLOBAL_INDEX_C(ROW,COL) ((ROW)*ldc+(COL))" + endLine
+    kStr += "#define GET_GLOBAL_INDEX_C(ROW,COL) (%s(ROW)*ldc+(COL))%s" % (wide, endLine)
 
   ####################################
   # local memory indices
   # A
-  kStr += endLine
-  kStr += "/* local memory indices */" + endLine
-  kStr += "#define GET_LOCAL_INDEX_A(ROW,COL) ((ROW) + (COL)*((MACRO_TILE_NUM_ROWS)+(LOCAL_COL_PAD)) )" + endLine
-  # B
-  kStr += "#define GET_LOCAL_INDEX_B(ROW,COL) ((COL) + (ROW)*((MACRO_TILE_NUM_COLS)+(LOCAL_ROW_PAD)) )" + endLine
+  if not kernel.cpu:
+    kStr += endLine
+    kStr += "/* local memory indices */" + endLine
+    kStr += "#define GET_LOCAL_INDEX_A(ROW,COL) ((ROW) + (COL)*((MACRO_TILE_NUM_ROWS)+(LOCAL_COL_PAD)) )" + endLine
+    # B
+    kStr += "#define GET_LOCAL_INDEX_B(ROW,COL) ((COL) + (ROW)*((MACRO_TILE_NUM_COLS)+(LOCAL_ROW_PAD)) )" + endLine
+
+  ####################################
+  # triangle of C
+  if kernel.triangular:
+    kStr += endLine
+    kStr += "/* triangle of C */" + endLine
+    kStr += "#define IN_TRIANGLE(ROW,COL) (upper ? (ROW) <= (COL) : (ROW) >= (COL))" + endLine
 
   ####################################
   # data types
@@ -95,10 +124,18 @@ def makeOpenCLKernelString(kernel):
   kStr += "/* data types */" + endLine
   kStr += "#define DATA_TYPE_STR %s%s" \
       % (Common.openclDataType[kernel.precision], endLine)
-  if kernel.precision=="s" or kernel.precision=="d":
+  if half:
+    kStr += makeOpenCLHalfTypesString(kernel)
+  elif kernel.precision=="s" or kernel.precision=="d":
     # real arithmetic
     kStr += "#define TYPE_MAD(MULA,MULB,DST) DST = mad(MULA,MULB,DST);" + endLine
-    if kernel.beta==1:
+    if kernel.epilogue:
+      kStr += makeOpenCLEpilogueString(kernel)
+      if kernel.beta==1:
+        kStr += "#define TYPE_MAD_WRITE(DST,ALPHA,REG,BETA,ROW,COL) DST = EPILOGUE( EPILOGUE_ALPHA(ALPHA,ROW,COL)*(REG) + (BETA)*(DST), ROW, COL );" + endLine
+      else:
+        kStr += "#define TYPE_MAD_WRITE(DST,ALPHA,REG,BETA,ROW,COL) DST = EPILOGUE( EPILOGUE_ALPHA(ALPHA,ROW,COL)*(REG), ROW, COL );" + endLine
+    elif kernel.beta==1:
       kStr += "#define TYPE_MAD_WRITE(DST,ALPHA,REG,BETA) DST = (ALPHA)*(REG) + (BETA)*(DST);" + endLine
     else:
       kStr += "#define TYPE_MAD_WRITE(DST,ALPHA,REG,BETA) DST = (ALPHA)*(REG);" + endLine
@@ -163,22 +200,64 @@ def makeOpenCLKernelString(kernel):
         "  REG.s1 *= ALPHA.s0; \\\\" + endLine +
         "  REG.s1 = mad(  ALPHA.s1, type_mad_tmp, REG.s1 ); \\\\" + endLine +
         "  DST = REG;" + endLine )
+    if kernel.rank2k:
+      kStr += makeOpenCLScaleString(kernel)
+
+  # TODO - zeroString for real and complex
+  if kernel.precision == "c":
+    zeroString = "(float2)(0.f, 0.f)"
+  elif kernel.precision == "z":
+    zeroString = "(double2)(0.0, 0.0)"
+  elif half:
+    zeroString = "(COMPUTE_TYPE_STR)0"
+  else:
+    zeroString = "0.0"
+
+  # C elements of a work item; CPU kernels own a contiguous micro-tile, the
+  # others interleave theirs with the work group
+  if kernel.cpu:
+    cRow = lambda a: "globalCRow+%d" % a
+    cCol = lambda b: "globalCCol+%d" % b
+  else:
+    cRow = lambda a: "globalCRow+%d*WG_NUM_ROWS" % a
+    cCol = lambda b: "globalCCol+%d*WG_NUM_COLS" % b
 
   ####################################
   # micro-tile
   kStr += endLine
   kStr += "/* %dx%d micro-tile */%s" % (kernel.microTileNumRows, kernel.microTileNumCols, endLine)
-  kStr += "#define MICRO_TILE \\\\" + endLine
-  for a in range(0, int(kernel.microTileNumRows)):
-    kStr += "  rA[%d] = localA[offA + %d*WG_NUM_ROWS]; \\\\%s" % (a, a, endLine)
-  for b in range(0, int(kernel.microTileNumCols)):
-    kStr += "  rB[%d] = localB[offB + %d*WG_NUM_COLS]; \\\\%s" % (b, b, endLine)
-  kStr += "  offA += (MACRO_TILE_NUM_ROWS+LOCAL_COL_PAD); \\\\" + endLine
-  kStr += "  offB += (MACRO_TILE_NUM_COLS+LOCAL_ROW_PAD); \\\\" + endLine
-  for a in range(0, int(kernel.microTileNumRows)):
+  if kernel.cpu:
+    # operands are read from global memory, which the caches of a CPU serve
+    # as fast as its emulated local memory; U is the offset in the k block
+    kStr += "#define MICRO_TILE(U) \\\\" + endLine
+    for a in range(0, int(kernel.microTileNumRows)):
+      kStr += "  rA[%d] = " % a
+      if kernel.isRowKernel():
+        kStr += "(%s >= M) ? %s : " % (cRow(a), zeroString)
+      kStr += "A[ GET_GLOBAL_INDEX_A( %s, (U) ) ]; \\\\%s" % (cRow(a), endLine)
     for b in range(0, int(kernel.microTileNumCols)):
-      kStr += "  TYPE_MAD(rA[%d],rB[%d],rC[%d][%d]); \\\\%s" % (a, b, a, b, endLine)
-  kStr += "  mem_fence(CLK_LOCAL_MEM_FENCE);" + endLine
+      kStr += "  rB[%d] = " % b
+      if kernel.isColKernel():
+        kStr += "(%s >= N) ? %s : " % (cCol(b), zeroString)
+      kStr += "B[ GET_GLOBAL_INDEX_B( (U), %s ) ]; \\\\%s" % (cCol(b), endLine)
+    for a in range(0, int(kernel.microTileNumRows)):
+      for b in range(0, int(kernel.microTileNumCols)):
+        kStr += "  TYPE_MAD(rA[%d],rB[%d],rC[%d][%d]);" % (a, b, a, b)
+        if a < kernel.microTileNumRows-1 or b < kernel.microTileNumCols-1:
+          kStr += " \\\\"
+        kStr += endLine
+  else:
+    kStr += "#define MICRO_TILE \\\\" + endLine
+    for a in range(0, int(kernel.microTileNumRows)):
+      kStr += "  rA[%d] = localA[offA + %d*WG_NUM_ROWS]; \\\\%s" % (a, a, endLine)
+    for b in range(0, int(kernel.microTileNumCols)):
+      kStr += "  rB[%d] = localB[offB + %d*WG_NUM_COLS]; \\\\%s" % (b, b, endLine)
+    kStr += "  offA += (MACRO_TILE_NUM_ROWS+LOCAL_COL_PAD); \\\\" + endLine
+    kStr += "  offB += (MACRO_TILE_NUM_COLS+LOCAL_ROW_PAD); \\\\" + endLine
+    for a in range(0, int(kernel.microTileNumRows)):
+      for b in range(0, int(kernel.microTileNumCols)):
+        kStr += "  TYPE_MAD(rA[%d],rB[%d],rC[%d][%d]); \\\\%s" % (a, b, a, b, endLine)
+    kStr += "  mem_fence(CLK_LOCAL_MEM_FENCE);" + endLine
   kStr += endLine
 
   ####################################
@@ -187,23 +266,38 @@ def makeOpenCLKernelString(kernel):
   kStr += "__attribute__((reqd_work_group_size(WG_NUM_COLS,WG_NUM_ROWS,1)))" + endLine
   kStr += "__kernel void %s" % ( kernel.getName() )
   kStr += "(" + endLine
-  # arguments
+  # arguments; 64-bit kernels take offsets beyond 4G elements
+  offsetType = "ulong" if kernel.index64 else "uint"
   kStr += (
     "  __global DATA_TYPE_STR const * restrict A," + endLine +
     "  __global DATA_TYPE_STR const * restrict B," + endLine +
-    "  __global DATA_TYPE_STR       *          C," + endLine +
-    "  DATA_TYPE_STR const alpha," + endLine +
-    "  DATA_TYPE_STR const beta," + endLine +
+    "  __global " + cType + "       *          C," + endLine +
+    "  " + scalarType + " const alpha," + endLine +
+    "  " + scalarType + " const beta," + endLine +
     "  uint const M," + endLine +
     "  uint const N," + endLine +
     "  uint const K," + endLine +
     "  uint const lda," + endLine +
     "  uint const ldb," + endLine +
     "  uint const ldc," + endLine +
-    "  uint const offsetA," + endLine +
-    "  uint const offsetB," + endLine +
-    "  uint const offsetC" + endLine +
-    ") {" + endLine )
+    "  " + offsetType + " const offsetA," + endLine +
+    "  " + offsetType + " const offsetB," + endLine +
+    "  " + offsetType + " const offsetC" )
+  if kernel.triangular:
+    kStr += (
+      "," + endLine +
+      "  uint const upper," + endLine +
+      "  uint const realDiagonal" )
+  if kernel.epilogue:
+    kStr += (
+      "," + endLine +
+      "  __global DATA_TYPE_STR const * restrict epilogueBias," + endLine +
+      "  __global DATA_TYPE_STR const * restrict epilogueScale," + endLine +
+      "  uint const offsetBias," + endLine +
+      "  uint const offsetScale," + endLine +
+      "  DATA_TYPE_STR const clampLow," + endLine +
+      "  DATA_TYPE_STR const clampHigh" )
+  kStr += endLine + ") {" + endLine
 
   ####################################
   # apply offsets
@@ -213,33 +307,54 @@ def makeOpenCLKernelString(kernel):
     "  A += offsetA;" + endLine +
     "  B += offsetB;" + endLine +
     "  C += offsetC;" + endLine )
+  if kernel.epilogue:
+    kStr += (
+      "  epilogueBias += offsetBias;" + endLine +
+      "  epilogueScale += offsetScale;" + endLine )
+  if kernel.rank2k:
+    kStr += makeOpenCLRank2KOperandsString(kernel)
 
   ####################################
   # allocate registers
   kStr += endLine
   kStr += (
     "  /* allocate registers */" + endLine +
-    "  DATA_TYPE_STR rC[MICRO_TILE_NUM_ROWS][MICRO_TILE_NUM_COLS] = { {0} };" + endLine +
-    "  DATA_TYPE_STR rA[MICRO_TILE_NUM_ROWS];" + endLine +
-    "  DATA_TYPE_STR rB[MICRO_TILE_NUM_COLS];" + endLine )
+    "  " + computeType + " rC[MICRO_TILE_NUM_ROWS][MICRO_TILE_NUM_COLS] = { {0} };" + endLine +
+    "  " + computeType + " rA[MICRO_TILE_NUM_ROWS];" + endLine +
+    "  " + computeType + " rB[MICRO_TILE_NUM_COLS];" + endLine )
 
   ####################################
   # allocate local memory
-  kStr += endLine
-  kStr += (
-    "  /* allocate local memory */" + endLine +
-    "  __local DATA_TYPE_STR localA[NUM_UNROLL_ITER*(MACRO_TILE_NUM_ROWS+LOCAL_COL_PAD)];" + endLine +
-    "  __local DATA_TYPE_STR localB[NUM_UNROLL_ITER*(MACRO_TILE_NUM_COLS+LOCAL_ROW_PAD)];" + endLine )
+  if not kernel.cpu:
+    kStr += endLine
+    kStr += (
+      "  /* allocate local memory */" + endLine +
+      "  __local " + computeType + " localA[NUM_UNROLL_ITER*(MACRO_TILE_NUM_ROWS+LOCAL_COL_PAD)];" + endLine +
+      "  __local " + computeType + " localB[NUM_UNROLL_ITER*(MACRO_TILE_NUM_COLS+LOCAL_ROW_PAD)];" + endLine )
 
   ####################################
   # work item indices
   kStr += endLine
   kStr += "  /* work item indices */" + endLine
-  if kernel.isRowKernel():
+  if kernel.triangular:
+    # the groups enumerate the macro tiles of the triangle by rows (lower)
+    # or columns (upper); row and column kernels only add bounds checks
+    kStr += (
+      "  uint groupTri = get_group_id(0);" + endLine +
+      "  uint groupOuter = (uint)((sqrt(8.0f*groupTri + 1.0f) - 1.0f) * 0.5f);" + endLine +
+      "  while (groupOuter*(groupOuter+1)/2 > groupTri) groupOuter--;" + endLine +
+      "  while ((groupOuter+1)*(groupOuter+2)/2 <= groupTri) groupOuter++;" + endLine +
+      "  uint groupInner = groupTri - groupOuter*(groupOuter+1)/2;" + endLine +
+      "  uint groupRow = upper ? groupInner : groupOuter;" + endLine +
+      "  uint groupCol = upper ? groupOuter : groupInner;" + endLine +
+      "  bool diagonalTile = (groupRow == groupCol);" + endLine )
+  elif kernel.isRowKernel():
     kStr += "  uint groupRow = M / " + str(kernel.workGroupNumRows*kernel.microTileNumRows) + "; // last row" + endLine
   else:
     kStr += "  uint groupRow = get_group_id(0);" + endLine
-  if kernel.isColKernel():
+  if kernel.triangular:
+    pass
+  elif kernel.isColKernel():
     kStr += "  uint groupCol = N / " + str(kernel.workGroupNumCols*kernel.microTileNumCols) + "; // last column" + endLine
   else:
     kStr += "  uint groupCol = get_group_id(1);" + endLine
@@ -274,8 +389,32 @@ def makeOpenCLKernelString(kernel):
 
   kStr += (
     "  uint localRow = get_local_id(0);" + endLine +
-    "  uint localCol = get_local_id(1);" + endLine +
-    "  uint localSerial = localRow + localCol*WG_NUM_ROWS;" + endLine )
+    "  uint localCol = get_local_id(1);" + endLine )
+
+  ####################################
+  # CPU kernels: every work item reads its own operands in the loop over k
+  if kernel.cpu:
+    kStr += endLine
+    kStr += "  /* which global Cij index */" + endLine
+    kStr += "  uint globalCRow = groupRow * MACRO_TILE_NUM_ROWS + localRow*MICRO_TILE_NUM_ROWS;" + endLine
+    kStr += "  uint globalCCol = groupCol * MACRO_TILE_NUM_COLS + localCol*MICRO_TILE_NUM_COLS;" + endLine
+    kStr += endLine
+    kStr += (
+      "  /* loop over k */" + endLine +
+      "  uint block_k = K / NUM_UNROLL_ITER;" + endLine +
+      "  do {" + endLine )
+    kStr += endLine
+    kStr += "    /* do mads */" + endLine
+    for u in range(0, int(kernel.unroll)):
+      kStr += "    MICRO_TILE(%d)%s" % (u, endLine)
+    kStr += makeOpenCLShiftKString(kernel)
+    kStr += endLine
+    kStr += "  } while (--block_k > 0);" + endLine
+    kStr += endLine
+    kStr += makeOpenCLWriteCString(kernel, cRow, cCol)
+    return kStr
+
+  kStr += "  uint localSerial = localRow + localCol*WG_NUM_ROWS;" + endLine
 
   ####################################
   # global indices being loaded
@@ -306,6 +445,8 @@ def makeOpenCLKernelString(kernel):
   ####################################
   # loop over k
   kStr += endLine
+  if kernel.rank2k:
+    kStr += "  for (uint sweep = 0; sweep < 2; sweep++) {" + endLine
   kStr += (
     "  /* loop over k */" + endLine +
     "  uint block_k = K / NUM_UNROLL_ITER;" + endLine +
@@ -339,8 +480,8 @@ def makeOpenCLKernelString(kernel):
 
 
   kStr += (
-    "    __local DATA_TYPE_STR *lA = localA + GET_LOCAL_INDEX_A(localARow, localACol);" + endLine +
-    "    __local DATA_TYPE_STR *lB = localB + GET_LOCAL_INDEX_B(localBRow, localBCol);" + endLine +
+    "    __local " + computeType + " *lA = localA + GET_LOCAL_INDEX_A(localARow, localACol);" + endLine +
+    "    __local " + computeType + " *lB = localB + GET_LOCAL_INDEX_B(localBRow, localBCol);" + endLine +
     "    barrier(CLK_LOCAL_MEM_FENCE);" + endLine )
 
   ####################################
@@ -359,37 +500,41 @@ def makeOpenCLKernelString(kernel):
   numBLoadsR = (kernel.workGroupNumCols*kernel.microTileNumCols*kernel.unroll) \
       % (kernel.workGroupNumRows*kernel.workGroupNumCols)
 
-  # TODO - zeroString for real and complex
-  if kernel.precision == "c":
-    zeroString = "(float2)(0.f, 0.f)"
-  elif kernel.precision == "z":
-    zeroString = "(double2)(0.0, 0.0)"
+  # halves are read with LOAD_HALF
+  if half:
+    loadA = "LOAD_HALF( A, GET_GLOBAL_INDEX_A( globalARow(%d), globalACol(%d) ) );%s"
+    loadB = "LOAD_HALF( B, GET_GLOBAL_INDEX_B( globalBRow(%d), globalBCol(%d) ) );%s"
+  elif kernel.rank2k and isComplex(kernel):
+    # complex rank-2k kernels apply the alpha of the sweep to op(A)
+    loadA = "TYPE_SCALE( sweepAlpha, " + opA + "[ GET_GLOBAL_INDEX_A( globalARow(%d), globalACol(%d) ) ] );%s"
+    loadB = opB + "[ GET_GLOBAL_INDEX_B( globalBRow(%d), globalBCol(%d) ) ];%s"
   else:
-    zeroString = "0.0"
+    loadA = opA + "[ GET_GLOBAL_INDEX_A( globalARow(%d), globalACol(%d) ) ];%s"
+    loadB = opB + "[ GET_GLOBAL_INDEX_B( globalBRow(%d), globalBCol(%d) ) ];%s"
   for a in range(0, int(numALoads)):
     kStr += "    lA[ %d*localAStride ] = " % a
     if kernel.isRowKernel():
       kStr += "( globalARow(%d) >= M) ? %s : " % ( a, zeroString )
-    kStr += "A[ GET_GLOBAL_INDEX_A( globalARow(%d), globalACol(%d) ) ];%s" % (a, a, endLine)
+    kStr += loadA % (a, a, endLine)
   if numALoadsR:
     kStr += "    if ( localSerial + " + str(numALoads) + "*WG_NUM_ROWS*WG_NUM_COLS < (WG_NUM_ROWS*MICRO_TILE_NUM_ROWS*NUM_UNROLL_ITER) ) {" + endLine
     kStr += "      lA[ %d*localAStride ] = " % numALoads
     if kernel.isRowKernel():
       kStr += "( globalARow(%d) >= M) ? %s : " % ( numALoads, zeroString )
-    kStr += "A[ GET_GLOBAL_INDEX_A( globalARow(%d), globalACol(%d) ) ];%s" % (numALoads, numALoads, endLine)
+    kStr += loadA % (numALoads, numALoads, endLine)
     kStr += "    }" + endLine
 
   for b in range(0, int(numBLoads)):
     kStr += "    lB[ %d*localBStride ] = " % b
     if kernel.isColKernel():
       kStr += "( globalBCol(%d) >= N) ? %s : " % ( b, zeroString )
-    kStr += "B[ GET_GLOBAL_INDEX_B( globalBRow(%d), globalBCol(%d) ) ];%s" % (b, b, endLine)
+    kStr += loadB % (b, b, endLine)
   if numBLoadsR:
     kStr += "    if ( localSerial + " + str(numBLoads) + "*WG_NUM_ROWS*WG_NUM_COLS < (WG_NUM_COLS*MICRO_TILE_NUM_COLS*NUM_UNROLL_ITER) ) {" + endLine
     kStr += "      lB[ %d*localBStride ] = " % numBLoads
     if kernel.isColKernel():
       kStr += "(globalBCol(%d) >= N) ? %s : " % ( numBLoads, zeroString )
-    kStr += "B[ GET_GLOBAL_INDEX_B( globalBRow(%d), globalBCol(%d) ) ];%s" % (numBLoads, numBLoads, endLine)
+    kStr += loadB % (numBLoads, numBLoads, endLine)
     kStr += "    }" + endLine
   kStr += (
     "    barrier(CLK_LOCAL_MEM_FENCE);" + endLine +
@@ -405,22 +550,15 @@ def makeOpenCLKernelString(kernel):
 
   ####################################
   # shift to next k block
-  kStr += endLine
-  kStr += "    /* shift to next k block */" + endLine
-  if (kernel.order=="clblasColumnMajor")==(kernel.transA=="N"):
-    kStr += "    A += lda*NUM_UNROLL_ITER;" + endLine
-  else:
-    kStr += "    A += NUM_UNROLL_ITER;" + endLine
-  if (kernel.order=="clblasColumnMajor")==(kernel.transB=="N"):
-    kStr += "    B += NUM_UNROLL_ITER;" + endLine
-  else:
-    kStr += "    B += ldb*NUM_UNROLL_ITER;" + endLine
+  kStr += makeOpenCLShiftKString(kernel)
 
   ####################################
   # end loop
   kStr += endLine
   kStr += "  } while (--block_k > 0);" + endLine
   kStr += endLine
+  if kernel.rank2k:
+    kStr += makeOpenCLSwapOperandsString(kernel)
 
   ####################################
   # which global Cij index
@@ -428,35 +566,234 @@ def makeOpenCLKernelString(kernel):
   kStr += "  /* which global Cij index */" + endLine
   kStr += "  uint globalCRow = groupRow * MACRO_TILE_NUM_ROWS + localRow;" + endLine
   kStr += "  uint globalCCol = groupCol * MACRO_TILE_NUM_COLS + localCol;" + endLine
+  kStr += makeOpenCLWriteCString(kernel, cRow, cCol)
+
+  return kStr
+
+
+##############################################################################
+# Shift A and B to the next k block
+##############################################################################
+def makeOpenCLShiftKString(kernel):
+  endLine = "\\n\"\n\""
+  sStr = ""
+  sStr += endLine
+  sStr += "    /* shift to next k block */" + endLine
+  # widened like the GET_GLOBAL_INDEX_* products in 64-bit kernels
+  wide = "(ulong)" if kernel.index64 else ""
+  (opA, opB, ldOpA, ldOpB) = getOperandNames(kernel)
+  if (kernel.order=="clblasColumnMajor")==(kernel.transA=="N"):
+    sStr += "    %s += %s%s*NUM_UNROLL_ITER;%s" % (opA, wide, ldOpA, endLine)
+  else:
+    sStr += "    %s += NUM_UNROLL_ITER;%s" % (opA, endLine)
+  if (kernel.order=="clblasColumnMajor")==(kernel.transB=="N"):
+    sStr += "    %s += NUM_UNROLL_ITER;%s" % (opB, endLine)
+  else:
+    sStr += "    %s += %s%s*NUM_UNROLL_ITER;%s" % (opB, wide, ldOpB, endLine)
+  return sStr
+
+
+##############################################################################
+# Rank-2k kernels: C = alpha*op(A)*op(B) + alpha2*op(B)*op(A) + beta*C in a
+# single pass over C, alpha2 being the conjugate of alpha for HER2K. The loop
+# over k runs twice with the operands swapped, accumulating into the same
+# registers. Complex kernels scale op(A) by the alpha of the sweep as it is
+# loaded and write with alpha = 1; in real ones both alphas are alpha.
+##############################################################################
+def isComplex(kernel):
+  return kernel.precision=="c" or kernel.precision=="z"
+
+def getOperandNames(kernel):
+  if kernel.rank2k:
+    return ("opA", "opB", "ldOpA", "ldOpB")
+  return ("A", "B", "lda", "ldb")
+
+def makeOpenCLScaleString(kernel):
+  endLine = "\\n\"\n\""
+  sStr = ""
+  # a conjugated op(A) is scaled by the conjugate, leaving alpha*conj(a)
+  if kernel.transA=="C":
+    sStr += "#define TYPE_SCALE(S,X) ((DATA_TYPE_STR)( (S).s0*(X).s0 + (S).s1*(X).s1, (S).s0*(X).s1 - (S).s1*(X).s0 ))" + endLine
+  else:
+    sStr += "#define TYPE_SCALE(S,X) ((DATA_TYPE_STR)( (S).s0*(X).s0 - (S).s1*(X).s1, (S).s0*(X).s1 + (S).s1*(X).s0 ))" + endLine
+  return sStr
+
+def makeOpenCLRank2KOperandsString(kernel):
+  endLine = "\\n\"\n\""
+  rStr = ""
+  rStr += endLine
+  rStr += (
+    "  /* operands of the sweeps over k */" + endLine +
+    "  __global DATA_TYPE_STR const *opA = A;" + endLine +
+    "  __global DATA_TYPE_STR const *opB = B;" + endLine +
+    "  uint ldOpA = lda;" + endLine +
+    "  uint ldOpB = ldb;" + endLine )
+  if isComplex(kernel):
+    one = "(float2)(1.f, 0.f)" if kernel.precision=="c" else "(double2)(1.0, 0.0)"
+    rStr += (
+      "  DATA_TYPE_STR sweepAlpha = alpha;" + endLine +
+      "  DATA_TYPE_STR alpha2 = alpha;" + endLine +
+      "  if (realDiagonal) alpha2.s1 = -alpha2.s1;" + endLine +
+      "  DATA_TYPE_STR const writeAlpha = " + one + ";" + endLine )
+  return rStr
+
+def makeOpenCLSwapOperandsString(kernel):
+  endLine = "\\n\"\n\""
+  sStr = ""
+  sStr += (
+    "  /* second sweep: op(B)*op(A) */" + endLine +
+    "  opA = B;" + endLine +
+    "  opB = A;" + endLine +
+    "  ldOpA = ldb;" + endLine +
+    "  ldOpB = lda;" + endLine )
+  if isComplex(kernel):
+    sStr += "  sweepAlpha = alpha2;" + endLine
+  sStr += "  }" + endLine
+  return sStr
 
+
+##############################################################################
+# Write the micro-tile of a work item to C and end the kernel; cRow and cCol
+# give the row and column of its elements
+##############################################################################
+def makeOpenCLWriteCString(kernel, cRow, cCol):
+  endLine = "\\n\"\n\""
+  half = kernel.precision in AutoGemmParameters.halfPrecisions
+  alpha = "writeAlpha" if kernel.rank2k and isComplex(kernel) else "alpha"
+  wStr = ""
   ####################################
   # write global Cij
-  kStr += endLine
-  kStr += "  /* write global Cij */" + endLine
+  wStr += endLine
+  wStr += "  /* write global Cij */" + endLine
   if kernel.precision=="c":
-    kStr += "  float type_mad_tmp;" + endLine
+    wStr += "  float type_mad_tmp;" + endLine
   if kernel.precision=="z":
-    kStr += "  double type_mad_tmp;" + endLine
+    wStr += "  double type_mad_tmp;" + endLine
 
   for a in range(0, int(kernel.microTileNumRows)):
     for b in range(0, int(kernel.microTileNumCols)):
+      row = cRow(a)
+      col = cCol(b)
       if kernel.isRowKernel():
-        kStr += "  if (globalCRow+%d*WG_NUM_ROWS < M)" % a
+        wStr += "  if (%s < M)" % row
       if kernel.isColKernel():
-        kStr += "  if (globalCCol+%d*WG_NUM_COLS < N)" % b
-      if kernel.isRowKernel() or kernel.isColKernel():
-        kStr += "{"
-      kStr += "  TYPE_MAD_WRITE( C[ GET_GLOBAL_INDEX_C( globalCRow+%d*WG_NUM_ROWS, globalCCol+%d*WG_NUM_COLS) ], alpha, rC[%d][%d], beta )" % (a, b, a, b)
-      if kernel.isRowKernel() or kernel.isColKernel():
-        kStr += "}"
-      kStr += endLine
+        wStr += "  if (%s < N)" % col
+      if kernel.triangular:
+        wStr += "  if (!diagonalTile || IN_TRIANGLE(%s, %s))" % (row, col)
+      if kernel.isRowKernel() or kernel.isColKernel() or kernel.triangular:
+        wStr += "{"
+      if half:
+        wStr += "  TYPE_MAD_WRITE( GET_GLOBAL_INDEX_C( %s, %s), alpha, rC[%d][%d], beta )" % (row, col, a, b)
+      elif kernel.epilogue:
+        wStr += "  TYPE_MAD_WRITE( C[ GET_GLOBAL_INDEX_C( %s, %s) ], alpha, rC[%d][%d], beta, %s, %s )" % (row, col, a, b, row, col)
+      else:
+        wStr += "  TYPE_MAD_WRITE( C[ GET_GLOBAL_INDEX_C( %s, %s) ], %s, rC[%d][%d], beta )" % (row, col, alpha, a, b)
+      # HERK and HER2K leave no rounding residue in the imaginary part
+      # of the diagonal
+      if kernel.triangular and (kernel.precision=="c" or kernel.precision=="z"):
+        wStr += " if (realDiagonal && diagonalTile && %s == %s) C[ GET_GLOBAL_INDEX_C( %s, %s) ].s1 = 0;" % (row, col, row, col)
+      if kernel.isRowKernel() or kernel.isColKernel() or kernel.triangular:
+        wStr += "}"
+      wStr += endLine
 
   ####################################
   # end kernel
-  kStr += endLine
-  kStr += "}" + endLine
+  wStr += endLine
+  wStr += "}" + endLine
+
+  return wStr
 
-  return kStr
+
+##############################################################################
+# Data types of half precision kernels
+# - loads convert halves to COMPUTE_TYPE_STR, which is half only when built
+#   with -DHALF_ARITHMETIC; otherwise only the conversions of the core
+#   language are needed, so devices without cl_khr_fp16 run them too
+# - TYPE_MAD_WRITE takes the index of the C element rather than the element
+##############################################################################
+def makeOpenCLHalfTypesString(kernel):
+  endLine = "\\n\"\n\""
+  hStr = ""
+  hStr += (
+    "#ifdef HALF_ARITHMETIC" + endLine +
+    "#define COMPUTE_TYPE_STR half" + endLine +
+    "#define LOAD_HALF(PTR,IDX) (PTR)[IDX]" + endLine +
+    "#else" + endLine +
+    "#define COMPUTE_TYPE_STR float" + endLine +
+    "#define LOAD_HALF(PTR,IDX) vload_half( (IDX), (PTR) )" + endLine +
+    "#endif" + endLine +
+    "#define TYPE_MAD(MULA,MULB,DST) DST = mad(MULA,MULB,DST);" + endLine )
+  if kernel.precision == "h":
+    hStr += "#define C_TYPE_STR half" + endLine
+    if kernel.beta==1:
+      hStr += (
+        "#ifdef HALF_ARITHMETIC" + endLine +
+        "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) C[IDX] = (ALPHA)*(REG) + (BETA)*C[IDX];" + endLine +
+        "#else" + endLine +
+        "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) vstore_half_rte( (ALPHA)*(REG) + (BETA)*vload_half( (IDX), C ), (IDX), C );" + endLine +
+        "#endif" + endLine )
+    else:
+      hStr += (
+        "#ifdef HALF_ARITHMETIC" + endLine +
+        "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) C[IDX] = (ALPHA)*(REG);" + endLine +
+        "#else" + endLine +
+        "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) vstore_half_rte( (ALPHA)*(REG), (IDX), C );" + endLine +
+        "#endif" + endLine )
+  else:
+    hStr += "#define C_TYPE_STR float" + endLine
+    if kernel.beta==1:
+      hStr += "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) C[IDX] = (ALPHA)*(REG) + (BETA)*C[IDX];" + endLine
+    else:
+      hStr += "#define TYPE_MAD_WRITE(IDX,ALPHA,REG,BETA) C[IDX] = (ALPHA)*(REG);" + endLine
+  return hStr
+
+
+##############################################################################
+# Fused epilogue of real precision kernels
+# - applied to each element of C as it is written
+# - the kind is selected at build time with -DEPILOGUE_BIAS, -DEPILOGUE_SCALE,
+#   -DEPILOGUE_ACTIVATION and -DEPILOGUE_CLAMP; 0 or undefined disables a
+#   stage, 1 and 2 index vectors by row or column of C
+##############################################################################
+def makeOpenCLEpilogueString(kernel):
+  endLine = "\\n\"\n\""
+  eStr = ""
+  eStr += endLine
+  eStr += "/* fused epilogue */" + endLine
+  for stage in [ "EPILOGUE_BIAS", "EPILOGUE_SCALE", "EPILOGUE_ACTIVATION", "EPILOGUE_CLAMP" ]:
+    eStr += (
+      "#ifndef " + stage + endLine +
+      "#define " + stage + " 0" + endLine +
+      "#endif" + endLine )
+  eStr += (
+    "#if EPILOGUE_BIAS == 1" + endLine +
+    "#define EPILOGUE_ADD_BIAS(X,ROW,COL) ((X) + epilogueBias[ROW])" + endLine +
+    "#elif EPILOGUE_BIAS == 2" + endLine +
+    "#define EPILOGUE_ADD_BIAS(X,ROW,COL) ((X) + epilogueBias[COL])" + endLine +
+    "#else" + endLine +
+    "#define EPILOGUE_ADD_BIAS(X,ROW,COL) (X)" + endLine +
+    "#endif" + endLine +
+    "#if EPILOGUE_SCALE == 1" + endLine +
+    "#define EPILOGUE_ALPHA(ALPHA,ROW,COL) ((ALPHA)*epilogueScale[ROW])" + endLine +
+    "#elif EPILOGUE_SCALE == 2" + endLine +
+    "#define EPILOGUE_ALPHA(ALPHA,ROW,COL) ((ALPHA)*epilogueScale[COL])" + endLine +
+    "#else" + endLine +
+    "#define EPILOGUE_ALPHA(ALPHA,ROW,COL) (ALPHA)" + endLine +
+    "#endif" + endLine +
+    "#if EPILOGUE_ACTIVATION == 1" + endLine +
+    "#define EPILOGUE_ACTIVATE(X) fmax( (X), (DATA_TYPE_STR)0 )" + endLine +
+    "#elif EPILOGUE_ACTIVATION == 2" + endLine +
+    "#define EPILOGUE_ACTIVATE(X) ( (DATA_TYPE_STR)0.5*(X)*( (DATA_TYPE_STR)1 + erf( (X)*(DATA_TYPE_STR)0.70710678118654752 ) ) )" + endLine +
+    "#else" + endLine +
+    "#define EPILOGUE_ACTIVATE(X) (X)" + endLine +
+    "#endif" + endLine +
+    "#if EPILOGUE_CLAMP" + endLine +
+    "#define EPILOGUE_CLAMP_TO(X) clamp( (X), clampLow, clampHigh )" + endLine +
+    "#else" + endLine +
+    "#define EPILOGUE_CLAMP_TO(X) (X)" + endLine +
+    "#endif" + endLine +
+    "#define EPILOGUE(X,ROW,COL) EPILOGUE_CLAMP_TO( EPILOGUE_ACTIVATE( EPILOGUE_ADD_BIAS(X,ROW,COL) ) )" + endLine )
+  return eStr
 
 
 ##############################################################################
@@ -487,6 +824,38 @@ def writeOpenCLKernelToFile(kernel):
   kernelFile.close()
 
 
+##############################################################################
+# Write the kernels of a family with fixed tiles; returns the kernel count
+##############################################################################
+def writeOpenCLKernelFamily(kernel, precisions, transposes, getTiles):
+  numKernels = 0
+  for precision in precisions:
+    kernel.precision = precision
+    for order in AutoGemmParameters.orders:
+      kernel.order = order
+      for transA in transposes[precision]:
+        kernel.transA = transA
+        for transB in transposes[precision]:
+          kernel.transB = transB
+          for beta in AutoGemmParameters.betas:
+            kernel.beta = beta
+            for tile in getTiles(precision):
+              kernel.useTile(tile)
+              writeOpenCLKernelToFile(kernel)
+              rowKernel = copy.copy(kernel)
+              rowKernel.macroTileNumRows = 1
+              writeOpenCLKernelToFile(rowKernel)
+              colKernel = copy.copy(kernel)
+              colKernel.macroTileNumCols = 1
+              writeOpenCLKernelToFile(colKernel)
+              cornerKernel = copy.copy(kernel)
+              cornerKernel.macroTileNumRows = 1
+              cornerKernel.macroTileNumCols = 1
+              writeOpenCLKernelToFile(cornerKernel)
+              numKernels += 4
+  return numKernels
+
+
 ##############################################################################
 # Write OpenCL kernel to file
 ##############################################################################
@@ -535,6 +904,48 @@ def writeOpenCLKernels():
               cornerKernel.macroTileNumCols = 1
               writeOpenCLKernelToFile(cornerKernel)
               numKernels += 4
+
+  # fused epilogue variants
+  kernel = KernelParameters.KernelParameters()
+  kernel.epilogue = True
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.epiloguePrecisions, AutoGemmParameters.transposes, \
+      AutoGemmParameters.getEpilogueTilesForPrecision)
+
+  # 64-bit index variants
+  kernel = KernelParameters.KernelParameters()
+  kernel.index64 = True
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.index64Precisions, AutoGemmParameters.transposes, \
+      AutoGemmParameters.getIndex64TilesForPrecision)
+
+  # triangular variants
+  kernel = KernelParameters.KernelParameters()
+  kernel.triangular = True
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.triangularPrecisions, AutoGemmParameters.transposes, \
+      AutoGemmParameters.getTriangularTilesForPrecision)
+
+  # triangular rank-2k variants
+  kernel = KernelParameters.KernelParameters()
+  kernel.triangular = True
+  kernel.rank2k = True
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.triangularPrecisions, AutoGemmParameters.transposes, \
+      AutoGemmParameters.getTriangularTilesForPrecision)
+
+  # half precision
+  kernel = KernelParameters.KernelParameters()
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.halfPrecisions, AutoGemmParameters.halfTransposes, \
+      AutoGemmParameters.getHalfTilesForPrecision)
+
+  # register-blocked kernels of CPU devices
+  kernel = KernelParameters.KernelParameters()
+  kernel.cpu = True
+  numKernels += writeOpenCLKernelFamily(kernel, \
+      AutoGemmParameters.precisions, AutoGemmParameters.transposes, \
+      AutoGemmParameters.getCPUTilesForPrecision)
   print("AutoGemm.py: generated %d kernels" % numKernels)
 
 
@@ -544,7 +955,7 @@ def writeOpenCLKernels():
 ################################################################################
 if __name__ == "__main__":
   ap = argparse.ArgumentParser(description="KernelOpenCL")
-  ap.add_argument("precision", choices=["s","d","c","z"], help="precision" )
+  ap.add_argument("precision", choices=["s","d","c","z","h","hs"], help="precision" )
   ap.add_argument("order", choices=["row","col"], help="order: row major or column major" )
   ap.add_argument("transA", choices=["N","T", "C"], help="transA" )
   ap.add_argument("transB", choices=["N","T", "C"], help="transB" )
@@ -203,6 +203,11 @@ class NonTileParameters:
     self.transA = ""     # N, T, C
     self.transB = ""     # N, T, C
     self.beta = -1       # 0, 1
+    self.epilogue = False # fused epilogue variant
+    self.index64 = False  # 64-bit offsets and index arithmetic
+    self.triangular = False # macro tiles of one triangle of C only
+    self.rank2k = False   # triangular, adds op(B)*op(A) in a second sweep
+    self.cpu = False      # registers only, no local memory staging
 
   def printAttributes(self):
     print("precision = " + self.precision)
@@ -210,6 +215,11 @@ class NonTileParameters:
     print("transA    = " + self.transA)
     print("transB    = " + self.transB)
     print("beta      = %d" % self.beta)
+    print("epilogue  = %s" % self.epilogue)
+    print("index64   = %s" % self.index64)
+    print("triangular = %s" % self.triangular)
+    print("rank2k    = %s" % self.rank2k)
+    print("cpu       = %s" % self.cpu)
 
   ##############################################################################
   # NonTile - get Name
@@ -257,13 +267,17 @@ class KernelParameters( NonTileParameters, TileParameters ):
   ##############################################################################
   def getName(self):
     return NonTileParameters.getName(self) \
-        + "_" + TileParameters.getName(self)
+        + "_" + TileParameters.getName(self) + self.getVariantSuffix()
   def getRowName(self):
     return NonTileParameters.getName(self) \
-        + "_" + TileParameters.getRowName(self)
+        + "_" + TileParameters.getRowName(self) + self.getVariantSuffix()
   def getColName(self):
     return NonTileParameters.getName(self) \
-        + "_" + TileParameters.getColName(self)
+        + "_" + TileParameters.getColName(self) + self.getVariantSuffix()
   def getCornerName(self):
     return NonTileParameters.getName(self) \
-        + "_" + TileParameters.getCornerName(self)
+        + "_" + TileParameters.getCornerName(self) + self.getVariantSuffix()
+  def getVariantSuffix(self):
+    return ("_EP" if self.epilogue else "") + ("_64" if self.index64 else "") \
+        + ("_TRI" if self.triangular else "") + ("2K" if self.rank2k else "") \
+        + ("_CPU" if self.cpu else "")
@@ -12,6 +12,8 @@ def indent(il):
     returnTabs += "  "
   return returnTabs
 
+transposeEnum = { "N":"clblasNoTrans", "T":"clblasTrans", "C":"clblasConjTrans" }
+
 def tileInRange( tileMin, tileMax, rangeMin, rangeMax):
   if ( tileMax < 0 or (tileMax >= rangeMax and rangeMax>0) ) and tileMin <= rangeMin :
     valid = True
@@ -41,7 +43,9 @@ class KernelSelection:
       transDict, \
       betaList, \
       unrollDict, \
-      kernelSelectionData):
+      kernelSelectionData, \
+      kernelSelectionDataCPU, \
+      unrollDictCPU):
 
     self.incFileName = Common.getIncludePath() + "AutoGemmKernelSelection.h"
     self.incFile = open(self.incFileName, "w")
@@ -62,9 +66,10 @@ class KernelSelection:
       "\n"
       "#define EXACT_MULTIPLES(MULTIPLE_STR) MULTIPLE_STR\n"
       "\n"
-      "// kernel selection logic template\n"
-      "template<typename Precision>\n"
-      "void gemmSelectKernel(\n"
+      )
+
+    # parameters of selection functions
+    selectionParameters = (
       "  clblasOrder order,\n"
       "  clblasTranspose transA,\n"
       "  clblasTranspose transB,\n"
@@ -96,187 +101,347 @@ class KernelSelection:
       "  unsigned int *microTileNumRows,\n"
       "  unsigned int *microTileNumCols,\n"
       "  unsigned int *unroll\n"
+      )
+
+    self.inc += (
+      "// kernel selection function type\n"
+      "typedef void (*GemmSelectKernelFunc)(\n"
+      + selectionParameters +
       ");\n\n" )
 
-    self.logic = "#include \"" + Common.getRelativeIncludePath() + "AutoGemmKernelSelection.h\"\n"
+    # GPU and CPU devices select kernels with their own tables; CPU devices
+    # run the "_CPU" family
+    selections = [ \
+        ( "gemmSelectKernel", kernelSelectionData, False, unrollDict ), \
+        ( "gemmSelectKernelCPU", kernelSelectionDataCPU, True, unrollDictCPU ) ]
+    for selection in selections:
+      self.inc += (
+        "// kernel selection logic template\n"
+        "template<typename Precision>\n"
+        "void " + selection[0] + "(\n"
+        + selectionParameters +
+        ");\n\n" )
+
+    # fused epilogue kernels; a single tile chosen by K alone
+    self.inc += (
+      "// fused epilogue kernel selection template\n"
+      "template<typename Precision>\n"
+      "void gemmSelectKernelEpilogue(\n"
+      + selectionParameters +
+      ");\n\n" )
 
-    ####################################
-    # precision
-    kernel = KernelParameters.KernelParameters()
-    for precision in precisionList:
-      #self.selectionFile.write( self.logic )
-      #self.logic = ""
-      kernel.precision = precision
-      sizeEvents = kernelSelectionData[precision]
-      self.logic += (
-          "\n// " + precision + "gemm kernel selection logic\n"
-          "template<>\n"
-          "void gemmSelectKernel<" )
-      if precision == "s":
-        self.logic += "float"
-      elif precision == "d":
-        self.logic += "double"
-      elif precision == "c":
-        self.logic += "FloatComplex"
-      else:
-        self.logic += "DoubleComplex"
+    # 64-bit index kernels; a single tile chosen by K alone
+    self.inc += (
+      "// 64-bit index kernel selection template\n"
+      "template<typename Precision>\n"
+      "void gemmSelectKernel64(\n"
+      + selectionParameters +
+      ");\n\n" )
 
-      self.logic += (
-          ">(\n"
-          "  clblasOrder order,\n"
-          "  clblasTranspose transA,\n"
-          "  clblasTranspose transB,\n"
-          "  size_t M,\n"
-          "  size_t N,\n"
-          "  size_t K,\n"
-          "  bool betaNonZero,\n"
-          "  float optimalNumElementsPerWorkItem,\n"
-          "  const char **tileKernelSource,\n"
-          "  const char **rowKernelSource,\n"
-          "  const char **colKernelSource,\n"
-          "  const char **cornerKernelSource,\n"
-          "  const char **sourceBuildOptions,\n"
-          "  const unsigned char **tileKernelBinary,\n"
-          "  const unsigned char **rowKernelBinary,\n"
-          "  const unsigned char **colKernelBinary,\n"
-          "  const unsigned char **cornerKernelBinary,\n"
-          "  size_t **tileKernelBinarySize,\n"
-          "  size_t **rowKernelBinarySize,\n"
-          "  size_t **colKernelBinarySize,\n"
-          "  size_t **cornerKernelBinarySize,\n"
-          "  const char **binaryBuildOptions,\n"
-          "  cl_kernel  **tileClKernel,\n"
-          "  cl_kernel  **rowClKernel,\n"
-          "  cl_kernel  **colClKernel,\n"
-          "  cl_kernel  **cornerClKernel,\n"
-          "  unsigned int *workGroupNumRows,\n"
-          "  unsigned int *workGroupNumCols,\n"
-          "  unsigned int *microTileNumRows,\n"
-          "  unsigned int *microTileNumCols,\n"
-          "  unsigned int *unroll\n"
-          ") {\n" )
+    # triangular kernels of the SYRK family; a single tile chosen by K alone
+    self.inc += (
+      "// triangular kernel selection template\n"
+      "template<typename Precision>\n"
+      "void gemmSelectKernelTriangular(\n"
+      + selectionParameters +
+      ");\n\n" )
+
+    # triangular rank-2k kernels of SYR2K and HER2K, same tiles
+    self.inc += (
+      "// triangular rank-2k kernel selection template\n"
+      "template<typename Precision>\n"
+      "void gemmSelectKernelTriangular2K(\n"
+      + selectionParameters +
+      ");\n\n" )
+
+    # half precision kernels of clblasHgemm and clblasGemmEx
+    for precision in AutoGemmParameters.halfPrecisions:
+      self.inc += (
+        "// " + precision + "gemm kernel selection\n"
+        "void " + precision + "gemmSelectKernel(\n"
+        + selectionParameters +
+        ");\n\n" )
+
+    self.logic = "#include \"" + Common.getRelativeIncludePath() + "AutoGemmKernelSelection.h\"\n"
 
+    for selection in selections:
       ####################################
-      # order
-      for order in orderList:
-        #print(precision + "gemm" + "_" + order)
-        kernel.order = order
-        self.logic += indent(1) + "if (order == " + order + ") {\n"
-        transList = transDict[precision]
+      # precision
+      kernel = KernelParameters.KernelParameters()
+      kernel.cpu = selection[2]
+      for precision in precisionList:
+        #self.selectionFile.write( self.logic )
+        #self.logic = ""
+        kernel.precision = precision
+        sizeEvents = selection[1][precision]
+        self.logic += (
+            "\n// " + precision + "gemm kernel selection logic\n"
+            "template<>\n"
+            "void " + selection[0] + "<" )
+        if precision == "s":
+          self.logic += "float"
+        elif precision == "d":
+          self.logic += "double"
+        elif precision == "c":
+          self.logic += "FloatComplex"
+        else:
+          self.logic += "DoubleComplex"
+
+        self.logic += (
+            ">(\n"
+            "  clblasOrder order,\n"
+            "  clblasTranspose transA,\n"
+            "  clblasTranspose transB,\n"
+            "  size_t M,\n"
+            "  size_t N,\n"
+            "  size_t K,\n"
+            "  bool betaNonZero,\n"
+            "  float optimalNumElementsPerWorkItem,\n"
+            "  const char **tileKernelSource,\n"
+            "  const char **rowKernelSource,\n"
+            "  const char **colKernelSource,\n"
+            "  const char **cornerKernelSource,\n"
+            "  const char **sourceBuildOptions,\n"
+            "  const unsigned char **tileKernelBinary,\n"
+            "  const unsigned char **rowKernelBinary,\n"
+            "  const unsigned char **colKernelBinary,\n"
+            "  const unsigned char **cornerKernelBinary,\n"
+            "  size_t **tileKernelBinarySize,\n"
+            "  size_t **rowKernelBinarySize,\n"
+            "  size_t **colKernelBinarySize,\n"
+            "  size_t **cornerKernelBinarySize,\n"
+            "  const char **binaryBuildOptions,\n"
+            "  cl_kernel  **tileClKernel,\n"
+            "  cl_kernel  **rowClKernel,\n"
+            "  cl_kernel  **colClKernel,\n"
+            "  cl_kernel  **cornerClKernel,\n"
+            "  unsigned int *workGroupNumRows,\n"
+            "  unsigned int *workGroupNumCols,\n"
+            "  unsigned int *microTileNumRows,\n"
+            "  unsigned int *microTileNumCols,\n"
+            "  unsigned int *unroll\n"
+            ") {\n" )
 
         ####################################
-        # transA
-        for transA in transList:
-          #print(precision + "gemm" + "_" + order + "_" + transA)
-          kernel.transA = transA
-          self.logic += indent(2) + "if (transA == "
-          if transA == "N":
-            self.logic += "clblasNoTrans"
-          elif transA == "T":
-            self.logic += "clblasTrans"
-          else:
-            self.logic += "clblasConjTrans"
-          self.logic += ") {\n"
+        # order
+        for order in orderList:
+          #print(precision + "gemm" + "_" + order)
+          kernel.order = order
+          self.logic += indent(1) + "if (order == " + order + ") {\n"
+          transList = transDict[precision]
 
           ####################################
-          # transB
-          for transB in transList:
-            kernel.transB = transB
-            self.logic += indent(3) + "if (transB == "
-            if transB == "N":
+          # transA
+          for transA in transList:
+            #print(precision + "gemm" + "_" + order + "_" + transA)
+            kernel.transA = transA
+            self.logic += indent(2) + "if (transA == "
+            if transA == "N":
               self.logic += "clblasNoTrans"
-            elif transB == "T":
+            elif transA == "T":
               self.logic += "clblasTrans"
             else:
               self.logic += "clblasConjTrans"
             self.logic += ") {\n"
 
             ####################################
-            # beta
-            for beta in betaList:
-              #print(precision + "gemm" + "_" + order + "_" + transA + "_" + transB + "_B" + str(beta))
-              kernel.beta = beta
-              self.logic += indent(4) + "if ( "
-              if beta == 0:
-                self.logic += "!betaNonZero"
+            # transB
+            for transB in transList:
+              kernel.transB = transB
+              self.logic += indent(3) + "if (transB == "
+              if transB == "N":
+                self.logic += "clblasNoTrans"
+              elif transB == "T":
+                self.logic += "clblasTrans"
               else:
-                self.logic += "betaNonZero"
-              self.logic += " ) {\n"
+                self.logic += "clblasConjTrans"
+              self.logic += ") {\n"
 
               ####################################
-              # if size event
-              for sizeEvent in sizeEvents:
-                self.selectionFile.write( self.logic )
-                self.logic = ""
-                sizeMin = sizeEvent[0]
-                fallbackTile = sizeEvent[1]
-                validTiles = sizeEvent[2]
-                self.logic += indent(5)+"if ( M*N >= "+str(sizeMin)+"*"+str(sizeMin) + ") {\n"
-                #print(precision + "gemm" + "_" + order + "_" + transA + "_" + transB + "_B" + str(beta) + "_" + str(sizeMin) + "->" + str(sizeMax))
+              # beta
+              for beta in betaList:
+                #print(precision + "gemm" + "_" + order + "_" + transA + "_" + transB + "_B" + str(beta))
+                kernel.beta = beta
+                self.logic += indent(4) + "if ( "
+                if beta == 0:
+                  self.logic += "!betaNonZero"
+                else:
+                  self.logic += "betaNonZero"
+                self.logic += " ) {\n"
 
                 ####################################
-                # valid tiles
-                self.logic += indent(6)+"// valid tiles\n"
-                for tileParams in validTiles:
-                  kernel.workGroupNumRows = tileParams[0]
-                  kernel.workGroupNumCols = tileParams[1]
-                  kernel.microTileNumRows = tileParams[2]
-                  kernel.microTileNumCols = tileParams[3]
+                # if size event
+                for sizeEvent in sizeEvents:
+                  self.selectionFile.write( self.logic )
+                  self.logic = ""
+                  sizeMin = sizeEvent[0]
+                  fallbackTile = sizeEvent[1]
+                  validTiles = sizeEvent[2]
+                  self.logic += indent(5)+"if ( M*N >= "+str(sizeMin)+"*"+str(sizeMin) + ") {\n"
+                  #print(precision + "gemm" + "_" + order + "_" + transA + "_" + transB + "_B" + str(beta) + "_" + str(sizeMin) + "->" + str(sizeMax))
+
+                  ####################################
+                  # valid tiles
+                  self.logic += indent(6)+"// valid tiles\n"
+                  for tileParams in validTiles:
+                    kernel.workGroupNumRows = tileParams[0]
+                    kernel.workGroupNumCols = tileParams[1]
+                    kernel.microTileNumRows = tileParams[2]
+                    kernel.microTileNumCols = tileParams[3]
+                    kernel.macroTileNumRows = kernel.workGroupNumRows*kernel.microTileNumRows
+                    kernel.macroTileNumCols = kernel.workGroupNumCols*kernel.microTileNumCols
+                    for unroll in selection[3][precision]:
+                      kernel.unroll = unroll
+                      self.logic += indent(6)+"if ( M%%%d == 0 && N%%%d == 0 && K%%%d == 0) {\n" \
+                          % (kernel.getMultipleM(), kernel.getMultipleN(), kernel.getMultipleK())
+                      self.addBodyForKernel( kernel )
+                      self.logic += indent(6) + "}\n"
+
+                  ####################################
+                  # fallback tile - TODO all tiles begin added
+                  self.logic += indent(6)+"// fallback tile\n"
+                  #print("\nFallback[%i, %i]"%(sizeMin, sizeMax))
+                  kernel.workGroupNumRows = fallbackTile[0]
+                  kernel.workGroupNumCols = fallbackTile[1]
+                  kernel.microTileNumRows = fallbackTile[2]
+                  kernel.microTileNumCols = fallbackTile[3]
                   kernel.macroTileNumRows = kernel.workGroupNumRows*kernel.microTileNumRows
                   kernel.macroTileNumCols = kernel.workGroupNumCols*kernel.microTileNumCols
-                  for unroll in unrollDict[precision]:
+                  for unroll in selection[3][precision]:
                     kernel.unroll = unroll
-                    self.logic += indent(6)+"if ( M%%%d == 0 && N%%%d == 0 && K%%%d == 0) {\n" \
-                        % (kernel.getMultipleM(), kernel.getMultipleN(), kernel.getMultipleK())
+                    self.logic += indent(6)+"if ( K%%%d == 0 ) {\n" \
+                        % (kernel.getMultipleK())
                     self.addBodyForKernel( kernel )
                     self.logic += indent(6) + "}\n"
 
-                ####################################
-                # fallback tile - TODO all tiles begin added
-                self.logic += indent(6)+"// fallback tile\n"
-                #print("\nFallback[%i, %i]"%(sizeMin, sizeMax))
-                kernel.workGroupNumRows = fallbackTile[0]
-                kernel.workGroupNumCols = fallbackTile[1]
-                kernel.microTileNumRows = fallbackTile[2]
-                kernel.microTileNumCols = fallbackTile[3]
-                kernel.macroTileNumRows = kernel.workGroupNumRows*kernel.microTileNumRows
-                kernel.macroTileNumCols = kernel.workGroupNumCols*kernel.microTileNumCols
-                for unroll in unrollDict[precision]:
-                  kernel.unroll = unroll
-                  self.logic += indent(6)+"if ( K%%%d == 0 ) {\n" \
-                      % (kernel.getMultipleK())
-                  self.addBodyForKernel( kernel )
-                  self.logic += indent(6) + "}\n"
+                  ####################################
+                  # end size event
+                  self.logic += indent(5) + "} // end size\n"
 
                 ####################################
-                # end size event
-                self.logic += indent(5) + "} // end size\n"
+                # end beta
+                self.logic += indent(4) + "} // end beta\n"
 
               ####################################
-              # end beta
-              self.logic += indent(4) + "} // end beta\n"
+              # end transB
+              self.logic += indent(3) + "} // end transB\n"
 
             ####################################
-            # end transB
-            self.logic += indent(3) + "} // end transB\n"
+            # end transA
+            self.logic += indent(2) + "} // end transA\n"
 
           ####################################
-          # end transA
-          self.logic += indent(2) + "} // end transA\n"
+          # end order
+          self.logic += indent(1) + "} // end order\n"
 
         ####################################
-        # end order
-        self.logic += indent(1) + "} // end order\n"
+        # end precision
+        self.logic += indent(0) + "} // end precision function\n"
+    ####################################
+    # fused epilogue selection
+    kernel = KernelParameters.KernelParameters()
+    kernel.epilogue = True
+    for precision in precisionList:
+      kernel.precision = precision
+      self.logic += (
+          "\n// " + precision + "gemm fused epilogue kernel selection\n"
+          "template<>\n"
+          "void gemmSelectKernelEpilogue<" + Common.hostPrecisionType[precision] + ">(\n"
+          + selectionParameters +
+          ") {\n" )
+      epilogueTiles = AutoGemmParameters.getEpilogueTilesForPrecision(precision)
+      if len(epilogueTiles) == 0:
+        self.logic += indent(1) + "// no fused epilogue kernels for this precision\n"
+      else:
+        self.addFixedTileSelection(kernel, epilogueTiles, orderList, \
+            transDict[precision], betaList)
+      self.logic += indent(0) + "} // end precision function\n"
 
-      ####################################
-      # end precision
+    ####################################
+    # 64-bit index selection
+    kernel = KernelParameters.KernelParameters()
+    kernel.index64 = True
+    for precision in precisionList:
+      kernel.precision = precision
+      self.logic += (
+          "\n// " + precision + "gemm 64-bit index kernel selection\n"
+          "template<>\n"
+          "void gemmSelectKernel64<" + Common.hostPrecisionType[precision] + ">(\n"
+          + selectionParameters +
+          ") {\n" )
+      self.addFixedTileSelection(kernel, \
+          AutoGemmParameters.getIndex64TilesForPrecision(precision), \
+          orderList, transDict[precision], betaList)
+      self.logic += indent(0) + "} // end precision function\n"
+
+    ####################################
+    # triangular selection, single and rank-2k
+    for rank2k in [ False, True ]:
+      kernel = KernelParameters.KernelParameters()
+      kernel.triangular = True
+      kernel.rank2k = rank2k
+      for precision in precisionList:
+        kernel.precision = precision
+        self.logic += (
+            "\n// " + precision + "gemm triangular" + (" rank-2k" if rank2k else "") + " kernel selection\n"
+            "template<>\n"
+            "void gemmSelectKernelTriangular" + ("2K" if rank2k else "") + "<" + Common.hostPrecisionType[precision] + ">(\n"
+            + selectionParameters +
+            ") {\n" )
+        self.addFixedTileSelection(kernel, \
+            AutoGemmParameters.getTriangularTilesForPrecision(precision), \
+            orderList, transDict[precision], betaList)
+        self.logic += indent(0) + "} // end precision function\n"
+
+    ####################################
+    # half precision selection
+    kernel = KernelParameters.KernelParameters()
+    for precision in AutoGemmParameters.halfPrecisions:
+      kernel.precision = precision
+      self.logic += (
+          "\n// " + precision + "gemm kernel selection\n"
+          "void " + precision + "gemmSelectKernel(\n"
+          + selectionParameters +
+          ") {\n" )
+      self.addFixedTileSelection(kernel, \
+          AutoGemmParameters.getHalfTilesForPrecision(precision), orderList, \
+          AutoGemmParameters.halfTransposes[precision], betaList)
       self.logic += indent(0) + "} // end precision function\n"
+
     # write last precision
     self.selectionFile.write( self.logic )
     self.selectionFile.write( "\n" )
 
 
 
+  ##############################################################################
+  # KSL - selection among fixed tiles, by the first unroll dividing K
+  ##############################################################################
+  def addFixedTileSelection( self, kernel, tiles, orderList, transList, betaList ):
+    for order in orderList:
+      kernel.order = order
+      self.logic += indent(1) + "if (order == " + order + ") {\n"
+      for transA in transList:
+        kernel.transA = transA
+        self.logic += indent(2) + "if (transA == " + transposeEnum[transA] + ") {\n"
+        for transB in transList:
+          kernel.transB = transB
+          self.logic += indent(3) + "if (transB == " + transposeEnum[transB] + ") {\n"
+          for beta in betaList:
+            kernel.beta = beta
+            self.logic += indent(4) + "if ( " + ("betaNonZero" if beta else "!betaNonZero") + " ) {\n"
+            for tile in tiles:
+              kernel.useTile(tile)
+              self.logic += indent(6) + "if ( K%%%d == 0 ) {\n" % (kernel.getMultipleK())
+              self.addBodyForKernel( kernel )
+              self.logic += indent(6) + "}\n"
+            self.logic += indent(4) + "} // end beta\n"
+          self.logic += indent(3) + "} // end transB\n"
+        self.logic += indent(2) + "} // end transA\n"
+      self.logic += indent(1) + "} // end order\n"
+
+
+
   def addBodyForKernel( self, kernel ):
     #self.logic += indent(7) + "printf(\"selected kernel: " + kernel.getName() + "\\n\");\n"
     self.logic += indent(7) + "*tileKernelSource       =  " + kernel.getName()       + "_src;\n"
@@ -666,7 +831,9 @@ def writeKernelSelection():
       AutoGemmParameters.transposes, \
       AutoGemmParameters.betas, \
       AutoGemmParameters.unrolls, \
-      AutoGemmParameters.kernelSelectionData )
+      AutoGemmParameters.kernelSelectionData, \
+      AutoGemmParameters.kernelSelectionDataCPU, \
+      AutoGemmParameters.unrollsCPU )
   ks.writeToFile()
 
 
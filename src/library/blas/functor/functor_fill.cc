@@ -25,6 +25,7 @@
 
 #include <functor_fill.h>
 #include <binary_lookup.h>
+#include <statistics.h>
 
 // The internal cache of clblasFill2DFunctorFallback
 typedef clblasFunctorCache<clblasFill2DFunctorDefault, int> Cache;
@@ -103,6 +104,9 @@ clblasFill2DFunctorDefault::execute(Args & args)
   err = clEnqueueNDRangeKernel(args.queue, kernel, 2, NULL,
                                globalThreads, NULL , 
                                args.numEventsInWaitList, args.eventWaitList, args.events);
+  if (err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+  }
 
   clReleaseKernel(kernel) ;
   return clblasStatus(err) ;
@@ -24,6 +24,7 @@
 
 #include <functor_xscal_generic.h>
 #include <binary_lookup.h>
+#include <statistics.h>
 
 #include <kprintf.hpp>
 #include <scal.clT>
@@ -108,6 +109,9 @@ static clblasStatus xscalExecute(cl_command_queue queue,
   err = clEnqueueNDRangeKernel(queue, kernel, 1, NULL,
                                globalThreads, NULL , 
                                numEventsInWaitList, eventWaitList, events);
+  if (err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+  }
 
   clReleaseKernel(kernel) ;
   return clblasStatus(err) ;
@@ -21,6 +21,8 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "trxm_recursive.h"
+#include "path_table.h"
 
 #include <functor_xtrsm.h>
 
@@ -53,6 +55,7 @@ doTrsm(
     ListHead seq;
     size_t msize;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -74,6 +77,13 @@ doTrsm(
         return retCode;
     }
 
+    retCode = trxmRecursive(CLBLAS_TRSM, kargs, order, side, uplo, transA, diag,
+        M, N, A, offA, lda, B, offB, ldb, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        return retCode;
+    }
+
     kargs->order = order;
     kargs->side = side;
     kargs->uplo = uplo;
@@ -100,6 +110,14 @@ doTrsm(
     kargs->offsetN = 0;
     kargs->scimage[0] = 0;
 
+    int strict;
+    ImplPath path = trxmPinnedPath(CLBLAS_TRSM, kargs->dtype, side, uplo,
+                                   transA, M, N, &strict);
+    kargs->pattern = pathPattern(CLBLAS_TRSM, path);
+    if (strict && (kargs->pattern == 0)) {
+        return clblasNotImplemented;
+    }
+
 #ifndef TRXM_MULTIPLE_QUEUES
     if (numCommandQueues != 0) {
         numCommandQueues = 1;
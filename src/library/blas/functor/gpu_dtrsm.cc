@@ -8,6 +8,8 @@
 
 #include "functor.h"
 #include "binary_lookup.h"
+#include "statistics.h"
+#include "path_table.h"
 #include <iostream>
 
 #include "functor_xtrsm.h"
@@ -168,6 +170,7 @@ cl_int call_kernel_triple_update(const char* kernel_name,
     //printf( "execution of kernel %s failed with %d\n", kernel_name, err );
     return err;
   }
+  statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
   err = clReleaseKernel(kernel);
   return err;
@@ -229,6 +232,7 @@ cl_int diag_dtrtri (cl_program prg,
       //printf( "kernel -diag_dtrtri_kernel_lower- failed with %d\n", err );
       return err;
     }
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
     err = clReleaseKernel(diag_dtrtri_kernel_lower);
     if (err != CL_SUCCESS) {
@@ -293,6 +297,7 @@ cl_int diag_dtrtri (cl_program prg,
       //printf( "kernel -diag_dtrtri_kernel_upper- failed with %d\n", err );
       return err;
     }
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
  
     clReleaseKernel(diag_dtrtri_kernel_upper);
     if (err != CL_SUCCESS) {
@@ -431,6 +436,7 @@ cl_int cl_dtrsm( cl_program prg,
   size_t size_X = N*ldX * sizeof(double);
   X = clCreateBuffer(context, CL_MEM_READ_WRITE, size_X, NULL, &err);
   check_error(err) ;         
+  statisticsAdd(STAT_TEMP_BYTES, size_X);
   err = clearBuffer( queue, X, size_X ) ;
   check_error(err) ; 
 
@@ -447,6 +453,7 @@ cl_int cl_dtrsm( cl_program prg,
       InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
 
       check_error(err) ;         
+      statisticsAdd(STAT_TEMP_BYTES, size_InvA);
       err = clearBuffer( queue, InvA, size_InvA ) ;
       check_error(err) ; 
 
@@ -604,6 +611,7 @@ cl_int cl_dtrsm( cl_program prg,
       size_t size_InvA = ldInvA * BLOCKS(N,nb) * nb *sizeof(double); 
       InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
       check_error(err) ;         
+      statisticsAdd(STAT_TEMP_BYTES, size_InvA);
       err = clearBuffer( queue, InvA, size_InvA ) ;
       check_error(err) ; 
 
@@ -758,6 +766,9 @@ clblasStatus clblasDtrsmFunctorGpu::execute(Args &args)
 
   
   cl_program prg = this->m_program;
+
+  // the DGEMMs are the library's own calls
+  PathInternalScope internal;
   
 
   err = cl_dtrsm( prg,
@@ -8,6 +8,8 @@
 
 #include "functor.h"
 #include "binary_lookup.h"
+#include "statistics.h"
+#include "path_table.h"
 #include <iostream>
 
 #include "functor_xtrsm.h"
@@ -187,6 +189,7 @@ cl_int call_kernel_triple_update192(const char* kernel_name,
     //printf( "execution of kernel %s failed with %d\n", kernel_name, err );
     return err;
   }
+  statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
   err = clReleaseKernel(kernel);
   return err;
@@ -250,6 +253,7 @@ cl_int diag_dtrtri192 (cl_program prg,
       //printf( "kernel -diag_dtrtri_kernel_upper- failed with %d\n", err );
       return err;
     }
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
  
     clReleaseKernel(diag_dtrtri_kernel_upper);
     if (err != CL_SUCCESS) {
@@ -390,6 +394,7 @@ cl_int cl_dtrsm192( cl_program prg,
   size_t size_X = N*ldX * sizeof(double);
   X = clCreateBuffer(context, CL_MEM_READ_WRITE, size_X, NULL, &err);
   check_error(err) ;         
+  statisticsAdd(STAT_TEMP_BYTES, size_X);
   err = clearBuffer192( queue, X, size_X ) ;
   check_error(err) ; 
 
@@ -433,6 +438,7 @@ cl_int cl_dtrsm192( cl_program prg,
       size_t size_InvA = ldInvA * BLOCKS(N,nb) * nb *sizeof(double); 
       InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
       check_error(err) ;         
+      statisticsAdd(STAT_TEMP_BYTES, size_InvA);
       err = clearBuffer192( queue, InvA, size_InvA ) ;
       check_error(err) ; 
 
@@ -531,6 +537,9 @@ clblasStatus clblasDtrsm192FunctorGpu::execute(Args &args)
 
   
   cl_program prg = this->m_program;
+
+  // the DGEMMs are the library's own calls
+  PathInternalScope internal;
   
 
   err = cl_dtrsm192( prg,
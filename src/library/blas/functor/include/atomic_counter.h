@@ -110,6 +110,11 @@ public:
     int get(){
         return value.load();
     }
+
+    // Set the counter value 
+    void set(int v){
+        value.store(v);
+    }
 };
 
 #else
@@ -164,6 +169,12 @@ public:
     return v ; 
   }
 
+  void set(int v){
+    mutexLock( this->mutex ) ; 
+    this->value = v ;
+    mutexUnlock( this->mutex ) ; 
+  }
+
 
 };
 
@@ -20,6 +20,7 @@
 #include <clBLAS.h>
 #include <cassert>
 #include <map>
+#include <vector>
 #include <rwlock.h>
 #include "atomic_counter.h"
 #include "functor_utils.h"
@@ -117,12 +118,11 @@ private:
 // will register themselves in a global cache pool thus allowing 
 // some global cache management tasks to be performed
 //
-// As of now, the only implemented task is to discard all 
+// As of now, the implemented tasks are to discard all 
 // cache entries (see cleanFunctorCaches() typically called 
-// during clblasTeardown()) but, in future versions, it 
-// would be nice to have other management tasks such as 
-// removing all cache entries using a specific context 
-// or controling the overall size of the cache
+// during clblasTeardown()) and to discard the entries using
+// a specific context (see discardContextFunctors() called by
+// clblasReleaseContextResources()). 
 //
 class clblasFunctorCacheBase {
 public:
@@ -133,10 +133,17 @@ public:
 public:
   // Discard all members of the cache 
   virtual void discardAll() = 0 ;
+  // Discard the members of the cache using the specified context
+  virtual void discardContext(cl_context ctxt) = 0 ;
 
 } ;
 
 
+//
+// The maximum number of entries of a functor cache, 0 if unbounded 
+//
+size_t functorCacheSizeLimit() ;
+
 //
 // A dummy class used to represent the absence of additional data. 
 //
@@ -174,15 +181,21 @@ public:
 //       on the returned functor is implicitly increased and that 
 //       functor can be used immediately. 
 //   (3) If the lookup() is not successfull - that is if the 
-//       resulting functor is null, then the cache is locked for 
-//       writing and a new cache entry is prepared. The user 
-//       is then responsible for creating a new functor that must 
-//       be registered via a call to setFunctorInEntry().
-//       Alternatively, the new cache entry can be dropped by a 
-//       call to dropEntry().
-//       Not calling setFunctorInEntry() or dropEntry() will leave 
-//       the cache in a locked state thus making it unusable and 
-//       likely to cause a dead-lock. 
+//       resulting functor is null, then a pending cache entry is 
+//       registered. The user is then responsible for creating a new
+//       functor, without any lock held, that must be registered via
+//       a call to fillPendingEntry(). Alternatively, the pending entry 
+//       can be dropped by a call to dropPendingEntry(). Meanwhile,
+//       other threads looking for the same entry wait rather than 
+//       build the same functor, so not calling fillPendingEntry() or 
+//       dropPendingEntry() is likely to cause a dead-lock. 
+//
+// Lookups finding their entry only take the lock for reading, so they
+// don't wait on each other nor on functors being built. 
+//
+// The number of entries of each cache is bounded by the environment
+// variable AMD_CLBLAS_FUNCTOR_CACHE_SIZE, 64 by default, 0 meaning no
+// bound. Entries not used recently are evicted first. 
 //
 // In order to simplify development and to avoid errors, the
 // clblasFunctorCache provides an Lookup object class that hides most
@@ -256,6 +269,43 @@ private:
     }
   };
 
+  // A cached functor. The 'used' flag is set by every lookup finding it
+  // and cleared when the eviction passes over it.
+  struct Slot {
+    F *                 functor ;
+    clblasAtomicCounter used ;
+
+    Slot(F * f) : functor(f), used(1) { }
+  } ;
+
+  // A functor being built outside of the lock. The building thread holds
+  // the mutex until the functor is in the cache or given up, so other 
+  // threads looking for the same key wait on it rather than build it again.
+  // A promise whose context is discarded meanwhile is 'discarded', and its
+  // functor is not cached. The flag is only accessed with the cache locked.
+  struct Promise {
+    mutex_t *           mutex ;
+    clblasAtomicCounter refcount ;
+    bool                discarded ;
+
+    Promise() : refcount(1), discarded(false) 
+    { 
+      this->mutex = mutexInit() ; 
+      mutexLock(this->mutex) ;
+    }
+
+    ~Promise() 
+    { 
+      mutexDestroy(this->mutex) ; 
+    }
+
+    void release() 
+    {
+      if ( this->refcount.decrement() == 0 ) 
+        delete this ; 
+    }
+  } ;
+
 
   typedef clblasFunctorCache<F,D,CompareD> Cache;
 
@@ -263,19 +313,26 @@ private:
   // That may not be the most efficient but that can easily be 
   // changed if needed.
 
-  typedef std::map<Key, F *>        Map;
-  typedef typename Map::iterator    Entry;
+  typedef std::map<Key, Slot *>           Map;
+  typedef typename Map::iterator          Entry;
+  typedef std::map<Key, Promise *>        PendingMap;
+  typedef typename PendingMap::iterator   PendingEntry;
 
 
 private:
 
   Map        m_map;
+  PendingMap m_pending;
   rwlock_t * m_rwlock;
 
+  // Position of the eviction in m_map, as a key 
+  Key        m_hand;
+  bool       m_hasHand;
+
 public:
 
   //Cache constructor: init mutex
-  clblasFunctorCache()
+  clblasFunctorCache() : m_hasHand(false)
   {
     this->m_rwlock = rwlockInit();
   }
@@ -298,8 +355,9 @@ public:
   //  - Declare a local Lookup object 
   //  - Perform a call to the ok() member 
   //     (1) if true then use the functor returned by get() 
-  //     (2) if false then the cache is locked until the user provides 
-  //         a new functor with a call to set().
+  //     (2) if false then the user shall build a new functor and
+  //         provide it with a call to set(). Other threads looking
+  //         for the same entry wait until then. 
   //  - Destroy the Lookup object
   //
   // So a functor implementation can implement its own cache as illustrated 
@@ -341,37 +399,54 @@ public:
   //
   class Lookup {
   private:
-    Entry         m_entry ;
+    Key           m_key ;
+    Promise *     m_promise ;
     F *           m_functor ;
+    bool          m_found ;
     Cache &       m_cache ;
 
+    static Key makeKey(cl_context ctxt, cl_device_id dev, const D & data)
+    {
+      Key key = { dev, ctxt , data };
+      return key ;
+    }
+
   public:
 
     // Constructor
     //
     // Perform a lookup in the specified cache 
     // 
-    Lookup(Cache & cache, cl_context ctxt,  cl_device_id dev , const D & data) : m_cache(cache) 
+    Lookup(Cache & cache, cl_context ctxt,  cl_device_id dev , const D & data) 
+      : m_key(makeKey(ctxt,dev,data)), m_cache(cache) 
     {
-      this->m_functor = m_cache.lookup(ctxt,dev,data,this->m_entry) ;
+      this->m_functor = m_cache.lookup(this->m_key,this->m_promise) ;
+      this->m_found = this->ok() ;
     }
 
     //
     // Alternative constructor when D is the default type clblasNoData
     // 
-    Lookup(Cache & cache, cl_context ctxt,  cl_device_id dev ) : m_cache(cache) 
+    Lookup(Cache & cache, cl_context ctxt,  cl_device_id dev ) 
+      : m_key(makeKey(ctxt,dev,CLBLAS_NO_DATA)), m_cache(cache) 
     {
-      this->m_functor = m_cache.lookup(ctxt,dev,CLBLAS_NO_DATA,this->m_entry) ;
+      this->m_functor = m_cache.lookup(this->m_key,this->m_promise) ;
+      this->m_found = this->ok() ;
     }
    
 
     // Destructor 
     ~Lookup()
     {
-      if (  !this->ok() ) {
+      if ( this->m_promise != NULL ) {
         // Hoops! Something went wrong! 
         // It is important to drop the pending cache entry
-        m_cache.dropPendingEntry(this->m_entry) ;
+        m_cache.dropPendingEntry(this->m_key,this->m_promise) ;
+      }
+      else if ( this->m_found ) {
+        // The reference taken by the lookup, which kept the functor 
+        // alive until the user took its own 
+        this->m_functor->release() ;
       }
     } 
     
@@ -383,7 +458,6 @@ public:
     
     F * get() {
       assert(this->ok()) ;
-      //return m_cache.getFunctorFromEntry(this->entry) ;
       return this->m_functor;
     }
     
@@ -392,9 +466,10 @@ public:
     {
       assert(!this->ok()) ;
       assert(f != NULL) ;
-      m_cache.fillPendingEntry(this->m_entry,f) ;
+      assert(this->m_promise != NULL) ;
+      m_cache.fillPendingEntry(this->m_key,this->m_promise,f) ;
+      this->m_promise = NULL ;
       this->m_functor = f ;
-      this->m_functor->retain();
     }
     
   } ;
@@ -404,72 +479,181 @@ private:
   
   // Perform a lookup in the cache.
   //
-  // In case of success, returns the found functor.
+  // In case of success, returns the found functor with one more reference.
   //
-  // In case of failure, locks the cache, creates a new pending cache entry (in argument 'entry')
-  // and returns NULL.  The pending 'entry' shall then be populated with a valid functor by a 
-  // call to fillPendingEntry() or shall be dropped by a called dropPendingEntry(). Any failure 
-  // to perform one of those action will let the cache in a locked state thus making is unusable
+  // In case of failure, registers a pending entry for the key (returned in 
+  // argument 'promise') and returns NULL. The pending entry shall then be
+  // populated with a valid functor by a call to fillPendingEntry() or shall
+  // be dropped by a call to dropPendingEntry(). Until then, other lookups
+  // of the same key wait.
   // 
   // Remark: Direct use of this member is discouraged. Use the Lookup classe instead. 
   // 
-  F* lookup(cl_context ctxt, cl_device_id dev, const D & data, Entry & entry)
+  F* lookup(const Key & key, Promise * & promise)
   {
+    promise = NULL ;
 
-    Key key = { dev, ctxt , data };
-
-    rwlockReadLock(this->m_rwlock);
+    while ( true ) 
     {
-
-      Entry l_entry = this->m_map.find(key);
-      if( l_entry != this->m_map.end() )
+      rwlockReadLock(this->m_rwlock);
       {
-        entry = l_entry;
-        F * f =  entry->second;
-        rwlockReadUnlock(this->m_rwlock);
+        Entry l_entry = this->m_map.find(key);
+        if( l_entry != this->m_map.end() )
+        {
+          Slot * slot = l_entry->second ;
+          F *    f    = slot->functor ;
+
+          f->retain() ;
+          slot->used.set(1) ;
+          rwlockReadUnlock(this->m_rwlock);
  
-        return f ; 
+          return f ; 
+        }
       }
-    }
-    rwlockReadUnlock(this->m_rwlock);
+      rwlockReadUnlock(this->m_rwlock);
 
-    // key was not found! It must be created
-    std::pair<Entry,bool> ret;
-    
-    rwlockWriteLock(this->m_rwlock);
+      // key was not found! It must be created, unless another thread 
+      // is already doing so. The promise is made, and its mutex taken,
+      // before the cache is locked.
+      Promise * mine = new Promise() ;
+      Promise * other = NULL ;
 
-    ret = this->m_map.insert ( std::make_pair(key,(F *) NULL) );
+      rwlockWriteLock(this->m_rwlock);
 
-    if (!ret.second)  {
-      // The key already exists! 
-      F * f  = ret.first->second ;
-      rwlockWriteUnlock(this->m_rwlock);
-      return f ; 
-    }
+      Entry l_entry = this->m_map.find(key);
+      if ( l_entry != this->m_map.end() ) 
+      {
+        F * f = l_entry->second->functor ;
+
+        f->retain() ;
+        rwlockWriteUnlock(this->m_rwlock);
+        mutexUnlock(mine->mutex) ;
+        mine->release() ;
+        return f ; 
+      }
 
-    entry = ret.first;
+      PendingEntry p_entry = this->m_pending.find(key);
+      if ( p_entry == this->m_pending.end() ) 
+      {
+        // One reference for m_pending and one for the building thread
+        promise = mine ; 
+        promise->refcount.increment() ;
+        this->m_pending[key] = promise ;
+        rwlockWriteUnlock(this->m_rwlock);
+        return NULL ;
+      }
 
-    // Reminder: the lookup() returns with the cache in a write-locked state
-    return NULL;    
+      other = p_entry->second ;
+      other->refcount.increment() ;
+      rwlockWriteUnlock(this->m_rwlock);
+      mutexUnlock(mine->mutex) ;
+      mine->release() ;
 
+      // Wait for the other thread, then try again 
+      mutexLock(other->mutex) ;
+      mutexUnlock(other->mutex) ;
+      other->release() ;
+    }
   };
 
 
   // Fill a pending cache entry with a valid functor as provided by an
   // unsuccessfull call to lookup().
-  void fillPendingEntry(Entry & entry, F * functor)
+  void fillPendingEntry(const Key & key, Promise * promise, F * functor)
   {
+    std::vector<F *> evicted ;
+
     assert(functor != NULL) ;
-    entry->second = functor ;
+    rwlockWriteLock(this->m_rwlock);
+    if ( !promise->discarded ) 
+    {
+      this->m_pending.erase(key) ;
+      promise->release() ;
+      // The reference of the cache
+      functor->retain() ;
+      this->m_map[key] = new Slot(functor) ;
+      this->evict(evicted) ;
+    }
     rwlockWriteUnlock(this->m_rwlock);
+
+    mutexUnlock(promise->mutex) ;
+    promise->release() ;
+
+    // Functors may release OpenCL objects, outside of the lock
+    for (size_t i = 0; i < evicted.size(); i++)
+      evicted[i]->release() ;
   }
 
-  // Drop a pending cache entry with a valid functor as provided by 
-  // an unsuccessfull call to lookup(). 
-  void dropPendingEntry(Entry & entry ) 
+  // Drop a pending cache entry as provided by an unsuccessfull call to
+  // lookup(). 
+  void dropPendingEntry(const Key & key, Promise * promise) 
   {
-    this->m_map.erase(entry) ;
+    rwlockWriteLock(this->m_rwlock);
+    if ( !promise->discarded ) 
+    {
+      this->m_pending.erase(key) ;
+      promise->release() ;
+    }
     rwlockWriteUnlock(this->m_rwlock);
+
+    mutexUnlock(promise->mutex) ;
+    promise->release() ;
+  }
+
+  // Remove entries until the size of the cache is within its limit, taken
+  // from AMD_CLBLAS_FUNCTOR_CACHE_SIZE. The entries are visited in turn and
+  // the first one not used since the previous visit is evicted, so that 
+  // recently used functors stay.
+  //
+  // Remark: shall be called with the cache locked for writing.
+  void evict(std::vector<F *> & evicted)
+  {
+    size_t limit = functorCacheSizeLimit() ;
+
+    while ( limit != 0 && this->m_map.size() > limit ) 
+    {
+      Entry entry = this->m_hasHand ? this->m_map.lower_bound(this->m_hand) 
+                                    : this->m_map.begin() ;
+      while ( true ) 
+      {
+        if ( entry == this->m_map.end() ) 
+          entry = this->m_map.begin() ;
+        if ( entry->second->used.get() == 0 ) 
+          break ;
+        entry->second->used.set(0) ;
+        ++entry ;
+      }
+
+      evicted.push_back(entry->second->functor) ;
+      delete entry->second ;
+      this->m_map.erase(entry++) ;
+      this->m_hasHand = ( entry != this->m_map.end() ) ;
+      if ( this->m_hasHand ) 
+        this->m_hand = entry->first ;
+    }
+  }
+
+  // Mark the pending entries of a context, or of all of them if 'ctxt' is
+  // NULL, as discarded and forget them. Their building threads still fill
+  // or drop them, but the functors are then not cached.
+  //
+  // Remark: shall be called with the cache locked for writing.
+  void discardPending(cl_context ctxt)
+  {
+    PendingEntry entry = this->m_pending.begin() ;
+    while ( entry != this->m_pending.end() ) 
+    {
+      if ( ctxt == NULL || entry->first.ctxt == ctxt ) 
+      {
+        entry->second->discarded = true ;
+        entry->second->release() ;
+        this->m_pending.erase(entry++) ;
+      }
+      else
+      {
+        ++entry ;
+      }
+    }
   }
 
 public: // Inherited members from clblasFunctorCacheBase
@@ -483,9 +667,35 @@ public: // Inherited members from clblasFunctorCacheBase
       Entry entry = this->m_map.begin() ;
       if ( entry == this->m_map.end() ) 
         break ; 
-      entry->second->release() ;
+      entry->second->functor->release() ;
+      delete entry->second ;
       this->m_map.erase(entry) ;
     }
+    this->discardPending(NULL) ;
+    this->m_hasHand = false ;
+    rwlockWriteUnlock(this->m_rwlock);   
+  }
+
+  void discardContext(cl_context ctxt) 
+  {
+    rwlockWriteLock(this->m_rwlock);
+
+    Entry entry = this->m_map.begin() ;
+    while ( entry != this->m_map.end() ) 
+    {
+      if ( entry->first.ctxt == ctxt ) 
+      {
+        entry->second->functor->release() ;
+        delete entry->second ;
+        this->m_map.erase(entry++) ;
+      }
+      else
+      {
+        ++entry ;
+      }
+    }
+    this->discardPending(ctxt) ;
+    this->m_hasHand = false ;
     rwlockWriteUnlock(this->m_rwlock);   
   }
 
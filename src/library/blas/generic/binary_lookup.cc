@@ -44,6 +44,10 @@ extern "C"
 #include <md5sum.h>
 }
 
+#include <kernel_blob.h>
+#include <kernel_pack.h>
+#include <statistics.h>
+
 // size for clGetDeviceInfo queries
 #define SIZE 256
 
@@ -127,7 +131,7 @@ bool BinaryLookup::CacheEntry::exclusive_create()
 }
 
 BinaryLookup::BinaryLookup(cl_context ctxt, cl_device_id device, const std::string & kernel_name)
-    : m_context(ctxt), m_device(device), m_program(NULL), m_binary(0), m_signature(0), m_cache_enabled(cache_enabled)
+    : m_kernel_name(kernel_name), m_context(ctxt), m_device(device), m_program(NULL), m_binary(0), m_signature(0), m_cache_enabled(cache_enabled)
 {
     // initialize the entry name
     this->m_cache_entry_name = kernel_name;
@@ -362,8 +366,9 @@ bool BinaryLookup::tryLoadCacheFile()
 
 bool BinaryLookup::found()
 {
-    // if we could not create the directory, it is useless to 
-    if (! this->m_cache_enabled)
+    // if we could not create the directory and there is no kernel pack,
+    // it is useless to 
+    if (! this->m_cache_enabled && ! kernelPackActive())
     {
         return false; // not found
     }
@@ -371,17 +376,37 @@ bool BinaryLookup::found()
     this->finalizeVariant(); // serialize variant and cumpute checksum on it
     // also compute the tree to search from the cache entry (this->m_cache_entry_name, cache path ??)
 
-    if (tryLoadCacheFile())
+    // a pack built offline for the device comes first
+    const unsigned char * binary;
+    size_t binary_size;
+    if (kernelPackFind(this->m_device, this->m_kernel_name,
+                       this->m_cache_entry_name, &binary, &binary_size))
+    {
+        if (buildFromLoadedBinary(binary, binary_size, NULL) == CL_SUCCESS)
+        {
+            // carried over when a pack is rewritten from another one
+            kernelPackRecord(this->m_device, this->m_kernel_name,
+                             this->m_cache_entry_name, binary, binary_size);
+            statisticsAdd(STAT_BINARY_CACHE_HITS, 1);
+            return true;
+        }
+    }
+
+    bool hit = false;
+
+    if (this->m_cache_enabled && tryLoadCacheFile())
     {
         cl_int err = buildFromBinary(this->m_binary,
                                      this->m_header.binary_size, 
                                      NULL);
 
         // return false if the buildFromBinary failed, true else
-        return err==CL_SUCCESS;
+        hit = (err == CL_SUCCESS);
     }
 
-    return false;
+    statisticsAdd(hit ? STAT_BINARY_CACHE_HITS : STAT_BINARY_CACHE_MISSES, 1);
+
+    return hit;
 }
 
 static cl_int getSingleBinaryFromProgram(cl_program program,
@@ -475,6 +500,8 @@ cl_int BinaryLookup::populateCache()
     this->m_header.whole_file_size = this->m_header.header_size + this->m_header.binary_size + this->m_header.signature_size;
 
     err = writeCacheFile(data);
+    kernelPackRecord(this->m_device, this->m_kernel_name, this->m_cache_entry_name,
+                     data[0], data.size());
 
     return CL_SUCCESS;
 }
@@ -539,12 +566,14 @@ cl_program BinaryLookup::buildProgramFromSource(const char * source,
     if (err != CL_SUCCESS)
         return NULL;
 
+    cl_ulong start = statisticsTime();
     err = clBuildProgram(program,
                          1, /* FIXME: 1 device */
                          &device,
                          options, 
                          NULL, 
                          NULL);
+    statisticsProgramBuilt(start);
 
     if (err != CL_SUCCESS)
         return NULL;
@@ -554,6 +583,51 @@ cl_program BinaryLookup::buildProgramFromSource(const char * source,
 
 
 
+cl_program BinaryLookup::buildProgramFromSourceCached(const char * name,
+                                                      const char * source,
+                                                      cl_context context,
+                                                      cl_device_id device,
+                                                      cl_int & err,
+                                                      const char * options)
+{
+    BinaryLookup bl(context, device, name);
+
+    bl.variantRaw(source, strlen(source));
+    if (options != NULL)
+    {
+        bl.variantCompileOptions(options);
+    }
+
+    if (bl.found())
+    {
+        err = CL_SUCCESS;
+        return bl.getProgram();
+    }
+
+    cl_program program = clCreateProgramWithSource(context, 1, &source, NULL, &err);
+
+    if (err != CL_SUCCESS)
+        return NULL;
+
+    cl_ulong start = statisticsTime();
+    err = clBuildProgram(program,
+                         1, /* FIXME: 1 device */
+                         &device,
+                         options,
+                         NULL,
+                         NULL);
+    statisticsProgramBuilt(start);
+
+    // the program is returned on failure too for the build log
+    if (err == CL_SUCCESS)
+    {
+        bl.setProgram(program);
+        bl.populateCache();
+    }
+
+    return program;
+}
+
 cl_program BinaryLookup::buildProgramFromBinary(const char * data,
                                                 size_t data_size,
                                                 cl_context context,
@@ -561,6 +635,14 @@ cl_program BinaryLookup::buildProgramFromBinary(const char * data,
                                                 cl_int & err,
                                                 const char * options)
 {
+    // embedded binaries are compressed, decode them on first use
+    data = (const char *)kernelBlobData(data, &data_size);
+    if (data == NULL)
+    {
+        err = CL_INVALID_BINARY;
+        return NULL;
+    }
+
     cl_program program = clCreateProgramWithBinary(context,
                                                    1, // num_device
                                                    &device, // device_list
@@ -574,12 +656,14 @@ cl_program BinaryLookup::buildProgramFromBinary(const char * data,
         return NULL;
     }
 
+    cl_ulong start = statisticsTime();
     err = clBuildProgram(program,
                          1, /* FIXME: 1 device */
                          &device,
                          options,
                          NULL,
                          NULL);
+    statisticsProgramBuilt(start);
 
     if (err != CL_SUCCESS)
     {
@@ -623,27 +707,33 @@ static void do_mkdir(const std::string &path)
     }
 }
 
-cl_int BinaryLookup::retrieveDeviceAndDriverInfo()
+cl_int BinaryLookup::deviceCachePath(cl_device_id device, std::string & path,
+                                     const char * root)
 {
     char m_device_vendor[SIZE];
     char m_device_name[SIZE];
     char m_driver_version[SIZE];
 
-    cl_int err = clGetDeviceInfo(this->m_device, CL_DEVICE_VENDOR, sizeof(m_device_vendor),
+    if ((root == NULL) && !cache_enabled)
+    {
+        return CL_INVALID_VALUE;
+    }
+
+    cl_int err = clGetDeviceInfo(device, CL_DEVICE_VENDOR, sizeof(m_device_vendor),
                                  &m_device_vendor, NULL);
     if (err != CL_SUCCESS)
     {
         return err;
     }
 
-    err = clGetDeviceInfo(this->m_device, CL_DEVICE_NAME, sizeof(m_device_name),
+    err = clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(m_device_name),
                           &m_device_name, NULL);
     if (err != CL_SUCCESS)
     {
         return err;
     }
 
-    err = clGetDeviceInfo(this->m_device, CL_DRIVER_VERSION, sizeof(m_driver_version),
+    err = clGetDeviceInfo(device, CL_DRIVER_VERSION, sizeof(m_driver_version),
                           &m_driver_version, NULL);
     if (err != CL_SUCCESS)
     {
@@ -651,27 +741,64 @@ cl_int BinaryLookup::retrieveDeviceAndDriverInfo()
     }
 
 #if CAPS_DEBUG
-    fprintf(stderr, "device vendor = %s\n", this->m_device_vendor);
-    fprintf(stderr, "device name = %s\n", this->m_device_name);
-    fprintf(stderr, "driver version = %s\n", this->m_driver_version);
+    fprintf(stderr, "device vendor = %s\n", m_device_vendor);
+    fprintf(stderr, "device name = %s\n", m_device_name);
+    fprintf(stderr, "driver version = %s\n", m_driver_version);
 #endif
 
     try
     {
-        const std::string & root = (std::string(cache_path) + m_device_vendor + sep());
-        do_mkdir(root.c_str());
+        std::string base = cache_path;
+
+        if (root != NULL)
+        {
+            base = std::string(root) + sep();
+            do_mkdir(base.c_str());
+        }
 
-        const std::string & root2 = (root + m_device_name + sep());
+        const std::string & root1 = (base + m_device_vendor + sep());
+        do_mkdir(root1.c_str());
+
+        const std::string & root2 = (root1 + m_device_name + sep());
         do_mkdir(root2.c_str());
 
         const std::string & root3 = (root2 + m_driver_version + sep());
         do_mkdir(root3.c_str());
 
-        const std::string & root4 = (root3 + this->m_cache_entry_name + sep());
+        path = root3;
+
+        return CL_SUCCESS;
+    }
+    catch (std::string & e)
+    {
+        fprintf(stderr, "%s\n", e.c_str());
+        if (root == NULL)
+        {
+            cache_enabled = false;
+        }
+
+        return CL_INVALID_VALUE;
+    }
+}
+
+cl_int BinaryLookup::retrieveDeviceAndDriverInfo()
+{
+    std::string root;
+
+    cl_int err = deviceCachePath(this->m_device, root);
+    if (err != CL_SUCCESS)
+    {
+        this->m_cache_enabled = false;
+        return err;
+    }
+
+    try
+    {
+        const std::string & root4 = (root + this->m_cache_entry_name + sep());
         do_mkdir(root4.c_str());
 
         this->m_path = root4;
-        
+
         return CL_SUCCESS;
     }
     catch (std::string & e)
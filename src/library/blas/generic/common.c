@@ -25,6 +25,7 @@
 #include <ctype.h>
 
 #include "clblas-internal.h"
+#include "statistics.h"
 
 #if defined(DUMP_CLBLAS_KERNELS) && !defined(KEEP_CLBLAS_KERNEL_SOURCES)
 #define KEEP_CLBLAS_KERNEL_SOURCES
@@ -349,17 +350,20 @@ Kernel VISIBILITY_HIDDEN
 {
     cl_int status = CL_SUCCESS;
     Kernel* kernel;
+    cl_ulong start;
 
     kernel = allocKernel();
     if (kernel == NULL) {
         return NULL;
     }
 
+    start = statisticsTime();
     kernel->program = createClProgramWithBinary(key->context,
                                                 key->device,
                                                 (unsigned char*)*buffer,
                                                 sizeBuffer,
                                                 &status);
+    statisticsProgramBuilt(start);
     if (status == CL_SUCCESS) {
         kernel->extraSize = sizeof(CLBLASKernExtra);
         kernel->extra = calloc(1, kernel->extraSize);
@@ -389,6 +393,7 @@ dropProgramSource(cl_program *program, cl_context ctx, cl_device_id devID)
     unsigned char *bin;
     cl_program p = *program;
     cl_int err;
+    cl_ulong start;
 
     size = getProgramBinarySize(p);
     bin = getProgramBinary(p);
@@ -398,7 +403,9 @@ dropProgramSource(cl_program *program, cl_context ctx, cl_device_id devID)
      * in order to retain its own reference to the context if it is
      * released by user
      */
+    start = statisticsTime();
     p = createClProgramWithBinary(ctx, devID, bin, size, &err);
+    statisticsProgramBuilt(start);
     if (err == CL_SUCCESS) {
         clReleaseProgram(*program);
         *program = p;
@@ -428,6 +435,7 @@ Kernel
     ssize_t size;
     Kernel *kernel;
     char *log;
+    cl_ulong start;
 
 	#ifdef DEBUG_2
 	printf("Make kernel called\n");
@@ -446,6 +454,7 @@ Kernel
 
     if (kernelGenerator)
     {
+    statisticsAdd(STAT_GENERATIONS, 1);
     size = kernelGenerator(NULL, 0, dims, pgran, (void*)extra);
     if (size < 0) {
         storeErrorCode(error, CL_OUT_OF_HOST_MEMORY);
@@ -473,8 +482,10 @@ Kernel
 	#endif
 	#undef DEBUG_2
 
+    start = statisticsTime();
     kernel->program = buildClProgram(source, buildOpts, context, device,
                                      log, BUILD_LOG_SIZE, &err);
+    statisticsProgramBuilt(start);
     if (err != CL_SUCCESS) {
         printBuildError(err, device, kernelGenerator, dims,
                         pgran, extra, source, log);
@@ -582,20 +593,22 @@ char VISIBILITY_HIDDEN
     return buf;
 }
 
-clblasStatus VISIBILITY_HIDDEN
-checkMatrixSizes(
+/*
+ * Size in bytes of the memory spanned by a matrix, and the lead
+ * dimension check
+ */
+static clblasStatus
+matrixFootprint(
     DataType dtype,
     clblasOrder order,
     clblasTranspose transA,
     size_t M,
     size_t N,
-    cl_mem A,
-    size_t offA,
     size_t lda,         // lda is passed as zero for packed matrices
-    ErrorCodeSet err )
+    ErrorCodeSet err,
+    size_t *matrSize)
 {
-    size_t memSize, matrSize, tsize, memUsed;
-    size_t unusedTail = 0;
+    size_t tsize;
     bool tra;
 
     if ((M == 0) || (N == 0)) {
@@ -622,8 +635,7 @@ checkMatrixSizes(
                     return clblasNotImplemented;
                 }
             }
-            matrSize = ((N - 1) * lda + M) * tsize;
-            unusedTail = ( lda - N ) * tsize;
+            *matrSize = ((N - 1) * lda + M) * tsize;
         }
         else {
             if (lda < N) {
@@ -639,15 +651,37 @@ checkMatrixSizes(
                     return clblasNotImplemented;
                 }
             }
-            matrSize = ((M - 1) * lda + N) * tsize;
-            unusedTail = ( lda - M ) * tsize;
+            *matrSize = ((M - 1) * lda + N) * tsize;
         }
     }
     else {                     // For the case of packed matrices
-         matrSize = ((M * (N+1)) / 2) * tsize;
+         *matrSize = ((M * (N+1)) / 2) * tsize;
     }
 
-    offA *= tsize;
+    return clblasSuccess;
+}
+
+clblasStatus VISIBILITY_HIDDEN
+checkMatrixSizes(
+    DataType dtype,
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    cl_mem A,
+    size_t offA,
+    size_t lda,         // lda is passed as zero for packed matrices
+    ErrorCodeSet err )
+{
+    size_t memSize, matrSize, memUsed;
+    clblasStatus status;
+
+    status = matrixFootprint(dtype, order, transA, M, N, lda, err, &matrSize);
+    if (status != clblasSuccess) {
+        return status;
+    }
+
+    offA *= dtypeSize(dtype);
 
     if (clGetMemObjectInfo(A, CL_MEM_SIZE, sizeof(memSize), &memSize, NULL) !=
                                 CL_SUCCESS) {
@@ -686,6 +720,36 @@ checkMatrixSizes(
 }
 
 
+clblasStatus VISIBILITY_HIDDEN
+checkSVMMatrixSizes(
+    DataType dtype,
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    const void *A,
+    size_t lda,
+    ErrorCodeSet err )
+{
+    size_t matrSize;
+
+    if (A == NULL) {
+        switch( err )
+        {
+        case A_MAT_ERRSET:
+            return clblasInvalidMatA;
+        case B_MAT_ERRSET:
+            return clblasInvalidMatB;
+        case C_MAT_ERRSET:
+            return clblasInvalidMatC;
+        default:
+            return clblasNotImplemented;
+        }
+    }
+
+    return matrixFootprint(dtype, order, transA, M, N, lda, err, &matrSize);
+}
+
 clblasStatus VISIBILITY_HIDDEN
 checkBandedMatrixSizes(
     DataType dtype,
@@ -834,6 +898,32 @@ checkVectorSizes(
     return clblasSuccess;
 }
 
+clblasStatus VISIBILITY_HIDDEN
+checkSVMVectorSizes(
+    size_t N,
+    const void *x,
+    int incx,
+    ErrorCodeSet err )
+{
+    if (N == 0) {
+        return clblasInvalidDim;
+    }
+
+    if ((incx == 0) || (x == NULL)) {
+        switch( err )
+        {
+        case X_VEC_ERRSET:
+            return (x == NULL) ? clblasInvalidVecX : clblasInvalidIncX;
+        case Y_VEC_ERRSET:
+            return (x == NULL) ? clblasInvalidVecY : clblasInvalidIncY;
+        default:
+            return clblasNotImplemented;
+        }
+    }
+
+    return clblasSuccess;
+}
+
 clblasStatus
 checkMemObjects(
     cl_mem A,
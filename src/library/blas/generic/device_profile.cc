@@ -0,0 +1,255 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Device profiles are measured on request with clblasProfileDevice(), never
+ * from a BLAS call, since the microbenchmarks build programs and run
+ * kernels. The result is kept in memory for the library lifetime. It is
+ * also kept on disk, so that subsequent runs don't pay for the measurement
+ * again, if CLBLAS_PROFILE_PATH is set or the binary cache is enabled with
+ * CLBLAS_CACHE_PATH; the profile is then stored under that folder.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <map>
+
+#include <binary_lookup.h>
+#include <clblas-internal.h>
+
+extern "C"
+{
+#include <devinfo.h>
+#include <mutex.h>
+}
+
+#define PROFILE_FILE_NAME "device_profile"
+#define PROFILE_VERSION 1
+
+struct DeviceProfileEntry
+{
+    mutex_t *lock;      // held while the device is characterized
+    bool looked;        // the stored profile has been looked for
+    bool valid;
+    DeviceProfile profile;
+};
+
+typedef std::map<cl_device_id, DeviceProfileEntry*> DeviceProfileMap;
+
+static mutex_t *profileLock = NULL;
+static DeviceProfileMap *profiles = NULL;
+
+static bool loadProfile(const std::string & filename, DeviceProfile & profile)
+{
+    std::ifstream file(filename.c_str());
+    std::string key;
+    int version = 0;
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    memset(&profile, 0, sizeof(profile));
+    while (file >> key)
+    {
+        if (key == "version")
+            file >> version;
+        else if (key == "l1CacheSize")
+            file >> profile.l1CacheSize;
+        else if (key == "l2CacheSize")
+            file >> profile.l2CacheSize;
+        else if (key == "l1CacheAssoc")
+            file >> profile.l1CacheAssoc;
+        else if (key == "globalBandwidth")
+            file >> profile.globalBandwidth;
+        else if (key == "loadVecLen")
+            file >> profile.loadVecLen;
+        else if (key == "ldsBandwidth")
+            file >> profile.ldsBandwidth;
+        else if (key == "launchLatency")
+            file >> profile.launchLatency;
+
+        if (file.fail())
+        {
+            return false;
+        }
+    }
+
+    // a profile of an older format is remeasured
+    return (version == PROFILE_VERSION) && (profile.loadVecLen != 0);
+}
+
+static void saveProfile(const std::string & filename, const DeviceProfile & profile)
+{
+    std::ofstream file(filename.c_str());
+
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    file << "version " << PROFILE_VERSION << std::endl
+         << "l1CacheSize " << profile.l1CacheSize << std::endl
+         << "l2CacheSize " << profile.l2CacheSize << std::endl
+         << "l1CacheAssoc " << profile.l1CacheAssoc << std::endl
+         << "globalBandwidth " << profile.globalBandwidth << std::endl
+         << "loadVecLen " << profile.loadVecLen << std::endl
+         << "ldsBandwidth " << profile.ldsBandwidth << std::endl
+         << "launchLatency " << profile.launchLatency << std::endl;
+}
+
+// The folder the profile of the device is stored in
+// The folder the profile of the device is stored in, if any
+static bool profileFolder(cl_device_id device, std::string & path)
+{
+    const char *root = getenv("CLBLAS_PROFILE_PATH");
+
+    if ((root == NULL) || (root[0] == '\0'))
+    {
+        return (BinaryLookup::deviceCachePath(device, path) == CL_SUCCESS);
+    }
+
+    return (BinaryLookup::deviceCachePath(device, path, root) == CL_SUCCESS);
+}
+
+extern "C" void deviceProfileSetup(void)
+{
+    profileLock = mutexInit();
+    profiles = new DeviceProfileMap;
+}
+
+extern "C" void deviceProfileTeardown(void)
+{
+    if (profiles != NULL)
+    {
+        for (DeviceProfileMap::iterator it = profiles->begin();
+             it != profiles->end(); ++it)
+        {
+            mutexDestroy(it->second->lock);
+            delete it->second;
+        }
+    }
+    delete profiles;
+    profiles = NULL;
+    if (profileLock != NULL)
+    {
+        mutexDestroy(profileLock);
+        profileLock = NULL;
+    }
+}
+
+/*
+ * The entry of the device, locked, with the stored profile loaded if there
+ * is one. Returns NULL if the library is not initialized.
+ */
+static DeviceProfileEntry* lockProfileEntry(cl_device_id device)
+{
+    DeviceProfileEntry *entry;
+
+    if (profileLock == NULL)
+    {
+        return NULL;
+    }
+
+    mutexLock(profileLock);
+    DeviceProfileMap::iterator it = profiles->find(device);
+    if (it == profiles->end())
+    {
+        entry = new DeviceProfileEntry;
+        entry->lock = mutexInit();
+        entry->looked = false;
+        entry->valid = false;
+        profiles->insert(std::make_pair(device, entry));
+    }
+    else
+    {
+        entry = it->second;
+    }
+    mutexUnlock(profileLock);
+
+    /*
+     * Only the callers for the same device wait for its characterization,
+     * so that they don't run the benchmarks simultaneously and spoil each
+     * other's measurements
+     */
+    mutexLock(entry->lock);
+    if (!entry->looked)
+    {
+        std::string path;
+
+        entry->valid = (profileFolder(device, path) &&
+                        loadProfile(path + PROFILE_FILE_NAME, entry->profile));
+        entry->looked = true;
+    }
+
+    return entry;
+}
+
+extern "C" const DeviceProfile* getDeviceProfile(cl_device_id device)
+{
+    DeviceProfileEntry *entry = lockProfileEntry(device);
+    bool valid;
+
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+    valid = entry->valid;
+    mutexUnlock(entry->lock);
+
+    return valid ? &entry->profile : NULL;
+}
+
+extern "C" clblasStatus clblasProfileDevice(cl_device_id device)
+{
+    DeviceProfileEntry *entry;
+    clblasStatus status = clblasSuccess;
+
+    if (device == NULL)
+    {
+        return clblasInvalidDevice;
+    }
+    entry = lockProfileEntry(device);
+    if (entry == NULL)
+    {
+        return clblasNotInitialized;
+    }
+
+    if (!entry->valid)
+    {
+        std::string path;
+
+        if (characterizeDevice(device, &entry->profile) == CL_SUCCESS)
+        {
+            entry->valid = true;
+            if (profileFolder(device, path))
+            {
+                saveProfile(path + PROFILE_FILE_NAME, entry->profile);
+            }
+        }
+        else
+        {
+            status = clblasOutOfResources;
+        }
+    }
+    mutexUnlock(entry->lock);
+
+    return status;
+}
@@ -15,6 +15,7 @@
  * ************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <fstream>
 #include <iostream>
 #include <ios>
@@ -25,6 +26,8 @@
 #include <vector>
 #include <set>
 
+#define DEFAULT_FUNCTOR_CACHE_SIZE 64
+
 
 
 // ==================================================
@@ -64,6 +67,31 @@ extern "C" void cleanFunctorCaches(void)
     }
 }
 
+//
+// This function is called from clblasReleaseContextResources to remove the
+// entries using a context from all caches
+//
+extern "C" void discardContextFunctors(cl_context context) 
+{
+  clblasFunctorCacheSet & all = getFunctorCacheSet() ; 
+  for (clblasFunctorCacheSet::iterator it= all.begin(); it!=all.end(); ++it)
+    {
+      clblasFunctorCacheBase * cache = *it ; 
+      cache->discardContext(context) ; 
+    }
+}
+
+//
+// The bound on the number of entries of each cache, read when an entry is 
+// added so that it can be changed at run time
+//
+size_t functorCacheSizeLimit() 
+{
+  const char * env = getenv("AMD_CLBLAS_FUNCTOR_CACHE_SIZE") ;
+
+  return (env != NULL) ? (size_t) atoi(env) : DEFAULT_FUNCTOR_CACHE_SIZE ;
+}
+
 clblasFunctorCacheBase::clblasFunctorCacheBase()
 {
   //  if ( _cleanFunctorCachesHook == 0 ) 
@@ -0,0 +1,661 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <clBLAS.h>
+
+#include <host_path.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define HOST_PATH_SSE2
+#endif
+
+enum {
+    MAX_HOST_BUFFERS = 3
+};
+
+typedef struct HostBuffer {
+    cl_mem mem;
+    cl_map_flags flags;
+    void *ptr;
+} HostBuffer;
+
+/*
+ * Problem size thresholds for running on the host, zero disables
+ * the host path for the function
+ */
+static size_t hostThresholds[BLAS_FUNCTIONS_NUMBER];
+
+static void
+readThreshold(BlasFunctionID funcID, const char *name)
+{
+    const char *env;
+
+    env = getenv(name);
+    hostThresholds[funcID] = (env != NULL) ? (size_t)atol(env) : 0;
+}
+
+void
+hostPathSetup(void)
+{
+    memset(hostThresholds, 0, sizeof(hostThresholds));
+
+    readThreshold(CLBLAS_GEMM, "AMD_CLBLAS_GEMM_HOST_THRESHOLD");
+    readThreshold(CLBLAS_GEMV, "AMD_CLBLAS_GEMV_HOST_THRESHOLD");
+    readThreshold(CLBLAS_DOT, "AMD_CLBLAS_DOT_HOST_THRESHOLD");
+    readThreshold(CLBLAS_AXPY, "AMD_CLBLAS_AXPY_HOST_THRESHOLD");
+    readThreshold(CLBLAS_SCAL, "AMD_CLBLAS_SCAL_HOST_THRESHOLD");
+}
+
+static size_t
+problemSize(BlasFunctionID funcID, const CLBlasKargs *kargs)
+{
+    switch (funcID) {
+    case CLBLAS_GEMM:
+        return kargs->M * kargs->N * kargs->K;
+    case CLBLAS_GEMV:
+        return kargs->M * kargs->N;
+    default:
+        return kargs->N;
+    }
+}
+
+static bool
+isHostMemoryShared(cl_command_queue queue)
+{
+    cl_device_id device;
+    cl_device_type type;
+    cl_bool unified = CL_FALSE;
+
+    if (clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device),
+                              &device, NULL) != CL_SUCCESS) {
+        return false;
+    }
+    if (clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type,
+                        NULL) != CL_SUCCESS) {
+        return false;
+    }
+    if (type & CL_DEVICE_TYPE_CPU) {
+        return true;
+    }
+    clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified),
+                    &unified, NULL);
+
+    return (unified == CL_TRUE);
+}
+
+bool
+isHostPathSuitable(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues)
+{
+    size_t size;
+
+    // SVM pointers are not supported, they can't be mapped as buffers
+    if ((hostThresholds[funcID] == 0) || kargs->svm ||
+        ((kargs->dtype != TYPE_FLOAT) && (kargs->dtype != TYPE_DOUBLE)) ||
+        (numCommandQueues == 0) || (commandQueues == NULL) ||
+        (commandQueues[0] == NULL)) {
+
+        return false;
+    }
+
+    size = problemSize(funcID, kargs);
+
+    return (size <= hostThresholds[funcID]) &&
+           isHostMemoryShared(commandQueues[0]);
+}
+
+/*
+ * Host kernels. The innermost loops over contiguous memory are done by the
+ * vector primitives below, strided ones are scalar
+ */
+
+/* index of an element of a vector with the increment 'inc' */
+static __inline size_t
+vecIdx(size_t i, size_t n, int inc)
+{
+    return (inc > 0) ? i * inc : (n - 1 - i) * (size_t)(-inc);
+}
+
+/*
+ * Vector primitives over contiguous elements: y += alpha * x, the dot
+ * product of x and y, and x *= alpha. With SSE2 they process 4 floats or
+ * 2 doubles per instruction, two registers per iteration, and finish the
+ * remainder in scalar code
+ */
+
+static void
+sVecAxpy(size_t n, cl_float alpha, const cl_float *x, cl_float *y)
+{
+    size_t i = 0;
+#ifdef HOST_PATH_SSE2
+    __m128 va = _mm_set1_ps(alpha);
+    __m128 y0, y1;
+
+    for (; i + 8 <= n; i += 8) {
+        y0 = _mm_add_ps(_mm_loadu_ps(y + i),
+                        _mm_mul_ps(va, _mm_loadu_ps(x + i)));
+        y1 = _mm_add_ps(_mm_loadu_ps(y + i + 4),
+                        _mm_mul_ps(va, _mm_loadu_ps(x + i + 4)));
+        _mm_storeu_ps(y + i, y0);
+        _mm_storeu_ps(y + i + 4, y1);
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+static cl_float
+sVecDot(size_t n, const cl_float *x, const cl_float *y)
+{
+    size_t i = 0;
+    cl_float sum = 0;
+#ifdef HOST_PATH_SSE2
+    __m128 s0 = _mm_setzero_ps();
+    __m128 s1 = _mm_setzero_ps();
+    cl_float part[4];
+
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(x + i),
+                                       _mm_loadu_ps(y + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(x + i + 4),
+                                       _mm_loadu_ps(y + i + 4)));
+    }
+    _mm_storeu_ps(part, _mm_add_ps(s0, s1));
+    sum = (part[0] + part[1]) + (part[2] + part[3]);
+#endif
+    for (; i < n; i++) {
+        sum += x[i] * y[i];
+    }
+
+    return sum;
+}
+
+static void
+sVecScal(size_t n, cl_float alpha, cl_float *x)
+{
+    size_t i = 0;
+#ifdef HOST_PATH_SSE2
+    __m128 va = _mm_set1_ps(alpha);
+
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_ps(x + i, _mm_mul_ps(va, _mm_loadu_ps(x + i)));
+        _mm_storeu_ps(x + i + 4, _mm_mul_ps(va, _mm_loadu_ps(x + i + 4)));
+    }
+#endif
+    for (; i < n; i++) {
+        x[i] *= alpha;
+    }
+}
+
+static void
+dVecAxpy(size_t n, cl_double alpha, const cl_double *x, cl_double *y)
+{
+    size_t i = 0;
+#ifdef HOST_PATH_SSE2
+    __m128d va = _mm_set1_pd(alpha);
+    __m128d y0, y1;
+
+    for (; i + 4 <= n; i += 4) {
+        y0 = _mm_add_pd(_mm_loadu_pd(y + i),
+                        _mm_mul_pd(va, _mm_loadu_pd(x + i)));
+        y1 = _mm_add_pd(_mm_loadu_pd(y + i + 2),
+                        _mm_mul_pd(va, _mm_loadu_pd(x + i + 2)));
+        _mm_storeu_pd(y + i, y0);
+        _mm_storeu_pd(y + i + 2, y1);
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+static cl_double
+dVecDot(size_t n, const cl_double *x, const cl_double *y)
+{
+    size_t i = 0;
+    cl_double sum = 0;
+#ifdef HOST_PATH_SSE2
+    __m128d s0 = _mm_setzero_pd();
+    __m128d s1 = _mm_setzero_pd();
+    cl_double part[2];
+
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + i),
+                                       _mm_loadu_pd(y + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + i + 2),
+                                       _mm_loadu_pd(y + i + 2)));
+    }
+    _mm_storeu_pd(part, _mm_add_pd(s0, s1));
+    sum = part[0] + part[1];
+#endif
+    for (; i < n; i++) {
+        sum += x[i] * y[i];
+    }
+
+    return sum;
+}
+
+static void
+dVecScal(size_t n, cl_double alpha, cl_double *x)
+{
+    size_t i = 0;
+#ifdef HOST_PATH_SSE2
+    __m128d va = _mm_set1_pd(alpha);
+
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_pd(x + i, _mm_mul_pd(va, _mm_loadu_pd(x + i)));
+        _mm_storeu_pd(x + i + 2, _mm_mul_pd(va, _mm_loadu_pd(x + i + 2)));
+    }
+#endif
+    for (; i < n; i++) {
+        x[i] *= alpha;
+    }
+}
+
+#define DEFINE_HOST_KERNELS(TYPE, PREFIX)                                   \
+                                                                            \
+static void                                                                 \
+PREFIX##gemmHost(                                                           \
+    clblasTranspose transA,                                                 \
+    clblasTranspose transB,                                                 \
+    size_t M,                                                               \
+    size_t N,                                                               \
+    size_t K,                                                               \
+    TYPE alpha,                                                             \
+    const TYPE *A,                                                          \
+    size_t lda,                                                             \
+    const TYPE *B,                                                          \
+    size_t ldb,                                                             \
+    TYPE beta,                                                              \
+    TYPE *C,                                                                \
+    size_t ldc)                                                             \
+{                                                                           \
+    size_t i, j, k;                                                         \
+                                                                            \
+    for (j = 0; j < N; j++) {                                               \
+        TYPE *c = C + j * ldc;                                              \
+                                                                            \
+        if (beta == 0) {                                                    \
+            memset(c, 0, M * sizeof(TYPE));                                 \
+        }                                                                   \
+        else {                                                              \
+            PREFIX##VecScal(M, beta, c);                                    \
+        }                                                                   \
+        if (transA == clblasNoTrans) {                                      \
+            for (k = 0; k < K; k++) {                                       \
+                const TYPE *a = A + k * lda;                                \
+                TYPE b = alpha * ((transB == clblasNoTrans) ?               \
+                                  B[k + j * ldb] : B[j + k * ldb]);         \
+                                                                            \
+                PREFIX##VecAxpy(M, b, a, c);                                \
+            }                                                               \
+        }                                                                   \
+        else {                                                              \
+            for (i = 0; i < M; i++) {                                       \
+                const TYPE *a = A + i * lda;                                \
+                TYPE sum = 0;                                               \
+                                                                            \
+                if (transB == clblasNoTrans) {                              \
+                    sum = PREFIX##VecDot(K, a, B + j * ldb);                \
+                }                                                           \
+                else {                                                      \
+                    for (k = 0; k < K; k++) {                               \
+                        sum += a[k] * B[j + k * ldb];                       \
+                    }                                                       \
+                }                                                           \
+                c[i] += alpha * sum;                                        \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+/* y = alpha * A * x + beta * y, A is column major M x N */                 \
+static void                                                                 \
+PREFIX##gemvHost(                                                           \
+    bool trans,                                                             \
+    size_t M,                                                               \
+    size_t N,                                                               \
+    TYPE alpha,                                                             \
+    const TYPE *A,                                                          \
+    size_t lda,                                                             \
+    const TYPE *x,                                                          \
+    int incx,                                                               \
+    TYPE beta,                                                              \
+    TYPE *y,                                                                \
+    int incy)                                                               \
+{                                                                           \
+    size_t i, j;                                                            \
+    size_t lenx = (trans) ? M : N;                                          \
+    size_t leny = (trans) ? N : M;                                          \
+                                                                            \
+    for (i = 0; i < leny; i++) {                                            \
+        TYPE *yi = y + vecIdx(i, leny, incy);                               \
+                                                                            \
+        *yi = (beta == 0) ? 0 : beta * *yi;                                 \
+    }                                                                       \
+    if (!trans) {                                                           \
+        for (j = 0; j < N; j++) {                                           \
+            const TYPE *a = A + j * lda;                                    \
+            TYPE b = alpha * x[vecIdx(j, lenx, incx)];                      \
+                                                                            \
+            if (incy == 1) {                                                \
+                PREFIX##VecAxpy(M, b, a, y);                                \
+            }                                                               \
+            else {                                                          \
+                for (i = 0; i < M; i++) {                                   \
+                    y[vecIdx(i, M, incy)] += a[i] * b;                      \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    else {                                                                  \
+        for (j = 0; j < N; j++) {                                           \
+            const TYPE *a = A + j * lda;                                    \
+            TYPE sum = 0;                                                   \
+                                                                            \
+            if (incx == 1) {                                                \
+                sum = PREFIX##VecDot(M, a, x);                              \
+            }                                                               \
+            else {                                                          \
+                for (i = 0; i < M; i++) {                                   \
+                    sum += a[i] * x[vecIdx(i, M, incx)];                    \
+                }                                                           \
+            }                                                               \
+            y[vecIdx(j, N, incy)] += alpha * sum;                           \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static TYPE                                                                 \
+PREFIX##dotHost(                                                            \
+    size_t N,                                                               \
+    const TYPE *x,                                                          \
+    int incx,                                                               \
+    const TYPE *y,                                                          \
+    int incy)                                                               \
+{                                                                           \
+    size_t i;                                                               \
+    TYPE sum = 0;                                                           \
+                                                                            \
+    if ((incx == 1) && (incy == 1)) {                                       \
+        sum = PREFIX##VecDot(N, x, y);                                      \
+    }                                                                       \
+    else {                                                                  \
+        for (i = 0; i < N; i++) {                                           \
+            sum += x[vecIdx(i, N, incx)] * y[vecIdx(i, N, incy)];           \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    return sum;                                                             \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+PREFIX##axpyHost(                                                           \
+    size_t N,                                                               \
+    TYPE alpha,                                                             \
+    const TYPE *x,                                                          \
+    int incx,                                                               \
+    TYPE *y,                                                                \
+    int incy)                                                               \
+{                                                                           \
+    size_t i;                                                               \
+                                                                            \
+    if ((incx == 1) && (incy == 1)) {                                       \
+        PREFIX##VecAxpy(N, alpha, x, y);                                    \
+    }                                                                       \
+    else {                                                                  \
+        for (i = 0; i < N; i++) {                                           \
+            y[vecIdx(i, N, incy)] += alpha * x[vecIdx(i, N, incx)];         \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+PREFIX##scalHost(                                                           \
+    size_t N,                                                               \
+    TYPE alpha,                                                             \
+    TYPE *x,                                                                \
+    int incx)                                                               \
+{                                                                           \
+    size_t i;                                                               \
+                                                                            \
+    if (incx == 1) {                                                        \
+        PREFIX##VecScal(N, alpha, x);                                       \
+    }                                                                       \
+    else {                                                                  \
+        for (i = 0; i < N; i++) {                                           \
+            x[vecIdx(i, N, incx)] *= alpha;                                 \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+PREFIX##runHost(                                                            \
+    BlasFunctionID funcID,                                                  \
+    const CLBlasKargs *kargs,                                               \
+    TYPE alpha,                                                             \
+    TYPE beta,                                                              \
+    HostBuffer *bufs)                                                       \
+{                                                                           \
+    TYPE *a = (TYPE*)bufs[0].ptr + kargs->offA;                             \
+    TYPE *b = (bufs[1].ptr) ? (TYPE*)bufs[1].ptr + kargs->offBX : NULL;     \
+    TYPE *c = (bufs[2].ptr) ? (TYPE*)bufs[2].ptr + kargs->offCY : NULL;     \
+                                                                            \
+    switch (funcID) {                                                       \
+    case CLBLAS_GEMM:                                                       \
+        /* C^T = B^T * A^T for row major matrices */                        \
+        if (kargs->order == clblasColumnMajor) {                            \
+            PREFIX##gemmHost(kargs->transA, kargs->transB, kargs->M,        \
+                kargs->N, kargs->K, alpha, a, kargs->lda.matrix, b,         \
+                kargs->ldb.matrix, beta, c, kargs->ldc.matrix);             \
+        }                                                                   \
+        else {                                                              \
+            PREFIX##gemmHost(kargs->transB, kargs->transA, kargs->N,        \
+                kargs->M, kargs->K, alpha, b, kargs->ldb.matrix, a,         \
+                kargs->lda.matrix, beta, c, kargs->ldc.matrix);             \
+        }                                                                   \
+        break;                                                              \
+    case CLBLAS_GEMV:                                                       \
+        /* a row major matrix is the transposed column major one */         \
+        if (kargs->order == clblasColumnMajor) {                            \
+            PREFIX##gemvHost(kargs->transA != clblasNoTrans, kargs->M,      \
+                kargs->N, alpha, a, kargs->lda.matrix, b,                   \
+                kargs->ldb.Vector, beta, c, kargs->ldc.Vector);             \
+        }                                                                   \
+        else {                                                              \
+            PREFIX##gemvHost(kargs->transA == clblasNoTrans, kargs->N,      \
+                kargs->M, alpha, a, kargs->lda.matrix, b,                   \
+                kargs->ldb.Vector, beta, c, kargs->ldc.Vector);             \
+        }                                                                   \
+        break;                                                              \
+    case CLBLAS_DOT:                                                        \
+        *a = PREFIX##dotHost(kargs->N, b, kargs->ldb.Vector, c,             \
+                             kargs->ldc.Vector);                            \
+        break;                                                              \
+    case CLBLAS_AXPY:                                                       \
+        PREFIX##axpyHost(kargs->N, alpha,                                   \
+                         (TYPE*)bufs[0].ptr + kargs->offBX,                 \
+                         kargs->ldb.Vector,                                 \
+                         (TYPE*)bufs[1].ptr + kargs->offCY,                 \
+                         kargs->ldc.Vector);                                \
+        break;                                                              \
+    case CLBLAS_SCAL:                                                       \
+        PREFIX##scalHost(kargs->N, alpha,                                   \
+                         (TYPE*)bufs[0].ptr + kargs->offBX,                 \
+                         kargs->ldb.Vector);                                \
+        break;                                                              \
+    default:                                                                \
+        break;                                                              \
+    }                                                                       \
+}
+
+DEFINE_HOST_KERNELS(cl_float, s)
+DEFINE_HOST_KERNELS(cl_double, d)
+
+/*
+ * Fill buffers used by the function in the order the host kernels
+ * expect them
+ */
+static void
+getProblemBuffers(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    HostBuffer *bufs)
+{
+    memset(bufs, 0, MAX_HOST_BUFFERS * sizeof(HostBuffer));
+
+    switch (funcID) {
+    case CLBLAS_GEMM:
+    case CLBLAS_GEMV:
+        bufs[0].mem = kargs->A;
+        bufs[0].flags = CL_MAP_READ;
+        bufs[1].mem = kargs->B;
+        bufs[1].flags = CL_MAP_READ;
+        bufs[2].mem = kargs->C;
+        bufs[2].flags = CL_MAP_READ | CL_MAP_WRITE;
+        break;
+    case CLBLAS_DOT:
+        bufs[0].mem = kargs->A;
+        bufs[0].flags = CL_MAP_WRITE;
+        bufs[1].mem = kargs->B;
+        bufs[1].flags = CL_MAP_READ;
+        bufs[2].mem = kargs->C;
+        bufs[2].flags = CL_MAP_READ;
+        break;
+    case CLBLAS_AXPY:
+        bufs[0].mem = kargs->A;
+        bufs[0].flags = CL_MAP_READ;
+        bufs[1].mem = kargs->B;
+        bufs[1].flags = CL_MAP_READ | CL_MAP_WRITE;
+        break;
+    case CLBLAS_SCAL:
+        bufs[0].mem = kargs->A;
+        bufs[0].flags = CL_MAP_READ | CL_MAP_WRITE;
+        break;
+    default:
+        break;
+    }
+}
+
+clblasStatus
+executeOnHost(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+    HostBuffer bufs[MAX_HOST_BUFFERS];
+    cl_event unmapEvents[MAX_HOST_BUFFERS];
+    cl_uint nrUnmapEvents = 0;
+    cl_context ctx;
+    cl_int err = CL_SUCCESS;
+    size_t size;
+    unsigned int i, j;
+
+    getProblemBuffers(funcID, kargs, bufs);
+
+    /*
+     * A buffer passed several times is mapped once with all the access
+     * flags needed
+     */
+    for (i = 1; i < MAX_HOST_BUFFERS; i++) {
+        for (j = 0; j < i; j++) {
+            if ((bufs[i].mem != NULL) && (bufs[j].mem == bufs[i].mem)) {
+                bufs[j].flags |= bufs[i].flags;
+                bufs[i].flags = 0;
+                break;
+            }
+        }
+    }
+
+    // blocking maps wait for the events the problem depends on
+    for (i = 0; (i < MAX_HOST_BUFFERS) && (err == CL_SUCCESS); i++) {
+        if ((bufs[i].mem == NULL) || (bufs[i].flags == 0)) {
+            continue;
+        }
+        err = clGetMemObjectInfo(bufs[i].mem, CL_MEM_SIZE, sizeof(size),
+                                 &size, NULL);
+        if (err == CL_SUCCESS) {
+            bufs[i].ptr = clEnqueueMapBuffer(queue, bufs[i].mem, CL_TRUE,
+                bufs[i].flags, 0, size, numEventsInWaitList, eventWaitList,
+                NULL, &err);
+        }
+    }
+    for (i = 1; i < MAX_HOST_BUFFERS; i++) {
+        for (j = 0; (j < i) && (bufs[i].flags == 0); j++) {
+            if (bufs[j].mem == bufs[i].mem) {
+                bufs[i].ptr = bufs[j].ptr;
+            }
+        }
+    }
+
+    if (err == CL_SUCCESS) {
+        if (kargs->dtype == TYPE_FLOAT) {
+            srunHost(funcID, kargs, kargs->alpha.argFloat,
+                     kargs->beta.argFloat, bufs);
+        }
+        else {
+            drunHost(funcID, kargs, kargs->alpha.argDouble,
+                     kargs->beta.argDouble, bufs);
+        }
+    }
+
+    for (i = 0; i < MAX_HOST_BUFFERS; i++) {
+        if ((bufs[i].ptr == NULL) || (bufs[i].flags == 0)) {
+            continue;
+        }
+        if (clEnqueueUnmapMemObject(queue, bufs[i].mem, bufs[i].ptr, 0, NULL,
+                &unmapEvents[nrUnmapEvents]) == CL_SUCCESS) {
+
+            nrUnmapEvents++;
+        }
+    }
+
+    if (nrUnmapEvents) {
+        clWaitForEvents(nrUnmapEvents, unmapEvents);
+        for (i = 0; i < nrUnmapEvents; i++) {
+            clReleaseEvent(unmapEvents[i]);
+        }
+    }
+
+    /*
+     * The results are in place by now, so the caller gets an already
+     * completed event
+     */
+    if ((err == CL_SUCCESS) && (events != NULL)) {
+        err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(ctx),
+                                    &ctx, NULL);
+        if (err == CL_SUCCESS) {
+            events[0] = clCreateUserEvent(ctx, &err);
+        }
+        if (err == CL_SUCCESS) {
+            err = clSetUserEventStatus(events[0], CL_COMPLETE);
+        }
+    }
+
+    return (clblasStatus)err;
+}
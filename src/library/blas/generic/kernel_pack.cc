@@ -0,0 +1,280 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * A pack is the magic "CLBP", a version and the number of entries, all
+ * 32 bit little endian, followed by the entries: the length of the key,
+ * the key, the length of the binary and the binary. The key is the
+ * vendor, name and driver version of the device, the kernel name and the
+ * cache entry name, separated by newlines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <kernel_pack.h>
+
+extern "C"
+{
+#include <mutex.h>
+}
+
+#define PACK_MAGIC "CLBP"
+#define PACK_VERSION 1
+#define DEVICE_INFO_SIZE 256
+
+typedef std::map<std::string, std::vector<unsigned char> > PackEntries;
+
+// the pack loaded, read only after setup
+static PackEntries *loaded = NULL;
+// the kernels built, to be written to 'outputPath'
+static PackEntries *recorded = NULL;
+static std::string outputPath;
+static mutex_t *recordLock = NULL;
+
+static bool
+deviceKey(
+    cl_device_id device,
+    const std::string &name,
+    const std::string &entry,
+    std::string &key)
+{
+    static const cl_device_info infos[] = {
+        CL_DEVICE_VENDOR, CL_DEVICE_NAME, CL_DRIVER_VERSION
+    };
+    char value[DEVICE_INFO_SIZE];
+
+    key.clear();
+    for (size_t i = 0; i < sizeof(infos) / sizeof(infos[0]); i++) {
+        if (clGetDeviceInfo(device, infos[i], sizeof(value), value,
+                            NULL) != CL_SUCCESS) {
+            return false;
+        }
+        key += value;
+        key += '\n';
+    }
+    key += name + '\n' + entry;
+
+    return true;
+}
+
+static bool
+readWord(FILE *f, size_t *value)
+{
+    unsigned char b[4];
+
+    if (fread(b, 1, 4, f) != 4) {
+        return false;
+    }
+    *value = (size_t)b[0] | ((size_t)b[1] << 8) | ((size_t)b[2] << 16) |
+             ((size_t)b[3] << 24);
+
+    return true;
+}
+
+/*
+ * Read the length of what follows and check it against the bytes left in
+ * the file, of 'fileSize' bytes, so a corrupt length fails the load
+ */
+static bool
+readLength(FILE *f, long fileSize, size_t *len)
+{
+    long pos;
+
+    if (!readWord(f, len)) {
+        return false;
+    }
+    pos = ftell(f);
+
+    return (pos >= 0) && (pos <= fileSize) && (*len <= (size_t)(fileSize - pos));
+}
+
+static bool
+writeWord(FILE *f, size_t value)
+{
+    unsigned char b[4];
+
+    b[0] = (unsigned char)(value & 0xFF);
+    b[1] = (unsigned char)((value >> 8) & 0xFF);
+    b[2] = (unsigned char)((value >> 16) & 0xFF);
+    b[3] = (unsigned char)((value >> 24) & 0xFF);
+
+    return (fwrite(b, 1, 4, f) == 4);
+}
+
+static bool
+loadPack(const char *path, PackEntries &entries)
+{
+    FILE *f = fopen(path, "rb");
+    char magic[4];
+    size_t version, nrEntries, len;
+    long fileSize;
+    bool ok;
+
+    if (f == NULL) {
+        return false;
+    }
+    if ((fseek(f, 0, SEEK_END) != 0) || ((fileSize = ftell(f)) < 0) ||
+        (fseek(f, 0, SEEK_SET) != 0)) {
+        fclose(f);
+        return false;
+    }
+
+    ok = (fread(magic, 1, 4, f) == 4) && !memcmp(magic, PACK_MAGIC, 4) &&
+         readWord(f, &version) && (version == PACK_VERSION) &&
+         readWord(f, &nrEntries);
+    for (size_t i = 0; ok && (i < nrEntries); i++) {
+        std::string key;
+        std::vector<unsigned char> binary;
+
+        ok = readLength(f, fileSize, &len);
+        if (ok) {
+            key.resize(len);
+            ok = (len == 0) || (fread(&key[0], 1, len, f) == len);
+        }
+        ok = ok && readLength(f, fileSize, &len);
+        if (ok) {
+            binary.resize(len);
+            ok = (len == 0) || (fread(&binary[0], 1, len, f) == len);
+        }
+        if (ok) {
+            entries[key].swap(binary);
+        }
+    }
+    fclose(f);
+
+    return ok;
+}
+
+static bool
+writePack(const char *path, const PackEntries &entries)
+{
+    FILE *f = fopen(path, "wb");
+    PackEntries::const_iterator it;
+    bool ok;
+
+    if (f == NULL) {
+        return false;
+    }
+
+    ok = (fwrite(PACK_MAGIC, 1, 4, f) == 4) && writeWord(f, PACK_VERSION) &&
+         writeWord(f, entries.size());
+    for (it = entries.begin(); ok && (it != entries.end()); ++it) {
+        ok = writeWord(f, it->first.size()) &&
+             (fwrite(it->first.data(), 1, it->first.size(), f) ==
+              it->first.size()) &&
+             writeWord(f, it->second.size()) &&
+             (it->second.empty() ||
+              (fwrite(&it->second[0], 1, it->second.size(), f) ==
+               it->second.size()));
+    }
+
+    return (fclose(f) == 0) && ok;
+}
+
+extern "C" void kernelPackSetup(void)
+{
+    const char *input = getenv("CLBLAS_KERNEL_PACK");
+    const char *output = getenv("CLBLAS_KERNEL_PACK_OUTPUT");
+
+    if (input != NULL) {
+        loaded = new PackEntries;
+        if (!loadPack(input, *loaded)) {
+            fprintf(stderr, "Warning: cannot load the kernel pack '%s'\n",
+                    input);
+            delete loaded;
+            loaded = NULL;
+        }
+    }
+
+    if (output != NULL) {
+        outputPath = output;
+        recorded = new PackEntries;
+        recordLock = mutexInit();
+    }
+}
+
+extern "C" void kernelPackTeardown(void)
+{
+    if (recorded != NULL) {
+        if (!writePack(outputPath.c_str(), *recorded)) {
+            fprintf(stderr, "Warning: cannot write the kernel pack '%s'\n",
+                    outputPath.c_str());
+        }
+        mutexDestroy(recordLock);
+        recordLock = NULL;
+        delete recorded;
+        recorded = NULL;
+    }
+
+    delete loaded;
+    loaded = NULL;
+}
+
+bool kernelPackActive(void)
+{
+    return (loaded != NULL) || (recorded != NULL);
+}
+
+bool
+kernelPackFind(
+    cl_device_id device,
+    const std::string &name,
+    const std::string &entry,
+    const unsigned char **binary,
+    size_t *size)
+{
+    std::string key;
+    PackEntries::const_iterator it;
+
+    if ((loaded == NULL) || !deviceKey(device, name, entry, key)) {
+        return false;
+    }
+
+    it = loaded->find(key);
+    if ((it == loaded->end()) || it->second.empty()) {
+        return false;
+    }
+    *binary = &it->second[0];
+    *size = it->second.size();
+
+    return true;
+}
+
+void
+kernelPackRecord(
+    cl_device_id device,
+    const std::string &name,
+    const std::string &entry,
+    const unsigned char *binary,
+    size_t size)
+{
+    std::string key;
+
+    if ((recorded == NULL) || (size == 0) ||
+        !deviceKey(device, name, entry, key)) {
+
+        return;
+    }
+
+    mutexLock(recordLock);
+    (*recorded)[key].assign(binary, binary + size);
+    mutexUnlock(recordLock);
+}
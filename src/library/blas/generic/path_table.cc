@@ -0,0 +1,300 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * A path table is a text file with one pinned shape class per line:
+ *
+ *     <routine> <op> <M> <N> <K> <path>
+ *
+ * for instance "sgemm NT 10 10 12 streamk". The routine is named with its
+ * precision, the op is the transpositions of A and B for GEMM and the
+ * side, triangle and transposition of A for TRSM and TRMM ("RUN"), and a
+ * dimension d stands for the sizes from 2^d to 2^(d+1) - 1. K is 0 for
+ * TRSM and TRMM. Empty lines and lines starting with '#' are skipped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include <path_table.h>
+#include <clblas-internal.h>
+
+#define LINE_SIZE 256
+
+typedef std::map<std::string, ImplPath> PathEntries;
+
+static const char *pathNames[PATH_NR_PATHS] = {
+    "default", "autogemm", "special", "strassen", "3m", "streamk", "splitk",
+    "recursive", "dtrsm", "lds", "image", "nolds", "cached"
+};
+
+// the table loaded, read only after setup
+static PathEntries *pinned = NULL;
+
+// nesting of the calls the thread makes for the library's own use
+#if defined( _WIN32 )
+__declspec( thread ) static unsigned int internalDepth = 0;
+#else
+static __thread unsigned int internalDepth = 0;
+#endif
+
+static ImplPath
+pathFromName(const char *name)
+{
+    for (int i = 0; i < PATH_NR_PATHS; i++) {
+        if (strcmp(name, pathNames[i]) == 0) {
+            return static_cast<ImplPath>(i);
+        }
+    }
+
+    return PATH_NR_PATHS;
+}
+
+static char
+precisionLetter(DataType dtype)
+{
+    switch (dtype) {
+    case TYPE_FLOAT:
+        return 's';
+    case TYPE_DOUBLE:
+        return 'd';
+    case TYPE_COMPLEX_FLOAT:
+        return 'c';
+    case TYPE_COMPLEX_DOUBLE:
+        return 'z';
+    default:
+        return '\0';
+    }
+}
+
+static char
+transposeLetter(clblasTranspose trans)
+{
+    return (trans == clblasNoTrans) ? 'N' : (trans == clblasTrans) ? 'T' : 'C';
+}
+
+static unsigned int
+shapeClass(size_t dim)
+{
+    unsigned int c = 0;
+
+    while (dim > 1) {
+        dim >>= 1;
+        c++;
+    }
+
+    return c;
+}
+
+static std::string
+entryKey(
+    const char *routine,
+    const char *op,
+    unsigned int m,
+    unsigned int n,
+    unsigned int k)
+{
+    char key[LINE_SIZE];
+
+    snprintf(key, sizeof(key), "%s %s %u %u %u", routine, op, m, n, k);
+
+    return key;
+}
+
+static bool
+loadTable(const char *path, PathEntries &entries)
+{
+    FILE *f = fopen(path, "r");
+    char line[LINE_SIZE];
+    bool ok = true;
+
+    if (f == NULL) {
+        return false;
+    }
+
+    while (ok && (fgets(line, sizeof(line), f) != NULL)) {
+        char routine[16], op[16], name[16];
+        unsigned int m, n, k;
+        int nr;
+        ImplPath p;
+
+        if ((line[0] == '#') || (sscanf(line, "%15s", routine) != 1)) {
+            continue;
+        }
+        nr = sscanf(line, "%15s %15s %u %u %u %15s", routine, op, &m, &n, &k,
+                    name);
+        p = (nr == 6) ? pathFromName(name) : PATH_NR_PATHS;
+        ok = (p != PATH_NR_PATHS);
+        if (ok) {
+            entries[entryKey(routine, op, m, n, k)] = p;
+        }
+    }
+    fclose(f);
+
+    return ok;
+}
+
+/*
+ * The path named by CLBLAS_FORCE_PATH, or else the one pinned for the
+ * class of the call
+ */
+static ImplPath
+pinnedPath(
+    const char *routine,
+    const char *op,
+    size_t M,
+    size_t N,
+    size_t K,
+    int *strict)
+{
+    // read on every call so that it can be switched per problem
+    const char *env = getenv("CLBLAS_FORCE_PATH");
+    PathEntries::const_iterator it;
+
+    *strict = 0;
+    if (internalDepth > 0) {
+        return PATH_DEFAULT;
+    }
+
+    if (env != NULL) {
+        ImplPath p = pathFromName(env);
+
+        if (p != PATH_NR_PATHS) {
+            *strict = (p != PATH_DEFAULT);
+            return p;
+        }
+    }
+
+    if (pinned == NULL) {
+        return PATH_DEFAULT;
+    }
+    it = pinned->find(entryKey(routine, op, shapeClass(M), shapeClass(N),
+                               shapeClass(K)));
+
+    return (it != pinned->end()) ? it->second : PATH_DEFAULT;
+}
+
+extern "C" void pathTableSetup(void)
+{
+    const char *path = getenv("CLBLAS_PATH_TABLE");
+
+    if ((path != NULL) && (path[0] != '\0')) {
+        pinned = new PathEntries;
+        if (!loadTable(path, *pinned)) {
+            fprintf(stderr, "Warning: cannot load the path table '%s'\n",
+                    path);
+            delete pinned;
+            pinned = NULL;
+        }
+    }
+}
+
+extern "C" void pathTableTeardown(void)
+{
+    delete pinned;
+    pinned = NULL;
+}
+
+extern "C" void pathInternalEnter(void)
+{
+    internalDepth++;
+}
+
+extern "C" void pathInternalLeave(void)
+{
+    internalDepth--;
+}
+
+extern "C" const char*
+pathName(ImplPath path)
+{
+    return (path < PATH_NR_PATHS) ? pathNames[path] : "";
+}
+
+extern "C" ImplPath
+gemmPinnedPath(
+    DataType dtype,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    int *strict)
+{
+    char routine[] = { precisionLetter(dtype), 'g', 'e', 'm', 'm', '\0' };
+    char op[] = { transposeLetter(transA), transposeLetter(transB), '\0' };
+
+    if (routine[0] == '\0') {
+        *strict = 0;
+        return PATH_DEFAULT;
+    }
+
+    return pinnedPath(routine, op, M, N, K, strict);
+}
+
+extern "C" ImplPath
+trxmPinnedPath(
+    BlasFunctionID funcID,
+    DataType dtype,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    int *strict)
+{
+    char routine[] = { precisionLetter(dtype), 't', 'r', 'x', 'm', '\0' };
+    char op[] = { (side == clblasLeft) ? 'L' : 'R',
+                  (uplo == clblasUpper) ? 'U' : 'L',
+                  transposeLetter(transA), '\0' };
+
+    if (routine[0] == '\0') {
+        *strict = 0;
+        return PATH_DEFAULT;
+    }
+    routine[3] = (funcID == CLBLAS_TRSM) ? 's' : 'm';
+
+    return pinnedPath(routine, op, M, N, 0, strict);
+}
+
+extern "C" unsigned int
+pathPattern(BlasFunctionID funcID, ImplPath path)
+{
+    int idx = -1;
+
+    if (funcID == CLBLAS_TRSM) {
+        switch (path) {
+        case PATH_LDS:    idx = getTrsmMemPatternIndex(clblasLdsBlockTrsm); break;
+        case PATH_IMAGE:  idx = getTrsmMemPatternIndex(clblasImageBlockTrsm); break;
+        case PATH_NO_LDS: idx = getTrsmMemPatternIndex(clblasBlockTrsmWithoutLds); break;
+        case PATH_CACHED: idx = getTrsmMemPatternIndex(clblasBlockTrsmWithCaching); break;
+        default:          break;
+        }
+    }
+    else if (funcID == CLBLAS_TRMM) {
+        switch (path) {
+        case PATH_LDS:    idx = getTrmmMemPatternIndex(clblasLdsBlockTrmm); break;
+        case PATH_IMAGE:  idx = getTrmmMemPatternIndex(clblasImageBlockTrmm); break;
+        case PATH_CACHED: idx = getTrmmMemPatternIndex(clblasBlockTrmmWithCaching); break;
+        default:          break;
+        }
+    }
+
+    return (idx < 0) ? 0 : static_cast<unsigned int>(idx) + 1;
+}
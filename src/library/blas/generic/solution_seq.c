@@ -18,11 +18,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <clblas_stddef.h>
+#include <mutex.h>
 
 #include "matrix_dims.h"
 #include "problem_iter.h"
 #include "solution_assert.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 bool VISIBILITY_HIDDEN isMatrixInImage(MemoryPattern *pattern, MatrixRole mrole);
 void VISIBILITY_HIDDEN releaseStepImgs(SolutionStep *step);
@@ -50,6 +52,87 @@ executeImageStep(
     const cl_event *eventWaitList,
     cl_event *event);
 
+/*
+ * Released solution steps are kept in a pool rather than being returned to
+ * the heap, so that in steady state making a sequence does not allocate.
+ */
+enum {
+    STEP_POOL_MAX_SIZE = 64
+};
+
+static mutex_t *stepPoolLock = NULL;
+static ListHead stepPool;
+static unsigned int stepPoolSize = 0;
+
+void
+solutionStepPoolSetup(void)
+{
+    listInitHead(&stepPool);
+    stepPoolSize = 0;
+    stepPoolLock = mutexInit();
+}
+
+void
+solutionStepPoolTeardown(void)
+{
+    ListNode *node;
+
+    mutexLock(stepPoolLock);
+    while (!isListEmpty(&stepPool)) {
+        node = listNodeFirst(&stepPool);
+        listDel(node);
+        free(container_of(node, node, SolutionStep));
+    }
+    stepPoolSize = 0;
+    mutexUnlock(stepPoolLock);
+
+    mutexDestroy(stepPoolLock);
+    stepPoolLock = NULL;
+}
+
+SolutionStep
+*allocSolutionStep(void)
+{
+    SolutionStep *step = NULL;
+    ListNode *node;
+
+    if (stepPoolLock == NULL) {
+        return calloc(1, sizeof(SolutionStep));
+    }
+
+    mutexLock(stepPoolLock);
+    if (!isListEmpty(&stepPool)) {
+        node = listNodeFirst(&stepPool);
+        listDel(node);
+        stepPoolSize--;
+        step = container_of(node, node, SolutionStep);
+    }
+    mutexUnlock(stepPoolLock);
+
+    if (step == NULL) {
+        return calloc(1, sizeof(SolutionStep));
+    }
+    memset(step, 0, sizeof(SolutionStep));
+
+    return step;
+}
+
+void
+releaseSolutionStep(SolutionStep *step)
+{
+    if (stepPoolLock != NULL) {
+        mutexLock(stepPoolLock);
+        if (stepPoolSize < STEP_POOL_MAX_SIZE) {
+            listAddToHead(&stepPool, &step->node);
+            stepPoolSize++;
+            step = NULL;
+        }
+        mutexUnlock(stepPoolLock);
+    }
+
+    free(step);
+}
+
 void
 freeSolutionSeq(ListHead *seq)
 {
@@ -107,7 +190,7 @@ freeSolutionStep(ListNode *node)
         }
     }
     releaseStepImgs(step);
-    free(step);
+    releaseSolutionStep(step);
 }
 
 static cl_int
@@ -204,6 +287,9 @@ enqueueKernel(
     if (err == CL_SUCCESS) {
         err = launchClKernel(&kernelDesc, step->cmdQueue, &errInfo);
         clReleaseKernel(kernelDesc.kernel);
+        if (err == CL_SUCCESS) {
+            statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+        }
     }
 
     return err;
@@ -29,6 +29,7 @@
 #include "matrix_dims.h"
 #include "solution_assert.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 #define DECOMPOSITION_THRESHOLD(type) (2560 * sizeof(cl_float) / dtypeSize(type))
 
@@ -47,7 +48,11 @@ enum {
     DEFAULT_BUFS_LSIZE_0 = 8,
     DEFAULT_BUFS_LSIZE_1 = 8,
     DEFAULT_CACHED_BUFS_LSIZE_0 = 8,
-    DEFAULT_CACHED_BUFS_LSIZE_1 = 8
+    DEFAULT_CACHED_BUFS_LSIZE_1 = 8,
+    CPU_BUFS_LSIZE_0 = 4,
+    CPU_BUFS_LSIZE_1 = 4,
+    // rows and columns of the tile each work item computes on CPU devices
+    CPU_ITEM_TILE_SIZE = 8
 };
 
 static cl_uint getQueueMaxImages(cl_command_queue queue);
@@ -269,6 +274,30 @@ selectVectorization(
 
         kextra->vecLen = umin(kextra->vecLenA, kextra->vecLenB);
         kextra->vecLen = umin(kextra->vecLenC, kextra->vecLen);
+
+        /*
+         * CPUs get vectors matching their SIMD unit. For other devices
+         * without known tuning don't issue loads wider than the ones
+         * giving the best bandwidth according to the device profile
+         */
+        vlen = 0;
+        if (device->ident.family == CPU_FAMILY_GENERIC) {
+            vlen = umax(1, deviceSIMDWidth(device->id, NULL) / tsize);
+        }
+        else if (device->ident.chip == CHIP_UNKNOWN) {
+            const DeviceProfile *profile = getDeviceProfile(device->id);
+
+            if (profile != NULL) {
+                vlen = umax(1, profile->loadVecLen * sizeof(cl_float) /
+                               tsize);
+            }
+        }
+        if (vlen) {
+            kextra->vecLenA = umin(kextra->vecLenA, vlen);
+            kextra->vecLenB = umin(kextra->vecLenB, vlen);
+            kextra->vecLenC = umin(kextra->vecLenC, vlen);
+            kextra->vecLen = umin(kextra->vecLen, vlen);
+        }
     }
 
     kextra->flags = kflags;
@@ -386,7 +415,7 @@ makeSolutionSeq(
             }
         }
 
-        step = calloc(1, sizeof(SolutionStep));
+        step = allocSolutionStep();
         if (step == NULL) {
             freeSolutionSeq(seq);
             return CL_OUT_OF_HOST_MEMORY;
@@ -562,6 +591,8 @@ makeSolutionSeq(
 
             if (areKernelsCacheable()) {
                 kernel = findKernel(clblasKernelCache, sid, &key, &extra);
+                statisticsAdd((kernel != NULL) ? STAT_KERNEL_CACHE_HITS :
+                                                 STAT_KERNEL_CACHE_MISSES, 1);
             }
             if (kernel == NULL) {
                 if (!loadData && !avoidLoadFromStorage(step)) {
@@ -763,6 +794,14 @@ checkMatrixMemLevelSet(
  */
 static const size_t DIVISION_ALIGNMENT = 128;
 
+/*
+ * Number of steps rectDivision() sorts without allocating a separate array,
+ * it is enough for any real system
+ */
+enum {
+    RECT_DIVISION_STACK_STEPS = 16
+};
+
 static size_t
 align(
     size_t value,
@@ -873,19 +912,27 @@ rectDivision(
      cl_uint totalCUs)
  {
      SolutionStep *step, **sortedSteps;
+     SolutionStep *stepsOnStack[RECT_DIVISION_STACK_STEPS];
      ListNode *i, *j;
      cl_int err;
      cl_device_id device;
      cl_uint nrCU, k, l;
      SubproblemDim size, offset, stepSize;
      unsigned int nrSteps = 0;
+     size_t seqLen;
 
      /* 1. Sort steps according to the number of CU they have */
      /* NOTE: We expect small number of steps, so simple insertion sort
       *       would be enough.
       */
 
-     sortedSteps = calloc(listLength(seq), sizeof(*sortedSteps));
+     seqLen = listLength(seq);
+     if (seqLen <= RECT_DIVISION_STACK_STEPS) {
+         sortedSteps = stepsOnStack;
+     }
+     else {
+         sortedSteps = calloc(seqLen, sizeof(*sortedSteps));
+     }
      // assert(sortedSteps != NULL);
 
      k = 0;
@@ -970,7 +1017,9 @@ rectDivision(
          totalCUs -= nrCU;
      }
 
-     free(sortedSteps);
+     if (sortedSteps != stepsOnStack) {
+         free(sortedSteps);
+     }
 }
 
 /* Dividing triangular matrix (N x N) horizontally:
@@ -1241,6 +1290,12 @@ selectPattern( SolutionStep* pStep,
     int funcID = pStep->funcID;
     unsigned int kflags = pStep->extraFlags;
 
+    if ((pStep->args.pattern != 0) &&
+        (pStep->args.pattern <= clblasSolvers[funcID].nrPatterns)) {
+
+        return pStep->args.pattern - 1;
+    }
+
     if (clblasSolvers[funcID].defaultPattern != -1) {
 // assert(clblasSolvers[funcID].defaultPattern < clblasSolvers[funcID].nrPatterns);
         return clblasSolvers[funcID].defaultPattern;
@@ -1255,6 +1310,17 @@ selectPattern( SolutionStep* pStep,
                 kflags,
                 (void*)&pStep->args);
 
+            /*
+             * Local memory is emulated in the cache of CPU devices, so
+             * staging through it is pure overhead
+             */
+            if ((pStep->device.ident.family == CPU_FAMILY_GENERIC) &&
+                (perf > PPERF_POOR) &&
+                isLdsUsed(&clblasSolvers[funcID].memPatterns[i])) {
+
+                perf = PPERF_POOR;
+            }
+
             if( perf > maxPerf ){
                 selPatt = i;
                 maxPerf = perf;
@@ -1698,6 +1764,48 @@ getDefaultStepGranulation(SolutionStep *step)
                dims[0].bwidth * tsize >= sizeof(cl_float4));
     }
 
+    /*
+     * CPU devices prefer few work items each of them computing a large
+     * tile; the whole block is sized to fit the per-core cache below
+     */
+    if (!square && !isLdsUsed(mempat) &&
+        (step->device.ident.family == CPU_FAMILY_GENERIC) &&
+        (step->funcID != CLBLAS_GEMM2) && (step->funcID != CLBLAS_GEMM_TAIL) &&
+        (step->funcID != CLBLAS_TRSV) && (step->funcID != CLBLAS_TRSV_GEMV) &&
+        (step->funcID != CLBLAS_TRMV) && (step->funcID != CLBLAS_HEMV)) {
+
+        wgY = CPU_BUFS_LSIZE_0;
+        wgX = CPU_BUFS_LSIZE_1;
+        dims[0].y = CPU_ITEM_TILE_SIZE * wgY;
+        dims[0].x = CPU_ITEM_TILE_SIZE * wgX;
+    }
+
+    /*
+     * For devices without known tuning and patterns working through the
+     * cache, keep the block working set within a half of the measured
+     * L1 cache
+     */
+    if (!square && !isLdsUsed(mempat) && (step->device.ident.chip == CHIP_UNKNOWN) &&
+        (step->funcID != CLBLAS_GEMM2) && (step->funcID != CLBLAS_GEMM_TAIL) &&
+        (step->funcID != CLBLAS_TRSV) && (step->funcID != CLBLAS_TRSV_GEMV)) {
+
+        const DeviceProfile *profile = getDeviceProfile(devID);
+
+        if ((profile != NULL) && profile->l1CacheSize) {
+            while (((dims[0].y + dims[0].x) * dims[0].bwidth * tsize >
+                    profile->l1CacheSize / 2) &&
+                   (dims[0].y > 8 || dims[0].x > 8)) {
+
+                if (dims[0].y >= dims[0].x) {
+                    dims[0].y /= 2;
+                }
+                else {
+                    dims[0].x /= 2;
+                }
+            }
+        }
+    }
+
     /*
      * adjust local size if a subproblem is not divisible
      * between all local threads
@@ -2009,18 +2117,18 @@ decomposeTRXMStep(SolutionStep *step)
         return &(step->node);
     }
 
-    trxm1 = calloc(1, sizeof(SolutionStep));
-    gemm = calloc(1, sizeof(SolutionStep));
-    trxm2 = calloc(1, sizeof(SolutionStep));
+    trxm1 = allocSolutionStep();
+    gemm = allocSolutionStep();
+    trxm2 = allocSolutionStep();
     if ((trxm1 == NULL) || (gemm == NULL) || (trxm2 == NULL)) {
         if (trxm1 != NULL) {
-            free(trxm1);
+            releaseSolutionStep(trxm1);
         }
         if (gemm != NULL) {
-            free(gemm);
+            releaseSolutionStep(gemm);
         }
         if (trxm2 != NULL) {
-            free(trxm2);
+            releaseSolutionStep(trxm2);
         }
         return &(step->node);
     }
@@ -2029,6 +2137,8 @@ decomposeTRXMStep(SolutionStep *step)
     memcpy(trxm2, step, sizeof(SolutionStep));
 
     gemm->funcID = CLBLAS_GEMM;
+    // a pinned pattern is one of the triangular solver's
+    gemm->args.pattern = 0;
     gemm->args.C = kargs->B;
     gemm->args.ldc.matrix = kargs->ldb.matrix;
     gemm->args.offCY = kargs->offBX;
@@ -2249,7 +2359,7 @@ decomposeSYRKStep(SolutionStep *step)
         return &(step->node);
     }
 
-    syrk2 = malloc(sizeof(SolutionStep));
+    syrk2 = allocSolutionStep();
     if (syrk2 == NULL) {
         return &(step->node);
     }
@@ -2298,14 +2408,14 @@ decomposeSYR2KStep(SolutionStep *step)
         return &(step->node);
     }
 
-    syrk1 = calloc(1, sizeof(SolutionStep));
-    syrk2 = calloc(1, sizeof(SolutionStep));
+    syrk1 = allocSolutionStep();
+    syrk2 = allocSolutionStep();
     if ((syrk1 == NULL) || (syrk2 == NULL)) {
         if (syrk1 != NULL) {
-            free(syrk1);
+            releaseSolutionStep(syrk1);
         }
         if (syrk2 != NULL) {
-            free(syrk2);
+            releaseSolutionStep(syrk2);
         }
         return &(step->node);
     }
@@ -0,0 +1,305 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <statistics.h>
+#include <../functor/include/atomic_counter.h>
+
+extern "C"
+{
+#include <mutex.h>
+}
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+// the functions, and a slot for the work done outside of any call
+#define NR_SLOTS (BLAS_FUNCTIONS_NUMBER + 1)
+#define OUTSIDE_SLOT BLAS_FUNCTIONS_NUMBER
+#define NR_PRECISIONS (TYPE_HALF + 1)
+#define NAME_SIZE 32
+
+#if CLBLAS_USE_STD_ATOMIC
+
+// A counter is only written by its thread, so a relaxed load and store,
+// as cheap as a plain increment, is enough for the readers to see whole
+// values.
+typedef std::atomic<cl_ulong> Counter;
+
+static inline void counterAdd(Counter &counter, cl_ulong value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+}
+
+static inline cl_ulong counterGet(const Counter &counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+#else
+
+typedef volatile cl_ulong Counter;
+
+static inline void counterAdd(Counter &counter, cl_ulong value)
+{
+    counter += value;
+}
+
+static inline cl_ulong counterGet(const Counter &counter)
+{
+    return counter;
+}
+
+#endif
+
+struct ThreadStatistics
+{
+    Counter counters[NR_SLOTS][NR_PRECISIONS][STAT_NR_COUNTERS];
+};
+
+typedef cl_ulong Totals[NR_SLOTS][NR_PRECISIONS][STAT_NR_COUNTERS];
+
+// the call being made by the thread
+struct CallFrame
+{
+    int depth;
+    int slot;
+    int precision;
+    cl_ulong start;
+};
+
+static const char *functionNames[BLAS_FUNCTIONS_NUMBER] = {
+    "gemv", "symv", "gemm", "trmm", "trsm", "syrk", "syr2k", "trmv", "hemv",
+    "trsv", "trsv_gemv", "symm", "symm_diagonal", "hemm_diagonal", "gemm2",
+    "gemm_tail", "syr", "syr2", "ger", "her", "her2", "hemm", "herk", "tpmv",
+    "spmv", "hpmv", "tpsv", "spr", "spr2", "hpr", "hpr2", "gbmv", "tbmv",
+    "sbmv", "hbmv", "tbsv", "swap", "scal", "copy", "axpy", "dot",
+    "reduction_epilogue", "rotg", "rotmg", "rot", "rotm", "amax", "nrm2",
+    "asum", "transpose", "her2k"
+};
+
+// the blocks of all the threads which ever counted; they are kept when
+// the threads exit so that their counts are not lost
+static std::vector<ThreadStatistics*> threadBlocks;
+// totals at the last reset, subtracted from the current ones
+static Totals *baseline = NULL;
+static char names[NR_SLOTS][NR_PRECISIONS][NAME_SIZE];
+static mutex_t *statisticsLock = mutexInit();
+
+#if defined( _WIN32 )
+__declspec( thread ) static ThreadStatistics *threadStats = 0;
+__declspec( thread ) static CallFrame frame = { 0, OUTSIDE_SLOT, 0, 0 };
+#else
+static __thread ThreadStatistics *threadStats = 0;
+static __thread CallFrame frame = { 0, OUTSIDE_SLOT, 0, 0 };
+#endif
+
+static ThreadStatistics*
+getThreadStatistics(void)
+{
+    if (threadStats == NULL) {
+        ThreadStatistics *stats = new ThreadStatistics();
+
+        mutexLock(statisticsLock);
+        threadBlocks.push_back(stats);
+        mutexUnlock(statisticsLock);
+        threadStats = stats;
+    }
+
+    return threadStats;
+}
+
+extern "C" cl_ulong statisticsTime(void)
+{
+#if defined(_MSC_VER)
+    LARGE_INTEGER count, freq;
+
+    if (!QueryPerformanceCounter(&count) || !QueryPerformanceFrequency(&freq)) {
+        return 0;
+    }
+    return (cl_ulong)((double)count.QuadPart * 1e9 / (double)freq.QuadPart);
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+
+    if (timebase.denom == 0) {
+        (void)mach_timebase_info(&timebase);
+    }
+    return (cl_ulong)mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    struct timespec t;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &t) != 0) {
+        return 0;
+    }
+    return (cl_ulong)t.tv_sec * 1000000000UL + (cl_ulong)t.tv_nsec;
+#endif
+}
+
+extern "C" void statisticsAdd(StatCounter counter, cl_ulong value)
+{
+    ThreadStatistics *stats = getThreadStatistics();
+
+    counterAdd(stats->counters[frame.slot][frame.precision][counter], value);
+}
+
+extern "C" void statisticsEnter(BlasFunctionID funcID, DataType dtype)
+{
+    if (frame.depth++ > 0) {
+        return;
+    }
+
+    frame.slot = funcID;
+    frame.precision = dtype;
+    frame.start = statisticsTime();
+    statisticsAdd(STAT_CALLS, 1);
+}
+
+extern "C" void statisticsLeave(void)
+{
+    if (frame.depth == 0 || --frame.depth > 0) {
+        return;
+    }
+
+    statisticsAdd(STAT_ENQUEUE_TIME, statisticsTime() - frame.start);
+    frame.slot = OUTSIDE_SLOT;
+    frame.precision = 0;
+}
+
+extern "C" void statisticsProgramBuilt(cl_ulong start)
+{
+    statisticsAdd(STAT_PROGRAM_BUILDS, 1);
+    statisticsAdd(STAT_BUILD_TIME, statisticsTime() - start);
+}
+
+// must be called with the lock held
+static void
+sumThreadStatistics(Totals &totals)
+{
+    memset(totals, 0, sizeof(Totals));
+    for (size_t i = 0; i < threadBlocks.size(); i++) {
+        for (int s = 0; s < NR_SLOTS; s++) {
+            for (int p = 0; p < NR_PRECISIONS; p++) {
+                for (int c = 0; c < STAT_NR_COUNTERS; c++) {
+                    totals[s][p][c] +=
+                        counterGet(threadBlocks[i]->counters[s][p][c]);
+                }
+            }
+        }
+    }
+}
+
+static const char*
+statisticsName(int slot, int precision)
+{
+    static const char letters[NR_PRECISIONS] = { 's', 'd', 'c', 'z', 'u', 'h' };
+    char *name = names[slot][precision];
+
+    if (name[0] == '\0') {
+        if (slot == OUTSIDE_SLOT) {
+            snprintf(name, NAME_SIZE, "other");
+        }
+        else {
+            snprintf(name, NAME_SIZE, "%s%c%s",
+                     (slot == CLBLAS_iAMAX) ? "i" : "", letters[precision],
+                     functionNames[slot]);
+        }
+    }
+
+    return name;
+}
+
+extern "C" clblasStatus
+clblasGetStatistics(clblasStatistics *stats, size_t *count)
+{
+    Totals *totals;
+    size_t capacity, n = 0;
+
+    if (count == NULL || (stats == NULL && *count != 0)) {
+        return clblasInvalidValue;
+    }
+    capacity = *count;
+
+    totals = new Totals[1];
+
+    mutexLock(statisticsLock);
+
+    sumThreadStatistics(*totals);
+    for (int s = 0; s < NR_SLOTS; s++) {
+        for (int p = 0; p < NR_PRECISIONS; p++) {
+            cl_ulong *c = (*totals)[s][p];
+            bool used = false;
+
+            for (int i = 0; i < STAT_NR_COUNTERS; i++) {
+                if (baseline != NULL) {
+                    c[i] -= (*baseline)[s][p][i];
+                }
+                used = used || (c[i] != 0);
+            }
+            if (!used) {
+                continue;
+            }
+
+            if (n < capacity) {
+                clblasStatistics *st = &stats[n];
+
+                st->function = statisticsName(s, p);
+                st->calls = c[STAT_CALLS];
+                st->kernelLaunches = c[STAT_KERNEL_LAUNCHES];
+                st->kernelCacheHits = c[STAT_KERNEL_CACHE_HITS];
+                st->kernelCacheMisses = c[STAT_KERNEL_CACHE_MISSES];
+                st->binaryCacheHits = c[STAT_BINARY_CACHE_HITS];
+                st->binaryCacheMisses = c[STAT_BINARY_CACHE_MISSES];
+                st->programBuilds = c[STAT_PROGRAM_BUILDS];
+                st->buildMilliseconds = (cl_double)c[STAT_BUILD_TIME] / 1e6;
+                st->generatorInvocations = c[STAT_GENERATIONS];
+                st->temporaryBytes = c[STAT_TEMP_BYTES];
+                st->meanEnqueueMicroseconds = (c[STAT_CALLS] == 0) ? 0 :
+                    (cl_double)c[STAT_ENQUEUE_TIME] / 1e3 / c[STAT_CALLS];
+            }
+            n++;
+        }
+    }
+
+    mutexUnlock(statisticsLock);
+
+    delete[] totals;
+    *count = n;
+
+    return clblasSuccess;
+}
+
+extern "C" clblasStatus
+clblasResetStatistics(void)
+{
+    mutexLock(statisticsLock);
+    if (baseline == NULL) {
+        baseline = new Totals[1];
+    }
+    sumThreadStatistics(*baseline);
+    mutexUnlock(statisticsLock);
+
+    return clblasSuccess;
+}
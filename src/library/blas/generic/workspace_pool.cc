@@ -0,0 +1,214 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+#include <stdlib.h>
+#include <list>
+
+#include <workspace_pool.h>
+#include <statistics.h>
+
+extern "C"
+{
+#include <mutex.h>
+}
+
+#define DEFAULT_POOL_LIMIT_MB 256
+
+struct IdleWorkspace
+{
+    cl_context context;
+    cl_mem mem;
+    size_t size;
+};
+
+// most recently released buffers first
+typedef std::list<IdleWorkspace> IdleWorkspaceList;
+
+static mutex_t *poolLock = NULL;
+static IdleWorkspaceList *idleList = NULL;
+static size_t idleBytes = 0;
+static size_t poolLimit = 0;
+
+extern "C" void workspacePoolSetup(void)
+{
+    const char *env = getenv("AMD_CLBLAS_WORKSPACE_POOL_LIMIT_MB");
+
+    poolLimit = (env != NULL) ? (size_t)atoi(env) : DEFAULT_POOL_LIMIT_MB;
+    poolLimit *= 1024 * 1024;
+
+    poolLock = mutexInit();
+    idleList = new IdleWorkspaceList;
+    idleBytes = 0;
+}
+
+extern "C" void workspacePoolTeardown(void)
+{
+    if (poolLock == NULL)
+    {
+        return;
+    }
+
+    mutexLock(poolLock);
+    for (IdleWorkspaceList::iterator it = idleList->begin();
+         it != idleList->end(); ++it)
+    {
+        clReleaseMemObject(it->mem);
+    }
+    delete idleList;
+    idleList = NULL;
+    idleBytes = 0;
+    mutexUnlock(poolLock);
+
+    mutexDestroy(poolLock);
+    poolLock = NULL;
+}
+
+extern "C" void workspacePoolReleaseContext(cl_context context)
+{
+    if (poolLock == NULL)
+    {
+        return;
+    }
+
+    mutexLock(poolLock);
+    for (IdleWorkspaceList::iterator it = idleList->begin();
+         it != idleList->end(); )
+    {
+        if (it->context == context)
+        {
+            idleBytes -= it->size;
+            clReleaseMemObject(it->mem);
+            it = idleList->erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    mutexUnlock(poolLock);
+}
+
+extern "C" cl_mem acquireWorkspace(
+    cl_context context,
+    size_t size,
+    cl_int *err)
+{
+    if (poolLock != NULL)
+    {
+        IdleWorkspaceList::iterator best;
+        bool found = false;
+
+        mutexLock(poolLock);
+        for (IdleWorkspaceList::iterator it = idleList->begin();
+             it != idleList->end(); ++it)
+        {
+            if ((it->context == context) && (it->size >= size) &&
+                (it->size / 2 <= size) && (!found || (it->size < best->size)))
+            {
+                best = it;
+                found = true;
+            }
+        }
+
+        if (found)
+        {
+            cl_mem mem = best->mem;
+
+            idleBytes -= best->size;
+            idleList->erase(best);
+            mutexUnlock(poolLock);
+
+            if (err != NULL)
+            {
+                *err = CL_SUCCESS;
+            }
+            return mem;
+        }
+        mutexUnlock(poolLock);
+    }
+
+    cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE, size, NULL, err);
+
+    if (mem != NULL)
+    {
+        statisticsAdd(STAT_TEMP_BYTES, size);
+    }
+    return mem;
+}
+
+static void putWorkspace(cl_mem mem)
+{
+    IdleWorkspace entry;
+
+    if ((poolLock == NULL) ||
+        (clGetMemObjectInfo(mem, CL_MEM_CONTEXT, sizeof(entry.context),
+                            &entry.context, NULL) != CL_SUCCESS) ||
+        (clGetMemObjectInfo(mem, CL_MEM_SIZE, sizeof(entry.size),
+                            &entry.size, NULL) != CL_SUCCESS) ||
+        (entry.size > poolLimit))
+    {
+        clReleaseMemObject(mem);
+        return;
+    }
+    entry.mem = mem;
+
+    mutexLock(poolLock);
+    idleList->push_front(entry);
+    idleBytes += entry.size;
+    // drop the least recently used buffers
+    while (idleBytes > poolLimit)
+    {
+        idleBytes -= idleList->back().size;
+        clReleaseMemObject(idleList->back().mem);
+        idleList->pop_back();
+    }
+    mutexUnlock(poolLock);
+}
+
+static void CL_CALLBACK workspaceEventCallback(
+    cl_event event,
+    cl_int status,
+    void *userData)
+{
+    (void)event;
+    (void)status;
+
+    putWorkspace(static_cast<cl_mem>(userData));
+}
+
+extern "C" void releaseWorkspace(
+    cl_mem workspace,
+    cl_event event)
+{
+    if (workspace == NULL)
+    {
+        return;
+    }
+
+    if (event == NULL)
+    {
+        putWorkspace(workspace);
+    }
+    else if (clSetEventCallback(event, CL_COMPLETE, workspaceEventCallback,
+                                workspace) != CL_SUCCESS)
+    {
+        /*
+         * There's no telling when the buffer is free then; the runtime
+         * keeps it alive until the commands using it complete.
+         */
+        clReleaseMemObject(workspace);
+    }
+}
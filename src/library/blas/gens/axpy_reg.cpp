@@ -265,8 +265,8 @@ assignKargs(KernelArg *args, const void *params, const void* )
 	cl_int incx, incy;
 
     assignScalarKarg(&args[0], &(blasArgs->alpha), blasArgs->dtype);
-    INIT_KARG(&args[1], blasArgs->A);
-	INIT_KARG(&args[2], blasArgs->B);
+    INIT_MEM_KARG(&args[1], blasArgs->A, blasArgs->svm);
+	INIT_MEM_KARG(&args[2], blasArgs->B, blasArgs->svm);
     initSizeKarg(&args[3], blasArgs->N);
     initSizeKarg(&args[4], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
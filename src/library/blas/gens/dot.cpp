@@ -267,9 +267,9 @@ assignKargs(KernelArg *args, const void *params, const void* )
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 	cl_int incx, incy, doConj;
 
-    INIT_KARG(&args[0], blasArgs->B);
-	INIT_KARG(&args[1], blasArgs->C);
-	INIT_KARG(&args[2], blasArgs->D);
+    INIT_MEM_KARG(&args[0], blasArgs->B, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->C, blasArgs->svm);
+	INIT_MEM_KARG(&args[2], blasArgs->D, blasArgs->svm);
     initSizeKarg(&args[3], blasArgs->N);
     initSizeKarg(&args[4], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
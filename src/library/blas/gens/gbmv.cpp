@@ -379,9 +379,9 @@ assignKargs(KernelArg *args, const void *params, const void* )
 	    fKU = blasArgs->KU;
 	}
 
-    INIT_KARG(&args[0], blasArgs->A); 	    //A - input matrix - argument
-    INIT_KARG(&args[1], blasArgs->C);       //y - y vector
-    INIT_KARG(&args[2], blasArgs->B);       //x - actual x vector argument
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm); 	    //A - input matrix - argument
+    INIT_MEM_KARG(&args[1], blasArgs->C, blasArgs->svm);       //y - y vector
+    INIT_MEM_KARG(&args[2], blasArgs->B, blasArgs->svm);       //x - actual x vector argument
 
 	initSizeKarg(&args[3], fM);
     initSizeKarg(&args[4], fN);
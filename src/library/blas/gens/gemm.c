@@ -1077,9 +1077,9 @@ assignBlockKargs(KernelArg *args, const void *params, const void *extra)
     initSizeKarg(&args[2], blasArgs->K);
     assignScalarKarg(&args[3], &(blasArgs->alpha), blasArgs->dtype);
     assignScalarKarg(&args[4], &(blasArgs->beta), blasArgs->dtype);
-    INIT_KARG(&args[5], blasArgs->A);
-    INIT_KARG(&args[6], blasArgs->B);
-    INIT_KARG(&args[7], blasArgs->C);
+    INIT_MEM_KARG(&args[5], blasArgs->A, blasArgs->svm);
+    INIT_MEM_KARG(&args[6], blasArgs->B, blasArgs->svm);
+    INIT_MEM_KARG(&args[7], blasArgs->C, blasArgs->svm);
     initSizeKarg(&args[8], blasArgs->lda.matrix);
     initSizeKarg(&args[9], blasArgs->ldb.matrix);
     initSizeKarg(&args[10], blasArgs->ldc.matrix);
@@ -1145,9 +1145,9 @@ assignSubgKargs(KernelArg *args, const void *params, const void *extra)
     initSizeKarg(&args[2], blasArgs->K);
     assignScalarKarg(&args[3], &(blasArgs->alpha), blasArgs->dtype);
     assignScalarKarg(&args[4], &(blasArgs->beta), blasArgs->dtype);
-    INIT_KARG(&args[5], blasArgs->A);
-    INIT_KARG(&args[6], blasArgs->B);
-    INIT_KARG(&args[7], blasArgs->C);
+    INIT_MEM_KARG(&args[5], blasArgs->A, blasArgs->svm);
+    INIT_MEM_KARG(&args[6], blasArgs->B, blasArgs->svm);
+    INIT_MEM_KARG(&args[7], blasArgs->C, blasArgs->svm);
     initSizeKarg(&args[8], blasArgs->lda.matrix);
     initSizeKarg(&args[9], blasArgs->ldb.matrix);
     initSizeKarg(&args[10], blasArgs->ldc.matrix);
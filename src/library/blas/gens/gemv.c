@@ -415,13 +415,13 @@ assignKargs(KernelArg *args, const void *params, const void *extra)
     initSizeKarg(&args[0], blasArgs->M);
     initSizeKarg(&args[1], blasArgs->N);
     assignScalarKarg(&args[2], &(blasArgs->alpha), blasArgs->dtype);
-    INIT_KARG(&args[3], blasArgs->A);
-    INIT_KARG(&args[4], blasArgs->B);
+    INIT_MEM_KARG(&args[3], blasArgs->A, blasArgs->svm);
+    INIT_MEM_KARG(&args[4], blasArgs->B, blasArgs->svm);
     i = 5;
     if (!(kflags & KEXTRA_BETA_ZERO)) {
         assignScalarKarg(&args[i++], &(blasArgs->beta), blasArgs->dtype);
     }
-    INIT_KARG(&args[i], blasArgs->C);
+    INIT_MEM_KARG(&args[i], blasArgs->C, blasArgs->svm);
     i++;
     initSizeKarg(&args[i++], blasArgs->lda.matrix);
     if (kflags & KEXTRA_A_OFF_NOT_ZERO) {
@@ -311,9 +311,9 @@ assignKargs(KernelArg *args, const void *params, const void*)
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
     cl_int incx, incy, doConj;
 
-    INIT_KARG(&args[0], blasArgs->B); 	//  B - our X vector
-    INIT_KARG(&args[1], blasArgs->C); 	//  C - our Y vector
-    INIT_KARG(&args[2], blasArgs->A); 	//  A - matrix A
+    INIT_MEM_KARG(&args[0], blasArgs->B, blasArgs->svm); 	//  B - our X vector
+    INIT_MEM_KARG(&args[1], blasArgs->C, blasArgs->svm); 	//  C - our Y vector
+    INIT_MEM_KARG(&args[2], blasArgs->A, blasArgs->svm); 	//  A - matrix A
     initSizeKarg(&args[3], blasArgs->M);
 	initSizeKarg(&args[4], blasArgs->N);
 
@@ -327,9 +327,9 @@ assignKargs(KernelArg *args, const void *params, const void*)
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
     cl_int inc;
 
-    INIT_KARG(&args[0], blasArgs->A); 	//A - input/output matrix - argument
-    INIT_KARG(&args[1], blasArgs->B); 	//X - x vector
-	INIT_KARG(&args[2], blasArgs->C); 	//Y - y vector
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm); 	//A - input/output matrix - argument
+    INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm); 	//X - x vector
+	INIT_MEM_KARG(&args[2], blasArgs->C, blasArgs->svm); 	//Y - y vector
 	initSizeKarg(&args[3], blasArgs->N);
 	initSizeKarg(&args[4], blasArgs->offBX);
     inc = blasArgs->ldb.Vector;
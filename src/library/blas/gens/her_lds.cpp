@@ -326,8 +326,8 @@ assignKargs(KernelArg *args, const void *params, const void*)
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
     cl_int incx;
 
-    INIT_KARG(&args[0], blasArgs->A); 	//A - input/output matrix - argument
-    INIT_KARG(&args[1], blasArgs->B); 	//x - x vector
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm); 	//A - input/output matrix - argument
+    INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm); 	//x - x vector
     initSizeKarg(&args[2], blasArgs->N);
 	initSizeKarg(&args[3], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
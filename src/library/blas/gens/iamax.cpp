@@ -273,8 +273,8 @@ assignKargs(KernelArg *args, const void *params, const void* )
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 	cl_int incx;
 
-    INIT_KARG(&args[0], blasArgs->B);
-	INIT_KARG(&args[1], blasArgs->D);
+    INIT_MEM_KARG(&args[0], blasArgs->B, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->D, blasArgs->svm);
     initSizeKarg(&args[2], blasArgs->N);
     initSizeKarg(&args[3], blasArgs->offb);
     incx = blasArgs->ldb.Vector;
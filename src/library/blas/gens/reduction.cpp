@@ -282,8 +282,8 @@ assignKargs(KernelArg *args, const void *params, const void* _extra)
     DUMMY_ARG_USAGE(_extra);
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 
-    INIT_KARG(&args[0], blasArgs->D);
-	INIT_KARG(&args[1], blasArgs->A);
+    INIT_MEM_KARG(&args[0], blasArgs->D, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->A, blasArgs->svm);
     initSizeKarg(&args[2], blasArgs->N);
     size_t offScratch = 0;
     initSizeKarg(&args[3], offScratch);
@@ -203,10 +203,10 @@ assignKargs(KernelArg *args, const void *params, const void* )
 {
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 
-    INIT_KARG(&args[0], blasArgs->A);
-	INIT_KARG(&args[1], blasArgs->B);
-	INIT_KARG(&args[2], blasArgs->C);
-    INIT_KARG(&args[3], blasArgs->D);
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm);
+	INIT_MEM_KARG(&args[2], blasArgs->C, blasArgs->svm);
+    INIT_MEM_KARG(&args[3], blasArgs->D, blasArgs->svm);
     initSizeKarg(&args[4], blasArgs->offa);
     initSizeKarg(&args[5], blasArgs->offb);
     initSizeKarg(&args[6], blasArgs->offc);
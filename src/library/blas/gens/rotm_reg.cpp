@@ -264,8 +264,8 @@ assignKargs(KernelArg *args, const void *params, const void* )
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 	cl_int incx, incy;
 
-    INIT_KARG(&args[0], blasArgs->A);
-	INIT_KARG(&args[1], blasArgs->B);
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm);
     initSizeKarg(&args[2], blasArgs->N);
     initSizeKarg(&args[3], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
@@ -283,7 +283,7 @@ assignKargs(KernelArg *args, const void *params, const void* )
 	}
 	else if(blasArgs->pigFuncID == CLBLAS_ROTM)
 	{
-        INIT_KARG(&args[7], blasArgs->D);
+        INIT_MEM_KARG(&args[7], blasArgs->D, blasArgs->svm);
         initSizeKarg(&args[8], blasArgs->offd);
     }
 
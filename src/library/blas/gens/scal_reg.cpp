@@ -258,7 +258,7 @@ assignKargs(KernelArg *args, const void *params, const void* )
 	cl_int incx;
 
     assignScalarKarg(&args[0], &(blasArgs->alpha), blasArgs->dtype);
-    INIT_KARG(&args[1], blasArgs->A);
+    INIT_MEM_KARG(&args[1], blasArgs->A, blasArgs->svm);
     initSizeKarg(&args[2], blasArgs->N);
     initSizeKarg(&args[3], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
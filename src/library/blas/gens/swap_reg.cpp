@@ -261,8 +261,8 @@ assignKargs(KernelArg *args, const void *params, const void* )
     CLBlasKargs *blasArgs = (CLBlasKargs*)params;
 	cl_int incx, incy;
 
-    INIT_KARG(&args[0], blasArgs->A);
-	INIT_KARG(&args[1], blasArgs->B);
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm);
+	INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm);
     initSizeKarg(&args[2], blasArgs->N);
     initSizeKarg(&args[3], blasArgs->offBX);
     incx = blasArgs->ldb.Vector;
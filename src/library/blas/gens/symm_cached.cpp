@@ -238,9 +238,9 @@ assignKargs(KernelArg *args, const void *params, const void*)
 			CREAL(blasArgs->beta.argDoubleComplex) , CIMAG(blasArgs->beta.argDoubleComplex));
 	#endif
 
-    INIT_KARG(&args[0], blasArgs->A);   //A - input matrix - argument
-	INIT_KARG(&args[1], blasArgs->B);
-	INIT_KARG(&args[2], blasArgs->C);
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm);   //A - input matrix - argument
+	INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm);
+	INIT_MEM_KARG(&args[2], blasArgs->C, blasArgs->svm);
 	initSizeKarg(&args[3], blasArgs->M);
 	initSizeKarg(&args[4], blasArgs->N);
 	initSizeKarg(&args[5], blasArgs->lda.matrix);
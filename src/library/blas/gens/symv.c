@@ -908,8 +908,8 @@ assignKargs(KernelArg *args, const void *params, const void *extra)
 
     initSizeKarg(&args[0], blasArgs->K);
     assignScalarKarg(&args[1], &(blasArgs->alpha), blasArgs->dtype);
-    INIT_KARG(&args[2], blasArgs->A);
-    INIT_KARG(&args[3], blasArgs->B);
+    INIT_MEM_KARG(&args[2], blasArgs->A, blasArgs->svm);
+    INIT_MEM_KARG(&args[3], blasArgs->B, blasArgs->svm);
     i = 4;
     if (!(kflags & KEXTRA_BETA_ZERO)) {
         assignScalarKarg(&args[i++], &(blasArgs->beta), blasArgs->dtype);
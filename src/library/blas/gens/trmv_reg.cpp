@@ -414,16 +414,16 @@ assignKargs(KernelArg *args, const void *params, const void* )
     //bool incxOne = (blasArgs->ldb.vector == 1);
     //bool incyOne = (blasArgs->ldc.vector == 1);
 
-    INIT_KARG(&args[0], blasArgs->A); 	//A - input matrix - argument
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm); 	//A - input matrix - argument
     if( (step->funcID == CLBLAS_HEMV) || (blasArgs->pigFuncID == CLBLAS_HPMV) || (blasArgs->pigFuncID == CLBLAS_SPMV) )
 	{
-		INIT_KARG(&args[1], blasArgs->C);   //y - since the 2nd argument is the result buffer, we should send y for HEMV
-        INIT_KARG(&args[2], blasArgs->B);   //x - actual x vector argument
+		INIT_MEM_KARG(&args[1], blasArgs->C, blasArgs->svm);   //y - since the 2nd argument is the result buffer, we should send y for HEMV
+        INIT_MEM_KARG(&args[2], blasArgs->B, blasArgs->svm);   //x - actual x vector argument
 	}
 	else
 	{
-		INIT_KARG(&args[1], blasArgs->B); 	//x - result buffer = _xnew argument
-    	INIT_KARG(&args[2], blasArgs->C); 	//y - scratch == _x_vector argument
+		INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm); 	//x - result buffer = _xnew argument
+    	INIT_MEM_KARG(&args[2], blasArgs->C, blasArgs->svm); 	//y - scratch == _x_vector argument
     }
 	initSizeKarg(&args[3], blasArgs->N);
     inc = blasArgs->ldb.Vector;
@@ -379,8 +379,8 @@ assignKargs(KernelArg *args, const void *params, const void*)
     cl_int inc;
     cl_int unity, doConj;
 
-    INIT_KARG(&args[0], blasArgs->A);     //A - input matrix - argument
-    INIT_KARG(&args[1], blasArgs->B);     //x - result buffer = _xnew argument
+    INIT_MEM_KARG(&args[0], blasArgs->A, blasArgs->svm);     //A - input matrix - argument
+    INIT_MEM_KARG(&args[1], blasArgs->B, blasArgs->svm);     //x - result buffer = _xnew argument
     initSizeKarg(&args[2], blasArgs->N);
     inc = blasArgs->ldb.Vector;
     INIT_KARG(&args[3], inc);
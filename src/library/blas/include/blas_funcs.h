@@ -79,6 +79,7 @@ typedef enum BlasFunctionID {
     CLBLAS_NRM2,
     CLBLAS_ASUM,
     CLBLAS_TRANSPOSE,
+    CLBLAS_HER2K,       /* statistics only, solved as HERK */
 
     /* ! Must be the last */
     BLAS_FUNCTIONS_NUMBER
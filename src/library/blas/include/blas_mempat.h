@@ -27,6 +27,10 @@
 #include <clkern.h>
 #include <kern_cache.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Type of internal function implementation
  */
@@ -375,4 +379,8 @@ initAsumMemPatterns(MemoryPattern *mempats);
 int
 getAsumMemPatternIndex(clblasImplementation impl);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* BLAS_MEMPAT_H_ */
@@ -128,6 +128,9 @@ typedef struct CLBlasKargs {
     size_t KL;                  // Number of sub-diagonals in a banded-matrix
     size_t KU;                  // Number of super-diagonals in a banded-matrix
     reductionType redctnType;   // To store kind of reduction for reduction-framewrok to handle -- enum
+    bool svm;                   /**< Memory objects are SVM pointers */
+    /** Memory pattern pinned for the call plus one, 0 to select one */
+    unsigned int pattern;
 } CLBlasKargs;
 
 
@@ -142,6 +145,25 @@ void clblasInitBinaryCache(void);
  */
 void cleanFunctorCaches(void);
 
+/*
+ * Remove the entries for the context 'context' from all registered functor
+ * caches
+ */
+void discardContextFunctors(cl_context context);
+
+/*
+ * Release the kernels built for the context 'context' by the AutoGemm and
+ * the TRSM paths; a NULL context releases all of them
+ */
+void releaseGemmKernels(cl_context context);
+void releaseTrsmKernels(cl_context context);
+
+/*
+ * Setup and release the in-memory store of device profiles
+ */
+void deviceProfileSetup(void);
+void deviceProfileTeardown(void);
+
 
 static __inline bool
 areKernelsCacheable(void)
@@ -281,6 +303,12 @@ initSCImages(void);
 void
 releaseSCImages(void);
 
+/*
+ * Release the scratch images created in the context 'ctx'
+ */
+void
+releaseContextSCImages(cl_context ctx);
+
 /**
  * Request an image appropriating the most to perform a user API request
  *
@@ -388,6 +416,28 @@ checkVectorSizes(
     int incx,
     ErrorCodeSet err );
 
+/*
+ * Argument checks for SVM pointers. They are the same as for buffers
+ * except that the memory size can't be checked.
+ */
+clblasStatus
+checkSVMMatrixSizes(
+    DataType dtype,
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    const void *A,
+    size_t lda,
+    ErrorCodeSet err );
+
+clblasStatus
+checkSVMVectorSizes(
+    size_t N,
+    const void *x,
+    int incx,
+    ErrorCodeSet err );
+
 clblasStatus
 checkMemObjects(
     cl_mem A,
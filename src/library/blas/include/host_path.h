@@ -0,0 +1,68 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Host side execution of small problems and problems on CPU devices.
+ *
+ * A problem is run on the host if the device of the queue shares memory
+ * with the host and the problem size doesn't exceed the threshold set for
+ * the function with the AMD_CLBLAS_<FUNC>_HOST_THRESHOLD environment
+ * variable. The size is M*N*K for GEMM, M*N for GEMV and N for level 1
+ * functions. Only real single and double precision problems are supported.
+ */
+
+#ifndef HOST_PATH_H_
+#define HOST_PATH_H_
+
+#include <clblas-internal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void hostPathSetup(void);
+
+/*
+ * Check if a problem is worth running on the host. Arguments are
+ * passed the same way as to makeSolutionSeq()
+ */
+bool
+isHostPathSuitable(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues);
+
+/*
+ * Map the problem buffers and run the problem on the host. The event
+ * returned in 'events' is a user event completed when results are
+ * available to the device.
+ */
+clblasStatus
+executeOnHost(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events);
+
+#ifdef __cplusplus
+}       /* extern "C" { */
+#endif
+
+#endif  /* HOST_PATH_H_ */
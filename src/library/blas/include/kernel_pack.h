@@ -0,0 +1,77 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Kernel packs: files holding the binaries of the kernels built for some
+ * devices, keyed like the entries of the binary cache.
+ *
+ * The pack named by the CLBLAS_KERNEL_PACK environment variable is loaded
+ * at clblasSetup() and looked up before the binary cache, so that the
+ * kernels it holds are never compiled at run time. If the
+ * CLBLAS_KERNEL_PACK_OUTPUT environment variable is set, the binaries of
+ * all the kernels built until clblasTeardown() are written to the pack it
+ * names; the kpack tool drives the library that way.
+ */
+
+#ifndef KERNEL_PACK_H_
+#define KERNEL_PACK_H_
+
+#include <clBLAS.h>
+
+#ifdef __cplusplus
+#include <string>
+
+extern "C" {
+#endif
+
+void kernelPackSetup(void);
+void kernelPackTeardown(void);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+
+/*
+ * Whether kernels are looked up in or recorded to a pack
+ */
+bool kernelPackActive(void);
+
+/*
+ * Find the binary of the cache entry 'entry' of the kernel 'name' for
+ * 'device'. The binary stays valid until clblasTeardown().
+ */
+bool
+kernelPackFind(
+    cl_device_id device,
+    const std::string &name,
+    const std::string &entry,
+    const unsigned char **binary,
+    size_t *size);
+
+/*
+ * Record the binary of a kernel just built, if a pack is being written
+ */
+void
+kernelPackRecord(
+    cl_device_id device,
+    const std::string &name,
+    const std::string &entry,
+    const unsigned char *binary,
+    size_t size);
+
+#endif  /* __cplusplus */
+
+#endif /* KERNEL_PACK_H_ */
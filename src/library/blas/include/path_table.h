@@ -0,0 +1,130 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Implementation paths pinned per shape class.
+ *
+ * A GEMM, TRSM or TRMM can be served by several implementations, chosen by
+ * the library's own heuristics. A path table pins one of them for a class
+ * of shapes: the routine, the transpositions (and side and triangle) and
+ * the power of two bucket of each dimension. The table named by the
+ * CLBLAS_PATH_TABLE environment variable is loaded at clblasSetup(); the
+ * pathbench tool writes such tables.
+ *
+ * The CLBLAS_FORCE_PATH environment variable names a path taken by every
+ * call instead. It is read on every call so that it can be switched per
+ * problem, and a call the path can't serve fails with clblasNotImplemented
+ * rather than falling back, so that tools can tell that the path does not
+ * apply.
+ *
+ * Only the calls made by the application are pinned, not the ones the
+ * library makes for its own use, for instance the GEMMs of a TRSM. Those
+ * are made between pathInternalEnter() and pathInternalLeave().
+ */
+
+#ifndef PATH_TABLE_H_
+#define PATH_TABLE_H_
+
+#include <clBLAS.h>
+#include <cltypes.h>
+#include <blas_funcs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum ImplPath {
+    PATH_DEFAULT,       /* the library's own choice */
+    /* GEMM */
+    PATH_AUTOGEMM,      /* the AutoGemm tile kernels alone */
+    PATH_SPECIAL,       /* the kernels of GemmSpecialCases */
+    PATH_STRASSEN,
+    PATH_3M,
+    PATH_STREAMK,
+    PATH_SPLITK,
+    /* TRSM and TRMM */
+    PATH_RECURSIVE,     /* GEMM based recursion */
+    PATH_DTRSM,         /* the blocked DTRSM of the functor selectors */
+    PATH_LDS,           /* the generator's memory patterns */
+    PATH_IMAGE,
+    PATH_NO_LDS,
+    PATH_CACHED,
+    PATH_NR_PATHS
+} ImplPath;
+
+void pathTableSetup(void);
+void pathTableTeardown(void);
+
+/*
+ * Name of a path in the table and in CLBLAS_FORCE_PATH
+ */
+const char *pathName(ImplPath path);
+
+/*
+ * Path of a GEMM; 'strict' is set if a path the call can't take must fail
+ */
+ImplPath
+gemmPinnedPath(
+    DataType dtype,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    int *strict);
+
+/*
+ * Path of a TRSM or a TRMM, with the same 'strict'
+ */
+ImplPath
+trxmPinnedPath(
+    BlasFunctionID funcID,
+    DataType dtype,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    int *strict);
+
+/*
+ * Index of the memory pattern of 'funcID' a path stands for, plus one,
+ * so that 0 lets the solver choose
+ */
+unsigned int pathPattern(BlasFunctionID funcID, ImplPath path);
+
+/*
+ * Mark the calls of the thread, up to the matching pathInternalLeave(), as
+ * made by the library for its own use, so that they are never pinned.
+ * The marks nest.
+ */
+void pathInternalEnter(void);
+void pathInternalLeave(void);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+
+/* The calls of a scope are made by the library for its own use */
+class PathInternalScope
+{
+public:
+    PathInternalScope() { pathInternalEnter(); }
+    ~PathInternalScope() { pathInternalLeave(); }
+};
+#endif
+
+#endif /* PATH_TABLE_H_ */
@@ -115,6 +115,40 @@ freeSolutionSeq(ListHead *seq);
 void
 freeSolutionStep(ListNode *node);
 
+/**
+ * @internal
+ * @brief Allocate a zeroed solution step
+ *
+ * The step is taken from the pool of released steps if it is not empty,
+ * and is allocated on the heap otherwise.
+ *
+ * @returns The new step, or NULL if there is not enough memory.
+ *
+ * @ingroup SUBMIT_PROBLEM
+ */
+SolutionStep
+*allocSolutionStep(void);
+
+/**
+ * @internal
+ * @brief Release a solution step
+ *
+ * @param[in] step                  Step to release. It must not own any
+ *                                  kernels or images anymore.
+ *
+ * The step is put back to the pool unless it is full.
+ *
+ * @ingroup SUBMIT_PROBLEM
+ */
+void
+releaseSolutionStep(SolutionStep *step);
+
+void
+solutionStepPoolSetup(void);
+
+void
+solutionStepPoolTeardown(void);
+
 /**
  * @internal
  * @brief Execute solution sequence
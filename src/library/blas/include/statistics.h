@@ -0,0 +1,83 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Runtime statistics reported by clblasGetStatistics().
+ *
+ * Every thread counts into its own block, and a block is only written by
+ * its thread, so that counting takes no lock. The blocks are summed when
+ * the statistics are read. The work done between statisticsEnter() and
+ * statisticsLeave() is accounted to the function and precision given to
+ * the outermost statisticsEnter() of the thread, so that the GEMM calls a
+ * TRSM is made of count for the TRSM. Work done outside of any call is
+ * reported separately.
+ */
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+#include <clBLAS.h>
+#include <cltypes.h>
+#include <blas_funcs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum StatCounter {
+    STAT_CALLS,
+    STAT_KERNEL_LAUNCHES,
+    STAT_KERNEL_CACHE_HITS,
+    STAT_KERNEL_CACHE_MISSES,
+    STAT_BINARY_CACHE_HITS,
+    STAT_BINARY_CACHE_MISSES,
+    STAT_PROGRAM_BUILDS,
+    STAT_BUILD_TIME,            /* nanoseconds */
+    STAT_GENERATIONS,
+    STAT_TEMP_BYTES,
+    STAT_ENQUEUE_TIME,          /* nanoseconds */
+    STAT_NR_COUNTERS
+} StatCounter;
+
+/*
+ * Start accounting to a call of 'funcID' in the precision 'dtype'
+ */
+void statisticsEnter(BlasFunctionID funcID, DataType dtype);
+
+/*
+ * End the call started by the matching statisticsEnter(); the time
+ * between them is the host enqueue time of the call
+ */
+void statisticsLeave(void);
+
+void statisticsAdd(StatCounter counter, cl_ulong value);
+
+/*
+ * Monotonic time in nanoseconds
+ */
+cl_ulong statisticsTime(void);
+
+/*
+ * Count a program built, 'start' being the time the build started at
+ */
+void statisticsProgramBuilt(cl_ulong start);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+#endif
+
+#endif /* STATISTICS_H_ */
@@ -0,0 +1,73 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Single pass SPMV, HPMV and HEMV.
+ *
+ * The two TRMV-like passes of these routines each read the whole of A.
+ * Here every stored element is read once and used for both of its
+ * products, A(i,j)*x(j) and A(j,i)*x(i), in a single kernel launch. The
+ * partial sums of a block of y are combined by the last work group
+ * contributing to it. AMD_CLBLAS_SYMV_SINGLE_PASS=0 leaves these routines
+ * to the kernels of the solver framework.
+ */
+
+#ifndef SYMV_SINGLE_PASS_H_
+#define SYMV_SINGLE_PASS_H_
+
+#include <clBLAS.h>
+#include "clblas-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * y = alpha*A*x + beta*y for the symmetric, or if 'hermitian' is set the
+ * Hermitian, matrix A stored in its 'uplo' triangle: packed if 'lda' is 0,
+ * full otherwise. The data type, alpha and beta are taken from 'kargs'.
+ *
+ * Arguments must have been validated. If the problem can't be run on this
+ * path, 'handled' is set to false and nothing is enqueued.
+ */
+clblasStatus
+symvSinglePass(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    size_t N,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem X,
+    size_t offx,
+    int incx,
+    cl_mem Y,
+    size_t offy,
+    int incy,
+    bool hermitian,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+#endif
+
+#endif /* SYMV_SINGLE_PASS_H_ */
@@ -0,0 +1,77 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * SYRK, HERK, SYR2K and HER2K on the triangular AutoGemm kernels.
+ *
+ * A triangular kernel launches one work group per macro tile on the
+ * referenced side of the diagonal of C and masks the elements of diagonal
+ * tiles outside the triangle, so a rank-k update is a single launch and a
+ * rank-2k update two. AMD_CLBLAS_SYRK_AUTOGEMM=0 leaves these routines to
+ * the kernels of the solver framework.
+ */
+
+#ifndef SYRK_AUTOGEMM_H_
+#define SYRK_AUTOGEMM_H_
+
+#include <clBLAS.h>
+#include "clblas-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Update the 'uplo' triangle of C with alpha*A*B' (+ alpha'*B*A') + beta*C,
+ * where ' is the transpose, or the conjugate transpose if 'hermitian' is
+ * set; the product is A'*B (+ B'*A) if 'trans' is not clblasNoTrans. A NULL
+ * 'B' stands for the rank-k update with B = A. The data type, alpha and beta
+ * are taken from 'kargs'; for HER2K alpha' is the conjugate of alpha, and
+ * alpha is expected conjugated for row major order as clblas[CZ]her2k do.
+ *
+ * Arguments must have been validated. If the problem can't be run on these
+ * kernels, 'handled' is set to false and nothing is enqueued.
+ */
+clblasStatus
+syrkAutoGemm(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    clblasTranspose trans,
+    size_t N,
+    size_t K,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    bool hermitian,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+#endif
+
+#endif /* SYRK_AUTOGEMM_H_ */
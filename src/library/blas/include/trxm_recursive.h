@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Recursive TRSM and TRMM on top of GEMM.
+ *
+ * The triangle is split in halves until the diagonal blocks are small
+ * enough to be held in local memory by a single kernel, which solves or
+ * multiplies every right hand side against its block. The off-diagonal
+ * blocks are applied with clblas[SDCZ]gemm, so nearly all of the flops of
+ * a large problem run on the GEMM kernels.
+ *
+ * The path is taken when the order of the triangle is at least
+ * AMD_CLBLAS_TRXM_RECURSIVE (1024 if unset); 0 disables it.
+ */
+
+#ifndef TRXM_RECURSIVE_H_
+#define TRXM_RECURSIVE_H_
+
+#include <clBLAS.h>
+#include "clblas-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * B = alpha*op(A)^-1*B (funcID CLBLAS_TRSM) or B = alpha*op(A)*B
+ * (CLBLAS_TRMM), with op(A) on the right of B for clblasRight. The data
+ * type and alpha are taken from 'kargs'.
+ *
+ * Arguments must have been validated. If the problem is not run on this
+ * path, 'handled' is set to false and nothing is enqueued.
+ */
+clblasStatus
+trxmRecursive(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+#endif
+
+#endif /* TRXM_RECURSIVE_H_ */
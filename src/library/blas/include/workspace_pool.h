@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Pool of device buffers used as temporary workspace by the library.
+ *
+ * Buffers are kept per context after use and handed out again to later
+ * calls needing at least half of their size, so that a sequence of large
+ * calls doesn't allocate and free the same workspace every time.
+ * The amount of idle memory kept is bounded by the
+ * AMD_CLBLAS_WORKSPACE_POOL_LIMIT_MB environment variable, 256 MB by default.
+ */
+
+#ifndef WORKSPACE_POOL_H_
+#define WORKSPACE_POOL_H_
+
+#include <clBLAS.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void workspacePoolSetup(void);
+void workspacePoolTeardown(void);
+
+/*
+ * Release the idle buffers of the context 'context'
+ */
+void workspacePoolReleaseContext(cl_context context);
+
+/*
+ * Get a buffer of at least 'size' bytes in 'context', either from the
+ * pool or newly created.
+ */
+cl_mem
+acquireWorkspace(
+    cl_context context,
+    size_t size,
+    cl_int *err);
+
+/*
+ * Give a buffer back to the pool once 'event' completes; if 'event' is
+ * NULL the buffer must be no longer in use.
+ */
+void
+releaseWorkspace(
+    cl_mem workspace,
+    cl_event event);
+
+#ifdef __cplusplus
+}      /* extern "C" { */
+#endif
+
+#endif /* WORKSPACE_POOL_H_ */
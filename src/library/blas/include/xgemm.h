@@ -32,6 +32,18 @@ void makeGemmKernel(
 	size_t *kernelBinarySize,
 	const char *binaryBuildOptions);
 
+/*
+ * Hand the events of kernels enqueued on 'clQueue' back as one in
+ * 'clEvent': a marker waiting for all of them on an out-of-order queue,
+ * the last one on an in-order queue. The other events are released, all
+ * of them if 'clEvent' is NULL.
+ */
+cl_int joinGemmEvents(
+	cl_command_queue clQueue,
+	cl_uint numKernelEvents,
+	cl_event *kernelEvents,
+	cl_event *clEvent);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,10 +18,16 @@
 #include <clBLAS.h>
 #include <toolslib.h>
 #include <kern_cache.h>
+#include <kernel_blob.h>
 #include <clBLAS.version.h>
 #include <trace_malloc.h>
 
 #include "clblas-internal.h"
+#include "solution_seq.h"
+#include "host_path.h"
+#include "workspace_pool.h"
+#include "kernel_pack.h"
+#include "path_table.h"
 #include <events.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -58,6 +64,8 @@ clblasSetup(void)
 
 
     clblasInitBinaryCache();
+    kernelPackSetup();
+    pathTableSetup();
 
     clblasSolvers[CLBLAS_GEMM].nrPatterns =
         initGemmMemPatterns(clblasSolvers[CLBLAS_GEMM].memPatterns);
@@ -215,6 +223,11 @@ clblasSetup(void)
     }
 
     decomposeEventsSetup();
+    solutionStepPoolSetup();
+    deviceProfileSetup();
+    hostPathSetup();
+    workspacePoolSetup();
+    kernelBlobSetup();
 
     initStorageCache();
 
@@ -245,6 +258,12 @@ clblasTeardown(void)
     }
     releaseSCImages();
     decomposeEventsTeardown();
+    solutionStepPoolTeardown();
+    deviceProfileTeardown();
+    workspacePoolTeardown();
+    kernelBlobTeardown();
+    kernelPackTeardown();
+    pathTableTeardown();
 
     // win32 - crashes
     destroyStorageCache();
@@ -255,9 +274,37 @@ clblasTeardown(void)
     releaseMallocTrace();
 
 #ifdef BUILDING_CLBLAS
+   releaseGemmKernels(NULL);
+   releaseTrsmKernels(NULL);
    initUserGemmClKernels();
    initAutoGemmClKernels();
 #endif
 
     clblasInitialized = 0;
 }
+
+clblasStatus
+clblasReleaseContextResources(cl_context context)
+{
+    if (!clblasInitialized) {
+        return clblasNotInitialized;
+    }
+    if (context == NULL) {
+        return clblasInvalidContext;
+    }
+
+    if (clblasKernelCache != NULL) {
+        removeContextKernels(clblasKernelCache, context);
+    }
+    releaseContextSCImages(context);
+    workspacePoolReleaseContext(context);
+    discardContextFunctors(context);
+
+    // ktest and tune build the sources above, but not xgemm.cc and xtrsm.cc
+#ifdef BUILDING_CLBLAS
+    releaseGemmKernels(context);
+    releaseTrsmKernels(context);
+#endif
+
+    return clblasSuccess;
+}
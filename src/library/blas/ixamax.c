@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doiAmax(
@@ -122,6 +123,8 @@ doiAmax(
 #endif
         memcpy(&redctnArgs, kargs, sizeof(CLBlasKargs));
 
+		statisticsEnter(CLBLAS_iAMAX, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_iAMAX, kargs, numCommandQueues, commandQueues,
         					  numEventsInWaitList, eventWaitList, &firstiAmaxCall, &seq);
@@ -154,6 +157,7 @@ doiAmax(
 		}
 
 		freeSolutionSeq(&seq);
+		statisticsLeave();
 		return (clblasStatus)err;
 }
 
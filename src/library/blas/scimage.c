@@ -146,6 +146,28 @@ releaseSCImages(void)
     mutexDestroy(imagesLock);
 }
 
+static void
+releaseContextImage(ListNode *node, void *priv)
+{
+    SCImageNode *imgNode;
+    cl_context ctx = NULL;
+
+    imgNode = container_of(node, node, SCImageNode);
+    clGetMemObjectInfo(imgNode->image, CL_MEM_CONTEXT, sizeof(ctx), &ctx, NULL);
+    if (ctx == *(cl_context*)priv) {
+        listDel(node);
+        freeImageNode(node);
+    }
+}
+
+void VISIBILITY_HIDDEN
+releaseContextSCImages(cl_context ctx)
+{
+    IMAGES_LOCK();
+    listDoForEachPrivSafe(&images, releaseContextImage, &ctx);
+    IMAGES_UNLOCK();
+}
+
 cl_mem VISIBILITY_HIDDEN
 getSCImage(
     cl_context ctx,
@@ -0,0 +1,496 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+#include <stdlib.h>
+#include "Gemm3M.h"
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
+#include "workspace_pool.h"
+#include "path_table.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define GEMM3M_WG_SIZE 16
+
+// largest K range of one pass over the real GEMMs
+#define GEMM3M_K_PANEL 512
+// panels are multiples of this, and no narrower
+#define GEMM3M_MIN_PANEL 64
+// bound of the workspace, in bytes
+#define GEMM3M_MAX_WORKSPACE (256 * 1024 * 1024)
+
+/******************************************************************************
+ * Kernel sources. The split kernel stores a block of op(X) as three column
+ * major real planes: real part, imaginary part and their sum. The combine
+ * kernel forms C = alpha ((T1 - T2) + i (T3 - T1 - T2)) + beta C for a
+ * panel of columns of C.
+ *****************************************************************************/
+#define GEMM3M_SPLIT_SRC \
+"__kernel void gemm3MSplit(\n" \
+"    __global const TYPE *X,\n" \
+"    __global REAL *W,\n" \
+"    uint rows, uint cols,\n" \
+"    uint rowStart, uint colStart,\n" \
+"    uint offX, uint ldx, int trans,\n" \
+"    uint offRe, uint offIm, uint offSum)\n" \
+"{\n" \
+"    const uint r = get_global_id(0);\n" \
+"    const uint c = get_global_id(1);\n" \
+"    const uint i = rowStart + r;\n" \
+"    const uint j = colStart + c;\n" \
+"    const uint w = c * rows + r;\n" \
+"    TYPE v;\n" \
+"\n" \
+"    if ((r >= rows) || (c >= cols)) {\n" \
+"        return;\n" \
+"    }\n" \
+"    v = (trans == 0) ? X[offX + j * ldx + i] : X[offX + i * ldx + j];\n" \
+"    if (trans == 2) {\n" \
+"        v.y = -v.y;\n" \
+"    }\n" \
+"    W[offRe + w] = v.x;\n" \
+"    W[offIm + w] = v.y;\n" \
+"    W[offSum + w] = v.x + v.y;\n" \
+"}\n"
+
+#define GEMM3M_COMBINE_SRC \
+"#define MUL(a, b) ((TYPE)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x))\n" \
+"\n" \
+"__kernel void gemm3MCombine(\n" \
+"    __global const REAL *W,\n" \
+"    __global TYPE *C,\n" \
+"    uint M, uint N, uint colStart,\n" \
+"    uint offT1, uint offT2, uint offT3,\n" \
+"    uint ldc, uint offC,\n" \
+"    TYPE alpha, TYPE beta, int betaZero)\n" \
+"{\n" \
+"    const uint i = get_global_id(0);\n" \
+"    const uint j = get_global_id(1);\n" \
+"    const uint t = j * M + i;\n" \
+"    REAL t1, t2;\n" \
+"    TYPE prod;\n" \
+"\n" \
+"    if ((i >= M) || (j >= N)) {\n" \
+"        return;\n" \
+"    }\n" \
+"    t1 = W[offT1 + t];\n" \
+"    t2 = W[offT2 + t];\n" \
+"    prod = (TYPE)(t1 - t2, W[offT3 + t] - t1 - t2);\n" \
+"    C += offC + (colStart + j) * ldc + i;\n" \
+"    if (betaZero) {\n" \
+"        *C = MUL(alpha, prod);\n" \
+"    }\n" \
+"    else {\n" \
+"        *C = MUL(alpha, prod) + MUL(beta, *C);\n" \
+"    }\n" \
+"}\n"
+
+#define GEMM3M_COMPLEX_FLOAT_DEFS \
+"#define TYPE float2\n" \
+"#define REAL float\n"
+
+#define GEMM3M_COMPLEX_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define TYPE double2\n" \
+"#define REAL double\n"
+
+/*
+ * Real type of the planes and kernel sources for every precision. Kernels
+ * are cached by makeGemmKernel() by the address of their source, so every
+ * precision has sources of its own.
+ */
+template<typename Precision>
+struct Gemm3MTraits
+{
+  typedef Precision Real;
+  static const bool isComplex = false;
+  static const char *split;
+  static const char *combine;
+};
+
+template<>
+struct Gemm3MTraits<FloatComplex>
+{
+  typedef cl_float Real;
+  static const bool isComplex = true;
+  static const char *split;
+  static const char *combine;
+};
+
+template<>
+struct Gemm3MTraits<DoubleComplex>
+{
+  typedef cl_double Real;
+  static const bool isComplex = true;
+  static const char *split;
+  static const char *combine;
+};
+
+template<> const char *Gemm3MTraits<float>::split = NULL;
+template<> const char *Gemm3MTraits<float>::combine = NULL;
+template<> const char *Gemm3MTraits<double>::split = NULL;
+template<> const char *Gemm3MTraits<double>::combine = NULL;
+
+const char *Gemm3MTraits<FloatComplex>::split =
+  GEMM3M_COMPLEX_FLOAT_DEFS GEMM3M_SPLIT_SRC;
+const char *Gemm3MTraits<FloatComplex>::combine =
+  GEMM3M_COMPLEX_FLOAT_DEFS GEMM3M_COMBINE_SRC;
+const char *Gemm3MTraits<DoubleComplex>::split =
+  GEMM3M_COMPLEX_DOUBLE_DEFS GEMM3M_SPLIT_SRC;
+const char *Gemm3MTraits<DoubleComplex>::combine =
+  GEMM3M_COMPLEX_DOUBLE_DEFS GEMM3M_COMBINE_SRC;
+
+static bool isZero(float v) { return v == 0; }
+static bool isZero(double v) { return v == 0; }
+static bool isZero(FloatComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool isZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+static int transposeArg(clblasTranspose trans)
+{
+  return (trans == clblasNoTrans) ? 0 : (trans == clblasTrans) ? 1 : 2;
+}
+
+/******************************************************************************
+ * Real column major GEMMs over the planes
+ *****************************************************************************/
+static clblasStatus
+realGemm(cl_uint M, cl_uint N, cl_uint K,
+         cl_float alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb,
+         cl_float beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue,
+         cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList,
+         cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+    M, N, K, alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+static clblasStatus
+realGemm(cl_uint M, cl_uint N, cl_uint K,
+         cl_double alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb,
+         cl_double beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue,
+         cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList,
+         cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+    M, N, K, alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+/******************************************************************************
+ * Smallest of M, N and K using the 3M method, 0 if disabled. Read on every
+ * call so that it can be switched per problem.
+ *****************************************************************************/
+static cl_uint
+gemm3MThreshold(void)
+{
+  const char *env = getenv("AMD_CLBLAS_GEMM_3M");
+  int threshold = (env != NULL) ? atoi(env) : 0;
+
+  return (threshold > 0) ? static_cast<cl_uint>(threshold) : 0;
+}
+
+/******************************************************************************
+ * Choose the K panel 'kb' and the N panel 'nb' so that the planes of op(A),
+ * op(B) and the three products fit in the workspace bound. Return false if
+ * even the narrowest panels don't fit.
+ *****************************************************************************/
+static bool
+gemm3MPanels(
+  cl_uint M, cl_uint N, cl_uint K,
+  size_t realSize,
+  cl_uint &kb,
+  cl_uint &nb)
+{
+  const size_t budget = GEMM3M_MAX_WORKSPACE / realSize;
+  size_t cols;
+
+  // keep the planes of op(A) within half of the workspace
+  kb = GEMM3M_K_PANEL;
+  while ((kb > GEMM3M_MIN_PANEL) && (3 * (size_t)M * kb > budget / 2)) {
+    kb /= 2;
+  }
+  if (kb > K) {
+    kb = K;
+  }
+  if (3 * (size_t)M * kb >= budget) {
+    return false;
+  }
+
+  cols = (budget - 3 * (size_t)M * kb) / (3 * ((size_t)kb + M));
+  if (cols >= N) {
+    nb = N;
+  }
+  else if (cols >= GEMM3M_MIN_PANEL) {
+    nb = static_cast<cl_uint>((cols / GEMM3M_MIN_PANEL) * GEMM3M_MIN_PANEL);
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ * 3M GEMM
+ *****************************************************************************/
+template<typename Precision>
+clblasStatus
+Gemm3M(clblasTranspose transA,
+       clblasTranspose transB,
+       cl_uint M, cl_uint N, cl_uint K,
+       Precision alpha,
+       cl_mem A, cl_uint offA, cl_uint lda,
+       cl_mem B, cl_uint offB, cl_uint ldb,
+       Precision beta,
+       cl_mem C, cl_uint offC, cl_uint ldc,
+       cl_uint numCommandQueues,
+       cl_command_queue *commandQueues,
+       cl_uint numEventsInWaitList,
+       const cl_event *eventWaitList,
+       cl_event *events,
+       bool forced,
+       bool &gemm3MHandled)
+{
+  typedef typename Gemm3MTraits<Precision>::Real Real;
+
+  cl_command_queue queue = commandQueues[0];
+  cl_uint threshold = forced ? 1 : gemm3MThreshold();
+  cl_context context;
+  cl_uint kb, nb;
+  cl_int err;
+
+  (void)numCommandQueues;
+
+  gemm3MHandled = false;
+  if (!Gemm3MTraits<Precision>::isComplex || (threshold == 0) ||
+      (M < threshold) || (N < threshold) || (K < threshold)) {
+    return clblasNotImplemented;
+  }
+  if (!gemm3MPanels(M, N, K, sizeof(Real), kb, nb)) {
+    return clblasNotImplemented;
+  }
+
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(context), &context, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  gemm3MHandled = true;
+
+/******************************************************************************
+ * Build kernels
+ *****************************************************************************/
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+  cl_kernel splitKernel = NULL;
+  cl_kernel combineKernel = NULL;
+
+  makeGemmKernel(&splitKernel, queue, Gemm3MTraits<Precision>::split,
+    "", &noBinary, &noBinarySize, "");
+  makeGemmKernel(&combineKernel, queue, Gemm3MTraits<Precision>::combine,
+    "", &noBinary, &noBinarySize, "");
+
+/******************************************************************************
+ * Workspace: planes of op(A), planes of op(B) and the three products
+ *****************************************************************************/
+  const cl_uint sizeAPlane = M * kb;
+  const cl_uint sizeBPlane = kb * nb;
+  const cl_uint sizeTPlane = M * nb;
+  const cl_uint offAPlanes = 0;
+  const cl_uint offBPlanes = 3 * sizeAPlane;
+  const cl_uint offTPlanes = offBPlanes + 3 * sizeBPlane;
+
+  cl_mem W = acquireWorkspace(context,
+    ((size_t)offTPlanes + 3 * sizeTPlane) * sizeof(Real), &err);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+/******************************************************************************
+ * Enqueue. Every command waits for the previous one since the planes are
+ * reused by the next panel.
+ *****************************************************************************/
+  const size_t localSize[2] = { GEMM3M_WG_SIZE, GEMM3M_WG_SIZE };
+  const int tA = transposeArg(transA);
+  const int tB = transposeArg(transB);
+  const int betaZero = isZero(beta) ? 1 : 0;
+  const Real one = 1;
+  const Real zero = 0;
+  cl_event prev = NULL;
+  cl_event next = NULL;
+
+  err = CL_SUCCESS;
+  for (cl_uint n0 = 0; err == CL_SUCCESS && n0 < N; n0 += nb) {
+    cl_uint nw = (N - n0 < nb) ? N - n0 : nb;
+
+    for (cl_uint k0 = 0; err == CL_SUCCESS && k0 < K; k0 += kb) {
+      cl_uint kw = (K - k0 < kb) ? K - k0 : kb;
+      // op(A) stays in place across N panels if K fits in one panel
+      bool splitA = (n0 == 0) || (kb < K);
+
+      for (int operand = 0; err == CL_SUCCESS && operand < 2; operand++) {
+        bool isA = (operand == 0);
+        cl_mem X = isA ? A : B;
+        cl_uint rows = isA ? M : kw;
+        cl_uint cols = isA ? kw : nw;
+        cl_uint rowStart = isA ? 0 : k0;
+        cl_uint colStart = isA ? k0 : n0;
+        cl_uint offX = isA ? offA : offB;
+        cl_uint ldx = isA ? lda : ldb;
+        int trans = isA ? tA : tB;
+        cl_uint plane = isA ? sizeAPlane : sizeBPlane;
+        cl_uint offRe = isA ? offAPlanes : offBPlanes;
+        cl_uint offIm = offRe + plane;
+        cl_uint offSum = offIm + plane;
+
+        if (isA && !splitA) {
+          continue;
+        }
+
+        const size_t argSizes[] = {
+          sizeof(cl_mem), sizeof(cl_mem),
+          sizeof(cl_uint), sizeof(cl_uint),
+          sizeof(cl_uint), sizeof(cl_uint),
+          sizeof(cl_uint), sizeof(cl_uint), sizeof(int),
+          sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint) };
+        const void *args[] = {
+          &X, &W,
+          &rows, &cols,
+          &rowStart, &colStart,
+          &offX, &ldx, &trans,
+          &offRe, &offIm, &offSum };
+        const size_t globalSize[2] = {
+          ((rows + GEMM3M_WG_SIZE - 1) / GEMM3M_WG_SIZE) * GEMM3M_WG_SIZE,
+          ((cols + GEMM3M_WG_SIZE - 1) / GEMM3M_WG_SIZE) * GEMM3M_WG_SIZE };
+
+        for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(args) / sizeof(args[0]); i++) {
+          err = clSetKernelArg(splitKernel, i, argSizes[i], args[i]);
+        }
+        if (err == CL_SUCCESS) {
+          err = clEnqueueNDRangeKernel(queue, splitKernel, 2, NULL,
+            globalSize, localSize,
+            (prev != NULL) ? 1 : numEventsInWaitList,
+            (prev != NULL) ? &prev : eventWaitList, &next);
+        }
+        if (err == CL_SUCCESS) {
+          statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+          if (prev != NULL) {
+            clReleaseEvent(prev);
+          }
+          prev = next;
+        }
+      }
+
+      // T1 = Ar Br, T2 = Ai Bi, T3 = (Ar + Ai)(Br + Bi), accumulated over K
+      for (cl_uint t = 0; err == CL_SUCCESS && t < 3; t++) {
+        err = realGemm(M, nw, kw,
+          one,
+          W, offAPlanes + t * sizeAPlane, M,
+          W, offBPlanes + t * sizeBPlane, kw,
+          (k0 == 0) ? zero : one,
+          W, offTPlanes + t * sizeTPlane, M,
+          &queue, 1, &prev, &next);
+        if (err == CL_SUCCESS) {
+          clReleaseEvent(prev);
+          prev = next;
+        }
+      }
+    }
+
+    if (err == CL_SUCCESS) {
+      cl_uint offT1 = offTPlanes;
+      cl_uint offT2 = offT1 + sizeTPlane;
+      cl_uint offT3 = offT2 + sizeTPlane;
+
+      const size_t argSizes[] = {
+        sizeof(cl_mem), sizeof(cl_mem),
+        sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+        sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+        sizeof(cl_uint), sizeof(cl_uint),
+        sizeof(Precision), sizeof(Precision), sizeof(int) };
+      const void *args[] = {
+        &W, &C,
+        &M, &nw, &n0,
+        &offT1, &offT2, &offT3,
+        &ldc, &offC,
+        &alpha, &beta, &betaZero };
+      const size_t globalSize[2] = {
+        ((M + GEMM3M_WG_SIZE - 1) / GEMM3M_WG_SIZE) * GEMM3M_WG_SIZE,
+        ((nw + GEMM3M_WG_SIZE - 1) / GEMM3M_WG_SIZE) * GEMM3M_WG_SIZE };
+
+      for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(args) / sizeof(args[0]); i++) {
+        err = clSetKernelArg(combineKernel, i, argSizes[i], args[i]);
+      }
+      if (err == CL_SUCCESS) {
+        err = clEnqueueNDRangeKernel(queue, combineKernel, 2, NULL,
+          globalSize, localSize, 1, &prev, &next);
+      }
+      if (err == CL_SUCCESS) {
+        statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+        clReleaseEvent(prev);
+        prev = next;
+      }
+    }
+  }
+
+  // the workspace goes back to the pool once the last command completes
+  releaseWorkspace(W, prev);
+  if (err == CL_SUCCESS && events != NULL) {
+    *events = prev;
+  }
+  else if (prev != NULL) {
+    clReleaseEvent(prev);
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+/******************************************************************************
+ * Explicit instantiations
+ *****************************************************************************/
+#define INSTANTIATE_GEMM_3M(Precision)                            \
+template clblasStatus                                             \
+Gemm3M<Precision>(clblasTranspose, clblasTranspose,               \
+  cl_uint, cl_uint, cl_uint,                                      \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_mem, cl_uint, cl_uint,                                       \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_uint, cl_command_queue *,                                    \
+  cl_uint, const cl_event *, cl_event *,                          \
+  bool, bool &);
+
+INSTANTIATE_GEMM_3M(float)
+INSTANTIATE_GEMM_3M(double)
+INSTANTIATE_GEMM_3M(FloatComplex)
+INSTANTIATE_GEMM_3M(DoubleComplex)
@@ -14,10 +14,12 @@
 * limitations under the License.
 * ************************************************************************/
 
+#include <vector>
 #include "GemmSpecialCases.h"
 #include "UserGemmKernelSources/UserGemmKernelSourceIncludes.h"
 #include "UserGemmKernelSources/UserGemmClKernels.h"
 #include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
 #include "AutoGemmIncludes/AutoGemmClKernels.h"
 #include "AutoGemmIncludes/AutoGemmKernelSources.h"
 #include "AutoGemmIncludes/AutoGemmKernelBinaries.h"
@@ -124,76 +126,61 @@ clblasStatus GEMM_SPLIT_CALLS(
 		error = clSetKernelArg(*ClKernel, 7, sizeof(cl_uint), &small_K);
 		assert(error == CL_SUCCESS);
 
+		// the blocks of C are independent and may run concurrently on an
+		// out-of-order queue; the products accumulated into a block wait
+		// for each other
+		std::vector<cl_event> blockEvents;
+
 		for (int M_split_index = 0; M_split_index < M_split_factor; M_split_index++)
 		{
 			for (int N_split_index = 0; N_split_index < N_split_factor; N_split_index++)
 			{
+				cl_event prev = NULL;
 				unsigned int offc_C = ldc*N / N_split_factor * N_split_index + M / M_split_factor * M_split_index + offC;
 				error = clSetKernelArg(*ClKernel, 13, sizeof(cl_uint), &offc_C);
 				assert(error == CL_SUCCESS);
 
 				for (int K_split_index = 0; K_split_index < K_split_factor; K_split_index++)
 				{
+					cl_event next = NULL;
 					unsigned int offa_A = (M / M_split_factor * M_split_index) + (lda * K / K_split_factor * K_split_index) + offA;
 					unsigned int offb_B = (N / N_split_factor * N_split_index) + (ldb * K / K_split_factor * K_split_index) + offB;
 					error = clSetKernelArg(*ClKernel, 11, sizeof(cl_uint), &offa_A);
 					assert(error == CL_SUCCESS);
 					error = clSetKernelArg(*ClKernel, 12, sizeof(cl_uint), &offb_B);
 					assert(error == CL_SUCCESS);
+					error = clSetKernelArg(*ClKernel, 4, sizeof(precision), (K_split_index == 0) ? &beta : &betaone);
+					assert(error == CL_SUCCESS);
 
-					if (K_split_index == 0)
+					error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
+						gs, wgsize, (prev != NULL) ? 1 : numEventsInWaitList,
+						(prev != NULL) ? &prev : eventWaitList, &next);
+					assert(error == CL_SUCCESS);
+					if (prev != NULL)
 					{
-						error = clSetKernelArg(*ClKernel, 4, sizeof(precision), &(beta));
-						assert(error == CL_SUCCESS);
-
-						if (M_split_index == 0 && N_split_index == 0)
-						{
-							//very first GEMM call
-							if ((M_split_factor == 1) && (N_split_factor == 1) && (K_split_factor == 1))
-							{
-								//also very last GEMM call
-								error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
-									gs, wgsize, numEventsInWaitList, eventWaitList, &events[0]);
-								assert(error == CL_SUCCESS);
-							}
-							else
-							{
-								error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
-									gs, wgsize, numEventsInWaitList, eventWaitList, NULL);
-								assert(error == CL_SUCCESS);
-							}
-						}
-						else
-						{
-							error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
-								gs, wgsize, 0, NULL, NULL);
-							assert(error == CL_SUCCESS);
-						}
+						clReleaseEvent(prev);
 					}
-					else
+					prev = next;
+					if (error != CL_SUCCESS)
 					{
-						error = clSetKernelArg(*ClKernel, 4, sizeof(precision), &betaone);
-						assert(error == CL_SUCCESS);
-
-						if ((M_split_index == (M_split_factor - 1)) && (N_split_index == (N_split_factor - 1)) && (K_split_index == (K_split_factor - 1)))
-						{
-							//very last GEMM call
-							error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
-								gs, wgsize, 0, NULL, events);
-							assert(error == CL_SUCCESS);
-						}
-						else
-						{
-							error = clEnqueueNDRangeKernel(commandQueues[0], *ClKernel, 2, NULL,
-								gs, wgsize, 0, NULL, NULL);
-							assert(error == CL_SUCCESS);
-						}
+						break;
 					}
 				}
+				if (prev != NULL)
+				{
+					blockEvents.push_back(prev);
+				}
+				if (error != CL_SUCCESS)
+				{
+					joinGemmEvents(commandQueues[0], (cl_uint)blockEvents.size(), blockEvents.data(), NULL);
+					return (clblasStatus)error;
+				}
 			}
 		}
 
-		return clblasSuccess;
+		statisticsAdd(STAT_KERNEL_LAUNCHES, M_split_factor * N_split_factor * K_split_factor);
+		error = joinGemmEvents(commandQueues[0], (cl_uint)blockEvents.size(), blockEvents.data(), events);
+		return (clblasStatus)error;
 	}
 	return clblasNotImplemented;
 }
@@ -451,7 +438,6 @@ clblasStatus SGEMM_SPLIT64_32(
 			//GlobalY = ((Nvalue - 1) / 64) * 16
 			size_t GlobalX = ((M - 1) / 64) * 16;
 			size_t GlobalY = ((N - 1) / 64) * 16;
-			size_t gs[2] = { GlobalX, GlobalY };
 			size_t wgsize[2] = { 16, 16 };
 
 			tileKernelSource = sgemm_Col_NT_B1_MX064_NX064_KX16_src;
@@ -514,20 +500,29 @@ clblasStatus SGEMM_SPLIT64_32(
 				CL_CHECK(err);
 			}
 
-			err = clEnqueueNDRangeKernel(commandQueues[0], *Kernels[0], 2, NULL, gs, wgsize, numEventsInWaitList, eventWaitList, NULL);
-
-			gs[0] = 16;
-			err |= clEnqueueNDRangeKernel(commandQueues[0], *Kernels[1], 2, NULL, gs, wgsize, 0, NULL, NULL);
+			// the kernels write disjoint parts of C, so they all wait for the
+			// caller's wait list only and are joined into the event
+			size_t kernelGs[4][2] = { { GlobalX, GlobalY }, { 16, GlobalY }, { GlobalX, 16 }, { 16, 16 } };
+			cl_event kernelEvents[4];
+			cl_uint numKernelEvents = 0;
 
-			gs[1] = 16;
-			gs[0] = GlobalX;
-			err |= clEnqueueNDRangeKernel(commandQueues[0], *Kernels[2], 2, NULL, gs, wgsize, 0, NULL, NULL);
-
-			gs[0] = 16; gs[1] = 16;
-			err |= clEnqueueNDRangeKernel(commandQueues[0], *Kernels[3], 2, NULL, gs, wgsize, 0, NULL, events);
+			err = CL_SUCCESS;
+			for (int i = 0; i < 4 && err == CL_SUCCESS; i++)
+			{
+				err = clEnqueueNDRangeKernel(commandQueues[0], *Kernels[i], 2, NULL, kernelGs[i], wgsize,
+					numEventsInWaitList, eventWaitList, (events != NULL) ? &kernelEvents[numKernelEvents] : NULL);
+				if (err == CL_SUCCESS && events != NULL)
+				{
+					numKernelEvents++;
+				}
+			}
 
 			if (err == 0)
-				return clblasSuccess;
+			{
+				statisticsAdd(STAT_KERNEL_LAUNCHES, 4);
+				return (clblasStatus)joinGemmEvents(commandQueues[0], numKernelEvents, kernelEvents, events);
+			}
+			joinGemmEvents(commandQueues[0], numKernelEvents, kernelEvents, NULL);
 
 		}
 	}
@@ -612,7 +607,10 @@ clblasStatus SGEMM_BRANCH_32(
 				gs, wgsize, numEventsInWaitList, eventWaitList, &events[0]);
 
 			if (err == 0)
+			{
+				statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 				return clblasSuccess;
+			}
 		}
 		if (transA == clblasNoTrans && transB == clblasTrans)
 		{
@@ -657,7 +655,10 @@ clblasStatus SGEMM_BRANCH_32(
 				gs, wgsize, numEventsInWaitList, eventWaitList, &events[0]);
 
 			if (err == 0)
+			{
+				statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 				return clblasSuccess;
+			}
 		}
 		if (transA == clblasTrans && transB == clblasNoTrans)
 		{
@@ -702,7 +703,10 @@ clblasStatus SGEMM_BRANCH_32(
 				gs, wgsize, numEventsInWaitList, eventWaitList, &events[0]);
 
 			if (err == 0)
+			{
+				statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 				return clblasSuccess;
+			}
 		}
 	}
 
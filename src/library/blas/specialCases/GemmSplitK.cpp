@@ -0,0 +1,584 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include "GemmSplitK.h"
+#include "mutex.h"
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
+#include "workspace_pool.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define SPLITK_WG_SIZE 16
+#define SPLITK_TILE 32
+#define SPLITK_UNROLL 16
+
+// work groups per compute unit targeted when choosing the split factor
+#define SPLITK_GROUPS_PER_CU 4
+// shortest K range worth a work group of its own
+#define SPLITK_MIN_CHUNK 256
+// bound of the partial products workspace, in bytes
+#define SPLITK_MAX_WORKSPACE (64 * 1024 * 1024)
+
+/******************************************************************************
+ * Kernel sources. Each work group computes a 32x32 tile of C over one slice
+ * of K and either stores it to its own slice of the workspace or, if
+ * ATOMIC is defined, accumulates it into C. The reduction kernel sums the
+ * slices in a fixed order and applies beta; with no slices it only scales C.
+ *****************************************************************************/
+#define SPLITK_KERNEL_SRC \
+"#define WG 16\n" \
+"#define TILE 32\n" \
+"#define KB 16\n" \
+"#if defined(ATOMIC) && defined(ATOMIC64)\n" \
+"#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable\n" \
+"#endif\n" \
+"#ifdef COMPLEX\n" \
+"#define MAD(c, a, b) c = (TYPE)(mad(a.x, b.x, mad(-a.y, b.y, c.x)), mad(a.x, b.y, mad(a.y, b.x, c.y)))\n" \
+"#define MUL(a, b) ((TYPE)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x))\n" \
+"#define CONJ(a) ((TYPE)(a.x, -a.y))\n" \
+"#else\n" \
+"#define MAD(c, a, b) c = mad(a, b, c)\n" \
+"#define MUL(a, b) ((a) * (b))\n" \
+"#define CONJ(a) (a)\n" \
+"#endif\n" \
+"\n" \
+"#ifdef ATOMIC\n" \
+"void atomicAddReal(volatile __global REAL *p, REAL v)\n" \
+"{\n" \
+"    union { UINT_T u; REAL r; } prev, next;\n" \
+"    do {\n" \
+"        prev.r = *p;\n" \
+"        next.r = prev.r + v;\n" \
+"    } while (ATOMIC_CMPXCHG((volatile __global UINT_T*)p, prev.u, next.u) != prev.u);\n" \
+"}\n" \
+"#ifdef COMPLEX\n" \
+"#define STORE(c, i, j) {                                                \\\n" \
+"    TYPE v = MUL(alpha, c);                                             \\\n" \
+"    atomicAddReal((volatile __global REAL*)&Out[(j) * ldo + (i)], v.x);     \\\n" \
+"    atomicAddReal((volatile __global REAL*)&Out[(j) * ldo + (i)] + 1, v.y); \\\n" \
+"}\n" \
+"#else\n" \
+"#define STORE(c, i, j) atomicAddReal(&Out[(j) * ldo + (i)], MUL(alpha, c))\n" \
+"#endif\n" \
+"#else\n" \
+"#define STORE(c, i, j) Out[(j) * ldo + (i)] = MUL(alpha, c)\n" \
+"#endif\n" \
+"\n" \
+"__attribute__((reqd_work_group_size(WG, WG, 1)))\n" \
+"__kernel void gemmSplitK(\n" \
+"    __global const TYPE *A,\n" \
+"    __global const TYPE *B,\n" \
+"    __global TYPE *Out,\n" \
+"    uint M, uint N, uint K,\n" \
+"    uint lda, uint ldb, uint ldo,\n" \
+"    uint offA, uint offB, uint offO,\n" \
+"    uint sliceSize, uint kChunk,\n" \
+"    int transA, int transB,\n" \
+"    TYPE alpha)\n" \
+"{\n" \
+"    __local TYPE lA[KB][TILE + 1];\n" \
+"    __local TYPE lB[KB][TILE + 1];\n" \
+"    const uint lx = get_local_id(0);\n" \
+"    const uint ly = get_local_id(1);\n" \
+"    const uint lid = ly * WG + lx;\n" \
+"    const uint row0 = get_group_id(0) * TILE;\n" \
+"    const uint col0 = get_group_id(1) * TILE;\n" \
+"    const uint kBegin = get_group_id(2) * kChunk;\n" \
+"    const uint kEnd = min(kBegin + kChunk, K);\n" \
+"    TYPE c00 = (TYPE)(0), c01 = (TYPE)(0), c10 = (TYPE)(0), c11 = (TYPE)(0);\n" \
+"    uint i, j, k, e, k0;\n" \
+"    TYPE v;\n" \
+"\n" \
+"    A += offA;\n" \
+"    B += offB;\n" \
+"    for (k0 = kBegin; k0 < kEnd; k0 += KB) {\n" \
+"        for (e = lid; e < KB * TILE; e += WG * WG) {\n" \
+"            /* the fastest index walks contiguous memory */\n" \
+"            if (transA == 0) { i = e % TILE; k = e / TILE; }\n" \
+"            else { k = e % KB; i = e / KB; }\n" \
+"            v = (TYPE)(0);\n" \
+"            if ((row0 + i < M) && (k0 + k < kEnd)) {\n" \
+"                v = (transA == 0) ? A[(k0 + k) * lda + row0 + i] :\n" \
+"                                    A[(row0 + i) * lda + k0 + k];\n" \
+"                if (transA == 2) v = CONJ(v);\n" \
+"            }\n" \
+"            lA[k][i] = v;\n" \
+"\n" \
+"            if (transB == 0) { k = e % KB; j = e / KB; }\n" \
+"            else { j = e % TILE; k = e / TILE; }\n" \
+"            v = (TYPE)(0);\n" \
+"            if ((col0 + j < N) && (k0 + k < kEnd)) {\n" \
+"                v = (transB == 0) ? B[(col0 + j) * ldb + k0 + k] :\n" \
+"                                    B[(k0 + k) * ldb + col0 + j];\n" \
+"                if (transB == 2) v = CONJ(v);\n" \
+"            }\n" \
+"            lB[k][j] = v;\n" \
+"        }\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"        for (k = 0; k < KB; k++) {\n" \
+"            TYPE a0 = lA[k][lx];\n" \
+"            TYPE a1 = lA[k][lx + WG];\n" \
+"            TYPE b0 = lB[k][ly];\n" \
+"            TYPE b1 = lB[k][ly + WG];\n" \
+"            MAD(c00, a0, b0);\n" \
+"            MAD(c10, a1, b0);\n" \
+"            MAD(c01, a0, b1);\n" \
+"            MAD(c11, a1, b1);\n" \
+"        }\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"    }\n" \
+"\n" \
+"    Out += offO + get_group_id(2) * sliceSize;\n" \
+"    i = row0 + lx;\n" \
+"    j = col0 + ly;\n" \
+"    if ((i < M) && (j < N)) STORE(c00, i, j);\n" \
+"    if ((i + WG < M) && (j < N)) STORE(c10, i + WG, j);\n" \
+"    if ((i < M) && (j + WG < N)) STORE(c01, i, j + WG);\n" \
+"    if ((i + WG < M) && (j + WG < N)) STORE(c11, i + WG, j + WG);\n" \
+"}\n"
+
+#define SPLITK_REDUCE_SRC \
+"#ifdef COMPLEX\n" \
+"#define MUL(a, b) ((TYPE)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x))\n" \
+"#else\n" \
+"#define MUL(a, b) ((a) * (b))\n" \
+"#endif\n" \
+"\n" \
+"__kernel void gemmSplitKReduce(\n" \
+"    __global const TYPE *W,\n" \
+"    __global TYPE *C,\n" \
+"    uint M, uint N, uint nrSlices,\n" \
+"    uint ldc, uint offC,\n" \
+"    TYPE beta, int betaZero)\n" \
+"{\n" \
+"    const uint i = get_global_id(0);\n" \
+"    const uint j = get_global_id(1);\n" \
+"    TYPE sum = (TYPE)(0);\n" \
+"    uint s;\n" \
+"\n" \
+"    if ((i >= M) || (j >= N)) {\n" \
+"        return;\n" \
+"    }\n" \
+"    for (s = 0; s < nrSlices; s++) {\n" \
+"        sum += W[(s * N + j) * M + i];\n" \
+"    }\n" \
+"    C += offC + j * ldc + i;\n" \
+"    if (betaZero) {\n" \
+"        *C = sum;\n" \
+"    }\n" \
+"    else {\n" \
+"        *C = sum + MUL(beta, *C);\n" \
+"    }\n" \
+"}\n"
+
+#define SPLITK_FLOAT_DEFS \
+"#define TYPE float\n" \
+"#define REAL float\n" \
+"#define UINT_T uint\n" \
+"#define ATOMIC_CMPXCHG atomic_cmpxchg\n"
+
+#define SPLITK_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define TYPE double\n" \
+"#define REAL double\n" \
+"#define UINT_T ulong\n" \
+"#define ATOMIC_CMPXCHG atom_cmpxchg\n" \
+"#define ATOMIC64\n"
+
+#define SPLITK_COMPLEX_FLOAT_DEFS \
+"#define TYPE float2\n" \
+"#define REAL float\n" \
+"#define COMPLEX\n" \
+"#define UINT_T uint\n" \
+"#define ATOMIC_CMPXCHG atomic_cmpxchg\n"
+
+#define SPLITK_COMPLEX_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define TYPE double2\n" \
+"#define REAL double\n" \
+"#define COMPLEX\n" \
+"#define UINT_T ulong\n" \
+"#define ATOMIC_CMPXCHG atom_cmpxchg\n" \
+"#define ATOMIC64\n"
+
+/*
+ * Kernels are cached by makeGemmKernel() by the address of their source,
+ * so every variant has a source of its own
+ */
+template<typename Precision>
+struct SplitKSources
+{
+  static const char *partial;
+  static const char *atomic;
+  static const char *reduce;
+  static const bool needs64BitAtomics;
+};
+
+template<> const char *SplitKSources<float>::partial =
+  SPLITK_FLOAT_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<float>::atomic =
+  "#define ATOMIC\n" SPLITK_FLOAT_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<float>::reduce =
+  SPLITK_FLOAT_DEFS SPLITK_REDUCE_SRC;
+template<> const bool SplitKSources<float>::needs64BitAtomics = false;
+
+template<> const char *SplitKSources<double>::partial =
+  SPLITK_DOUBLE_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<double>::atomic =
+  "#define ATOMIC\n" SPLITK_DOUBLE_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<double>::reduce =
+  SPLITK_DOUBLE_DEFS SPLITK_REDUCE_SRC;
+template<> const bool SplitKSources<double>::needs64BitAtomics = true;
+
+template<> const char *SplitKSources<FloatComplex>::partial =
+  SPLITK_COMPLEX_FLOAT_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<FloatComplex>::atomic =
+  "#define ATOMIC\n" SPLITK_COMPLEX_FLOAT_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<FloatComplex>::reduce =
+  SPLITK_COMPLEX_FLOAT_DEFS SPLITK_REDUCE_SRC;
+template<> const bool SplitKSources<FloatComplex>::needs64BitAtomics = false;
+
+template<> const char *SplitKSources<DoubleComplex>::partial =
+  SPLITK_COMPLEX_DOUBLE_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<DoubleComplex>::atomic =
+  "#define ATOMIC\n" SPLITK_COMPLEX_DOUBLE_DEFS SPLITK_KERNEL_SRC;
+template<> const char *SplitKSources<DoubleComplex>::reduce =
+  SPLITK_COMPLEX_DOUBLE_DEFS SPLITK_REDUCE_SRC;
+template<> const bool SplitKSources<DoubleComplex>::needs64BitAtomics = true;
+
+static bool isZero(float v) { return v == 0; }
+static bool isZero(double v) { return v == 0; }
+static bool isZero(FloatComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool isZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+static int transposeArg(clblasTranspose trans)
+{
+  return (trans == clblasNoTrans) ? 0 : (trans == clblasTrans) ? 1 : 2;
+}
+
+static int readEnvInt(const char *name, int defaultValue)
+{
+  const char *env = getenv(name);
+
+  return (env != NULL) ? atoi(env) : defaultValue;
+}
+
+static bool hasExtension(cl_device_id device, const char *name)
+{
+  size_t size = 0;
+  bool ret = false;
+
+  if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, 0, NULL, &size) != CL_SUCCESS) {
+    return false;
+  }
+  char *extensions = new char[size + 1];
+  if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, size, extensions, NULL) == CL_SUCCESS) {
+    extensions[size] = '\0';
+    ret = (strstr(extensions, name) != NULL);
+  }
+  delete[] extensions;
+
+  return ret;
+}
+
+/*
+ * cl_khr_int64_base_atomics support of the devices seen so far, so that
+ * the extension string is not queried on every call
+ */
+static std::map<cl_device_id, bool> int64Atomics;
+static mutex_t *int64AtomicsLock = mutexInit();
+
+static bool hasInt64Atomics(cl_device_id device)
+{
+  std::map<cl_device_id, bool>::iterator it;
+  bool ret;
+
+  mutexLock(int64AtomicsLock);
+  it = int64Atomics.find(device);
+  if (it != int64Atomics.end()) {
+    ret = it->second;
+  }
+  else {
+    ret = hasExtension(device, "cl_khr_int64_base_atomics");
+    int64Atomics[device] = ret;
+  }
+  mutexUnlock(int64AtomicsLock);
+
+  return ret;
+}
+
+/******************************************************************************
+ * Number of K slices; less than 2 means the problem should not be split
+ *****************************************************************************/
+static cl_uint
+splitKFactor(
+  cl_device_id device,
+  cl_uint M, cl_uint N, cl_uint K,
+  size_t elemSize,
+  bool atomics,
+  bool pinned)
+{
+  // read on every call, as the other switches
+  int forced = readEnvInt("AMD_CLBLAS_GEMM_SPLITK", -1);
+  cl_uint numTiles = ((M + SPLITK_TILE - 1) / SPLITK_TILE) *
+                     ((N + SPLITK_TILE - 1) / SPLITK_TILE);
+  cl_uint numCUs;
+  cl_uint nrSlices;
+
+  if (forced == 0 && !pinned) {
+    return 1;
+  }
+  else if (forced > 0) {
+    nrSlices = static_cast<cl_uint>(forced);
+  }
+  else {
+    if (clGetDeviceInfo(device, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(numCUs),
+                        &numCUs, NULL) != CL_SUCCESS) {
+      return 1;
+    }
+    // C alone fills the device
+    if (numTiles >= numCUs && !pinned) {
+      return 1;
+    }
+    nrSlices = (SPLITK_GROUPS_PER_CU * numCUs + numTiles - 1) / numTiles;
+    if (nrSlices < 2) {
+      nrSlices = 2;
+    }
+  }
+
+  if (nrSlices > K / SPLITK_MIN_CHUNK) {
+    nrSlices = K / SPLITK_MIN_CHUNK;
+  }
+  if (!atomics) {
+    size_t sliceBytes = (size_t)M * N * elemSize;
+    if (nrSlices > SPLITK_MAX_WORKSPACE / sliceBytes) {
+      nrSlices = static_cast<cl_uint>(SPLITK_MAX_WORKSPACE / sliceBytes);
+    }
+  }
+
+  return nrSlices;
+}
+
+/******************************************************************************
+ * Split-K GEMM
+ *****************************************************************************/
+template<typename Precision>
+clblasStatus
+GemmSplitK(clblasTranspose transA,
+           clblasTranspose transB,
+           cl_uint M, cl_uint N, cl_uint K,
+           Precision alpha,
+           cl_mem A, cl_uint offA, cl_uint lda,
+           cl_mem B, cl_uint offB, cl_uint ldb,
+           Precision beta,
+           cl_mem C, cl_uint offC, cl_uint ldc,
+           cl_uint numCommandQueues,
+           cl_command_queue *commandQueues,
+           cl_uint numEventsInWaitList,
+           const cl_event *eventWaitList,
+           cl_event *events,
+           bool forced,
+           bool &splitKHandled)
+{
+  // read on every call so that the mode can be switched per problem
+  bool wantAtomics = readEnvInt("AMD_CLBLAS_GEMM_SPLITK_ATOMICS", 0) != 0;
+  cl_command_queue queue = commandQueues[0];
+  cl_context context;
+  cl_device_id device;
+  cl_int err;
+
+  splitKHandled = false;
+  if (M == 0 || N == 0 || K == 0) {
+    return clblasNotImplemented;
+  }
+
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(context), &context, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  bool atomics = wantAtomics &&
+    (!SplitKSources<Precision>::needs64BitAtomics ||
+     hasInt64Atomics(device));
+
+  cl_uint nrSlices = splitKFactor(device, M, N, K, sizeof(Precision), atomics, forced);
+  if (nrSlices < 2) {
+    return clblasNotImplemented;
+  }
+  // whole unrolled iterations per slice
+  cl_uint kChunk = (K + nrSlices - 1) / nrSlices;
+  kChunk = ((kChunk + SPLITK_UNROLL - 1) / SPLITK_UNROLL) * SPLITK_UNROLL;
+  nrSlices = (K + kChunk - 1) / kChunk;
+
+  splitKHandled = true;
+
+/******************************************************************************
+ * Build kernels
+ *****************************************************************************/
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+  cl_kernel partialKernel = NULL;
+  cl_kernel reduceKernel = NULL;
+
+  makeGemmKernel(&partialKernel, queue,
+    atomics ? SplitKSources<Precision>::atomic : SplitKSources<Precision>::partial,
+    "", &noBinary, &noBinarySize, "");
+  makeGemmKernel(&reduceKernel, queue, SplitKSources<Precision>::reduce,
+    "", &noBinary, &noBinarySize, "");
+
+/******************************************************************************
+ * Workspace for the partial products, one M x N slice per K slice
+ *****************************************************************************/
+  cl_mem W = NULL;
+  cl_uint sliceSize = 0;
+  if (!atomics) {
+    sliceSize = M * N;
+    W = acquireWorkspace(context,
+      (size_t)sliceSize * nrSlices * sizeof(Precision), &err);
+    if (err != CL_SUCCESS) {
+      return static_cast<clblasStatus>(err);
+    }
+  }
+
+  const size_t localSize[3] = { SPLITK_WG_SIZE, SPLITK_WG_SIZE, 1 };
+  const size_t partialGlobalSize[3] = {
+    ((M + SPLITK_TILE - 1) / SPLITK_TILE) * SPLITK_WG_SIZE,
+    ((N + SPLITK_TILE - 1) / SPLITK_TILE) * SPLITK_WG_SIZE,
+    nrSlices };
+  const size_t reduceGlobalSize[2] = {
+    ((M + SPLITK_WG_SIZE - 1) / SPLITK_WG_SIZE) * SPLITK_WG_SIZE,
+    ((N + SPLITK_WG_SIZE - 1) / SPLITK_WG_SIZE) * SPLITK_WG_SIZE };
+
+  cl_mem out = atomics ? C : W;
+  cl_uint ldo = atomics ? ldc : M;
+  cl_uint offO = atomics ? offC : 0;
+  int tA = transposeArg(transA);
+  int tB = transposeArg(transB);
+  cl_uint reduceSlices = atomics ? 0 : nrSlices;
+  int betaZero = isZero(beta) ? 1 : 0;
+
+  const size_t partialArgSizes[] = {
+    sizeof(cl_mem), sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(int), sizeof(int),
+    sizeof(Precision) };
+  const void *partialArgs[] = {
+    &A, &B, &out,
+    &M, &N, &K,
+    &lda, &ldb, &ldo,
+    &offA, &offB, &offO,
+    &sliceSize, &kChunk,
+    &tA, &tB,
+    &alpha };
+  const size_t reduceArgSizes[] = {
+    sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(Precision), sizeof(int) };
+  const void *reduceArgs[] = {
+    &W, &C,
+    &M, &N, &reduceSlices,
+    &ldc, &offC,
+    &beta, &betaZero };
+
+  err = CL_SUCCESS;
+  for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(partialArgs) / sizeof(partialArgs[0]); i++) {
+    err = clSetKernelArg(partialKernel, i, partialArgSizes[i], partialArgs[i]);
+  }
+  for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(reduceArgs) / sizeof(reduceArgs[0]); i++) {
+    err = clSetKernelArg(reduceKernel, i, reduceArgSizes[i], reduceArgs[i]);
+  }
+  if (err != CL_SUCCESS) {
+    if (W != NULL) {
+      releaseWorkspace(W, NULL);
+    }
+    return static_cast<clblasStatus>(err);
+  }
+
+/******************************************************************************
+ * Enqueue. The deterministic mode reduces the slices after the partial
+ * products are done; the atomic one scales C by beta before accumulating.
+ *****************************************************************************/
+  cl_kernel first = atomics ? reduceKernel : partialKernel;
+  cl_kernel second = atomics ? partialKernel : reduceKernel;
+  cl_uint firstDim = atomics ? 2 : 3;
+  cl_uint secondDim = atomics ? 3 : 2;
+  const size_t *firstGlobalSize = atomics ? reduceGlobalSize : partialGlobalSize;
+  const size_t *secondGlobalSize = atomics ? partialGlobalSize : reduceGlobalSize;
+  cl_event firstEvent = NULL;
+  cl_event secondEvent = NULL;
+
+  err = clEnqueueNDRangeKernel(queue, first, firstDim, NULL,
+    firstGlobalSize, localSize, numEventsInWaitList, eventWaitList, &firstEvent);
+  if (err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+    err = clEnqueueNDRangeKernel(queue, second, secondDim, NULL,
+      secondGlobalSize, localSize, 1, &firstEvent, &secondEvent);
+    if (err == CL_SUCCESS) {
+      statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+      clReleaseEvent(firstEvent);
+    }
+    else {
+      secondEvent = firstEvent;
+    }
+  }
+
+  // the workspace goes back to the pool once the last kernel completes
+  if (W != NULL) {
+    releaseWorkspace(W, secondEvent);
+  }
+  if (err == CL_SUCCESS && events != NULL) {
+    *events = secondEvent;
+  }
+  else if (secondEvent != NULL) {
+    clReleaseEvent(secondEvent);
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+/******************************************************************************
+ * Explicit instantiations
+ *****************************************************************************/
+#define INSTANTIATE_GEMM_SPLIT_K(Precision)                       \
+template clblasStatus                                             \
+GemmSplitK<Precision>(clblasTranspose, clblasTranspose,           \
+  cl_uint, cl_uint, cl_uint,                                      \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_mem, cl_uint, cl_uint,                                       \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_uint, cl_command_queue *,                                    \
+  cl_uint, const cl_event *, cl_event *,                          \
+  bool, bool &);
+
+INSTANTIATE_GEMM_SPLIT_K(float)
+INSTANTIATE_GEMM_SPLIT_K(double)
+INSTANTIATE_GEMM_SPLIT_K(FloatComplex)
+INSTANTIATE_GEMM_SPLIT_K(DoubleComplex)
@@ -0,0 +1,473 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+#include <limits.h>
+#include <stdlib.h>
+#include "GemmStrassen.h"
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
+#include "workspace_pool.h"
+#include "path_table.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define STRASSEN_WG_SIZE 16
+
+/******************************************************************************
+ * Kernel source. Z = a X + b Y for blocks of op(X), op(Y) and a column
+ * major Z, which may be X or Y itself; Y is not read if b is zero.
+ *****************************************************************************/
+#define STRASSEN_ADD_SRC \
+"__kernel void strassenAdd(\n" \
+"    __global const REAL *X, uint offX, uint ldx, int transX,\n" \
+"    __global const REAL *Y, uint offY, uint ldy, int transY,\n" \
+"    __global REAL *Z, uint offZ, uint ldz,\n" \
+"    uint rows, uint cols, REAL a, REAL b)\n" \
+"{\n" \
+"    const uint i = get_global_id(0);\n" \
+"    const uint j = get_global_id(1);\n" \
+"    REAL v;\n" \
+"\n" \
+"    if ((i >= rows) || (j >= cols)) {\n" \
+"        return;\n" \
+"    }\n" \
+"    v = a * (transX ? X[offX + i * ldx + j] : X[offX + j * ldx + i]);\n" \
+"    if (b != 0) {\n" \
+"        v += b * (transY ? Y[offY + i * ldy + j] : Y[offY + j * ldy + i]);\n" \
+"    }\n" \
+"    Z[offZ + j * ldz + i] = v;\n" \
+"}\n"
+
+#define STRASSEN_FLOAT_DEFS \
+"#define REAL float\n"
+
+#define STRASSEN_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define REAL double\n"
+
+/*
+ * Kernels are cached by makeGemmKernel() by the address of their source,
+ * so every precision has a source of its own.
+ */
+template<typename Precision>
+struct StrassenTraits
+{
+  static const char *add;
+};
+
+template<> const char *StrassenTraits<float>::add =
+  STRASSEN_FLOAT_DEFS STRASSEN_ADD_SRC;
+template<> const char *StrassenTraits<double>::add =
+  STRASSEN_DOUBLE_DEFS STRASSEN_ADD_SRC;
+
+/******************************************************************************
+ * A block of op(X) for a column major X
+ *****************************************************************************/
+struct StrassenMatrix
+{
+  cl_mem mem;
+  cl_uint off;
+  cl_uint ld;
+  clblasTranspose trans;
+
+  StrassenMatrix(cl_mem mem_, cl_uint off_, cl_uint ld_,
+                 clblasTranspose trans_) :
+    mem(mem_), off(off_), ld(ld_), trans(trans_)
+  {
+  }
+
+  // the block starting at row 'r' and column 'c' of op(X)
+  StrassenMatrix block(cl_uint r, cl_uint c) const
+  {
+    cl_uint pos = (trans == clblasNoTrans) ? c * ld + r : r * ld + c;
+    return StrassenMatrix(mem, off + pos, ld, trans);
+  }
+};
+
+/******************************************************************************
+ * Commands are chained with events; each waits for the previous one, the
+ * first for the caller's wait list. The chain stops at the first error.
+ *****************************************************************************/
+struct StrassenChain
+{
+  cl_command_queue queue;
+  cl_uint numEventsInWaitList;
+  const cl_event *eventWaitList;
+  cl_event prev;
+  cl_int err;
+
+  cl_uint numWaits() const
+  {
+    return (prev != NULL) ? 1 : numEventsInWaitList;
+  }
+
+  const cl_event *waits() const
+  {
+    return (prev != NULL) ? &prev : eventWaitList;
+  }
+
+  void advance(cl_event next)
+  {
+    if (prev != NULL) {
+      clReleaseEvent(prev);
+    }
+    prev = next;
+  }
+};
+
+/******************************************************************************
+ * C = alpha op(A) op(B) + beta C on blocks with the regular GEMM, which
+ * applies another level of Strassen if the blocks are still large enough
+ *****************************************************************************/
+static clblasStatus
+blockGemm(cl_uint M, cl_uint N, cl_uint K,
+          cl_float alpha,
+          const StrassenMatrix &A,
+          const StrassenMatrix &B,
+          cl_float beta,
+          const StrassenMatrix &C,
+          cl_command_queue *queue,
+          cl_uint numEventsInWaitList,
+          const cl_event *eventWaitList,
+          cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasSgemm(clblasColumnMajor, A.trans, B.trans,
+    M, N, K, alpha, A.mem, A.off, A.ld, B.mem, B.off, B.ld,
+    beta, C.mem, C.off, C.ld,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+static clblasStatus
+blockGemm(cl_uint M, cl_uint N, cl_uint K,
+          cl_double alpha,
+          const StrassenMatrix &A,
+          const StrassenMatrix &B,
+          cl_double beta,
+          const StrassenMatrix &C,
+          cl_command_queue *queue,
+          cl_uint numEventsInWaitList,
+          const cl_event *eventWaitList,
+          cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasDgemm(clblasColumnMajor, A.trans, B.trans,
+    M, N, K, alpha, A.mem, A.off, A.ld, B.mem, B.off, B.ld,
+    beta, C.mem, C.off, C.ld,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+template<typename Precision>
+static void
+strassenGemm(StrassenChain &chain,
+             cl_uint M, cl_uint N, cl_uint K,
+             Precision alpha,
+             const StrassenMatrix &A,
+             const StrassenMatrix &B,
+             Precision beta,
+             const StrassenMatrix &C)
+{
+  cl_event next = NULL;
+
+  if (chain.err != CL_SUCCESS) {
+    return;
+  }
+  chain.err = blockGemm(M, N, K, alpha, A, B, beta, C,
+    &chain.queue, chain.numWaits(), chain.waits(), &next);
+  if (chain.err == CL_SUCCESS) {
+    chain.advance(next);
+  }
+}
+
+/******************************************************************************
+ * Z = a op(X) + b op(Y) on blocks of 'rows' x 'cols'
+ *****************************************************************************/
+template<typename Precision>
+static void
+strassenAdd(StrassenChain &chain,
+            cl_kernel kernel,
+            cl_uint rows, cl_uint cols,
+            Precision a, const StrassenMatrix &X,
+            Precision b, const StrassenMatrix &Y,
+            const StrassenMatrix &Z)
+{
+  const int transX = (X.trans == clblasNoTrans) ? 0 : 1;
+  const int transY = (Y.trans == clblasNoTrans) ? 0 : 1;
+  const size_t localSize[2] = { STRASSEN_WG_SIZE, STRASSEN_WG_SIZE };
+  const size_t globalSize[2] = {
+    ((rows + STRASSEN_WG_SIZE - 1) / STRASSEN_WG_SIZE) * STRASSEN_WG_SIZE,
+    ((cols + STRASSEN_WG_SIZE - 1) / STRASSEN_WG_SIZE) * STRASSEN_WG_SIZE };
+  const size_t argSizes[] = {
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint), sizeof(int),
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint), sizeof(int),
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(Precision), sizeof(Precision) };
+  const void *args[] = {
+    &X.mem, &X.off, &X.ld, &transX,
+    &Y.mem, &Y.off, &Y.ld, &transY,
+    &Z.mem, &Z.off, &Z.ld,
+    &rows, &cols, &a, &b };
+  cl_event next = NULL;
+
+  for (cl_uint i = 0; chain.err == CL_SUCCESS && i < sizeof(args) / sizeof(args[0]); i++) {
+    chain.err = clSetKernelArg(kernel, i, argSizes[i], args[i]);
+  }
+  if (chain.err == CL_SUCCESS) {
+    chain.err = clEnqueueNDRangeKernel(chain.queue, kernel, 2, NULL,
+      globalSize, localSize, chain.numWaits(), chain.waits(), &next);
+  }
+  if (chain.err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+    chain.advance(next);
+  }
+}
+
+/******************************************************************************
+ * Smallest of M, N and K using Strassen, 0 if disabled. Read on every call
+ * so that it can be switched per problem.
+ *****************************************************************************/
+static cl_uint
+gemmStrassenThreshold(void)
+{
+  const char *env = getenv("AMD_CLBLAS_GEMM_STRASSEN");
+  int threshold = (env != NULL) ? atoi(env) : 0;
+
+  if (threshold <= 0) {
+    return 0;
+  }
+  // blocks must not be empty
+  return (threshold < 2) ? 2 : static_cast<cl_uint>(threshold);
+}
+
+/******************************************************************************
+ * Strassen-Winograd GEMM
+ *****************************************************************************/
+template<typename Precision>
+clblasStatus
+GemmStrassen(clblasTranspose transA,
+             clblasTranspose transB,
+             cl_uint M, cl_uint N, cl_uint K,
+             Precision alpha,
+             cl_mem A, cl_uint offA, cl_uint lda,
+             cl_mem B, cl_uint offB, cl_uint ldb,
+             Precision beta,
+             cl_mem C, cl_uint offC, cl_uint ldc,
+             cl_uint numCommandQueues,
+             cl_command_queue *commandQueues,
+             cl_uint numEventsInWaitList,
+             const cl_event *eventWaitList,
+             cl_event *events,
+             bool forced,
+             bool &strassenHandled)
+{
+  cl_command_queue queue = commandQueues[0];
+  cl_uint threshold = forced ? 2 : gemmStrassenThreshold();
+  cl_context context;
+  cl_device_id device;
+  cl_ulong maxAlloc;
+  cl_int err;
+
+  (void)numCommandQueues;
+
+  strassenHandled = false;
+  if ((threshold == 0) || (M < threshold) || (N < threshold) ||
+      (K < threshold)) {
+    return clblasNotImplemented;
+  }
+
+/******************************************************************************
+ * Workspace: the operands X and Y of the block GEMMs, the product Z of the
+ * top left blocks and, unless beta is zero, the product R of the even part
+ * of the problem before it is added to beta C
+ *****************************************************************************/
+  const cl_uint m = M / 2;
+  const cl_uint n = N / 2;
+  const cl_uint k = K / 2;
+  const bool betaZero = (beta == 0);
+  const size_t sizeX = (size_t)m * k;
+  const size_t sizeY = (size_t)k * n;
+  const size_t sizeZ = (size_t)m * n;
+  const size_t sizeR = betaZero ? 0 : 4 * (size_t)m * n;
+  const size_t sizeW = sizeX + sizeY + sizeZ + sizeR;
+
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(context), &context, NULL);
+  if (err == CL_SUCCESS) {
+    err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+  }
+  if (err == CL_SUCCESS) {
+    err = clGetDeviceInfo(device, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(maxAlloc), &maxAlloc, NULL);
+  }
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+  if ((sizeW > UINT_MAX) || (sizeW * sizeof(Precision) > maxAlloc)) {
+    return clblasNotImplemented;
+  }
+
+  strassenHandled = true;
+
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+  cl_kernel addKernel = NULL;
+
+  makeGemmKernel(&addKernel, queue, StrassenTraits<Precision>::add,
+    "", &noBinary, &noBinarySize, "");
+
+  cl_mem W = acquireWorkspace(context, sizeW * sizeof(Precision), &err);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+/******************************************************************************
+ * Blocks
+ *****************************************************************************/
+  const Precision one = 1;
+  const Precision zero = 0;
+  const StrassenMatrix opA(A, offA, lda, transA);
+  const StrassenMatrix opB(B, offB, ldb, transB);
+  const StrassenMatrix opC(C, offC, ldc, clblasNoTrans);
+  const StrassenMatrix X(W, 0, m, clblasNoTrans);
+  const StrassenMatrix Y(W, static_cast<cl_uint>(sizeX), k, clblasNoTrans);
+  const StrassenMatrix Z(W, static_cast<cl_uint>(sizeX + sizeY), m, clblasNoTrans);
+  const StrassenMatrix R = betaZero ? opC :
+    StrassenMatrix(W, static_cast<cl_uint>(sizeX + sizeY + sizeZ), 2 * m, clblasNoTrans);
+
+  const StrassenMatrix A11 = opA.block(0, 0), A12 = opA.block(0, k);
+  const StrassenMatrix A21 = opA.block(m, 0), A22 = opA.block(m, k);
+  const StrassenMatrix B11 = opB.block(0, 0), B12 = opB.block(0, n);
+  const StrassenMatrix B21 = opB.block(k, 0), B22 = opB.block(k, n);
+  const StrassenMatrix R11 = R.block(0, 0), R12 = R.block(0, n);
+  const StrassenMatrix R21 = R.block(m, 0), R22 = R.block(m, n);
+
+  StrassenChain chain;
+  chain.queue = queue;
+  chain.numEventsInWaitList = numEventsInWaitList;
+  chain.eventWaitList = eventWaitList;
+  chain.prev = NULL;
+  chain.err = CL_SUCCESS;
+
+/******************************************************************************
+ * Winograd's schedule with three temporaries, R = alpha op(A) op(B) for the
+ * even part:
+ *
+ *   S1 = A21 + A22   S2 = S1 - A11   S3 = A11 - A21   S4 = A12 - S2
+ *   T1 = B12 - B11   T2 = B22 - T1   T3 = B22 - B12   T4 = T2 - B21
+ *   P1 = A11 B11     P2 = A12 B21    P3 = S4 B22      P4 = A22 T4
+ *   P5 = S1 T1       P6 = S2 T2      P7 = S3 T3
+ *   U2 = P1 + P6     U3 = U2 + P7    U4 = U2 + P5
+ *   R11 = P1 + P2    R12 = U4 + P3   R21 = U3 - P4    R22 = U3 + P5
+ *
+ * Every P carries alpha.
+ *****************************************************************************/
+  strassenAdd(chain, addKernel, m, k, one, A11, -one, A21, X);  // S3
+  strassenAdd(chain, addKernel, k, n, one, B22, -one, B12, Y);  // T3
+  strassenGemm(chain, m, n, k, alpha, X, Y, zero, R21);         // P7
+  strassenAdd(chain, addKernel, m, k, one, A21, one, A22, X);   // S1
+  strassenAdd(chain, addKernel, k, n, one, B12, -one, B11, Y);  // T1
+  strassenGemm(chain, m, n, k, alpha, X, Y, zero, R22);         // P5
+  strassenAdd(chain, addKernel, m, k, one, X, -one, A11, X);    // S2
+  strassenAdd(chain, addKernel, k, n, one, B22, -one, Y, Y);    // T2
+  strassenGemm(chain, m, n, k, alpha, X, Y, zero, R12);         // P6
+  strassenAdd(chain, addKernel, m, k, one, A12, -one, X, X);    // S4
+  strassenGemm(chain, m, n, k, alpha, X, B22, zero, R11);       // P3
+  strassenGemm(chain, m, n, k, alpha, A11, B11, zero, Z);       // P1
+  strassenAdd(chain, addKernel, m, n, one, Z, one, R12, R12);   // U2
+  strassenAdd(chain, addKernel, m, n, one, R12, one, R21, R21); // U3
+  strassenAdd(chain, addKernel, m, n, one, R12, one, R22, R12); // U4
+  strassenAdd(chain, addKernel, m, n, one, R21, one, R22, R22); // R22
+  strassenAdd(chain, addKernel, m, n, one, R12, one, R11, R12); // R12
+  strassenAdd(chain, addKernel, k, n, one, Y, -one, B21, Y);    // T4
+  strassenGemm(chain, m, n, k, alpha, A22, Y, zero, R11);       // P4
+  strassenAdd(chain, addKernel, m, n, one, R21, -one, R11, R21);// R21
+  strassenGemm(chain, m, n, k, alpha, A12, B21, zero, R11);     // P2
+  strassenAdd(chain, addKernel, m, n, one, Z, one, R11, R11);   // R11
+
+/******************************************************************************
+ * Odd depth, beta C, then odd rows and columns with the regular GEMM
+ *****************************************************************************/
+  if (K > 2 * k) {
+    strassenGemm(chain, 2 * m, 2 * n, K - 2 * k, alpha,
+      opA.block(0, 2 * k), opB.block(2 * k, 0), one, R);
+  }
+  if (!betaZero) {
+    strassenAdd(chain, addKernel, 2 * m, 2 * n, one, R, beta, opC, opC);
+  }
+  if (M > 2 * m) {
+    strassenGemm(chain, M - 2 * m, N, K, alpha,
+      opA.block(2 * m, 0), opB, beta, opC.block(2 * m, 0));
+  }
+  if (N > 2 * n) {
+    strassenGemm(chain, 2 * m, N - 2 * n, K, alpha,
+      opA, opB.block(0, 2 * n), beta, opC.block(0, 2 * n));
+  }
+
+  // the workspace goes back to the pool once the last command completes
+  releaseWorkspace(W, chain.prev);
+  if (chain.err == CL_SUCCESS && events != NULL) {
+    *events = chain.prev;
+  }
+  else if (chain.prev != NULL) {
+    clReleaseEvent(chain.prev);
+  }
+
+  return static_cast<clblasStatus>(chain.err);
+}
+
+/******************************************************************************
+ * Complex precisions are never handled
+ *****************************************************************************/
+#define GEMM_STRASSEN_COMPLEX(Precision)                          \
+template<>                                                        \
+clblasStatus                                                      \
+GemmStrassen<Precision>(clblasTranspose, clblasTranspose,         \
+  cl_uint, cl_uint, cl_uint,                                      \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_mem, cl_uint, cl_uint,                                       \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_uint, cl_command_queue *,                                    \
+  cl_uint, const cl_event *, cl_event *,                          \
+  bool, bool &strassenHandled)                                    \
+{                                                                 \
+  strassenHandled = false;                                        \
+  return clblasNotImplemented;                                    \
+}
+
+GEMM_STRASSEN_COMPLEX(FloatComplex)
+GEMM_STRASSEN_COMPLEX(DoubleComplex)
+
+/******************************************************************************
+ * Explicit instantiations
+ *****************************************************************************/
+#define INSTANTIATE_GEMM_STRASSEN(Precision)                      \
+template clblasStatus                                             \
+GemmStrassen<Precision>(clblasTranspose, clblasTranspose,         \
+  cl_uint, cl_uint, cl_uint,                                      \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_mem, cl_uint, cl_uint,                                       \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_uint, cl_command_queue *,                                    \
+  cl_uint, const cl_event *, cl_event *,                          \
+  bool, bool &);
+
+INSTANTIATE_GEMM_STRASSEN(float)
+INSTANTIATE_GEMM_STRASSEN(double)
@@ -0,0 +1,504 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+#include <stdlib.h>
+#include "GemmStreamK.h"
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
+#include "workspace_pool.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define STREAMK_WG_SIZE 16
+#define STREAMK_TILE 32
+#define STREAMK_UNROLL 16
+
+// work groups of the kernel held by a compute unit at once
+#define STREAMK_GROUPS_PER_CU 4
+// shortest K worth spreading over work groups
+#define STREAMK_MIN_K 256
+// device use below which the tail wave is worth balancing, in percent
+#define STREAMK_MIN_EFFICIENCY 75
+
+/******************************************************************************
+ * Kernel sources. Work group g runs the multiply-add iterations
+ * [g * total / numGroups, (g + 1) * total / numGroups) of the tiles laid
+ * end to end, each iteration covering KB values of K of a 32x32 tile. The
+ * part of a tile it computes is either the whole tile, stored to C, or the
+ * first or last segment of its range, stored unscaled to workspace slot
+ * 2g or 2g+1. The fix-up kernel sums the slots of every split tile in
+ * group order and applies alpha and beta.
+ *****************************************************************************/
+#define STREAMK_COMMON_SRC \
+"#define WG 16\n" \
+"#define TILE 32\n" \
+"#define KB 16\n" \
+"#ifdef COMPLEX\n" \
+"#define MAD(c, a, b) c = (TYPE)(mad(a.x, b.x, mad(-a.y, b.y, c.x)), mad(a.x, b.y, mad(a.y, b.x, c.y)))\n" \
+"#define MUL(a, b) ((TYPE)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x))\n" \
+"#define CONJ(a) ((TYPE)(a.x, -a.y))\n" \
+"#else\n" \
+"#define MAD(c, a, b) c = mad(a, b, c)\n" \
+"#define MUL(a, b) ((a) * (b))\n" \
+"#define CONJ(a) (a)\n" \
+"#endif\n" \
+"\n" \
+"/* first iteration of a work group */\n" \
+"uint groupStart(uint g, uint total, uint numGroups)\n" \
+"{\n" \
+"    return (uint)(((ulong)g * total) / numGroups);\n" \
+"}\n" \
+"\n" \
+"/* work group running an iteration */\n" \
+"uint groupOf(uint iter, uint total, uint numGroups)\n" \
+"{\n" \
+"    return (uint)((((ulong)iter + 1) * numGroups - 1) / total);\n" \
+"}\n" \
+"\n" \
+"#define STORE(c, i, j) {                                                \\\n" \
+"    if (betaZero) C[(j) * ldc + (i)] = MUL(alpha, c);                   \\\n" \
+"    else C[(j) * ldc + (i)] = MUL(alpha, c) + MUL(beta, C[(j) * ldc + (i)]); \\\n" \
+"}\n"
+
+#define STREAMK_KERNEL_SRC \
+"__attribute__((reqd_work_group_size(WG, WG, 1)))\n" \
+"__kernel void gemmStreamK(\n" \
+"    __global const TYPE *A,\n" \
+"    __global const TYPE *B,\n" \
+"    __global TYPE *C,\n" \
+"    __global TYPE *W,\n" \
+"    uint M, uint N, uint K,\n" \
+"    uint lda, uint ldb, uint ldc,\n" \
+"    uint offA, uint offB, uint offC,\n" \
+"    int transA, int transB,\n" \
+"    uint tilesM, uint itersPerTile, uint totalIters,\n" \
+"    TYPE alpha, TYPE beta, int betaZero)\n" \
+"{\n" \
+"    __local TYPE lA[KB][TILE + 1];\n" \
+"    __local TYPE lB[KB][TILE + 1];\n" \
+"    const uint lx = get_local_id(0);\n" \
+"    const uint ly = get_local_id(1);\n" \
+"    const uint lid = ly * WG + lx;\n" \
+"    const uint g = get_group_id(0);\n" \
+"    const uint numGroups = get_num_groups(0);\n" \
+"    const uint start = groupStart(g, totalIters, numGroups);\n" \
+"    const uint end = groupStart(g + 1, totalIters, numGroups);\n" \
+"    uint iter = start;\n" \
+"    uint i, j, k, e, k0;\n" \
+"    TYPE v;\n" \
+"\n" \
+"    A += offA;\n" \
+"    B += offB;\n" \
+"    C += offC;\n" \
+"    while (iter < end) {\n" \
+"        const uint tile = iter / itersPerTile;\n" \
+"        const uint tileBegin = tile * itersPerTile;\n" \
+"        const uint segStart = iter;\n" \
+"        const uint segEnd = min(end, tileBegin + itersPerTile);\n" \
+"        const uint row0 = (tile % tilesM) * TILE;\n" \
+"        const uint col0 = (tile / tilesM) * TILE;\n" \
+"        TYPE c00 = (TYPE)(0), c01 = (TYPE)(0), c10 = (TYPE)(0), c11 = (TYPE)(0);\n" \
+"\n" \
+"        for (; iter < segEnd; iter++) {\n" \
+"            k0 = (iter - tileBegin) * KB;\n" \
+"            for (e = lid; e < KB * TILE; e += WG * WG) {\n" \
+"                /* the fastest index walks contiguous memory */\n" \
+"                if (transA == 0) { i = e % TILE; k = e / TILE; }\n" \
+"                else { k = e % KB; i = e / KB; }\n" \
+"                v = (TYPE)(0);\n" \
+"                if ((row0 + i < M) && (k0 + k < K)) {\n" \
+"                    v = (transA == 0) ? A[(k0 + k) * lda + row0 + i] :\n" \
+"                                        A[(row0 + i) * lda + k0 + k];\n" \
+"                    if (transA == 2) v = CONJ(v);\n" \
+"                }\n" \
+"                lA[k][i] = v;\n" \
+"\n" \
+"                if (transB == 0) { k = e % KB; j = e / KB; }\n" \
+"                else { j = e % TILE; k = e / TILE; }\n" \
+"                v = (TYPE)(0);\n" \
+"                if ((col0 + j < N) && (k0 + k < K)) {\n" \
+"                    v = (transB == 0) ? B[(col0 + j) * ldb + k0 + k] :\n" \
+"                                        B[(k0 + k) * ldb + col0 + j];\n" \
+"                    if (transB == 2) v = CONJ(v);\n" \
+"                }\n" \
+"                lB[k][j] = v;\n" \
+"            }\n" \
+"            barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"            for (k = 0; k < KB; k++) {\n" \
+"                TYPE a0 = lA[k][lx];\n" \
+"                TYPE a1 = lA[k][lx + WG];\n" \
+"                TYPE b0 = lB[k][ly];\n" \
+"                TYPE b1 = lB[k][ly + WG];\n" \
+"                MAD(c00, a0, b0);\n" \
+"                MAD(c10, a1, b0);\n" \
+"                MAD(c01, a0, b1);\n" \
+"                MAD(c11, a1, b1);\n" \
+"            }\n" \
+"            barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"        }\n" \
+"\n" \
+"        i = row0 + lx;\n" \
+"        j = col0 + ly;\n" \
+"        if ((segStart == tileBegin) && (segEnd == tileBegin + itersPerTile)) {\n" \
+"            /* whole tile */\n" \
+"            if ((i < M) && (j < N)) STORE(c00, i, j);\n" \
+"            if ((i + WG < M) && (j < N)) STORE(c10, i + WG, j);\n" \
+"            if ((i < M) && (j + WG < N)) STORE(c01, i, j + WG);\n" \
+"            if ((i + WG < M) && (j + WG < N)) STORE(c11, i + WG, j + WG);\n" \
+"        }\n" \
+"        else {\n" \
+"            /* first segment of the range to slot 2g, last one to 2g+1 */\n" \
+"            __global TYPE *slot = W + (2 * g + (segStart == start ? 0 : 1)) * TILE * TILE;\n" \
+"            slot[ly * TILE + lx] = c00;\n" \
+"            slot[ly * TILE + lx + WG] = c10;\n" \
+"            slot[(ly + WG) * TILE + lx] = c01;\n" \
+"            slot[(ly + WG) * TILE + lx + WG] = c11;\n" \
+"        }\n" \
+"    }\n" \
+"}\n"
+
+#define STREAMK_FIXUP_SRC \
+"__kernel void gemmStreamKFixup(\n" \
+"    __global const TYPE *W,\n" \
+"    __global TYPE *C,\n" \
+"    uint M, uint N,\n" \
+"    uint ldc, uint offC,\n" \
+"    uint tilesM, uint itersPerTile, uint totalIters, uint numGroups,\n" \
+"    TYPE alpha, TYPE beta, int betaZero)\n" \
+"{\n" \
+"    const uint lx = get_local_id(0);\n" \
+"    const uint ly = get_local_id(1);\n" \
+"    const uint tile = get_group_id(1) * tilesM + get_group_id(0);\n" \
+"    const uint tileBegin = tile * itersPerTile;\n" \
+"    const uint first = groupOf(tileBegin, totalIters, numGroups);\n" \
+"    const uint last = groupOf(tileBegin + itersPerTile - 1, totalIters, numGroups);\n" \
+"    const uint i = get_group_id(0) * TILE + lx;\n" \
+"    const uint j = get_group_id(1) * TILE + ly;\n" \
+"    TYPE c00 = (TYPE)(0), c01 = (TYPE)(0), c10 = (TYPE)(0), c11 = (TYPE)(0);\n" \
+"    uint g;\n" \
+"\n" \
+"    /* tiles computed by a single work group are in C already */\n" \
+"    if (first == last) {\n" \
+"        return;\n" \
+"    }\n" \
+"    for (g = first; g <= last; g++) {\n" \
+"        /* the tile is the first segment of every group starting in it */\n" \
+"        const uint s = (g == first && groupStart(g, totalIters, numGroups) < tileBegin) ? 1 : 0;\n" \
+"        __global const TYPE *slot = W + (2 * g + s) * TILE * TILE;\n" \
+"        c00 += slot[ly * TILE + lx];\n" \
+"        c10 += slot[ly * TILE + lx + WG];\n" \
+"        c01 += slot[(ly + WG) * TILE + lx];\n" \
+"        c11 += slot[(ly + WG) * TILE + lx + WG];\n" \
+"    }\n" \
+"\n" \
+"    C += offC;\n" \
+"    if ((i < M) && (j < N)) STORE(c00, i, j);\n" \
+"    if ((i + WG < M) && (j < N)) STORE(c10, i + WG, j);\n" \
+"    if ((i < M) && (j + WG < N)) STORE(c01, i, j + WG);\n" \
+"    if ((i + WG < M) && (j + WG < N)) STORE(c11, i + WG, j + WG);\n" \
+"}\n"
+
+#define STREAMK_FLOAT_DEFS \
+"#define TYPE float\n"
+
+#define STREAMK_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define TYPE double\n"
+
+#define STREAMK_COMPLEX_FLOAT_DEFS \
+"#define TYPE float2\n" \
+"#define COMPLEX\n"
+
+#define STREAMK_COMPLEX_DOUBLE_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n" \
+"#define TYPE double2\n" \
+"#define COMPLEX\n"
+
+/*
+ * Kernels are cached by makeGemmKernel() by the address of their source,
+ * so every precision has sources of its own
+ */
+template<typename Precision>
+struct StreamKSources
+{
+  static const char *main;
+  static const char *fixup;
+};
+
+template<> const char *StreamKSources<float>::main =
+  STREAMK_FLOAT_DEFS STREAMK_COMMON_SRC STREAMK_KERNEL_SRC;
+template<> const char *StreamKSources<float>::fixup =
+  STREAMK_FLOAT_DEFS STREAMK_COMMON_SRC STREAMK_FIXUP_SRC;
+
+template<> const char *StreamKSources<double>::main =
+  STREAMK_DOUBLE_DEFS STREAMK_COMMON_SRC STREAMK_KERNEL_SRC;
+template<> const char *StreamKSources<double>::fixup =
+  STREAMK_DOUBLE_DEFS STREAMK_COMMON_SRC STREAMK_FIXUP_SRC;
+
+template<> const char *StreamKSources<FloatComplex>::main =
+  STREAMK_COMPLEX_FLOAT_DEFS STREAMK_COMMON_SRC STREAMK_KERNEL_SRC;
+template<> const char *StreamKSources<FloatComplex>::fixup =
+  STREAMK_COMPLEX_FLOAT_DEFS STREAMK_COMMON_SRC STREAMK_FIXUP_SRC;
+
+template<> const char *StreamKSources<DoubleComplex>::main =
+  STREAMK_COMPLEX_DOUBLE_DEFS STREAMK_COMMON_SRC STREAMK_KERNEL_SRC;
+template<> const char *StreamKSources<DoubleComplex>::fixup =
+  STREAMK_COMPLEX_DOUBLE_DEFS STREAMK_COMMON_SRC STREAMK_FIXUP_SRC;
+
+static bool isZero(float v) { return v == 0; }
+static bool isZero(double v) { return v == 0; }
+static bool isZero(FloatComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool isZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+static int transposeArg(clblasTranspose trans)
+{
+  return (trans == clblasNoTrans) ? 0 : (trans == clblasTrans) ? 1 : 2;
+}
+
+static int readEnvInt(const char *name, int defaultValue)
+{
+  const char *env = getenv(name);
+
+  return (env != NULL) ? atoi(env) : defaultValue;
+}
+
+/******************************************************************************
+ * Number of persistent work groups; 0 means the problem is better served
+ * by a work group per tile
+ *****************************************************************************/
+static cl_uint
+streamKGroups(
+  cl_device_id device,
+  cl_uint numTiles,
+  cl_uint K,
+  cl_ulong totalIters,
+  bool forced)
+{
+  // read on every call so that it can be switched per problem
+  int mode = forced ? 1 : readEnvInt("AMD_CLBLAS_GEMM_STREAMK", -1);
+  cl_uint numCUs;
+  cl_uint capacity;
+  cl_ulong waves;
+
+  if (mode == 0 || totalIters > 0xffffffffUL) {
+    return 0;
+  }
+  if (clGetDeviceInfo(device, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(numCUs),
+                      &numCUs, NULL) != CL_SUCCESS) {
+    return 0;
+  }
+  capacity = numCUs * STREAMK_GROUPS_PER_CU;
+
+  if (mode < 0) {
+    if (K < STREAMK_MIN_K) {
+      return 0;
+    }
+    // less than a wave is left to split-K
+    if (numTiles < capacity) {
+      return 0;
+    }
+    // share of the device busy over the waves of a tile per work group
+    waves = (numTiles + capacity - 1) / capacity;
+    if ((cl_ulong)numTiles * 100 >= waves * capacity * STREAMK_MIN_EFFICIENCY) {
+      return 0;
+    }
+  }
+
+  return (totalIters < capacity) ? static_cast<cl_uint>(totalIters) : capacity;
+}
+
+/******************************************************************************
+ * Stream-K GEMM
+ *****************************************************************************/
+template<typename Precision>
+clblasStatus
+GemmStreamK(clblasTranspose transA,
+            clblasTranspose transB,
+            cl_uint M, cl_uint N, cl_uint K,
+            Precision alpha,
+            cl_mem A, cl_uint offA, cl_uint lda,
+            cl_mem B, cl_uint offB, cl_uint ldb,
+            Precision beta,
+            cl_mem C, cl_uint offC, cl_uint ldc,
+            cl_uint numCommandQueues,
+            cl_command_queue *commandQueues,
+            cl_uint numEventsInWaitList,
+            const cl_event *eventWaitList,
+            cl_event *events,
+            bool forced,
+            bool &streamKHandled)
+{
+  cl_command_queue queue = commandQueues[0];
+  cl_context context;
+  cl_device_id device;
+  cl_int err;
+
+  (void)numCommandQueues;
+
+  streamKHandled = false;
+  if (M == 0 || N == 0 || K == 0) {
+    return clblasNotImplemented;
+  }
+
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(context), &context, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  cl_uint tilesM = (M + STREAMK_TILE - 1) / STREAMK_TILE;
+  cl_uint tilesN = (N + STREAMK_TILE - 1) / STREAMK_TILE;
+  cl_uint itersPerTile = (K + STREAMK_UNROLL - 1) / STREAMK_UNROLL;
+  cl_ulong total = (cl_ulong)tilesM * tilesN * itersPerTile;
+
+  cl_uint numGroups = streamKGroups(device, tilesM * tilesN, K, total, forced);
+  if (numGroups == 0) {
+    return clblasNotImplemented;
+  }
+  cl_uint totalIters = static_cast<cl_uint>(total);
+
+  streamKHandled = true;
+
+/******************************************************************************
+ * Build kernels
+ *****************************************************************************/
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+  cl_kernel mainKernel = NULL;
+  cl_kernel fixupKernel = NULL;
+
+  makeGemmKernel(&mainKernel, queue, StreamKSources<Precision>::main,
+    "", &noBinary, &noBinarySize, "");
+  makeGemmKernel(&fixupKernel, queue, StreamKSources<Precision>::fixup,
+    "", &noBinary, &noBinarySize, "");
+
+/******************************************************************************
+ * Workspace for the segments of split tiles, two tiles per work group
+ *****************************************************************************/
+  cl_mem W = acquireWorkspace(context,
+    (size_t)2 * numGroups * STREAMK_TILE * STREAMK_TILE * sizeof(Precision), &err);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  const size_t localSize[2] = { STREAMK_WG_SIZE, STREAMK_WG_SIZE };
+  const size_t mainGlobalSize[2] = {
+    (size_t)numGroups * STREAMK_WG_SIZE, STREAMK_WG_SIZE };
+  const size_t fixupGlobalSize[2] = {
+    (size_t)tilesM * STREAMK_WG_SIZE, (size_t)tilesN * STREAMK_WG_SIZE };
+
+  int tA = transposeArg(transA);
+  int tB = transposeArg(transB);
+  int betaZero = isZero(beta) ? 1 : 0;
+
+  const size_t mainArgSizes[] = {
+    sizeof(cl_mem), sizeof(cl_mem), sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(int), sizeof(int),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(Precision), sizeof(Precision), sizeof(int) };
+  const void *mainArgs[] = {
+    &A, &B, &C, &W,
+    &M, &N, &K,
+    &lda, &ldb, &ldc,
+    &offA, &offB, &offC,
+    &tA, &tB,
+    &tilesM, &itersPerTile, &totalIters,
+    &alpha, &beta, &betaZero };
+  const size_t fixupArgSizes[] = {
+    sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(Precision), sizeof(Precision), sizeof(int) };
+  const void *fixupArgs[] = {
+    &W, &C,
+    &M, &N,
+    &ldc, &offC,
+    &tilesM, &itersPerTile, &totalIters, &numGroups,
+    &alpha, &beta, &betaZero };
+
+  err = CL_SUCCESS;
+  for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(mainArgs) / sizeof(mainArgs[0]); i++) {
+    err = clSetKernelArg(mainKernel, i, mainArgSizes[i], mainArgs[i]);
+  }
+  for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(fixupArgs) / sizeof(fixupArgs[0]); i++) {
+    err = clSetKernelArg(fixupKernel, i, fixupArgSizes[i], fixupArgs[i]);
+  }
+  if (err != CL_SUCCESS) {
+    releaseWorkspace(W, NULL);
+    return static_cast<clblasStatus>(err);
+  }
+
+/******************************************************************************
+ * Enqueue. The fix-up waits for all segments of the split tiles.
+ *****************************************************************************/
+  cl_event mainEvent = NULL;
+  cl_event fixupEvent = NULL;
+
+  err = clEnqueueNDRangeKernel(queue, mainKernel, 2, NULL,
+    mainGlobalSize, localSize, numEventsInWaitList, eventWaitList, &mainEvent);
+  if (err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+    err = clEnqueueNDRangeKernel(queue, fixupKernel, 2, NULL,
+      fixupGlobalSize, localSize, 1, &mainEvent, &fixupEvent);
+    if (err == CL_SUCCESS) {
+      statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+      clReleaseEvent(mainEvent);
+    }
+    else {
+      fixupEvent = mainEvent;
+    }
+  }
+
+  // the workspace goes back to the pool once the last kernel completes
+  releaseWorkspace(W, fixupEvent);
+  if (err == CL_SUCCESS && events != NULL) {
+    *events = fixupEvent;
+  }
+  else if (fixupEvent != NULL) {
+    clReleaseEvent(fixupEvent);
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+/******************************************************************************
+ * Explicit instantiations
+ *****************************************************************************/
+#define INSTANTIATE_GEMM_STREAM_K(Precision)                      \
+template clblasStatus                                             \
+GemmStreamK<Precision>(clblasTranspose, clblasTranspose,          \
+  cl_uint, cl_uint, cl_uint,                                      \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_mem, cl_uint, cl_uint,                                       \
+  Precision,                                                      \
+  cl_mem, cl_uint, cl_uint,                                       \
+  cl_uint, cl_command_queue *,                                    \
+  cl_uint, const cl_event *, cl_event *,                          \
+  bool, bool &);
+
+INSTANTIATE_GEMM_STREAM_K(float)
+INSTANTIATE_GEMM_STREAM_K(double)
+INSTANTIATE_GEMM_STREAM_K(FloatComplex)
+INSTANTIATE_GEMM_STREAM_K(DoubleComplex)
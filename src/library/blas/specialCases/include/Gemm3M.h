@@ -0,0 +1,65 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+/*
+ * 3M (Gauss) complex GEMM on top of the real GEMM kernels.
+ *
+ * With op(A) = Ar + i Ai and op(B) = Br + i Bi, the product is
+ *
+ *   T1 = Ar Br,  T2 = Ai Bi,  T3 = (Ar + Ai)(Br + Bi)
+ *   op(A) op(B) = (T1 - T2) + i (T3 - T1 - T2)
+ *
+ * which takes three real GEMMs instead of the four real multiplies per
+ * complex one of the direct kernels, i.e. 25% fewer flops. A split kernel
+ * stores the real, imaginary and summed planes of op(A) and op(B) to a
+ * workspace and a combine kernel applies alpha and beta to C. The imaginary
+ * part is slightly less accurate than with the direct method since it is
+ * obtained by cancellation.
+ *
+ * The mode is opt-in: AMD_CLBLAS_GEMM_3M=<n> uses it for CGEMM and ZGEMM
+ * when M, N and K are all at least n; unset or 0 disables it.
+ */
+
+#ifndef CLBLAS_GEMM_3M_H
+#define CLBLAS_GEMM_3M_H
+
+#include <clBLAS.h>
+
+/*
+ * Matrices are expected in column major order. If the mode is disabled or
+ * the problem is not large enough, 'gemm3MHandled' is set to false and
+ * nothing is enqueued. Real precisions are never handled. 'forced' takes
+ * the mode whatever the threshold, for a path pinned by the caller.
+ */
+template<typename Precision>
+clblasStatus
+Gemm3M(clblasTranspose transA,
+       clblasTranspose transB,
+       cl_uint M, cl_uint N, cl_uint K,
+       Precision alpha,
+       cl_mem A, cl_uint offA, cl_uint lda,
+       cl_mem B, cl_uint offB, cl_uint ldb,
+       Precision beta,
+       cl_mem C, cl_uint offC, cl_uint ldc,
+       cl_uint numCommandQueues,
+       cl_command_queue *commandQueues,
+       cl_uint numEventsInWaitList,
+       const cl_event *eventWaitList,
+       cl_event *events,
+       bool forced,
+       bool &gemm3MHandled);
+
+#endif
@@ -0,0 +1,62 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+/*
+ * Split-K GEMM for problems whose C has too few tiles to occupy the device
+ * while K is long, e.g. 64x64x1000000.
+ *
+ * K is partitioned across work groups. By default each slice writes its
+ * partial product to a workspace which a second pass sums in a fixed order,
+ * so results are deterministic. With AMD_CLBLAS_GEMM_SPLITK_ATOMICS=1 the
+ * slices accumulate into C with atomics instead, skipping the workspace;
+ * the variable is read on every call. The workspace comes from the
+ * workspace pool.
+ *
+ * The split factor is chosen from the number of compute units and C tiles.
+ * AMD_CLBLAS_GEMM_SPLITK=0 disables the mode, AMD_CLBLAS_GEMM_SPLITK=<n>
+ * forces n slices for every problem long enough in K.
+ */
+
+#ifndef CLBLAS_GEMM_SPLIT_K_H
+#define CLBLAS_GEMM_SPLIT_K_H
+
+#include <clBLAS.h>
+
+/*
+ * Matrices are expected in column major order. If the problem is not
+ * worth splitting, 'splitKHandled' is set to false and nothing is enqueued.
+ * 'forced' splits even a C filling the device, for a path pinned by the
+ * caller, as long as K is long enough.
+ */
+template<typename Precision>
+clblasStatus
+GemmSplitK(clblasTranspose transA,
+           clblasTranspose transB,
+           cl_uint M, cl_uint N, cl_uint K,
+           Precision alpha,
+           cl_mem A, cl_uint offA, cl_uint lda,
+           cl_mem B, cl_uint offB, cl_uint ldb,
+           Precision beta,
+           cl_mem C, cl_uint offC, cl_uint ldc,
+           cl_uint numCommandQueues,
+           cl_command_queue *commandQueues,
+           cl_uint numEventsInWaitList,
+           const cl_event *eventWaitList,
+           cl_event *events,
+           bool forced,
+           bool &splitKHandled);
+
+#endif
@@ -0,0 +1,64 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+/*
+ * Strassen-Winograd SGEMM and DGEMM for very large problems.
+ *
+ * One level of Winograd's variant of Strassen's algorithm splits op(A),
+ * op(B) and C in 2x2 blocks and forms the product with 7 block GEMMs and
+ * 15 block additions instead of 8 block GEMMs, i.e. 12.5% fewer flops.
+ * The block GEMMs are regular clblasSgemm/clblasDgemm calls, so a block
+ * that is still large enough takes another level, 23% fewer flops for two.
+ * Odd rows, columns and depth are left to regular GEMMs on the rims.
+ *
+ * The error bound is weaker than for the standard algorithm and gets weaker
+ * with every level; the Strassen performance test reports the difference
+ * against the standard algorithm.
+ *
+ * The mode is opt-in: AMD_CLBLAS_GEMM_STRASSEN=<n> uses it when M, N and K
+ * are all at least n; unset or 0 disables it.
+ */
+
+#ifndef CLBLAS_GEMM_STRASSEN_H
+#define CLBLAS_GEMM_STRASSEN_H
+
+#include <clBLAS.h>
+
+/*
+ * Matrices are expected in column major order. If the mode is disabled or
+ * the problem is not large enough, 'strassenHandled' is set to false and
+ * nothing is enqueued. Complex precisions are never handled. 'forced'
+ * takes the mode whatever the threshold, for a path pinned by the caller.
+ */
+template<typename Precision>
+clblasStatus
+GemmStrassen(clblasTranspose transA,
+             clblasTranspose transB,
+             cl_uint M, cl_uint N, cl_uint K,
+             Precision alpha,
+             cl_mem A, cl_uint offA, cl_uint lda,
+             cl_mem B, cl_uint offB, cl_uint ldb,
+             Precision beta,
+             cl_mem C, cl_uint offC, cl_uint ldc,
+             cl_uint numCommandQueues,
+             cl_command_queue *commandQueues,
+             cl_uint numEventsInWaitList,
+             const cl_event *eventWaitList,
+             cl_event *events,
+             bool forced,
+             bool &strassenHandled);
+
+#endif
@@ -0,0 +1,64 @@
+/* ************************************************************************
+* Copyright 2015 Advanced Micro Devices, Inc.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+* ************************************************************************/
+
+/*
+ * Stream-K GEMM for problems whose tile count is a little more than a
+ * multiple of the number of work groups the device runs at once, which
+ * leaves the last wave of a tile per work group launch mostly idle.
+ *
+ * Exactly as many work groups as the device holds are launched. The
+ * multiply-add iterations of all tiles are laid end to end and every work
+ * group takes an equal share of them, so a tile may be split between
+ * consecutive work groups. Tiles a work group covers completely are written
+ * to C directly; the parts of split tiles are stored to a workspace and
+ * summed in a fixed order by a fix-up kernel, so results are deterministic.
+ *
+ * The mode is chosen when C fills at least one wave but a tile per work
+ * group launch would use less than 75% of the device over its waves; less
+ * than a wave is left to split-K. AMD_CLBLAS_GEMM_STREAMK=0 disables it,
+ * AMD_CLBLAS_GEMM_STREAMK=1 forces it for every problem.
+ */
+
+#ifndef CLBLAS_GEMM_STREAM_K_H
+#define CLBLAS_GEMM_STREAM_K_H
+
+#include <clBLAS.h>
+
+/*
+ * Matrices are expected in column major order. If the problem doesn't
+ * suffer from wave quantization, 'streamKHandled' is set to false and
+ * nothing is enqueued. 'forced' takes the mode as
+ * AMD_CLBLAS_GEMM_STREAMK=1 does, for a path pinned by the caller.
+ */
+template<typename Precision>
+clblasStatus
+GemmStreamK(clblasTranspose transA,
+            clblasTranspose transB,
+            cl_uint M, cl_uint N, cl_uint K,
+            Precision alpha,
+            cl_mem A, cl_uint offA, cl_uint lda,
+            cl_mem B, cl_uint offB, cl_uint ldb,
+            Precision beta,
+            cl_mem C, cl_uint offC, cl_uint ldc,
+            cl_uint numCommandQueues,
+            cl_command_queue *commandQueues,
+            cl_uint numEventsInWaitList,
+            const cl_event *eventWaitList,
+            cl_event *events,
+            bool forced,
+            bool &streamKHandled);
+
+#endif
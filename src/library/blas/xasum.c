@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doAsum(
@@ -121,6 +122,8 @@ doAsum(
 
         redctnArgs.dtype = asumType;
 
+		statisticsEnter(CLBLAS_ASUM, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_ASUM, kargs, numCommandQueues, commandQueues,
         					  numEventsInWaitList, eventWaitList, &firstAsumCall, &seq);
@@ -151,6 +154,7 @@ doAsum(
 		}
 
 		freeSolutionSeq(&seq);
+		statisticsLeave();
 		return (clblasStatus)err;
 }
 
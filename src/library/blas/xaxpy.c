@@ -24,6 +24,8 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "host_path.h"
 
 
 clblasStatus
@@ -52,27 +54,41 @@ doAxpy(
 
 		/* Validate arguments */
 
-        retCode = checkMemObjects(X, Y, X, false, X_VEC_ERRSET, Y_VEC_ERRSET, X_VEC_ERRSET );
-		if (retCode) {
-			#ifdef DEBUG_AXPY
-			printf("Invalid mem object..\n");
-			#endif
-            return retCode;
+		if (kargs->svm) {
+#if !defined(CL_VERSION_2_0)
+			return clblasNotImplemented;
+#endif
+			retCode = checkSVMVectorSizes(N, X, incx, X_VEC_ERRSET);
+			if (retCode == clblasSuccess) {
+				retCode = checkSVMVectorSizes(N, Y, incy, Y_VEC_ERRSET);
+			}
+			if (retCode) {
+				return retCode;
+			}
 		}
-
-		// Check wheather enough memory was allocated
-
-		if ((retCode = checkVectorSizes(kargs->dtype, N, X, offx, incx, X_VEC_ERRSET))) {
-			#ifdef DEBUG_AXPY
-			printf("Invalid Size for X\n");
-			#endif
-            return retCode;
-		}
-		if ((retCode = checkVectorSizes(kargs->dtype, N, Y, offy, incy, Y_VEC_ERRSET))) {
-			#ifdef DEBUG_AXPY
-			printf("Invalid Size for Y\n");
-			#endif
-            return retCode;
+		else {
+			retCode = checkMemObjects(X, Y, X, false, X_VEC_ERRSET, Y_VEC_ERRSET, X_VEC_ERRSET );
+			if (retCode) {
+				#ifdef DEBUG_AXPY
+				printf("Invalid mem object..\n");
+				#endif
+				return retCode;
+			}
+
+			// Check wheather enough memory was allocated
+
+			if ((retCode = checkVectorSizes(kargs->dtype, N, X, offx, incx, X_VEC_ERRSET))) {
+				#ifdef DEBUG_AXPY
+				printf("Invalid Size for X\n");
+				#endif
+				return retCode;
+			}
+			if ((retCode = checkVectorSizes(kargs->dtype, N, Y, offy, incy, Y_VEC_ERRSET))) {
+				#ifdef DEBUG_AXPY
+				printf("Invalid Size for Y\n");
+				#endif
+				return retCode;
+			}
 		}
 		///////////////////////////////////////////////////////////////
 
@@ -108,6 +124,17 @@ doAxpy(
 		kargs->offCY = offy;
 		kargs->ldc.Vector = incy;	// Will be using this as incy
 
+		statisticsEnter(CLBLAS_AXPY, kargs->dtype);
+
+		if (isHostPathSuitable(CLBLAS_AXPY, kargs, numCommandQueues,
+		                       commandQueues)) {
+			retCode = executeOnHost(CLBLAS_AXPY, kargs, commandQueues[0],
+			                        numEventsInWaitList, eventWaitList, events);
+
+			statisticsLeave();
+			return retCode;
+		}
+
 		#ifdef DEBUG_AXPY
 		printf("Calling makeSolutionSeq from DoAxpy: AXPY\n");
 		#endif
@@ -121,6 +148,7 @@ doAxpy(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
@@ -247,3 +275,57 @@ clblasZaxpy(
 		return doAxpy(&kargs, N, X, offx, incx, Y, offy, incy,
 						numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
 	}
+
+clblasStatus
+clblasSaxpySVM(
+    size_t N,
+    cl_float alpha,
+    const void *X,
+    size_t offx,
+    int incx,
+    void *Y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+	{
+		CLBlasKargs kargs;
+
+		memset(&kargs, 0, sizeof(kargs));
+		kargs.dtype = TYPE_FLOAT;
+		kargs.alpha.argFloat = alpha;
+		kargs.svm = true;
+
+		return doAxpy(&kargs, N, (cl_mem)X, offx, incx, (cl_mem)Y, offy, incy,
+						numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+	}
+
+clblasStatus
+clblasDaxpySVM(
+    size_t N,
+    cl_double alpha,
+    const void *X,
+    size_t offx,
+    int incx,
+    void *Y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+	{
+		CLBlasKargs kargs;
+
+		memset(&kargs, 0, sizeof(kargs));
+		kargs.dtype = TYPE_DOUBLE;
+		kargs.alpha.argDouble = alpha;
+		kargs.svm = true;
+
+		return doAxpy(&kargs, N, (cl_mem)X, offx, incx, (cl_mem)Y, offy, incy,
+						numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+	}
@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -105,6 +106,8 @@ doCopy(
 		printf("Calling makeSolutionSeq from DoCopy: COPY\n");
 		#endif
 
+		statisticsEnter(CLBLAS_COPY, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_COPY, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -114,6 +117,7 @@ doCopy(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
@@ -23,6 +23,8 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "host_path.h"
 
 clblasStatus
 doDot(
@@ -58,41 +60,59 @@ doDot(
 
 		/* Validate arguments */
 
-		retCode = checkMemObjects(X, Y, X, false, X_VEC_ERRSET, Y_VEC_ERRSET, X_VEC_ERRSET );
-		retCode |= checkMemObjects(scratchBuff, dotProduct, X, false, X_VEC_ERRSET, X_VEC_ERRSET, Y_VEC_ERRSET );
-		if (retCode) {
-			#ifdef DEBUG_DOT
-            printf("Invalid mem object..\n");
-            #endif
-            return retCode;
-		}
-
-		// Check wheather enough memory was allocated
-
-		if ((retCode = checkVectorSizes(kargs->dtype, N, X, offx, incx, X_VEC_ERRSET))) {
-			#ifdef DEBUG_DOT
-            printf("Invalid Size for X\n");
-            #endif
-            return retCode;
-		}
-		if ((retCode = checkVectorSizes(kargs->dtype, N, Y, offy, incy, Y_VEC_ERRSET))) {
-			#ifdef DEBUG_DOT
-            printf("Invalid Size for Y\n");
-            #endif
-            return retCode;
+		if (kargs->svm) {
+#if !defined(CL_VERSION_2_0)
+			return clblasNotImplemented;
+#endif
+			retCode = checkSVMVectorSizes(N, X, incx, X_VEC_ERRSET);
+			if (retCode == clblasSuccess) {
+				retCode = checkSVMVectorSizes(N, Y, incy, Y_VEC_ERRSET);
+			}
+			if ((retCode == clblasSuccess) &&
+			    ((scratchBuff == NULL) || (dotProduct == NULL))) {
+				retCode = clblasInvalidMemObject;
+			}
+			if (retCode) {
+				return retCode;
+			}
 		}
-		// Minimum size of scratchBuff is N
-		if ((retCode = checkVectorSizes(kargs->dtype, N, scratchBuff, 0, 1, X_VEC_ERRSET))) {
-			#ifdef DEBUG_DOT
-            printf("Insufficient ScratchBuff\n");
-            #endif
-            return retCode;
-		}
-		if ((retCode = checkVectorSizes(kargs->dtype, 1, dotProduct, offDP, 1, Y_VEC_ERRSET))) {
-			#ifdef DEBUG_DOT
-            printf("Invalid Size for dotProduct\n");
-            #endif
-            return retCode;
+		else {
+			retCode = checkMemObjects(X, Y, X, false, X_VEC_ERRSET, Y_VEC_ERRSET, X_VEC_ERRSET );
+			retCode |= checkMemObjects(scratchBuff, dotProduct, X, false, X_VEC_ERRSET, X_VEC_ERRSET, Y_VEC_ERRSET );
+			if (retCode) {
+				#ifdef DEBUG_DOT
+				printf("Invalid mem object..\n");
+				#endif
+				return retCode;
+			}
+
+			// Check wheather enough memory was allocated
+
+			if ((retCode = checkVectorSizes(kargs->dtype, N, X, offx, incx, X_VEC_ERRSET))) {
+				#ifdef DEBUG_DOT
+				printf("Invalid Size for X\n");
+				#endif
+				return retCode;
+			}
+			if ((retCode = checkVectorSizes(kargs->dtype, N, Y, offy, incy, Y_VEC_ERRSET))) {
+				#ifdef DEBUG_DOT
+				printf("Invalid Size for Y\n");
+				#endif
+				return retCode;
+			}
+			// Minimum size of scratchBuff is N
+			if ((retCode = checkVectorSizes(kargs->dtype, N, scratchBuff, 0, 1, X_VEC_ERRSET))) {
+				#ifdef DEBUG_DOT
+				printf("Insufficient ScratchBuff\n");
+				#endif
+				return retCode;
+			}
+			if ((retCode = checkVectorSizes(kargs->dtype, 1, dotProduct, offDP, 1, Y_VEC_ERRSET))) {
+				#ifdef DEBUG_DOT
+				printf("Invalid Size for dotProduct\n");
+				#endif
+				return retCode;
+			}
 		}
 		///////////////////////////////////////////////////////////////
 
@@ -126,6 +146,18 @@ doDot(
         kargs->D = scratchBuff;
         kargs->redctnType = REDUCE_BY_SUM;
         kargs->K = (size_t)doConj;
+
+        statisticsEnter(CLBLAS_DOT, kargs->dtype);
+
+        if (isHostPathSuitable(CLBLAS_DOT, kargs, numCommandQueues,
+                               commandQueues)) {
+            retCode = executeOnHost(CLBLAS_DOT, kargs, commandQueues[0],
+                                    numEventsInWaitList, eventWaitList, events);
+
+            statisticsLeave();
+            return retCode;
+        }
+
         memcpy(&redctnArgs, kargs, sizeof(CLBlasKargs));
 
 		listInitHead(&seq);
@@ -158,6 +190,7 @@ doDot(
 		}
 
 		freeSolutionSeq(&seq);
+		statisticsLeave();
 		return (clblasStatus)err;
 }
 
@@ -358,3 +391,63 @@ clblasZdotc(
     return doDot(&kargs, N, dotProduct, offDP, X, offx, incx, Y, offy, incy, scratchBuff, doConj,
                     numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
 }
+
+clblasStatus
+clblasSdotSVM(
+    size_t N,
+    void *dotProduct,
+    size_t offDP,
+    const void *X,
+    size_t offx,
+    int incx,
+    const void *Y,
+    size_t offy,
+    int incy,
+    void *scratchBuff,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_FLOAT;
+    kargs.pigFuncID = CLBLAS_DOT;
+    kargs.svm = true;
+
+    return doDot(&kargs, N, (cl_mem)dotProduct, offDP, (cl_mem)X, offx, incx,
+                 (cl_mem)Y, offy, incy, (cl_mem)scratchBuff, 0,
+                 numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+}
+
+clblasStatus
+clblasDdotSVM(
+    size_t N,
+    void *dotProduct,
+    size_t offDP,
+    const void *X,
+    size_t offx,
+    int incx,
+    const void *Y,
+    size_t offy,
+    int incy,
+    void *scratchBuff,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_DOUBLE;
+    kargs.pigFuncID = CLBLAS_DOT;
+    kargs.svm = true;
+
+    return doDot(&kargs, N, (cl_mem)dotProduct, offDP, (cl_mem)X, offx, incx,
+                 (cl_mem)Y, offy, incy, (cl_mem)scratchBuff, 0,
+                 numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+}
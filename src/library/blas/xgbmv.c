@@ -21,6 +21,7 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 static clblasStatus
 doGbmv(
@@ -107,6 +108,8 @@ doGbmv(
     kargs->offCY = offy;
     kargs->ldc.Vector = incy;
 
+    statisticsEnter(CLBLAS_GBMV, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_GBMV, kargs, numCommandQueues, commandQueues,
                               numEventsInWaitList, eventWaitList, events, &seq);
@@ -117,6 +120,7 @@ doGbmv(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
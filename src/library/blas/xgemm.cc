@@ -15,18 +15,30 @@
  * ************************************************************************/
 
 #include <map>
+#include <set>
 #include <string>
 #include <sstream>
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <clBLAS.h>
 #include "mutex.h"
+#include "kernel_blob.h"
+#include "binary_lookup.h"
 #include "AutoGemmIncludes/AutoGemmKernelSelection.h"
 #include "GemmSpecialCases.h"
+#include "GemmSplitK.h"
+#include "Gemm3M.h"
+#include "GemmStrassen.h"
+#include "GemmStreamK.h"
 
  #include <functor.h>
 // #include <functor_selector.h>
 #include "xgemm.h"
+#include "host_path.h"
+#include "statistics.h"
+#include "path_table.h"
 
 #ifdef _WIN32
 //#include <thread>
@@ -37,6 +49,7 @@
 /******************************************************************************
  * Row major -> column major
  *****************************************************************************/
+template<typename Mem>
 static void force_gemm_column_major(
   clblasOrder &order,
   clblasTranspose &transA,
@@ -47,8 +60,8 @@ static void force_gemm_column_major(
   cl_uint &offB,
   cl_uint &lda,
   cl_uint &ldb,
-  cl_mem &A,
-  cl_mem &B )
+  Mem &A,
+  Mem &B )
 {
   if (order == clblasRowMajor) {
     std::swap(transA , transB);
@@ -72,10 +85,55 @@ static void force_gemm_column_major(
 	if (err != CL_SUCCESS)\
 		return static_cast<clblasStatus>(err);
 
+// tile, row, column and corner
+const static unsigned int numGemmKernels = 4;
 const static unsigned int numGemmKernelArgs = 14;
-void *gemmKernelArgs[numGemmKernelArgs];
-size_t gemmKernelArgSizes[numGemmKernelArgs];
+// bias, scale, offBias, offScale, clampLow, clampHigh
+const static unsigned int numGemmEpilogueArgs = 6;
+void *gemmKernelArgs[numGemmKernelArgs + numGemmEpilogueArgs];
+size_t gemmKernelArgSizes[numGemmKernelArgs + numGemmEpilogueArgs];
 
+/******************************************************************************
+ * Matrices are the first kernel arguments; they are either buffers or
+ * SVM pointers
+ *****************************************************************************/
+const static unsigned int numGemmMemArgs = 3;
+
+static bool setGemmMemArg(unsigned int idx, cl_mem &mem) {
+  gemmKernelArgs[idx] = &mem;
+  gemmKernelArgSizes[idx] = sizeof(cl_mem);
+  return false;
+}
+static bool setGemmMemArg(unsigned int idx, void *&svmPtr) {
+  gemmKernelArgs[idx] = svmPtr;
+  gemmKernelArgSizes[idx] = sizeof(void*);
+  return true;
+}
+
+
+/******************************************************************************
+ * Kernel arguments for the host path
+ *****************************************************************************/
+static void setHostKargsType(CLBlasKargs &kargs, float alpha, float beta) {
+  kargs.dtype = TYPE_FLOAT;
+  kargs.alpha.argFloat = alpha;
+  kargs.beta.argFloat = beta;
+}
+static void setHostKargsType(CLBlasKargs &kargs, double alpha, double beta) {
+  kargs.dtype = TYPE_DOUBLE;
+  kargs.alpha.argDouble = alpha;
+  kargs.beta.argDouble = beta;
+}
+static void setHostKargsType(CLBlasKargs &kargs, FloatComplex alpha, FloatComplex beta) {
+  kargs.dtype = TYPE_COMPLEX_FLOAT;
+  kargs.alpha.argFloatComplex = alpha;
+  kargs.beta.argFloatComplex = beta;
+}
+static void setHostKargsType(CLBlasKargs &kargs, DoubleComplex alpha, DoubleComplex beta) {
+  kargs.dtype = TYPE_COMPLEX_DOUBLE;
+  kargs.alpha.argDoubleComplex = alpha;
+  kargs.beta.argDoubleComplex = beta;
+}
 
 /******************************************************************************
  * Is beta zero for optimization
@@ -131,6 +189,7 @@ typedef struct kernel_map_key_ {
   cl_context context; // address of context
   cl_device_id device; // address of device
   const char *kernelSource; // address of kernel source
+  unsigned int variant; // build options the source is compiled with
 } kernel_map_key;
 
 bool operator<(const kernel_map_key & l, const kernel_map_key & r) {
@@ -149,24 +208,61 @@ bool operator<(const kernel_map_key & l, const kernel_map_key & r) {
   } else if (r.kernelSource < l.kernelSource) {
     return false;
   }
+  if (l.variant < r.variant) {
+    return true;
+  } else if (r.variant < l.variant) {
+    return false;
+  }
   return false;
 }
 
+typedef std::map<kernel_map_key, cl_kernel> kernel_map_t;
+
+/*
+ * Every thread keeps its own map of kernels, as arguments can't be set on a
+ * kernel from several threads at once. The maps are registered here, so that
+ * the kernels of a context can be released from any thread.
+ */
+static std::set<kernel_map_t*> kernelMaps;
+static mutex_t *kernelMapsLock = mutexInit();
+
+extern "C" void releaseGemmKernels(cl_context context)
+{
+  mutexLock(kernelMapsLock);
+  for (std::set<kernel_map_t*>::iterator m = kernelMaps.begin();
+       m != kernelMaps.end(); ++m) {
+    kernel_map_t::iterator it = (*m)->begin();
+    while (it != (*m)->end()) {
+      if (context == NULL || it->first.context == context) {
+        clReleaseKernel(it->second);
+        (*m)->erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+  mutexUnlock(kernelMapsLock);
+}
+
 
 /******************************************************************************
  * Make Gemm Kernel
  *****************************************************************************/
 //FIXME: This function should be returning an error.
-void makeGemmKernel(
+/*
+ * Kernels built from the same source with different build options must be
+ * told apart by 'variant'; the plain kernels are variant 0.
+ */
+static void makeGemmKernelVariant(
   cl_kernel *clKernel, // ignored as input; returns as output only
   cl_command_queue clQueue,
   const char *kernelSource,
   const char *sourceBuildOptions,
   const unsigned char **kernelBinary,
   size_t *kernelBinarySize,
-  const char *binaryBuildOptions)
+  const char *binaryBuildOptions,
+  unsigned int variant)
 {
-  typedef std::map<kernel_map_key, cl_kernel> kernel_map_t;
   #if defined( _WIN32 )
   __declspec( thread ) static kernel_map_t *kernel_map = 0;
 #else
@@ -174,6 +270,9 @@ void makeGemmKernel(
 #endif
   if (!kernel_map) {
     kernel_map = new kernel_map_t();
+    mutexLock(kernelMapsLock);
+    kernelMaps.insert(kernel_map);
+    mutexUnlock(kernelMapsLock);
   }
 
   cl_context clContext;
@@ -190,11 +289,16 @@ void makeGemmKernel(
   key.kernelSource = kernelSource;
   key.context = clContext;
   key.device = clDevice;
+  key.variant = variant;
+  mutexLock(kernelMapsLock);
   kernel_map_t::iterator idx = kernel_map->find(key);
   if (idx == kernel_map->end()) {
     *clKernel = NULL;
   } else {
     *clKernel = idx->second;
+  }
+  mutexUnlock(kernelMapsLock);
+  if (*clKernel) {
     return;
   }
 
@@ -207,20 +311,25 @@ void makeGemmKernel(
       printf("makeGemmKernel: pre-compiled binary found: %llu bytes\n", *kernelBinarySize);
       printf("makeGemmKernel: Creating program from binary\n");
 #endif
+      // embedded binaries are compressed, decode them on first use
+      size_t binarySize = *kernelBinarySize;
+      const unsigned char *binary = kernelBlobData(*kernelBinary, &binarySize);
       clProgram = clCreateProgramWithBinary(
         clContext,
         1, &clDevice,
-        kernelBinarySize, kernelBinary,
+        &binarySize, &binary,
         &clBinaryStatus, &err );
 #ifdef AUTOGEMM_PRINT_DEBUG
       if (err != CL_SUCCESS) {
           printf("makeGemmKernel: Failed to create program with binary\n");
       }
 #endif
+      cl_ulong start = statisticsTime();
       err = clBuildProgram(
         clProgram,
         1, &clDevice,
         binaryBuildOptions, NULL, NULL );
+      statisticsProgramBuilt(start);
 #ifdef AUTOGEMM_PRINT_DEBUG
       if (err != CL_SUCCESS) {
           printf("makeGemmKernel: Failed to build program from binary\n");
@@ -232,15 +341,11 @@ void makeGemmKernel(
 #ifdef AUTOGEMM_PRINT_DEBUG
       printf("makeGemmKernel: Creating program from source\n");
 #endif
-      clProgram = clCreateProgramWithSource(
-        clContext,
-        1, &kernelSource,
-        NULL, &err );
-      CL_CHECK(err)
-      err = clBuildProgram(
-        clProgram,
-        1, &clDevice,
-        sourceBuildOptions, NULL, NULL );
+      // a kernel pack or the binary cache may have it built already
+      clProgram = BinaryLookup::buildProgramFromSourceCached(
+        "clblasAutoGemm", kernelSource,
+        clContext, clDevice,
+        err, sourceBuildOptions );
       CL_CHECK(err)
     }
 
@@ -275,11 +380,26 @@ void makeGemmKernel(
 #endif
 
     //put kernel in map
+    mutexLock(kernelMapsLock);
     (*kernel_map)[key] = *clKernel;
+    mutexUnlock(kernelMapsLock);
   }
   return;
 }
 
+void makeGemmKernel(
+  cl_kernel *clKernel, // ignored as input; returns as output only
+  cl_command_queue clQueue,
+  const char *kernelSource,
+  const char *sourceBuildOptions,
+  const unsigned char **kernelBinary,
+  size_t *kernelBinarySize,
+  const char *binaryBuildOptions)
+{
+  makeGemmKernelVariant(clKernel, clQueue, kernelSource, sourceBuildOptions,
+    kernelBinary, kernelBinarySize, binaryBuildOptions, 0);
+}
+
 /******************************************************************************
  * Enqueue Gemm Kernel
  *****************************************************************************/
@@ -289,6 +409,7 @@ void makeGemmKernel(
    void **kernelArgs,
    size_t *kernelArgSizes,
    unsigned int numKernelArgs,
+   bool svmMemArgs,
    const size_t *globalWorkSize,
    const size_t *localWorkSize,
    cl_uint numEventsInWaitList,
@@ -296,7 +417,17 @@ void makeGemmKernel(
    cl_event *clEvent)
  {
    for (unsigned int i = 0; i < numKernelArgs; i++) {
-	   cl_int err = clSetKernelArg(clKernel, i, kernelArgSizes[i], kernelArgs[i]);
+	   cl_int err;
+	   if (svmMemArgs && i < numGemmMemArgs) {
+#if defined(CL_VERSION_2_0)
+		   err = clSetKernelArgSVMPointer(clKernel, i, kernelArgs[i]);
+#else
+		   err = CL_INVALID_ARG_VALUE;
+#endif
+	   }
+	   else {
+		   err = clSetKernelArg(clKernel, i, kernelArgSizes[i], kernelArgs[i]);
+	   }
 	   if (err != CL_SUCCESS)
 		   return err;
    }
@@ -308,10 +439,50 @@ void makeGemmKernel(
 	   numEventsInWaitList, eventWaitList, clEvent);
    if (err != CL_SUCCESS)
 	   return err;
+   statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
    return CL_SUCCESS;
  }
 
+/******************************************************************************
+ * Join the events of kernels enqueued on one queue
+ *****************************************************************************/
+cl_int joinGemmEvents(
+  cl_command_queue clQueue,
+  cl_uint numKernelEvents,
+  cl_event *kernelEvents,
+  cl_event *clEvent)
+{
+  cl_int err = CL_SUCCESS;
+  cl_command_queue_properties props = 0;
+
+  if (numKernelEvents == 0) {
+    return CL_SUCCESS;
+  }
+
+  if (clEvent != NULL) {
+    if (numKernelEvents > 1) {
+      err = clGetCommandQueueInfo(clQueue, CL_QUEUE_PROPERTIES, sizeof(props),
+        &props, NULL);
+    }
+    if (err == CL_SUCCESS && (props & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE)) {
+      // the kernels may run in any order, wait for all of them
+      err = clEnqueueMarkerWithWaitList(clQueue, numKernelEvents, kernelEvents,
+        clEvent);
+    }
+    else if (err == CL_SUCCESS) {
+      // in order, the last kernel completes after the others
+      *clEvent = kernelEvents[--numKernelEvents];
+    }
+  }
+
+  for (cl_uint i = 0; i < numKernelEvents; i++) {
+    clReleaseEvent(kernelEvents[i]);
+  }
+
+  return err;
+}
+
 
 /******************************************************************************
  * get precision string
@@ -336,31 +507,413 @@ template<> clblasTranspose correctTranspose<DoubleComplex>( clblasTranspose tran
 
 
 /******************************************************************************
- * templated Gemm
+ * Paths available for buffers only. Return true if one of them has handled
+ * the problem, its status is stored to 'status' then. A pinned 'path' is
+ * the only one tried; if it is 'strict' and can't serve the problem, the
+ * call fails instead of falling back to the tile kernels.
  *****************************************************************************/
 template<typename Precision>
-clblasStatus
-clblasGemm(
+static bool
+gemmBufferPaths(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    cl_uint M, cl_uint N, cl_uint K,
+    Precision alpha,
+    cl_mem A, cl_uint offA, cl_uint lda,
+    cl_mem B, cl_uint offB, cl_uint ldb,
+    Precision beta,
+    cl_mem C, cl_uint offC, cl_uint ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    ImplPath path,
+    bool strict,
+    clblasStatus &status)
+{
+  if (path == PATH_AUTOGEMM) {
+    return false;
+  }
+
+/******************************************************************************
+ * Run small problems on the host if the device shares memory with it
+ *****************************************************************************/
+  CLBlasKargs hostKargs;
+  memset(&hostKargs, 0, sizeof(hostKargs));
+  setHostKargsType(hostKargs, alpha, beta);
+  hostKargs.order = order;
+  hostKargs.transA = transA;
+  hostKargs.transB = transB;
+  hostKargs.M = M;
+  hostKargs.N = N;
+  hostKargs.K = K;
+  hostKargs.A = A;
+  hostKargs.offA = offA;
+  hostKargs.lda.matrix = lda;
+  hostKargs.B = B;
+  hostKargs.offBX = offB;
+  hostKargs.ldb.matrix = ldb;
+  hostKargs.C = C;
+  hostKargs.offCY = offC;
+  hostKargs.ldc.matrix = ldc;
+  if (path == PATH_DEFAULT &&
+      isHostPathSuitable(CLBLAS_GEMM, &hostKargs, numCommandQueues, commandQueues)) {
+    status = executeOnHost(CLBLAS_GEMM, &hostKargs, commandQueues[0],
+      numEventsInWaitList, eventWaitList, events);
+    return true;
+  }
+
+/******************************************************************************
+ * Handle Special Cases
+ *
+ * 1) sgemm NT where lda, ldb are big multiples of 1024 starting from 4096
+ *
+ * 2) sgemm NT where M and N are within middle range
+ * and are mod32 but not mod96 or mod64
+ *
+ *****************************************************************************/
+
+  bool specialCaseHandled = false;
+
+  if (path == PATH_DEFAULT || path == PATH_SPECIAL) {
+    status = GemmSpecialCases<Precision>(order,
+      transA,
+      transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      specialCaseHandled);
+  }
+
+  if (specialCaseHandled)
+    return true;
+
+/******************************************************************************
+ * Strassen-Winograd for very large real problems, if enabled
+ *****************************************************************************/
+  bool strassenHandled = false;
+
+  if (path == PATH_DEFAULT || path == PATH_STRASSEN) {
+    status = GemmStrassen<Precision>(transA, transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      path == PATH_STRASSEN,
+      strassenHandled);
+  }
+
+  if (strassenHandled)
+    return true;
+
+/******************************************************************************
+ * Three real GEMMs in place of a large complex one, if enabled
+ *****************************************************************************/
+  bool gemm3MHandled = false;
+
+  if (path == PATH_DEFAULT || path == PATH_3M) {
+    status = Gemm3M<Precision>(transA, transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      path == PATH_3M,
+      gemm3MHandled);
+  }
+
+  if (gemm3MHandled)
+    return true;
+
+/******************************************************************************
+ * Persistent work groups when the last wave of tiles would be mostly idle
+ *****************************************************************************/
+  bool streamKHandled = false;
+
+  if (path == PATH_DEFAULT || path == PATH_STREAMK) {
+    status = GemmStreamK<Precision>(transA, transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      path == PATH_STREAMK,
+      streamKHandled);
+  }
+
+  if (streamKHandled)
+    return true;
+
+/******************************************************************************
+ * Split K across work groups when C is too small to occupy the device
+ *****************************************************************************/
+  bool splitKHandled = false;
+
+  if (path == PATH_DEFAULT || path == PATH_SPLITK) {
+    status = GemmSplitK<Precision>(transA, transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      path == PATH_SPLITK,
+      splitKHandled);
+  }
+
+  if (splitKHandled)
+    return true;
+
+  if (strict) {
+    status = clblasNotImplemented;
+    return true;
+  }
+
+  return false;
+}
+
+template<typename Precision>
+static bool
+gemmBufferPaths(
+    clblasOrder, clblasTranspose, clblasTranspose,
+    cl_uint, cl_uint, cl_uint,
+    Precision,
+    void *, cl_uint, cl_uint,
+    void *, cl_uint, cl_uint,
+    Precision,
+    void *, cl_uint, cl_uint,
+    cl_uint, cl_command_queue *,
+    cl_uint, const cl_event *, cl_event *,
+    ImplPath, bool strict,
+    clblasStatus &status)
+{
+  if (strict) {
+    status = clblasNotImplemented;
+    return true;
+  }
+  return false;
+}
+
+
+/******************************************************************************
+ * Fused epilogue
+ *****************************************************************************/
+template<typename Precision>
+static Precision epilogueScalar(cl_double value);
+template<>
+float epilogueScalar<float>(cl_double value) {
+  return static_cast<float>(value);
+}
+template<>
+double epilogueScalar<double>(cl_double value) {
+  return value;
+}
+template<>
+FloatComplex epilogueScalar<FloatComplex>(cl_double value) {
+  FloatComplex scalar;
+  CREAL(scalar) = static_cast<float>(value);
+  CIMAG(scalar) = 0;
+  return scalar;
+}
+template<>
+DoubleComplex epilogueScalar<DoubleComplex>(cl_double value) {
+  DoubleComplex scalar;
+  CREAL(scalar) = value;
+  CIMAG(scalar) = 0;
+  return scalar;
+}
+
+/*
+ * The kind of epilogue is compiled into the EP kernels. Append the matching
+ * defines to 'buildOptions' and return the kernel cache variant; 0 if there
+ * is no epilogue. Kernels see the column major problem, so per row vectors
+ * of a row major problem become per column ones.
+ */
+static unsigned int
+gemmEpilogueVariant(
+    const clblasEpilogue *epilogue,
+    bool rowMajor,
+    std::string &buildOptions)
+{
+  if (epilogue == NULL) {
+    return 0;
+  }
+
+  unsigned int bias = epilogue->biasMode;
+  unsigned int scale = epilogue->scaleMode;
+  unsigned int activation = epilogue->activation;
+  unsigned int clamp = epilogue->clamp ? 1 : 0;
+
+  if (rowMajor) {
+    if (bias != clblasEpilogueNone) {
+      bias = (bias == clblasEpiloguePerRow) ? clblasEpiloguePerColumn : clblasEpiloguePerRow;
+    }
+    if (scale != clblasEpilogueNone) {
+      scale = (scale == clblasEpiloguePerRow) ? clblasEpiloguePerColumn : clblasEpiloguePerRow;
+    }
+  }
+
+  std::ostringstream options;
+  options << " -DEPILOGUE_BIAS=" << bias
+          << " -DEPILOGUE_SCALE=" << scale
+          << " -DEPILOGUE_ACTIVATION=" << activation
+          << " -DEPILOGUE_CLAMP=" << clamp;
+  buildOptions += options.str();
+
+  return 1 + bias + 3*(scale + 3*(activation + 3*clamp));
+}
+
+
+/******************************************************************************
+ * Half precision kernels; clblasHgemm() and clblasGemmEx() run through
+ * clblasGemm<float>() with these in place of the float kernels
+ *****************************************************************************/
+typedef struct GemmHalfKernels_ {
+  GemmSelectKernelFunc selectKernel; // hgemmSelectKernel or hsgemmSelectKernel
+  bool halfArithmetic;               // build with -DHALF_ARITHMETIC
+} GemmHalfKernels;
+
+/*
+ * CPU devices run the register-blocked "_CPU" kernels unless
+ * AMD_CLBLAS_GEMM_CPU_KERNELS=0, which gives them the GPU kernels
+ */
+static bool
+gemmCPUKernelsEnabled(void)
+{
+  const char *env = getenv("AMD_CLBLAS_GEMM_CPU_KERNELS");
+
+  return env == NULL || atoi(env) != 0;
+}
+
+/*
+ * Devices with cl_khr_fp16 multiply halves natively unless
+ * AMD_CLBLAS_HALF_ARITHMETIC=0
+ */
+static bool
+deviceHalfArithmetic(cl_command_queue queue)
+{
+  const char *env = getenv("AMD_CLBLAS_HALF_ARITHMETIC");
+  cl_device_id device;
+  size_t size;
+
+  if (env != NULL && atoi(env) == 0) {
+    return false;
+  }
+  if (clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL) != CL_SUCCESS ||
+      clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, 0, NULL, &size) != CL_SUCCESS) {
+    return false;
+  }
+  std::string extensions(size, '\0');
+  if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, size, &extensions[0], NULL) != CL_SUCCESS) {
+    return false;
+  }
+  return extensions.find("cl_khr_fp16") != std::string::npos;
+}
+
+
+/******************************************************************************
+ * The regular kernels add the offset to the buffer pointer and index a matrix
+ * with col*ld+row in 32 bits; 'outer' is the number of columns as stored
+ *****************************************************************************/
+static bool
+gemmNeedsIndex64(size_t off, size_t ld, size_t outer)
+{
+  return off > UINT_MAX
+      || static_cast<cl_ulong>(ld) * static_cast<cl_ulong>(outer) > UINT_MAX;
+}
+
+template<typename Precision> DataType gemmDataType();
+template<> DataType gemmDataType<float>() { return TYPE_FLOAT; }
+template<> DataType gemmDataType<double>() { return TYPE_DOUBLE; }
+template<> DataType gemmDataType<FloatComplex>() { return TYPE_COMPLEX_FLOAT; }
+template<> DataType gemmDataType<DoubleComplex>() { return TYPE_COMPLEX_DOUBLE; }
+
+/******************************************************************************
+ * templated Gemm
+ *****************************************************************************/
+template<typename Precision, typename Mem>
+static clblasStatus
+doGemm(
     clblasOrder order,
     clblasTranspose transA,
     clblasTranspose transB,
     size_t iM, size_t iN, size_t iK,
     Precision alpha,
-    const cl_mem iA, size_t iOffA, size_t iLda,
-    const cl_mem iB, size_t iOffB, size_t iLdb,
+    const Mem iA, size_t iOffA, size_t iLda,
+    const Mem iB, size_t iOffB, size_t iLdb,
     Precision beta,
-    cl_mem C, size_t iOffC,  size_t iLdc,
+    Mem C, size_t iOffC,  size_t iLdc,
     cl_uint numCommandQueues,
     cl_command_queue *commandQueues,
     cl_uint numEventsInWaitList,
     const cl_event *eventWaitList,
-    cl_event *events)
+    cl_event *events,
+    const clblasEpilogue *epilogue,
+    const GemmHalfKernels *halfKernels)
 {
+  // sizes and leading dimensions are 32-bit in every kernel; offsets and
+  // matrices spanning more than 4G elements take the 64-bit index kernels
+  if (iM > UINT_MAX || iN > UINT_MAX || iK > UINT_MAX ||
+      iLda > UINT_MAX || iLdb > UINT_MAX || iLdc > UINT_MAX) {
+    return clblasNotImplemented;
+  }
+  bool colMajorIn = (order == clblasColumnMajor);
+  bool index64 =
+      gemmNeedsIndex64(iOffA, iLda, (colMajorIn == (transA == clblasNoTrans)) ? iK : iM) ||
+      gemmNeedsIndex64(iOffB, iLdb, (colMajorIn == (transB == clblasNoTrans)) ? iN : iK) ||
+      gemmNeedsIndex64(iOffC, iLdc, colMajorIn ? iN : iM);
+  if (index64 && (epilogue != NULL || halfKernels != NULL)) {
+    return clblasNotImplemented;
+  }
 
+  // a path pinned for the shape; epilogues, halves and 64-bit indices only
+  // have the tile kernels
+  int strictPath;
+  ImplPath path = gemmPinnedPath(
+      (halfKernels != NULL) ? TYPE_HALF : gemmDataType<Precision>(),
+      transA, transB, iM, iN, iK, &strictPath);
+  bool tileKernelsOnly = (epilogue != NULL || halfKernels != NULL || index64);
+  if (tileKernelsOnly && strictPath && path != PATH_AUTOGEMM) {
+    return clblasNotImplemented;
+  }
 
   // cast types to opencl types
-  cl_mem A = iA;
-  cl_mem B = iB;
+  Mem A = iA;
+  Mem B = iB;
   cl_uint M = static_cast<cl_uint>( iM );
   cl_uint N = static_cast<cl_uint>( iN );
   cl_uint K = static_cast<cl_uint>( iK );
@@ -379,41 +932,32 @@ clblasGemm(
   // CHECK_MATRIX_A(Precision, order, transA, A, M, K, offA, lda);
   // CHECK_MATRIX_B(Precision, order, transB, B, K, N, offB, ldb);
   // CHECK_MATRIX_C(Precision, order, clblasNoTrans, C, M, N, offC, ldc);
+  bool rowMajor = (order == clblasRowMajor);
   force_gemm_column_major( order, transA, transB,
     M, N, offA, offB, lda, ldb, A, B );
+  cl_ulong offA64 = iOffA;
+  cl_ulong offB64 = iOffB;
+  cl_ulong offC64 = iOffC;
+  if (rowMajor) {
+    std::swap(offA64, offB64);
+  }
 
 
-
-/******************************************************************************
- * Handle Special Cases
- *
- * 1) sgemm NT where lda, ldb are big multiples of 1024 starting from 4096
- *
- * 2) sgemm NT where M and N are within middle range
- * and are mod32 but not mod96 or mod64
- *
- *****************************************************************************/
-
-  bool specialCaseHandled = false;
-
-  clblasStatus SpecialCaseStatus = GemmSpecialCases<Precision>(order,
-	  transA,
-	  transB,
-	  M, N, K,
-	  alpha,
-	  A, offA, lda,
-	  B, offB, ldb,
-	  beta,
-	  C, offC, ldc,
-	  numCommandQueues,
-	  commandQueues,
-	  numEventsInWaitList,
-	  eventWaitList,
-	  events,
-	  specialCaseHandled);
-
-  if (specialCaseHandled)
-	  return SpecialCaseStatus;
+  // the host path and special cases know nothing about epilogues, halves
+  // and 64-bit indices
+  clblasStatus bufferPathStatus;
+  if (!tileKernelsOnly && gemmBufferPaths<Precision>(order, transA, transB,
+        M, N, K,
+        alpha,
+        A, offA, lda,
+        B, offB, ldb,
+        beta,
+        C, offC, ldc,
+        numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events,
+        path, strictPath != 0,
+        bufferPathStatus))
+    return bufferPathStatus;
 
 
 /******************************************************************************
@@ -429,7 +973,14 @@ clblasGemm(
   err = clGetDeviceInfo( clDevice, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(clDeviceNumCUs), &clDeviceNumCUs, NULL);
   //CL_CHECK(err)
   returnIfErr(err);
-  unsigned int deviceIdealNumThreads = (8 /*waves per CU*/)*(64 /*threads per wave*/)*clDeviceNumCUs;
+  cl_device_type clDeviceType;
+  err = clGetDeviceInfo( clDevice, CL_DEVICE_TYPE, sizeof(clDeviceType), &clDeviceType, NULL);
+  returnIfErr(err);
+  bool cpuKernels = (clDeviceType & CL_DEVICE_TYPE_CPU) != 0 && gemmCPUKernelsEnabled();
+  // a CPU core runs one work group at a time
+  unsigned int deviceIdealNumThreads = cpuKernels
+      ? (16 /*work group size*/)*clDeviceNumCUs
+      : (8 /*waves per CU*/)*(64 /*threads per wave*/)*clDeviceNumCUs;
   float optimalNumElementsPerThread = ((float)M*N) / deviceIdealNumThreads;
   //optimalNumElementsPerThread = 32;
   bool betaNonZero = !isZero(beta);
@@ -470,7 +1021,20 @@ clblasGemm(
   unsigned int microTileNumRows;
   unsigned int microTileNumCols;
   unsigned int unroll;
-  gemmSelectKernel<Precision>(
+  GemmSelectKernelFunc selectKernel = gemmSelectKernel<Precision>;
+  if (cpuKernels) {
+    selectKernel = gemmSelectKernelCPU<Precision>;
+  }
+  if (epilogue != NULL) {
+    selectKernel = gemmSelectKernelEpilogue<Precision>;
+  }
+  if (index64) {
+    selectKernel = gemmSelectKernel64<Precision>;
+  }
+  if (halfKernels != NULL) {
+    selectKernel = halfKernels->selectKernel;
+  }
+  selectKernel(
     order, transA, transB,
     iM, iN, iK,
     betaNonZero,
@@ -507,7 +1071,7 @@ clblasGemm(
       M, N, K,
       betaNonZero ? 1 : 0,
       optimalNumElementsPerThread );
-      gemmSelectKernel<Precision>(
+      selectKernel(
           order,
           transA,
           transB,
@@ -543,6 +1107,22 @@ clblasGemm(
   }
 
 
+  // the kind of epilogue and half arithmetic are build options, so
+  // binaries can't be used
+  std::string variantBuildOptions(sourceBuildOptions ? sourceBuildOptions : "");
+  unsigned int variant = gemmEpilogueVariant(epilogue, rowMajor, variantBuildOptions);
+  if (halfKernels != NULL && halfKernels->halfArithmetic) {
+    variantBuildOptions += " -DHALF_ARITHMETIC";
+    variant = 1;
+  }
+  if (variant != 0) {
+    sourceBuildOptions = variantBuildOptions.c_str();
+    tileKernelBinary   = NULL;
+    rowKernelBinary    = NULL;
+    colKernelBinary    = NULL;
+    cornerKernelBinary = NULL;
+  }
+
   unsigned int macroTileNumRows = workGroupNumRows*microTileNumRows;
   unsigned int macroTileNumCols = workGroupNumCols*microTileNumCols;
   bool needTileKernel = M/macroTileNumRows > 0
@@ -571,19 +1151,22 @@ clblasGemm(
   cl_kernel  rowClKernel        = NULL;
   cl_kernel  colClKernel        = NULL;
   cl_kernel  cornerClKernel     = NULL;
-  if (needTileKernel)   makeGemmKernel(  &tileClKernel, commandQueues[0],   tileKernelSource, sourceBuildOptions,   &tileKernelBinary,   tileKernelBinarySize, binaryBuildOptions);
-  if (needRowKernel)    makeGemmKernel(   &rowClKernel, commandQueues[0],    rowKernelSource, sourceBuildOptions,    &rowKernelBinary,    rowKernelBinarySize, binaryBuildOptions);
-  if (needColKernel)    makeGemmKernel(   &colClKernel, commandQueues[0],    colKernelSource, sourceBuildOptions,    &colKernelBinary,    colKernelBinarySize, binaryBuildOptions);
-  if (needCornerKernel) makeGemmKernel(&cornerClKernel, commandQueues[0], cornerKernelSource, sourceBuildOptions, &cornerKernelBinary, cornerKernelBinarySize, binaryBuildOptions);
+  if (needTileKernel)   makeGemmKernelVariant(  &tileClKernel, commandQueues[0],   tileKernelSource, sourceBuildOptions,   &tileKernelBinary,   tileKernelBinarySize, binaryBuildOptions, variant);
+  if (needRowKernel)    makeGemmKernelVariant(   &rowClKernel, commandQueues[0],    rowKernelSource, sourceBuildOptions,    &rowKernelBinary,    rowKernelBinarySize, binaryBuildOptions, variant);
+  if (needColKernel)    makeGemmKernelVariant(   &colClKernel, commandQueues[0],    colKernelSource, sourceBuildOptions,    &colKernelBinary,    colKernelBinarySize, binaryBuildOptions, variant);
+  if (needCornerKernel) makeGemmKernelVariant(&cornerClKernel, commandQueues[0], cornerKernelSource, sourceBuildOptions, &cornerKernelBinary, cornerKernelBinarySize, binaryBuildOptions, variant);
   const size_t localWorkSize[2] = { workGroupNumRows, workGroupNumCols };
+  // the kernels write disjoint parts of C and only wait for the caller's
+  // wait list, so they may run concurrently on an out-of-order queue
+  cl_event kernelEvents[numGemmKernels];
   unsigned int numKernelsEnqueued = 0;
 
 /******************************************************************************
  * Gather kernel arguments
  *****************************************************************************/
-  gemmKernelArgs[ 0] = &A;     gemmKernelArgSizes[ 0] = sizeof(cl_mem);
-  gemmKernelArgs[ 1] = &B;     gemmKernelArgSizes[ 1] = sizeof(cl_mem);
-  gemmKernelArgs[ 2] = &C;     gemmKernelArgSizes[ 2] = sizeof(cl_mem);
+  bool svmMemArgs = setGemmMemArg(0, A);
+  setGemmMemArg(1, B);
+  setGemmMemArg(2, C);
   gemmKernelArgs[ 3] = &alpha; gemmKernelArgSizes[ 3] = sizeof(Precision);
   gemmKernelArgs[ 4] = &beta;  gemmKernelArgSizes[ 4] = sizeof(Precision);
   gemmKernelArgs[ 5] = &M;     gemmKernelArgSizes[ 5] = sizeof(cl_uint);
@@ -595,6 +1178,36 @@ clblasGemm(
   gemmKernelArgs[11] = &offA;  gemmKernelArgSizes[11] = sizeof(cl_uint);
   gemmKernelArgs[12] = &offB;  gemmKernelArgSizes[12] = sizeof(cl_uint);
   gemmKernelArgs[13] = &offC;  gemmKernelArgSizes[13] = sizeof(cl_uint);
+  if (index64) {
+    gemmKernelArgs[11] = &offA64; gemmKernelArgSizes[11] = sizeof(cl_ulong);
+    gemmKernelArgs[12] = &offB64; gemmKernelArgSizes[12] = sizeof(cl_ulong);
+    gemmKernelArgs[13] = &offC64; gemmKernelArgSizes[13] = sizeof(cl_ulong);
+  }
+  unsigned int numKernelArgs = numGemmKernelArgs;
+
+  cl_mem epilogueBias  = NULL;
+  cl_mem epilogueScale = NULL;
+  cl_uint offBias  = 0;
+  cl_uint offScale = 0;
+  Precision clampLow  = epilogueScalar<Precision>(epilogue ? epilogue->clampMin : 0);
+  Precision clampHigh = epilogueScalar<Precision>(epilogue ? epilogue->clampMax : 0);
+  if (epilogue != NULL) {
+    if (epilogue->biasMode != clblasEpilogueNone) {
+      epilogueBias = epilogue->bias;
+      offBias = static_cast<cl_uint>(epilogue->offBias);
+    }
+    if (epilogue->scaleMode != clblasEpilogueNone) {
+      epilogueScale = epilogue->scale;
+      offScale = static_cast<cl_uint>(epilogue->offScale);
+    }
+    gemmKernelArgs[14] = &epilogueBias;  gemmKernelArgSizes[14] = sizeof(cl_mem);
+    gemmKernelArgs[15] = &epilogueScale; gemmKernelArgSizes[15] = sizeof(cl_mem);
+    gemmKernelArgs[16] = &offBias;       gemmKernelArgSizes[16] = sizeof(cl_uint);
+    gemmKernelArgs[17] = &offScale;      gemmKernelArgSizes[17] = sizeof(cl_uint);
+    gemmKernelArgs[18] = &clampLow;      gemmKernelArgSizes[18] = sizeof(Precision);
+    gemmKernelArgs[19] = &clampHigh;     gemmKernelArgSizes[19] = sizeof(Precision);
+    numKernelArgs += numGemmEpilogueArgs;
+  }
 
 
 /******************************************************************************
@@ -604,76 +1217,130 @@ clblasGemm(
     //printf("enqueueing tile kernel\n");
     size_t globalWorkSize[2] = {(M/macroTileNumRows)*workGroupNumRows, (N/macroTileNumCols)*workGroupNumCols };
     err = enqueueGemmKernel( commandQueues[numKernelsEnqueued%numCommandQueues], tileClKernel,
-      gemmKernelArgs, gemmKernelArgSizes, numGemmKernelArgs,
+      gemmKernelArgs, gemmKernelArgSizes, numKernelArgs, svmMemArgs,
       globalWorkSize, localWorkSize,
       numEventsInWaitList, eventWaitList,
-      &events[numKernelsEnqueued%numCommandQueues] );
-	returnIfErr(err);
-    numKernelsEnqueued++;
+      (events != NULL) ? &kernelEvents[numKernelsEnqueued] : NULL );
+    if (err == CL_SUCCESS) {
+      numKernelsEnqueued++;
+    }
   }
 
 /******************************************************************************
  * Enqueue Row kernel
  *****************************************************************************/
-  if (needRowKernel) {
+  if (err == CL_SUCCESS && needRowKernel) {
     //printf("enqueueing row kernel\n");
     size_t globalWorkSize[2] = {1*workGroupNumRows, (N/macroTileNumCols)*workGroupNumCols };
     err = enqueueGemmKernel( commandQueues[numKernelsEnqueued%numCommandQueues], rowClKernel,
-      gemmKernelArgs, gemmKernelArgSizes, numGemmKernelArgs,
+      gemmKernelArgs, gemmKernelArgSizes, numKernelArgs, svmMemArgs,
       globalWorkSize, localWorkSize,
       numEventsInWaitList, eventWaitList,
-      &events[numKernelsEnqueued%numCommandQueues] );
-	returnIfErr(err);
-    numKernelsEnqueued++;
+      (events != NULL) ? &kernelEvents[numKernelsEnqueued] : NULL );
+    if (err == CL_SUCCESS) {
+      numKernelsEnqueued++;
+    }
   }
 
 /******************************************************************************
  * Enqueue Col kernel
  *****************************************************************************/
-  if (needColKernel) {
+  if (err == CL_SUCCESS && needColKernel) {
     //printf("enqueueing col kernel\n");
     size_t globalWorkSize[2] = { (M/macroTileNumRows)*workGroupNumRows, 1*workGroupNumCols };
     err = enqueueGemmKernel( commandQueues[numKernelsEnqueued%numCommandQueues], colClKernel,
-      gemmKernelArgs, gemmKernelArgSizes, numGemmKernelArgs,
+      gemmKernelArgs, gemmKernelArgSizes, numKernelArgs, svmMemArgs,
       globalWorkSize, localWorkSize,
       numEventsInWaitList, eventWaitList,
-      &events[numKernelsEnqueued%numCommandQueues] );
-	returnIfErr(err);
-    numKernelsEnqueued++;
+      (events != NULL) ? &kernelEvents[numKernelsEnqueued] : NULL );
+    if (err == CL_SUCCESS) {
+      numKernelsEnqueued++;
+    }
   }
 
 /******************************************************************************
  * Enqueue Corner kernel
  *****************************************************************************/
-  if (needCornerKernel) {
+  if (err == CL_SUCCESS && needCornerKernel) {
     //printf("enqueueing corner kernel\n");
     size_t globalWorkSize[2] = { 1*workGroupNumRows, 1*workGroupNumCols };
     err = enqueueGemmKernel( commandQueues[numKernelsEnqueued%numCommandQueues], cornerClKernel,
-      gemmKernelArgs, gemmKernelArgSizes, numGemmKernelArgs,
+      gemmKernelArgs, gemmKernelArgSizes, numKernelArgs, svmMemArgs,
       globalWorkSize, localWorkSize,
       numEventsInWaitList, eventWaitList,
-      &events[numKernelsEnqueued%numCommandQueues] );
-	returnIfErr(err);
-    numKernelsEnqueued++;
+      (events != NULL) ? &kernelEvents[numKernelsEnqueued] : NULL );
+    if (err == CL_SUCCESS) {
+      numKernelsEnqueued++;
+    }
   }
 
-  return clblasSuccess;
-}
-
-
 /******************************************************************************
- * SGEMM API call
+ * Join the kernels of every queue into its event
  *****************************************************************************/
-extern "C"
+  if (events != NULL) {
+    for (cl_uint q = 0; q < numCommandQueues && q < numKernelsEnqueued; q++) {
+      cl_event queueEvents[numGemmKernels];
+      cl_uint n = 0;
+
+      for (unsigned int i = q; i < numKernelsEnqueued; i += numCommandQueues) {
+        queueEvents[n++] = kernelEvents[i];
+      }
+      cl_int joinErr = joinGemmEvents(commandQueues[q], n, queueEvents,
+        (err == CL_SUCCESS) ? &events[q] : NULL);
+      if (err == CL_SUCCESS) {
+        err = joinErr;
+      }
+    }
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+template<typename Precision, typename Mem>
 clblasStatus
-clblasSgemm(
+clblasGemm(
     clblasOrder order,
     clblasTranspose transA,
     clblasTranspose transB,
-    size_t M, size_t N, size_t K,
-    cl_float alpha,
-    const cl_mem A, size_t offA, size_t lda,
-    const cl_mem B, size_t offB, size_t ldb,
+    size_t iM, size_t iN, size_t iK,
+    Precision alpha,
+    const Mem iA, size_t iOffA, size_t iLda,
+    const Mem iB, size_t iOffB, size_t iLdb,
+    Precision beta,
+    Mem C, size_t iOffC,  size_t iLdc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    const clblasEpilogue *epilogue = NULL,
+    const GemmHalfKernels *halfKernels = NULL)
+{
+  statisticsEnter(CLBLAS_GEMM, (halfKernels != NULL) ? TYPE_HALF :
+                                                       gemmDataType<Precision>());
+  clblasStatus status = doGemm(order, transA, transB, iM, iN, iK,
+      alpha, iA, iOffA, iLda, iB, iOffB, iLdb, beta, C, iOffC, iLdc,
+      numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList,
+      events, epilogue, halfKernels);
+  statisticsLeave();
+
+  return status;
+}
+
+
+/******************************************************************************
+ * SGEMM API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasSgemm(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_float alpha,
+    const cl_mem A, size_t offA, size_t lda,
+    const cl_mem B, size_t offB, size_t ldb,
     cl_float beta,
     cl_mem C, size_t offC,  size_t ldc,
     cl_uint numCommandQueues,
@@ -782,6 +1449,351 @@ clblasDgemm( clblasOrder order,
        events);
 }
 
+/******************************************************************************
+ * Validate the epilogue of SGEMMEX and DGEMMEX; rows and columns are those
+ * of C as seen by the caller
+ *****************************************************************************/
+static clblasStatus
+checkGemmEpilogue(
+    DataType dtype,
+    size_t M, size_t N,
+    const clblasEpilogue *epilogue)
+{
+  clblasStatus clblasErr;
+
+  if (epilogue->biasMode > clblasEpiloguePerColumn ||
+      epilogue->scaleMode > clblasEpiloguePerColumn ||
+      epilogue->activation > clblasActivationGELU) {
+    return clblasInvalidValue;
+  }
+  if (epilogue->clamp && epilogue->clampMin > epilogue->clampMax) {
+    return clblasInvalidValue;
+  }
+
+  if (epilogue->biasMode != clblasEpilogueNone) {
+    clblasErr = checkVectorSizes(dtype,
+        (epilogue->biasMode == clblasEpiloguePerRow) ? M : N,
+        epilogue->bias, epilogue->offBias, 1, X_VEC_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  if (epilogue->scaleMode != clblasEpilogueNone) {
+    clblasErr = checkVectorSizes(dtype,
+        (epilogue->scaleMode == clblasEpiloguePerRow) ? M : N,
+        epilogue->scale, epilogue->offScale, 1, Y_VEC_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+
+  return clblasSuccess;
+}
+
+/******************************************************************************
+ * SGEMM with fused epilogue API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasSgemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_float alpha,
+    const cl_mem A, size_t offA, size_t lda,
+    const cl_mem B, size_t offB, size_t ldb,
+    cl_float beta,
+    cl_mem C, size_t offC,  size_t ldc,
+    const clblasEpilogue *epilogue,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  if (epilogue == NULL) {
+    return clblasSgemm(order, transA, transB, M, N, K,
+        alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+        numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events);
+  }
+
+  // check if memory objects are valid
+  clblasStatus clblasErr = clblasSuccess;
+  clblasErr = checkMemObjects(A, B, C, true, A_MAT_ERRSET, B_MAT_ERRSET, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  if (K != 0)
+  {
+    //check matrix A
+    clblasErr = checkMatrixSizes(TYPE_FLOAT, order, transA, M, K, A, offA, lda, A_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+
+    //check matrix B
+    clblasErr = checkMatrixSizes(TYPE_FLOAT, order, transB, K, N, B, offB, ldb, B_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  //check matrix C
+  clblasErr = checkMatrixSizes(TYPE_FLOAT, order, clblasNoTrans, M, N, C, offC, ldc, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  clblasErr = checkGemmEpilogue(TYPE_FLOAT, M, N, epilogue);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  return clblasGemm(
+      order,
+      transA,
+      transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      epilogue);
+}
+
+/******************************************************************************
+ * DGEMM with fused epilogue API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasDgemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_double alpha,
+    const cl_mem A, size_t offA, size_t lda,
+    const cl_mem B, size_t offB, size_t ldb,
+    cl_double beta,
+    cl_mem C, size_t offC,  size_t ldc,
+    const clblasEpilogue *epilogue,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  if (epilogue == NULL) {
+    return clblasDgemm(order, transA, transB, M, N, K,
+        alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+        numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events);
+  }
+
+  // check if memory objects are valid
+  clblasStatus clblasErr = clblasSuccess;
+  clblasErr = checkMemObjects(A, B, C, true, A_MAT_ERRSET, B_MAT_ERRSET, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  if (K != 0)
+  {
+    //check matrix A
+    clblasErr = checkMatrixSizes(TYPE_DOUBLE, order, transA, M, K, A, offA, lda, A_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+
+    //check matrix B
+    clblasErr = checkMatrixSizes(TYPE_DOUBLE, order, transB, K, N, B, offB, ldb, B_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  //check matrix C
+  clblasErr = checkMatrixSizes(TYPE_DOUBLE, order, clblasNoTrans, M, N, C, offC, ldc, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  clblasErr = checkGemmEpilogue(TYPE_DOUBLE, M, N, epilogue);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  return clblasGemm(
+      order,
+      transA,
+      transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      epilogue);
+}
+
+/******************************************************************************
+ * HGEMM API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasHgemm(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_float alpha,
+    const cl_mem A, size_t offA, size_t lda,
+    const cl_mem B, size_t offB, size_t ldb,
+    cl_float beta,
+    cl_mem C, size_t offC,  size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  // check if memory objects are valid
+  clblasStatus clblasErr = clblasSuccess;
+  clblasErr = checkMemObjects(A, B, C, true, A_MAT_ERRSET, B_MAT_ERRSET, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  if (K != 0)
+  {
+    //check matrix A
+    clblasErr = checkMatrixSizes(TYPE_HALF, order, transA, M, K, A, offA, lda, A_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+
+    //check matrix B
+    clblasErr = checkMatrixSizes(TYPE_HALF, order, transB, K, N, B, offB, ldb, B_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  //check matrix C
+  clblasErr = checkMatrixSizes(TYPE_HALF, order, clblasNoTrans, M, N, C, offC, ldc, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  GemmHalfKernels halfKernels;
+  halfKernels.selectKernel = hgemmSelectKernel;
+  halfKernels.halfArithmetic = deviceHalfArithmetic(commandQueues[0]);
+
+  return clblasGemm(
+      order,
+      transA,
+      transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      NULL,
+      &halfKernels);
+}
+
+/******************************************************************************
+ * GEMM with separate element types API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasGemmEx(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_float alpha,
+    const cl_mem A, size_t offA, size_t lda,
+    const cl_mem B, size_t offB, size_t ldb,
+    cl_float beta,
+    cl_mem C, size_t offC,  size_t ldc,
+    clblasDataType typeAB,
+    clblasDataType typeC,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  if ((typeAB != clblasDataHalf && typeAB != clblasDataFloat) ||
+      (typeC != clblasDataHalf && typeC != clblasDataFloat)) {
+    return clblasInvalidValue;
+  }
+
+  if (typeAB == clblasDataFloat && typeC == clblasDataFloat) {
+    return clblasSgemm(order, transA, transB, M, N, K,
+        alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+        numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events);
+  }
+  if (typeAB == clblasDataHalf && typeC == clblasDataHalf) {
+    return clblasHgemm(order, transA, transB, M, N, K,
+        alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+        numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events);
+  }
+  if (typeAB != clblasDataHalf || typeC != clblasDataFloat) {
+    return clblasNotImplemented;
+  }
+
+  // check if memory objects are valid
+  clblasStatus clblasErr = clblasSuccess;
+  clblasErr = checkMemObjects(A, B, C, true, A_MAT_ERRSET, B_MAT_ERRSET, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  if (K != 0)
+  {
+    //check matrix A
+    clblasErr = checkMatrixSizes(TYPE_HALF, order, transA, M, K, A, offA, lda, A_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+
+    //check matrix B
+    clblasErr = checkMatrixSizes(TYPE_HALF, order, transB, K, N, B, offB, ldb, B_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  //check matrix C
+  clblasErr = checkMatrixSizes(TYPE_FLOAT, order, clblasNoTrans, M, N, C, offC, ldc, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  // products of halves are accumulated in float
+  GemmHalfKernels halfKernels;
+  halfKernels.selectKernel = hsgemmSelectKernel;
+  halfKernels.halfArithmetic = false;
+
+  return clblasGemm(
+      order,
+      transA,
+      transB,
+      M, N, K,
+      alpha,
+      A, offA, lda,
+      B, offB, ldb,
+      beta,
+      C, offC, ldc,
+      numCommandQueues,
+      commandQueues,
+      numEventsInWaitList,
+      eventWaitList,
+      events,
+      NULL,
+      &halfKernels);
+}
+
 /******************************************************************************
  * CGEMM API call
  *****************************************************************************/
@@ -903,3 +1915,198 @@ clblasZgemm(
        eventWaitList,
        events);
 }
+
+/******************************************************************************
+ * GEMM API calls with 64-bit sizes
+ *****************************************************************************/
+// the 64-bit arguments must be representable in size_t on 32-bit hosts
+static bool
+gemmArgsFitSizeT(
+    cl_ulong M, cl_ulong N, cl_ulong K,
+    cl_ulong offA, cl_ulong lda,
+    cl_ulong offB, cl_ulong ldb,
+    cl_ulong offC, cl_ulong ldc)
+{
+  const cl_ulong args[] = { M, N, K, offA, lda, offB, ldb, offC, ldc };
+
+  for (size_t i = 0; i < sizeof(args) / sizeof(args[0]); i++) {
+    if (static_cast<cl_ulong>(static_cast<size_t>(args[i])) != args[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#define GEMM_64_API(NAME, TYPE, GEMM)                                         \
+extern "C"                                                                    \
+clblasStatus                                                                  \
+NAME(                                                                         \
+    clblasOrder order,                                                        \
+    clblasTranspose transA,                                                   \
+    clblasTranspose transB,                                                   \
+    cl_ulong M, cl_ulong N, cl_ulong K,                                       \
+    TYPE alpha,                                                               \
+    const cl_mem A, cl_ulong offA, cl_ulong lda,                              \
+    const cl_mem B, cl_ulong offB, cl_ulong ldb,                              \
+    TYPE beta,                                                                \
+    cl_mem C, cl_ulong offC, cl_ulong ldc,                                    \
+    cl_uint numCommandQueues,                                                 \
+    cl_command_queue *commandQueues,                                          \
+    cl_uint numEventsInWaitList,                                              \
+    const cl_event *eventWaitList,                                            \
+    cl_event *events)                                                         \
+{                                                                             \
+  if (!gemmArgsFitSizeT(M, N, K, offA, lda, offB, ldb, offC, ldc)) {          \
+    return clblasInvalidValue;                                                \
+  }                                                                           \
+  return GEMM(order, transA, transB,                                          \
+      static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),\
+      alpha,                                                                  \
+      A, static_cast<size_t>(offA), static_cast<size_t>(lda),                 \
+      B, static_cast<size_t>(offB), static_cast<size_t>(ldb),                 \
+      beta,                                                                   \
+      C, static_cast<size_t>(offC), static_cast<size_t>(ldc),                 \
+      numCommandQueues, commandQueues,                                        \
+      numEventsInWaitList, eventWaitList, events);                            \
+}
+
+GEMM_64_API(clblasSgemm_64, cl_float, clblasSgemm)
+GEMM_64_API(clblasDgemm_64, cl_double, clblasDgemm)
+GEMM_64_API(clblasCgemm_64, FloatComplex, clblasCgemm)
+GEMM_64_API(clblasZgemm_64, DoubleComplex, clblasZgemm)
+
+/******************************************************************************
+ * templated Gemm on SVM pointers
+ *****************************************************************************/
+template<typename Precision>
+clblasStatus
+clblasGemmSVM(
+    DataType dtype,
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    Precision alpha,
+    const void *A, size_t offA, size_t lda,
+    const void *B, size_t offB, size_t ldb,
+    Precision beta,
+    void *C, size_t offC, size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+#if !defined(CL_VERSION_2_0)
+  return clblasNotImplemented;
+#endif
+  clblasStatus clblasErr = clblasSuccess;
+
+  if (K != 0)
+  {
+    clblasErr = checkSVMMatrixSizes(dtype, order, transA, M, K, A, lda, A_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+
+    clblasErr = checkSVMMatrixSizes(dtype, order, transB, K, N, B, ldb, B_MAT_ERRSET);
+    if (clblasErr != clblasSuccess)
+      return clblasErr;
+  }
+  clblasErr = checkSVMMatrixSizes(dtype, order, clblasNoTrans, M, N, C, ldc, C_MAT_ERRSET);
+  if (clblasErr != clblasSuccess)
+    return clblasErr;
+
+  return clblasGemm(
+       order,
+       transA,
+       transB,
+       M, N, K,
+       alpha,
+       const_cast<void*>(A), offA, lda,
+       const_cast<void*>(B), offB, ldb,
+       beta,
+       C, offC, ldc,
+       numCommandQueues,
+       commandQueues,
+       numEventsInWaitList,
+       eventWaitList,
+       events);
+}
+
+/******************************************************************************
+ * SGEMM SVM API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasSgemmSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_float alpha,
+    const void *A, size_t offA, size_t lda,
+    const void *B, size_t offB, size_t ldb,
+    cl_float beta,
+    void *C, size_t offC, size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  return clblasGemmSVM(
+       TYPE_FLOAT,
+       order,
+       transA,
+       transB,
+       M, N, K,
+       alpha,
+       A, offA, lda,
+       B, offB, ldb,
+       beta,
+       C, offC, ldc,
+       numCommandQueues,
+       commandQueues,
+       numEventsInWaitList,
+       eventWaitList,
+       events);
+}
+
+/******************************************************************************
+ * DGEMM SVM API call
+ *****************************************************************************/
+extern "C"
+clblasStatus
+clblasDgemmSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    cl_double alpha,
+    const void *A, size_t offA, size_t lda,
+    const void *B, size_t offB, size_t ldb,
+    cl_double beta,
+    void *C, size_t offC, size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+  return clblasGemmSVM(
+       TYPE_DOUBLE,
+       order,
+       transA,
+       transB,
+       M, N, K,
+       alpha,
+       A, offA, lda,
+       B, offB, ldb,
+       beta,
+       C, offC, ldc,
+       numCommandQueues,
+       commandQueues,
+       numEventsInWaitList,
+       eventWaitList,
+       events);
+}
@@ -0,0 +1,469 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Out-of-core GEMM on matrices in host memory.
+ *
+ * C is computed by blocks. For every block, panels of op(A) and op(B) along
+ * K are written to the device with clblasWriteSubMatrixAsync and multiplied
+ * into the block by the regular device GEMM; the block is then read back
+ * with clblasReadSubMatrixAsync. Panels and blocks are double buffered, and
+ * with a second command queue the transfers run on it while the first one
+ * computes, so the next panel is written and the previous block read while
+ * a panel is multiplied.
+ *
+ * The device memory used is bounded by AMD_CLBLAS_GEMM_OOC_MB, half of the
+ * global memory of the device by default; no single buffer exceeds
+ * CL_DEVICE_MAX_MEM_ALLOC_SIZE.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <clBLAS.h>
+
+#include "workspace_pool.h"
+#include "statistics.h"
+#include "path_table.h"
+
+#define OOC_TILE_ALIGN 64
+#define OOC_MIN_TILE   16
+
+/******************************************************************************
+ * Scalars and device GEMM per precision
+ *****************************************************************************/
+static bool oocIsZero(cl_float v)  { return v == 0; }
+static bool oocIsZero(cl_double v) { return v == 0; }
+static bool oocIsZero(FloatComplex v)  { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool oocIsZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+template<typename T>
+static T
+oocOne(void)
+{
+  return T(1);
+}
+
+template<>
+FloatComplex
+oocOne<FloatComplex>(void)
+{
+  FloatComplex one;
+  CREAL(one) = 1;
+  CIMAG(one) = 0;
+  return one;
+}
+
+template<>
+DoubleComplex
+oocOne<DoubleComplex>(void)
+{
+  DoubleComplex one;
+  CREAL(one) = 1;
+  CIMAG(one) = 0;
+  return one;
+}
+
+#define OOC_DEVICE_GEMM(TYPE, GEMM)                                           \
+static clblasStatus                                                           \
+deviceGemm(                                                                   \
+    clblasTranspose transA, clblasTranspose transB,                           \
+    size_t M, size_t N, size_t K,                                             \
+    TYPE alpha, cl_mem A, size_t lda, cl_mem B, size_t ldb,                   \
+    TYPE beta, cl_mem C, size_t ldc,                                          \
+    cl_command_queue queue,                                                   \
+    cl_uint numEventsInWaitList, const cl_event *eventWaitList,               \
+    cl_event *event)                                                          \
+{                                                                             \
+  PathInternalScope internal;                                                 \
+                                                                              \
+  return GEMM(clblasColumnMajor, transA, transB, M, N, K,                     \
+      alpha, A, 0, lda, B, 0, ldb, beta, C, 0, ldc,                           \
+      1, &queue, numEventsInWaitList, eventWaitList, event);                  \
+}
+
+OOC_DEVICE_GEMM(cl_float, clblasSgemm)
+OOC_DEVICE_GEMM(cl_double, clblasDgemm)
+OOC_DEVICE_GEMM(FloatComplex, clblasCgemm)
+OOC_DEVICE_GEMM(DoubleComplex, clblasZgemm)
+
+/******************************************************************************
+ * Tile size: a K panel of up to 'kb' and C blocks of up to 'tile' x 'tile'
+ * so that two A panels, two B panels and two C blocks fit in the budget
+ *****************************************************************************/
+static void
+oocTileSizes(
+    cl_device_id device,
+    size_t elemSize,
+    size_t M, size_t N, size_t K,
+    size_t *mb, size_t *nb, size_t *kb)
+{
+  cl_ulong globalMem = 0;
+  cl_ulong maxAlloc = 0;
+  const char *env = getenv("AMD_CLBLAS_GEMM_OOC_MB");
+
+  clGetDeviceInfo(device, CL_DEVICE_GLOBAL_MEM_SIZE, sizeof(globalMem),
+                  &globalMem, NULL);
+  clGetDeviceInfo(device, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(maxAlloc),
+                  &maxAlloc, NULL);
+
+  double budget = (env != NULL && atoi(env) > 0)
+      ? (double)atoi(env) * 1024 * 1024
+      : (double)globalMem / 2;
+  double maxElems = (double)maxAlloc / elemSize;
+  double elems = budget / (2 * elemSize);
+
+  // a square tile first bounds the panel depth
+  double tile = sqrt(elems / 3);
+  double depth = std::max(std::min((double)K, tile), 1.0);
+
+  // then the blocks of C take what the panels leave:
+  // tile^2 + 2*depth*tile <= elems
+  tile = sqrt(depth * depth + elems) - depth;
+  tile = std::min(tile, sqrt(maxElems));
+  tile = std::min(tile, maxElems / depth);
+
+  size_t t = (size_t)tile;
+  if (t >= OOC_TILE_ALIGN) {
+    t -= t % OOC_TILE_ALIGN;
+  }
+  t = std::max(t, (size_t)OOC_MIN_TILE);
+
+  *mb = std::min(M, t);
+  *nb = std::min(N, t);
+  // panels are allocated even if K is zero, for the call scaling C
+  *kb = std::max(std::min(K, std::max((size_t)depth, (size_t)OOC_MIN_TILE)),
+                 (size_t)1);
+}
+
+/******************************************************************************
+ * Stored position and extent of a block of op(X): 'rows' x 'cols' of op(X)
+ * starting at ('row', 'col')
+ *****************************************************************************/
+struct OocBlock
+{
+  size_t x, y;   // stored row and column of the first element
+  size_t nx, ny; // stored rows and columns
+
+  OocBlock(clblasTranspose trans, size_t row, size_t col,
+           size_t rows, size_t cols)
+  {
+    if (trans == clblasNoTrans) {
+      x = row; y = col; nx = rows; ny = cols;
+    }
+    else {
+      x = col; y = row; nx = cols; ny = rows;
+    }
+  }
+};
+
+static void
+oocReleaseEvent(cl_event *event)
+{
+  if (*event != NULL) {
+    clReleaseEvent(*event);
+    *event = NULL;
+  }
+}
+
+/******************************************************************************
+ * templated out-of-core Gemm; column major
+ *****************************************************************************/
+template<typename T>
+static clblasStatus
+gemmOutOfCore(
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    T alpha,
+    const T *A, size_t lda,
+    const T *B, size_t ldb,
+    T beta,
+    T *C, size_t ldc,
+    cl_command_queue compute,
+    cl_command_queue transfer)
+{
+  const size_t elemSize = sizeof(T);
+  const bool betaZero = oocIsZero(beta);
+  // stored columns of the host matrices
+  const size_t colsA = (transA == clblasNoTrans) ? K : M;
+  const size_t colsB = (transB == clblasNoTrans) ? N : K;
+  cl_context context;
+  cl_device_id device;
+  cl_int err;
+
+  err = clGetCommandQueueInfo(compute, CL_QUEUE_CONTEXT, sizeof(context),
+                              &context, NULL);
+  if (err == CL_SUCCESS) {
+    err = clGetCommandQueueInfo(compute, CL_QUEUE_DEVICE, sizeof(device),
+                                &device, NULL);
+  }
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  size_t mb, nb, kb;
+  oocTileSizes(device, elemSize, M, N, K, &mb, &nb, &kb);
+
+  cl_mem panelA[2] = { NULL, NULL };
+  cl_mem panelB[2] = { NULL, NULL };
+  cl_mem blockC[2] = { NULL, NULL };
+  for (int i = 0; i < 2 && err == CL_SUCCESS; i++) {
+    panelA[i] = acquireWorkspace(context, mb * kb * elemSize, &err);
+    if (err == CL_SUCCESS) {
+      panelB[i] = acquireWorkspace(context, kb * nb * elemSize, &err);
+    }
+    if (err == CL_SUCCESS) {
+      blockC[i] = acquireWorkspace(context, mb * nb * elemSize, &err);
+    }
+  }
+
+  // last multiply using each panel slot and last read of each block of C
+  cl_event panelDone[2] = { NULL, NULL };
+  cl_event blockRead[2] = { NULL, NULL };
+  unsigned int panel = 0;
+  unsigned int block = 0;
+
+  for (size_t j0 = 0; j0 < N && err == CL_SUCCESS; j0 += nb) {
+    size_t n = std::min(nb, N - j0);
+
+    for (size_t i0 = 0; i0 < M && err == CL_SUCCESS; i0 += mb, block++) {
+      size_t m = std::min(mb, M - i0);
+      unsigned int c = block % 2;
+      cl_event blockReady = NULL;
+      cl_event prev = NULL;
+
+      // the block buffer is free once its previous contents are read back
+      if (!betaZero) {
+        err = clblasWriteSubMatrixAsync(clblasColumnMajor, elemSize,
+            C, 0, ldc, ldc, N, i0, j0,
+            blockC[c], 0, m, m, n, 0, 0, m, n,
+            transfer, (blockRead[c] != NULL) ? 1 : 0,
+            (blockRead[c] != NULL) ? &blockRead[c] : NULL, &blockReady);
+      }
+
+      for (size_t k0 = 0; k0 < K && err == CL_SUCCESS; k0 += kb, panel++) {
+        size_t k = std::min(kb, K - k0);
+        unsigned int s = panel % 2;
+        OocBlock a(transA, i0, k0, m, k);
+        OocBlock b(transB, k0, j0, k, n);
+        cl_event written[2] = { NULL, NULL };
+
+        // panel slots are rewritten once the multiply reading them is done
+        cl_uint numWaits = (panelDone[s] != NULL) ? 1 : 0;
+        const cl_event *waits = (panelDone[s] != NULL) ? &panelDone[s] : NULL;
+
+        err = clblasWriteSubMatrixAsync(clblasColumnMajor, elemSize,
+            A, 0, lda, lda, colsA, a.x, a.y,
+            panelA[s], 0, a.nx, a.nx, a.ny, 0, 0, a.nx, a.ny,
+            transfer, numWaits, waits, &written[0]);
+        if (err == CL_SUCCESS) {
+          err = clblasWriteSubMatrixAsync(clblasColumnMajor, elemSize,
+              B, 0, ldb, ldb, colsB, b.x, b.y,
+              panelB[s], 0, b.nx, b.nx, b.ny, 0, 0, b.nx, b.ny,
+              transfer, numWaits, waits, &written[1]);
+        }
+        if (err != CL_SUCCESS) {
+          oocReleaseEvent(&written[0]);
+          break;
+        }
+
+        // the first panel scales C, or overwrites it if beta is zero, once
+        // the block buffer is written or free; later ones accumulate
+        cl_event gemmWaits[3] = { written[0], written[1], NULL };
+        cl_uint numGemmWaits = 2;
+        if (k0 == 0) {
+          gemmWaits[2] = betaZero ? blockRead[c] : blockReady;
+        }
+        else {
+          gemmWaits[2] = prev;
+        }
+        if (gemmWaits[2] != NULL) {
+          numGemmWaits++;
+        }
+
+        oocReleaseEvent(&panelDone[s]);
+        err = deviceGemm(transA, transB, m, n, k,
+            alpha, panelA[s], a.nx, panelB[s], b.nx,
+            (k0 == 0) ? beta : oocOne<T>(), blockC[c], m,
+            compute, numGemmWaits, gemmWaits, &panelDone[s]);
+        oocReleaseEvent(&written[0]);
+        oocReleaseEvent(&written[1]);
+        oocReleaseEvent(&prev);
+        if (err == CL_SUCCESS) {
+          clRetainEvent(panelDone[s]);
+          prev = panelDone[s];
+        }
+      }
+
+      if (err == CL_SUCCESS && K == 0) {
+        // C = beta * C; no panel was multiplied
+        cl_event wait = betaZero ? blockRead[c] : blockReady;
+
+        err = deviceGemm(transA, transB, m, n, 0,
+            alpha, panelA[0], 1, panelB[0], 1, beta, blockC[c], m,
+            compute, (wait != NULL) ? 1 : 0, (wait != NULL) ? &wait : NULL,
+            &prev);
+      }
+      oocReleaseEvent(&blockReady);
+
+      if (err == CL_SUCCESS) {
+        oocReleaseEvent(&blockRead[c]);
+        err = clblasReadSubMatrixAsync(clblasColumnMajor, elemSize,
+            blockC[c], 0, m, m, n, 0, 0,
+            C, 0, ldc, ldc, N, i0, j0, m, n,
+            transfer, 1, &prev, &blockRead[c]);
+      }
+      oocReleaseEvent(&prev);
+    }
+  }
+
+  // the host matrices must not be touched after returning, whatever failed
+  if (err == CL_SUCCESS) {
+    cl_event last[2];
+    cl_uint numLast = 0;
+
+    for (int i = 0; i < 2; i++) {
+      if (blockRead[i] != NULL) {
+        last[numLast++] = blockRead[i];
+      }
+    }
+    if (numLast > 0) {
+      err = clWaitForEvents(numLast, last);
+    }
+  }
+  else {
+    clFinish(compute);
+    clFinish(transfer);
+  }
+
+  for (int i = 0; i < 2; i++) {
+    oocReleaseEvent(&panelDone[i]);
+    oocReleaseEvent(&blockRead[i]);
+    if (panelA[i] != NULL) releaseWorkspace(panelA[i], NULL);
+    if (panelB[i] != NULL) releaseWorkspace(panelB[i], NULL);
+    if (blockC[i] != NULL) releaseWorkspace(blockC[i], NULL);
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+/******************************************************************************
+ * Argument checks and row major -> column major
+ *****************************************************************************/
+template<typename T>
+static clblasStatus
+clblasGemmOutOfCore(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M, size_t N, size_t K,
+    T alpha,
+    const T *A, size_t lda,
+    const T *B, size_t ldb,
+    T beta,
+    T *C, size_t ldc,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList)
+{
+  if (numCommandQueues == 0 || commandQueues == NULL) {
+    return clblasInvalidValue;
+  }
+  if ((numEventsInWaitList == 0) != (eventWaitList == NULL)) {
+    return clblasInvalidEventWaitList;
+  }
+  if (M == 0 || N == 0) {
+    return clblasSuccess;
+  }
+  if (A == NULL && K != 0) {
+    return clblasInvalidMatA;
+  }
+  if (B == NULL && K != 0) {
+    return clblasInvalidMatB;
+  }
+  if (C == NULL) {
+    return clblasInvalidMatC;
+  }
+
+  // leading dimensions cover the contiguous dimension of each matrix
+  bool colMajor = (order == clblasColumnMajor);
+  if (K != 0 && lda < ((colMajor == (transA == clblasNoTrans)) ? M : K)) {
+    return clblasInvalidLeadDimA;
+  }
+  if (K != 0 && ldb < ((colMajor == (transB == clblasNoTrans)) ? K : N)) {
+    return clblasInvalidLeadDimB;
+  }
+  if (ldc < (colMajor ? M : N)) {
+    return clblasInvalidLeadDimC;
+  }
+
+  // the call blocks anyway, so wait for the events here
+  if (numEventsInWaitList > 0) {
+    cl_int err = clWaitForEvents(numEventsInWaitList, eventWaitList);
+    if (err != CL_SUCCESS) {
+      return static_cast<clblasStatus>(err);
+    }
+  }
+
+  if (!colMajor) {
+    std::swap(transA, transB);
+    std::swap(M, N);
+    std::swap(A, B);
+    std::swap(lda, ldb);
+  }
+
+  return gemmOutOfCore<T>(transA, transB, M, N, K,
+      alpha, A, lda, B, ldb, beta, C, ldc,
+      commandQueues[0],
+      (numCommandQueues > 1) ? commandQueues[1] : commandQueues[0]);
+}
+
+/******************************************************************************
+ * API calls
+ *****************************************************************************/
+#define GEMM_OUT_OF_CORE_API(NAME, TYPE, DTYPE)                               \
+extern "C"                                                                    \
+clblasStatus                                                                  \
+NAME(                                                                         \
+    clblasOrder order,                                                        \
+    clblasTranspose transA,                                                   \
+    clblasTranspose transB,                                                   \
+    size_t M, size_t N, size_t K,                                             \
+    TYPE alpha,                                                               \
+    const TYPE *A, size_t lda,                                                \
+    const TYPE *B, size_t ldb,                                                \
+    TYPE beta,                                                                \
+    TYPE *C, size_t ldc,                                                      \
+    cl_uint numCommandQueues,                                                 \
+    cl_command_queue *commandQueues,                                          \
+    cl_uint numEventsInWaitList,                                              \
+    const cl_event *eventWaitList)                                            \
+{                                                                             \
+  /* the GEMM calls on the tiles are accounted to this one */                 \
+  statisticsEnter(CLBLAS_GEMM, DTYPE);                                        \
+  clblasStatus status = clblasGemmOutOfCore<TYPE>(order, transA, transB,      \
+      M, N, K, alpha, A, lda, B, ldb, beta, C, ldc,                           \
+      numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList);   \
+  statisticsLeave();                                                          \
+  return status;                                                              \
+}
+
+GEMM_OUT_OF_CORE_API(clblasSgemmOutOfCore, cl_float, TYPE_FLOAT)
+GEMM_OUT_OF_CORE_API(clblasDgemmOutOfCore, cl_double, TYPE_DOUBLE)
+GEMM_OUT_OF_CORE_API(clblasCgemmOutOfCore, FloatComplex, TYPE_COMPLEX_FLOAT)
+GEMM_OUT_OF_CORE_API(clblasZgemmOutOfCore, DoubleComplex, TYPE_COMPLEX_DOUBLE)
@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "host_path.h"
 
 static clblasStatus
 doGemv(
@@ -55,20 +57,39 @@ doGemv(
 
     /* Validate arguments */
 
-    if ((retCode = checkMemObjects( A, x, y, true, A_MAT_ERRSET, X_VEC_ERRSET, Y_VEC_ERRSET ))) {
-        return retCode;
+    if (kargs->svm) {
+#if !defined(CL_VERSION_2_0)
+        return clblasNotImplemented;
+#endif
+        if ((retCode = checkSVMMatrixSizes(kargs->dtype, order, clblasNoTrans,
+                                           M, N, A, lda, A_MAT_ERRSET))) {
+            return retCode;
+        }
+        sizev = (transA == clblasNoTrans) ? N : M;
+        if ((retCode = checkSVMVectorSizes(sizev, x, incx, X_VEC_ERRSET))) {
+            return retCode;
+        }
+        sizev = (transA == clblasNoTrans) ? M : N;
+        if ((retCode = checkSVMVectorSizes(sizev, y, incy, Y_VEC_ERRSET))) {
+            return retCode;
+        }
     }
-    if ((retCode = checkMatrixSizes(kargs->dtype, order, clblasNoTrans,
-                                    M, N, A, offA, lda, A_MAT_ERRSET ))) {
-        return retCode;
-    }
-    sizev = (transA == clblasNoTrans) ? N : M;
-    if ((retCode = checkVectorSizes(kargs->dtype, sizev, x, offx, incx, X_VEC_ERRSET ))) {
-        return retCode;
-    }
-    sizev = (transA == clblasNoTrans) ? M : N;
-    if ((retCode = checkVectorSizes(kargs->dtype, sizev, y, offy, incy, Y_VEC_ERRSET))) {
-        return retCode;
+    else {
+        if ((retCode = checkMemObjects( A, x, y, true, A_MAT_ERRSET, X_VEC_ERRSET, Y_VEC_ERRSET ))) {
+            return retCode;
+        }
+        if ((retCode = checkMatrixSizes(kargs->dtype, order, clblasNoTrans,
+                                        M, N, A, offA, lda, A_MAT_ERRSET ))) {
+            return retCode;
+        }
+        sizev = (transA == clblasNoTrans) ? N : M;
+        if ((retCode = checkVectorSizes(kargs->dtype, sizev, x, offx, incx, X_VEC_ERRSET ))) {
+            return retCode;
+        }
+        sizev = (transA == clblasNoTrans) ? M : N;
+        if ((retCode = checkVectorSizes(kargs->dtype, sizev, y, offy, incy, Y_VEC_ERRSET))) {
+            return retCode;
+        }
     }
 
     kargs->order = order;
@@ -90,6 +111,17 @@ doGemv(
     kargs->offCY = offy;
     kargs->ldc.Vector = incy;
 
+    statisticsEnter(CLBLAS_GEMV, kargs->dtype);
+
+    if (isHostPathSuitable(CLBLAS_GEMV, kargs, numCommandQueues,
+                           commandQueues)) {
+        retCode = executeOnHost(CLBLAS_GEMV, kargs, commandQueues[0],
+                                numEventsInWaitList, eventWaitList, events);
+
+        statisticsLeave();
+        return retCode;
+    }
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_GEMV, kargs, numCommandQueues, commandQueues,
         numEventsInWaitList, eventWaitList, events, &seq);
@@ -99,6 +131,7 @@ doGemv(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -241,3 +274,77 @@ clblasZgemv(
                   y, offy, incy, numCommandQueues, commandQueues,
                   numEventsInWaitList, eventWaitList, events);
 }
+
+clblasStatus
+clblasSgemvSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    cl_float alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *x,
+    size_t offx,
+    int incx,
+    cl_float beta,
+    void *y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_FLOAT;
+    kargs.alpha.argFloat = alpha;
+    kargs.beta.argFloat = beta;
+    kargs.svm = true;
+
+    return doGemv(&kargs, order, transA, M, N, (cl_mem)A, offA, lda,
+                  (cl_mem)x, offx, incx, (cl_mem)y, offy, incy,
+                  numCommandQueues, commandQueues,
+                  numEventsInWaitList, eventWaitList, events);
+}
+
+clblasStatus
+clblasDgemvSVM(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    cl_double alpha,
+    const void *A,
+    size_t offA,
+    size_t lda,
+    const void *x,
+    size_t offx,
+    int incx,
+    cl_double beta,
+    void *y,
+    size_t offy,
+    int incy,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events)
+{
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_DOUBLE;
+    kargs.alpha.argDouble = alpha;
+    kargs.beta.argDouble = beta;
+    kargs.svm = true;
+
+    return doGemv(&kargs, order, transA, M, N, (cl_mem)A, offA, lda,
+                  (cl_mem)x, offx, incx, (cl_mem)y, offy, incy,
+                  numCommandQueues, commandQueues,
+                  numEventsInWaitList, eventWaitList, events);
+}
@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -135,6 +136,8 @@ doGer(
 		printf("Calling makeSolutionSeq from DoGer: GER\n");
 		#endif
 
+		statisticsEnter(CLBLAS_GER, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_GER, kargs, numCommandQueues, commandQueues,
         					  numEventsInWaitList, eventWaitList, events, &seq);
@@ -144,6 +147,7 @@ doGer(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "symv_single_pass.h"
 
 static clblasStatus
 doHemv(
@@ -47,6 +49,7 @@ doHemv(
     ListHead seq1, seq2;
 	cl_event first_event;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -76,6 +79,16 @@ doHemv(
         return clblasInvalidEventWaitList;
     }
 
+    statisticsEnter(CLBLAS_HEMV, kargs->dtype);
+
+    retCode = symvSinglePass(kargs, order, uplo, N, A, offA, lda, x, offx, incx,
+        y, offy, incy, true, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
 	numCommandQueues = 1;
     kargs->order = order;
     kargs->uplo = uplo;
@@ -114,6 +127,7 @@ doHemv(
     }
 
     freeSolutionSeq(&seq1);
+    statisticsLeave();
     return (clblasStatus)err;
 
 	//printf("doHemv called\n");
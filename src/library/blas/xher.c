@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doher(
@@ -118,6 +119,8 @@ doher(
 	 */
 	numCommandQueues = 1;
 
+    statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_HER, kargs, numCommandQueues, commandQueues,
                           numEventsInWaitList, eventWaitList, events, &seq);
@@ -126,6 +129,7 @@ doher(
     }
 
     freeSolutionSeq(&seq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doHer2(
@@ -136,6 +137,8 @@ doHer2(
      */
     numCommandQueues = 1;
 
+    statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_HER2, kargs, numCommandQueues, commandQueue,
                           numEventsInWaitList, eventWaitList, events, &seq);
@@ -144,6 +147,7 @@ doHer2(
     }
 
     freeSolutionSeq(&seq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "syrk_autogemm.h"
 
 //#define DEBUG_HER2K
 
@@ -55,6 +57,7 @@ doHer2k(
     clblasTranspose fTransA;
     cl_event firstHerkCall;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -96,6 +99,16 @@ doHer2k(
         return clblasInvalidEventWaitList;
     }
 
+    statisticsEnter(CLBLAS_HER2K, kargs->dtype);
+
+    retCode = syrkAutoGemm(kargs, order, uplo, transA, N, K, A, offa, lda,
+        B, offb, ldb, C, offc, ldc, true, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
     fUplo = (order == clblasRowMajor) ? ((uplo == clblasLower) ? clblasUpper : clblasLower) : uplo;
     fTransA = (order == clblasRowMajor) ? ((transA == clblasNoTrans) ? clblasConjTrans : clblasNoTrans) : transA;
     kargs->order = (order == clblasRowMajor) ? clblasColumnMajor : order;
@@ -148,6 +161,7 @@ doHer2k(
         err = executeGEMM(kargs,  numCommandQueues, commandQueues, 1, &firstHerkCall, events);
     }
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "syrk_autogemm.h"
 
 extern clblasStatus executeGEMM( CLBlasKargs *kargs, cl_uint numCommandQueues, cl_command_queue *commandQueues, cl_uint numEventsInWaitList,
                                     const cl_event *eventWaitList, cl_event *events);
@@ -49,6 +51,7 @@ doHerk(
     clblasUplo fUplo;
     clblasTranspose fTransA;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -85,6 +88,16 @@ doHerk(
         return clblasInvalidEventWaitList;
     }
 
+    statisticsEnter(CLBLAS_HERK, kargs->dtype);
+
+    retCode = syrkAutoGemm(kargs, order, uplo, transA, N, K, A, offA, lda,
+        NULL, 0, 0, C, offC, ldc, true, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
     fUplo = (order == clblasRowMajor) ? ((uplo == clblasLower) ? clblasUpper : clblasLower) : uplo;
     fTransA = (order == clblasRowMajor) ? ((transA == clblasNoTrans) ? clblasConjTrans : clblasNoTrans) : transA;
     kargs->order = (order == clblasRowMajor) ? clblasColumnMajor : order;
@@ -125,6 +138,7 @@ doHerk(
 
     freeSolutionSeq(&seq);
 */
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
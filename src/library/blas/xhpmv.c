@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "symv_single_pass.h"
 
 static clblasStatus
 doHpmv(
@@ -46,6 +48,7 @@ doHpmv(
     ListHead seq1, seq2;
 	cl_event first_event;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -75,6 +78,16 @@ doHpmv(
         return clblasInvalidEventWaitList;
     }
 
+    statisticsEnter(CLBLAS_HPMV, kargs->dtype);
+
+    retCode = symvSinglePass(kargs, order, uplo, N, AP, offa, 0, X, offx, incx,
+        Y, offy, incy, true, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
 	numCommandQueues = 1;
     kargs->order = order;
     kargs->uplo = uplo;
@@ -115,6 +128,7 @@ doHpmv(
     }
 
     freeSolutionSeq(&seq1);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
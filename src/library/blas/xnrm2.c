@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doNrm2_hypot(CLBlasKargs *kargs,
@@ -225,13 +226,21 @@ doNrm2(
     }
     kargs->D = scratchBuff;
 
+    statisticsEnter(CLBLAS_NRM2, kargs->dtype);
+
     if(useHypot)
     {
-        return doNrm2_hypot(kargs, numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+        retCode = doNrm2_hypot(kargs, numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+
+        statisticsLeave();
+        return retCode;
     }
     else
     {
-        return doNrm2_ssq(kargs, numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+        retCode = doNrm2_ssq(kargs, numCommandQueues, commandQueues, numEventsInWaitList, eventWaitList, events);
+
+        statisticsLeave();
+        return retCode;
     }
 }
 
@@ -22,6 +22,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -101,6 +102,8 @@ doRot(
 		kargs->ldc.Vector = incy;	// Will be using this as incy
 		kargs->pigFuncID = CLBLAS_ROT;  // Using ROTM kernel for ROT. Both are similar
 
+		statisticsEnter(CLBLAS_ROT, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_ROTM, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -110,6 +113,7 @@ doRot(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
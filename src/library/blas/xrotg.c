@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -127,6 +128,8 @@ doRotg(
         kargs->offc = offC;
         kargs->offd = offS;
 
+		statisticsEnter(CLBLAS_ROTG, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_ROTG, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -136,6 +139,7 @@ doRotg(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
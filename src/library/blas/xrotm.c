@@ -22,6 +22,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -111,6 +112,8 @@ doRotm(
 		kargs->offd = offParam;
 		kargs->pigFuncID = CLBLAS_ROTM;
 
+		statisticsEnter(CLBLAS_ROTM, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_ROTM, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -120,6 +123,7 @@ doRotm(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
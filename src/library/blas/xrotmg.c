@@ -21,6 +21,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -129,6 +130,8 @@ doRotmg(
         kargs->offd = offY1;
         kargs->offe = offParam;
 
+		statisticsEnter(CLBLAS_ROTMG, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_ROTMG, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -138,6 +141,7 @@ doRotmg(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
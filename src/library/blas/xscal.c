@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -97,6 +98,8 @@ doScal(
 		printf("Calling makeSolutionSeq from DoScal: SCAL\n");
 		#endif
 
+		statisticsEnter(CLBLAS_SCAL, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_SCAL, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -106,6 +109,7 @@ doScal(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
@@ -21,6 +21,8 @@
 
 #include <functor.h>
 #include <functor_selector.h>
+#include <statistics.h>
+#include <host_path.h>
 
 //
 // This file provide the functor based public clBLAS API for
@@ -52,8 +54,30 @@ clblasSscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_FLOAT, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_FLOAT);
+
   clblasSscalFunctor * functor ;
 
+  {
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_FLOAT;
+    kargs.alpha.argFloat = alpha;
+    kargs.N = N;
+    kargs.A = X;
+    kargs.offBX = offx;
+    kargs.ldb.Vector = incx;
+    if (isHostPathSuitable(CLBLAS_SCAL, &kargs, numCommandQueues, commandQueues))
+    {
+      clblasStatus res = executeOnHost(CLBLAS_SCAL, &kargs, commandQueues[0],
+                                       numEventsInWaitList, eventWaitList, events);
+
+      statisticsLeave();
+      return res;
+    }
+  }
+
   if ( numCommandQueues>1 ) 
   {
     numCommandQueues = 1 ;  // No support for multi-device (yet)
@@ -79,6 +103,7 @@ clblasSscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
@@ -103,8 +128,30 @@ clblasDscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_DOUBLE, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_DOUBLE);
+
   clblasDscalFunctor * functor ;
 
+  {
+    CLBlasKargs kargs;
+
+    memset(&kargs, 0, sizeof(kargs));
+    kargs.dtype = TYPE_DOUBLE;
+    kargs.alpha.argDouble = alpha;
+    kargs.N = N;
+    kargs.A = X;
+    kargs.offBX = offx;
+    kargs.ldb.Vector = incx;
+    if (isHostPathSuitable(CLBLAS_SCAL, &kargs, numCommandQueues, commandQueues))
+    {
+      clblasStatus res = executeOnHost(CLBLAS_SCAL, &kargs, commandQueues[0],
+                                       numEventsInWaitList, eventWaitList, events);
+
+      statisticsLeave();
+      return res;
+    }
+  }
+
   if ( numCommandQueues>1 ) 
   {
     numCommandQueues = 1 ;  // No support for multi-device (yet)
@@ -130,6 +177,7 @@ clblasDscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 	
@@ -157,6 +205,8 @@ clblasCscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_COMPLEX_FLOAT, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_COMPLEX_FLOAT);
+
   clblasCscalFunctor * functor ;
 
   if ( numCommandQueues>1 ) 
@@ -184,6 +234,7 @@ clblasCscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
@@ -207,6 +258,8 @@ clblasZscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_COMPLEX_DOUBLE, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_COMPLEX_DOUBLE);
+
   clblasZscalFunctor * functor ;
 
   if ( numCommandQueues>1 ) 
@@ -234,6 +287,7 @@ clblasZscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;	
 }
@@ -257,6 +311,8 @@ clblasCsscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_COMPLEX_FLOAT, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_COMPLEX_FLOAT);
+
   clblasCsscalFunctor * functor ;
   
   if ( numCommandQueues>1 ) 
@@ -284,6 +340,7 @@ clblasCsscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
@@ -307,6 +364,8 @@ clblasZdscal(
   CHECK_EVENTS(numEventsInWaitList, eventWaitList);
   CHECK_VECTOR_X(TYPE_COMPLEX_DOUBLE, N, X, offx, incx);
 
+  statisticsEnter(CLBLAS_SCAL, TYPE_COMPLEX_DOUBLE);
+
   clblasZdscalFunctor * functor ;
 
   if ( numCommandQueues>1 ) 
@@ -334,6 +393,7 @@ clblasZdscal(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;	
 }
@@ -21,6 +21,7 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 static clblasStatus
 doSHbmv(
@@ -105,6 +106,8 @@ doSHbmv(
     kargs->offCY = offy;
     kargs->ldc.Vector = incy;
 
+    statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_GBMV, kargs, numCommandQueues, commandQueues,
         numEventsInWaitList, eventWaitList, events, &seq);
@@ -115,6 +118,7 @@ doSHbmv(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "symv_single_pass.h"
 
 static clblasStatus
 doSpmv(
@@ -46,6 +48,7 @@ doSpmv(
     ListHead seq1, seq2;
 	cl_event first_event;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -75,6 +78,16 @@ doSpmv(
         return clblasInvalidEventWaitList;
     }
 
+    statisticsEnter(CLBLAS_SPMV, kargs->dtype);
+
+    retCode = symvSinglePass(kargs, order, uplo, N, AP, offa, 0, X, offx, incx,
+        Y, offy, incy, false, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
 	numCommandQueues = 1;
     kargs->order = order;
     kargs->uplo = uplo;
@@ -117,6 +130,7 @@ doSpmv(
     }
 
     freeSolutionSeq(&seq1);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 
 clblasStatus
@@ -105,6 +106,8 @@ doSwap(
 		printf("Calling makeSolutionSeq from DoSwap: SWAP\n");
 		#endif
 
+		statisticsEnter(CLBLAS_SWAP, kargs->dtype);
+
 		listInitHead(&seq);
 		err = makeSolutionSeq(CLBLAS_SWAP, kargs, numCommandQueues, commandQueues,
         					        numEventsInWaitList, eventWaitList, events, &seq);
@@ -114,6 +117,7 @@ doSwap(
 
 		freeSolutionSeq(&seq);
 
+		statisticsLeave();
 		return (clblasStatus)err;
 	}
 
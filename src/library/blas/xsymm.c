@@ -22,6 +22,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 #define SYMM_USING_GEMM
 //#define DEBUG_SYMM
@@ -87,6 +88,8 @@ doSymm(	CLBlasKargs *kargs, clblasOrder order, clblasUplo uplo, clblasSide side,
 		return clblasInvalidEventWaitList;
 	}
 
+	statisticsEnter(symm_or_hemm, kargs->dtype);
+
 	numCommandQueues = 1;
     kargs->order = order;
     kargs->uplo = uplo;
@@ -269,6 +272,7 @@ doSymm(	CLBlasKargs *kargs, clblasOrder order, clblasUplo uplo, clblasSide side,
         }
     }
 #endif
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
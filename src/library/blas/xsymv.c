@@ -23,6 +23,7 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 static clblasStatus
 doSymv(
@@ -89,6 +90,8 @@ doSymv(
     kargs->offCY = offy;
     kargs->ldc.Vector = incy;
 
+    statisticsEnter(CLBLAS_SYMV, kargs->dtype);
+
     #ifndef USE_SYMV
 
         listInitHead(&seq);
@@ -129,6 +132,7 @@ doSymv(
     #endif
 
     freeSolutionSeq(&seq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
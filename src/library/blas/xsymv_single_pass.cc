@@ -0,0 +1,443 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Single pass SPMV, HPMV and HEMV.
+ *
+ * A is cut in tiles of SYMV_TILE x SYMV_TILE and work group R takes the
+ * stored tiles of block row R, each loaded once into local memory. A tile
+ * off the diagonal at block (R, C) adds T*x(C) to y(R), summed over the
+ * row in registers, and T'*x(R) to y(C), written to a workspace slot of
+ * its own; a diagonal tile is completed from its stored triangle. Every
+ * work group then counts itself in for the blocks of y it contributed to,
+ * and the last one in sums the slots of the block in a fixed order and
+ * writes y, so the result doesn't depend on the order groups complete.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <clBLAS.h>
+
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "workspace_pool.h"
+#include "statistics.h"
+#include "symv_single_pass.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define SYMV_TILE    32
+#define SYMV_WG_SIZE 64
+
+#define SYMV_STR_(x) #x
+#define SYMV_STR(x)  SYMV_STR_(x)
+
+// kernel flags
+#define SYMV_FLAG_UPPER      0x01   // A is stored in the upper triangle
+#define SYMV_FLAG_PACKED     0x02   // packed storage
+#define SYMV_FLAG_HERMITIAN  0x04   // Hermitian rather than symmetric
+#define SYMV_FLAG_CONJ       0x08   // conjugate the stored elements
+#define SYMV_FLAG_BETA_ZERO  0x10   // y is not read
+
+/******************************************************************************
+ * Kernel source. The first half of the work group sums the rows of the
+ * tile, the second half its columns.
+ *****************************************************************************/
+#define SYMV_SINGLE_PASS_SRC \
+"#define TB " SYMV_STR(SYMV_TILE) "\n" \
+"#define LDT (TB + 1)\n" \
+"\n" \
+"/* workspace slot of the contribution of tile (a, b) or (b, a) */\n" \
+"#define SLOT(a, b) ((a) >= (b) ? (a) * ((a) + 1) / 2 + (b) : (b) * ((b) + 1) / 2 + (a))\n" \
+"\n" \
+"__kernel __attribute__((reqd_work_group_size(" SYMV_STR(SYMV_WG_SIZE) ", 1, 1)))\n" \
+"void symvSinglePass(\n" \
+"    __global const TYPE *A, uint offA, uint lda,\n" \
+"    __global const TYPE *X, uint offX, uint incx,\n" \
+"    __global TYPE *Y, uint offY, uint incy,\n" \
+"    volatile __global TYPE *W,\n" \
+"    volatile __global uint *counters,\n" \
+"    uint N, TYPE alpha, TYPE beta, uint flags)\n" \
+"{\n" \
+"    __local TYPE T[TB * LDT];\n" \
+"    __local TYPE xR[TB];\n" \
+"    __local TYPE xC[TB];\n" \
+"    __local uint finalize;\n" \
+"    const uint lid = get_local_id(0);\n" \
+"    const uint t = lid % TB;\n" \
+"    const uint half = lid / TB;\n" \
+"    const uint R = get_group_id(0);\n" \
+"    const uint NT = get_num_groups(0);\n" \
+"    const uint upper = (flags & " SYMV_STR(SYMV_FLAG_UPPER) ") != 0;\n" \
+"    const uint hermitian = (flags & " SYMV_STR(SYMV_FLAG_HERMITIAN) ") != 0;\n" \
+"    const uint first = upper ? R : 0;\n" \
+"    const uint last = upper ? NT - 1 : R;\n" \
+"    const uint r = R * TB + t;\n" \
+"    TYPE rowSum = ZERO;\n" \
+"    TYPE a, s;\n" \
+"    uint C, c, k;\n" \
+"\n" \
+"    if (half == 0) {\n" \
+"        xR[t] = (r < N) ? X[offX + r * incx] : ZERO;\n" \
+"    }\n" \
+"    for (C = first; C <= last; C++) {\n" \
+"        /* the previous tile is consumed */\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"        if (half == 1) {\n" \
+"            c = C * TB + t;\n" \
+"            xC[t] = (c < N) ? X[offX + c * incx] : ZERO;\n" \
+"        }\n" \
+"        for (k = half; k < TB; k += 2) {\n" \
+"            c = C * TB + k;\n" \
+"            a = ZERO;\n" \
+"            if ((r < N) && (c < N) &&\n" \
+"                ((C != R) || (upper ? (r <= c) : (r >= c)))) {\n" \
+"                if (!(flags & " SYMV_STR(SYMV_FLAG_PACKED) ")) {\n" \
+"                    a = A[offA + c * lda + r];\n" \
+"                }\n" \
+"                else if (upper) {\n" \
+"                    a = A[offA + r + c * (c + 1) / 2];\n" \
+"                }\n" \
+"                else {\n" \
+"                    a = A[offA + r + c * (2 * N - c - 1) / 2];\n" \
+"                }\n" \
+"                if (flags & " SYMV_STR(SYMV_FLAG_CONJ) ") {\n" \
+"                    a = CONJ(a);\n" \
+"                }\n" \
+"            }\n" \
+"            T[t * LDT + k] = a;\n" \
+"        }\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"\n" \
+"        s = ZERO;\n" \
+"        if (C == R) {\n" \
+"            /* the other triangle of a diagonal tile is mirrored */\n" \
+"            if (half == 0) {\n" \
+"                for (k = 0; k < TB; k++) {\n" \
+"                    if (k == t) {\n" \
+"                        a = hermitian ? REAL_PART(T[t * LDT + t]) : T[t * LDT + t];\n" \
+"                    }\n" \
+"                    else if (upper ? (t < k) : (t > k)) {\n" \
+"                        a = T[t * LDT + k];\n" \
+"                    }\n" \
+"                    else {\n" \
+"                        a = hermitian ? CONJ(T[k * LDT + t]) : T[k * LDT + t];\n" \
+"                    }\n" \
+"                    s += MUL(a, xR[k]);\n" \
+"                }\n" \
+"                rowSum += s;\n" \
+"            }\n" \
+"        }\n" \
+"        else if (half == 0) {\n" \
+"            for (k = 0; k < TB; k++) {\n" \
+"                s += MUL(T[t * LDT + k], xC[k]);\n" \
+"            }\n" \
+"            rowSum += s;\n" \
+"        }\n" \
+"        else {\n" \
+"            for (k = 0; k < TB; k++) {\n" \
+"                a = hermitian ? CONJ(T[k * LDT + t]) : T[k * LDT + t];\n" \
+"                s += MUL(a, xR[k]);\n" \
+"            }\n" \
+"            W[SLOT(R, C) * TB + t] = s;\n" \
+"        }\n" \
+"    }\n" \
+"    if (half == 0) {\n" \
+"        W[SLOT(R, R) * TB + t] = rowSum;\n" \
+"    }\n" \
+"\n" \
+"    /* the slots are visible before the group counts itself in */\n" \
+"    write_mem_fence(CLK_GLOBAL_MEM_FENCE);\n" \
+"    barrier(CLK_GLOBAL_MEM_FENCE | CLK_LOCAL_MEM_FENCE);\n" \
+"    for (C = first; C <= last; C++) {\n" \
+"        const uint contributors = upper ? C + 1 : NT - C;\n" \
+"\n" \
+"        if (lid == 0) {\n" \
+"            finalize = (atomic_inc(&counters[C]) == contributors - 1);\n" \
+"        }\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"        c = C * TB + t;\n" \
+"        if (finalize && (half == 0) && (c < N)) {\n" \
+"            read_mem_fence(CLK_GLOBAL_MEM_FENCE);\n" \
+"            s = ZERO;\n" \
+"            for (k = (upper ? 0 : C); k < (upper ? C + 1 : NT); k++) {\n" \
+"                s += W[SLOT(k, C) * TB + t];\n" \
+"            }\n" \
+"            s = MUL(alpha, s);\n" \
+"            if (!(flags & " SYMV_STR(SYMV_FLAG_BETA_ZERO) ")) {\n" \
+"                s += MUL(beta, Y[offY + c * incy]);\n" \
+"            }\n" \
+"            Y[offY + c * incy] = s;\n" \
+"        }\n" \
+"        barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"    }\n" \
+"}\n"
+
+#define SYMV_REAL_DEFS \
+"#define ZERO 0\n" \
+"#define CONJ(a) (a)\n" \
+"#define REAL_PART(a) (a)\n" \
+"#define MUL(a, b) ((a) * (b))\n"
+
+#define SYMV_COMPLEX_DEFS \
+"#define ZERO ((TYPE)(0, 0))\n" \
+"#define CONJ(a) ((TYPE)((a).x, -(a).y))\n" \
+"#define REAL_PART(a) ((TYPE)((a).x, 0))\n" \
+"#define MUL(a, b) ((TYPE)((a).x * (b).x - (a).y * (b).y, " \
+                          "(a).x * (b).y + (a).y * (b).x))\n"
+
+#define SYMV_FP64_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+
+/*
+ * Kernels are cached by makeGemmKernel() by the address of their source,
+ * so every precision has a source of its own.
+ */
+template<typename Precision>
+struct SymvTraits
+{
+  static const char *source;
+};
+
+template<> const char *SymvTraits<cl_float>::source =
+  "#define TYPE float\n" SYMV_REAL_DEFS SYMV_SINGLE_PASS_SRC;
+template<> const char *SymvTraits<cl_double>::source =
+  SYMV_FP64_DEFS "#define TYPE double\n" SYMV_REAL_DEFS SYMV_SINGLE_PASS_SRC;
+template<> const char *SymvTraits<FloatComplex>::source =
+  "#define TYPE float2\n" SYMV_COMPLEX_DEFS SYMV_SINGLE_PASS_SRC;
+template<> const char *SymvTraits<DoubleComplex>::source =
+  SYMV_FP64_DEFS "#define TYPE double2\n" SYMV_COMPLEX_DEFS SYMV_SINGLE_PASS_SRC;
+
+/******************************************************************************
+ * Scalars per precision
+ *****************************************************************************/
+template<typename Precision>
+static Precision symvScalar(const ArgMultiplier &arg);
+template<>
+cl_float symvScalar<cl_float>(const ArgMultiplier &arg) { return arg.argFloat; }
+template<>
+cl_double symvScalar<cl_double>(const ArgMultiplier &arg) { return arg.argDouble; }
+template<>
+FloatComplex symvScalar<FloatComplex>(const ArgMultiplier &arg) { return arg.argFloatComplex; }
+template<>
+DoubleComplex symvScalar<DoubleComplex>(const ArgMultiplier &arg) { return arg.argDoubleComplex; }
+
+static bool symvIsZero(cl_float v)  { return v == 0; }
+static bool symvIsZero(cl_double v) { return v == 0; }
+static bool symvIsZero(FloatComplex v)  { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool symvIsZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+/******************************************************************************
+ * Row major -> column major, then the counters are cleared and the kernel
+ * launched
+ *****************************************************************************/
+template<typename Precision>
+static clblasStatus
+symvSinglePassType(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    cl_uint N,
+    cl_mem A, cl_uint offA, cl_uint lda,
+    cl_mem X, cl_uint offx, cl_uint incx,
+    cl_mem Y, cl_uint offy, cl_uint incy,
+    bool hermitian,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *event)
+{
+  const Precision alpha = symvScalar<Precision>(kargs->alpha);
+  const Precision beta = symvScalar<Precision>(kargs->beta);
+  const cl_uint numTiles = (N + SYMV_TILE - 1) / SYMV_TILE;
+  const size_t numSlots = (size_t)numTiles * (numTiles + 1) / 2;
+  const size_t localSize[1] = { SYMV_WG_SIZE };
+  const size_t globalSize[1] = { (size_t)numTiles * SYMV_WG_SIZE };
+  const cl_uint zero = 0;
+  cl_context context;
+  cl_mem W, counters;
+  cl_kernel kernel = NULL;
+  cl_event fillEvent = NULL;
+  cl_event kernelEvent = NULL;
+  cl_int err;
+
+  /*
+   * Row major A is stored as the transpose of the column major one: the
+   * other triangle of the same matrix if symmetric, of its conjugate if
+   * Hermitian.
+   */
+  if (order == clblasRowMajor) {
+    uplo = (uplo == clblasUpper) ? clblasLower : clblasUpper;
+  }
+
+  cl_uint flags = ((uplo == clblasUpper) ? SYMV_FLAG_UPPER : 0) |
+                  ((lda == 0) ? SYMV_FLAG_PACKED : 0) |
+                  (hermitian ? SYMV_FLAG_HERMITIAN : 0) |
+                  ((hermitian && order == clblasRowMajor) ? SYMV_FLAG_CONJ : 0) |
+                  (symvIsZero(beta) ? SYMV_FLAG_BETA_ZERO : 0);
+
+  err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(context), &context, NULL);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+
+  makeGemmKernel(&kernel, queue, SymvTraits<Precision>::source,
+    "", &noBinary, &noBinarySize, "");
+
+  W = acquireWorkspace(context, numSlots * SYMV_TILE * sizeof(Precision), &err);
+  if (err != CL_SUCCESS) {
+    return static_cast<clblasStatus>(err);
+  }
+  counters = acquireWorkspace(context, numTiles * sizeof(cl_uint), &err);
+  if (err != CL_SUCCESS) {
+    releaseWorkspace(W, NULL);
+    return static_cast<clblasStatus>(err);
+  }
+
+  const size_t argSizes[] = {
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(cl_uint), sizeof(Precision), sizeof(Precision), sizeof(cl_uint) };
+  const void *args[] = {
+    &A, &offA, &lda,
+    &X, &offx, &incx,
+    &Y, &offy, &incy,
+    &W, &counters,
+    &N, &alpha, &beta, &flags };
+
+  for (cl_uint i = 0; err == CL_SUCCESS && i < sizeof(args) / sizeof(args[0]); i++) {
+    err = clSetKernelArg(kernel, i, argSizes[i], args[i]);
+  }
+  if (err == CL_SUCCESS) {
+    err = clEnqueueFillBuffer(queue, counters, &zero, sizeof(zero), 0,
+      numTiles * sizeof(cl_uint), numEventsInWaitList, eventWaitList,
+      &fillEvent);
+  }
+  if (err == CL_SUCCESS) {
+    err = clEnqueueNDRangeKernel(queue, kernel, 1, NULL,
+      globalSize, localSize, 1, &fillEvent, &kernelEvent);
+    if (err == CL_SUCCESS) {
+      statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+    }
+  }
+  if (fillEvent != NULL) {
+    clReleaseEvent(fillEvent);
+  }
+
+  // the workspace goes back to the pool once the kernel completes
+  releaseWorkspace(W, kernelEvent);
+  releaseWorkspace(counters, kernelEvent);
+  if (err == CL_SUCCESS && event != NULL) {
+    *event = kernelEvent;
+  }
+  else if (kernelEvent != NULL) {
+    clReleaseEvent(kernelEvent);
+  }
+
+  return static_cast<clblasStatus>(err);
+}
+
+/******************************************************************************
+ * Entry point of xspmv.c, xhpmv.c and xhemv.c
+ *****************************************************************************/
+static bool
+symvSinglePassEnabled(void)
+{
+  const char *env = getenv("AMD_CLBLAS_SYMV_SINGLE_PASS");
+
+  return env == NULL || atoi(env) != 0;
+}
+
+extern "C"
+clblasStatus
+symvSinglePass(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    size_t N,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem X,
+    size_t offx,
+    int incx,
+    cl_mem Y,
+    size_t offy,
+    int incy,
+    bool hermitian,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled)
+{
+  *handled = false;
+
+  // vectors running backwards are left to the solver framework
+  if (!symvSinglePassEnabled() || N == 0 || incx <= 0 || incy <= 0 ||
+      numCommandQueues == 0) {
+    return clblasSuccess;
+  }
+  // every index into A, x and y must fit the kernel arguments
+  if (2 * (size_t)N * N > UINT_MAX || lda > UINT_MAX ||
+      offA + ((lda == 0) ? N * (N + 1) / 2 : N * lda) > UINT_MAX ||
+      offx + N * (size_t)incx > UINT_MAX ||
+      offy + N * (size_t)incy > UINT_MAX) {
+    return clblasSuccess;
+  }
+
+  cl_event *event = (events != NULL) ? &events[0] : NULL;
+  clblasStatus status = clblasSuccess;
+
+  *handled = true;
+  switch (kargs->dtype) {
+  case TYPE_FLOAT:
+    status = symvSinglePassType<cl_float>(kargs, order, uplo, (cl_uint)N,
+        A, (cl_uint)offA, (cl_uint)lda, X, (cl_uint)offx, (cl_uint)incx,
+        Y, (cl_uint)offy, (cl_uint)incy, false, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_DOUBLE:
+    status = symvSinglePassType<cl_double>(kargs, order, uplo, (cl_uint)N,
+        A, (cl_uint)offA, (cl_uint)lda, X, (cl_uint)offx, (cl_uint)incx,
+        Y, (cl_uint)offy, (cl_uint)incy, false, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_COMPLEX_FLOAT:
+    status = symvSinglePassType<FloatComplex>(kargs, order, uplo, (cl_uint)N,
+        A, (cl_uint)offA, (cl_uint)lda, X, (cl_uint)offx, (cl_uint)incx,
+        Y, (cl_uint)offy, (cl_uint)incy, hermitian, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_COMPLEX_DOUBLE:
+    status = symvSinglePassType<DoubleComplex>(kargs, order, uplo, (cl_uint)N,
+        A, (cl_uint)offA, (cl_uint)lda, X, (cl_uint)offx, (cl_uint)incx,
+        Y, (cl_uint)offy, (cl_uint)incy, hermitian, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  default:
+    *handled = false;
+    break;
+  }
+
+  return status;
+}
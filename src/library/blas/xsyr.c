@@ -22,6 +22,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doSyr(
@@ -122,6 +123,8 @@ doSyr(
 	 */
 	numCommandQueues = 1;
 
+    statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_SYR, kargs, numCommandQueues, commandQueue,
                           numEventsInWaitList, eventWaitList, events, &seq);
@@ -130,6 +133,7 @@ doSyr(
     }
 
     freeSolutionSeq(&seq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
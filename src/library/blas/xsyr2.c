@@ -22,6 +22,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doSyr2(
@@ -130,6 +131,8 @@ doSyr2(
      */
     numCommandQueues = 1;
 
+    statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
     listInitHead(&seq);
     err = makeSolutionSeq(CLBLAS_SYR2, kargs, numCommandQueues, commandQueue,
                           numEventsInWaitList, eventWaitList, events, &seq);
@@ -138,6 +141,7 @@ doSyr2(
     }
 
     freeSolutionSeq(&seq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
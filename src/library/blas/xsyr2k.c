@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "syrk_autogemm.h"
 
 clblasStatus
 doSyr2k(
@@ -48,6 +50,7 @@ doSyr2k(
     cl_int err;
     ListHead seq;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -76,6 +79,16 @@ doSyr2k(
         return retCode;
     }
 
+    statisticsEnter(CLBLAS_SYR2K, kargs->dtype);
+
+    retCode = syrkAutoGemm(kargs, order, uplo, transAB, N, K, A, offA, lda,
+        B, offB, ldb, C, offC, ldc, false, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
     kargs->order = order;
     kargs->transA = transAB;
     kargs->transB = transAB;
@@ -102,6 +115,7 @@ doSyr2k(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
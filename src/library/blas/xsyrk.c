@@ -21,6 +21,8 @@
 
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "syrk_autogemm.h"
 
 clblasStatus
 doSyrk(
@@ -45,6 +47,7 @@ doSyrk(
     cl_int err;
     ListHead seq;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -70,6 +73,16 @@ doSyrk(
         return retCode;
     }
 
+    statisticsEnter(CLBLAS_SYRK, kargs->dtype);
+
+    retCode = syrkAutoGemm(kargs, order, uplo, transA, N, K, A, offA, lda,
+        NULL, 0, 0, C, offC, ldc, false, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
     kargs->order = order;
     kargs->transA = transA;
     kargs->transB = transA;
@@ -96,6 +109,7 @@ doSyrk(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
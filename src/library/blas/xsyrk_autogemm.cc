@@ -0,0 +1,331 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * SYRK family on the triangular AutoGemm kernels.
+ *
+ * The work groups of a triangular kernel enumerate the macro tiles of the
+ * lower triangle by rows, or of the upper one by columns, from a one
+ * dimensional group id: numTiles*(numTiles+1)/2 groups instead of the
+ * numTiles^2 of GEMM, and no separate launches for the diagonal. The tile
+ * kernel is used when N is a multiple of the macro tile, the corner kernel
+ * with bounds checks otherwise.
+ *
+ * SYR2K and HER2K run the rank-2k variants, which add op(B)*op(A) in a
+ * second sweep over K before writing C, so C is read and written once.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <clBLAS.h>
+
+#include "AutoGemmIncludes/AutoGemmKernelSelection.h"
+#include "xgemm.h"
+#include "statistics.h"
+#include "syrk_autogemm.h"
+
+const static unsigned int numSyrkKernelArgs = 16;
+
+/******************************************************************************
+ * Scalars per precision
+ *****************************************************************************/
+template<typename Precision>
+static Precision syrkScalar(const ArgMultiplier &arg);
+template<>
+cl_float syrkScalar<cl_float>(const ArgMultiplier &arg) { return arg.argFloat; }
+template<>
+cl_double syrkScalar<cl_double>(const ArgMultiplier &arg) { return arg.argDouble; }
+template<>
+FloatComplex syrkScalar<FloatComplex>(const ArgMultiplier &arg) { return arg.argFloatComplex; }
+template<>
+DoubleComplex syrkScalar<DoubleComplex>(const ArgMultiplier &arg) { return arg.argDoubleComplex; }
+
+static bool syrkIsZero(cl_float v)  { return v == 0; }
+static bool syrkIsZero(cl_double v) { return v == 0; }
+static bool syrkIsZero(FloatComplex v)  { return CREAL(v) == 0 && CIMAG(v) == 0; }
+static bool syrkIsZero(DoubleComplex v) { return CREAL(v) == 0 && CIMAG(v) == 0; }
+
+/******************************************************************************
+ * Enqueue the triangular kernel for the 'uplo' triangle of
+ * C = alpha*op(A)*op(B) + beta*C, C being N x N in column major order, or
+ * with 'rank2k' of C = alpha*op(A)*op(B) + alpha2*op(B)*op(A) + beta*C, alpha2
+ * being the conjugate of alpha if 'realDiagonal' is set and alpha otherwise.
+ * Returns clblasNotImplemented if no kernel fits.
+ *****************************************************************************/
+template<typename Precision>
+static clblasStatus
+enqueueTriangle(
+    bool rank2k,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    cl_uint N, cl_uint K,
+    Precision alpha,
+    cl_mem A, cl_uint offA, cl_uint lda,
+    cl_mem B, cl_uint offB, cl_uint ldb,
+    Precision beta,
+    cl_mem C, cl_uint offC, cl_uint ldc,
+    cl_uint realDiagonal,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *event)
+{
+  const char *tileKernelSource   = NULL;
+  const char *rowKernelSource    = NULL;
+  const char *colKernelSource    = NULL;
+  const char *cornerKernelSource = NULL;
+  const char *sourceBuildOptions = NULL;
+  const unsigned char *tileKernelBinary   = NULL;
+  const unsigned char *rowKernelBinary    = NULL;
+  const unsigned char *colKernelBinary    = NULL;
+  const unsigned char *cornerKernelBinary = NULL;
+  size_t *tileKernelBinarySize   = 0;
+  size_t *rowKernelBinarySize    = 0;
+  size_t *colKernelBinarySize    = 0;
+  size_t *cornerKernelBinarySize = 0;
+  const char *binaryBuildOptions = NULL;
+  cl_kernel *tileClKernelDummy   = NULL;
+  cl_kernel *rowClKernelDummy    = NULL;
+  cl_kernel *colClKernelDummy    = NULL;
+  cl_kernel *cornerClKernelDummy = NULL;
+  unsigned int workGroupNumRows;
+  unsigned int workGroupNumCols;
+  unsigned int microTileNumRows;
+  unsigned int microTileNumCols;
+  unsigned int unroll;
+
+  GemmSelectKernelFunc selectKernel = rank2k ?
+    gemmSelectKernelTriangular2K<Precision> :
+    gemmSelectKernelTriangular<Precision>;
+
+  selectKernel(
+    clblasColumnMajor, transA, transB,
+    N, N, K,
+    !syrkIsZero(beta),
+    0,
+    &tileKernelSource,
+    &rowKernelSource,
+    &colKernelSource,
+    &cornerKernelSource,
+    &sourceBuildOptions,
+    &tileKernelBinary,
+    &rowKernelBinary,
+    &colKernelBinary,
+    &cornerKernelBinary,
+    &tileKernelBinarySize,
+    &rowKernelBinarySize,
+    &colKernelBinarySize,
+    &cornerKernelBinarySize,
+    &binaryBuildOptions,
+    &tileClKernelDummy,
+    &rowClKernelDummy,
+    &colClKernelDummy,
+    &cornerClKernelDummy,
+    &workGroupNumRows,
+    &workGroupNumCols,
+    &microTileNumRows,
+    &microTileNumCols,
+    &unroll);
+  // the corner kernel serves the sizes that aren't multiples of the tile
+  if (!tileKernelSource || !cornerKernelSource) {
+    return clblasNotImplemented;
+  }
+
+  // triangular kernels have square macro tiles
+  unsigned int macroTile = workGroupNumRows*microTileNumRows;
+  cl_kernel clKernel = NULL;
+  if (N % macroTile == 0) {
+    makeGemmKernel(&clKernel, queue, tileKernelSource, sourceBuildOptions,
+      &tileKernelBinary, tileKernelBinarySize, binaryBuildOptions);
+  }
+  else {
+    makeGemmKernel(&clKernel, queue, cornerKernelSource, sourceBuildOptions,
+      &cornerKernelBinary, cornerKernelBinarySize, binaryBuildOptions);
+  }
+
+  cl_uint upper = (uplo == clblasUpper) ? 1 : 0;
+  void *args[numSyrkKernelArgs] = {
+    &A, &B, &C, &alpha, &beta, &N, &N, &K,
+    &lda, &ldb, &ldc, &offA, &offB, &offC, &upper, &realDiagonal };
+  size_t argSizes[numSyrkKernelArgs] = {
+    sizeof(cl_mem), sizeof(cl_mem), sizeof(cl_mem),
+    sizeof(Precision), sizeof(Precision),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint) };
+  for (unsigned int i = 0; i < numSyrkKernelArgs; i++) {
+    cl_int err = clSetKernelArg(clKernel, i, argSizes[i], args[i]);
+    if (err != CL_SUCCESS) {
+      return (clblasStatus)err;
+    }
+  }
+
+  size_t numTiles = (N + macroTile - 1) / macroTile;
+  size_t globalWorkSize[2] = {
+    numTiles*(numTiles + 1)/2 * workGroupNumRows, workGroupNumCols };
+  size_t localWorkSize[2] = { workGroupNumRows, workGroupNumCols };
+  cl_int err = clEnqueueNDRangeKernel(queue, clKernel, 2, NULL,
+    globalWorkSize, localWorkSize, numEventsInWaitList, eventWaitList, event);
+  if (err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+  }
+  return (clblasStatus)err;
+}
+
+/******************************************************************************
+ * Row major -> column major, then a single launch
+ *****************************************************************************/
+template<typename Precision>
+static clblasStatus
+syrkAutoGemmType(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    clblasTranspose trans,
+    cl_uint N, cl_uint K,
+    cl_mem A, cl_uint offA, cl_uint lda,
+    cl_mem B, cl_uint offB, cl_uint ldb,
+    cl_mem C, cl_uint offC, cl_uint ldc,
+    bool hermitian,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *event,
+    bool *handled)
+{
+  Precision alpha = syrkScalar<Precision>(kargs->alpha);
+  Precision beta = syrkScalar<Precision>(kargs->beta);
+  clblasTranspose transConj = hermitian ? clblasConjTrans : clblasTrans;
+  bool rank2k = (B != NULL);
+
+  if (!rank2k) {
+    B = A;
+    offB = offA;
+    ldb = lda;
+  }
+
+  /*
+   * Row major C is the transpose of the column major one, so the other
+   * triangle of op(A)'*op(B) is updated. For HER2K the two products then
+   * also trade alpha and its conjugate; clblas[CZ]her2k already conjugate
+   * alpha for row major order.
+   */
+  if (order == clblasRowMajor) {
+    uplo = (uplo == clblasUpper) ? clblasLower : clblasUpper;
+    trans = (trans == clblasNoTrans) ? transConj : clblasNoTrans;
+  }
+  clblasTranspose transA = (trans == clblasNoTrans) ? clblasNoTrans : transConj;
+  clblasTranspose transB = (trans == clblasNoTrans) ? transConj : clblasNoTrans;
+  cl_uint realDiagonal = hermitian ? 1 : 0;
+
+  clblasStatus status = enqueueTriangle<Precision>(rank2k, uplo,
+      transA, transB, N, K, alpha, A, offA, lda, B, offB, ldb, beta,
+      C, offC, ldc, realDiagonal, queue, numEventsInWaitList, eventWaitList,
+      event);
+  if (status != clblasNotImplemented) {
+    *handled = true;
+  }
+  return status;
+}
+
+/******************************************************************************
+ * Entry point of xsyrk.c, xherk.c, xsyr2k.c and xher2k.c
+ *****************************************************************************/
+static bool
+syrkAutoGemmEnabled(void)
+{
+  const char *env = getenv("AMD_CLBLAS_SYRK_AUTOGEMM");
+
+  return env == NULL || atoi(env) != 0;
+}
+
+extern "C"
+clblasStatus
+syrkAutoGemm(
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasUplo uplo,
+    clblasTranspose trans,
+    size_t N,
+    size_t K,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    const cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_mem C,
+    size_t offC,
+    size_t ldc,
+    bool hermitian,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled)
+{
+  *handled = false;
+
+  // K = 0 only scales C, and the kernels loop over K at least once
+  if (!syrkAutoGemmEnabled() || N == 0 || K == 0 || numCommandQueues == 0) {
+    return clblasSuccess;
+  }
+  if (N > UINT_MAX || K > UINT_MAX || lda > UINT_MAX || ldb > UINT_MAX
+      || ldc > UINT_MAX || offA > UINT_MAX || offB > UINT_MAX
+      || offC > UINT_MAX) {
+    return clblasSuccess;
+  }
+
+  cl_event *event = (events != NULL) ? &events[0] : NULL;
+  clblasStatus status = clblasSuccess;
+  switch (kargs->dtype) {
+  case TYPE_FLOAT:
+    status = syrkAutoGemmType<cl_float>(kargs, order, uplo, trans,
+        (cl_uint)N, (cl_uint)K, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, C, (cl_uint)offC, (cl_uint)ldc,
+        false, commandQueues[0], numEventsInWaitList, eventWaitList,
+        event, handled);
+    break;
+  case TYPE_DOUBLE:
+    status = syrkAutoGemmType<cl_double>(kargs, order, uplo, trans,
+        (cl_uint)N, (cl_uint)K, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, C, (cl_uint)offC, (cl_uint)ldc,
+        false, commandQueues[0], numEventsInWaitList, eventWaitList,
+        event, handled);
+    break;
+  case TYPE_COMPLEX_FLOAT:
+    status = syrkAutoGemmType<FloatComplex>(kargs, order, uplo, trans,
+        (cl_uint)N, (cl_uint)K, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, C, (cl_uint)offC, (cl_uint)ldc,
+        hermitian, commandQueues[0], numEventsInWaitList, eventWaitList,
+        event, handled);
+    break;
+  case TYPE_COMPLEX_DOUBLE:
+    status = syrkAutoGemmType<DoubleComplex>(kargs, order, uplo, trans,
+        (cl_uint)N, (cl_uint)K, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, C, (cl_uint)offC, (cl_uint)ldc,
+        hermitian, commandQueues[0], numEventsInWaitList, eventWaitList,
+        event, handled);
+    break;
+  default:
+    break;
+  }
+
+  return *handled ? status : clblasSuccess;
+}
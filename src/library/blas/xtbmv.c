@@ -24,6 +24,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doTbmv(
@@ -100,9 +101,12 @@ doTbmv(
 		return clblasInvalidEventWaitList;
 	}
 
+	statisticsEnter(CLBLAS_TBMV, kargs->dtype);
+
 	newEventWaitList = malloc((numEventsInWaitList+1) * sizeof(cl_event));
 	if (newEventWaitList == NULL)
 	{
+		statisticsLeave();
 		return clblasOutOfHostMemory;
 	}
 	if (numEventsInWaitList != 0 )
@@ -122,6 +126,7 @@ doTbmv(
 	if (err != CL_SUCCESS)
 	{
 		free(newEventWaitList);
+		statisticsLeave();
 		return err;
 	}
 
@@ -164,6 +169,7 @@ doTbmv(
 
     freeSolutionSeq(&seq);
 	free(newEventWaitList);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 //#define DEBUG_TBSV
 static clblasUplo
@@ -615,6 +616,8 @@ doTbsv(
 	}
 
 
+	statisticsEnter(CLBLAS_TBSV, kargs->dtype);
+
 	numCommandQueues = 1; // NOTE: Hard-coding the number of command queues to 1i
     kargs->order = order;
     kargs->uplo = uplo;
@@ -665,6 +668,7 @@ doTbsv(
 
     freeSolutionSeq(&seq);
     freeSolutionSeq(&gbmvSeq);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
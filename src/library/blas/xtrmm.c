@@ -21,6 +21,9 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
+#include "trxm_recursive.h"
+#include "path_table.h"
 
 static clblasStatus
 doTrmm(
@@ -48,6 +51,9 @@ doTrmm(
     ListHead seq;
     size_t msize;
     clblasStatus retCode = clblasSuccess;
+    bool handled;
+    ImplPath path;
+    int strict;
 
     if (!clblasInitialized) {
         return clblasNotInitialized;
@@ -68,6 +74,16 @@ doTrmm(
         return retCode;
     }
 
+    statisticsEnter(CLBLAS_TRMM, kargs->dtype);
+
+    retCode = trxmRecursive(CLBLAS_TRMM, kargs, order, side, uplo, transA, diag,
+        M, N, A, offA, lda, B, offB, ldb, numCommandQueues, commandQueues,
+        numEventsInWaitList, eventWaitList, events, &handled);
+    if (handled) {
+        statisticsLeave();
+        return retCode;
+    }
+
     kargs->order = order;
     kargs->side = side;
     kargs->uplo = uplo;
@@ -94,6 +110,14 @@ doTrmm(
     kargs->offsetN = 0;
     kargs->scimage[0] = 0;
 
+    path = trxmPinnedPath(CLBLAS_TRMM, kargs->dtype, side, uplo, transA, M, N,
+                          &strict);
+    kargs->pattern = pathPattern(CLBLAS_TRMM, path);
+    if (strict && (kargs->pattern == 0)) {
+        statisticsLeave();
+        return clblasNotImplemented;
+    }
+
 #ifndef TRXM_MULTIPLE_QUEUES
     if (numCommandQueues != 0) {
         numCommandQueues = 1;
@@ -109,6 +133,7 @@ doTrmm(
 
     freeSolutionSeq(&seq);
 
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 clblasStatus
 doTrmv(
@@ -98,9 +99,12 @@ doTrmv(
 		return clblasInvalidEventWaitList;
 	}
 
+	statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
 	newEventWaitList = malloc((numEventsInWaitList+1) * sizeof(cl_event));
 	if (newEventWaitList == NULL)
 	{
+		statisticsLeave();
 		return clblasOutOfHostMemory;
 	}
 	if (numEventsInWaitList != 0 )
@@ -120,6 +124,7 @@ doTrmv(
 	if (err != CL_SUCCESS)
 	{
 		free(newEventWaitList);
+		statisticsLeave();
 		return err;
 	}
 
@@ -158,6 +163,7 @@ doTrmv(
 
     freeSolutionSeq(&seq);
 	free(newEventWaitList);
+    statisticsLeave();
     return (clblasStatus)err;
 }
 
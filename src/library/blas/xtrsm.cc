@@ -26,7 +26,13 @@
 
 #include <devinfo.h>
 #include "clblas-internal.h"
+#include "mutex.h"
+#include "kernel_blob.h"
+#include "binary_lookup.h"
 #include "solution_seq.h"
+#include "trxm_recursive.h"
+#include "statistics.h"
+#include "path_table.h"
 
 #include "TrtriClKernels.h"
 #include "TrtriKernelSourceIncludes.h"
@@ -104,34 +110,57 @@ static void force_trsm_column_major(Args & args)
     assert(false); \
       }
 
+//
+// CL_CHECK for the GPU DTRSMs once their commands are chained: the event of
+// the last command and the temporary buffers are released, and the error is
+// returned as handled since B may already be updated
+//
+#define TRSM_CHECK(RET) \
+  if(RET != CL_SUCCESS) { \
+    printf("OpenCL error %i on line %u\n", RET, __LINE__); \
+    chain.finish(NULL); \
+    if (InvA != NULL) clReleaseMemObject(InvA); \
+    if (X != NULL) clReleaseMemObject(X); \
+    specialCaseHandled = true; \
+    return (clblasStatus)RET; \
+      }
+
 #define min(x,y) ((x)<(y)?(x):(y))
 
-static char *getKernelName(cl_kernel clKernel)
-{
-  cl_int err;
-  // get kernel name
-  size_t kernelNameLength;
-  err = clGetKernelInfo(
-    clKernel,
-    CL_KERNEL_FUNCTION_NAME,
-    sizeof(kernelNameLength),
-    NULL,
-    &kernelNameLength);
-
-  // Do not check this error because of an nvidia bug.
-  // The kernelNameLength turns out to be of proper length.
-  // CL_CHECK(err)
-
-  char *kernelName = new char[kernelNameLength];
-  err = clGetKernelInfo(
-    clKernel,
-    CL_KERNEL_FUNCTION_NAME,
-    kernelNameLength*sizeof(char),
-    kernelName,
-    NULL );
-  CL_CHECK(err)
+typedef struct trsm_kernel_key_ {
+  cl_context context;
+  cl_device_id device;
+  const char *kernelSource; // address of kernel source
+} trsm_kernel_key;
 
-  return kernelName;
+static bool operator<(const trsm_kernel_key & l, const trsm_kernel_key & r) {
+  if (l.context != r.context) {
+    return l.context < r.context;
+  }
+  if (l.device != r.device) {
+    return l.device < r.device;
+  }
+  return l.kernelSource < r.kernelSource;
+}
+
+typedef std::map<trsm_kernel_key, cl_kernel> trsm_kernel_map_t;
+
+static trsm_kernel_map_t trsmKernels;
+static mutex_t *trsmKernelsLock = mutexInit();
+
+extern "C" void releaseTrsmKernels(cl_context context)
+{
+  mutexLock(trsmKernelsLock);
+  trsm_kernel_map_t::iterator it = trsmKernels.begin();
+  while (it != trsmKernels.end()) {
+    if (context == NULL || it->first.context == context) {
+      clReleaseKernel(it->second);
+      trsmKernels.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  mutexUnlock(trsmKernelsLock);
 }
 
 //FIXME: This function should be returning an error.
@@ -144,10 +173,6 @@ void makeKernel(
   size_t *kernelBinarySize,
   const char *binaryBuildOptions)
 {
-  //TODO: This will need to be converted to thread local when making clBLAS thread safe
-  typedef std::map<std::string, cl_kernel> kernel_map_t;
-  static kernel_map_t kernel_map;
-
   cl_context clContext;
   cl_device_id clDevice;
   cl_int err;
@@ -157,30 +182,24 @@ void makeKernel(
   err = clGetCommandQueueInfo( clQueue, CL_QUEUE_DEVICE, sizeof(clDevice), &clDevice, NULL);
   CL_CHECK(err)
 
-  std::stringstream ss;
-  ss << clDevice << "_" << clContext;
-  std::string prefix = ss.str();
-
-  if (*clKernel) {
-    char *kernelName = getKernelName(*clKernel);
-    // kernel has already been built, return
+  // The kernel passed in may have been released with its context, so the
+  // lookup is by source only
+  trsm_kernel_key key;
+  key.context = clContext;
+  key.device = clDevice;
+  key.kernelSource = kernelSource;
+
+  mutexLock(trsmKernelsLock);
+  trsm_kernel_map_t::iterator idx = trsmKernels.find(key);
+  if (idx == trsmKernels.end()) {
+    *clKernel = NULL;
+  } else {
+    *clKernel = idx->second;
 #ifdef AUTOGEMM_PRINT_DEBUG
-    printf("makeKernel: \"%s\" already built; returning.\n", kernelName);
+    printf("makeKernel: already built; returning.\n");
 #endif
-
-    // Check if kernel exists for this device
-    std::string key = prefix + "_" + kernelName;
-    kernel_map_t::iterator idx = kernel_map.find(key);
-
-    // If kernel not found for this device, set to NULL
-    if (idx == kernel_map.end()) {
-        *clKernel = NULL;
-    } else {
-        *clKernel = idx->second;
-    }
-
-    delete[] kernelName;
   }
+  mutexUnlock(trsmKernelsLock);
 
   if (!*clKernel) {
     // kernel has not been built, so build it (from binary, preferably)
@@ -191,20 +210,25 @@ void makeKernel(
       printf("makeKernel: pre-compiled binary found: %llu bytes\n", *kernelBinarySize);
       printf("makeKernel: Creating program from binary\n");
 #endif
+      // embedded binaries are compressed, decode them on first use
+      size_t binarySize = *kernelBinarySize;
+      const unsigned char *binary = kernelBlobData(*kernelBinary, &binarySize);
       clProgram = clCreateProgramWithBinary(
         clContext,
         1, &clDevice,
-        kernelBinarySize, kernelBinary,
+        &binarySize, &binary,
         &clBinaryStatus, &err );
 #ifdef AUTOGEMM_PRINT_DEBUG
       if (err != CL_SUCCESS) {
           printf("makeKernel: Failed to create program with binary\n");
       }
 #endif
+      cl_ulong start = statisticsTime();
       err = clBuildProgram(
         clProgram,
         1, &clDevice,
         binaryBuildOptions, NULL, NULL );
+      statisticsProgramBuilt(start);
 #ifdef AUTOGEMM_PRINT_DEBUG
       if (err != CL_SUCCESS) {
           printf("makeKernel: Failed to build program from binary\n");
@@ -216,15 +240,11 @@ void makeKernel(
 #ifdef AUTOGEMM_PRINT_DEBUG
       printf("makeKernel: Creating program from source\n");
 #endif
-      clProgram = clCreateProgramWithSource(
-        clContext,
-        1, &kernelSource,
-        NULL, &err );
-      CL_CHECK(err)
-      err = clBuildProgram(
-        clProgram,
-        1, &clDevice,
-        sourceBuildOptions, NULL, NULL );
+      // a kernel pack or the binary cache may have it built already
+      clProgram = BinaryLookup::buildProgramFromSourceCached(
+        "clblasTrsmKernel", kernelSource,
+        clContext, clDevice,
+        err, sourceBuildOptions );
       CL_CHECK(err)
     }
 
@@ -254,28 +274,82 @@ void makeKernel(
 	err = clReleaseProgram(clProgram);
 	CL_CHECK(err)
 
-    char *kernelName = getKernelName(*clKernel);
-
 #ifdef AUTOGEMM_PRINT_DEBUG
-    printf("makeKernel: \"%s\" now built; returning.\n", kernelName);
+    printf("makeKernel: now built; returning.\n");
 #endif
 
-    std::string key = prefix + "_" + kernelName;
-    kernel_map[key] = *clKernel;
-
-    delete[] kernelName;
+    mutexLock(trsmKernelsLock);
+    trsmKernels[key] = *clKernel;
+    mutexUnlock(trsmKernelsLock);
   }
 
   return;
 }
 
+/******************************************************************************
+ * The commands of a TRSM depend on each other, so they are chained with
+ * events: each waits for the previous one, the first for the caller's wait
+ * list. This keeps them ordered on an out-of-order queue as well.
+ *****************************************************************************/
+struct TrsmChain
+{
+	cl_uint numEventsInWaitList;
+	const cl_event *eventWaitList;
+	cl_event prev;
+	cl_event next;
+
+	TrsmChain(cl_uint numEvents, const cl_event *waitList) :
+		numEventsInWaitList(numEvents), eventWaitList(waitList),
+		prev(NULL), next(NULL)
+	{
+	}
+
+	cl_uint numWaits() const
+	{
+		return (prev != NULL) ? 1 : numEventsInWaitList;
+	}
+
+	const cl_event *waits() const
+	{
+		return (prev != NULL) ? &prev : eventWaitList;
+	}
+
+	// the event to give to the next command
+	cl_event *nextEvent()
+	{
+		next = NULL;
+		return &next;
+	}
+
+	// the next command is the last one now, unless it was not enqueued
+	void advance()
+	{
+		if (next == NULL)
+			return;
+		if (prev != NULL)
+			clReleaseEvent(prev);
+		prev = next;
+		next = NULL;
+	}
+
+	// hand the event of the last command to the caller
+	void finish(cl_event *events)
+	{
+		if (events != NULL)
+			*events = prev;
+		else if (prev != NULL)
+			clReleaseEvent(prev);
+		prev = NULL;
+	}
+};
+
 static cl_int clearBuffer(cl_command_queue  queue,
 	cl_mem  buffer,
-	size_t  buffer_size)
+	size_t  buffer_size,
+	TrsmChain &chain)
 {
 
 	cl_int err = 0;
-	cl_event  event;
 	// Hummm clEnqueueFillBuffer is OpenCL 1.2 !!!
 	double zero = 0.0;
 	err = clEnqueueFillBuffer(queue,
@@ -284,10 +358,11 @@ static cl_int clearBuffer(cl_command_queue  queue,
 		sizeof(double),
 		0,  // offset
 		buffer_size,
-		0,
-		NULL,
-		&event
+		chain.numWaits(),
+		chain.waits(),
+		chain.nextEvent()
 		);
+	chain.advance();
 
 	return err;
 
@@ -310,7 +385,7 @@ cl_int call_kernel_triple_update192(
 	int i,
 	unsigned int lda,
 	int M,
-	cl_event *event)
+	TrsmChain &chain)
 {
 	cl_int err = 0;
 
@@ -374,8 +449,11 @@ cl_int call_kernel_triple_update192(
 
 	err = clEnqueueNDRangeKernel(queue, *kernel, 2, NULL,
 		globalThreads, globalLocal,
-		0, NULL, event);
-
+		chain.numWaits(), chain.waits(), chain.nextEvent());
+	chain.advance();
+	if (err == CL_SUCCESS) {
+		statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+	}
 
 	return err;
 
@@ -392,7 +470,7 @@ cl_int diag_dtrtri192(
 	size_t lda,
 	int inner_block_size,
 	int outer_block_size,
-	cl_event *event)
+	TrsmChain &chain)
 {
 
 	const char *diag_dtrtri_kernel_upper_KernelSource = NULL;
@@ -448,12 +526,14 @@ cl_int diag_dtrtri192(
 
 		err = clEnqueueNDRangeKernel(queue, *diag_dtrtri_kernel_upper_ClKernel, 1, NULL,
 			globalThreads, globalLocal,
-			0, NULL, event);
+			chain.numWaits(), chain.waits(), chain.nextEvent());
+		chain.advance();
 
 		if (err != CL_SUCCESS) {
 			//printf( "kernel -diag_dtrtri_kernel_upper- failed with %d\n", err );
 			return err;
 		}
+		statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
 		//clReleaseKernel(diag_dtrtri_kernel_upper);
 		if (err != CL_SUCCESS) {
@@ -474,7 +554,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_12_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -488,7 +568,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_24_PART1_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update192(&triple_dgemm_update_192_24_PART2_R_clKernel,
 					  triple_dgemm_update_192_24_PART2_R_src,
@@ -497,7 +577,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_24_PART2_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -511,7 +591,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_48_PART1_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update192(&triple_dgemm_update_192_48_PART2_R_clKernel,
 					  triple_dgemm_update_192_48_PART2_R_src,
@@ -520,7 +600,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_48_PART2_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -534,7 +614,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_96_PART1_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update192(&triple_dgemm_update_192_96_PART2_R_clKernel,
 					  triple_dgemm_update_192_96_PART2_R_src,
@@ -543,7 +623,7 @@ cl_int diag_dtrtri192(
 					  &triple_dgemm_update_192_96_PART2_R_binSize,
 					  TrtribinBuildOptions,
 					  queue,
-					  A, offA, d_dinvA, i, lda, M, event);
+					  A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -587,6 +667,9 @@ static clblasStatus gpu_dtrsm192(
 	if (order != clblasColumnMajor)
 		return clblasNotImplemented;
 
+	// the DGEMMs are the library's own calls
+	PathInternalScope internal;
+
 	if ((M % 192 == 0) && (N % 192 == 0))
 	{
 		//TODO: the implementation of sub block being 192 only supports
@@ -612,6 +695,8 @@ static clblasStatus gpu_dtrsm192(
 			if (M <= 0 || N <= 0)
 				return clblasInvalidDim;
 
+			TrsmChain chain(numEventsInWaitList, eventWaitList);
+
 			double neg_one = -1.0;
 			double one = 1.0;
 			double zero = 0.0;
@@ -623,9 +708,10 @@ static clblasStatus gpu_dtrsm192(
 			size_t offX = 0; //must be 0: needed by the _(X,i,j) macro
 			size_t size_X = N*ldX * sizeof(double);
 			X = clCreateBuffer(context, CL_MEM_READ_WRITE, size_X, NULL, &err);
-			CL_CHECK(err);
-			err = clearBuffer(commandQueues[0], X, size_X);
-			CL_CHECK(err);
+			TRSM_CHECK(err);
+			statisticsAdd(STAT_TEMP_BYTES, size_X);
+			err = clearBuffer(commandQueues[0], X, size_X, chain);
+			TRSM_CHECK(err);
 
 			// side=R
 			/* invert the diagonals
@@ -639,11 +725,13 @@ static clblasStatus gpu_dtrsm192(
 			size_t offInvA = 0; //must be 0: needed by the _(X,i,j) macro
 			size_t size_InvA = ldInvA * BLOCKS(N, outer_block_size) * outer_block_size *sizeof(double);
 			InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
-			CL_CHECK(err);
-			err = clearBuffer(commandQueues[0], InvA, size_InvA);
-			CL_CHECK(err);
+			TRSM_CHECK(err);
+			statisticsAdd(STAT_TEMP_BYTES, size_InvA);
+			err = clearBuffer(commandQueues[0], InvA, size_InvA, chain);
+			TRSM_CHECK(err);
 
-			diag_dtrtri192(commandQueues[0], N, uplo, diag, A, offA, InvA, lda, inner_block_size, outer_block_size, events);
+			err = diag_dtrtri192(commandQueues[0], N, uplo, diag, A, offA, InvA, lda, inner_block_size, outer_block_size, chain);
+			TRSM_CHECK(err);
 
 			if (transA == clblasNoTrans)
 			{
@@ -662,30 +750,34 @@ static clblasStatus gpu_dtrsm192(
 					/* handle the first block seperately with alpha */
 					int nn = min(outer_block_size, (int)N);
 					//DGEMM_RIGHT(  M, nn, nn, alpha, _(B,0,0), _(InvA,0,0), zero, _(X,0,0) );
-					err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, nn, nn, alpha, B, offB, ldb, InvA, offInvA, ldInvA, zero, X, offX, ldX, 1, commandQueues, 0, NULL, events);
-					CL_CHECK(err);
+					err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, nn, nn, alpha, B, offB, ldb, InvA, offInvA, ldInvA, zero, X, offX, ldX, 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent());
+					chain.advance();
+					TRSM_CHECK(err);
 
 					if (outer_block_size < N)
 					{
 
 						//DGEMM_RIGHT(  M, N-nb, nb, neg_one, _(X,0,0), _(A,0,nb), alpha, _(B,0,nb)  );
-						err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, N - outer_block_size, outer_block_size, neg_one, X, offX, ldX, A, offA + lda*outer_block_size, lda, alpha, B, offB + outer_block_size*ldb, ldb, 1, commandQueues, 0, NULL, events);
-						assert(err == CL_SUCCESS);
+						err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, N - outer_block_size, outer_block_size, neg_one, X, offX, ldX, A, offA + lda*outer_block_size, lda, alpha, B, offB + outer_block_size*ldb, ldb, 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent());
+						chain.advance();
+						TRSM_CHECK(err);
 
 						/* the rest blocks */
 						for (i = outer_block_size; i < N; i += outer_block_size)
 						{
 							nn = min(outer_block_size, (int)N - i);
 							//DGEMM_RIGHT(  M, nn, nn, one, _(B,0,i), _(InvA,0,i), zero, _(X,0,i) );
-							err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, nn, nn, one, B, offB + i*ldb, ldb, InvA, offInvA + i*outer_block_size, ldInvA, zero, X, offX + i*ldX, ldX, 1, commandQueues, 0, NULL, events);
-							assert(err == CL_SUCCESS);
+							err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, nn, nn, one, B, offB + i*ldb, ldb, InvA, offInvA + i*outer_block_size, ldInvA, zero, X, offX + i*ldX, ldX, 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent());
+							chain.advance();
+							TRSM_CHECK(err);
 
 							if (i + outer_block_size >= N)
 								break;
 
 							//DGEMM_RIGHT(  M, N-i-nb, nb, neg_one, _(X,0,i),   _(A,i,i+nb), one, _(B,0,i+nb)  );
-							err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, N - i - outer_block_size, outer_block_size, neg_one, X, offX + i*ldX, ldX, A, offA + i + (outer_block_size + i)*lda, lda, one, B, offB + (i + outer_block_size)*ldb, ldb, 1, commandQueues, 0, NULL, events);
-							assert(err == CL_SUCCESS);
+							err = clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans, M, N - i - outer_block_size, outer_block_size, neg_one, X, offX + i*ldX, ldX, A, offA + i + (outer_block_size + i)*lda, lda, one, B, offB + (i + outer_block_size)*ldb, ldb, 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent());
+							chain.advance();
+							TRSM_CHECK(err);
 						}
 					}
 				}
@@ -711,9 +803,11 @@ static clblasStatus gpu_dtrsm192(
 					  region,
 					  ldX*sizeof(double), 0,
 					  ldb*sizeof(double), 0,
-					  0, NULL,
-					  events);
-				  CL_CHECK(err);
+					  chain.numWaits(), chain.waits(),
+					  chain.nextEvent());
+				  TRSM_CHECK(err);
+				  chain.advance();
+				  chain.finish(events);
 
 				  clReleaseMemObject(InvA);
 				  clReleaseMemObject(X);
@@ -745,7 +839,7 @@ cl_int call_kernel_triple_update128(
 	int i,
 	unsigned int lda,
 	int M,
-	cl_event *event)
+	TrsmChain &chain)
 {
 	cl_int err = 0;
 
@@ -780,8 +874,11 @@ cl_int call_kernel_triple_update128(
 
 	err = clEnqueueNDRangeKernel(queue, *kernel, 2, NULL,
 		globalThreads, globalLocal,
-		0, NULL, event);
-
+		chain.numWaits(), chain.waits(), chain.nextEvent());
+	chain.advance();
+	if (err == CL_SUCCESS) {
+		statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+	}
 
 	return err;
 }
@@ -798,7 +895,7 @@ cl_int diag_dtrtri128(
 	size_t lda,
 	int inner_block_size,
 	int outer_block_size,
-	cl_event *event)
+	TrsmChain &chain)
 {
 	const char *diag_dtrtri_kernel_upper_KernelSource = NULL;
 	cl_kernel  *diag_dtrtri_kernel_upper_ClKernel = NULL;
@@ -850,12 +947,14 @@ cl_int diag_dtrtri128(
 
 		err = clEnqueueNDRangeKernel(queue, *diag_dtrtri_kernel_lower_ClKernel, 1, NULL,
 			globalThreads, globalLocal,
-			0, NULL, event);
+			chain.numWaits(), chain.waits(), chain.nextEvent());
+		chain.advance();
 
 		if (err != CL_SUCCESS) {
 			//printf( "kernel -diag_dtrtri_kernel_lower- failed with %d\n", err );
 			return err;
 		}
+		statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 
 
 
@@ -873,7 +972,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_16_PART1_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_16_PART2_L_clKernel,
 					triple_dgemm_update_128_16_PART2_L_src,
@@ -882,7 +981,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_16_PART2_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -896,7 +995,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_32_PART1_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_32_PART2_L_clKernel,
 					triple_dgemm_update_128_32_PART2_L_src,
@@ -905,7 +1004,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_32_PART2_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -919,7 +1018,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_64_PART1_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_64_PART2_L_clKernel,
 					triple_dgemm_update_128_64_PART2_L_src,
@@ -928,7 +1027,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_64_PART2_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -943,7 +1042,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART1_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_ABOVE64_PART2_L_clKernel,
 					triple_dgemm_update_128_ABOVE64_PART2_L_src,
@@ -952,7 +1051,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART2_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_ABOVE64_PART3_L_clKernel,
 					triple_dgemm_update_128_ABOVE64_PART3_L_src,
@@ -961,7 +1060,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART3_L_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 
@@ -1006,6 +1105,7 @@ cl_int diag_dtrtri128(
 			globalThreads, globalLocal,
 			0, NULL, NULL);
 		CL_CHECK(err);
+		statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
 		//err = clFinish(queue);
 		//CL_CHECK(err);
 
@@ -1034,7 +1134,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_16_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				//err = clFinish(queue);
 				//CL_CHECK(err);
@@ -1051,7 +1151,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_32_PART1_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_32_PART2_R_clKernel,
 					triple_dgemm_update_128_32_PART2_R_src,
@@ -1060,7 +1160,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_32_PART2_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 
 				break;
@@ -1076,7 +1176,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_64_PART1_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_64_PART2_R_clKernel,
 					triple_dgemm_update_128_64_PART2_R_src,
@@ -1085,7 +1185,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_64_PART2_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 
 				break;
@@ -1101,7 +1201,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART1_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_ABOVE64_PART2_R_clKernel,
 					triple_dgemm_update_128_ABOVE64_PART2_R_src,
@@ -1110,7 +1210,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART2_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				err = call_kernel_triple_update128(&triple_dgemm_update_128_ABOVE64_PART3_R_clKernel,
 					triple_dgemm_update_128_ABOVE64_PART3_R_src,
@@ -1119,7 +1219,7 @@ cl_int diag_dtrtri128(
 					&triple_dgemm_update_128_ABOVE64_PART3_R_binSize,
 					TrtribinBuildOptions,
 					queue,
-					A, offA, d_dinvA, i, lda, M, event);
+					A, offA, d_dinvA, i, lda, M, chain);
 				CL_CHECK(err);
 				break;
 			}
@@ -1158,6 +1258,8 @@ static clblasStatus gpu_dtrsm128(
 	if (order != clblasColumnMajor)
 		return clblasNotImplemented;
 
+	// the DGEMMs are the library's own calls
+	PathInternalScope internal;
 
 	int inner_block_size = 16; // inner blocking size, <=32
 	int outer_block_size = 128;// outer blocking size, >BLOCK_SIZE
@@ -1173,6 +1275,8 @@ static clblasStatus gpu_dtrsm128(
 	if (M <= 0 || N <= 0)
 		return clblasInvalidDim;
 
+	TrsmChain chain(numEventsInWaitList, eventWaitList);
+
 	double neg_one = -1.0;
 	double one = 1.0;
 	double zero = 0.0;
@@ -1187,9 +1291,10 @@ static clblasStatus gpu_dtrsm128(
 	size_t offX = 0; //must be 0: needed by the _(X,i,j) macro
 	size_t size_X = N*ldX * sizeof(double);
 	X = clCreateBuffer(context, CL_MEM_READ_WRITE, size_X, NULL, &err);
-	CL_CHECK(err);
-	err = clearBuffer(commandQueues[0], X, size_X);
-	CL_CHECK(err);
+	TRSM_CHECK(err);
+	statisticsAdd(STAT_TEMP_BYTES, size_X);
+	err = clearBuffer(commandQueues[0], X, size_X, chain);
+	TRSM_CHECK(err);
 
 	if (side == clblasLeft)
 	{
@@ -1202,12 +1307,13 @@ static clblasStatus gpu_dtrsm128(
 		size_t size_InvA = ldInvA * BLOCKS(M, outer_block_size) * outer_block_size *sizeof(double);
 		InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
 
-		CL_CHECK(err);
-		err = clearBuffer(commandQueues[0], InvA, size_InvA);
-		CL_CHECK(err);
+		TRSM_CHECK(err);
+		statisticsAdd(STAT_TEMP_BYTES, size_InvA);
+		err = clearBuffer(commandQueues[0], InvA, size_InvA, chain);
+		TRSM_CHECK(err);
 
-		err = diag_dtrtri128(commandQueues[0], M, uplo, diag, A, offA, InvA, ldA, inner_block_size, outer_block_size, events);
-		CL_CHECK(err);
+		err = diag_dtrtri128(commandQueues[0], M, uplo, diag, A, offA, InvA, ldA, inner_block_size, outer_block_size, chain);
+		TRSM_CHECK(err);
 
 		//
 		// Helper for C = alpha * transp(A) * B + beta * C
@@ -1218,8 +1324,9 @@ static clblasStatus gpu_dtrsm128(
 		//
 #define DGEMM_LEFT(m, n, k, alpha, A,  B, beta,  C) \
     do { \
-        err = clblasDgemm(clblasColumnMajor, transA, clblasNoTrans , m, n, k, alpha, A, B, beta, C , 1, commandQueues, 0, NULL, events ) ; \
-        CL_CHECK(err); \
+        err = clblasDgemm(clblasColumnMajor, transA, clblasNoTrans , m, n, k, alpha, A, B, beta, C , 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent() ) ; \
+        TRSM_CHECK(err); \
+        chain.advance(); \
 	    } while(0)
 
 
@@ -1343,8 +1450,9 @@ static clblasStatus gpu_dtrsm128(
 		//
 #define DGEMM_RIGHT(m,n,k, alpha,  B, A, beta, C )   \
     do { \
-      err = clblasDgemm(clblasColumnMajor, clblasNoTrans, transA , m, n, k, alpha, B, A, beta, C , 1, commandQueues, 0, NULL, events ) ; \
-      CL_CHECK(err); \
+      err = clblasDgemm(clblasColumnMajor, clblasNoTrans, transA , m, n, k, alpha, B, A, beta, C , 1, commandQueues, chain.numWaits(), chain.waits(), chain.nextEvent() ) ; \
+      TRSM_CHECK(err); \
+      chain.advance(); \
 	    } while(0)
 
 
@@ -1360,12 +1468,13 @@ static clblasStatus gpu_dtrsm128(
 		size_t offInvA = 0; //must be 0: needed by the _(X,i,j) macro
 		size_t size_InvA = ldInvA * BLOCKS(N, outer_block_size) * outer_block_size *sizeof(double);
 		InvA = clCreateBuffer(context, CL_MEM_READ_WRITE, size_InvA, NULL, &err);
-		CL_CHECK(err);
-		err = clearBuffer(commandQueues[0], InvA, size_InvA);
-		CL_CHECK(err);
+		TRSM_CHECK(err);
+		statisticsAdd(STAT_TEMP_BYTES, size_InvA);
+		err = clearBuffer(commandQueues[0], InvA, size_InvA, chain);
+		TRSM_CHECK(err);
 
-		err = diag_dtrtri128(commandQueues[0], N, uplo, diag, A, offA, InvA, ldA, inner_block_size, outer_block_size, events);
-		CL_CHECK(err);
+		err = diag_dtrtri128(commandQueues[0], N, uplo, diag, A, offA, InvA, ldA, inner_block_size, outer_block_size, chain);
+		TRSM_CHECK(err);
 
 
 		if (transA == clblasNoTrans)
@@ -1492,9 +1601,11 @@ static clblasStatus gpu_dtrsm128(
 		  region,
 		  ldX*sizeof(double), 0,
 		  ldB*sizeof(double), 0,
-		  0, NULL,
-		  events);
-	  CL_CHECK(err);
+		  chain.numWaits(), chain.waits(),
+		  chain.nextEvent());
+	  TRSM_CHECK(err);
+	  chain.advance();
+	  chain.finish(events);
 
 	  clReleaseMemObject(InvA);
 	  clReleaseMemObject(X);
@@ -1532,6 +1643,7 @@ cl_event *events)
 	ListHead seq;
 	size_t msize;
 	clblasStatus retCode = clblasSuccess;
+	bool handled;
 
 	if (!clblasInitialized) {
 		return clblasNotInitialized;
@@ -1553,6 +1665,13 @@ cl_event *events)
 		return retCode;
 	}
 
+	retCode = trxmRecursive(CLBLAS_TRSM, kargs, order, side, uplo, transA, diag,
+		M, N, A, offA, lda, B, offB, ldb, numCommandQueues, commandQueues,
+		numEventsInWaitList, eventWaitList, events, &handled);
+	if (handled) {
+		return retCode;
+	}
+
 	kargs->order = order;
 	kargs->side = side;
 	kargs->uplo = uplo;
@@ -1579,6 +1698,14 @@ cl_event *events)
 	kargs->offsetN = 0;
 	kargs->scimage[0] = 0;
 
+	int strict;
+	ImplPath path = trxmPinnedPath(CLBLAS_TRSM, kargs->dtype, side, uplo,
+		transA, M, N, &strict);
+	kargs->pattern = pathPattern(CLBLAS_TRSM, path);
+	if (strict && (kargs->pattern == 0)) {
+		return clblasNotImplemented;
+	}
+
 #ifndef TRXM_MULTIPLE_QUEUES
 	if (numCommandQueues != 0) {
 		numCommandQueues = 1;
@@ -1630,6 +1757,8 @@ clblasStrsm(
 
    cl_command_queue queue = commandQueues[0];
 
+   statisticsEnter(CLBLAS_TRSM, TYPE_FLOAT);
+
    clblasStrsmFunctor::Args args(order,
                                  side,
                                  uplo,
@@ -1656,6 +1785,7 @@ clblasStrsm(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
@@ -1694,6 +1824,8 @@ clblasDtrsm(
 
    cl_command_queue queue = commandQueues[0];
 
+   statisticsEnter(CLBLAS_TRSM, TYPE_DOUBLE);
+
    clblasDtrsmFunctor::Args args(order,
                                  side,
                                  uplo,
@@ -1716,50 +1848,64 @@ clblasDtrsm(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 
 #else
 	bool specialCaseHandled = false;
 
-	//outer block size = 192
-	//inner block size = 12
+	statisticsEnter(CLBLAS_TRSM, TYPE_DOUBLE);
+
+	int strict;
+	ImplPath path = trxmPinnedPath(CLBLAS_TRSM, TYPE_DOUBLE, side, uplo,
+		transA, M, N, &strict);
 	clblasStatus SpecialCaseStatus;
-	SpecialCaseStatus = gpu_dtrsm192(order,
-		side,
-		uplo,
-		transA,
-		diag,
-		M, N,
-		alpha,
-		A, offA, lda,
-		B, offB, ldb,
-		numCommandQueues, commandQueues,
-		numEventsInWaitList,
-		eventWaitList,
-		events,
-		specialCaseHandled);
-
-	if (specialCaseHandled)
-		return SpecialCaseStatus;
-
-	SpecialCaseStatus = gpu_dtrsm128(order,
-		side,
-		uplo,
-		transA,
-		diag,
-		M, N,
-		alpha,
-		A, offA, lda,
-		B, offB, ldb,
-		numCommandQueues, commandQueues,
-		numEventsInWaitList,
-		eventWaitList,
-		events,
-		specialCaseHandled);
-
-	if (specialCaseHandled)
-		return SpecialCaseStatus;
+
+	// the blocked kernels are left out when another path is pinned
+	if ((path == PATH_DEFAULT) || (path == PATH_DTRSM)) {
+		//outer block size = 192
+		//inner block size = 12
+		SpecialCaseStatus = gpu_dtrsm192(order,
+			side,
+			uplo,
+			transA,
+			diag,
+			M, N,
+			alpha,
+			A, offA, lda,
+			B, offB, ldb,
+			numCommandQueues, commandQueues,
+			numEventsInWaitList,
+			eventWaitList,
+			events,
+			specialCaseHandled);
+
+		if (specialCaseHandled) {
+			statisticsLeave();
+			return SpecialCaseStatus;
+		}
+
+		SpecialCaseStatus = gpu_dtrsm128(order,
+			side,
+			uplo,
+			transA,
+			diag,
+			M, N,
+			alpha,
+			A, offA, lda,
+			B, offB, ldb,
+			numCommandQueues, commandQueues,
+			numEventsInWaitList,
+			eventWaitList,
+			events,
+			specialCaseHandled);
+
+		if (specialCaseHandled) {
+			statisticsLeave();
+			return SpecialCaseStatus;
+		}
+	}
 
 
    CLBlasKargs kargs;
@@ -1768,7 +1914,7 @@ clblasDtrsm(
    kargs.dtype = TYPE_DOUBLE;
    kargs.alpha.argDouble = alpha;
 
-   return doTrsm(&kargs,
+   SpecialCaseStatus = doTrsm(&kargs,
 	   order,
 	   side,
 	   uplo,
@@ -1781,6 +1927,9 @@ clblasDtrsm(
 	   numEventsInWaitList,
 	   eventWaitList,
 	   events);
+   statisticsLeave();
+
+   return SpecialCaseStatus;
 #endif
 }
 
@@ -1817,6 +1966,8 @@ clblasCtrsm(
 
    cl_command_queue queue = commandQueues[0];
 
+   statisticsEnter(CLBLAS_TRSM, TYPE_COMPLEX_FLOAT);
+
    clblasCtrsmFunctor::Args args(order,
                                  side,
                                  uplo,
@@ -1843,6 +1994,7 @@ clblasCtrsm(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
@@ -1880,6 +2032,8 @@ clblasZtrsm(
 
    cl_command_queue queue = commandQueues[0];
 
+   statisticsEnter(CLBLAS_TRSM, TYPE_COMPLEX_DOUBLE);
+
    clblasZtrsmFunctor::Args args(order,
                                  side,
                                  uplo,
@@ -1906,6 +2060,7 @@ clblasZtrsm(
    clblasStatus res = functor->execute(args);
 
    functor->release();
+   statisticsLeave();
 
    return res;
 }
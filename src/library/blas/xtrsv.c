@@ -23,6 +23,7 @@
 #include <devinfo.h>
 #include "clblas-internal.h"
 #include "solution_seq.h"
+#include "statistics.h"
 
 //#define DEBUG_TRSV
 
@@ -395,6 +396,8 @@ doTrsv(
 		return clblasInvalidCommandQueue;
 	}
 
+	statisticsEnter(kargs->pigFuncID, kargs->dtype);
+
 	numCommandQueues = 1; // NOTE: Hard-coding the number of command queues to 1
     kargs->order = order;
     kargs->uplo = uplo;
@@ -462,6 +465,7 @@ doTrsv(
 		printf("doTrsv(): REFCNT EXIT = %u\n", refcnt);
 	}
 	#endif
+    statisticsLeave();
     return  err;
 }
 
@@ -0,0 +1,646 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+/*
+ * Recursive GEMM-based TRSM and TRMM.
+ *
+ * After the row major problem is turned into the column major one, op(A)
+ * for clblasLeft, or op(A)' for clblasRight, is a lower or an upper
+ * triangle S applied to the vectors of B: its columns for clblasLeft, its
+ * rows for clblasRight. With S split in S11, S21 (or S12) and S22 and the
+ * vectors in the matching parts B1 and B2, a lower S solves
+ *
+ *     B1 = S11^-1 alpha B1,  B2 = alpha B2 - S21 B1,  B2 = S22^-1 B2
+ *
+ * and multiplies
+ *
+ *     B2 = alpha S22 B2,  B2 += alpha S21 B1,  B1 = alpha S11 B1
+ *
+ * with the parts taking the other order for an upper S. The update is one
+ * GEMM on an off-diagonal block of A; the diagonal blocks recurse down to
+ * TRXM_NB rows, which the diagonal kernel handles in local memory.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <clBLAS.h>
+
+#include "xgemm.h" //helper functions defined in xgemm.cpp
+#include "statistics.h"
+#include "trxm_recursive.h"
+#include "path_table.h"
+
+/******************************************************************************
+ * Kernel geometry; must match the kernel source below
+ *****************************************************************************/
+#define TRXM_NB      32
+#define TRXM_WG_SIZE 64
+
+#define TRXM_STR_(x) #x
+#define TRXM_STR(x)  TRXM_STR_(x)
+
+// diagonal kernel flags
+#define TRXM_FLAG_MULTIPLY  0x01   // TRMM rather than TRSM
+#define TRXM_FLAG_RIGHT     0x02   // vectors are the rows of B
+#define TRXM_FLAG_UPPER     0x04   // A is stored in the upper triangle
+#define TRXM_FLAG_TRANS     0x08   // op(A) is a transpose
+#define TRXM_FLAG_CONJ      0x10   // op(A) is a conjugate transpose
+#define TRXM_FLAG_UNIT      0x20   // unit diagonal
+#define TRXM_FLAG_LOWER_S   0x40   // S is lower triangular
+
+/******************************************************************************
+ * Kernel source. Every work group loads S, the n x n diagonal block of A
+ * seen through op() and the side, into local memory; every work item then
+ * solves or multiplies one vector of B, kept in private memory.
+ *****************************************************************************/
+#define TRXM_DIAGONAL_SRC \
+"#define NB " TRXM_STR(TRXM_NB) "\n" \
+"\n" \
+"__kernel __attribute__((reqd_work_group_size(" TRXM_STR(TRXM_WG_SIZE) ", 1, 1)))\n" \
+"void trxmDiagonal(\n" \
+"    __global const TYPE *A, uint offA, uint lda,\n" \
+"    __global TYPE *B, uint offB, uint ldb,\n" \
+"    uint n, uint count, TYPE alpha, uint flags)\n" \
+"{\n" \
+"    __local TYPE S[NB * NB];\n" \
+"    TYPE x[NB];\n" \
+"    TYPE s;\n" \
+"    const uint v = get_global_id(0);\n" \
+"    const uint swap = ((flags & " TRXM_STR(TRXM_FLAG_RIGHT) ") != 0) !=\n" \
+"                      ((flags & " TRXM_STR(TRXM_FLAG_TRANS) ") != 0);\n" \
+"    const uint upperA = (flags & " TRXM_STR(TRXM_FLAG_UPPER) ") != 0;\n" \
+"    const uint lowerS = (flags & " TRXM_STR(TRXM_FLAG_LOWER_S) ") != 0;\n" \
+"    const uint strideV = (flags & " TRXM_STR(TRXM_FLAG_RIGHT) ") ? 1 : ldb;\n" \
+"    const uint strideI = (flags & " TRXM_STR(TRXM_FLAG_RIGHT) ") ? ldb : 1;\n" \
+"    uint i, j, k;\n" \
+"\n" \
+"    for (k = get_local_id(0); k < NB * NB; k += " TRXM_STR(TRXM_WG_SIZE) ") {\n" \
+"        i = k / NB;\n" \
+"        j = k % NB;\n" \
+"        s = ZERO;\n" \
+"        if ((i < n) && (j < n)) {\n" \
+"            const uint r = swap ? j : i;\n" \
+"            const uint c = swap ? i : j;\n" \
+"            if ((r == c) && (flags & " TRXM_STR(TRXM_FLAG_UNIT) ")) {\n" \
+"                s = ONE;\n" \
+"            }\n" \
+"            else if (upperA ? (r <= c) : (r >= c)) {\n" \
+"                s = A[offA + c * lda + r];\n" \
+"                if (flags & " TRXM_STR(TRXM_FLAG_CONJ) ") {\n" \
+"                    s = CONJ(s);\n" \
+"                }\n" \
+"            }\n" \
+"        }\n" \
+"        S[k] = s;\n" \
+"    }\n" \
+"    barrier(CLK_LOCAL_MEM_FENCE);\n" \
+"\n" \
+"    if (v >= count) {\n" \
+"        return;\n" \
+"    }\n" \
+"    B += offB + v * strideV;\n" \
+"    for (i = 0; i < n; i++) {\n" \
+"        x[i] = B[i * strideI];\n" \
+"    }\n" \
+"\n" \
+"    if (flags & " TRXM_STR(TRXM_FLAG_MULTIPLY) ") {\n" \
+"        /* x[i] is overwritten after its last use by the rows left */\n" \
+"        for (k = 0; k < n; k++) {\n" \
+"            i = lowerS ? (n - 1 - k) : k;\n" \
+"            s = ZERO;\n" \
+"            for (j = lowerS ? 0 : i; j < (lowerS ? i + 1 : n); j++) {\n" \
+"                s += MUL(S[i * NB + j], x[j]);\n" \
+"            }\n" \
+"            x[i] = MUL(alpha, s);\n" \
+"        }\n" \
+"    }\n" \
+"    else {\n" \
+"        for (k = 0; k < n; k++) {\n" \
+"            i = lowerS ? k : (n - 1 - k);\n" \
+"            s = MUL(alpha, x[i]);\n" \
+"            for (j = lowerS ? 0 : i + 1; j < (lowerS ? i : n); j++) {\n" \
+"                s -= MUL(S[i * NB + j], x[j]);\n" \
+"            }\n" \
+"            x[i] = DIV(s, S[i * NB + i]);\n" \
+"        }\n" \
+"    }\n" \
+"\n" \
+"    for (i = 0; i < n; i++) {\n" \
+"        B[i * strideI] = x[i];\n" \
+"    }\n" \
+"}\n"
+
+#define TRXM_REAL_DEFS \
+"#define ZERO 0\n" \
+"#define ONE 1\n" \
+"#define CONJ(a) (a)\n" \
+"#define MUL(a, b) ((a) * (b))\n" \
+"#define DIV(a, b) ((a) / (b))\n"
+
+#define TRXM_COMPLEX_DEFS \
+"#define ZERO ((TYPE)(0, 0))\n" \
+"#define ONE ((TYPE)(1, 0))\n" \
+"#define CONJ(a) ((TYPE)((a).x, -(a).y))\n" \
+"#define MUL(a, b) ((TYPE)((a).x * (b).x - (a).y * (b).y, " \
+                          "(a).x * (b).y + (a).y * (b).x))\n" \
+"#define DIV(a, b) (MUL(a, CONJ(b)) / ((b).x * (b).x + (b).y * (b).y))\n"
+
+#define TRXM_FP64_DEFS \
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+
+/*
+ * Kernels are cached by makeGemmKernel() by the address of their source,
+ * so every precision has a source of its own.
+ */
+template<typename Precision>
+struct TrxmTraits
+{
+  static const char *diagonal;
+};
+
+template<> const char *TrxmTraits<cl_float>::diagonal =
+  "#define TYPE float\n" TRXM_REAL_DEFS TRXM_DIAGONAL_SRC;
+template<> const char *TrxmTraits<cl_double>::diagonal =
+  TRXM_FP64_DEFS "#define TYPE double\n" TRXM_REAL_DEFS TRXM_DIAGONAL_SRC;
+template<> const char *TrxmTraits<FloatComplex>::diagonal =
+  "#define TYPE float2\n" TRXM_COMPLEX_DEFS TRXM_DIAGONAL_SRC;
+template<> const char *TrxmTraits<DoubleComplex>::diagonal =
+  TRXM_FP64_DEFS "#define TYPE double2\n" TRXM_COMPLEX_DEFS TRXM_DIAGONAL_SRC;
+
+/******************************************************************************
+ * Scalars per precision
+ *****************************************************************************/
+template<typename Precision>
+static Precision trxmScalar(const ArgMultiplier &arg);
+template<>
+cl_float trxmScalar<cl_float>(const ArgMultiplier &arg) { return arg.argFloat; }
+template<>
+cl_double trxmScalar<cl_double>(const ArgMultiplier &arg) { return arg.argDouble; }
+template<>
+FloatComplex trxmScalar<FloatComplex>(const ArgMultiplier &arg) { return arg.argFloatComplex; }
+template<>
+DoubleComplex trxmScalar<DoubleComplex>(const ArgMultiplier &arg) { return arg.argDoubleComplex; }
+
+template<typename Precision>
+static Precision
+trxmReal(double v)
+{
+  return Precision(v);
+}
+
+template<>
+FloatComplex
+trxmReal<FloatComplex>(double v)
+{
+  FloatComplex r;
+  CREAL(r) = (cl_float)v;
+  CIMAG(r) = 0;
+  return r;
+}
+
+template<>
+DoubleComplex
+trxmReal<DoubleComplex>(double v)
+{
+  DoubleComplex r;
+  CREAL(r) = v;
+  CIMAG(r) = 0;
+  return r;
+}
+
+/******************************************************************************
+ * Column major C = alpha op(A) op(B) + beta C per precision
+ *****************************************************************************/
+static clblasStatus
+trxmGemm(clblasTranspose transA, clblasTranspose transB,
+         cl_uint M, cl_uint N, cl_uint K, cl_float alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb, cl_float beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue, cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList, cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasSgemm(clblasColumnMajor, transA, transB, M, N, K,
+    alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+static clblasStatus
+trxmGemm(clblasTranspose transA, clblasTranspose transB,
+         cl_uint M, cl_uint N, cl_uint K, cl_double alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb, cl_double beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue, cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList, cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasDgemm(clblasColumnMajor, transA, transB, M, N, K,
+    alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+static clblasStatus
+trxmGemm(clblasTranspose transA, clblasTranspose transB,
+         cl_uint M, cl_uint N, cl_uint K, FloatComplex alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb, FloatComplex beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue, cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList, cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasCgemm(clblasColumnMajor, transA, transB, M, N, K,
+    alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+static clblasStatus
+trxmGemm(clblasTranspose transA, clblasTranspose transB,
+         cl_uint M, cl_uint N, cl_uint K, DoubleComplex alpha,
+         cl_mem A, cl_uint offA, cl_uint lda,
+         cl_mem B, cl_uint offB, cl_uint ldb, DoubleComplex beta,
+         cl_mem C, cl_uint offC, cl_uint ldc,
+         cl_command_queue *queue, cl_uint numEventsInWaitList,
+         const cl_event *eventWaitList, cl_event *event)
+{
+  PathInternalScope internal;
+
+  return clblasZgemm(clblasColumnMajor, transA, transB, M, N, K,
+    alpha, A, offA, lda, B, offB, ldb, beta, C, offC, ldc,
+    1, queue, numEventsInWaitList, eventWaitList, event);
+}
+
+/******************************************************************************
+ * The column major problem. Commands are chained with events; each waits
+ * for the previous one, the first for the caller's wait list. The chain
+ * stops at the first error.
+ *****************************************************************************/
+template<typename Precision>
+struct TrxmProblem
+{
+  bool multiply;
+  clblasSide side;
+  clblasUplo uplo;
+  clblasTranspose trans;
+  bool lowerS;
+  cl_uint flags;
+  cl_uint count;        // number of vectors of B
+  cl_mem A;
+  cl_uint offA, lda;
+  cl_mem B;
+  cl_uint offB, ldb;
+  cl_kernel kernel;
+
+  cl_command_queue queue;
+  cl_uint numEventsInWaitList;
+  const cl_event *eventWaitList;
+  cl_event prev;
+  cl_int err;
+
+  cl_uint numWaits() const
+  {
+    return (prev != NULL) ? 1 : numEventsInWaitList;
+  }
+
+  const cl_event *waits() const
+  {
+    return (prev != NULL) ? &prev : eventWaitList;
+  }
+
+  void advance(cl_event next)
+  {
+    if (prev != NULL) {
+      clReleaseEvent(prev);
+    }
+    prev = next;
+  }
+
+  // offset in B of the part starting at element 'd' of every vector
+  cl_uint partB(cl_uint d) const
+  {
+    return (side == clblasLeft) ? offB + d : offB + d * ldb;
+  }
+};
+
+/******************************************************************************
+ * The diagonal block of n <= TRXM_NB rows starting at row 'd' of A
+ *****************************************************************************/
+template<typename Precision>
+static void
+trxmDiagonal(TrxmProblem<Precision> &p, cl_uint d, cl_uint n, Precision alpha)
+{
+  const cl_uint offA = p.offA + d * p.lda + d;
+  const cl_uint offB = p.partB(d);
+  const size_t localSize[1] = { TRXM_WG_SIZE };
+  const size_t globalSize[1] = {
+    ((p.count + TRXM_WG_SIZE - 1) / TRXM_WG_SIZE) * (size_t)TRXM_WG_SIZE };
+  const size_t argSizes[] = {
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_mem), sizeof(cl_uint), sizeof(cl_uint),
+    sizeof(cl_uint), sizeof(cl_uint), sizeof(Precision), sizeof(cl_uint) };
+  const void *args[] = {
+    &p.A, &offA, &p.lda,
+    &p.B, &offB, &p.ldb,
+    &n, &p.count, &alpha, &p.flags };
+  cl_event next = NULL;
+
+  if (p.err != CL_SUCCESS) {
+    return;
+  }
+  for (cl_uint i = 0; p.err == CL_SUCCESS && i < sizeof(args) / sizeof(args[0]); i++) {
+    p.err = clSetKernelArg(p.kernel, i, argSizes[i], args[i]);
+  }
+  if (p.err == CL_SUCCESS) {
+    p.err = clEnqueueNDRangeKernel(p.queue, p.kernel, 1, NULL,
+      globalSize, localSize, p.numWaits(), p.waits(), &next);
+  }
+  if (p.err == CL_SUCCESS) {
+    statisticsAdd(STAT_KERNEL_LAUNCHES, 1);
+    p.advance(next);
+  }
+}
+
+/******************************************************************************
+ * Part 'dst' of the vectors = alpha * S(dst, src) * part 'src' + beta * part
+ * 'dst', with S(dst, src) the off-diagonal block of S of the triangle of
+ * n1 + n2 rows starting at row 'd' of A
+ *****************************************************************************/
+template<typename Precision>
+static void
+trxmOffDiagonal(TrxmProblem<Precision> &p, cl_uint d, cl_uint n1, cl_uint n2,
+                Precision alpha, Precision beta)
+{
+  // the only stored block off the diagonal
+  const cl_uint offA = (p.uplo == clblasLower) ?
+    p.offA + d * p.lda + d + n1 : p.offA + (d + n1) * p.lda + d;
+  const cl_uint src = p.lowerS ? d : d + n1;
+  const cl_uint dst = p.lowerS ? d + n1 : d;
+  const cl_uint nSrc = p.lowerS ? n1 : n2;
+  const cl_uint nDst = p.lowerS ? n2 : n1;
+  cl_event next = NULL;
+
+  if (p.err != CL_SUCCESS) {
+    return;
+  }
+  if (p.side == clblasLeft) {
+    p.err = trxmGemm(p.trans, clblasNoTrans, nDst, p.count, nSrc, alpha,
+      p.A, offA, p.lda, p.B, p.partB(src), p.ldb, beta,
+      p.B, p.partB(dst), p.ldb,
+      &p.queue, p.numWaits(), p.waits(), &next);
+  }
+  else {
+    p.err = trxmGemm(clblasNoTrans, p.trans, p.count, nDst, nSrc, alpha,
+      p.B, p.partB(src), p.ldb, p.A, offA, p.lda, beta,
+      p.B, p.partB(dst), p.ldb,
+      &p.queue, p.numWaits(), p.waits(), &next);
+  }
+  if (p.err == CL_SUCCESS) {
+    p.advance(next);
+  }
+}
+
+/******************************************************************************
+ * The triangle of n rows starting at row 'd' of A
+ *****************************************************************************/
+template<typename Precision>
+static void
+trxmRecurse(TrxmProblem<Precision> &p, cl_uint d, cl_uint n, Precision alpha)
+{
+  if (n <= TRXM_NB) {
+    trxmDiagonal(p, d, n, alpha);
+    return;
+  }
+
+  // the first part is kept a multiple of the diagonal blocks
+  const cl_uint n1 = ((n / 2 + TRXM_NB - 1) / TRXM_NB) * TRXM_NB;
+  const cl_uint n2 = n - n1;
+  const cl_uint first = p.lowerS ? d : d + n1;
+  const cl_uint second = p.lowerS ? d + n1 : d;
+  const cl_uint nFirst = p.lowerS ? n1 : n2;
+  const cl_uint nSecond = p.lowerS ? n2 : n1;
+  const Precision one = trxmReal<Precision>(1);
+
+  if (p.multiply) {
+    // the destination of the update is done first, while the source holds B
+    trxmRecurse(p, second, nSecond, alpha);
+    trxmOffDiagonal(p, d, n1, n2, alpha, one);
+    trxmRecurse(p, first, nFirst, alpha);
+  }
+  else {
+    trxmRecurse(p, first, nFirst, alpha);
+    trxmOffDiagonal(p, d, n1, n2, trxmReal<Precision>(-1), alpha);
+    trxmRecurse(p, second, nSecond, one);
+  }
+}
+
+/******************************************************************************
+ * Row major -> column major, then the recursion over the whole triangle
+ *****************************************************************************/
+template<typename Precision>
+static clblasStatus
+trxmRecursiveType(
+    bool multiply,
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    cl_uint M, cl_uint N,
+    cl_mem A, cl_uint offA, cl_uint lda,
+    cl_mem B, cl_uint offB, cl_uint ldb,
+    cl_command_queue queue,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *event)
+{
+  TrxmProblem<Precision> p;
+
+  /*
+   * Row major B is the transpose of the column major one, and so is A, so
+   * the side and the triangle of A flip while op() is kept.
+   */
+  if (order == clblasRowMajor) {
+    cl_uint t = M;
+
+    M = N;
+    N = t;
+    side = (side == clblasLeft) ? clblasRight : clblasLeft;
+    uplo = (uplo == clblasUpper) ? clblasLower : clblasUpper;
+  }
+
+  bool lowerOp = (uplo == clblasLower) == (transA == clblasNoTrans);
+
+  p.multiply = multiply;
+  p.side = side;
+  p.uplo = uplo;
+  p.trans = transA;
+  p.lowerS = (lowerOp != (side == clblasRight));
+  p.count = (side == clblasLeft) ? N : M;
+  p.A = A;
+  p.offA = offA;
+  p.lda = lda;
+  p.B = B;
+  p.offB = offB;
+  p.ldb = ldb;
+  p.kernel = NULL;
+  p.queue = queue;
+  p.numEventsInWaitList = numEventsInWaitList;
+  p.eventWaitList = eventWaitList;
+  p.prev = NULL;
+  p.err = CL_SUCCESS;
+
+  p.flags = (multiply ? TRXM_FLAG_MULTIPLY : 0) |
+            ((side == clblasRight) ? TRXM_FLAG_RIGHT : 0) |
+            ((uplo == clblasUpper) ? TRXM_FLAG_UPPER : 0) |
+            ((transA != clblasNoTrans) ? TRXM_FLAG_TRANS : 0) |
+            ((transA == clblasConjTrans) ? TRXM_FLAG_CONJ : 0) |
+            ((diag == clblasUnit) ? TRXM_FLAG_UNIT : 0) |
+            (p.lowerS ? TRXM_FLAG_LOWER_S : 0);
+
+  const unsigned char *noBinary = NULL;
+  size_t noBinarySize = 0;
+
+  makeGemmKernel(&p.kernel, queue, TrxmTraits<Precision>::diagonal,
+    "", &noBinary, &noBinarySize, "");
+
+  trxmRecurse(p, 0, (side == clblasLeft) ? M : N,
+              trxmScalar<Precision>(kargs->alpha));
+
+  if (p.err == CL_SUCCESS && event != NULL) {
+    *event = p.prev;
+  }
+  else if (p.prev != NULL) {
+    clReleaseEvent(p.prev);
+  }
+  return static_cast<clblasStatus>(p.err);
+}
+
+/******************************************************************************
+ * Smallest order of the triangle taking the recursive path, 0 if disabled.
+ * Read on every call so that it can be switched per problem.
+ *****************************************************************************/
+static size_t
+trxmRecursiveThreshold(void)
+{
+  const char *env = getenv("AMD_CLBLAS_TRXM_RECURSIVE");
+  int threshold = (env != NULL) ? atoi(env) : 1024;
+
+  return (threshold <= 0) ? 0 : static_cast<size_t>(threshold);
+}
+
+/******************************************************************************
+ * The problem is left to the other paths, unless the recursion is pinned
+ * strictly and the call must fail
+ *****************************************************************************/
+static clblasStatus
+trxmNotRecursive(bool mustRecurse, bool *handled)
+{
+  *handled = mustRecurse;
+  return mustRecurse ? clblasNotImplemented : clblasSuccess;
+}
+
+/******************************************************************************
+ * Entry point of xtrsm.cc, functor_xtrsm.cc and xtrmm.c
+ *****************************************************************************/
+extern "C"
+clblasStatus
+trxmRecursive(
+    BlasFunctionID funcID,
+    const CLBlasKargs *kargs,
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    const cl_mem A,
+    size_t offA,
+    size_t lda,
+    cl_mem B,
+    size_t offB,
+    size_t ldb,
+    cl_uint numCommandQueues,
+    cl_command_queue *commandQueues,
+    cl_uint numEventsInWaitList,
+    const cl_event *eventWaitList,
+    cl_event *events,
+    bool *handled)
+{
+  int strict;
+  ImplPath path = trxmPinnedPath(funcID, kargs->dtype, side, uplo, transA,
+                                 M, N, &strict);
+  size_t threshold = (path == PATH_RECURSIVE) ? 1 :
+                     (path == PATH_DEFAULT) ? trxmRecursiveThreshold() : 0;
+  size_t triangle = (side == clblasLeft) ? M : N;
+  bool multiply = (funcID == CLBLAS_TRMM);
+  bool mustRecurse = (strict && path == PATH_RECURSIVE);
+
+  *handled = false;
+
+  if (threshold == 0 || triangle < threshold || M == 0 || N == 0 ||
+      numCommandQueues == 0) {
+    return trxmNotRecursive(mustRecurse, handled);
+  }
+  // every offset into A and B must fit the kernel arguments
+  if (M > UINT_MAX || N > UINT_MAX || lda > UINT_MAX || ldb > UINT_MAX ||
+      offA + triangle * lda > UINT_MAX ||
+      offB + ((order == clblasColumnMajor) ? N : M) * ldb > UINT_MAX) {
+    return trxmNotRecursive(mustRecurse, handled);
+  }
+
+  cl_event *event = (events != NULL) ? &events[0] : NULL;
+  clblasStatus status = clblasSuccess;
+
+  *handled = true;
+  switch (kargs->dtype) {
+  case TYPE_FLOAT:
+    status = trxmRecursiveType<cl_float>(multiply, kargs, order, side, uplo,
+        transA, diag, (cl_uint)M, (cl_uint)N, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_DOUBLE:
+    status = trxmRecursiveType<cl_double>(multiply, kargs, order, side, uplo,
+        transA, diag, (cl_uint)M, (cl_uint)N, A, (cl_uint)offA, (cl_uint)lda,
+        B, (cl_uint)offB, (cl_uint)ldb, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_COMPLEX_FLOAT:
+    status = trxmRecursiveType<FloatComplex>(multiply, kargs, order, side,
+        uplo, transA, diag, (cl_uint)M, (cl_uint)N, A, (cl_uint)offA,
+        (cl_uint)lda, B, (cl_uint)offB, (cl_uint)ldb, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  case TYPE_COMPLEX_DOUBLE:
+    status = trxmRecursiveType<DoubleComplex>(multiply, kargs, order, side,
+        uplo, transA, diag, (cl_uint)M, (cl_uint)N, A, (cl_uint)offA,
+        (cl_uint)lda, B, (cl_uint)offB, (cl_uint)ldb, commandQueues[0],
+        numEventsInWaitList, eventWaitList, event);
+    break;
+  default:
+    status = trxmNotRecursive(mustRecurse, handled);
+    break;
+  }
+
+  return status;
+}
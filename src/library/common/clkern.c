@@ -74,8 +74,18 @@ launchClKernel(
 
     karg = kernDesc->args;
     for (i = 0; (i < nrArgs) && (status == CL_SUCCESS); i++, karg++) {
-        status = clSetKernelArg(kernDesc->kernel, i, karg->typeSize,
-                                karg->arg.data);
+        if (karg->isSVM) {
+#if defined(CL_VERSION_2_0)
+            status = clSetKernelArgSVMPointer(kernDesc->kernel, i,
+                                              (const void*)karg->arg.mem);
+#else
+            status = CL_INVALID_ARG_VALUE;
+#endif
+        }
+        else {
+            status = clSetKernelArg(kernDesc->kernel, i, karg->typeSize,
+                                    karg->arg.data);
+        }
         if (status != CL_SUCCESS) {
             ei.wrongArg = i;
             ei.phase = PHASE_SET_ARGS;
@@ -0,0 +1,429 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Microbenchmarks measuring memory bandwidth and kernel launch latency
+ * of a device, and device characterization built upon them and the cache
+ * benchmarks.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__APPLE__) || defined(__MACOSX)
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <devinfo.h>
+
+enum {
+    // Number of float elements copied by the global memory benchmark
+    GLOBAL_BENCH_ELEMENTS = 4 * 1024 * 1024,
+    // Number of LDS reads each work item does in the LDS benchmark
+    LDS_BENCH_ROUNDS = 4096,
+    LDS_BENCH_WG_SIZE = 64,
+    // Work groups per compute unit in the LDS benchmark
+    LDS_BENCH_WG_PER_CU = 4,
+    // Each kernel run is repeated several times for higher reliability
+    BENCH_RELIABILITY_ROUNDS = 5,
+    BENCH_BUILD_OPTS_LEN = 64
+};
+
+static const char GLOBAL_BENCH_NAME[] = "globalBench";
+static const char *GLOBAL_BENCH =
+    "__kernel void                                                  \n"
+    "globalBench(__global const VTYPE *in, __global VTYPE *out)     \n"
+    "{                                                              \n"
+    "    size_t i = get_global_id(0);                               \n"
+    "                                                               \n"
+    "    out[i] = in[i];                                            \n"
+    "}                                                              \n";
+
+static const char LDS_BENCH_NAME[] = "ldsBench";
+static const char *LDS_BENCH =
+    "__kernel void                                                  \n"
+    "ldsBench(__global float *out, uint rounds)                     \n"
+    "{                                                              \n"
+    "    __local float lds[LDS_SIZE];                               \n"
+    "    uint lid = get_local_id(0);                                \n"
+    "    float sum = 0.0f;                                          \n"
+    "    uint k;                                                    \n"
+    "                                                               \n"
+    "    lds[lid] = (float)lid;                                     \n"
+    "    barrier(CLK_LOCAL_MEM_FENCE);                              \n"
+    "    for (k = 0; k < rounds; k++) {                             \n"
+    "        sum += lds[(lid + k) % LDS_SIZE];                      \n"
+    "    }                                                          \n"
+    "    out[get_global_id(0)] = sum;                               \n"
+    "}                                                              \n";
+
+static const char EMPTY_BENCH_NAME[] = "emptyBench";
+static const char *EMPTY_BENCH =
+    "__kernel void                                                  \n"
+    "emptyBench(__global float *out)                                \n"
+    "{                                                              \n"
+    "}                                                              \n";
+
+/*
+ * Objects every benchmark needs. The benchmarks use a private context
+ * so as not to disturb the user's ones.
+ */
+typedef struct BenchEnv {
+    cl_context ctx;
+    cl_command_queue queue;
+    cl_kernel kernel;
+} BenchEnv;
+
+static void
+releaseBenchEnv(BenchEnv *env)
+{
+    if (env->kernel != NULL) {
+        clReleaseKernel(env->kernel);
+    }
+    if (env->queue != NULL) {
+        clReleaseCommandQueue(env->queue);
+    }
+    if (env->ctx != NULL) {
+        clReleaseContext(env->ctx);
+    }
+    memset(env, 0, sizeof(BenchEnv));
+}
+
+static cl_int
+initBenchEnv(
+    BenchEnv *env,
+    cl_device_id device,
+    const char *source,
+    const char *name,
+    const char *buildOpts)
+{
+    cl_int err;
+    cl_platform_id platform;
+    cl_context_properties props[3] = { CL_CONTEXT_PLATFORM, 0, 0 };
+    cl_program program;
+
+    memset(env, 0, sizeof(BenchEnv));
+
+    err = clGetDeviceInfo(device, CL_DEVICE_PLATFORM,
+        sizeof(cl_platform_id), &platform, NULL);
+    if (err != CL_SUCCESS) {
+        return err;
+    }
+    props[1] = (cl_context_properties)platform;
+    env->ctx = clCreateContext(props, 1, &device, NULL, NULL, &err);
+    if (err != CL_SUCCESS) {
+        return err;
+    }
+    env->queue = clCreateCommandQueue(env->ctx, device,
+                                      CL_QUEUE_PROFILING_ENABLE, &err);
+    if (err != CL_SUCCESS) {
+        releaseBenchEnv(env);
+        return err;
+    }
+
+    program = clCreateProgramWithSource(env->ctx, 1, &source, NULL, &err);
+    if (err != CL_SUCCESS) {
+        releaseBenchEnv(env);
+        return err;
+    }
+    err = clBuildProgram(program, 1, &device, buildOpts, NULL, NULL);
+    if (err == CL_SUCCESS) {
+        env->kernel = clCreateKernel(program, name, &err);
+    }
+    clReleaseProgram(program);
+    if (err != CL_SUCCESS) {
+        releaseBenchEnv(env);
+    }
+
+    return err;
+}
+
+/*
+ * Run the benchmark kernel several times and return the best time between
+ * the 'from' and 'to' profiling points, in nanoseconds
+ */
+static cl_ulong
+runBench(
+    BenchEnv *env,
+    size_t globalSize,
+    size_t localSize,
+    cl_profiling_info from,
+    cl_profiling_info to,
+    cl_int *error)
+{
+    cl_int err = CL_SUCCESS;
+    cl_event event;
+    cl_ulong start, end, best = 0;
+    unsigned int i;
+
+    for (i = 0; (i < BENCH_RELIABILITY_ROUNDS) && (err == CL_SUCCESS); i++) {
+        err = clEnqueueNDRangeKernel(env->queue, env->kernel, 1, NULL,
+            &globalSize, (localSize) ? &localSize : NULL, 0, NULL, &event);
+        if (err != CL_SUCCESS) {
+            break;
+        }
+        err = clWaitForEvents(1, &event);
+        if (err == CL_SUCCESS) {
+            err = clGetEventProfilingInfo(event, from, sizeof(cl_ulong),
+                                          &start, NULL);
+        }
+        if (err == CL_SUCCESS) {
+            err = clGetEventProfilingInfo(event, to, sizeof(cl_ulong),
+                                          &end, NULL);
+        }
+        clReleaseEvent(event);
+
+        /*
+         * The first run is a warm up one
+         */
+        if ((err == CL_SUCCESS) && i && (end > start) &&
+            ((best == 0) || (end - start < best))) {
+
+            best = end - start;
+        }
+    }
+
+    if (error != NULL) {
+        *error = err;
+    }
+
+    return (err == CL_SUCCESS) ? best : 0;
+}
+
+double
+deviceGlobalBandwidth(
+    cl_device_id device,
+    unsigned int vecLen,
+    cl_int *error)
+{
+    cl_int err;
+    BenchEnv env;
+    char bopts[BENCH_BUILD_OPTS_LEN];
+    cl_mem in = NULL, out = NULL;
+    size_t size = GLOBAL_BENCH_ELEMENTS * sizeof(cl_float);
+    cl_ulong time = 0;
+
+    if (vecLen == 1) {
+        strcpy(bopts, "-DVTYPE=float");
+    }
+    else {
+        sprintf(bopts, "-DVTYPE=float%u", vecLen);
+    }
+
+    err = initBenchEnv(&env, device, GLOBAL_BENCH, GLOBAL_BENCH_NAME, bopts);
+    if (err != CL_SUCCESS) {
+        if (error != NULL) {
+            *error = err;
+        }
+        return 0;
+    }
+
+    in = clCreateBuffer(env.ctx, CL_MEM_READ_ONLY, size, NULL, &err);
+    if (err == CL_SUCCESS) {
+        out = clCreateBuffer(env.ctx, CL_MEM_WRITE_ONLY, size, NULL, &err);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(env.kernel, 0, sizeof(cl_mem), &in);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(env.kernel, 1, sizeof(cl_mem), &out);
+    }
+    if (err == CL_SUCCESS) {
+        time = runBench(&env, GLOBAL_BENCH_ELEMENTS / vecLen, 0,
+                        CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END,
+                        &err);
+    }
+
+    if (out != NULL) {
+        clReleaseMemObject(out);
+    }
+    if (in != NULL) {
+        clReleaseMemObject(in);
+    }
+    releaseBenchEnv(&env);
+
+    if (error != NULL) {
+        *error = err;
+    }
+    if (time == 0) {
+        return 0;
+    }
+
+    // read and written bytes per nanosecond is the same as GB/s
+    return (double)(2 * size) / time;
+}
+
+double
+deviceLDSBandwidth(
+    cl_device_id device,
+    cl_int *error)
+{
+    cl_int err;
+    BenchEnv env;
+    char bopts[BENCH_BUILD_OPTS_LEN];
+    cl_mem out = NULL;
+    cl_uint nrCU, rounds = LDS_BENCH_ROUNDS;
+    size_t globalSize, localSize = LDS_BENCH_WG_SIZE;
+    cl_ulong time = 0;
+
+    nrCU = deviceComputeUnits(device, &err);
+    if ((err != CL_SUCCESS) || (nrCU == 0)) {
+        if (error != NULL) {
+            *error = err;
+        }
+        return 0;
+    }
+    if (deviceMaxWorkgroupSize(device, NULL) < localSize) {
+        localSize = deviceMaxWorkgroupSize(device, NULL);
+    }
+    globalSize = localSize * nrCU * LDS_BENCH_WG_PER_CU;
+
+    sprintf(bopts, "-DLDS_SIZE=%lu", (unsigned long)localSize);
+    err = initBenchEnv(&env, device, LDS_BENCH, LDS_BENCH_NAME, bopts);
+    if (err != CL_SUCCESS) {
+        if (error != NULL) {
+            *error = err;
+        }
+        return 0;
+    }
+
+    out = clCreateBuffer(env.ctx, CL_MEM_WRITE_ONLY,
+                         globalSize * sizeof(cl_float), NULL, &err);
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(env.kernel, 0, sizeof(cl_mem), &out);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(env.kernel, 1, sizeof(cl_uint), &rounds);
+    }
+    if (err == CL_SUCCESS) {
+        time = runBench(&env, globalSize, localSize,
+                        CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END,
+                        &err);
+    }
+
+    if (out != NULL) {
+        clReleaseMemObject(out);
+    }
+    releaseBenchEnv(&env);
+
+    if (error != NULL) {
+        *error = err;
+    }
+    if (time == 0) {
+        return 0;
+    }
+
+    return (double)globalSize * rounds * sizeof(cl_float) / time;
+}
+
+double
+deviceLaunchLatency(
+    cl_device_id device,
+    cl_int *error)
+{
+    cl_int err;
+    BenchEnv env;
+    cl_mem out = NULL;
+    cl_ulong time = 0;
+
+    err = initBenchEnv(&env, device, EMPTY_BENCH, EMPTY_BENCH_NAME, NULL);
+    if (err != CL_SUCCESS) {
+        if (error != NULL) {
+            *error = err;
+        }
+        return 0;
+    }
+
+    out = clCreateBuffer(env.ctx, CL_MEM_WRITE_ONLY, sizeof(cl_float),
+                         NULL, &err);
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(env.kernel, 0, sizeof(cl_mem), &out);
+    }
+    if (err == CL_SUCCESS) {
+        time = runBench(&env, 1, 1, CL_PROFILING_COMMAND_QUEUED,
+                        CL_PROFILING_COMMAND_END, &err);
+    }
+
+    if (out != NULL) {
+        clReleaseMemObject(out);
+    }
+    releaseBenchEnv(&env);
+
+    if (error != NULL) {
+        *error = err;
+    }
+
+    // nanoseconds to microseconds
+    return (double)time / 1000;
+}
+
+cl_int
+characterizeDevice(
+    cl_device_id device,
+    DeviceProfile *profile)
+{
+    cl_int err;
+    unsigned int vecLen;
+    double bw;
+
+    memset(profile, 0, sizeof(DeviceProfile));
+
+    /*
+     * The cache benchmarks work via images; if they are not supported
+     * or the benchmark doesn't find the cache boundary, take what the
+     * runtime reports
+     */
+    profile->l2CacheSize = deviceL2CacheSize(device, &err);
+    if (profile->l2CacheSize == 0) {
+        clGetDeviceInfo(device, CL_DEVICE_GLOBAL_MEM_CACHE_SIZE,
+                        sizeof(cl_ulong), &profile->l2CacheSize, NULL);
+    }
+    if (profile->l2CacheSize != 0) {
+        profile->l1CacheSize = deviceL1CacheSize(device, profile->l2CacheSize,
+                                                 &err);
+    }
+    if (profile->l1CacheSize != 0) {
+        profile->l1CacheAssoc = deviceL1CacheAssoc(device,
+                                                   profile->l1CacheSize, &err);
+    }
+
+    // find the load width giving the best bandwidth
+    profile->loadVecLen = 1;
+    for (vecLen = 1; vecLen <= 8; vecLen *= 2) {
+        bw = deviceGlobalBandwidth(device, vecLen, &err);
+        if (err != CL_SUCCESS) {
+            return err;
+        }
+        /*
+         * Wider loads are taken only if they give a noticeable gain
+         */
+        if (bw > profile->globalBandwidth * 1.05) {
+            profile->globalBandwidth = bw;
+            profile->loadVecLen = vecLen;
+        }
+    }
+
+    profile->ldsBandwidth = deviceLDSBandwidth(device, &err);
+    if (err != CL_SUCCESS) {
+        return err;
+    }
+    profile->launchLatency = deviceLaunchLatency(device, &err);
+
+    return err;
+}
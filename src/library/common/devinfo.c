@@ -38,6 +38,10 @@ stringToVendor(const char *str)
     else if (!strcmp(str, "NVIDIA Corporation")) {
         vendor = VENDOR_NVIDIA;
     }
+    else if (!strcmp(str, "Intel(R) Corporation") ||
+             !strcmp(str, "GenuineIntel")) {
+        vendor = VENDOR_INTEL;
+    }
     else {
         vendor = VENDOR_UNKNOWN;
     }
@@ -111,6 +115,17 @@ devFamily(DeviceChip chip)
     return fam;
 }
 
+static bool
+isCPUDevice(cl_device_id device)
+{
+    cl_device_type type;
+    cl_int err;
+
+    err = clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, NULL);
+
+    return (err == CL_SUCCESS) && (type & CL_DEVICE_TYPE_CPU);
+}
+
 cl_int
 identifyDevice(TargetDevice *target)
 {
@@ -132,6 +147,14 @@ identifyDevice(TargetDevice *target)
     ident->chip = stringToChip(s);
     ident->family = devFamily(ident->chip);
 
+    /*
+     * CPU runtimes report the processor brand as the device name, so
+     * CPUs are recognized by the device type
+     */
+    if (isCPUDevice(target->id)) {
+        ident->family = CPU_FAMILY_GENERIC;
+    }
+
     return CL_SUCCESS;
 }
 
@@ -140,12 +163,15 @@ deviceWavefront(
     cl_device_id device,
     cl_int *error)
 {
-    (void)device;
-
     if (error != NULL) {
         *error = CL_SUCCESS;
     }
-    return 64;
+
+    /*
+     * CPU runtimes have no hardware wavefronts, any work group size
+     * is equally fine for them
+     */
+    return isCPUDevice(device) ? 1 : 64;
 }
 
 bool
@@ -178,6 +204,27 @@ deviceComputeUnits(
     return v;
 }
 
+/*
+ * Width of the device SIMD unit in bytes
+ */
+cl_uint
+deviceSIMDWidth(
+    cl_device_id device,
+    cl_int *error)
+{
+    cl_int err;
+    cl_uint v;
+
+    v = 0;
+    err = clGetDeviceInfo(device, CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT,
+        sizeof(v), &v, NULL);
+    if (error != NULL) {
+        *error = err;
+    }
+
+    return ((v) ? v : 1) * sizeof(cl_float);
+}
+
 size_t
 deviceMaxWorkgroupSize(
     cl_device_id device,
@@ -412,6 +412,34 @@ cleanKernelCache(struct KernelCache *kcache)
     putRemovedKernels(kcache, &truncList);
 }
 
+void
+removeContextKernels(struct KernelCache *kcache, cl_context context)
+{
+    ListHead truncList;
+    ListNode *l, *next;
+    KernelNode *knode;
+    size_t ksize;
+
+    listInitHead(&truncList);
+
+    KCACHE_LOCK(kcache);
+    for (l = listNodeFirst(&kcache->lruKern); l != &kcache->lruKern; l = next) {
+        next = l->next;
+        knode = container_of(l, lruNode, KernelNode);
+        if (knode->key.context != context) {
+            continue;
+        }
+        listDel(l);
+        listDel(&knode->dimNode);
+        listAddToTail(&truncList, &knode->lruNode);
+        ksize = fullKernelSize(&knode->kern);
+        kcache->totalSize -= ksize;
+    }
+    KCACHE_UNLOCK(kcache);
+
+    putRemovedKernels(kcache, &truncList);
+}
+
 size_t
 fullKernelSize(Kernel *kern)
 {
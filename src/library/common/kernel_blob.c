@@ -0,0 +1,212 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * On demand decoding of the compressed kernel binaries
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <defbool.h>
+#include <list.h>
+#include <mutex.h>
+#include <kernel_blob.h>
+
+typedef struct DecodedBlob {
+    const void *blob;
+    unsigned char *data;
+    size_t size;
+    ListNode node;
+} DecodedBlob;
+
+static ListHead decodedBlobs;
+static mutex_t *blobsLock = NULL;
+
+static size_t
+read32(const unsigned char *p)
+{
+    return (size_t)p[0] | ((size_t)p[1] << 8) | ((size_t)p[2] << 16) |
+           ((size_t)p[3] << 24);
+}
+
+static bool
+readLength(const unsigned char **ip, const unsigned char *iend, size_t *len)
+{
+    unsigned char b;
+
+    do {
+        if (*ip >= iend) {
+            return false;
+        }
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+
+    return true;
+}
+
+static bool
+decode(
+    const unsigned char *ip,
+    size_t inSize,
+    unsigned char *out,
+    size_t outSize)
+{
+    const unsigned char *iend = ip + inSize;
+    unsigned char *op = out;
+    unsigned char *oend = out + outSize;
+    const unsigned char *ref;
+    unsigned char token;
+    size_t len, distance;
+
+    while (op < oend) {
+        if (ip >= iend) {
+            return false;
+        }
+        token = *ip++;
+
+        len = token >> 4;
+        if ((len == 15) && !readLength(&ip, iend, &len)) {
+            return false;
+        }
+        if ((len > (size_t)(iend - ip)) || (len > (size_t)(oend - op))) {
+            return false;
+        }
+        memcpy(op, ip, len);
+        op += len;
+        ip += len;
+        if (op == oend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return false;
+        }
+        distance = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        len = token & 15;
+        if ((len == 15) && !readLength(&ip, iend, &len)) {
+            return false;
+        }
+        len += KERNEL_BLOB_MIN_MATCH;
+        if ((distance == 0) || (distance > (size_t)(op - out)) ||
+            (len > (size_t)(oend - op))) {
+
+            return false;
+        }
+        // the match may overlap the bytes it produces
+        for (ref = op - distance; len > 0; len--) {
+            *op++ = *ref++;
+        }
+    }
+
+    return (ip == iend);
+}
+
+static int
+blobCmp(const ListNode *node, const void *key)
+{
+    DecodedBlob *decoded = container_of(node, node, DecodedBlob);
+
+    return (decoded->blob != key);
+}
+
+static void
+freeDecodedBlob(ListNode *node)
+{
+    DecodedBlob *decoded = container_of(node, node, DecodedBlob);
+
+    free(decoded->data);
+    free(decoded);
+}
+
+void
+kernelBlobSetup(void)
+{
+    listInitHead(&decodedBlobs);
+    blobsLock = mutexInit();
+}
+
+void
+kernelBlobTeardown(void)
+{
+    if (blobsLock == NULL) {
+        return;
+    }
+
+    listDoForEachSafe(&decodedBlobs, freeDecodedBlob);
+    listInitHead(&decodedBlobs);
+    mutexDestroy(blobsLock);
+    blobsLock = NULL;
+}
+
+const unsigned char*
+kernelBlobData(const void *data, size_t *size)
+{
+    const unsigned char *blob = (const unsigned char*)data;
+    ListNode *node;
+    DecodedBlob *decoded;
+    size_t rawSize, packedSize;
+
+    if ((blob == NULL) || (*size < KERNEL_BLOB_HEADER_SIZE) ||
+        memcmp(blob, KERNEL_BLOB_MAGIC, 4)) {
+
+        return blob;
+    }
+
+    rawSize = read32(blob + 4);
+    packedSize = read32(blob + 8);
+    if (packedSize > *size - KERNEL_BLOB_HEADER_SIZE) {
+        return NULL;
+    }
+
+    mutexLock(blobsLock);
+
+    node = listNodeSearch(&decodedBlobs, blob, blobCmp);
+    if (node != NULL) {
+        decoded = container_of(node, node, DecodedBlob);
+    }
+    else {
+        decoded = calloc(1, sizeof(DecodedBlob));
+        if (decoded != NULL) {
+            decoded->blob = blob;
+            decoded->size = rawSize;
+            decoded->data = malloc(rawSize ? rawSize : 1);
+            if ((decoded->data == NULL) ||
+                !decode(blob + KERNEL_BLOB_HEADER_SIZE, packedSize,
+                        decoded->data, rawSize)) {
+
+                free(decoded->data);
+                free(decoded);
+                decoded = NULL;
+            }
+            else {
+                listAddToTail(&decodedBlobs, &decoded->node);
+            }
+        }
+    }
+
+    mutexUnlock(blobsLock);
+
+    if (decoded == NULL) {
+        return NULL;
+    }
+    *size = decoded->size;
+
+    return decoded->data;
+}
@@ -38,6 +38,9 @@ dtypeSize(DataType type)
     case TYPE_UNSIGNED_INT:// For iAMAX
         ret = sizeof(cl_uint);
         break;
+    case TYPE_HALF:
+        ret = sizeof(cl_half);
+        break;
     default:
         ret = (size_t)-1;
         break;
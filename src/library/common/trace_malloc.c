@@ -57,6 +57,7 @@ typedef struct MtraceNode {
 static mutex_t *mutex;
 static size_t tracedSize;
 static size_t rawSize;
+static unsigned long nrAllocs;
 ListHead traceList;
 
 static
@@ -134,6 +135,7 @@ initMallocTrace(void)
 {
     listInitHead(&traceList);
     tracedSize = rawSize = 0;
+    nrAllocs = 0;
     mutex = mutexInit();
 }
 
@@ -161,6 +163,7 @@ void
         MTRACE_LOCK();
         tracedSize += size;
         rawSize += rawTracedSize(mtnode);
+        nrAllocs++;
         listAddToTail(&traceList, &mtnode->node);
         MTRACE_UNLOCK();
     }
@@ -206,6 +209,7 @@ void
             MTRACE_LOCK();
             tracedSize += delta;
             rawSize += delta;
+            nrAllocs++;
             MTRACE_UNLOCK();
         }
         else {
@@ -246,6 +250,22 @@ printMallocStatistics(void)
     printf("[MALLOC TRACE] Totally %s is allocated\n", s);
 }
 
+/*
+ * Total number of allocation requests served since initMallocTrace(),
+ * used to check that hot paths don't touch the heap
+ */
+unsigned long
+getMallocTraceCount(void)
+{
+    unsigned long n;
+
+    MTRACE_LOCK();
+    n = nrAllocs;
+    MTRACE_UNLOCK();
+
+    return n;
+}
+
 void
 printMemLeaksInfo(void)
 {
@@ -27,6 +27,9 @@
 
 #include "CL/cl.h"
 
+#define KERNEL_BLOB_ENCODER
+#include <kernel_blob.h>
+
 void find_and_replace(std::string& str, const std::string& findStr, const std::string& replaceStr){
     size_t pos = 0;
     while ((pos = str.find(findStr, pos)) != std::string::npos){
@@ -332,13 +335,25 @@ int main(int argc, char *argv[])
 
     status = getKernelBinaryFromSource(context, kernelStr.c_str(), OCL_flag.c_str(), kernelBinary, &kernelBinarySize);
     CL_CHECK(status);
+    //compress the binary, the library decodes it the first time the kernel is built
+    char *blob = new char[KERNEL_BLOB_BOUND(kernelBinarySize)];
+    size_t blobSize = kernelBlobEncode((unsigned char *)*kernelBinary, kernelBinarySize, (unsigned char *)blob);
+    if (blobSize == 0)
+    {
+        printf("Compressing the binary failed. OCLBinaryGenerator aborted.\n");
+        exit(-1);
+    }
+    printf("OCLBinaryGenerator compressed %lu bytes to %lu\n", (unsigned long)kernelBinarySize, (unsigned long)blobSize);
+
     //writing the file
-    outputFile << "char " << outputKernelName << "_binArray[" << kernelBinarySize << "] = {" <<std::endl;
-    writeBinaryToStream(outputFile, *kernelBinary, kernelBinarySize);
+    outputFile << "#include <kernel_blob.h>" << std::endl << std::endl;
+    outputFile << "KERNEL_BLOB_SECTION const char " << outputKernelName << "_binArray[" << blobSize << "] = {" <<std::endl;
+    writeBinaryToStream(outputFile, blob, blobSize);
     outputFile << "};" << std::endl;
 
-    outputFile << "unsigned char *" << outputKernelName << "_bin = " << "reinterpret_cast<unsigned char *>(" << outputKernelName << "_binArray);" << std::endl;
-    outputFile << "size_t " << outputKernelName << "_binSize = " << kernelBinarySize << ";" << std::endl;
+    outputFile << "unsigned char *" << outputKernelName << "_bin = " << "(unsigned char *)" << outputKernelName << "_binArray;" << std::endl;
+    outputFile << "size_t " << outputKernelName << "_binSize = " << blobSize << ";" << std::endl;
+    delete[] blob;
     outputFile << "const char * const " << outputKernelName << "_src = NULL;" << std::endl;
 
     //end writing file
@@ -0,0 +1,775 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * kpack: build a kernel pack for a device ahead of time
+ *
+ * The kernels a call needs depend on the problem, the device and the
+ * library's own selection logic, so rather than enumerating them here the
+ * tool runs the selected routines over a set of problem sizes, in every
+ * precision, transposition and triangle the routine takes, and lets the
+ * library record each program it builds. The pack is written when the
+ * library is torn down; pointing CLBLAS_KERNEL_PACK at it lets later runs
+ * on the same device skip compilation. The calls are spread over several
+ * threads, each with its own queue, since compilation dominates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <clBLAS.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#include "process.h"
+
+#define THREAD_ID HANDLE
+#define THREAD_START(ID, DATA) \
+     ID = (HANDLE)_beginthreadex(NULL, 0, &packThread, &DATA, 0, NULL);
+#define THREAD_WAIT(ID) WaitForSingleObject(ID, INFINITE);
+#define THREAD_FUNC unsigned __stdcall
+#define THREAD_RETURN return 0
+#define SET_ENV(VAR) _putenv(VAR)
+
+#else /* defined(_MSC_VER) */
+#include "pthread.h"
+
+#define THREAD_ID pthread_t
+#define THREAD_START(ID, DATA) \
+     pthread_create(&ID, NULL, packThread, &DATA)
+#define THREAD_WAIT(ID) pthread_join(ID, NULL);
+#define THREAD_FUNC void*
+#define THREAD_RETURN return NULL
+#define SET_ENV(VAR) putenv(VAR)
+
+#endif
+
+#define DEFAULT_SIZES "64,512,2048"
+#define DEFAULT_ROUTINES \
+    "gemm,trsm,trmm,syrk,gemv,symv,trsv,scal,axpy,dot,nrm2,asum,amax"
+#define DEFAULT_PRECISIONS "sdcz"
+
+enum Precision {
+    PREC_S,
+    PREC_D,
+    PREC_C,
+    PREC_Z
+};
+
+/*
+ * A call to make: 'variant' enumerates the transpositions, triangles and
+ * sides of the routine, see the number of variants in 'routines'
+ */
+struct Job
+{
+    int routine;
+    Precision prec;
+    size_t n;
+    unsigned int variant;
+};
+
+struct PackThread
+{
+    cl_context context;
+    cl_device_id device;
+    const std::vector<Job> *jobs;
+    size_t first;
+    size_t step;
+    size_t failed;
+};
+
+/* the scalars 1 and 0 in every precision */
+struct Scalars
+{
+    cl_float s[2];
+    cl_double d[2];
+    FloatComplex c[2];
+    DoubleComplex z[2];
+
+    Scalars()
+    {
+        for (int i = 0; i < 2; i++) {
+            s[i] = d[i] = (i == 0);
+            c[i] = floatComplex((float)(i == 0), 0);
+            z[i] = doubleComplex((double)(i == 0), 0);
+        }
+    }
+};
+
+/* buffers of a call, large enough for any routine and precision */
+struct Buffers
+{
+    cl_mem A, B, C, X, Y;
+};
+
+typedef clblasStatus (*RunFunc)(const Job&, const Buffers&, cl_command_queue*);
+
+static const Scalars scalars;
+
+static clblasTranspose
+transOf(unsigned int bit)
+{
+    return bit ? clblasTrans : clblasNoTrans;
+}
+
+static clblasUplo
+uploOf(unsigned int bit)
+{
+    return bit ? clblasLower : clblasUpper;
+}
+
+static clblasSide
+sideOf(unsigned int bit)
+{
+    return bit ? clblasRight : clblasLeft;
+}
+
+/* transA, transB, beta zero or not */
+static clblasStatus
+runGemm(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasTranspose ta = transOf(job.variant & 1);
+    clblasTranspose tb = transOf((job.variant >> 1) & 1);
+    int beta = (job.variant >> 2) & 1;
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSgemm(clblasColumnMajor, ta, tb, n, n, n, scalars.s[0],
+            b.A, 0, n, b.B, 0, n, scalars.s[beta], b.C, 0, n,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDgemm(clblasColumnMajor, ta, tb, n, n, n, scalars.d[0],
+            b.A, 0, n, b.B, 0, n, scalars.d[beta], b.C, 0, n,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCgemm(clblasColumnMajor, ta, tb, n, n, n, scalars.c[0],
+            b.A, 0, n, b.B, 0, n, scalars.c[beta], b.C, 0, n,
+            1, queue, 0, NULL, NULL);
+    default:
+        return clblasZgemm(clblasColumnMajor, ta, tb, n, n, n, scalars.z[0],
+            b.A, 0, n, b.B, 0, n, scalars.z[beta], b.C, 0, n,
+            1, queue, 0, NULL, NULL);
+    }
+}
+
+/* side, uplo, transA */
+static clblasStatus
+runTrsm(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasSide side = sideOf(job.variant & 1);
+    clblasUplo uplo = uploOf((job.variant >> 1) & 1);
+    clblasTranspose ta = transOf((job.variant >> 2) & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasStrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.s[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.d[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.c[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    default:
+        return clblasZtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.z[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    }
+}
+
+/* side, uplo, transA */
+static clblasStatus
+runTrmm(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasSide side = sideOf(job.variant & 1);
+    clblasUplo uplo = uploOf((job.variant >> 1) & 1);
+    clblasTranspose ta = transOf((job.variant >> 2) & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasStrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.s[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.d[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.c[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    default:
+        return clblasZtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            n, n, scalars.z[0], b.A, 0, n, b.B, 0, n, 1, queue, 0, NULL, NULL);
+    }
+}
+
+/* uplo, transA */
+static clblasStatus
+runSyrk(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasUplo uplo = uploOf(job.variant & 1);
+    clblasTranspose ta = transOf((job.variant >> 1) & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSsyrk(clblasColumnMajor, uplo, ta, n, n, scalars.s[0],
+            b.A, 0, n, scalars.s[0], b.C, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDsyrk(clblasColumnMajor, uplo, ta, n, n, scalars.d[0],
+            b.A, 0, n, scalars.d[0], b.C, 0, n, 1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCsyrk(clblasColumnMajor, uplo, ta, n, n, scalars.c[0],
+            b.A, 0, n, scalars.c[0], b.C, 0, n, 1, queue, 0, NULL, NULL);
+    default:
+        return clblasZsyrk(clblasColumnMajor, uplo, ta, n, n, scalars.z[0],
+            b.A, 0, n, scalars.z[0], b.C, 0, n, 1, queue, 0, NULL, NULL);
+    }
+}
+
+/* transA */
+static clblasStatus
+runGemv(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasTranspose ta = transOf(job.variant & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSgemv(clblasColumnMajor, ta, n, n, scalars.s[0],
+            b.A, 0, n, b.X, 0, 1, scalars.s[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDgemv(clblasColumnMajor, ta, n, n, scalars.d[0],
+            b.A, 0, n, b.X, 0, 1, scalars.d[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCgemv(clblasColumnMajor, ta, n, n, scalars.c[0],
+            b.A, 0, n, b.X, 0, 1, scalars.c[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    default:
+        return clblasZgemv(clblasColumnMajor, ta, n, n, scalars.z[0],
+            b.A, 0, n, b.X, 0, 1, scalars.z[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    }
+}
+
+/* uplo; HEMV for the complex precisions */
+static clblasStatus
+runSymv(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasUplo uplo = uploOf(job.variant & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSsymv(clblasColumnMajor, uplo, n, scalars.s[0],
+            b.A, 0, n, b.X, 0, 1, scalars.s[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDsymv(clblasColumnMajor, uplo, n, scalars.d[0],
+            b.A, 0, n, b.X, 0, 1, scalars.d[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasChemv(clblasColumnMajor, uplo, n, scalars.c[0],
+            b.A, 0, n, b.X, 0, 1, scalars.c[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    default:
+        return clblasZhemv(clblasColumnMajor, uplo, n, scalars.z[0],
+            b.A, 0, n, b.X, 0, 1, scalars.z[0], b.Y, 0, 1,
+            1, queue, 0, NULL, NULL);
+    }
+}
+
+/* uplo, trans */
+static clblasStatus
+runTrsv(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    clblasUplo uplo = uploOf(job.variant & 1);
+    clblasTranspose ta = transOf((job.variant >> 1) & 1);
+    size_t n = job.n;
+
+    switch (job.prec) {
+    case PREC_S:
+        return clblasStrsv(clblasColumnMajor, uplo, ta, clblasNonUnit, n,
+            b.A, 0, n, b.X, 0, 1, 1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDtrsv(clblasColumnMajor, uplo, ta, clblasNonUnit, n,
+            b.A, 0, n, b.X, 0, 1, 1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCtrsv(clblasColumnMajor, uplo, ta, clblasNonUnit, n,
+            b.A, 0, n, b.X, 0, 1, 1, queue, 0, NULL, NULL);
+    default:
+        return clblasZtrsv(clblasColumnMajor, uplo, ta, clblasNonUnit, n,
+            b.A, 0, n, b.X, 0, 1, 1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runScal(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSscal(job.n, scalars.s[0], b.X, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDscal(job.n, scalars.d[0], b.X, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCscal(job.n, scalars.c[0], b.X, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    default:
+        return clblasZscal(job.n, scalars.z[0], b.X, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runAxpy(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSaxpy(job.n, scalars.s[0], b.X, 0, 1, b.Y, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDaxpy(job.n, scalars.d[0], b.X, 0, 1, b.Y, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCaxpy(job.n, scalars.c[0], b.X, 0, 1, b.Y, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    default:
+        return clblasZaxpy(job.n, scalars.z[0], b.X, 0, 1, b.Y, 0, 1,
+                           1, queue, 0, NULL, NULL);
+    }
+}
+
+/* the reductions put their result into A and use C as scratch */
+static clblasStatus
+runDot(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSdot(job.n, b.A, 0, b.X, 0, 1, b.Y, 0, 1, b.C,
+                          1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDdot(job.n, b.A, 0, b.X, 0, 1, b.Y, 0, 1, b.C,
+                          1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCdotu(job.n, b.A, 0, b.X, 0, 1, b.Y, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    default:
+        return clblasZdotu(job.n, b.A, 0, b.X, 0, 1, b.Y, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runNrm2(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSnrm2(job.n, b.A, 0, b.X, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDnrm2(job.n, b.A, 0, b.X, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasScnrm2(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    default:
+        return clblasDznrm2(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runAsum(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasSasum(job.n, b.A, 0, b.X, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDasum(job.n, b.A, 0, b.X, 0, 1, b.C,
+                           1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasScasum(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    default:
+        return clblasDzasum(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runAmax(const Job &job, const Buffers &b, cl_command_queue *queue)
+{
+    switch (job.prec) {
+    case PREC_S:
+        return clblasiSamax(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasiDamax(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasiCamax(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    default:
+        return clblasiZamax(job.n, b.A, 0, b.X, 0, 1, b.C,
+                            1, queue, 0, NULL, NULL);
+    }
+}
+
+static const struct {
+    const char *name;
+    RunFunc run;
+    unsigned int nrVariants;
+} routines[] = {
+    { "gemm", runGemm, 8 },
+    { "trsm", runTrsm, 8 },
+    { "trmm", runTrmm, 8 },
+    { "syrk", runSyrk, 4 },
+    { "gemv", runGemv, 2 },
+    { "symv", runSymv, 2 },
+    { "trsv", runTrsv, 4 },
+    { "scal", runScal, 1 },
+    { "axpy", runAxpy, 1 },
+    { "dot", runDot, 1 },
+    { "nrm2", runNrm2, 1 },
+    { "asum", runAsum, 1 },
+    { "amax", runAmax, 1 }
+};
+
+#define NR_ROUTINES (sizeof(routines) / sizeof(routines[0]))
+
+static size_t
+elementSize(Precision prec)
+{
+    switch (prec) {
+    case PREC_S:
+        return sizeof(cl_float);
+    case PREC_D:
+        return sizeof(cl_double);
+    case PREC_C:
+        return sizeof(FloatComplex);
+    default:
+        return sizeof(DoubleComplex);
+    }
+}
+
+static const char*
+jobName(const Job &job, char *buf, size_t size)
+{
+    snprintf(buf, size, "%c%s n=%lu variant=%u", "sdcz"[job.prec],
+             routines[job.routine].name, (unsigned long)job.n, job.variant);
+
+    return buf;
+}
+
+static bool
+runJob(PackThread *data, cl_command_queue queue, const Job &job)
+{
+    // the contents don't matter, only the kernels built
+    size_t matSize = job.n * job.n * elementSize(job.prec);
+    size_t vecSize = job.n * elementSize(job.prec);
+    cl_mem *mems[] = { NULL, NULL, NULL, NULL, NULL };
+    size_t sizes[] = { matSize, matSize, matSize, vecSize, vecSize };
+    Buffers b;
+    clblasStatus status = clblasOutOfResources;
+    cl_int err = CL_SUCCESS;
+    size_t i;
+
+    mems[0] = &b.A;
+    mems[1] = &b.B;
+    mems[2] = &b.C;
+    mems[3] = &b.X;
+    mems[4] = &b.Y;
+    for (i = 0; i < 5; i++) {
+        *mems[i] = NULL;
+    }
+    for (i = 0; (i < 5) && (err == CL_SUCCESS); i++) {
+        *mems[i] = clCreateBuffer(data->context, CL_MEM_READ_WRITE, sizes[i],
+                                  NULL, &err);
+    }
+
+    if (err == CL_SUCCESS) {
+        status = routines[job.routine].run(job, b, &queue);
+        if (status == clblasSuccess) {
+            status = (clblasStatus)clFinish(queue);
+        }
+    }
+
+    for (i = 0; i < 5; i++) {
+        if (*mems[i] != NULL) {
+            clReleaseMemObject(*mems[i]);
+        }
+    }
+
+    if (status != clblasSuccess) {
+        char name[64];
+
+        fprintf(stderr, "%s failed, status %d\n",
+                jobName(job, name, sizeof(name)), (int)status);
+    }
+
+    return (status == clblasSuccess);
+}
+
+static THREAD_FUNC
+packThread(void *arg)
+{
+    PackThread *data = (PackThread*)arg;
+    const std::vector<Job> &jobs = *data->jobs;
+    cl_command_queue queue;
+    cl_int err;
+
+    queue = clCreateCommandQueue(data->context, data->device, 0, &err);
+    if (err != CL_SUCCESS) {
+        data->failed = jobs.size();
+        THREAD_RETURN;
+    }
+
+    for (size_t i = data->first; i < jobs.size(); i += data->step) {
+        if (!runJob(data, queue, jobs[i])) {
+            data->failed++;
+        }
+    }
+    clReleaseCommandQueue(queue);
+
+    THREAD_RETURN;
+}
+
+static void
+split(const char *list, std::vector<std::string> &items)
+{
+    std::string s(list);
+    size_t start = 0;
+
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+
+        if (end == std::string::npos) {
+            end = s.size();
+        }
+        if (end > start) {
+            items.push_back(s.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+}
+
+static bool
+hasDouble(cl_device_id device)
+{
+    char extensions[4096];
+
+    if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, sizeof(extensions),
+                        extensions, NULL) != CL_SUCCESS) {
+        return false;
+    }
+
+    return (strstr(extensions, "cl_khr_fp64") != NULL) ||
+           (strstr(extensions, "cl_amd_fp64") != NULL);
+}
+
+static void
+printUsage(const char *app)
+{
+    printf("Usage: %s -o <pack> [options]\n"
+           "  -o <pack>        file the kernel pack is written to\n"
+           "  -p <platform>    index of the OpenCL platform (0)\n"
+           "  -d <device>      index of the GPU device on the platform (0)\n"
+           "  -j <threads>     number of threads building kernels (4)\n"
+           "  -s <sizes>       comma separated problem sizes (%s)\n"
+           "  -r <routines>    comma separated routines (%s)\n"
+           "  -t <precisions>  precisions among 'sdcz' (%s)\n"
+           "Double precision is skipped on devices without it.\n",
+           app, DEFAULT_SIZES, DEFAULT_ROUTINES, DEFAULT_PRECISIONS);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *output = NULL;
+    const char *sizesArg = DEFAULT_SIZES;
+    const char *routinesArg = DEFAULT_ROUTINES;
+    const char *precisionsArg = DEFAULT_PRECISIONS;
+    unsigned int platformIdx = 0, deviceIdx = 0, nrThreads = 4;
+    std::vector<std::string> names, sizes;
+    std::vector<cl_platform_id> platforms;
+    std::vector<cl_device_id> devices;
+    std::vector<Job> jobs;
+    std::vector<PackThread> threads;
+    std::vector<THREAD_ID> ids;
+    cl_uint nr;
+    cl_device_id device;
+    cl_context context;
+    cl_context_properties props[3] = { CL_CONTEXT_PLATFORM, 0, 0 };
+    cl_int err;
+    bool fp64;
+    size_t failed = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if ((argv[i][0] != '-') || (argv[i][1] == '\0') ||
+            (argv[i][2] != '\0') || (value == NULL)) {
+
+            printUsage(argv[0]);
+            return 1;
+        }
+        switch (argv[i][1]) {
+        case 'o': output = value; break;
+        case 'p': platformIdx = (unsigned int)atoi(value); break;
+        case 'd': deviceIdx = (unsigned int)atoi(value); break;
+        case 'j': nrThreads = (unsigned int)atoi(value); break;
+        case 's': sizesArg = value; break;
+        case 'r': routinesArg = value; break;
+        case 't': precisionsArg = value; break;
+        default:
+            printUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if ((output == NULL) || (nrThreads == 0)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    err = clGetPlatformIDs(0, NULL, &nr);
+    if ((err != CL_SUCCESS) || (platformIdx >= nr)) {
+        fprintf(stderr, "No OpenCL platform %u\n", platformIdx);
+        return 1;
+    }
+    platforms.resize(nr);
+    clGetPlatformIDs(nr, &platforms[0], NULL);
+
+    err = clGetDeviceIDs(platforms[platformIdx], CL_DEVICE_TYPE_GPU, 0,
+                         NULL, &nr);
+    if ((err != CL_SUCCESS) || (deviceIdx >= nr)) {
+        fprintf(stderr, "No GPU device %u on platform %u\n", deviceIdx,
+                platformIdx);
+        return 1;
+    }
+    devices.resize(nr);
+    clGetDeviceIDs(platforms[platformIdx], CL_DEVICE_TYPE_GPU, nr,
+                   &devices[0], NULL);
+    device = devices[deviceIdx];
+    fp64 = hasDouble(device);
+
+    props[1] = (cl_context_properties)platforms[platformIdx];
+    context = clCreateContext(props, 1, &device, NULL, NULL, &err);
+    if (err != CL_SUCCESS) {
+        fprintf(stderr, "clCreateContext() failed with %d\n", err);
+        return 1;
+    }
+
+    // the list of calls, interleaved so that every thread gets a share of
+    // the expensive routines
+    split(routinesArg, names);
+    split(sizesArg, sizes);
+    for (size_t r = 0; r < names.size(); r++) {
+        size_t routine;
+
+        for (routine = 0; routine < NR_ROUTINES; routine++) {
+            if (names[r] == routines[routine].name) {
+                break;
+            }
+        }
+        if (routine == NR_ROUTINES) {
+            fprintf(stderr, "Unknown routine '%s'\n", names[r].c_str());
+            clReleaseContext(context);
+            return 1;
+        }
+
+        for (const char *p = precisionsArg; *p != '\0'; p++) {
+            const char *prec = strchr(DEFAULT_PRECISIONS, *p);
+            Job job;
+
+            if (prec == NULL) {
+                fprintf(stderr, "Unknown precision '%c'\n", *p);
+                clReleaseContext(context);
+                return 1;
+            }
+            job.routine = (int)routine;
+            job.prec = (Precision)(prec - DEFAULT_PRECISIONS);
+            if (!fp64 && ((job.prec == PREC_D) || (job.prec == PREC_Z))) {
+                continue;
+            }
+            for (size_t s = 0; s < sizes.size(); s++) {
+                job.n = (size_t)atol(sizes[s].c_str());
+                if (job.n == 0) {
+                    continue;
+                }
+                for (job.variant = 0;
+                     job.variant < routines[routine].nrVariants;
+                     job.variant++) {
+
+                    jobs.push_back(job);
+                }
+            }
+        }
+    }
+    if (!fp64) {
+        printf("The device has no double precision, skipping 'd' and 'z'\n");
+    }
+
+    // the library writes the pack at teardown
+    std::string env = std::string("CLBLAS_KERNEL_PACK_OUTPUT=") + output;
+    std::vector<char> envVar(env.begin(), env.end());
+    envVar.push_back('\0');
+    SET_ENV(&envVar[0]);
+
+    err = clblasSetup();
+    if (err != CL_SUCCESS) {
+        fprintf(stderr, "clblasSetup() failed with %d\n", err);
+        clReleaseContext(context);
+        return 1;
+    }
+
+    printf("Building the kernels of %lu calls with %u threads...\n",
+           (unsigned long)jobs.size(), nrThreads);
+
+    threads.resize(nrThreads);
+    ids.resize(nrThreads);
+    for (unsigned int t = 0; t < nrThreads; t++) {
+        threads[t].context = context;
+        threads[t].device = device;
+        threads[t].jobs = &jobs;
+        threads[t].first = t;
+        threads[t].step = nrThreads;
+        threads[t].failed = 0;
+        THREAD_START(ids[t], threads[t]);
+    }
+    for (unsigned int t = 0; t < nrThreads; t++) {
+        THREAD_WAIT(ids[t]);
+        failed += threads[t].failed;
+    }
+
+    clblasTeardown();
+    clReleaseContext(context);
+
+    printf("%lu calls failed, pack written to '%s'\n",
+           (unsigned long)failed, output);
+
+    return (failed != 0);
+}
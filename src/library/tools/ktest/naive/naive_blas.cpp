@@ -563,13 +563,15 @@ gemm(
     MatrixAccessor<T> ma(const_cast<T*>(A), order, transA, M, K, lda);
     MatrixAccessor<T> mb(const_cast<T*>(B), order, transB, K, N, ldb);
     MatrixAccessor<T> mc(C, order, clblasNoTrans, M, N, ldc);
-    size_t i, j, k;
-    T tmp;
+    long i;
 
-    for (i = 0; i < M; i++) {
-        for (j = 0; j < N; j++) {
-            tmp = ZERO<T>();
-            for (k = 0; k < K; k++) {
+    // rows are independent, they are computed in parallel when built with OpenMP
+    #pragma omp parallel for schedule(dynamic)
+    for (i = 0; i < (long)M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            T tmp = ZERO<T>();
+
+            for (size_t k = 0; k < K; k++) {
                 tmp = tmp + ma[i][k] * mb[k][j];
             }
             mc[i][j] = mc[i][j] * beta + tmp * alpha;
@@ -644,14 +646,12 @@ trsm(
     T *B,
     size_t ldb)
 {
-    size_t i, j, k;
-    size_t row, col;
     size_t rowsA = (side == clblasLeft) ? M : N;
     size_t colsB = (side == clblasLeft) ? N : M;
     MatrixAccessor<T> ma(const_cast<T*>(A), order, transA, rowsA, rowsA, lda);
     MatrixAccessor<T> mb(B, order, clblasNoTrans, rowsA, colsB, ldb);
-    T tmp, a;
     bool revPass;
+    long j;
 
     revPass = (uplo == clblasUpper) ^ (transA != clblasNoTrans);
     if (side == clblasRight) {
@@ -660,16 +660,23 @@ trsm(
         revPass = !revPass;
     }
 
-    for (i = 0; i < rowsA; i++) {
-        row = (revPass) ? (rowsA - i - 1) : i;
-        for (j = 0; j < colsB; j++) {
+    /*
+     * The columns of B are solved independently, in parallel when built
+     * with OpenMP; each of them goes through the same steps as in a row
+     * by row pass.
+     */
+    #pragma omp parallel for schedule(dynamic)
+    for (j = 0; j < (long)colsB; j++) {
+        for (size_t i = 0; i < rowsA; i++) {
+            size_t row = (revPass) ? (rowsA - i - 1) : i;
             size_t boundK = (revPass) ? (rowsA - row - 1) : row;
+            T tmp = ZERO<T>();
+
+            for (size_t k = 0; k <= boundK; k++) {
+                size_t col = (revPass) ? (rowsA - k - 1) : k;
 
-            tmp = ZERO<T>();
-            for (k = 0; k <= boundK; k++) {
-                col = (revPass) ? (rowsA - k - 1) : k;
                 if (col == row) {
-                    a = (diag == clblasUnit) ? ONE<T>() : ma[row][col];
+                    T a = (diag == clblasUnit) ? ONE<T>() : ma[row][col];
                     tmp = (mb[row][j] - tmp) / a;
                 }
                 else {
@@ -679,10 +686,7 @@ trsm(
             }
             mb[row][j] = tmp;
         }
-    }
-
-    for (i = 0; i < rowsA; i++) {
-        for (j = 0; j < colsB; j++) {
+        for (size_t i = 0; i < rowsA; i++) {
             mb[i][j] = mb[i][j] * alpha;
         }
     }
@@ -702,22 +706,22 @@ syrk(
     T *C,
     size_t ldc)
 {
-    size_t i, j, k;
     clblasTranspose tr =
             trans == clblasNoTrans ? clblasNoTrans : clblasTrans;
     MatrixAccessor<T> ma(const_cast<T*>(A), order, tr, N, K, lda);
     MatrixAccessor<T> mc(C, order, clblasNoTrans, N, N, ldc);
-    T tmp;
+    long i;
 
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            if ((uplo == clblasLower && j > i) ||
-                (uplo == clblasUpper && i > j)) {
+    #pragma omp parallel for schedule(dynamic)
+    for (i = 0; i < (long)N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            if ((uplo == clblasLower && j > (size_t)i) ||
+                (uplo == clblasUpper && (size_t)i > j)) {
                 continue;
             }
 
-            tmp = ZERO<T>();
-            for (k = 0; k < K; k++) {
+            T tmp = ZERO<T>();
+            for (size_t k = 0; k < K; k++) {
                 tmp = tmp + ma[i][k] * ma[j][k];
             }
             mc[i][j] = mc[i][j] * beta + tmp * alpha;
@@ -781,8 +785,7 @@ gemv(
     int incy)
 {
     size_t sizeX, sizeY;
-    size_t m, n;
-    T tmp;
+    long m;
 
     if(transA == clblasNoTrans) {
         sizeX = N;
@@ -797,9 +800,11 @@ gemv(
     VectorAccessor<T, int> vx(const_cast<T*>(X), sizeX, incx);
     VectorAccessor<T, int> vy(const_cast<T*>(Y), sizeY, incy);
 
-    for (m = 0; m < sizeY; m++) {
-        tmp = ZERO<T>();
-        for (n = 0; n < sizeX; n++) {
+    #pragma omp parallel for
+    for (m = 0; m < (long)sizeY; m++) {
+        T tmp = ZERO<T>();
+
+        for (size_t n = 0; n < sizeX; n++) {
             tmp = tmp + ma[m][n] * vx[n];
         }
         vy[m] = tmp * alpha + vy[m] * beta;
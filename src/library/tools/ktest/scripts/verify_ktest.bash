@@ -80,7 +80,7 @@ forward_options_and_call_test()
 
         if [ $stat -eq 0 ]
         then
-            g++ -o test ktest.cpp -I$AMDAPPSDKROOT/include -lOpenCL
+            g++ -fopenmp -o test ktest.cpp -I$AMDAPPSDKROOT/include -lOpenCL
             stat=$?
             err_msg="[ERROR]: test compilation has failed!"=
         fi
@@ -0,0 +1,1082 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * pathbench: time every implementation path of GEMM, TRSM and TRMM
+ *
+ * Each problem of the list is run once per path, the path being forced
+ * with CLBLAS_FORCE_PATH; a path that can't serve the problem makes the
+ * call fail with clblasNotImplemented and is reported as such. The result
+ * of every path is checked against a host reference at a sample of
+ * entries, the residual op(A) * X - alpha * B for TRSM, and the median
+ * wall clock time of several runs is reported.
+ *
+ * With -o the fastest path of every shape class, the one the library
+ * looks up in CLBLAS_PATH_TABLE, is written when it beats the default
+ * one on all the problems of the class. A class is the routine, the
+ * transpositions and the power of two bucket of each dimension, so the
+ * problem list should cover the classes worth pinning.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <complex>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <clBLAS.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+
+#define SET_ENV(VAR) _putenv(VAR)
+
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+
+#define SET_ENV(VAR) putenv(VAR)
+
+#else /* defined(_MSC_VER) */
+#include <time.h>
+
+#define SET_ENV(VAR) putenv(VAR)
+
+#endif
+
+#define DEFAULT_SHAPES "256x256x256,1024x1024x1024,4096x4096x128,128x128x8192"
+#define DEFAULT_ROUTINES "gemm,trsm,trmm"
+#define DEFAULT_PRECISIONS "sdcz"
+#define DEFAULT_GEMM_OPS "NN,NT"
+#define DEFAULT_TRXM_OPS "LLN,RUN"
+#define DEFAULT_REPEATS 5
+
+/* entries of the result checked against the reference */
+#define NR_SAMPLES 64
+
+/* a path is pinned if it is at least that much faster than the default */
+#define MIN_GAIN 0.05
+
+enum Precision {
+    PREC_S,
+    PREC_D,
+    PREC_C,
+    PREC_Z
+};
+
+enum Routine {
+    ROUTINE_GEMM,
+    ROUTINE_TRSM,
+    ROUTINE_TRMM,
+    NR_ROUTINES
+};
+
+typedef std::complex<double> Complex;
+
+/*
+ * The paths of every routine, named as in CLBLAS_FORCE_PATH, the default
+ * one first
+ */
+static const char *gemmPaths[] = {
+    "default", "autogemm", "special", "strassen", "3m", "streamk", "splitk",
+    NULL
+};
+static const char *trsmPaths[] = {
+    "default", "recursive", "dtrsm", "lds", "image", "nolds", "cached", NULL
+};
+static const char *trmmPaths[] = {
+    "default", "recursive", "lds", "image", "cached", NULL
+};
+
+static const struct {
+    const char *name;
+    const char **paths;
+} routines[NR_ROUTINES] = {
+    { "gemm", gemmPaths },
+    { "trsm", trsmPaths },
+    { "trmm", trmmPaths }
+};
+
+/*
+ * A problem: 'op' is the transpositions of A and B for GEMM, and the side,
+ * triangle and transposition of A for TRSM and TRMM, as in the path table;
+ * K is not used by TRSM and TRMM
+ */
+struct Problem
+{
+    Routine routine;
+    Precision prec;
+    char op[4];
+    size_t M, N, K;
+};
+
+/* host copies of the operands, column major */
+struct HostData
+{
+    std::vector<Complex> A, B, C;
+    size_t lda, ldb, ldc;
+};
+
+struct Result
+{
+    const char *path;
+    bool valid;
+    double seconds;
+};
+
+/* results of a shape class, by path */
+struct ClassResults
+{
+    size_t nrProblems;
+    std::map<std::string, double> seconds;
+    std::map<std::string, size_t> nrValid;
+
+    ClassResults() : nrProblems(0) {}
+
+    /* the path is right on all the problems of the class */
+    bool valid(const std::string &path) const
+    {
+        std::map<std::string, size_t>::const_iterator it = nrValid.find(path);
+
+        return (it != nrValid.end()) && (it->second == nrProblems);
+    }
+};
+
+static bool
+isComplex(Precision prec)
+{
+    return (prec == PREC_C) || (prec == PREC_Z);
+}
+
+static bool
+isDouble(Precision prec)
+{
+    return (prec == PREC_D) || (prec == PREC_Z);
+}
+
+static size_t
+elementSize(Precision prec)
+{
+    return (isDouble(prec) ? sizeof(cl_double) : sizeof(cl_float)) *
+           (isComplex(prec) ? 2 : 1);
+}
+
+static double
+tolerance(Precision prec)
+{
+    return isDouble(prec) ? 1e-9 : 1e-3;
+}
+
+static double
+wallTime(void)
+{
+#if defined(_MSC_VER)
+    LARGE_INTEGER count, freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+
+    if (timebase.denom == 0) {
+        (void)mach_timebase_info(&timebase);
+    }
+    return (double)mach_absolute_time() * timebase.numer / timebase.denom *
+           1e-9;
+#else
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+#endif
+}
+
+static clblasTranspose
+transOf(char c)
+{
+    return (c == 'N') ? clblasNoTrans : (c == 'T') ? clblasTrans :
+                                                     clblasConjTrans;
+}
+
+/* the bucket of a dimension in the path table */
+static unsigned int
+shapeClass(size_t dim)
+{
+    unsigned int c = 0;
+
+    while (dim > 1) {
+        dim >>= 1;
+        c++;
+    }
+
+    return c;
+}
+
+static double
+randomValue(void)
+{
+    return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+static Complex
+randomElement(Precision prec)
+{
+    double re = randomValue();
+
+    return Complex(re, isComplex(prec) ? randomValue() : 0.0);
+}
+
+static std::vector<unsigned char>
+toDevice(const std::vector<Complex> &v, Precision prec)
+{
+    std::vector<unsigned char> buf(v.size() * elementSize(prec));
+    size_t nrParts = isComplex(prec) ? 2 : 1;
+
+    for (size_t i = 0; i < v.size(); i++) {
+        double parts[2] = { v[i].real(), v[i].imag() };
+
+        for (size_t p = 0; p < nrParts; p++) {
+            if (isDouble(prec)) {
+                memcpy(&buf[(i * nrParts + p) * sizeof(cl_double)], &parts[p],
+                       sizeof(cl_double));
+            }
+            else {
+                cl_float f = (cl_float)parts[p];
+
+                memcpy(&buf[(i * nrParts + p) * sizeof(cl_float)], &f,
+                       sizeof(cl_float));
+            }
+        }
+    }
+
+    return buf;
+}
+
+static std::vector<Complex>
+fromDevice(const std::vector<unsigned char> &buf, Precision prec)
+{
+    size_t nrParts = isComplex(prec) ? 2 : 1;
+    std::vector<Complex> v(buf.size() / elementSize(prec));
+
+    for (size_t i = 0; i < v.size(); i++) {
+        double parts[2] = { 0.0, 0.0 };
+
+        for (size_t p = 0; p < nrParts; p++) {
+            if (isDouble(prec)) {
+                memcpy(&parts[p], &buf[(i * nrParts + p) * sizeof(cl_double)],
+                       sizeof(cl_double));
+            }
+            else {
+                cl_float f;
+
+                memcpy(&f, &buf[(i * nrParts + p) * sizeof(cl_float)],
+                       sizeof(cl_float));
+                parts[p] = f;
+            }
+        }
+        v[i] = Complex(parts[0], parts[1]);
+    }
+
+    return v;
+}
+
+/* order of the triangular matrix */
+static size_t
+triangleOrder(const Problem &prob)
+{
+    return (prob.op[0] == 'L') ? prob.M : prob.N;
+}
+
+/*
+ * Random operands; the triangular matrix is diagonally dominant so that
+ * the solves are well conditioned
+ */
+static void
+makeHostData(const Problem &prob, HostData &h)
+{
+    size_t rowsA, colsA, rowsB, colsB;
+
+    if (prob.routine == ROUTINE_GEMM) {
+        bool ta = (prob.op[0] != 'N');
+        bool tb = (prob.op[1] != 'N');
+
+        rowsA = ta ? prob.K : prob.M;
+        colsA = ta ? prob.M : prob.K;
+        rowsB = tb ? prob.N : prob.K;
+        colsB = tb ? prob.K : prob.N;
+    }
+    else {
+        rowsA = colsA = triangleOrder(prob);
+        rowsB = prob.M;
+        colsB = prob.N;
+    }
+
+    h.lda = rowsA;
+    h.ldb = rowsB;
+    h.ldc = prob.M;
+    h.A.resize(rowsA * colsA);
+    h.B.resize(rowsB * colsB);
+    h.C.assign((prob.routine == ROUTINE_GEMM) ? prob.M * prob.N : 1,
+               Complex(0.0, 0.0));
+
+    for (size_t i = 0; i < h.A.size(); i++) {
+        h.A[i] = randomElement(prob.prec);
+    }
+    for (size_t i = 0; i < h.B.size(); i++) {
+        h.B[i] = randomElement(prob.prec);
+    }
+    if (prob.routine != ROUTINE_GEMM) {
+        for (size_t i = 0; i < h.A.size(); i++) {
+            h.A[i] /= (double)rowsA;
+        }
+        for (size_t i = 0; i < rowsA; i++) {
+            h.A[i * h.lda + i] += 2.0;
+        }
+    }
+}
+
+/* element (i, j) of op(A) for GEMM */
+static Complex
+gemmOpA(const Problem &prob, const HostData &h, size_t i, size_t j)
+{
+    Complex a = (prob.op[0] == 'N') ? h.A[j * h.lda + i] : h.A[i * h.lda + j];
+
+    return (prob.op[0] == 'C') ? std::conj(a) : a;
+}
+
+static Complex
+gemmOpB(const Problem &prob, const HostData &h, size_t i, size_t j)
+{
+    Complex b = (prob.op[1] == 'N') ? h.B[j * h.ldb + i] : h.B[i * h.ldb + j];
+
+    return (prob.op[1] == 'C') ? std::conj(b) : b;
+}
+
+/* element (i, j) of op(A) for TRSM and TRMM, the other triangle is zero */
+static Complex
+triOpA(const Problem &prob, const HostData &h, size_t i, size_t j)
+{
+    bool trans = (prob.op[2] != 'N');
+    size_t r = trans ? j : i;
+    size_t c = trans ? i : j;
+    bool upper = (prob.op[1] == 'U');
+    Complex a;
+
+    if (upper ? (r > c) : (r < c)) {
+        return Complex(0.0, 0.0);
+    }
+    a = h.A[c * h.lda + r];
+
+    return (prob.op[2] == 'C') ? std::conj(a) : a;
+}
+
+/*
+ * Entry (i, j) of op(A) * X or X * op(A) with X given by 'x', and the sum
+ * of the magnitudes of the products the error is relative to
+ */
+static Complex
+triProduct(
+    const Problem &prob,
+    const HostData &h,
+    const std::vector<Complex> &x,
+    size_t i,
+    size_t j,
+    double *scale)
+{
+    Complex sum(0.0, 0.0);
+    size_t k, n = triangleOrder(prob);
+
+    *scale = 0.0;
+    for (k = 0; k < n; k++) {
+        Complex a, b;
+
+        if (prob.op[0] == 'L') {
+            a = triOpA(prob, h, i, k);
+            b = x[j * h.ldb + k];
+        }
+        else {
+            a = x[k * h.ldb + i];
+            b = triOpA(prob, h, k, j);
+        }
+        sum += a * b;
+        *scale += std::abs(a) * std::abs(b);
+    }
+
+    return sum;
+}
+
+/*
+ * Largest error of the result 'res' at a sample of entries, relative to
+ * the magnitude of the terms it is computed from; alpha is 1 and beta 0
+ */
+static double
+checkResult(
+    const Problem &prob,
+    const HostData &h,
+    const std::vector<Complex> &res)
+{
+    double maxErr = 0.0;
+    unsigned int seed = 1;
+
+    for (size_t s = 0; s < NR_SAMPLES; s++) {
+        size_t i, j;
+        Complex ref, got;
+        double scale = 0.0;
+
+        // the corners and pseudo random entries
+        if (s < 2) {
+            i = s ? prob.M - 1 : 0;
+            j = s ? prob.N - 1 : 0;
+        }
+        else {
+            seed = seed * 1103515245u + 12345u;
+            i = (seed >> 8) % prob.M;
+            seed = seed * 1103515245u + 12345u;
+            j = (seed >> 8) % prob.N;
+        }
+
+        switch (prob.routine) {
+        case ROUTINE_GEMM:
+            ref = Complex(0.0, 0.0);
+            for (size_t k = 0; k < prob.K; k++) {
+                Complex a = gemmOpA(prob, h, i, k);
+                Complex b = gemmOpB(prob, h, k, j);
+
+                ref += a * b;
+                scale += std::abs(a) * std::abs(b);
+            }
+            got = res[j * h.ldc + i];
+            break;
+        case ROUTINE_TRSM:
+            // the residual of the solution
+            ref = h.B[j * h.ldb + i];
+            got = triProduct(prob, h, res, i, j, &scale);
+            scale += std::abs(ref);
+            break;
+        default:
+            ref = triProduct(prob, h, h.B, i, j, &scale);
+            got = res[j * h.ldb + i];
+            break;
+        }
+
+        if (scale == 0.0) {
+            scale = 1.0;
+        }
+        maxErr = std::max(maxErr, std::abs(got - ref) / scale);
+    }
+
+    return maxErr;
+}
+
+static double
+flopCount(const Problem &prob)
+{
+    double m = (double)prob.M, n = (double)prob.N;
+    double flops;
+
+    if (prob.routine == ROUTINE_GEMM) {
+        flops = 2.0 * m * n * (double)prob.K;
+    }
+    else {
+        flops = (prob.op[0] == 'L') ? m * m * n : m * n * n;
+    }
+
+    return isComplex(prob.prec) ? 4.0 * flops : flops;
+}
+
+static clblasStatus
+runGemm(const Problem &prob, const HostData &h, cl_mem A, cl_mem B, cl_mem C,
+        cl_command_queue *queue)
+{
+    clblasTranspose ta = transOf(prob.op[0]);
+    clblasTranspose tb = transOf(prob.op[1]);
+
+    switch (prob.prec) {
+    case PREC_S:
+        return clblasSgemm(clblasColumnMajor, ta, tb, prob.M, prob.N, prob.K,
+            1.0f, A, 0, h.lda, B, 0, h.ldb, 0.0f, C, 0, h.ldc,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDgemm(clblasColumnMajor, ta, tb, prob.M, prob.N, prob.K,
+            1.0, A, 0, h.lda, B, 0, h.ldb, 0.0, C, 0, h.ldc,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCgemm(clblasColumnMajor, ta, tb, prob.M, prob.N, prob.K,
+            floatComplex(1, 0), A, 0, h.lda, B, 0, h.ldb, floatComplex(0, 0),
+            C, 0, h.ldc, 1, queue, 0, NULL, NULL);
+    default:
+        return clblasZgemm(clblasColumnMajor, ta, tb, prob.M, prob.N, prob.K,
+            doubleComplex(1, 0), A, 0, h.lda, B, 0, h.ldb, doubleComplex(0, 0),
+            C, 0, h.ldc, 1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runTrsm(const Problem &prob, const HostData &h, cl_mem A, cl_mem B,
+        cl_command_queue *queue)
+{
+    clblasSide side = (prob.op[0] == 'L') ? clblasLeft : clblasRight;
+    clblasUplo uplo = (prob.op[1] == 'U') ? clblasUpper : clblasLower;
+    clblasTranspose ta = transOf(prob.op[2]);
+
+    switch (prob.prec) {
+    case PREC_S:
+        return clblasStrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, 1.0f, A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, 1.0, A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, floatComplex(1, 0), A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    default:
+        return clblasZtrsm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, doubleComplex(1, 0), A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    }
+}
+
+static clblasStatus
+runTrmm(const Problem &prob, const HostData &h, cl_mem A, cl_mem B,
+        cl_command_queue *queue)
+{
+    clblasSide side = (prob.op[0] == 'L') ? clblasLeft : clblasRight;
+    clblasUplo uplo = (prob.op[1] == 'U') ? clblasUpper : clblasLower;
+    clblasTranspose ta = transOf(prob.op[2]);
+
+    switch (prob.prec) {
+    case PREC_S:
+        return clblasStrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, 1.0f, A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    case PREC_D:
+        return clblasDtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, 1.0, A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    case PREC_C:
+        return clblasCtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, floatComplex(1, 0), A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    default:
+        return clblasZtrmm(clblasColumnMajor, side, uplo, ta, clblasNonUnit,
+            prob.M, prob.N, doubleComplex(1, 0), A, 0, h.lda, B, 0, h.ldb,
+            1, queue, 0, NULL, NULL);
+    }
+}
+
+/*
+ * One timed call: B is restored first since TRSM and TRMM overwrite it
+ */
+static clblasStatus
+runOnce(
+    const Problem &prob,
+    const HostData &h,
+    const std::vector<unsigned char> &hostB,
+    cl_mem A,
+    cl_mem B,
+    cl_mem C,
+    cl_command_queue queue,
+    double *seconds)
+{
+    clblasStatus status;
+    double start;
+    cl_int err;
+
+    err = clEnqueueWriteBuffer(queue, B, CL_TRUE, 0, hostB.size(), &hostB[0],
+                               0, NULL, NULL);
+    if (err != CL_SUCCESS) {
+        return (clblasStatus)err;
+    }
+
+    start = wallTime();
+    switch (prob.routine) {
+    case ROUTINE_GEMM:
+        status = runGemm(prob, h, A, B, C, &queue);
+        break;
+    case ROUTINE_TRSM:
+        status = runTrsm(prob, h, A, B, &queue);
+        break;
+    default:
+        status = runTrmm(prob, h, A, B, &queue);
+        break;
+    }
+    if (status == clblasSuccess) {
+        status = (clblasStatus)clFinish(queue);
+    }
+    *seconds = wallTime() - start;
+
+    return status;
+}
+
+static cl_mem
+createBuffer(cl_context context, const std::vector<unsigned char> &data)
+{
+    return clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                          data.size(), (void*)&data[0], NULL);
+}
+
+static void
+problemName(const Problem &prob, char *buf, size_t size)
+{
+    if (prob.routine == ROUTINE_GEMM) {
+        snprintf(buf, size, "%cgemm %s %lux%lux%lu", "sdcz"[prob.prec],
+                 prob.op, (unsigned long)prob.M, (unsigned long)prob.N,
+                 (unsigned long)prob.K);
+    }
+    else {
+        snprintf(buf, size, "%c%s %s %lux%lu", "sdcz"[prob.prec],
+                 routines[prob.routine].name, prob.op, (unsigned long)prob.M,
+                 (unsigned long)prob.N);
+    }
+}
+
+/* the key of the class of a problem, as a line of the path table */
+static std::string
+classKey(const Problem &prob)
+{
+    char key[64];
+
+    snprintf(key, sizeof(key), "%c%s %s %u %u %u", "sdcz"[prob.prec],
+             routines[prob.routine].name, prob.op, shapeClass(prob.M),
+             shapeClass(prob.N),
+             (prob.routine == ROUTINE_GEMM) ? shapeClass(prob.K) : 0);
+
+    return key;
+}
+
+/*
+ * Run a problem on every path of its routine, print the results and
+ * return them
+ */
+static std::vector<Result>
+benchProblem(
+    const Problem &prob,
+    cl_context context,
+    cl_command_queue queue,
+    unsigned int repeats)
+{
+    static char forceEnv[64];
+    const char **paths = routines[prob.routine].paths;
+    std::vector<Result> results;
+    HostData h;
+    char name[64];
+    cl_mem A, B, C;
+
+    makeHostData(prob, h);
+    std::vector<unsigned char> hostA = toDevice(h.A, prob.prec);
+    std::vector<unsigned char> hostB = toDevice(h.B, prob.prec);
+    std::vector<unsigned char> hostC = toDevice(h.C, prob.prec);
+    A = createBuffer(context, hostA);
+    B = createBuffer(context, hostB);
+    C = createBuffer(context, hostC);
+
+    problemName(prob, name, sizeof(name));
+    printf("%s\n", name);
+    if ((A == NULL) || (B == NULL) || (C == NULL)) {
+        printf("  cannot allocate the buffers\n");
+    }
+
+    for (size_t p = 0; (paths[p] != NULL) && (A != NULL) && (B != NULL) &&
+                       (C != NULL); p++) {
+        std::vector<double> times;
+        Result res;
+        clblasStatus status;
+        double seconds, err = 0.0;
+
+        res.path = paths[p];
+        res.valid = false;
+        res.seconds = 0.0;
+
+        snprintf(forceEnv, sizeof(forceEnv), "CLBLAS_FORCE_PATH=%s", paths[p]);
+        SET_ENV(forceEnv);
+
+        // the first call builds the kernels and is not timed
+        status = runOnce(prob, h, hostB, A, B, C, queue, &seconds);
+        for (unsigned int r = 0; (r < repeats) && (status == clblasSuccess);
+             r++) {
+
+            status = runOnce(prob, h, hostB, A, B, C, queue, &seconds);
+            times.push_back(seconds);
+        }
+
+        if (status == clblasNotImplemented) {
+            printf("  %-10s not applicable\n", paths[p]);
+            continue;
+        }
+        if (status != clblasSuccess) {
+            printf("  %-10s failed, status %d\n", paths[p], (int)status);
+            continue;
+        }
+
+        std::vector<unsigned char> out((prob.routine == ROUTINE_GEMM) ?
+                                       hostC.size() : hostB.size());
+        if (clEnqueueReadBuffer(queue, (prob.routine == ROUTINE_GEMM) ? C : B,
+                                CL_TRUE, 0, out.size(), &out[0], 0, NULL,
+                                NULL) != CL_SUCCESS) {
+            printf("  %-10s cannot read the result\n", paths[p]);
+            continue;
+        }
+        err = checkResult(prob, h, fromDevice(out, prob.prec));
+
+        std::sort(times.begin(), times.end());
+        res.seconds = times[times.size() / 2];
+        res.valid = (err <= tolerance(prob.prec));
+        results.push_back(res);
+
+        printf("  %-10s %10.3f ms %9.1f GFLOPS  error %.1e%s\n", paths[p],
+               res.seconds * 1e3, flopCount(prob) / res.seconds * 1e-9, err,
+               res.valid ? "" : "  WRONG");
+    }
+    snprintf(forceEnv, sizeof(forceEnv), "CLBLAS_FORCE_PATH=");
+    SET_ENV(forceEnv);
+
+    if (A != NULL) {
+        clReleaseMemObject(A);
+    }
+    if (B != NULL) {
+        clReleaseMemObject(B);
+    }
+    if (C != NULL) {
+        clReleaseMemObject(C);
+    }
+
+    return results;
+}
+
+/* add the results of a problem to its class, summing the times */
+static void
+addToClass(ClassResults &cls, const std::vector<Result> &results)
+{
+    cls.nrProblems++;
+    for (size_t i = 0; i < results.size(); i++) {
+        cls.seconds[results[i].path] += results[i].seconds;
+        if (results[i].valid) {
+            cls.nrValid[results[i].path]++;
+        }
+    }
+}
+
+static bool
+writeTable(
+    const char *output,
+    cl_device_id device,
+    const std::map<std::string, ClassResults> &classes)
+{
+    std::map<std::string, ClassResults>::const_iterator it;
+    char devName[256], driver[256];
+    cl_uint major, minor, patch;
+    FILE *f;
+    size_t nrPinned = 0;
+
+    f = fopen(output, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Cannot open '%s'\n", output);
+        return false;
+    }
+
+    devName[0] = driver[0] = '\0';
+    clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(devName), devName, NULL);
+    clGetDeviceInfo(device, CL_DRIVER_VERSION, sizeof(driver), driver, NULL);
+    clblasGetVersion(&major, &minor, &patch);
+    fprintf(f, "# clBLAS %u.%u.%u path table for %s, driver %s\n",
+            major, minor, patch, devName, driver);
+    fprintf(f, "# <routine> <op> <log2 M> <log2 N> <log2 K> <path>\n");
+
+    for (it = classes.begin(); it != classes.end(); ++it) {
+        const ClassResults &cls = it->second;
+        std::map<std::string, double>::const_iterator p;
+        std::map<std::string, double>::const_iterator def;
+        std::string best;
+        double bestTime = 0.0;
+
+        def = cls.seconds.find("default");
+        if ((def == cls.seconds.end()) || !cls.valid("default")) {
+            continue;
+        }
+        for (p = cls.seconds.begin(); p != cls.seconds.end(); ++p) {
+            if (cls.valid(p->first) &&
+                (best.empty() || (p->second < bestTime))) {
+
+                best = p->first;
+                bestTime = p->second;
+            }
+        }
+        if ((best != "default") &&
+            (bestTime < (1.0 - MIN_GAIN) * def->second)) {
+            fprintf(f, "%s %s\n", it->first.c_str(), best.c_str());
+            nrPinned++;
+        }
+    }
+    fclose(f);
+
+    printf("%lu of %lu shape classes pinned in '%s'\n",
+           (unsigned long)nrPinned, (unsigned long)classes.size(), output);
+
+    return true;
+}
+
+static void
+split(const char *list, std::vector<std::string> &items)
+{
+    std::string s(list);
+    size_t start = 0;
+
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+
+        if (end == std::string::npos) {
+            end = s.size();
+        }
+        if (end > start) {
+            items.push_back(s.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+}
+
+static bool
+hasDouble(cl_device_id device)
+{
+    char extensions[4096];
+
+    if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, sizeof(extensions),
+                        extensions, NULL) != CL_SUCCESS) {
+        return false;
+    }
+
+    return (strstr(extensions, "cl_khr_fp64") != NULL) ||
+           (strstr(extensions, "cl_amd_fp64") != NULL);
+}
+
+static bool
+validOp(Routine routine, const std::string &op)
+{
+    if (routine == ROUTINE_GEMM) {
+        return (op.size() == 2) && strchr("NTC", op[0]) && strchr("NTC", op[1]);
+    }
+
+    return (op.size() == 3) && strchr("LR", op[0]) && strchr("UL", op[1]) &&
+           strchr("NTC", op[2]);
+}
+
+static void
+printUsage(const char *app)
+{
+    printf("Usage: %s [options]\n"
+           "  -o <table>       file the path table is written to\n"
+           "  -p <platform>    index of the OpenCL platform (0)\n"
+           "  -d <device>      index of the GPU device on the platform (0)\n"
+           "  -s <shapes>      comma separated MxNxK shapes (%s)\n"
+           "  -r <routines>    comma separated routines (%s)\n"
+           "  -t <precisions>  precisions among 'sdcz' (%s)\n"
+           "  -g <ops>         transpositions of A and B for GEMM (%s)\n"
+           "  -x <ops>         side, triangle and transposition of A for\n"
+           "                   TRSM and TRMM (%s)\n"
+           "  -n <repeats>     timed runs of every path (%u)\n"
+           "K is not used by TRSM and TRMM. Double precision is skipped on\n"
+           "devices without it.\n",
+           app, DEFAULT_SHAPES, DEFAULT_ROUTINES, DEFAULT_PRECISIONS,
+           DEFAULT_GEMM_OPS, DEFAULT_TRXM_OPS, DEFAULT_REPEATS);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *output = NULL;
+    const char *shapesArg = DEFAULT_SHAPES;
+    const char *routinesArg = DEFAULT_ROUTINES;
+    const char *precisionsArg = DEFAULT_PRECISIONS;
+    const char *gemmOpsArg = DEFAULT_GEMM_OPS;
+    const char *trxmOpsArg = DEFAULT_TRXM_OPS;
+    unsigned int platformIdx = 0, deviceIdx = 0;
+    unsigned int repeats = DEFAULT_REPEATS;
+    std::vector<std::string> names, shapes, gemmOps, trxmOps;
+    std::vector<cl_platform_id> platforms;
+    std::vector<cl_device_id> devices;
+    std::vector<Problem> problems;
+    std::map<std::string, ClassResults> classes;
+    static char tableEnv[] = "CLBLAS_PATH_TABLE=";
+    cl_uint nr;
+    cl_device_id device;
+    cl_context context;
+    cl_command_queue queue;
+    cl_context_properties props[3] = { CL_CONTEXT_PLATFORM, 0, 0 };
+    cl_int err;
+    bool fp64, ok = true;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if ((argv[i][0] != '-') || (argv[i][1] == '\0') ||
+            (argv[i][2] != '\0') || (value == NULL)) {
+
+            printUsage(argv[0]);
+            return 1;
+        }
+        switch (argv[i][1]) {
+        case 'o': output = value; break;
+        case 'p': platformIdx = (unsigned int)atoi(value); break;
+        case 'd': deviceIdx = (unsigned int)atoi(value); break;
+        case 's': shapesArg = value; break;
+        case 'r': routinesArg = value; break;
+        case 't': precisionsArg = value; break;
+        case 'g': gemmOpsArg = value; break;
+        case 'x': trxmOpsArg = value; break;
+        case 'n': repeats = (unsigned int)atoi(value); break;
+        default:
+            printUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (repeats == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    err = clGetPlatformIDs(0, NULL, &nr);
+    if ((err != CL_SUCCESS) || (platformIdx >= nr)) {
+        fprintf(stderr, "No OpenCL platform %u\n", platformIdx);
+        return 1;
+    }
+    platforms.resize(nr);
+    clGetPlatformIDs(nr, &platforms[0], NULL);
+
+    err = clGetDeviceIDs(platforms[platformIdx], CL_DEVICE_TYPE_GPU, 0,
+                         NULL, &nr);
+    if ((err != CL_SUCCESS) || (deviceIdx >= nr)) {
+        fprintf(stderr, "No GPU device %u on platform %u\n", deviceIdx,
+                platformIdx);
+        return 1;
+    }
+    devices.resize(nr);
+    clGetDeviceIDs(platforms[platformIdx], CL_DEVICE_TYPE_GPU, nr,
+                   &devices[0], NULL);
+    device = devices[deviceIdx];
+    fp64 = hasDouble(device);
+
+    // the list of problems
+    split(routinesArg, names);
+    split(shapesArg, shapes);
+    split(gemmOpsArg, gemmOps);
+    split(trxmOpsArg, trxmOps);
+    for (size_t r = 0; r < names.size(); r++) {
+        int routine;
+
+        for (routine = 0; routine < NR_ROUTINES; routine++) {
+            if (names[r] == routines[routine].name) {
+                break;
+            }
+        }
+        if (routine == NR_ROUTINES) {
+            fprintf(stderr, "Unknown routine '%s'\n", names[r].c_str());
+            return 1;
+        }
+        const std::vector<std::string> &ops =
+            (routine == ROUTINE_GEMM) ? gemmOps : trxmOps;
+
+        for (const char *p = precisionsArg; *p != '\0'; p++) {
+            const char *prec = strchr(DEFAULT_PRECISIONS, *p);
+            Problem prob;
+
+            if (prec == NULL) {
+                fprintf(stderr, "Unknown precision '%c'\n", *p);
+                return 1;
+            }
+            prob.routine = (Routine)routine;
+            prob.prec = (Precision)(prec - DEFAULT_PRECISIONS);
+            if (!fp64 && isDouble(prob.prec)) {
+                continue;
+            }
+            for (size_t o = 0; o < ops.size(); o++) {
+                if (!validOp(prob.routine, ops[o])) {
+                    fprintf(stderr, "Invalid %s operation '%s'\n",
+                            routines[routine].name, ops[o].c_str());
+                    return 1;
+                }
+                strcpy(prob.op, ops[o].c_str());
+                for (size_t s = 0; s < shapes.size(); s++) {
+                    unsigned long m = 0, n = 0, k = 0;
+
+                    if ((sscanf(shapes[s].c_str(), "%lux%lux%lu", &m, &n,
+                                &k) != 3) || (m == 0) || (n == 0) ||
+                        (k == 0)) {
+
+                        fprintf(stderr, "Invalid shape '%s'\n",
+                                shapes[s].c_str());
+                        return 1;
+                    }
+                    prob.M = m;
+                    prob.N = n;
+                    prob.K = k;
+                    problems.push_back(prob);
+                }
+            }
+        }
+    }
+    if (!fp64) {
+        printf("The device has no double precision, skipping 'd' and 'z'\n");
+    }
+
+    props[1] = (cl_context_properties)platforms[platformIdx];
+    context = clCreateContext(props, 1, &device, NULL, NULL, &err);
+    if (err != CL_SUCCESS) {
+        fprintf(stderr, "clCreateContext() failed with %d\n", err);
+        return 1;
+    }
+    queue = clCreateCommandQueue(context, device, 0, &err);
+    if (err != CL_SUCCESS) {
+        fprintf(stderr, "clCreateCommandQueue() failed with %d\n", err);
+        clReleaseContext(context);
+        return 1;
+    }
+
+    // the default path must be the library's own choice, not a table's
+    SET_ENV(tableEnv);
+    err = clblasSetup();
+    if (err != CL_SUCCESS) {
+        fprintf(stderr, "clblasSetup() failed with %d\n", err);
+        clReleaseCommandQueue(queue);
+        clReleaseContext(context);
+        return 1;
+    }
+
+    srand(1);
+    for (size_t p = 0; p < problems.size(); p++) {
+        std::vector<Result> results = benchProblem(problems[p], context,
+                                                   queue, repeats);
+
+        addToClass(classes[classKey(problems[p])], results);
+    }
+
+    clblasTeardown();
+
+    if (output != NULL) {
+        ok = writeTable(output, device, classes);
+    }
+    clReleaseCommandQueue(queue);
+    clReleaseContext(context);
+
+    return ok ? 0 : 1;
+}
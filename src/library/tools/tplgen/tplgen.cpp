@@ -20,8 +20,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define KERNEL_BLOB_ENCODER
+#include <kernel_blob.h>
+
 #ifdef __GNUC__
 // Linux
+    #include <limits.h>
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <unistd.h>
@@ -35,7 +39,16 @@
 
 using namespace std;
 
-void binaryCaseProcess(const string &inputStr, std::ostream &outFile)
+//Symbol declared by the text before the @, e.g. 'const char name '
+static string symbolName(const string &declaration)
+{
+  size_t last = declaration.find_last_not_of(" ");
+  size_t first = declaration.find_last_of(" *", last);
+
+  return declaration.substr(first + 1, last - first);
+}
+
+void binaryCaseProcess(const string &inputStr, std::ostream &outFile, const char *outputPrefix)
 {
   //Get the binary location in fileName
   size_t found = inputStr.find( '@' );
@@ -62,21 +75,71 @@ void binaryCaseProcess(const string &inputStr, std::ostream &outFile)
   }
   file.close();
 
+  //Compress it, the library decodes it the first time the kernel is built
+  unsigned char* blob = new unsigned char[KERNEL_BLOB_BOUND(fileSize)];
+  size_t blobSize = kernelBlobEncode((unsigned char*)fileContents, fileSize, blob);
+  if (blobSize == 0)
+  {
+    std::cerr << "fail to compress binary file '" <<  fileName << "'" << std::endl;
+    exit(1);
+  }
+  delete[] fileContents;
+
+  string symbol = symbolName(inputStr.substr (0,found));
 
   outFile << "//generated from the binary: " << fileName << "\n";
+  outFile << "//" << fileSize << " bytes compressed to " << blobSize << "\n";
+
+#ifdef __GNUC__
+  //Write the blob next to the .clT for the assembler to pull it in, the
+  //path must not depend on the directory the library is compiled from
+  char blobDir[PATH_MAX];
+  if (realpath(outputPrefix, blobDir) == NULL)
+  {
+    std::cerr << "fail to resolve output directory '" <<  outputPrefix << "'" << std::endl;
+    exit(1);
+  }
+  string blobName = string(blobDir) + "/" + symbol + ".clz";
+  std::ofstream blobFile (blobName.c_str(), std::ios::out | std::ios::binary);
+  if (!blobFile.write((const char*)blob, blobSize))
+  {
+    std::cerr << "fail to write compressed binary '" <<  blobName << "'" << std::endl;
+    exit(1);
+  }
+  blobFile.close();
+
+  //The .clT may be included by several sources, the comdat group keeps
+  //one copy of the blob
+  outFile << "#if defined(__GNUC__) && defined(__ELF__)\n";
+  outFile << "__asm__(\".pushsection " KERNEL_BLOB_SECTION_NAME ",\\\"aG\\\",@progbits,"
+          << symbol << ",comdat\\n\"\n";
+  outFile << "        \".weak " << symbol << "\\n\"\n";
+  outFile << "        \".hidden " << symbol << "\\n\"\n";
+  outFile << "        \"" << symbol << ":\\n\"\n";
+  outFile << "        \".incbin \\\"" << blobName << "\\\"\\n\"\n";
+  outFile << "        \".popsection\\n\");\n";
+  outFile << "extern \"C\" const char " << symbol << "[" << blobSize << "];\n";
+  outFile << "#else\n";
+#endif
 
   //Copy the chars found before the @
   outFile <<  inputStr.substr (0,found);
 
-  //Write contents of the binary
-  outFile << "[" << fileSize << "] = {\n";
-  for(int i=0; i < fileSize; i++)
+  //Write contents of the blob
+  outFile << "[" << blobSize << "] = {\n";
+  for(size_t i=0; i < blobSize; i++)
   {
-    outFile << (int) fileContents[i];
-    if(i < fileSize-1) outFile << ",";
+    outFile << (int) (char) blob[i];
+    if(i < blobSize-1) outFile << ",";
     if((i+1)%50 == 0) outFile << "\n";
   }
   outFile << "\n};\n";
+
+#ifdef __GNUC__
+  outFile << "#endif\n";
+#endif
+
+  delete[] blob;
 }
 
 
@@ -205,7 +268,7 @@ int main( int argc, char *argv[] )
             // Deals with the case of a binary
             else if( !validKernel && (str.find( "char" ) != string::npos) && (str.find( '@' ) != string::npos))
             {
-              binaryCaseProcess(str, outFile);
+              binaryCaseProcess(str, outFile, outputPrefix);
             }
             // Find for end of kernel
             else if( (str.find( "\";" ) != string::npos) && validKernel )
@@ -0,0 +1,801 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Blocked reference: the columns of the result are spread over threads,
+ * and every thread walks its columns by blocks of A small enough to stay
+ * in cache. A transposed A is copied out first so that the innermost loop
+ * is always a unit stride update the compiler can vectorize. Every element
+ * is accumulated in the same order as in the reference library's column
+ * oriented loops, K ascending, so the results are as accurate as the naive
+ * ones.
+ */
+
+#include <stdio.h>          /* fprintf(), stderr */
+#include <stdlib.h>         /* abort(), getenv() */
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <clBLAS.h>
+#include <blas-blocked.h>
+
+/* rows and depth of the blocks of A */
+#define BLOCK_M 256
+#define BLOCK_K 128
+
+/* columns of the result handed to a thread at once */
+#define BLOCK_N 16
+
+/* calls with less multiply-adds than that run on the calling thread */
+#define MIN_PARALLEL_WORK 262144.0
+
+typedef void (*RangeFunc)(void *arg, size_t first, size_t last);
+
+/*
+ * A thread takes the chunks of 'step' columns 'index', 'index' +
+ * 'nrThreads', and so on, so that the triangular routines are balanced
+ */
+struct Worker
+{
+    RangeFunc func;
+    void *arg;
+    size_t n;
+    size_t step;
+    size_t index;
+    size_t nrThreads;
+};
+
+static void
+runWorker(Worker *w)
+{
+    for (size_t first = w->index * w->step; first < w->n;
+         first += w->nrThreads * w->step) {
+
+        w->func(w->arg, first, std::min(first + w->step, w->n));
+    }
+}
+
+#if defined(_MSC_VER)
+
+typedef HANDLE ThreadID;
+
+static unsigned __stdcall
+workerThread(void *arg)
+{
+    runWorker((Worker*)arg);
+    return 0;
+}
+
+static bool
+startThread(ThreadID *id, Worker *w)
+{
+    *id = (HANDLE)_beginthreadex(NULL, 0, &workerThread, w, 0, NULL);
+    return (*id != 0);
+}
+
+static void
+joinThread(ThreadID id)
+{
+    WaitForSingleObject(id, INFINITE);
+    CloseHandle(id);
+}
+
+static unsigned int
+nrProcessors(void)
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (unsigned int)info.dwNumberOfProcessors;
+}
+
+#else   /* _MSC_VER */
+
+typedef pthread_t ThreadID;
+
+static void*
+workerThread(void *arg)
+{
+    runWorker((Worker*)arg);
+    return NULL;
+}
+
+static bool
+startThread(ThreadID *id, Worker *w)
+{
+    return (pthread_create(id, NULL, workerThread, w) == 0);
+}
+
+static void
+joinThread(ThreadID id)
+{
+    pthread_join(id, NULL);
+}
+
+static unsigned int
+nrProcessors(void)
+{
+    long nr = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (nr > 0) ? (unsigned int)nr : 1;
+}
+
+#endif  /* !_MSC_VER */
+
+static unsigned int
+nrThreads(void)
+{
+    static unsigned int nr = 0;
+
+    if (nr == 0) {
+        const char *env = getenv("CLBLAS_TEST_REF_THREADS");
+
+        nr = (env != NULL) ? (unsigned int)atoi(env) : nrProcessors();
+        if (nr == 0) {
+            nr = 1;
+        }
+    }
+
+    return nr;
+}
+
+/*
+ * Call 'func' on the columns [0, n) by chunks of 'step'; 'work' is the
+ * number of multiply-adds the call takes
+ */
+static void
+parallelFor(size_t n, size_t step, double work, RangeFunc func, void *arg)
+{
+    size_t nr = std::min((size_t)nrThreads(), (n + step - 1) / step);
+    std::vector<Worker> workers;
+    std::vector<ThreadID> ids;
+    std::vector<bool> started;
+
+    if ((nr <= 1) || (work < MIN_PARALLEL_WORK)) {
+        func(arg, 0, n);
+        return;
+    }
+
+    workers.resize(nr);
+    ids.resize(nr);
+    started.resize(nr, false);
+    for (size_t t = 0; t < nr; t++) {
+        workers[t].func = func;
+        workers[t].arg = arg;
+        workers[t].n = n;
+        workers[t].step = step;
+        workers[t].index = t;
+        workers[t].nrThreads = nr;
+    }
+    // the calling thread takes the first share, and the ones of the
+    // threads that could not be started
+    for (size_t t = 1; t < nr; t++) {
+        started[t] = startThread(&ids[t], &workers[t]);
+    }
+    runWorker(&workers[0]);
+    for (size_t t = 1; t < nr; t++) {
+        if (started[t]) {
+            joinThread(ids[t]);
+        }
+        else {
+            runWorker(&workers[t]);
+        }
+    }
+}
+
+/*
+ * Arithmetic of the four types; the complex operators of blas-math.h are
+ * not used, they compute the imaginary parts of sums wrongly
+ */
+template <typename T> static inline T
+fromReal(double a)
+{
+    return (T)a;
+}
+
+template <> inline FloatComplex
+fromReal<FloatComplex>(double a)
+{
+    return floatComplex((cl_float)a, 0.0f);
+}
+
+template <> inline DoubleComplex
+fromReal<DoubleComplex>(double a)
+{
+    return doubleComplex(a, 0.0);
+}
+
+static inline float conjOf(float a) { return a; }
+static inline double conjOf(double a) { return a; }
+static inline bool isZero(float a) { return (a == 0.0f); }
+static inline bool isZero(double a) { return (a == 0.0); }
+static inline float add(float a, float b) { return a + b; }
+static inline double add(double a, double b) { return a + b; }
+static inline float sub(float a, float b) { return a - b; }
+static inline double sub(double a, double b) { return a - b; }
+static inline float mul(float a, float b) { return a * b; }
+static inline double mul(double a, double b) { return a * b; }
+static inline float divide(float a, float b) { return a / b; }
+static inline double divide(double a, double b) { return a / b; }
+
+#define COMPLEX_ARITHMETIC(T, MAKE)                                         \
+    static inline T                                                         \
+    conjOf(T a)                                                             \
+    {                                                                       \
+        return MAKE(CREAL(a), -CIMAG(a));                                   \
+    }                                                                       \
+                                                                            \
+    static inline bool                                                      \
+    isZero(T a)                                                             \
+    {                                                                       \
+        return (CREAL(a) == 0) && (CIMAG(a) == 0);                          \
+    }                                                                       \
+                                                                            \
+    static inline T                                                         \
+    add(T a, T b)                                                           \
+    {                                                                       \
+        return MAKE(CREAL(a) + CREAL(b), CIMAG(a) + CIMAG(b));              \
+    }                                                                       \
+                                                                            \
+    static inline T                                                         \
+    sub(T a, T b)                                                           \
+    {                                                                       \
+        return MAKE(CREAL(a) - CREAL(b), CIMAG(a) - CIMAG(b));              \
+    }                                                                       \
+                                                                            \
+    static inline T                                                         \
+    mul(T a, T b)                                                           \
+    {                                                                       \
+        return MAKE(CREAL(a) * CREAL(b) - CIMAG(a) * CIMAG(b),              \
+                    CREAL(a) * CIMAG(b) + CIMAG(a) * CREAL(b));             \
+    }                                                                       \
+                                                                            \
+    static inline T                                                         \
+    divide(T a, T b)                                                        \
+    {                                                                       \
+        double d = (double)CREAL(b) * CREAL(b) +                           \
+                   (double)CIMAG(b) * CIMAG(b);                             \
+                                                                            \
+        return MAKE((CREAL(a) * CREAL(b) + CIMAG(a) * CIMAG(b)) / d,        \
+                    (CIMAG(a) * CREAL(b) - CREAL(a) * CIMAG(b)) / d);       \
+    }
+
+COMPLEX_ARITHMETIC(FloatComplex, floatComplex)
+COMPLEX_ARITHMETIC(DoubleComplex, doubleComplex)
+
+/* element (i, j) of op(A) */
+template <typename T> static inline T
+opElem(const T *A, size_t lda, clblasTranspose trans, size_t i, size_t j)
+{
+    if (trans == clblasNoTrans) {
+        return A[j * lda + i];
+    }
+
+    return (trans == clblasConjTrans) ? conjOf(A[i * lda + j]) : A[i * lda + j];
+}
+
+static void
+checkOrder(clblasOrder order)
+{
+    if (order != clblasColumnMajor) {
+        fprintf(stderr, "LAPACK routines require clblasColumnMajor order\n");
+        abort();
+    }
+}
+
+/*
+ * GEMM, and SYRK with 'triangle': only the rows from the diagonal down
+ * (clblasLower) or up to it (clblasUpper) of every column are computed
+ */
+template <typename T> struct GemmArgs
+{
+    clblasTranspose transA, transB;
+    size_t M, N, K;
+    T alpha;
+    const T *A;
+    size_t lda;
+    const T *B;
+    size_t ldb;
+    T beta;
+    T *C;
+    size_t ldc;
+    bool triangular;
+    clblasUplo triangle;
+
+    /* the rows of column j computed */
+    void rows(size_t j, size_t *first, size_t *last) const
+    {
+        *first = 0;
+        *last = M;
+        if (triangular) {
+            if (triangle == clblasLower) {
+                *first = j;
+            }
+            else {
+                *last = std::min(j + 1, M);
+            }
+        }
+    }
+};
+
+/* the columns [first, last) of C, with A not transposed */
+template <typename T> static void
+gemmColumns(void *arg, size_t first, size_t last)
+{
+    const GemmArgs<T> &g = *(const GemmArgs<T>*)arg;
+    size_t i, j, l, r0, r1;
+
+    for (j = first; j < last; j++) {
+        T *c = g.C + j * g.ldc;
+
+        g.rows(j, &r0, &r1);
+        for (i = r0; i < r1; i++) {
+            c[i] = isZero(g.beta) ? fromReal<T>(0) : mul(c[i], g.beta);
+        }
+    }
+    if (isZero(g.alpha) || (g.K == 0)) {
+        return;
+    }
+
+    for (size_t l0 = 0; l0 < g.K; l0 += BLOCK_K) {
+        size_t l1 = std::min(l0 + BLOCK_K, g.K);
+
+        for (size_t i0 = 0; i0 < g.M; i0 += BLOCK_M) {
+            size_t i1 = std::min(i0 + BLOCK_M, g.M);
+
+            // blocks out of the triangle of all the columns
+            if (g.triangular && (((g.triangle == clblasLower) &&
+                                  (i1 <= first)) ||
+                                 ((g.triangle == clblasUpper) &&
+                                  (i0 >= last)))) {
+                continue;
+            }
+
+            for (j = first; j < last; j++) {
+                T *c = g.C + j * g.ldc;
+
+                g.rows(j, &r0, &r1);
+                r0 = std::max(r0, i0);
+                r1 = std::min(r1, i1);
+                if (r0 >= r1) {
+                    continue;
+                }
+                for (l = l0; l < l1; l++) {
+                    T t = mul(g.alpha, opElem(g.B, g.ldb, g.transB, l, j));
+                    const T *a = g.A + l * g.lda;
+
+                    for (i = r0; i < r1; i++) {
+                        c[i] = add(c[i], mul(t, a[i]));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* op(A) is copied out first if A is transposed */
+template <typename T> static void
+runGemm(GemmArgs<T> &g)
+{
+    double work = (double)g.M * (double)g.N * (double)g.K;
+    std::vector<T> packed;
+
+    if ((g.transA != clblasNoTrans) && (g.M != 0) && (g.K != 0)) {
+        packed.resize(g.M * g.K);
+        for (size_t l = 0; l < g.K; l++) {
+            for (size_t i = 0; i < g.M; i++) {
+                packed[l * g.M + i] = opElem(g.A, g.lda, g.transA, i, l);
+            }
+        }
+        g.A = &packed[0];
+        g.lda = g.M;
+        g.transA = clblasNoTrans;
+    }
+
+    parallelFor(g.N, BLOCK_N, work, gemmColumns<T>, &g);
+}
+
+template <typename T> void
+blockedGemm(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    T alpha,
+    const T *A,
+    size_t lda,
+    const T *B,
+    size_t ldb,
+    T beta,
+    T *C,
+    size_t ldc)
+{
+    GemmArgs<T> g;
+
+    checkOrder(order);
+
+    g.transA = transA;
+    g.transB = transB;
+    g.M = M;
+    g.N = N;
+    g.K = K;
+    g.alpha = alpha;
+    g.A = A;
+    g.lda = lda;
+    g.B = B;
+    g.ldb = ldb;
+    g.beta = beta;
+    g.C = C;
+    g.ldc = ldc;
+    g.triangular = false;
+    g.triangle = clblasUpper;
+    runGemm(g);
+}
+
+/* C = alpha * op(A) * op(A)^T + beta * C is a GEMM with B = A */
+template <typename T> void
+blockedSyrk(
+    clblasOrder order,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    size_t N,
+    size_t K,
+    T alpha,
+    const T *A,
+    size_t lda,
+    T beta,
+    T *C,
+    size_t ldc)
+{
+    GemmArgs<T> g;
+
+    checkOrder(order);
+
+    g.transA = (transA == clblasNoTrans) ? clblasNoTrans : clblasTrans;
+    g.transB = (transA == clblasNoTrans) ? clblasTrans : clblasNoTrans;
+    g.M = N;
+    g.N = N;
+    g.K = K;
+    g.alpha = alpha;
+    g.A = A;
+    g.lda = lda;
+    g.B = A;
+    g.ldb = lda;
+    g.beta = beta;
+    g.C = C;
+    g.ldc = ldc;
+    g.triangular = true;
+    g.triangle = uplo;
+    runGemm(g);
+}
+
+/* GEMV on contiguous copies of the vectors */
+template <typename T> struct GemvArgs
+{
+    clblasTranspose transA;
+    size_t M, N;
+    T alpha;
+    const T *A;
+    size_t lda;
+    const T *x;
+    T beta;
+    T *y;
+};
+
+template <typename T> static void
+gemvRows(void *arg, size_t first, size_t last)
+{
+    const GemvArgs<T> &g = *(const GemvArgs<T>*)arg;
+    size_t i, j;
+
+    for (i = first; i < last; i++) {
+        g.y[i] = isZero(g.beta) ? fromReal<T>(0) : mul(g.y[i], g.beta);
+    }
+
+    if (g.transA == clblasNoTrans) {
+        for (j = 0; j < g.N; j++) {
+            T t = mul(g.alpha, g.x[j]);
+            const T *a = g.A + j * g.lda;
+
+            for (i = first; i < last; i++) {
+                g.y[i] = add(g.y[i], mul(t, a[i]));
+            }
+        }
+    }
+    else {
+        for (j = first; j < last; j++) {
+            const T *a = g.A + j * g.lda;
+            T sum = fromReal<T>(0);
+
+            if (g.transA == clblasConjTrans) {
+                for (i = 0; i < g.M; i++) {
+                    sum = add(sum, mul(conjOf(a[i]), g.x[i]));
+                }
+            }
+            else {
+                for (i = 0; i < g.M; i++) {
+                    sum = add(sum, mul(a[i], g.x[i]));
+                }
+            }
+            g.y[j] = add(g.y[j], mul(g.alpha, sum));
+        }
+    }
+}
+
+/* index of element k of a vector of n elements with increment inc */
+static inline size_t
+vectorIndex(size_t k, size_t n, int inc)
+{
+    return (inc > 0) ? k * (size_t)inc : (n - 1 - k) * (size_t)(-inc);
+}
+
+template <typename T> void
+blockedGemv(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    T alpha,
+    const T *A,
+    size_t lda,
+    const T *X,
+    int incx,
+    T beta,
+    T *Y,
+    int incy)
+{
+    size_t sizeX = (transA == clblasNoTrans) ? N : M;
+    size_t sizeY = (transA == clblasNoTrans) ? M : N;
+    std::vector<T> x(sizeX), y(sizeY);
+    GemvArgs<T> g;
+    size_t k;
+
+    checkOrder(order);
+    if (sizeY == 0) {
+        return;
+    }
+
+    for (k = 0; k < sizeX; k++) {
+        x[k] = X[vectorIndex(k, sizeX, incx)];
+    }
+    for (k = 0; k < sizeY; k++) {
+        y[k] = Y[vectorIndex(k, sizeY, incy)];
+    }
+
+    g.transA = transA;
+    g.M = M;
+    g.N = N;
+    g.alpha = alpha;
+    g.A = A;
+    g.lda = lda;
+    g.x = (sizeX != 0) ? &x[0] : NULL;
+    g.beta = beta;
+    g.y = &y[0];
+    parallelFor(sizeY, BLOCK_M, (double)M * (double)N, gemvRows<T>, &g);
+
+    for (k = 0; k < sizeY; k++) {
+        Y[vectorIndex(k, sizeY, incy)] = y[k];
+    }
+}
+
+/*
+ * TRSM solving E * X = alpha * X in place for every column of X, with E
+ * the n x n triangular matrix copied out of A
+ */
+template <typename T> struct TrsmArgs
+{
+    const T *E;
+    size_t n;
+    bool lower;
+    T alpha;
+    T *X;
+    size_t ldx;
+};
+
+template <typename T> static void
+trsmColumns(void *arg, size_t first, size_t last)
+{
+    const TrsmArgs<T> &s = *(const TrsmArgs<T>*)arg;
+    size_t n = s.n;
+    size_t i, j, k;
+
+    for (j = first; j < last; j++) {
+        T *x = s.X + j * s.ldx;
+
+        for (i = 0; i < n; i++) {
+            x[i] = mul(x[i], s.alpha);
+        }
+    }
+
+    // a block of unknowns is solved, then eliminated from the rows left
+    // a block of rows at a time
+    for (size_t done = 0; done < n; done += BLOCK_K) {
+        size_t k0, k1;
+
+        if (s.lower) {
+            k0 = done;
+            k1 = std::min(done + BLOCK_K, n);
+        }
+        else {
+            k1 = n - done;
+            k0 = (k1 > BLOCK_K) ? k1 - BLOCK_K : 0;
+        }
+
+        for (j = first; j < last; j++) {
+            T *x = s.X + j * s.ldx;
+
+            if (s.lower) {
+                for (k = k0; k < k1; k++) {
+                    const T *e = s.E + k * n;
+
+                    x[k] = divide(x[k], e[k]);
+                    for (i = k + 1; i < k1; i++) {
+                        x[i] = sub(x[i], mul(x[k], e[i]));
+                    }
+                }
+            }
+            else {
+                for (k = k1; k-- > k0; ) {
+                    const T *e = s.E + k * n;
+
+                    x[k] = divide(x[k], e[k]);
+                    for (i = k0; i < k; i++) {
+                        x[i] = sub(x[i], mul(x[k], e[i]));
+                    }
+                }
+            }
+        }
+
+        size_t r0 = s.lower ? k1 : 0;
+        size_t r1 = s.lower ? n : k0;
+
+        for (size_t i0 = r0; i0 < r1; i0 += BLOCK_M) {
+            size_t i1 = std::min(i0 + BLOCK_M, r1);
+
+            for (j = first; j < last; j++) {
+                T *x = s.X + j * s.ldx;
+
+                if (s.lower) {
+                    for (k = k0; k < k1; k++) {
+                        const T *e = s.E + k * n;
+
+                        for (i = i0; i < i1; i++) {
+                            x[i] = sub(x[i], mul(x[k], e[i]));
+                        }
+                    }
+                }
+                else {
+                    for (k = k1; k-- > k0; ) {
+                        const T *e = s.E + k * n;
+
+                        for (i = i0; i < i1; i++) {
+                            x[i] = sub(x[i], mul(x[k], e[i]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * The right side X * op(A) = alpha * B is solved as op(A)^T * X^T =
+ * alpha * B^T, so that both sides are solved by columns
+ */
+template <typename T> void
+blockedTrsm(
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    T alpha,
+    const T *A,
+    size_t lda,
+    T *B,
+    size_t ldb)
+{
+    size_t n = (side == clblasLeft) ? M : N;
+    size_t nrCols = (side == clblasLeft) ? N : M;
+    bool lowerOp = (uplo == clblasLower) != (transA != clblasNoTrans);
+    std::vector<T> E, Bt;
+    TrsmArgs<T> s;
+    size_t i, k;
+
+    checkOrder(order);
+    if ((M == 0) || (N == 0)) {
+        return;
+    }
+
+    // E is op(A) on the left and op(A)^T on the right
+    s.lower = (side == clblasLeft) ? lowerOp : !lowerOp;
+    E.resize(n * n, fromReal<T>(0));
+    for (k = 0; k < n; k++) {
+        size_t first = s.lower ? k : 0;
+        size_t last = s.lower ? n : k + 1;
+
+        for (i = first; i < last; i++) {
+            if ((i == k) && (diag == clblasUnit)) {
+                E[k * n + i] = fromReal<T>(1);
+            }
+            else if (side == clblasLeft) {
+                E[k * n + i] = opElem(A, lda, transA, i, k);
+            }
+            else {
+                E[k * n + i] = opElem(A, lda, transA, k, i);
+            }
+        }
+    }
+
+    s.E = &E[0];
+    s.n = n;
+    s.alpha = alpha;
+    if (side == clblasLeft) {
+        s.X = B;
+        s.ldx = ldb;
+    }
+    else {
+        Bt.resize(N * M);
+        for (k = 0; k < N; k++) {
+            for (i = 0; i < M; i++) {
+                Bt[i * N + k] = B[k * ldb + i];
+            }
+        }
+        s.X = &Bt[0];
+        s.ldx = N;
+    }
+
+    parallelFor(nrCols, BLOCK_N, (double)n * (double)n * (double)nrCols / 2,
+                trsmColumns<T>, &s);
+
+    if (side == clblasRight) {
+        for (k = 0; k < N; k++) {
+            for (i = 0; i < M; i++) {
+                B[k * ldb + i] = Bt[i * N + k];
+            }
+        }
+    }
+}
+
+#define INSTANTIATE_BLOCKED(T)                                              \
+    template void blockedGemv<T>(clblasOrder, clblasTranspose, size_t,      \
+        size_t, T, const T*, size_t, const T*, int, T, T*, int);            \
+    template void blockedGemm<T>(clblasOrder, clblasTranspose,              \
+        clblasTranspose, size_t, size_t, size_t, T, const T*, size_t,       \
+        const T*, size_t, T, T*, size_t);                                   \
+    template void blockedTrsm<T>(clblasOrder, clblasSide, clblasUplo,       \
+        clblasTranspose, clblasDiag, size_t, size_t, T, const T*, size_t,   \
+        T*, size_t);                                                        \
+    template void blockedSyrk<T>(clblasOrder, clblasUplo, clblasTranspose,  \
+        size_t, size_t, T, const T*, size_t, T, T*, size_t);
+
+INSTANTIATE_BLOCKED(float)
+INSTANTIATE_BLOCKED(double)
+INSTANTIATE_BLOCKED(FloatComplex)
+INSTANTIATE_BLOCKED(DoubleComplex)
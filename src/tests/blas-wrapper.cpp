@@ -19,6 +19,9 @@
 
 #include <blas-internal.h>
 #include <blas-wrapper.h>
+#if defined CORR_TEST_WITH_BLOCKED_REF
+#include <blas-blocked.h>
+#endif
 
 void
 ::clMath::blas::gemv(
@@ -35,7 +38,11 @@ void
     float *Y,
     int incy)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#else
     blasSgemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#endif
 }
 
 void
@@ -53,7 +60,11 @@ void
     double *Y,
     int incy)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#else
     blasDgemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#endif
 }
 
 void
@@ -71,7 +82,11 @@ void
     FloatComplex *Y,
     int incy)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#else
     blasCgemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#endif
 }
 
 void
@@ -89,7 +104,11 @@ void
     DoubleComplex *Y,
     int incy)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#else
     blasZgemv(order, transA, M, N, alpha, A, lda, X, incx, beta, Y, incy);
+#endif
 }
 
 void
@@ -143,7 +162,11 @@ void
     float *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#else
     blasSgemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#endif
 }
 
 void
@@ -163,7 +186,11 @@ void
     double *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#else
     blasDgemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#endif
 }
 
 void
@@ -183,7 +210,11 @@ void
     FloatComplex *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#else
     blasCgemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#endif
 }
 
 void
@@ -203,7 +234,11 @@ void
     DoubleComplex *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedGemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#else
     blasZgemm(order, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+#endif
 }
 
 void
@@ -293,7 +328,11 @@ void
     float *B,
     size_t ldb)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedTrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#else
     blasStrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#endif
 }
 
 void
@@ -311,7 +350,11 @@ void
     double *B,
     size_t ldb)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedTrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#else
     blasDtrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#endif
 }
 
 void
@@ -329,7 +372,11 @@ void
     FloatComplex *B,
     size_t ldb)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedTrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#else
     blasCtrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#endif
 }
 
 void
@@ -347,7 +394,11 @@ void
     DoubleComplex *B,
     size_t ldb)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedTrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#else
     blasZtrsm(order, side, uplo, transA, diag, M, N, alpha, A, lda, B, ldb);
+#endif
 }
 
 void
@@ -440,7 +491,11 @@ void
     float *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedSyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#else
     blasSsyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#endif
 }
 
 void
@@ -457,7 +512,11 @@ void
     double *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedSyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#else
     blasDsyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#endif
 }
 
 void
@@ -474,7 +533,11 @@ void
     FloatComplex *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedSyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#else
     blasCsyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#endif
 }
 
 void
@@ -491,7 +554,11 @@ void
     DoubleComplex *C,
     size_t ldc)
 {
+#if defined CORR_TEST_WITH_BLOCKED_REF
+    blockedSyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#else
     blasZsyrk(order, uplo, transA, N, K, alpha, A, lda, beta, C, ldc);
+#endif
 }
 
 void
@@ -0,0 +1,118 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check that calls going through the solution sequence don't allocate
+ * host memory once the kernels are built. Requires the library to be
+ * built with BLAS_TRACE_MALLOC, otherwise the tests are skipped.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "blas-wrapper.h"
+#include "clBLAS-wrapper.h"
+#include "BlasBase.h"
+#include "blas-random.h"
+#include "timer.h"
+#include "func.h"
+
+#if defined(TEST_WITH_MALLOC_TRACE)
+extern "C" unsigned long getMallocTraceCount(void);
+#endif
+
+// Number of calls checked after the warm up one
+#define ALLOC_TEST_CALLS 10
+
+template <typename M>
+class AllocClass
+{
+    M metod;
+protected:
+    void steadyStateTest();
+public:
+    void run();
+};
+
+template <typename M> void
+AllocClass<M>::run()
+{
+    metod.initDefault(256, 1);
+    steadyStateTest();
+    metod.destroy();
+}
+
+template <typename M> void
+AllocClass<M>::steadyStateTest()
+{
+#if defined(TEST_WITH_MALLOC_TRACE)
+    cl_int err;
+    unsigned long before, after;
+
+    metod.generateData();
+    if (!metod.prepareDataToRun()) {
+        ::std::cerr << ">> Failed to create/enqueue buffer for a matrix."
+            << ::std::endl
+            << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    // The first call builds and caches kernels and fills the step pool
+    err = metod.run();
+    ASSERT_EQ(err, CL_SUCCESS) << "first run";
+    err = clFinish(metod.queues[0]);
+    ASSERT_EQ(err, CL_SUCCESS) << "clFinish()";
+
+    before = getMallocTraceCount();
+    for (int i = 0; i < ALLOC_TEST_CALLS; i++) {
+        err = metod.run();
+        ASSERT_EQ(err, CL_SUCCESS) << "run " << i;
+    }
+    after = getMallocTraceCount();
+    err = clFinish(metod.queues[0]);
+    ASSERT_EQ(err, CL_SUCCESS) << "clFinish()";
+
+    EXPECT_EQ(before, after) << "heap allocations in steady state";
+#else
+    ::std::cerr << ">> The library is built without malloc tracing."
+        << ::std::endl
+        << ">> Test skipped." << ::std::endl;
+    SUCCEED();
+#endif
+}
+
+TEST(HEAP_ALLOC, ssymv) {
+    AllocClass<SymvMetod<float> > ac;
+    ac.run();
+}
+
+TEST(HEAP_ALLOC, strmm) {
+    AllocClass<TrmmMetod<float> > ac;
+    ac.run();
+}
+
+TEST(HEAP_ALLOC, dtrmm) {
+    CHECK_DOUBLE;
+    AllocClass<TrmmMetod<cl_double> > ac;
+    ac.run();
+}
+
+TEST(HEAP_ALLOC, ssyr2k) {
+    AllocClass<Syr2kMetod<float> > ac;
+    ac.run();
+}
@@ -0,0 +1,193 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Device profiles: the characterization gives plausible values, it is run
+ * by clblasProfileDevice() only, a profile stored on disk is loaded instead
+ * of being measured again, and nothing is stored unless a folder is given.
+ *
+ * The test calls internal functions of the library, which are exported
+ * from the shared library on Linux and Mac only.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+#include <devinfo.h>
+
+#include "BlasBase.h"
+
+extern "C" void deviceProfileSetup(void);
+extern "C" void deviceProfileTeardown(void);
+
+#define SIZE 256
+
+static cl_device_id
+testDevice(void)
+{
+    clMath::BlasBase *base = clMath::BlasBase::getInstance();
+    cl_device_id device = NULL;
+
+    clGetCommandQueueInfo(base->commandQueues()[0], CL_QUEUE_DEVICE,
+                          sizeof(device), &device, NULL);
+
+    return device;
+}
+
+// The file the profile of the device is stored in under root
+static std::string
+profileFile(cl_device_id device, const std::string &root)
+{
+    char vendor[SIZE], name[SIZE], driver[SIZE];
+
+    clGetDeviceInfo(device, CL_DEVICE_VENDOR, sizeof(vendor), vendor, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(name), name, NULL);
+    clGetDeviceInfo(device, CL_DRIVER_VERSION, sizeof(driver), driver, NULL);
+
+    return root + "/" + vendor + "/" + name + "/" + driver + "/device_profile";
+}
+
+// Forget the profiles measured so far, as in a new process
+static void
+restartProfiles(void)
+{
+    deviceProfileTeardown();
+    deviceProfileSetup();
+}
+
+TEST(DEVICE_PROFILE, characterize) {
+    DeviceProfile profile;
+    unsigned int vecLen;
+
+    ASSERT_EQ(CL_SUCCESS, characterizeDevice(testDevice(), &profile));
+
+    vecLen = profile.loadVecLen;
+    EXPECT_TRUE((vecLen == 1) || (vecLen == 2) || (vecLen == 4) ||
+                (vecLen == 8));
+    EXPECT_GT(profile.globalBandwidth, 0.0);
+    EXPECT_GT(profile.launchLatency, 0.0);
+    EXPECT_GE(profile.ldsBandwidth, 0.0);
+    if ((profile.l1CacheSize != 0) && (profile.l2CacheSize != 0)) {
+        EXPECT_LE(profile.l1CacheSize, profile.l2CacheSize);
+    }
+}
+
+TEST(DEVICE_PROFILE, saveAndLoad) {
+    cl_device_id device = testDevice();
+    char root[] = "/tmp/clblas-profile-XXXXXX";
+    const DeviceProfile *profile;
+    DeviceProfile measured;
+    std::string file;
+    FILE *f;
+
+    ASSERT_TRUE(mkdtemp(root) != NULL);
+    setenv("CLBLAS_PROFILE_PATH", root, 1);
+    file = profileFile(device, root);
+
+    // measured on request only, and stored
+    restartProfiles();
+    EXPECT_TRUE(getDeviceProfile(device) == NULL);
+    ASSERT_EQ(clblasSuccess, clblasProfileDevice(device));
+    profile = getDeviceProfile(device);
+    ASSERT_TRUE(profile != NULL);
+    measured = *profile;
+    f = fopen(file.c_str(), "r");
+    ASSERT_TRUE(f != NULL) << file << " is not written";
+    fclose(f);
+
+    // loaded: a value changed in the file is taken as is
+    f = fopen(file.c_str(), "a");
+    ASSERT_TRUE(f != NULL);
+    fprintf(f, "launchLatency 12345\n");
+    fclose(f);
+    restartProfiles();
+    profile = getDeviceProfile(device);
+    ASSERT_TRUE(profile != NULL);
+    EXPECT_EQ(12345.0, profile->launchLatency);
+    EXPECT_EQ(measured.loadVecLen, profile->loadVecLen);
+    EXPECT_EQ(measured.l1CacheSize, profile->l1CacheSize);
+    EXPECT_EQ(measured.l2CacheSize, profile->l2CacheSize);
+
+    // a damaged file is ignored, then measured again and rewritten
+    f = fopen(file.c_str(), "w");
+    ASSERT_TRUE(f != NULL);
+    fprintf(f, "version x\n");
+    fclose(f);
+    restartProfiles();
+    EXPECT_TRUE(getDeviceProfile(device) == NULL);
+    ASSERT_EQ(clblasSuccess, clblasProfileDevice(device));
+    profile = getDeviceProfile(device);
+    ASSERT_TRUE(profile != NULL);
+    EXPECT_NE(12345.0, profile->launchLatency);
+    restartProfiles();
+    profile = getDeviceProfile(device);
+    ASSERT_TRUE(profile != NULL);
+    EXPECT_NE(12345.0, profile->launchLatency);
+
+    unsetenv("CLBLAS_PROFILE_PATH");
+    restartProfiles();
+    remove(file.c_str());
+}
+
+TEST(DEVICE_PROFILE, notStoredByDefault) {
+    cl_device_id device = testDevice();
+    char home[] = "/tmp/clblas-home-XXXXXX";
+    const char *oldHome = getenv("HOME");
+    std::string savedHome = (oldHome != NULL) ? oldHome : "";
+    DIR *dir;
+    struct dirent *ent;
+    bool empty = true;
+
+    if (getenv("CLBLAS_CACHE_PATH") != NULL) {
+        ::std::cerr << ">> WARNING: CLBLAS_CACHE_PATH is set, profiles are "
+                       "stored in the binary cache." << ::std::endl
+                    << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    ASSERT_TRUE(mkdtemp(home) != NULL);
+    unsetenv("CLBLAS_PROFILE_PATH");
+    unsetenv("XDG_CACHE_HOME");
+    setenv("HOME", home, 1);
+
+    restartProfiles();
+    EXPECT_TRUE(getDeviceProfile(device) == NULL);
+    EXPECT_EQ(clblasSuccess, clblasProfileDevice(device));
+    EXPECT_TRUE(getDeviceProfile(device) != NULL);
+
+    dir = opendir(home);
+    ASSERT_TRUE(dir != NULL);
+    while ((ent = readdir(dir)) != NULL) {
+        if (strcmp(ent->d_name, ".") && strcmp(ent->d_name, "..")) {
+            empty = false;
+        }
+    }
+    closedir(dir);
+    EXPECT_TRUE(empty) << "the profile is written under " << home;
+
+    if (oldHome != NULL) {
+        setenv("HOME", savedHome.c_str(), 1);
+    }
+    restartProfiles();
+    rmdir(home);
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Functor cache contention: several threads calling SSCAL, whose functors
+ * come from a functor cache, on small vectors so that the time goes to
+ * looking up functors and enqueueing kernels. Every thread scales its vector by -1 an even number of
+ * times, which must leave it unchanged. The call rate with one and with
+ * all threads is printed; the second must not collapse if lookups don't
+ * serialize. A cache bound of one entry makes every other call a miss.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+#include "timer.h"
+
+#define CONTENTION_THREADS 8
+#define CONTENTION_CALLS 2000
+#define CONTENTION_N 64
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#include "process.h"
+
+#define THREAD_ID HANDLE
+#define THREAD_START(ID, DATA) \
+     ID = (HANDLE)_beginthreadex(NULL, 0, &scalThread, &DATA, 0, NULL);
+#define THREAD_WAIT(ID) WaitForSingleObject(ID, INFINITE);
+#define THREAD_FUNC unsigned __stdcall
+#define THREAD_RETURN return 0
+
+#else /* defined(_MSC_VER) */
+#include "pthread.h"
+
+#define THREAD_ID pthread_t
+#define THREAD_START(ID, DATA) \
+     pthread_create(&ID, NULL, scalThread, &DATA)
+#define THREAD_WAIT(ID) pthread_join(ID, NULL);
+#define THREAD_FUNC void*
+#define THREAD_RETURN return NULL
+
+#endif
+
+struct ScalThread
+{
+    cl_command_queue queue;
+    cl_mem X;
+    // the functors for unit and non unit increments differ, so that
+    // threads using both evict each other with a bound of one entry
+    int incx;
+    cl_int err;
+};
+
+static THREAD_FUNC
+scalThread(void *data)
+{
+    ScalThread *t = (ScalThread*)data;
+
+    t->err = CL_SUCCESS;
+    for (int i = 0; (i < CONTENTION_CALLS) && (t->err == CL_SUCCESS); i++) {
+        t->err = clblasSscal(CONTENTION_N / 2, -1.0f, t->X, 0, t->incx, 1,
+                             &t->queue, 0, NULL, NULL);
+    }
+    if (t->err == CL_SUCCESS) {
+        t->err = clFinish(t->queue);
+    }
+    THREAD_RETURN;
+}
+
+static void
+runContention(int nrThreads, const char *label)
+{
+    clMath::BlasBase *base = clMath::BlasBase::getInstance();
+    ScalThread threads[CONTENTION_THREADS];
+    THREAD_ID ids[CONTENTION_THREADS];
+    std::vector<float> host(CONTENTION_N), result(CONTENTION_N);
+    nano_time_t time;
+
+    for (size_t i = 0; i < CONTENTION_N; i++) {
+        host[i] = (float)(i % 13) - 6.0f;
+    }
+    for (int i = 0; i < nrThreads; i++) {
+        threads[i].queue = base->commandQueues()[0];
+        threads[i].incx = (i % 2) ? 2 : 1;
+        threads[i].X = clCreateBuffer(base->context(),
+            CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+            CONTENTION_N * sizeof(float), &host[0], NULL);
+    }
+
+    time = getCurrentTime();
+    for (int i = 0; i < nrThreads; i++) {
+        THREAD_START(ids[i], threads[i]);
+    }
+    for (int i = 0; i < nrThreads; i++) {
+        THREAD_WAIT(ids[i]);
+    }
+    time = getCurrentTime() - time;
+
+    printf("%s, %d threads: %.0f calls/s\n", label, nrThreads,
+           (double)nrThreads * CONTENTION_CALLS / (conv2nanosec(time) / 1e9));
+
+    for (int i = 0; i < nrThreads; i++) {
+        EXPECT_EQ(CL_SUCCESS, threads[i].err);
+        EXPECT_EQ(CL_SUCCESS, clEnqueueReadBuffer(threads[i].queue,
+            threads[i].X, CL_TRUE, 0, CONTENTION_N * sizeof(float),
+            &result[0], 0, NULL, NULL));
+        for (size_t j = 0; j < CONTENTION_N; j++) {
+            EXPECT_EQ(host[j], result[j]) << "thread " << i << ", element " << j;
+        }
+        clReleaseMemObject(threads[i].X);
+    }
+}
+
+TEST(FUNCTOR_CACHE, contention) {
+    runContention(1, "cached");
+    runContention(CONTENTION_THREADS, "cached");
+}
+
+TEST(FUNCTOR_CACHE, contentionWithEviction) {
+    putenv((char*)"AMD_CLBLAS_FUNCTOR_CACHE_SIZE=1");
+    runContention(1, "evicting");
+    runContention(CONTENTION_THREADS, "evicting");
+    putenv((char*)"AMD_CLBLAS_FUNCTOR_CACHE_SIZE=64");
+}
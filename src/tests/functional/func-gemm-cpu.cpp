@@ -0,0 +1,126 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check GEMM on the register-blocked kernels of CPU devices against a
+ * double precision host computation. Sizes that are multiples of the macro
+ * tile run the tile kernel alone; remainders of M and N add the row, column
+ * and corner kernels, and a K that is not a multiple of the unroll the
+ * unroll 1 kernels. Run with --device cpu, other devices skip the tests.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+static bool
+skipNotCPU(void)
+{
+    cl_command_queue queue =
+        clMath::BlasBase::getInstance()->commandQueues()[0];
+    cl_device_id device;
+    cl_device_type type = 0;
+
+    clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device,
+                          NULL);
+    clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, NULL);
+    if ((type & CL_DEVICE_TYPE_CPU) == 0) {
+        ::std::cerr << ">> WARNING: The target device is not a CPU."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        return true;
+    }
+    return false;
+}
+
+/* The AutoGemm kernels alone, the CPU family */
+template <typename T>
+static void
+runCPUKernels(clblasOrder order, clblasTranspose transA,
+              clblasTranspose transB, size_t M, size_t N, size_t K,
+              double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, M, N, K);
+
+    {
+        ScopedEnv path("CLBLAS_FORCE_PATH", "autogemm");
+        ScopedEnv kernels("AMD_CLBLAS_GEMM_CPU_KERNELS", "1");
+
+        ASSERT_EQ(clblasSuccess, runGemm(p));
+    }
+    p.check(tolerance);
+}
+
+TEST(GEMM_CPU, sgemmTileColumnMajorNN) {
+    if (skipNotCPU()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<cl_float>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                            64, 64, 64, 1e-5 * 64);
+}
+
+TEST(GEMM_CPU, sgemmEdgesColumnMajorTN) {
+    if (skipNotCPU()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<cl_float>(clblasColumnMajor, clblasTrans, clblasNoTrans,
+                            70, 45, 33, 1e-5 * 33);
+}
+
+TEST(GEMM_CPU, sgemmRowsRowMajorNT) {
+    if (skipNotCPU()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<cl_float>(clblasRowMajor, clblasNoTrans, clblasTrans,
+                            70, 64, 64, 1e-5 * 64);
+}
+
+TEST(GEMM_CPU, dgemmColumnsColumnMajorNN) {
+    if (skipNotCPU() || skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<cl_double>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                             64, 45, 40, 1e-12 * 40);
+}
+
+TEST(GEMM_CPU, cgemmEdgesColumnMajorCN) {
+    if (skipNotCPU()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<FloatComplex>(clblasColumnMajor, clblasConjTrans,
+                                clblasNoTrans, 37, 29, 20, 1e-5 * 20);
+}
+
+TEST(GEMM_CPU, zgemmTileRowMajorNC) {
+    if (skipNotCPU() || skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    runCPUKernels<DoubleComplex>(clblasRowMajor, clblasNoTrans,
+                                 clblasConjTrans, 64, 32, 16, 1e-12 * 16);
+}
@@ -0,0 +1,211 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check GEMM with a fused epilogue against a straightforward host
+ * computation.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define EPILOGUE_M 67
+#define EPILOGUE_N 45
+#define EPILOGUE_K 33
+
+/* A GEMM with bias and scale vectors of max(M, N) elements */
+template <typename T>
+class EpilogueProblem : public GemmProblem<T>
+{
+    size_t vecLen;
+    T *hostBias, *hostScale;
+
+public:
+    cl_mem bias, scale;
+    clblasEpilogue epilogue;
+
+    EpilogueProblem(clblasOrder order_) :
+        GemmProblem<T>(order_, clblasNoTrans, clblasNoTrans,
+                       EPILOGUE_M, EPILOGUE_N, EPILOGUE_K)
+    {
+        vecLen = (this->M > this->N) ? this->M : this->N;
+        hostBias = fillMatrix<T>(vecLen, 3);
+        hostScale = fillMatrix<T>(vecLen, 2);
+        for (size_t i = 0; i < vecLen; i++) {
+            hostScale[i] += T(1);
+        }
+        bias = createBuffer(hostBias, vecLen);
+        scale = createBuffer(hostScale, vecLen);
+
+        memset(&epilogue, 0, sizeof(epilogue));
+        epilogue.bias = bias;
+        epilogue.scale = scale;
+    }
+
+    ~EpilogueProblem()
+    {
+        clReleaseMemObject(bias);
+        clReleaseMemObject(scale);
+        delete[] hostBias;
+        delete[] hostScale;
+    }
+
+    /* Element (i, j) of C with the epilogue applied */
+    double reference(size_t i, size_t j) const
+    {
+        double x = this->alpha;
+
+        if (epilogue.scaleMode == clblasEpiloguePerRow) {
+            x *= hostScale[epilogue.offScale + i];
+        }
+        else if (epilogue.scaleMode == clblasEpiloguePerColumn) {
+            x *= hostScale[epilogue.offScale + j];
+        }
+        x = x * this->product(i, j).real() +
+            this->beta * this->hostC[this->indexC(i, j)];
+
+        if (epilogue.biasMode == clblasEpiloguePerRow) {
+            x += hostBias[epilogue.offBias + i];
+        }
+        else if (epilogue.biasMode == clblasEpiloguePerColumn) {
+            x += hostBias[epilogue.offBias + j];
+        }
+
+        if (epilogue.activation == clblasActivationReLU) {
+            x = (x > 0) ? x : 0;
+        }
+        else if (epilogue.activation == clblasActivationGELU) {
+            x = 0.5 * x * (1 + erf(x / sqrt(2.0)));
+        }
+
+        if (epilogue.clamp) {
+            x = (x < epilogue.clampMin) ? epilogue.clampMin : x;
+            x = (x > epilogue.clampMax) ? epilogue.clampMax : x;
+        }
+        return x;
+    }
+
+    void check(double tolerance)
+    {
+        T *result = new T[this->sizeC];
+
+        this->readC(result);
+        for (size_t i = 0; i < this->M; i++) {
+            for (size_t j = 0; j < this->N; j++) {
+                ASSERT_NEAR(reference(i, j), result[this->indexC(i, j)],
+                            tolerance)
+                    << "element (" << i << ", " << j << ")";
+            }
+        }
+        delete[] result;
+    }
+};
+
+static clblasStatus
+gemmEx(EpilogueProblem<float> &p, const clblasEpilogue *epilogue,
+       cl_event *event)
+{
+    return clblasSgemmEx(p.order, clblasNoTrans, clblasNoTrans, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, 0, p.ldc,
+        epilogue, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+gemmEx(EpilogueProblem<double> &p, const clblasEpilogue *epilogue,
+       cl_event *event)
+{
+    return clblasDgemmEx(p.order, clblasNoTrans, clblasNoTrans, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, 0, p.ldc,
+        epilogue, 1, p.queues(), 0, NULL, event);
+}
+
+template <typename T>
+static void
+runEpilogue(EpilogueProblem<T> &p, double tolerance)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, gemmEx(p, &p.epilogue, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    clReleaseEvent(event);
+    p.check(tolerance);
+}
+
+TEST(GEMM_EPILOGUE, sgemmBiasPerRowReLU) {
+    EpilogueProblem<float> p(clblasColumnMajor);
+
+    p.epilogue.biasMode = clblasEpiloguePerRow;
+    p.epilogue.activation = clblasActivationReLU;
+    runEpilogue(p, 1e-3 * EPILOGUE_K);
+}
+
+TEST(GEMM_EPILOGUE, sgemmBiasPerColumnRowMajor) {
+    EpilogueProblem<float> p(clblasRowMajor);
+
+    p.epilogue.biasMode = clblasEpiloguePerColumn;
+    p.epilogue.offBias = 1;
+    runEpilogue(p, 1e-3 * EPILOGUE_K);
+}
+
+TEST(GEMM_EPILOGUE, sgemmScaleClamp) {
+    EpilogueProblem<float> p(clblasColumnMajor);
+
+    p.epilogue.scaleMode = clblasEpiloguePerColumn;
+    p.epilogue.clamp = CL_TRUE;
+    p.epilogue.clampMin = -0.25;
+    p.epilogue.clampMax = 0.25;
+    runEpilogue(p, 1e-3 * EPILOGUE_K);
+}
+
+TEST(GEMM_EPILOGUE, dgemmScaleBiasGELU) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    EpilogueProblem<double> p(clblasRowMajor);
+
+    p.epilogue.scaleMode = clblasEpiloguePerRow;
+    p.epilogue.biasMode = clblasEpiloguePerRow;
+    p.epilogue.activation = clblasActivationGELU;
+    runEpilogue(p, 1e-10 * EPILOGUE_K);
+}
+
+TEST(GEMM_EPILOGUE, invalidArgs) {
+    EpilogueProblem<float> p(clblasColumnMajor);
+    clblasEpilogue epilogue = p.epilogue;
+
+    epilogue.clamp = CL_TRUE;
+    epilogue.clampMin = 1;
+    epilogue.clampMax = 0;
+    EXPECT_EQ(clblasInvalidValue, gemmEx(p, &epilogue, NULL));
+
+    epilogue = p.epilogue;
+    epilogue.biasMode = clblasEpiloguePerRow;
+    epilogue.bias = NULL;
+    EXPECT_EQ(clblasInvalidVecX, gemmEx(p, &epilogue, NULL));
+
+    /* The vector holds max(M, N) elements */
+    epilogue = p.epilogue;
+    epilogue.scaleMode = clblasEpiloguePerRow;
+    epilogue.offScale = 1;
+    EXPECT_EQ(clblasInsufficientMemVecY, gemmEx(p, &epilogue, NULL));
+}
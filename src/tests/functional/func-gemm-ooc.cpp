@@ -0,0 +1,102 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check out-of-core GEMM against a straightforward host computation. The
+ * device memory budget is cut to 1 MB so that C is split into several
+ * blocks and K into several panels.
+ */
+
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define OOC_M 300
+#define OOC_N 200
+#define OOC_K 500
+
+static clblasStatus
+gemm(HostGemmProblem<float> &p, float *C, cl_uint numQueues,
+     cl_command_queue *queues)
+{
+    return clblasSgemmOutOfCore(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.hostA, p.lda, p.hostB, p.ldb, p.beta, C, p.ldc,
+        numQueues, queues, 0, NULL);
+}
+
+static clblasStatus
+gemm(HostGemmProblem<double> &p, double *C, cl_uint numQueues,
+     cl_command_queue *queues)
+{
+    return clblasDgemmOutOfCore(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.hostA, p.lda, p.hostB, p.ldb, p.beta, C, p.ldc,
+        numQueues, queues, 0, NULL);
+}
+
+/*
+ * The device memory budget is cut for the run; the leading dimensions
+ * are padded
+ */
+template <typename T>
+static void
+runOutOfCore(clblasOrder order, clblasTranspose transA,
+             clblasTranspose transB, bool betaZero, double tolerance)
+{
+    clMath::BlasBase *base = clMath::BlasBase::getInstance();
+    cl_uint numQueues = (base->numCommandQueues() > 1) ? 2 : 1;
+    HostGemmProblem<T> p(order, transA, transB, OOC_M, OOC_N, OOC_K, 3);
+    T *C = new T[p.sizeC];
+    clblasStatus status;
+
+    if (betaZero) {
+        p.beta = 0;
+    }
+    memcpy(C, p.hostC, p.sizeC * sizeof(T));
+    {
+        ScopedEnv budget("AMD_CLBLAS_GEMM_OOC_MB", "1");
+
+        status = gemm(p, C, numQueues, base->commandQueues());
+    }
+
+    EXPECT_EQ(clblasSuccess, status);
+    if (status == clblasSuccess) {
+        p.check(C, tolerance);
+    }
+    delete[] C;
+}
+
+TEST(GEMM_OUT_OF_CORE, sgemmColumnMajorNN) {
+    runOutOfCore<float>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                        false, 1e-5 * OOC_K);
+}
+
+TEST(GEMM_OUT_OF_CORE, sgemmRowMajorTNBetaZero) {
+    runOutOfCore<float>(clblasRowMajor, clblasTrans, clblasNoTrans,
+                        true, 1e-5 * OOC_K);
+}
+
+TEST(GEMM_OUT_OF_CORE, dgemmColumnMajorNT) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    runOutOfCore<double>(clblasColumnMajor, clblasNoTrans, clblasTrans,
+                         false, 1e-12 * OOC_K);
+}
@@ -0,0 +1,119 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check GEMM run by the Split-K path against a straightforward host
+ * computation, with the slices summed by the reduction pass and with the
+ * slices accumulated into C with atomics. The reduction pass must give
+ * bitwise identical results from one run to the next.
+ */
+
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define SPLITK_M 70
+#define SPLITK_N 50
+#define SPLITK_K 2000
+
+/* The Split-K path and the accumulation mode are forced for one run */
+template <typename T>
+static void
+runSplitK(GemmProblem<T> &p, bool atomics, T *result)
+{
+    ScopedEnv path("CLBLAS_FORCE_PATH", "splitk");
+    ScopedEnv mode("AMD_CLBLAS_GEMM_SPLITK_ATOMICS", atomics ? "1" : "0");
+
+    ASSERT_TRUE(p.writeC());
+    ASSERT_EQ(clblasSuccess, runGemm(p));
+    p.readC(result);
+}
+
+template <typename T>
+static void
+checkReduce(clblasOrder order, clblasTranspose transA,
+            clblasTranspose transB, double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, SPLITK_M, SPLITK_N, SPLITK_K);
+    T *first = new T[p.sizeC];
+    T *second = new T[p.sizeC];
+
+    runSplitK(p, false, first);
+    p.check(first, tolerance);
+
+    runSplitK(p, false, second);
+    EXPECT_EQ(0, memcmp(first, second, p.sizeC * sizeof(T)))
+        << "the reduction pass is not deterministic";
+
+    delete[] first;
+    delete[] second;
+}
+
+template <typename T>
+static void
+checkAtomics(clblasOrder order, clblasTranspose transA,
+             clblasTranspose transB, double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, SPLITK_M, SPLITK_N, SPLITK_K);
+    T *result = new T[p.sizeC];
+
+    runSplitK(p, true, result);
+    p.check(result, tolerance);
+
+    delete[] result;
+}
+
+TEST(GEMM_SPLITK, sgemmReduceColumnMajorNN) {
+    checkReduce<cl_float>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                          1e-5 * SPLITK_K);
+}
+
+TEST(GEMM_SPLITK, sgemmReduceRowMajorTN) {
+    checkReduce<cl_float>(clblasRowMajor, clblasTrans, clblasNoTrans,
+                          1e-5 * SPLITK_K);
+}
+
+TEST(GEMM_SPLITK, sgemmAtomicsColumnMajorNT) {
+    checkAtomics<cl_float>(clblasColumnMajor, clblasNoTrans, clblasTrans,
+                           1e-5 * SPLITK_K);
+}
+
+TEST(GEMM_SPLITK, dgemmReduceColumnMajorTT) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    checkReduce<cl_double>(clblasColumnMajor, clblasTrans, clblasTrans,
+                           1e-12 * SPLITK_K);
+}
+
+/*
+ * Without cl_khr_int64_base_atomics the double precision falls back to the
+ * reduction pass, which must give the same result
+ */
+TEST(GEMM_SPLITK, dgemmAtomicsRowMajorNN) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    checkAtomics<cl_double>(clblasRowMajor, clblasNoTrans, clblasNoTrans,
+                            1e-12 * SPLITK_K);
+}
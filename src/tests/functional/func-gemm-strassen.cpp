@@ -0,0 +1,71 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check Strassen-Winograd GEMM against a straightforward host computation.
+ * With a threshold of 64, the sizes take two levels and odd rims on both.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define STRASSEN_M 131
+#define STRASSEN_N 130
+#define STRASSEN_K 133
+
+/* Strassen is enabled for the run */
+template <typename T>
+static void
+runStrassen(clblasOrder order, clblasTranspose transA,
+            clblasTranspose transB, bool betaZero, double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, STRASSEN_M, STRASSEN_N,
+                     STRASSEN_K);
+
+    if (betaZero) {
+        setValue(p.beta, 0, 0);
+    }
+    {
+        ScopedEnv mode("AMD_CLBLAS_GEMM_STRASSEN", "64");
+
+        ASSERT_EQ(clblasSuccess, runGemm(p));
+    }
+    p.check(tolerance);
+}
+
+TEST(GEMM_STRASSEN, sgemmColumnMajorNN) {
+    runStrassen<cl_float>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                          false, 1e-4 * STRASSEN_K);
+}
+
+// C is used for the Winograd temporaries when beta is zero
+TEST(GEMM_STRASSEN, sgemmRowMajorTN) {
+    runStrassen<cl_float>(clblasRowMajor, clblasTrans, clblasNoTrans,
+                          true, 1e-4 * STRASSEN_K);
+}
+
+TEST(GEMM_STRASSEN, dgemmColumnMajorNT) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    runStrassen<cl_double>(clblasColumnMajor, clblasNoTrans, clblasTrans,
+                           false, 1e-11 * STRASSEN_K);
+}
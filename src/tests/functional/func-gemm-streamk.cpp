@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check GEMM run by the Stream-K path against a straightforward host
+ * computation. The tile count and K are chosen so that tiles are split
+ * between work groups on any device.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define STREAMK_M 100
+#define STREAMK_N 70
+#define STREAMK_K 1000
+
+/* The Stream-K path is forced for the run */
+template <typename T>
+static void
+runStreamK(clblasOrder order, clblasTranspose transA,
+           clblasTranspose transB, double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, STREAMK_M, STREAMK_N, STREAMK_K);
+
+    {
+        ScopedEnv mode("AMD_CLBLAS_GEMM_STREAMK", "1");
+
+        ASSERT_EQ(clblasSuccess, runGemm(p));
+    }
+    p.check(tolerance);
+}
+
+TEST(GEMM_STREAMK, sgemmColumnMajorNN) {
+    runStreamK<cl_float>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                         1e-5 * STREAMK_K);
+}
+
+TEST(GEMM_STREAMK, sgemmRowMajorTN) {
+    runStreamK<cl_float>(clblasRowMajor, clblasTrans, clblasNoTrans,
+                         1e-5 * STREAMK_K);
+}
+
+TEST(GEMM_STREAMK, dgemmColumnMajorNT) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    runStreamK<cl_double>(clblasColumnMajor, clblasNoTrans, clblasTrans,
+                          1e-12 * STREAMK_K);
+}
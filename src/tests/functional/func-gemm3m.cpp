@@ -0,0 +1,70 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check CGEMM and ZGEMM computed with the 3M method against a double
+ * precision host computation. K is longer than one K panel of the 3M path
+ * so that the accumulation of the real products is covered too.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define GEMM3M_M 70
+#define GEMM3M_N 50
+#define GEMM3M_K 600
+
+/* The 3M path is taken for every problem of the run */
+template <typename T>
+static void
+run3M(clblasOrder order, clblasTranspose transA, clblasTranspose transB,
+      bool betaZero, double tolerance)
+{
+    GemmProblem<T> p(order, transA, transB, GEMM3M_M, GEMM3M_N, GEMM3M_K);
+
+    if (betaZero) {
+        setValue(p.beta, 0, 0);
+    }
+    {
+        ScopedEnv mode("AMD_CLBLAS_GEMM_3M", "1");
+
+        ASSERT_EQ(clblasSuccess, runGemm(p));
+    }
+    p.check(tolerance);
+}
+
+TEST(GEMM_3M, cgemmColumnMajorNN) {
+    run3M<FloatComplex>(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                        false, 1e-5 * GEMM3M_K);
+}
+
+TEST(GEMM_3M, cgemmRowMajorCT) {
+    run3M<FloatComplex>(clblasRowMajor, clblasConjTrans, clblasTrans,
+                        true, 1e-5 * GEMM3M_K);
+}
+
+TEST(GEMM_3M, zgemmColumnMajorNC) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    run3M<DoubleComplex>(clblasColumnMajor, clblasNoTrans, clblasConjTrans,
+                         false, 1e-12 * GEMM3M_K);
+}
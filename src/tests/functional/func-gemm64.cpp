@@ -0,0 +1,102 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check GEMM through the 64-bit size API against a straightforward host
+ * computation: a small problem that runs the regular kernels, and, on
+ * devices that can allocate it, a problem whose C starts beyond the first
+ * 4G elements of its buffer and so runs the 64-bit index kernels.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define GEMM64_M 70
+#define GEMM64_N 50
+#define GEMM64_K 40
+
+static clblasStatus
+gemm64(GemmProblem<float> &p, cl_event *event)
+{
+    return clblasSgemm_64(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+gemm64(GemmProblem<double> &p, cl_event *event)
+{
+    return clblasDgemm_64(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+template <typename T>
+static void
+runGemm64(GemmProblem<T> &p, double tolerance)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, gemm64(p, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    clReleaseEvent(event);
+    p.check(tolerance);
+}
+
+TEST(GEMM_64, sgemmSmall) {
+    GemmProblem<float> p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                         GEMM64_M, GEMM64_N, GEMM64_K);
+    runGemm64(p, 1e-5 * GEMM64_K);
+}
+
+TEST(GEMM_64, dgemmSmall) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    GemmProblem<double> p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                          GEMM64_M, GEMM64_N, GEMM64_K);
+    runGemm64(p, 1e-12 * GEMM64_K);
+}
+
+TEST(GEMM_64, sgemmOffsetBeyond4G) {
+    const cl_ulong offC = (cl_ulong)1 << 32;
+    cl_ulong maxAlloc = clMath::BlasBase::getInstance()->maxMemAllocSize();
+
+    if (sizeof(size_t) < sizeof(cl_ulong) ||
+        maxAlloc < (offC + GEMM64_M * GEMM64_N) * sizeof(cl_float)) {
+        ::std::cerr << ">> WARNING: The target device can't allocate a "
+                       "buffer of more than 4G elements."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    GemmProblem<float> p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                         GEMM64_M, GEMM64_N, GEMM64_K, 0, (size_t)offC);
+    if (p.C == NULL) {
+        ::std::cerr << ">> WARNING: Failed to allocate a buffer of more "
+                       "than 4G elements." << ::std::endl
+                    << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+    runGemm64(p, 1e-5 * GEMM64_K);
+}
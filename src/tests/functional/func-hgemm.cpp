@@ -0,0 +1,229 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check half precision and mixed precision GEMM against a double precision
+ * host computation. Inputs are multiples of 1/16, which halves represent
+ * exactly, so the error only comes from accumulation and the rounding of
+ * the result; it is bounded by (K + 2) * u * (|alpha| sum |a b| + |beta c|)
+ * with u the unit roundoff of the accumulation.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define HALF_UNIT_ROUNDOFF  (1.0 / 2048)
+#define FLOAT_UNIT_ROUNDOFF (1.0 / 16777216)
+
+static float
+halfToFloat(cl_half h)
+{
+    unsigned int exponent = (h >> 10) & 0x1f;
+    unsigned int mantissa = h & 0x3ff;
+    float value;
+
+    if (exponent == 0) {
+        value = ldexpf((float)mantissa, -24);
+    }
+    else if (exponent == 0x1f) {
+        value = mantissa ? NAN : INFINITY;
+    }
+    else {
+        value = ldexpf((float)(mantissa | 0x400), (int)exponent - 25);
+    }
+    return (h & 0x8000) ? -value : value;
+}
+
+/* Exact for the multiples of 1/16 used here */
+static cl_half
+floatToHalf(float value)
+{
+    cl_half sign = (value < 0) ? 0x8000 : 0;
+    unsigned int mantissa;
+    int exponent;
+
+    value = fabsf(value);
+    if (value == 0) {
+        return sign;
+    }
+    frexpf(value, &exponent);
+    mantissa = (unsigned int)floor(ldexpf(value, 11 - exponent) + 0.5f);
+    if (mantissa == 0x800) {
+        mantissa = 0x400;
+        exponent++;
+    }
+    return sign | (cl_half)((exponent + 14) << 10) | (cl_half)(mantissa & 0x3ff);
+}
+
+/*
+ * The GEMM of a float problem, with A and B, and C unless halfC is false,
+ * in half precision buffers
+ */
+class HalfGemmProblem : public HostGemmProblem<cl_float>
+{
+    cl_command_queue queue;
+
+public:
+    bool halfC;
+    cl_mem A, B, C;
+
+    HalfGemmProblem(clblasOrder order_, clblasTranspose transA_,
+                    clblasTranspose transB_, size_t M_, size_t N_, size_t K_,
+                    bool halfC_) :
+        HostGemmProblem<cl_float>(order_, transA_, transB_, M_, N_, K_),
+        halfC(halfC_)
+    {
+        queue = clMath::BlasBase::getInstance()->commandQueues()[0];
+
+        A = buffer(hostA, sizeA, true);
+        B = buffer(hostB, sizeB, true);
+        C = buffer(hostC, sizeC, halfC);
+    }
+
+    ~HalfGemmProblem()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+    }
+
+    cl_command_queue *queues() { return &queue; }
+
+    cl_mem buffer(const float *data, size_t nElems, bool half)
+    {
+        cl_mem mem;
+
+        if (half) {
+            cl_half *halves = new cl_half[nElems];
+
+            for (size_t i = 0; i < nElems; i++) {
+                halves[i] = floatToHalf(data[i]);
+            }
+            mem = createBuffer(halves, nElems);
+            delete[] halves;
+        }
+        else {
+            mem = createBuffer(data, nElems);
+        }
+        return mem;
+    }
+
+    void check(double unitRoundoff)
+    {
+        float *result = new float[sizeC];
+
+        if (halfC) {
+            cl_half *halves = new cl_half[sizeC];
+
+            ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, C, CL_TRUE, 0,
+                sizeC * sizeof(cl_half), halves, 0, NULL, NULL));
+            for (size_t i = 0; i < sizeC; i++) {
+                result[i] = halfToFloat(halves[i]);
+            }
+            delete[] halves;
+        }
+        else {
+            ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, C, CL_TRUE, 0,
+                sizeC * sizeof(cl_float), result, 0, NULL, NULL));
+        }
+
+        for (size_t i = 0; i < M; i++) {
+            for (size_t j = 0; j < N; j++) {
+                double magnitude = 0;
+                double c = hostC[indexC(i, j)];
+                double ref, bound;
+
+                for (size_t k = 0; k < K; k++) {
+                    magnitude += fabs(elemA(i, k).real() * elemB(k, j).real());
+                }
+                ref = alpha * product(i, j).real() + beta * c;
+                bound = (K + 2) * unitRoundoff *
+                        (fabs(alpha) * magnitude + fabs(beta * c));
+                ASSERT_NEAR(ref, result[indexC(i, j)], bound)
+                    << "element (" << i << ", " << j << ")";
+            }
+        }
+        delete[] result;
+    }
+};
+
+static void
+runHgemm(HalfGemmProblem &p)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, clblasHgemm(p.order, p.transA, p.transB,
+        p.M, p.N, p.K, p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb,
+        p.beta, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    p.check(HALF_UNIT_ROUNDOFF);
+}
+
+static void
+runGemmEx(HalfGemmProblem &p)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, clblasGemmEx(p.order, p.transA, p.transB,
+        p.M, p.N, p.K, p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb,
+        p.beta, p.C, 0, p.ldc, clblasDataHalf, clblasDataFloat,
+        1, p.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    p.check(FLOAT_UNIT_ROUNDOFF);
+}
+
+TEST(HGEMM, columnMajorNN) {
+    HalfGemmProblem p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                      67, 45, 33, true);
+    runHgemm(p);
+}
+
+TEST(HGEMM, rowMajorTN) {
+    HalfGemmProblem p(clblasRowMajor, clblasTrans, clblasNoTrans,
+                      128, 64, 64, true);
+    runHgemm(p);
+}
+
+TEST(HGEMM, mixedColumnMajorNT) {
+    HalfGemmProblem p(clblasColumnMajor, clblasNoTrans, clblasTrans,
+                      67, 45, 33, false);
+    runGemmEx(p);
+}
+
+TEST(HGEMM, mixedRowMajorNN) {
+    HalfGemmProblem p(clblasRowMajor, clblasNoTrans, clblasNoTrans,
+                      128, 64, 64, false);
+    runGemmEx(p);
+}
+
+TEST(HGEMM, gemmExTypes) {
+    HalfGemmProblem p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                      16, 16, 16, false);
+
+    EXPECT_EQ(clblasInvalidValue, clblasGemmEx(p.order, p.transA, p.transB,
+        p.M, p.N, p.K, p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb,
+        p.beta, p.C, 0, p.ldc, (clblasDataType)-1, clblasDataFloat,
+        1, p.queues(), 0, NULL, NULL));
+    EXPECT_EQ(clblasNotImplemented, clblasGemmEx(p.order, p.transA, p.transB,
+        p.M, p.N, p.K, p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb,
+        p.beta, p.C, 0, p.ldc, clblasDataFloat, clblasDataHalf,
+        1, p.queues(), 0, NULL, NULL));
+}
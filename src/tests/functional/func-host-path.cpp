@@ -0,0 +1,275 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Host path: GEMM, GEMV, DOT, AXPY and SCAL run on the host with the
+ * thresholds forced give the results of the device, and complete with a
+ * user event. Vector lengths are not multiples of the SIMD width, so the
+ * scalar remainders are covered too.
+ *
+ * The thresholds are read again with hostPathSetup(), an internal function
+ * exported from the shared library on Linux and Mac only. Devices sharing
+ * no memory with the host never take the path and skip the tests.
+ */
+
+#include <stdlib.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+
+extern "C" void hostPathSetup(void);
+
+static const char *thresholdVars[] = {
+    "AMD_CLBLAS_GEMM_HOST_THRESHOLD",
+    "AMD_CLBLAS_GEMV_HOST_THRESHOLD",
+    "AMD_CLBLAS_DOT_HOST_THRESHOLD",
+    "AMD_CLBLAS_AXPY_HOST_THRESHOLD",
+    "AMD_CLBLAS_SCAL_HOST_THRESHOLD"
+};
+
+// A threshold of "0" disables the host path
+static void
+setThresholds(const char *value)
+{
+    for (size_t i = 0; i < sizeof(thresholdVars) / sizeof(thresholdVars[0]); i++) {
+        setenv(thresholdVars[i], value, 1);
+    }
+    hostPathSetup();
+}
+
+static bool
+hostPathAvailable(void)
+{
+    cl_command_queue queue = clMath::BlasBase::getInstance()->commandQueues()[0];
+    cl_device_id device;
+    cl_device_type type = 0;
+    cl_bool unified = CL_FALSE;
+
+    clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified),
+                    &unified, NULL);
+
+    if ((type & CL_DEVICE_TYPE_CPU) || (unified == CL_TRUE)) {
+        return true;
+    }
+    ::std::cerr << ">> WARNING: The target device shares no memory with "
+                   "the host." << ::std::endl << ">> Test skipped."
+                << ::std::endl;
+    return false;
+}
+
+typedef clblasStatus (*HostPathCall)(cl_mem *mems, cl_command_queue *queue,
+                                     cl_event *event);
+
+/*
+ * Run 'call' on buffers holding 'data' and read them back into 'data';
+ * 'userEvent' tells if the call completed with a user event
+ */
+template <typename T>
+static void
+runCall(HostPathCall call, std::vector< std::vector<T> > &data, bool host,
+        bool *userEvent)
+{
+    clMath::BlasBase *base = clMath::BlasBase::getInstance();
+    cl_command_queue queue = base->commandQueues()[0];
+    std::vector<cl_mem> mems(data.size());
+    cl_command_type type = 0;
+    cl_event event = NULL;
+    clblasStatus status;
+
+    for (size_t i = 0; i < data.size(); i++) {
+        mems[i] = clCreateBuffer(base->context(),
+            CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+            data[i].size() * sizeof(T), &data[i][0], NULL);
+        ASSERT_TRUE(mems[i] != NULL);
+    }
+
+    setThresholds(host ? "100000000" : "0");
+    status = call(&mems[0], &queue, &event);
+    setThresholds("0");
+    ASSERT_EQ(clblasSuccess, status);
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    clGetEventInfo(event, CL_EVENT_COMMAND_TYPE, sizeof(type), &type, NULL);
+    *userEvent = (type == CL_COMMAND_USER);
+    clReleaseEvent(event);
+
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, mems[i], CL_TRUE, 0,
+            data[i].size() * sizeof(T), &data[i][0], 0, NULL, NULL));
+        clReleaseMemObject(mems[i]);
+    }
+}
+
+/*
+ * Run 'call' on the device and on the host, and compare the first
+ * 'nrCompared' buffers; the others are scratch buffers
+ */
+template <typename T>
+static void
+compareHostPath(HostPathCall call, const size_t *sizes, size_t nrBuffers,
+                size_t nrCompared, T tolerance)
+{
+    std::vector< std::vector<T> > device(nrBuffers), host;
+    bool userEvent;
+
+    for (size_t i = 0; i < nrBuffers; i++) {
+        device[i].resize(sizes[i]);
+        for (size_t j = 0; j < sizes[i]; j++) {
+            device[i][j] = T(((i + 3) * j) % 17) / T(17) - T(0.5);
+        }
+    }
+    host = device;
+
+    runCall(call, device, false, &userEvent);
+    EXPECT_FALSE(userEvent);
+    runCall(call, host, true, &userEvent);
+    EXPECT_TRUE(userEvent) << "the problem didn't run on the host";
+
+    for (size_t i = 0; i < nrCompared; i++) {
+        for (size_t j = 0; j < sizes[i]; j++) {
+            ASSERT_NEAR(device[i][j], host[i][j], tolerance)
+                << "buffer " << i << ", element " << j;
+        }
+    }
+}
+
+#define GEMM_M 37
+#define GEMM_N 29
+#define GEMM_K 23
+#define GEMV_M 45
+#define GEMV_N 31
+#define VEC_N 203
+
+static clblasStatus
+sgemmColumnNN(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        GEMM_M, GEMM_N, GEMM_K, 1.5f, m[0], 0, GEMM_M, m[1], 0, GEMM_K,
+        0.5f, m[2], 0, GEMM_M, 1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+sgemmRowTN(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSgemm(clblasRowMajor, clblasTrans, clblasNoTrans,
+        GEMM_M, GEMM_N, GEMM_K, 1.5f, m[0], 0, GEMM_M, m[1], 0, GEMM_N,
+        0.0f, m[2], 0, GEMM_N, 1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+dgemmColumnTT(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasDgemm(clblasColumnMajor, clblasTrans, clblasTrans,
+        GEMM_M, GEMM_N, GEMM_K, 1.5, m[0], 0, GEMM_K, m[1], 0, GEMM_N,
+        0.5, m[2], 0, GEMM_M, 1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+sgemvColumnN(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSgemv(clblasColumnMajor, clblasNoTrans, GEMV_M, GEMV_N,
+        1.5f, m[0], 0, GEMV_M, m[1], 0, 1, 0.5f, m[2], 0, 1,
+        1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+sgemvColumnTStrided(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSgemv(clblasColumnMajor, clblasTrans, GEMV_M, GEMV_N,
+        1.5f, m[0], 0, GEMV_M, m[1], 0, 1, 0.5f, m[2], 0, 2,
+        1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+sdot(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSdot(VEC_N, m[0], 0, m[1], 0, 1, m[2], 0, 1, m[3],
+        1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+saxpy(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSaxpy(VEC_N, 1.5f, m[0], 0, 1, m[1], 0, 1,
+        1, queue, 0, NULL, event);
+}
+
+static clblasStatus
+sscal(cl_mem *m, cl_command_queue *queue, cl_event *event)
+{
+    return clblasSscal(VEC_N, 1.5f, m[0], 0, 1, 1, queue, 0, NULL, event);
+}
+
+TEST(HOST_PATH, sgemm) {
+    const size_t sizes[] = { GEMM_M * GEMM_K, GEMM_K * GEMM_N, GEMM_M * GEMM_N };
+
+    if (hostPathAvailable()) {
+        compareHostPath<float>(sgemmColumnNN, sizes, 3, 3, 1e-4f);
+        compareHostPath<float>(sgemmRowTN, sizes, 3, 3, 1e-4f);
+    }
+}
+
+TEST(HOST_PATH, dgemm) {
+    const size_t sizes[] = { GEMM_M * GEMM_K, GEMM_K * GEMM_N, GEMM_M * GEMM_N };
+
+    if (!clMath::BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+    if (hostPathAvailable()) {
+        compareHostPath<double>(dgemmColumnTT, sizes, 3, 3, 1e-12);
+    }
+}
+
+TEST(HOST_PATH, sgemv) {
+    const size_t sizes[] = { GEMV_M * GEMV_N, GEMV_M, GEMV_N * 2 };
+
+    if (hostPathAvailable()) {
+        compareHostPath<float>(sgemvColumnN, sizes, 3, 3, 1e-4f);
+        compareHostPath<float>(sgemvColumnTStrided, sizes, 3, 3, 1e-4f);
+    }
+}
+
+TEST(HOST_PATH, sdot) {
+    const size_t sizes[] = { 1, VEC_N, VEC_N, VEC_N };
+
+    if (hostPathAvailable()) {
+        compareHostPath<float>(sdot, sizes, 4, 3, 1e-3f);
+    }
+}
+
+TEST(HOST_PATH, saxpy) {
+    const size_t sizes[] = { VEC_N, VEC_N };
+
+    if (hostPathAvailable()) {
+        compareHostPath<float>(saxpy, sizes, 2, 2, 1e-5f);
+    }
+}
+
+TEST(HOST_PATH, sscal) {
+    const size_t sizes[] = { VEC_N };
+
+    if (hostPathAvailable()) {
+        compareHostPath<float>(sscal, sizes, 1, 1, 1e-5f);
+    }
+}
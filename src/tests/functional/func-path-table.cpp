@@ -0,0 +1,75 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Paths forced with CLBLAS_FORCE_PATH: every GEMM path either computes the
+ * right result or reports clblasNotImplemented, and a path of another
+ * routine is never taken silently.
+ */
+
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+#define PATH_M 96
+#define PATH_N 80
+#define PATH_K 200
+
+static clblasStatus
+forcedGemm(GemmProblem<float> &p, const char *path)
+{
+    ScopedEnv force("CLBLAS_FORCE_PATH", path);
+
+    if (!p.writeC()) {
+        return clblasOutOfResources;
+    }
+    return runGemm(p);
+}
+
+TEST(PATH_TABLE, gemmPaths) {
+    static const char *paths[] = {
+        "default", "autogemm", "special", "strassen", "streamk", "splitk"
+    };
+    GemmProblem<float> p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                         PATH_M, PATH_N, PATH_K);
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        clblasStatus status = forcedGemm(p, paths[i]);
+
+        if (status == clblasNotImplemented) {
+            continue;
+        }
+        ASSERT_EQ(clblasSuccess, status) << "path " << paths[i];
+        SCOPED_TRACE(paths[i]);
+        p.check(1e-4 * PATH_K);
+    }
+}
+
+TEST(PATH_TABLE, otherPathsFail) {
+    GemmProblem<float> p(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                         PATH_M, PATH_N, PATH_K);
+
+    // 3M is for the complex precisions, the memory patterns for TRSM/TRMM
+    EXPECT_EQ(clblasNotImplemented, forcedGemm(p, "3m"));
+    EXPECT_EQ(clblasNotImplemented, forcedGemm(p, "lds"));
+
+    ScopedEnv force("CLBLAS_FORCE_PATH", "splitk");
+    EXPECT_EQ(clblasNotImplemented, clblasStrsm(clblasColumnMajor, clblasLeft,
+        clblasLower, clblasNoTrans, clblasNonUnit, PATH_M, PATH_N, 1.0f,
+        p.A, 0, p.lda, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, NULL));
+}
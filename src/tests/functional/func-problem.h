@@ -0,0 +1,343 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Problems shared by the functional tests of the implementation paths:
+ * matrices of a fixed pattern, their buffers, a double precision host
+ * reference, and the environment switches selecting a path for the calls
+ * of one scope.
+ */
+
+#ifndef FUNC_PROBLEM_H_
+#define FUNC_PROBLEM_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <complex>
+#include <string>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+
+typedef std::complex<double> HostComplex;
+
+inline HostComplex value(cl_float v) { return HostComplex(v, 0); }
+inline HostComplex value(cl_double v) { return HostComplex(v, 0); }
+inline HostComplex value(const FloatComplex &v) { return HostComplex(v.s[0], v.s[1]); }
+inline HostComplex value(const DoubleComplex &v) { return HostComplex(v.s[0], v.s[1]); }
+
+inline void setValue(cl_float &v, double re, double) { v = (cl_float)re; }
+inline void setValue(cl_double &v, double re, double) { v = re; }
+inline void setValue(FloatComplex &v, double re, double im) { v.s[0] = (cl_float)re; v.s[1] = (cl_float)im; }
+inline void setValue(DoubleComplex &v, double re, double im) { v.s[0] = re; v.s[1] = im; }
+
+/*
+ * Elements in [-0.5, 0.5], multiples of 1/16 so that every precision,
+ * half included, holds them exactly
+ */
+template <typename T>
+T*
+fillMatrix(size_t nElems, size_t seed)
+{
+    T *data = new T[nElems];
+
+    for (size_t i = 0; i < nElems; i++) {
+        setValue(data[i], ((i * seed) % 17) / 16.0 - 0.5,
+                 ((i * seed) % 9) / 8.0 - 0.5);
+    }
+    return data;
+}
+
+template <typename T>
+cl_mem
+createBuffer(const T *data, size_t nElems)
+{
+    return clCreateBuffer(clMath::BlasBase::getInstance()->context(),
+                          CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                          nElems * sizeof(T), (void*)data, NULL);
+}
+
+inline bool
+skipDouble(void)
+{
+    if (!clMath::BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Sets an environment variable until the end of the scope, then restores
+ * its previous value. The library reads its path switches on every call.
+ */
+class ScopedEnv
+{
+    std::string name;
+    std::string saved;
+    bool wasSet;
+
+    void set(const char *v)
+    {
+#if WIN32
+        _putenv_s(name.c_str(), v);
+#else
+        setenv(name.c_str(), v, 1);
+#endif
+    }
+
+public:
+    ScopedEnv(const char *name_, const char *value_) : name(name_)
+    {
+        const char *old = getenv(name_);
+
+        wasSet = (old != NULL);
+        if (wasSet) {
+            saved = old;
+        }
+        set(value_);
+    }
+
+    ~ScopedEnv()
+    {
+        if (wasSet) {
+            set(saved.c_str());
+        }
+        else {
+#if WIN32
+            _putenv_s(name.c_str(), "");
+#else
+            unsetenv(name.c_str());
+#endif
+        }
+    }
+};
+
+/*
+ * GEMM on host matrices: op(A) is M x K and op(B) is K x N, with leading
+ * dimensions padded by 'pad' elements
+ */
+template <typename T>
+class HostGemmProblem
+{
+public:
+    clblasOrder order;
+    clblasTranspose transA, transB;
+    size_t M, N, K;
+    size_t lda, ldb, ldc;
+    size_t sizeA, sizeB, sizeC;
+    T alpha, beta;
+    T *hostA, *hostB, *hostC;
+
+    HostGemmProblem(clblasOrder order_, clblasTranspose transA_,
+                    clblasTranspose transB_, size_t M_, size_t N_, size_t K_,
+                    size_t pad = 0) :
+        order(order_), transA(transA_), transB(transB_), M(M_), N(N_), K(K_)
+    {
+        bool colMajor = (order == clblasColumnMajor);
+
+        lda = ((colMajor == (transA == clblasNoTrans)) ? M : K) + pad;
+        ldb = ((colMajor == (transB == clblasNoTrans)) ? K : N) + pad;
+        ldc = (colMajor ? M : N) + pad;
+        sizeA = lda * ((colMajor == (transA == clblasNoTrans)) ? K : M);
+        sizeB = ldb * ((colMajor == (transB == clblasNoTrans)) ? N : K);
+        sizeC = ldc * (colMajor ? N : M);
+
+        setValue(alpha, 1.5, -0.5);
+        setValue(beta, 0.5, 0.25);
+
+        hostA = fillMatrix<T>(sizeA, 7);
+        hostB = fillMatrix<T>(sizeB, 11);
+        hostC = fillMatrix<T>(sizeC, 5);
+    }
+
+    virtual ~HostGemmProblem()
+    {
+        delete[] hostA;
+        delete[] hostB;
+        delete[] hostC;
+    }
+
+    // element (i, k) of op(A)
+    HostComplex elemA(size_t i, size_t k) const
+    {
+        bool rows = (order == clblasColumnMajor) == (transA == clblasNoTrans);
+        HostComplex a = value(rows ? hostA[k * lda + i] : hostA[i * lda + k]);
+        return (transA == clblasConjTrans) ? conj(a) : a;
+    }
+
+    // element (k, j) of op(B)
+    HostComplex elemB(size_t k, size_t j) const
+    {
+        bool rows = (order == clblasColumnMajor) == (transB == clblasNoTrans);
+        HostComplex b = value(rows ? hostB[j * ldb + k] : hostB[k * ldb + j]);
+        return (transB == clblasConjTrans) ? conj(b) : b;
+    }
+
+    size_t indexC(size_t i, size_t j) const
+    {
+        return (order == clblasColumnMajor) ? j * ldc + i : i * ldc + j;
+    }
+
+    // element (i, j) of op(A)*op(B)
+    HostComplex product(size_t i, size_t j) const
+    {
+        HostComplex sum = 0;
+
+        for (size_t k = 0; k < K; k++) {
+            sum += elemA(i, k) * elemB(k, j);
+        }
+        return sum;
+    }
+
+    // Check the C computed from the initial one
+    void check(const T *result, double tolerance) const
+    {
+        for (size_t i = 0; i < M; i++) {
+            for (size_t j = 0; j < N; j++) {
+                HostComplex ref = value(alpha) * product(i, j) +
+                                  value(beta) * value(hostC[indexC(i, j)]);
+                HostComplex got = value(result[indexC(i, j)]);
+
+                ASSERT_NEAR(ref.real(), got.real(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+                ASSERT_NEAR(ref.imag(), got.imag(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+            }
+        }
+    }
+};
+
+/*
+ * The same GEMM in buffers, C starting at element offC of its buffer. C is
+ * left NULL if the buffer can't be allocated.
+ */
+template <typename T>
+class GemmProblem : public HostGemmProblem<T>
+{
+    cl_command_queue queue;
+
+public:
+    size_t offC;
+    cl_mem A, B, C;
+
+    GemmProblem(clblasOrder order_, clblasTranspose transA_,
+                clblasTranspose transB_, size_t M_, size_t N_, size_t K_,
+                size_t pad = 0, size_t offC_ = 0) :
+        HostGemmProblem<T>(order_, transA_, transB_, M_, N_, K_, pad),
+        offC(offC_)
+    {
+        clMath::BlasBase *base = clMath::BlasBase::getInstance();
+
+        queue = base->commandQueues()[0];
+        A = createBuffer(this->hostA, this->sizeA);
+        B = createBuffer(this->hostB, this->sizeB);
+        C = clCreateBuffer(base->context(), CL_MEM_READ_WRITE,
+                           (offC + this->sizeC) * sizeof(T), NULL, NULL);
+        if ((C != NULL) && !writeC()) {
+            clReleaseMemObject(C);
+            C = NULL;
+        }
+    }
+
+    ~GemmProblem()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        if (C != NULL) {
+            clReleaseMemObject(C);
+        }
+    }
+
+    cl_command_queue *queues() { return &queue; }
+
+    // Restore the initial C, before another run
+    bool writeC(void)
+    {
+        return clEnqueueWriteBuffer(queue, C, CL_TRUE, offC * sizeof(T),
+            this->sizeC * sizeof(T), this->hostC, 0, NULL, NULL) == CL_SUCCESS;
+    }
+
+    void readC(T *result)
+    {
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, C, CL_TRUE,
+            offC * sizeof(T), this->sizeC * sizeof(T), result, 0, NULL, NULL));
+    }
+
+    using HostGemmProblem<T>::check;
+
+    void check(double tolerance)
+    {
+        T *result = new T[this->sizeC];
+
+        readC(result);
+        HostGemmProblem<T>::check(result, tolerance);
+        delete[] result;
+    }
+};
+
+inline clblasStatus
+gemm(GemmProblem<cl_float> &p, cl_event *event)
+{
+    return clblasSgemm(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+inline clblasStatus
+gemm(GemmProblem<cl_double> &p, cl_event *event)
+{
+    return clblasDgemm(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+inline clblasStatus
+gemm(GemmProblem<FloatComplex> &p, cl_event *event)
+{
+    return clblasCgemm(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+inline clblasStatus
+gemm(GemmProblem<DoubleComplex> &p, cl_event *event)
+{
+    return clblasZgemm(p.order, p.transA, p.transB, p.M, p.N, p.K,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, p.beta, p.C, p.offC, p.ldc,
+        1, p.queues(), 0, NULL, event);
+}
+
+/* Run the GEMM and wait for it */
+template <typename T>
+clblasStatus
+runGemm(GemmProblem<T> &p)
+{
+    cl_event event = NULL;
+    clblasStatus status = gemm(p, &event);
+
+    if (status == clblasSuccess) {
+        status = (clblasStatus)clWaitForEvents(1, &event);
+        clReleaseEvent(event);
+    }
+    return status;
+}
+
+#endif  /* FUNC_PROBLEM_H_ */
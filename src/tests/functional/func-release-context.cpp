@@ -0,0 +1,145 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check that the resources held for a context are released: once
+ * clblasReleaseContextResources() returns, the library must hold no
+ * reference on a context it ran GEMM and TRSM on, and later calls on
+ * another context must still work.
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+
+static const size_t N = 64;
+
+class ContextRun
+{
+public:
+    cl_context context;
+    cl_command_queue queue;
+    cl_mem A, B, C;
+
+    ContextRun()
+    {
+        cl_device_id device;
+        cl_platform_id platform;
+        cl_context_properties props[3] = { CL_CONTEXT_PLATFORM, 0, 0 };
+        std::vector<float> a(N * N, 0.0f);
+
+        clGetCommandQueueInfo(clMath::BlasBase::getInstance()->commandQueues()[0],
+                              CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+        clGetDeviceInfo(device, CL_DEVICE_PLATFORM, sizeof(platform),
+                        &platform, NULL);
+        props[1] = (cl_context_properties)platform;
+        context = clCreateContext(props, 1, &device, NULL, NULL, NULL);
+        queue = clCreateCommandQueue(context, device, 0, NULL);
+
+        for (size_t i = 0; i < N; i++) {
+            a[i * N + i] = 2.0f;
+        }
+        A = buffer(a);
+        for (size_t i = 0; i < N * N; i++) {
+            a[i] = (float)(i % 7);
+        }
+        B = buffer(a);
+        C = buffer(a);
+    }
+
+    // the context is left to the caller
+    ~ContextRun()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+        clReleaseCommandQueue(queue);
+    }
+
+    cl_mem buffer(std::vector<float> &data)
+    {
+        return clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                              data.size() * sizeof(float), &data[0], NULL);
+    }
+
+    // C = A * B with A = 2I, then B = A^-1 * B, and check B and C
+    void run()
+    {
+        cl_event event = NULL;
+        std::vector<float> b(N * N), c(N * N);
+
+        ASSERT_EQ(clblasSuccess, clblasSgemm(clblasColumnMajor, clblasNoTrans,
+            clblasNoTrans, N, N, N, 1.0f, A, 0, N, B, 0, N, 0.0f, C, 0, N,
+            1, &queue, 0, NULL, &event));
+        ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+        clReleaseEvent(event);
+        ASSERT_EQ(clblasSuccess, clblasStrsm(clblasColumnMajor, clblasLeft,
+            clblasLower, clblasNoTrans, clblasNonUnit, N, N, 1.0f, A, 0, N,
+            B, 0, N, 1, &queue, 0, NULL, &event));
+        ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+        clReleaseEvent(event);
+
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, B, CL_TRUE, 0,
+            N * N * sizeof(float), &b[0], 0, NULL, NULL));
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, C, CL_TRUE, 0,
+            N * N * sizeof(float), &c[0], 0, NULL, NULL));
+        for (size_t i = 0; i < N * N; i++) {
+            ASSERT_NEAR((float)(i % 7) * 2.0f, c[i], 1e-5) << "element " << i;
+            ASSERT_NEAR((float)(i % 7) / 2.0f, b[i], 1e-5) << "element " << i;
+        }
+    }
+};
+
+static cl_uint
+contextReferences(cl_context context)
+{
+    cl_uint count = 0;
+
+    clGetContextInfo(context, CL_CONTEXT_REFERENCE_COUNT, sizeof(count),
+                     &count, NULL);
+    return count;
+}
+
+TEST(RELEASE_CONTEXT, invalidContext) {
+    EXPECT_EQ(clblasInvalidContext, clblasReleaseContextResources(NULL));
+}
+
+TEST(RELEASE_CONTEXT, noReferenceLeft) {
+    ContextRun *run = new ContextRun;
+    cl_context context = run->context;
+
+    run->run();
+    delete run;
+
+    ASSERT_EQ(clblasSuccess, clblasReleaseContextResources(context));
+    // the buffers and the queue are gone, only the application's
+    // reference should be left
+    EXPECT_EQ(1u, contextReferences(context));
+    clReleaseContext(context);
+}
+
+TEST(RELEASE_CONTEXT, reuseAfterRelease) {
+    for (int i = 0; i < 2; i++) {
+        ContextRun run;
+
+        run.run();
+        EXPECT_EQ(clblasSuccess, clblasReleaseContextResources(run.context));
+        clReleaseContext(run.context);
+    }
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Runtime statistics: after a reset only the calls made since are
+ * counted, every call launches at least one kernel, and a TRSM is counted
+ * once although it is made of GEMM calls.
+ */
+
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+
+static const size_t N = 64;
+
+static std::vector<clblasStatistics>
+getStatistics(void)
+{
+    std::vector<clblasStatistics> stats;
+    size_t count = 0;
+
+    EXPECT_EQ(clblasSuccess, clblasGetStatistics(NULL, &count));
+    stats.resize(count);
+    if (count != 0) {
+        EXPECT_EQ(clblasSuccess, clblasGetStatistics(&stats[0], &count));
+    }
+    stats.resize(count);
+
+    return stats;
+}
+
+static const clblasStatistics*
+findStatistics(const std::vector<clblasStatistics> &stats, const char *function)
+{
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (strcmp(stats[i].function, function) == 0) {
+            return &stats[i];
+        }
+    }
+    return NULL;
+}
+
+TEST(STATISTICS, invalidArguments) {
+    size_t count = 1;
+
+    EXPECT_EQ(clblasInvalidValue, clblasGetStatistics(NULL, NULL));
+    EXPECT_EQ(clblasInvalidValue, clblasGetStatistics(NULL, &count));
+}
+
+TEST(STATISTICS, countsSinceReset) {
+    clMath::BlasBase *base = clMath::BlasBase::getInstance();
+    cl_command_queue queue = base->commandQueues()[0];
+    std::vector<float> a(N * N, 0.0f);
+    const clblasStatistics *st;
+    cl_mem A, B, C;
+
+    for (size_t i = 0; i < N; i++) {
+        a[i * N + i] = 1.0f;
+    }
+    A = clCreateBuffer(base->context(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                       N * N * sizeof(float), &a[0], NULL);
+    B = clCreateBuffer(base->context(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                       N * N * sizeof(float), &a[0], NULL);
+    C = clCreateBuffer(base->context(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                       N * N * sizeof(float), &a[0], NULL);
+
+    ASSERT_EQ(clblasSuccess, clblasResetStatistics());
+    EXPECT_EQ(0u, getStatistics().size());
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(clblasSuccess, clblasSgemm(clblasColumnMajor, clblasNoTrans,
+            clblasNoTrans, N, N, N, 1.0f, A, 0, N, B, 0, N, 0.0f, C, 0, N,
+            1, &queue, 0, NULL, NULL));
+    }
+    ASSERT_EQ(clblasSuccess, clblasStrsm(clblasColumnMajor, clblasLeft,
+        clblasLower, clblasNoTrans, clblasNonUnit, N, N, 1.0f, A, 0, N,
+        B, 0, N, 1, &queue, 0, NULL, NULL));
+    ASSERT_EQ(CL_SUCCESS, clFinish(queue));
+
+    std::vector<clblasStatistics> stats = getStatistics();
+
+    st = findStatistics(stats, "sgemm");
+    ASSERT_TRUE(st != NULL);
+    EXPECT_EQ(3u, st->calls);
+    EXPECT_LE(3u, st->kernelLaunches);
+    EXPECT_LE(0.0, st->meanEnqueueMicroseconds);
+
+    st = findStatistics(stats, "strsm");
+    ASSERT_TRUE(st != NULL);
+    EXPECT_EQ(1u, st->calls);
+    EXPECT_LE(1u, st->kernelLaunches);
+
+    // an array too small for the entries is filled and the count of all
+    // of them returned
+    clblasStatistics first;
+    size_t count = 1;
+    EXPECT_EQ(clblasSuccess, clblasGetStatistics(&first, &count));
+    EXPECT_EQ(stats.size(), count);
+
+    ASSERT_EQ(clblasSuccess, clblasResetStatistics());
+    stats = getStatistics();
+    EXPECT_TRUE(findStatistics(stats, "sgemm") == NULL);
+
+    clReleaseMemObject(A);
+    clReleaseMemObject(B);
+    clReleaseMemObject(C);
+}
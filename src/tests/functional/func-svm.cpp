@@ -0,0 +1,281 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check the SVM pointer variants against a straightforward host
+ * computation. The tests are skipped if the device doesn't support
+ * OpenCL 2.0 shared virtual memory.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "BlasBase.h"
+
+#if defined(CL_VERSION_2_0)
+
+#define SVM_TEST_SIZE 67
+
+class SVMClass
+{
+    cl_context context;
+    cl_command_queue queue;
+    bool supported;
+
+public:
+    SVMClass()
+    {
+        clMath::BlasBase *base = clMath::BlasBase::getInstance();
+        cl_device_id device;
+        cl_device_svm_capabilities caps = 0;
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+        supported = (clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE,
+                        sizeof(device), &device, NULL) == CL_SUCCESS) &&
+                    (clGetDeviceInfo(device, CL_DEVICE_SVM_CAPABILITIES,
+                        sizeof(caps), &caps, NULL) == CL_SUCCESS) &&
+                    (caps & CL_DEVICE_SVM_COARSE_GRAIN_BUFFER);
+    }
+
+    bool isSupported() const { return supported; }
+    cl_command_queue *queues() { return &queue; }
+
+    float* alloc(size_t nElems)
+    {
+        return static_cast<float*>(clSVMAlloc(context, CL_MEM_READ_WRITE,
+                                              nElems * sizeof(float), 0));
+    }
+
+    void release(float *ptr) { clSVMFree(context, ptr); }
+
+    /* Coarse grained SVM is accessed by the host only between map and unmap */
+    void map(float *ptr, size_t nElems)
+    {
+        clEnqueueSVMMap(queue, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, ptr,
+                        nElems * sizeof(float), 0, NULL, NULL);
+    }
+
+    void unmap(float *ptr)
+    {
+        clEnqueueSVMUnmap(queue, ptr, 0, NULL, NULL);
+    }
+
+    void fill(float *ptr, size_t nElems)
+    {
+        map(ptr, nElems);
+        for (size_t i = 0; i < nElems; i++) {
+            ptr[i] = (float)((i * 7) % 13) / 13.0f - 0.5f;
+        }
+        unmap(ptr);
+    }
+};
+
+#define SKIP_IF_NO_SVM(svm)                                         \
+    if (!(svm).isSupported()) {                                     \
+        ::std::cerr << ">> The device doesn't support SVM."          \
+            << ::std::endl << ">> Test skipped." << ::std::endl;     \
+        SUCCEED();                                                  \
+        return;                                                     \
+    }
+
+TEST(SVM, sgemm) {
+    SVMClass svm;
+    SKIP_IF_NO_SVM(svm);
+
+    const size_t n = SVM_TEST_SIZE;
+    float *A = svm.alloc(n * n);
+    float *B = svm.alloc(n * n);
+    float *C = svm.alloc(n * n);
+    float *ref = new float[n * n];
+    cl_event event = NULL;
+
+    svm.fill(A, n * n);
+    svm.fill(B, n * n);
+    svm.fill(C, n * n);
+
+    svm.map(A, n * n);
+    svm.map(B, n * n);
+    svm.map(C, n * n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            float sum = 0;
+            for (size_t k = 0; k < n; k++) {
+                sum += A[k * n + i] * B[j * n + k];
+            }
+            ref[j * n + i] = 2.0f * sum + 0.5f * C[j * n + i];
+        }
+    }
+    svm.unmap(A);
+    svm.unmap(B);
+    svm.unmap(C);
+
+    ASSERT_EQ(clblasSuccess, clblasSgemmSVM(clblasColumnMajor, clblasNoTrans,
+        clblasNoTrans, n, n, n, 2.0f, A, 0, n, B, 0, n, 0.5f, C, 0, n,
+        1, svm.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+
+    svm.map(C, n * n);
+    for (size_t i = 0; i < n * n; i++) {
+        ASSERT_NEAR(ref[i], C[i], 1e-3f * n) << "element " << i;
+    }
+    svm.unmap(C);
+    clFinish(svm.queues()[0]);
+
+    delete[] ref;
+    svm.release(A);
+    svm.release(B);
+    svm.release(C);
+}
+
+TEST(SVM, sgemv) {
+    SVMClass svm;
+    SKIP_IF_NO_SVM(svm);
+
+    const size_t n = SVM_TEST_SIZE;
+    float *A = svm.alloc(n * n);
+    float *x = svm.alloc(n);
+    float *y = svm.alloc(n);
+    float *ref = new float[n];
+    cl_event event = NULL;
+
+    svm.fill(A, n * n);
+    svm.fill(x, n);
+    svm.fill(y, n);
+
+    svm.map(A, n * n);
+    svm.map(x, n);
+    svm.map(y, n);
+    for (size_t i = 0; i < n; i++) {
+        float sum = 0;
+        for (size_t j = 0; j < n; j++) {
+            sum += A[i * n + j] * x[j];
+        }
+        ref[i] = 2.0f * sum + 0.5f * y[i];
+    }
+    svm.unmap(A);
+    svm.unmap(x);
+    svm.unmap(y);
+
+    ASSERT_EQ(clblasSuccess, clblasSgemvSVM(clblasRowMajor, clblasNoTrans,
+        n, n, 2.0f, A, 0, n, x, 0, 1, 0.5f, y, 0, 1,
+        1, svm.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+
+    svm.map(y, n);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_NEAR(ref[i], y[i], 1e-3f * n) << "element " << i;
+    }
+    svm.unmap(y);
+    clFinish(svm.queues()[0]);
+
+    delete[] ref;
+    svm.release(A);
+    svm.release(x);
+    svm.release(y);
+}
+
+TEST(SVM, saxpy) {
+    SVMClass svm;
+    SKIP_IF_NO_SVM(svm);
+
+    const size_t n = SVM_TEST_SIZE;
+    float *x = svm.alloc(n);
+    float *y = svm.alloc(n);
+    float *ref = new float[n];
+    cl_event event = NULL;
+
+    svm.fill(x, n);
+    svm.fill(y, n);
+
+    svm.map(x, n);
+    svm.map(y, n);
+    for (size_t i = 0; i < n; i++) {
+        ref[i] = 3.0f * x[i] + y[i];
+    }
+    svm.unmap(x);
+    svm.unmap(y);
+
+    ASSERT_EQ(clblasSuccess, clblasSaxpySVM(n, 3.0f, x, 0, 1, y, 0, 1,
+        1, svm.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+
+    svm.map(y, n);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_NEAR(ref[i], y[i], 1e-5f) << "element " << i;
+    }
+    svm.unmap(y);
+    clFinish(svm.queues()[0]);
+
+    delete[] ref;
+    svm.release(x);
+    svm.release(y);
+}
+
+TEST(SVM, sdot) {
+    SVMClass svm;
+    SKIP_IF_NO_SVM(svm);
+
+    const size_t n = SVM_TEST_SIZE;
+    float *x = svm.alloc(n);
+    float *y = svm.alloc(n);
+    float *dot = svm.alloc(1);
+    float *scratch = svm.alloc(n);
+    float ref = 0;
+    cl_event event = NULL;
+
+    svm.fill(x, n);
+    svm.fill(y, n);
+
+    svm.map(x, n);
+    svm.map(y, n);
+    for (size_t i = 0; i < n; i++) {
+        ref += x[i] * y[i];
+    }
+    svm.unmap(x);
+    svm.unmap(y);
+
+    ASSERT_EQ(clblasSuccess, clblasSdotSVM(n, dot, 0, x, 0, 1, y, 0, 1,
+        scratch, 1, svm.queues(), 0, NULL, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+
+    svm.map(dot, 1);
+    ASSERT_NEAR(ref, dot[0], 1e-3f * n);
+    svm.unmap(dot);
+    clFinish(svm.queues()[0]);
+
+    svm.release(x);
+    svm.release(y);
+    svm.release(dot);
+    svm.release(scratch);
+}
+
+TEST(SVM, nullPointer) {
+    SVMClass svm;
+    SKIP_IF_NO_SVM(svm);
+
+    float *y = svm.alloc(16);
+
+    EXPECT_EQ(clblasInvalidVecX, clblasSaxpySVM(16, 1.0f, NULL, 0, 1,
+        y, 0, 1, 1, svm.queues(), 0, NULL, NULL));
+
+    svm.release(y);
+}
+
+#endif  /* CL_VERSION_2_0 */
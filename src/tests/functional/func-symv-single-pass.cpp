@@ -0,0 +1,245 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check single pass SPMV, HPMV and HEMV against a double precision host
+ * computation, for both triangles and orders, packed and full storage, and
+ * sizes that are and aren't multiples of the tile. The unreferenced
+ * triangle holds garbage and Hermitian diagonals a spurious imaginary part,
+ * neither of which may be read.
+ */
+
+#include <stdlib.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+template <typename T>
+class SymvProblem
+{
+    cl_command_queue queue;
+
+    std::vector<T> hostA, hostX, hostY;
+    // the whole matrix, as referenced by the routine
+    std::vector<HostComplex> full;
+
+public:
+    clblasOrder order;
+    clblasUplo uplo;
+    size_t N, lda;
+    int incx, incy;
+    bool packed, hermitian;
+    T alpha, beta;
+    cl_mem A, X, Y;
+
+    SymvProblem(clblasOrder order_, clblasUplo uplo_, size_t N_,
+                bool packed_, bool hermitian_) :
+        order(order_), uplo(uplo_), N(N_), incx(2), incy(3),
+        packed(packed_), hermitian(hermitian_)
+    {
+        queue = clMath::BlasBase::getInstance()->commandQueues()[0];
+
+        lda = packed ? 0 : N + 3;
+        setValue(alpha, 1.5, hermitian ? -0.5 : 0);
+        setValue(beta, 0.5, hermitian ? 0.25 : 0);
+
+        hostA.resize(packed ? N * (N + 1) / 2 : lda * N);
+        full.resize(N * N);
+        for (size_t i = 0; i < hostA.size(); i++) {
+            setValue(hostA[i], 99, 99);
+        }
+        for (size_t j = 0; j < N; j++) {
+            for (size_t i = 0; i < N; i++) {
+                bool stored = (uplo == clblasLower) ? (i >= j) : (i <= j);
+
+                if (!stored) {
+                    continue;
+                }
+
+                T &a = hostA[index(i, j)];
+                setValue(a, ((i * 7 + j * 3) % 13) / 13.0 - 0.5,
+                         ((i * 5 + j) % 7) / 7.0 - 0.5);
+                if (i == j) {
+                    full[j * N + i] = hermitian ? value(a).real() : value(a);
+                }
+                else {
+                    full[j * N + i] = value(a);
+                    full[i * N + j] = hermitian ? conj(value(a)) : value(a);
+                }
+            }
+        }
+
+        hostX.resize(N * incx);
+        for (size_t i = 0; i < hostX.size(); i++) {
+            setValue(hostX[i], ((i * 11) % 13) / 13.0 - 0.5,
+                     ((i * 3) % 7) / 7.0 - 0.5);
+        }
+        hostY.resize(N * incy);
+        for (size_t i = 0; i < hostY.size(); i++) {
+            setValue(hostY[i], ((i * 5) % 13) / 13.0 - 0.5,
+                     ((i * 2) % 7) / 7.0 - 0.5);
+        }
+
+        A = createBuffer(&hostA[0], hostA.size());
+        X = createBuffer(&hostX[0], hostX.size());
+        Y = createBuffer(&hostY[0], hostY.size());
+    }
+
+    ~SymvProblem()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(X);
+        clReleaseMemObject(Y);
+    }
+
+    cl_command_queue *queues() { return &queue; }
+
+    // index of the stored element (i, j)
+    size_t index(size_t i, size_t j) const
+    {
+        bool colMajor = (order == clblasColumnMajor);
+        size_t r = colMajor ? i : j;
+        size_t c = colMajor ? j : i;
+        // the stored triangle of the column major view
+        bool upper = (uplo == clblasUpper) == colMajor;
+
+        if (!packed) {
+            return c * lda + r;
+        }
+        return upper ? r + c * (c + 1) / 2 : r + c * (2 * N - c - 1) / 2;
+    }
+
+    void check(double tolerance)
+    {
+        std::vector<T> result(hostY.size());
+        HostComplex a = value(alpha);
+        HostComplex b = value(beta);
+
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, Y, CL_TRUE, 0,
+            result.size() * sizeof(T), &result[0], 0, NULL, NULL));
+        for (size_t i = 0; i < N; i++) {
+            HostComplex ref = 0;
+            HostComplex got = value(result[i * incy]);
+
+            for (size_t j = 0; j < N; j++) {
+                ref += full[j * N + i] * value(hostX[j * incx]);
+            }
+            ref = a * ref + b * value(hostY[i * incy]);
+            ASSERT_NEAR(ref.real(), got.real(), tolerance) << "element " << i;
+            ASSERT_NEAR(ref.imag(), got.imag(), tolerance) << "element " << i;
+        }
+    }
+};
+
+static clblasStatus
+symv(SymvProblem<float> &p, cl_event *event)
+{
+    return clblasSspmv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.X, 0, p.incx,
+        p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+symv(SymvProblem<double> &p, cl_event *event)
+{
+    return clblasDspmv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.X, 0, p.incx,
+        p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+symv(SymvProblem<FloatComplex> &p, cl_event *event)
+{
+    if (p.packed) {
+        return clblasChpmv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.X, 0,
+            p.incx, p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasChemv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.lda, p.X, 0,
+        p.incx, p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+symv(SymvProblem<DoubleComplex> &p, cl_event *event)
+{
+    if (p.packed) {
+        return clblasZhpmv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.X, 0,
+            p.incx, p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasZhemv(p.order, p.uplo, p.N, p.alpha, p.A, 0, p.lda, p.X, 0,
+        p.incx, p.beta, p.Y, 0, p.incy, 1, p.queues(), 0, NULL, event);
+}
+
+template <typename T>
+static void
+runSymv(SymvProblem<T> &p, double tolerance)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, symv(p, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    p.check(tolerance);
+}
+
+TEST(SYMV_SINGLE_PASS, sspmvColumnMajorLower) {
+    SymvProblem<float> p(clblasColumnMajor, clblasLower, 130, true, false);
+    runSymv(p, 1e-4);
+}
+
+TEST(SYMV_SINGLE_PASS, sspmvRowMajorUpper) {
+    SymvProblem<float> p(clblasRowMajor, clblasUpper, 96, true, false);
+    runSymv(p, 1e-4);
+}
+
+TEST(SYMV_SINGLE_PASS, dspmvColumnMajorUpper) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    SymvProblem<double> p(clblasColumnMajor, clblasUpper, 77, true, false);
+    runSymv(p, 1e-10);
+}
+
+TEST(SYMV_SINGLE_PASS, chpmvRowMajorLower) {
+    SymvProblem<FloatComplex> p(clblasRowMajor, clblasLower, 100, true, true);
+    runSymv(p, 1e-4);
+}
+
+TEST(SYMV_SINGLE_PASS, chemvColumnMajorUpper) {
+    SymvProblem<FloatComplex> p(clblasColumnMajor, clblasUpper, 65, false, true);
+    runSymv(p, 1e-4);
+}
+
+TEST(SYMV_SINGLE_PASS, zhpmvColumnMajorLower) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    SymvProblem<DoubleComplex> p(clblasColumnMajor, clblasLower, 33, true, true);
+    runSymv(p, 1e-10);
+}
+
+TEST(SYMV_SINGLE_PASS, zhemvRowMajorLower) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    SymvProblem<DoubleComplex> p(clblasRowMajor, clblasLower, 128, false, true);
+    runSymv(p, 1e-10);
+}
@@ -0,0 +1,285 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check SYRK, HERK, SYR2K and HER2K on the triangular AutoGemm kernels
+ * against a double precision host computation. Sizes that are and aren't
+ * multiples of the macro tile are used; the other triangle of C must be
+ * left untouched and HERK/HER2K must leave a real diagonal.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+template <typename T>
+class SyrkProblem
+{
+    cl_command_queue queue;
+
+    T *hostA, *hostB, *hostC;
+    size_t sizeAB, sizeC;
+
+public:
+    clblasOrder order;
+    clblasUplo uplo;
+    clblasTranspose trans;
+    size_t N, K;
+    size_t lda, ldc;
+    bool rank2k, hermitian;
+    T alpha, beta;
+    cl_mem A, B, C;
+
+    SyrkProblem(clblasOrder order_, clblasUplo uplo_, clblasTranspose trans_,
+                size_t N_, size_t K_, bool rank2k_, bool hermitian_) :
+        order(order_), uplo(uplo_), trans(trans_), N(N_), K(K_),
+        rank2k(rank2k_), hermitian(hermitian_)
+    {
+        bool colMajor = (order == clblasColumnMajor);
+
+        queue = clMath::BlasBase::getInstance()->commandQueues()[0];
+
+        // padded leading dimensions
+        lda = ((colMajor == (trans == clblasNoTrans)) ? N : K) + 3;
+        ldc = N + 5;
+        sizeAB = lda * ((colMajor == (trans == clblasNoTrans)) ? K : N);
+        sizeC = ldc * N;
+
+        // HERK takes real alpha and beta
+        setValue(alpha, 1.5, (hermitian && !rank2k) ? 0 : -0.5);
+        setValue(beta, 0.5, hermitian ? 0 : 0.25);
+
+        hostA = fillMatrix<T>(sizeAB, 7);
+        hostB = fillMatrix<T>(sizeAB, 11);
+        hostC = fillMatrix<T>(sizeC, 5);
+
+        A = createBuffer(hostA, sizeAB);
+        B = createBuffer(hostB, sizeAB);
+        C = createBuffer(hostC, sizeC);
+    }
+
+    ~SyrkProblem()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+        delete[] hostA;
+        delete[] hostB;
+        delete[] hostC;
+    }
+
+    cl_command_queue *queues() { return &queue; }
+
+    // element (i, k) of the N x K matrix op(X), without conjugation
+    HostComplex elem(const T *X, size_t i, size_t k) const
+    {
+        bool rows = (order == clblasColumnMajor) == (trans == clblasNoTrans);
+        return value(rows ? X[k * lda + i] : X[i * lda + k]);
+    }
+
+    // op(X)*op(Y)' element (i, j), ' conjugating for Hermitian updates
+    HostComplex product(const T *X, const T *Y, size_t i, size_t j) const
+    {
+        HostComplex sum = 0;
+
+        for (size_t k = 0; k < K; k++) {
+            HostComplex x = elem(X, i, k);
+            HostComplex y = elem(Y, j, k);
+
+            if (hermitian) {
+                if (trans == clblasNoTrans) {
+                    y = conj(y);
+                }
+                else {
+                    x = conj(x);
+                }
+            }
+            sum += x * y;
+        }
+        return sum;
+    }
+
+    size_t indexC(size_t i, size_t j) const
+    {
+        return (order == clblasColumnMajor) ? j * ldc + i : i * ldc + j;
+    }
+
+    void check(double tolerance)
+    {
+        T *result = new T[sizeC];
+        HostComplex a = value(alpha);
+        HostComplex b = value(beta);
+
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, C, CL_TRUE, 0,
+            sizeC * sizeof(T), result, 0, NULL, NULL));
+        for (size_t i = 0; i < N; i++) {
+            for (size_t j = 0; j < N; j++) {
+                HostComplex c = value(result[indexC(i, j)]);
+                bool inTriangle = (uplo == clblasLower) ? (i >= j) : (i <= j);
+
+                if (!inTriangle) {
+                    ASSERT_EQ(value(hostC[indexC(i, j)]), c)
+                        << "element (" << i << ", " << j << ") changed";
+                    continue;
+                }
+
+                HostComplex ref = a * product(hostA, rank2k ? hostB : hostA, i, j);
+                if (rank2k) {
+                    ref += (hermitian ? conj(a) : a) * product(hostB, hostA, i, j);
+                }
+                ref += b * value(hostC[indexC(i, j)]);
+                if (hermitian && i == j) {
+                    ASSERT_EQ(0.0, c.imag()) << "diagonal element " << i;
+                    ref = HostComplex(ref.real(), 0);
+                }
+                ASSERT_NEAR(ref.real(), c.real(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+                ASSERT_NEAR(ref.imag(), c.imag(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+            }
+        }
+        delete[] result;
+    }
+};
+
+static clblasStatus
+syrk(SyrkProblem<float> &p, cl_event *event)
+{
+    if (p.rank2k) {
+        return clblasSsyr2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta, p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    return clblasSsyrk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+        p.A, 0, p.lda, p.beta, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+syrk(SyrkProblem<double> &p, cl_event *event)
+{
+    if (p.rank2k) {
+        return clblasDsyr2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta, p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    return clblasDsyrk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+        p.A, 0, p.lda, p.beta, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+syrk(SyrkProblem<FloatComplex> &p, cl_event *event)
+{
+    if (p.hermitian && p.rank2k) {
+        return clblasCher2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta.s[0], p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    if (p.hermitian) {
+        return clblasCherk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha.s[0],
+            p.A, 0, p.lda, p.beta.s[0], p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    if (p.rank2k) {
+        return clblasCsyr2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta, p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    return clblasCsyrk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+        p.A, 0, p.lda, p.beta, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+syrk(SyrkProblem<DoubleComplex> &p, cl_event *event)
+{
+    if (p.hermitian && p.rank2k) {
+        return clblasZher2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta.s[0], p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    if (p.hermitian) {
+        return clblasZherk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha.s[0],
+            p.A, 0, p.lda, p.beta.s[0], p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    if (p.rank2k) {
+        return clblasZsyr2k(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+            p.A, 0, p.lda, p.B, 0, p.lda, p.beta, p.C, 0, p.ldc,
+            1, p.queues(), 0, NULL, event);
+    }
+    return clblasZsyrk(p.order, p.uplo, p.trans, p.N, p.K, p.alpha,
+        p.A, 0, p.lda, p.beta, p.C, 0, p.ldc, 1, p.queues(), 0, NULL, event);
+}
+
+template <typename T>
+static void
+runSyrk(SyrkProblem<T> &p, double tolerance)
+{
+    cl_event event = NULL;
+
+    ASSERT_EQ(clblasSuccess, syrk(p, &event));
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    p.check(tolerance);
+}
+
+TEST(SYRK_AUTOGEMM, ssyrkColumnMajorLowerN) {
+    SyrkProblem<float> p(clblasColumnMajor, clblasLower, clblasNoTrans,
+                         130, 70, false, false);
+    runSyrk(p, 1e-4);
+}
+
+TEST(SYRK_AUTOGEMM, ssyrkRowMajorUpperT) {
+    SyrkProblem<float> p(clblasRowMajor, clblasUpper, clblasTrans,
+                         128, 64, false, false);
+    runSyrk(p, 1e-4);
+}
+
+TEST(SYRK_AUTOGEMM, dsyr2kColumnMajorUpperN) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    SyrkProblem<double> p(clblasColumnMajor, clblasUpper, clblasNoTrans,
+                          100, 33, true, false);
+    runSyrk(p, 1e-10);
+}
+
+TEST(SYRK_AUTOGEMM, csyrkColumnMajorUpperT) {
+    SyrkProblem<FloatComplex> p(clblasColumnMajor, clblasUpper, clblasTrans,
+                                64, 17, false, false);
+    runSyrk(p, 1e-4);
+}
+
+TEST(SYRK_AUTOGEMM, cherkColumnMajorLowerN) {
+    SyrkProblem<FloatComplex> p(clblasColumnMajor, clblasLower, clblasNoTrans,
+                                70, 40, false, true);
+    runSyrk(p, 1e-4);
+}
+
+TEST(SYRK_AUTOGEMM, zher2kRowMajorLowerC) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    SyrkProblem<DoubleComplex> p(clblasRowMajor, clblasLower, clblasConjTrans,
+                                 65, 20, true, true);
+    runSyrk(p, 1e-10);
+}
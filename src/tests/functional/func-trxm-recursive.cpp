@@ -0,0 +1,295 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Check the recursive GEMM-based TRSM and TRMM against a double precision
+ * host computation: TRMM against the product, TRSM through the residual
+ * op(A)*X - alpha*B. The threshold is lowered so that triangles of a few
+ * diagonal blocks, not multiples of the block, take the recursive path.
+ */
+
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include "func-problem.h"
+
+template <typename T>
+class TrxmProblem
+{
+    cl_command_queue queue;
+
+    T *hostA, *hostB;
+    size_t sizeA, sizeB;
+
+public:
+    clblasOrder order;
+    clblasSide side;
+    clblasUplo uplo;
+    clblasTranspose trans;
+    clblasDiag diag;
+    size_t M, N, K;
+    size_t lda, ldb;
+    T alpha;
+    cl_mem A, B;
+
+    TrxmProblem(clblasOrder order_, clblasSide side_, clblasUplo uplo_,
+                clblasTranspose trans_, clblasDiag diag_,
+                size_t M_, size_t N_) :
+        order(order_), side(side_), uplo(uplo_), trans(trans_), diag(diag_),
+        M(M_), N(N_)
+    {
+        queue = clMath::BlasBase::getInstance()->commandQueues()[0];
+
+        // order of the triangle, and padded leading dimensions
+        K = (side == clblasLeft) ? M : N;
+        lda = K + 3;
+        ldb = ((order == clblasColumnMajor) ? M : N) + 5;
+        sizeA = lda * K;
+        sizeB = ldb * ((order == clblasColumnMajor) ? N : M);
+
+        setValue(alpha, 1.5, -0.5);
+
+        // small off-diagonal elements keep the solves well conditioned
+        hostA = new T[sizeA];
+        for (size_t i = 0; i < sizeA; i++) {
+            setValue(hostA[i], (((i * 7) % 13) / 13.0 - 0.5) / K,
+                     (((i * 7) % 5) / 5.0 - 0.5) / K);
+        }
+        for (size_t i = 0; i < K; i++) {
+            setValue(hostA[i * lda + i], 1 + ((i * 3) % 7) / 7.0,
+                     ((i * 3) % 5) / 5.0 - 0.5);
+        }
+        hostB = new T[sizeB];
+        for (size_t i = 0; i < sizeB; i++) {
+            setValue(hostB[i], ((i * 11) % 13) / 13.0 - 0.5,
+                     ((i * 11) % 7) / 7.0 - 0.5);
+        }
+
+        A = createBuffer(hostA, sizeA);
+        B = createBuffer(hostB, sizeB);
+    }
+
+    ~TrxmProblem()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        delete[] hostA;
+        delete[] hostB;
+    }
+
+    cl_command_queue *queues() { return &queue; }
+
+    // element (i, j) of op(A), the triangle only
+    HostComplex opA(size_t i, size_t j) const
+    {
+        size_t r = (trans == clblasNoTrans) ? i : j;
+        size_t c = (trans == clblasNoTrans) ? j : i;
+        HostComplex a;
+
+        if ((uplo == clblasLower) ? (r < c) : (r > c)) {
+            return 0;
+        }
+        if ((r == c) && (diag == clblasUnit)) {
+            return 1;
+        }
+        a = value(hostA[(order == clblasColumnMajor) ? c * lda + r : r * lda + c]);
+        return (trans == clblasConjTrans) ? conj(a) : a;
+    }
+
+    size_t indexB(size_t i, size_t j) const
+    {
+        return (order == clblasColumnMajor) ? j * ldb + i : i * ldb + j;
+    }
+
+    // element (i, j) of op(A)*X or X*op(A)
+    HostComplex product(const T *X, size_t i, size_t j) const
+    {
+        HostComplex sum = 0;
+
+        for (size_t k = 0; k < K; k++) {
+            sum += (side == clblasLeft) ?
+                opA(i, k) * value(X[indexB(k, j)]) :
+                value(X[indexB(i, k)]) * opA(k, j);
+        }
+        return sum;
+    }
+
+    void check(bool solve, double tolerance)
+    {
+        T *result = new T[sizeB];
+        HostComplex a = value(alpha);
+
+        ASSERT_EQ(CL_SUCCESS, clEnqueueReadBuffer(queue, B, CL_TRUE, 0,
+            sizeB * sizeof(T), result, 0, NULL, NULL));
+        for (size_t i = 0; i < M; i++) {
+            for (size_t j = 0; j < N; j++) {
+                HostComplex got, ref;
+
+                if (solve) {
+                    got = product(result, i, j);
+                    ref = a * value(hostB[indexB(i, j)]);
+                }
+                else {
+                    got = value(result[indexB(i, j)]);
+                    ref = a * product(hostB, i, j);
+                }
+                ASSERT_NEAR(ref.real(), got.real(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+                ASSERT_NEAR(ref.imag(), got.imag(), tolerance)
+                    << "element (" << i << ", " << j << ")";
+            }
+        }
+        delete[] result;
+    }
+};
+
+static clblasStatus
+trxm(TrxmProblem<float> &p, bool solve, cl_event *event)
+{
+    if (solve) {
+        return clblasStrsm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+            p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasStrmm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+trxm(TrxmProblem<double> &p, bool solve, cl_event *event)
+{
+    if (solve) {
+        return clblasDtrsm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+            p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasDtrmm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+trxm(TrxmProblem<FloatComplex> &p, bool solve, cl_event *event)
+{
+    if (solve) {
+        return clblasCtrsm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+            p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasCtrmm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+}
+
+static clblasStatus
+trxm(TrxmProblem<DoubleComplex> &p, bool solve, cl_event *event)
+{
+    if (solve) {
+        return clblasZtrsm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+            p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+    }
+    return clblasZtrmm(p.order, p.side, p.uplo, p.trans, p.diag, p.M, p.N,
+        p.alpha, p.A, 0, p.lda, p.B, 0, p.ldb, 1, p.queues(), 0, NULL, event);
+}
+
+template <typename T>
+static void
+runTrxm(TrxmProblem<T> &p, bool solve, double tolerance)
+{
+    cl_event event = NULL;
+    clblasStatus status;
+
+    {
+        ScopedEnv threshold("AMD_CLBLAS_TRXM_RECURSIVE", "64");
+
+        status = trxm(p, solve, &event);
+    }
+
+    ASSERT_EQ(clblasSuccess, status);
+    ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    p.check(solve, tolerance);
+}
+
+TEST(TRXM_RECURSIVE, strsmColumnMajorLeftLowerN) {
+    TrxmProblem<float> p(clblasColumnMajor, clblasLeft, clblasLower,
+                         clblasNoTrans, clblasNonUnit, 100, 37);
+    runTrxm(p, true, 1e-4);
+}
+
+TEST(TRXM_RECURSIVE, strsmRowMajorRightUpperTUnit) {
+    TrxmProblem<float> p(clblasRowMajor, clblasRight, clblasUpper,
+                         clblasTrans, clblasUnit, 45, 130);
+    runTrxm(p, true, 1e-4);
+}
+
+TEST(TRXM_RECURSIVE, dtrsmColumnMajorRightLowerN) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    TrxmProblem<double> p(clblasColumnMajor, clblasRight, clblasLower,
+                          clblasNoTrans, clblasNonUnit, 70, 97);
+    runTrxm(p, true, 1e-10);
+}
+
+TEST(TRXM_RECURSIVE, ctrsmColumnMajorLeftUpperC) {
+    TrxmProblem<FloatComplex> p(clblasColumnMajor, clblasLeft, clblasUpper,
+                                clblasConjTrans, clblasNonUnit, 96, 33);
+    runTrxm(p, true, 1e-4);
+}
+
+TEST(TRXM_RECURSIVE, ztrsmRowMajorLeftLowerT) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    TrxmProblem<DoubleComplex> p(clblasRowMajor, clblasLeft, clblasLower,
+                                 clblasTrans, clblasNonUnit, 129, 20);
+    runTrxm(p, true, 1e-10);
+}
+
+TEST(TRXM_RECURSIVE, strmmColumnMajorLeftUpperN) {
+    TrxmProblem<float> p(clblasColumnMajor, clblasLeft, clblasUpper,
+                         clblasNoTrans, clblasNonUnit, 100, 37);
+    runTrxm(p, false, 1e-4);
+}
+
+TEST(TRXM_RECURSIVE, dtrmmRowMajorRightLowerTUnit) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    TrxmProblem<double> p(clblasRowMajor, clblasRight, clblasLower,
+                          clblasTrans, clblasUnit, 50, 90);
+    runTrxm(p, false, 1e-10);
+}
+
+TEST(TRXM_RECURSIVE, ctrmmColumnMajorRightUpperC) {
+    TrxmProblem<FloatComplex> p(clblasColumnMajor, clblasRight, clblasUpper,
+                                clblasConjTrans, clblasNonUnit, 40, 77);
+    runTrxm(p, false, 1e-4);
+}
+
+TEST(TRXM_RECURSIVE, ztrmmColumnMajorLeftLowerC) {
+    if (skipDouble()) {
+        SUCCEED();
+        return;
+    }
+
+    TrxmProblem<DoubleComplex> p(clblasColumnMajor, clblasLeft, clblasLower,
+                                 clblasConjTrans, clblasNonUnit, 65, 64);
+    runTrxm(p, false, 1e-10);
+}
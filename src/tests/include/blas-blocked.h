@@ -0,0 +1,95 @@
+/* ************************************************************************
+ * Copyright 2014 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Cache blocked, multithreaded reference for the routines dominating the
+ * reference time of the tests. It replaces the reference library for them
+ * when the tests are built with CORR_TEST_WITH_BLOCKED_REF.
+ *
+ * Like the reference library, the functions take column major matrices
+ * only. They are defined for float, double, FloatComplex and
+ * DoubleComplex. The number of threads is the number of processors, or
+ * the value of the CLBLAS_TEST_REF_THREADS environment variable.
+ */
+
+#ifndef BLAS_BLOCKED_H_
+#define BLAS_BLOCKED_H_
+
+#include <clBLAS.h>
+
+template <typename T> void
+blockedGemv(
+    clblasOrder order,
+    clblasTranspose transA,
+    size_t M,
+    size_t N,
+    T alpha,
+    const T *A,
+    size_t lda,
+    const T *X,
+    int incx,
+    T beta,
+    T *Y,
+    int incy);
+
+template <typename T> void
+blockedGemm(
+    clblasOrder order,
+    clblasTranspose transA,
+    clblasTranspose transB,
+    size_t M,
+    size_t N,
+    size_t K,
+    T alpha,
+    const T *A,
+    size_t lda,
+    const T *B,
+    size_t ldb,
+    T beta,
+    T *C,
+    size_t ldc);
+
+template <typename T> void
+blockedTrsm(
+    clblasOrder order,
+    clblasSide side,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    clblasDiag diag,
+    size_t M,
+    size_t N,
+    T alpha,
+    const T *A,
+    size_t lda,
+    T *B,
+    size_t ldb);
+
+template <typename T> void
+blockedSyrk(
+    clblasOrder order,
+    clblasUplo uplo,
+    clblasTranspose transA,
+    size_t N,
+    size_t K,
+    T alpha,
+    const T *A,
+    size_t lda,
+    T beta,
+    T *C,
+    size_t ldc);
+
+#endif  /* BLAS_BLOCKED_H_ */
@@ -0,0 +1,179 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * CPU GEMM performance test: SGEMM and DGEMM on a CPU device (PoCL, Intel)
+ * with the register-blocked CPU kernels and with the GPU kernels staging
+ * through local memory. Run with --device cpu.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define CPU_PERF_RUNS 5
+
+static const char *cpuKernelModes[] = { "1", "0" };
+static const char *cpuKernelModeName[] = { "registers", "local memory" };
+
+static bool
+isCPUDevice(void)
+{
+    cl_command_queue queue = BlasBase::getInstance()->commandQueues()[0];
+    cl_device_id device;
+    cl_device_type type = 0;
+
+    clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, NULL);
+
+    return (type & CL_DEVICE_TYPE_CPU) != 0;
+}
+
+template <typename T>
+class CPUGemmPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+
+public:
+    size_t N;
+    cl_mem A, B, C;
+
+    CPUGemmPerf(size_t N_) : N(N_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        A = buffer(N * N);
+        B = buffer(N * N);
+        C = buffer(N * N);
+    }
+
+    ~CPUGemmPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+    }
+
+    cl_mem buffer(size_t nElems)
+    {
+        cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE,
+                                    nElems * sizeof(T), NULL, NULL);
+        const T one = 1;
+
+        clEnqueueFillBuffer(queue, mem, &one, sizeof(one), 0,
+                            nElems * sizeof(T), 0, NULL, NULL);
+        return mem;
+    }
+
+    cl_int gemm(cl_event *event);
+
+    cl_int run(void)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = gemm(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+            clReleaseEvent(event);
+        }
+        return err;
+    }
+};
+
+template <>
+cl_int
+CPUGemmPerf<cl_float>::gemm(cl_event *event)
+{
+    return clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        N, N, N, 1.0f, A, 0, N, B, 0, N, 0.0f, C, 0, N,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int
+CPUGemmPerf<cl_double>::gemm(cl_event *event)
+{
+    return clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        N, N, N, 1.0, A, 0, N, B, 0, N, 0.0, C, 0, N,
+        1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static void
+runCPUGemmPerf(const char *name, size_t N)
+{
+    static char env[64];
+
+    if (!isCPUDevice()) {
+        std::cerr << ">> WARNING: The target device is not a CPU" <<
+                     std::endl << ">> Test skipped" << std::endl;
+        return;
+    }
+
+    CPUGemmPerf<T> perf(N);
+
+    for (int mode = 0; mode < 2; mode++) {
+        nano_time_t time;
+
+        sprintf(env, "AMD_CLBLAS_GEMM_CPU_KERNELS=%s", cpuKernelModes[mode]);
+        putenv(env);
+
+        // build kernels before timing
+        ASSERT_EQ(CL_SUCCESS, perf.run());
+
+        time = getCurrentTime();
+        for (int i = 0; i < CPU_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, perf.run());
+        }
+        time = (getCurrentTime() - time) / CPU_PERF_RUNS;
+
+        printf("%s %-12s %4lu: %.3f ms, %.1f GFLOPS\n", name,
+               cpuKernelModeName[mode], (unsigned long)N,
+               conv2nanosec(time) / 1e6,
+               2.0 * N * N * N / conv2nanosec(time));
+    }
+    putenv((char*)"AMD_CLBLAS_GEMM_CPU_KERNELS=1");
+}
+
+TEST(GEMM_CPU, perfSgemm) {
+    runCPUGemmPerf<cl_float>("sgemm", 256);
+    runCPUGemmPerf<cl_float>("sgemm", 1024);
+}
+
+TEST(GEMM_CPU, perfDgemm) {
+    if (!BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        std::cerr << ">> WARNING: The target device doesn't support native "
+                     "double precision floating point arithmetic" <<
+                     std::endl << ">> Test skipped" << std::endl;
+        return;
+    }
+    runCPUGemmPerf<cl_double>("dgemm", 256);
+    runCPUGemmPerf<cl_double>("dgemm", 1024);
+}
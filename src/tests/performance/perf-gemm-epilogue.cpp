@@ -0,0 +1,203 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Fused GEMM epilogue performance test: SGEMM with bias and ReLU applied
+ * while C is written, against SGEMM followed by a separate bias and ReLU
+ * kernel which reads and writes C once more.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define EPILOGUE_PERF_RUNS 10
+
+static const char *biasReluSource =
+"__kernel void biasRelu(__global float *C, __global const float *bias,\n"
+"                       uint M, uint ldc)\n"
+"{\n"
+"    size_t i = get_global_id(0);\n"
+"    size_t j = get_global_id(1);\n"
+"    if (i < M) {\n"
+"        float x = C[j * ldc + i] + bias[i];\n"
+"        C[j * ldc + i] = fmax(x, 0.0f);\n"
+"    }\n"
+"}\n";
+
+class GemmEpiloguePerf
+{
+    cl_context context;
+    cl_command_queue queue;
+    cl_program program;
+    cl_kernel kernel;
+
+public:
+    size_t M, N, K;
+    cl_mem A, B, C, bias;
+    clblasEpilogue epilogue;
+
+    GemmEpiloguePerf(size_t M_, size_t N_, size_t K_) :
+        program(NULL), kernel(NULL), M(M_), N(N_), K(K_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+        cl_device_id device;
+        cl_int err;
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        A = buffer(M * K);
+        B = buffer(K * N);
+        C = buffer(M * N);
+        bias = buffer(M);
+
+        memset(&epilogue, 0, sizeof(epilogue));
+        epilogue.biasMode = clblasEpiloguePerRow;
+        epilogue.bias = bias;
+        epilogue.activation = clblasActivationReLU;
+
+        clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device),
+                              &device, NULL);
+        program = clCreateProgramWithSource(context, 1, &biasReluSource,
+                                            NULL, &err);
+        if (err == CL_SUCCESS &&
+            clBuildProgram(program, 1, &device, NULL, NULL, NULL) == CL_SUCCESS) {
+            kernel = clCreateKernel(program, "biasRelu", &err);
+        }
+    }
+
+    ~GemmEpiloguePerf()
+    {
+        if (kernel != NULL) {
+            clReleaseKernel(kernel);
+        }
+        if (program != NULL) {
+            clReleaseProgram(program);
+        }
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+        clReleaseMemObject(bias);
+    }
+
+    cl_mem buffer(size_t nElems)
+    {
+        cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE,
+                                    nElems * sizeof(cl_float), NULL, NULL);
+        const cl_float zero = 0;
+
+        clEnqueueFillBuffer(queue, mem, &zero, sizeof(zero), 0,
+                            nElems * sizeof(cl_float), 0, NULL, NULL);
+        return mem;
+    }
+
+    bool hasKernel() const { return kernel != NULL; }
+
+    cl_int fused(void)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = clblasSgemmEx(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+            M, N, K, 1.0f, A, 0, M, B, 0, K, 1.0f, C, 0, M, &epilogue,
+            1, &queue, 0, NULL, &event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+
+    cl_int separate(void)
+    {
+        cl_event event = NULL;
+        cl_uint m = static_cast<cl_uint>(M);
+        cl_uint ldc = static_cast<cl_uint>(M);
+        size_t globalWorkSize[2] = { ((M + 63) / 64) * 64, N };
+        size_t localWorkSize[2] = { 64, 1 };
+        cl_int err;
+
+        err = clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+            M, N, K, 1.0f, A, 0, M, B, 0, K, 1.0f, C, 0, M,
+            1, &queue, 0, NULL, &event);
+        if (err != CL_SUCCESS) {
+            return err;
+        }
+
+        clSetKernelArg(kernel, 0, sizeof(cl_mem), &C);
+        clSetKernelArg(kernel, 1, sizeof(cl_mem), &bias);
+        clSetKernelArg(kernel, 2, sizeof(cl_uint), &m);
+        clSetKernelArg(kernel, 3, sizeof(cl_uint), &ldc);
+        err = clEnqueueNDRangeKernel(queue, kernel, 2, NULL, globalWorkSize,
+            localWorkSize, 1, &event, NULL);
+        if (err == CL_SUCCESS) {
+            err = clFinish(queue);
+        }
+        return err;
+    }
+};
+
+/*
+ * Bytes of C moved: beta is nonzero, so GEMM reads and writes C once; the
+ * separate kernel reads and writes it again.
+ */
+static void
+runEpiloguePerf(size_t M, size_t N, size_t K)
+{
+    GemmEpiloguePerf perf(M, N, K);
+    nano_time_t fusedTime, separateTime;
+    double bytesC = 2.0 * M * N * sizeof(cl_float);
+
+    ASSERT_TRUE(perf.hasKernel());
+
+    // build kernels before timing
+    ASSERT_EQ(CL_SUCCESS, perf.fused());
+    ASSERT_EQ(CL_SUCCESS, perf.separate());
+
+    fusedTime = getCurrentTime();
+    for (int i = 0; i < EPILOGUE_PERF_RUNS; i++) {
+        ASSERT_EQ(CL_SUCCESS, perf.fused());
+    }
+    fusedTime = (getCurrentTime() - fusedTime) / EPILOGUE_PERF_RUNS;
+
+    separateTime = getCurrentTime();
+    for (int i = 0; i < EPILOGUE_PERF_RUNS; i++) {
+        ASSERT_EQ(CL_SUCCESS, perf.separate());
+    }
+    separateTime = (getCurrentTime() - separateTime) / EPILOGUE_PERF_RUNS;
+
+    printf("sgemm %lux%lux%lu, bias+ReLU: fused %.3f ms, %.1f MB of C; "
+           "separate %.3f ms, %.1f MB of C\n",
+           (unsigned long)M, (unsigned long)N, (unsigned long)K,
+           conv2nanosec(fusedTime) / 1e6, bytesC / 1e6,
+           conv2nanosec(separateTime) / 1e6, 2 * bytesC / 1e6);
+}
+
+TEST(GEMM_EPILOGUE, perfShortK) {
+    runEpiloguePerf(4096, 4096, 64);
+}
+
+TEST(GEMM_EPILOGUE, perfSquare) {
+    runEpiloguePerf(2048, 2048, 2048);
+}
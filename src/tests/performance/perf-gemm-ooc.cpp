@@ -0,0 +1,109 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Out-of-core GEMM performance test: SGEMM on host matrices streamed
+ * through a 256 MB device budget with one and two command queues, against
+ * the in-core SGEMM on matrices already in device memory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define OOC_PERF_RUNS 3
+
+static void
+runOutOfCorePerf(size_t M, size_t N, size_t K)
+{
+    BlasBase *base = BlasBase::getInstance();
+    cl_context context = base->context();
+    cl_command_queue *queues = base->commandQueues();
+    cl_float *A = new cl_float[M * K];
+    cl_float *B = new cl_float[K * N];
+    cl_float *C = new cl_float[M * N];
+    cl_mem bufA, bufB, bufC;
+    cl_event event = NULL;
+    nano_time_t time;
+
+    for (size_t i = 0; i < M * K; i++) A[i] = (cl_float)(i % 13) / 13;
+    for (size_t i = 0; i < K * N; i++) B[i] = (cl_float)(i % 11) / 11;
+
+    // in-core reference, matrices already on the device
+    bufA = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                          M * K * sizeof(cl_float), A, NULL);
+    bufB = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                          K * N * sizeof(cl_float), B, NULL);
+    bufC = clCreateBuffer(context, CL_MEM_READ_WRITE,
+                          M * N * sizeof(cl_float), NULL, NULL);
+    if (bufA != NULL && bufB != NULL && bufC != NULL) {
+        for (int i = 0; i <= OOC_PERF_RUNS; i++) {
+            // the first run builds the kernels
+            if (i == 1) {
+                time = getCurrentTime();
+            }
+            ASSERT_EQ(CL_SUCCESS, clblasSgemm(clblasColumnMajor,
+                clblasNoTrans, clblasNoTrans, M, N, K, 1.0f, bufA, 0, M,
+                bufB, 0, K, 0.0f, bufC, 0, M, 1, queues, 0, NULL, &event));
+            ASSERT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+            clReleaseEvent(event);
+        }
+        time = (getCurrentTime() - time) / OOC_PERF_RUNS;
+        printf("in-core        %lux%lux%lu: %.3f ms, %.1f GFLOPS\n",
+               (unsigned long)M, (unsigned long)N, (unsigned long)K,
+               conv2nanosec(time) / 1e6,
+               2.0 * M * N * K / conv2nanosec(time));
+    }
+    if (bufA != NULL) clReleaseMemObject(bufA);
+    if (bufB != NULL) clReleaseMemObject(bufB);
+    if (bufC != NULL) clReleaseMemObject(bufC);
+
+    putenv((char*)"AMD_CLBLAS_GEMM_OOC_MB=256");
+    for (cl_uint numQueues = 1; numQueues <= 2; numQueues++) {
+        if (numQueues > base->numCommandQueues()) {
+            break;
+        }
+        time = getCurrentTime();
+        for (int i = 0; i < OOC_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, clblasSgemmOutOfCore(clblasColumnMajor,
+                clblasNoTrans, clblasNoTrans, M, N, K, 1.0f, A, M, B, K,
+                0.0f, C, M, numQueues, queues, 0, NULL));
+        }
+        time = (getCurrentTime() - time) / OOC_PERF_RUNS;
+        printf("out-of-core x%u %lux%lux%lu: %.3f ms, %.1f GFLOPS\n",
+               numQueues,
+               (unsigned long)M, (unsigned long)N, (unsigned long)K,
+               conv2nanosec(time) / 1e6,
+               2.0 * M * N * K / conv2nanosec(time));
+    }
+    putenv((char*)"AMD_CLBLAS_GEMM_OOC_MB=0");
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+}
+
+TEST(GEMM_OUT_OF_CORE, perfSquare) {
+    runOutOfCorePerf(8192, 8192, 8192);
+}
@@ -0,0 +1,204 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Strassen-Winograd GEMM performance test: SGEMM and DGEMM with one and two
+ * Strassen levels against the standard algorithm. Besides the time, the
+ * largest difference to the standard result relative to its largest
+ * element is reported, as the error bound gets weaker with every level.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define STRASSEN_PERF_RUNS 3
+#define STRASSEN_PERF_SIZE 8192
+
+/* Thresholds for the standard algorithm, one and two Strassen levels */
+static const char *strassenModes[] = {
+    "AMD_CLBLAS_GEMM_STRASSEN=0",
+    "AMD_CLBLAS_GEMM_STRASSEN=8192",
+    "AMD_CLBLAS_GEMM_STRASSEN=4096"
+};
+
+template <typename T>
+class StrassenPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+    T *hostA, *hostB;
+
+public:
+    size_t M, N, K;
+    cl_mem A, B, C;
+
+    StrassenPerf(size_t M_, size_t N_, size_t K_) : M(M_), N(N_), K(K_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        hostA = fill(M * K, 7);
+        hostB = fill(K * N, 11);
+        A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           M * K * sizeof(T), hostA, NULL);
+        B = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           K * N * sizeof(T), hostB, NULL);
+        C = clCreateBuffer(context, CL_MEM_READ_WRITE, M * N * sizeof(T),
+                           NULL, NULL);
+    }
+
+    ~StrassenPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+        delete[] hostA;
+        delete[] hostB;
+    }
+
+    T* fill(size_t nElems, size_t seed)
+    {
+        T *data = new T[nElems];
+
+        for (size_t i = 0; i < nElems; i++) {
+            data[i] = T((i * seed) % 13) / T(13) - T(0.5);
+        }
+        return data;
+    }
+
+    cl_int gemm(cl_event *event);
+
+    cl_int run(int mode)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        putenv((char*)strassenModes[mode]);
+        err = gemm(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        putenv((char*)strassenModes[0]);
+        return err;
+    }
+
+    void readC(T *result)
+    {
+        clEnqueueReadBuffer(queue, C, CL_TRUE, 0, M * N * sizeof(T), result,
+                            0, NULL, NULL);
+    }
+};
+
+template <>
+cl_int StrassenPerf<float>::gemm(cl_event *event)
+{
+    return clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        M, N, K, 1.0f, A, 0, M, B, 0, K, 0.0f, C, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int StrassenPerf<double>::gemm(cl_event *event)
+{
+    return clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        M, N, K, 1.0, A, 0, M, B, 0, K, 0.0, C, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static void
+runStrassenPerf(const char *name, size_t M, size_t N, size_t K)
+{
+    StrassenPerf<T> perf(M, N, K);
+    nano_time_t time[3];
+    T *result[3];
+    double maxElem = 0;
+
+    for (int mode = 0; mode < 3; mode++) {
+        // build kernels before timing
+        ASSERT_EQ(CL_SUCCESS, perf.run(mode));
+
+        time[mode] = getCurrentTime();
+        for (int i = 0; i < STRASSEN_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, perf.run(mode));
+        }
+        time[mode] = (getCurrentTime() - time[mode]) / STRASSEN_PERF_RUNS;
+
+        result[mode] = new T[M * N];
+        perf.readC(result[mode]);
+    }
+
+    for (size_t i = 0; i < M * N; i++) {
+        double elem = fabs((double)result[0][i]);
+
+        maxElem = (elem > maxElem) ? elem : maxElem;
+    }
+
+    // effective GFLOPS count the 2*M*N*K flops of the standard algorithm
+    printf("%s %lux%lux%lu: standard %.3f ms, %.1f GFLOPS\n", name,
+           (unsigned long)M, (unsigned long)N, (unsigned long)K,
+           conv2nanosec(time[0]) / 1e6,
+           2.0 * M * N * K / conv2nanosec(time[0]));
+    for (int mode = 1; mode < 3; mode++) {
+        double maxDiff = 0;
+
+        for (size_t i = 0; i < M * N; i++) {
+            double diff = fabs((double)result[mode][i] - result[0][i]);
+
+            maxDiff = (diff > maxDiff) ? diff : maxDiff;
+        }
+        printf("%s %lux%lux%lu: %d Strassen level(s) %.3f ms, "
+               "%.1f effective GFLOPS; relative difference %.2e\n", name,
+               (unsigned long)M, (unsigned long)N, (unsigned long)K, mode,
+               conv2nanosec(time[mode]) / 1e6,
+               2.0 * M * N * K / conv2nanosec(time[mode]),
+               (maxElem > 0) ? maxDiff / maxElem : maxDiff);
+    }
+
+    for (int mode = 0; mode < 3; mode++) {
+        delete[] result[mode];
+    }
+}
+
+TEST(GEMM_STRASSEN, perfSgemm) {
+    runStrassenPerf<float>("sgemm", STRASSEN_PERF_SIZE, STRASSEN_PERF_SIZE,
+                           STRASSEN_PERF_SIZE);
+}
+
+TEST(GEMM_STRASSEN, perfDgemm) {
+    if (!BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    runStrassenPerf<double>("dgemm", STRASSEN_PERF_SIZE, STRASSEN_PERF_SIZE,
+                            STRASSEN_PERF_SIZE);
+}
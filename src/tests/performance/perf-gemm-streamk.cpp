@@ -0,0 +1,129 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Stream-K GEMM performance test: SGEMM on mid-size shapes with the
+ * Stream-K path disabled, chosen by its heuristic and forced.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define STREAMK_PERF_RUNS 10
+
+static const char *streamKModes[] = { "0", "-1", "1" };
+static const char *streamKModeName[] = { "tiles", "heuristic", "stream-k" };
+
+class StreamKPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+
+public:
+    size_t M, N, K;
+    cl_mem A, B, C;
+
+    StreamKPerf(size_t M_, size_t N_, size_t K_) : M(M_), N(N_), K(K_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        A = buffer(M * K);
+        B = buffer(K * N);
+        C = buffer(M * N);
+    }
+
+    ~StreamKPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+    }
+
+    cl_mem buffer(size_t nElems)
+    {
+        cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE,
+                                    nElems * sizeof(cl_float), NULL, NULL);
+        const cl_float zero = 0;
+
+        clEnqueueFillBuffer(queue, mem, &zero, sizeof(zero), 0,
+                            nElems * sizeof(cl_float), 0, NULL, NULL);
+        return mem;
+    }
+
+    cl_int run(void)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+            M, N, K, 1.0f, A, 0, M, B, 0, K, 0.0f, C, 0, M,
+            1, &queue, 0, NULL, &event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+};
+
+static void
+runStreamKPerf(size_t M, size_t N, size_t K)
+{
+    StreamKPerf perf(M, N, K);
+    static char env[64];
+
+    for (int mode = 0; mode < 3; mode++) {
+        nano_time_t time;
+
+        sprintf(env, "AMD_CLBLAS_GEMM_STREAMK=%s", streamKModes[mode]);
+        putenv(env);
+
+        // build kernels before timing
+        ASSERT_EQ(CL_SUCCESS, perf.run());
+
+        time = getCurrentTime();
+        for (int i = 0; i < STREAMK_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, perf.run());
+        }
+        time = (getCurrentTime() - time) / STREAMK_PERF_RUNS;
+
+        printf("%-10s %lux%lux%lu: %.3f ms, %.1f GFLOPS\n",
+               streamKModeName[mode],
+               (unsigned long)M, (unsigned long)N, (unsigned long)K,
+               conv2nanosec(time) / 1e6,
+               2.0 * M * N * K / conv2nanosec(time));
+    }
+    putenv((char*)"AMD_CLBLAS_GEMM_STREAMK=-1");
+}
+
+TEST(GEMM_STREAMK, perfMidSize) {
+    runStreamKPerf(1056, 1056, 2048);
+}
+
+TEST(GEMM_STREAMK, perfTall) {
+    runStreamKPerf(2080, 544, 4096);
+}
@@ -0,0 +1,191 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * 3M complex GEMM performance test: CGEMM and ZGEMM with the 3M method
+ * against the direct complex kernels. Besides the time, the largest
+ * difference between both results relative to the largest element of the
+ * direct one is reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define GEMM3M_PERF_RUNS 5
+
+template <typename T>
+class Gemm3MPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+    T *hostA, *hostB;
+
+public:
+    size_t M, N, K;
+    cl_mem A, B, C;
+
+    Gemm3MPerf(size_t M_, size_t N_, size_t K_) : M(M_), N(N_), K(K_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        hostA = fill(M * K, 7);
+        hostB = fill(K * N, 11);
+        A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           M * K * sizeof(T), hostA, NULL);
+        B = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           K * N * sizeof(T), hostB, NULL);
+        C = clCreateBuffer(context, CL_MEM_READ_WRITE, M * N * sizeof(T),
+                           NULL, NULL);
+    }
+
+    ~Gemm3MPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+        delete[] hostA;
+        delete[] hostB;
+    }
+
+    T* fill(size_t nElems, size_t seed)
+    {
+        T *data = new T[nElems];
+
+        for (size_t i = 0; i < nElems; i++) {
+            data[i].s[0] = ((i * seed) % 13) / 13.0 - 0.5;
+            data[i].s[1] = ((i * seed) % 7) / 7.0 - 0.5;
+        }
+        return data;
+    }
+
+    cl_int gemm(cl_event *event);
+
+    cl_int run(bool use3M)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        putenv(use3M ? (char*)"AMD_CLBLAS_GEMM_3M=1"
+                     : (char*)"AMD_CLBLAS_GEMM_3M=0");
+        err = gemm(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        putenv((char*)"AMD_CLBLAS_GEMM_3M=0");
+        return err;
+    }
+
+    void readC(T *result)
+    {
+        clEnqueueReadBuffer(queue, C, CL_TRUE, 0, M * N * sizeof(T), result,
+                            0, NULL, NULL);
+    }
+};
+
+template <>
+cl_int Gemm3MPerf<FloatComplex>::gemm(cl_event *event)
+{
+    FloatComplex alpha = floatComplex(1, 0);
+    FloatComplex beta = floatComplex(0, 0);
+
+    return clblasCgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        M, N, K, alpha, A, 0, M, B, 0, K, beta, C, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int Gemm3MPerf<DoubleComplex>::gemm(cl_event *event)
+{
+    DoubleComplex alpha = doubleComplex(1, 0);
+    DoubleComplex beta = doubleComplex(0, 0);
+
+    return clblasZgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+        M, N, K, alpha, A, 0, M, B, 0, K, beta, C, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static void
+runGemm3MPerf(const char *name, size_t M, size_t N, size_t K)
+{
+    Gemm3MPerf<T> perf(M, N, K);
+    nano_time_t time[2];
+    T *result[2];
+    double maxDiff = 0, maxElem = 0;
+
+    for (int use3M = 0; use3M < 2; use3M++) {
+        // build kernels before timing
+        ASSERT_EQ(CL_SUCCESS, perf.run(use3M != 0));
+
+        time[use3M] = getCurrentTime();
+        for (int i = 0; i < GEMM3M_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, perf.run(use3M != 0));
+        }
+        time[use3M] = (getCurrentTime() - time[use3M]) / GEMM3M_PERF_RUNS;
+
+        result[use3M] = new T[M * N];
+        perf.readC(result[use3M]);
+    }
+
+    for (size_t i = 0; i < M * N; i++) {
+        for (int part = 0; part < 2; part++) {
+            double direct = result[0][i].s[part];
+            double diff = fabs(result[1][i].s[part] - direct);
+
+            maxDiff = (diff > maxDiff) ? diff : maxDiff;
+            maxElem = (fabs(direct) > maxElem) ? fabs(direct) : maxElem;
+        }
+    }
+    delete[] result[0];
+    delete[] result[1];
+
+    // 8 real flops per complex multiply-add of the direct method
+    printf("%s %lux%lux%lu: direct %.3f ms, %.1f GFLOPS; 3M %.3f ms, "
+           "%.1f effective GFLOPS; relative difference %.2e\n", name,
+           (unsigned long)M, (unsigned long)N, (unsigned long)K,
+           conv2nanosec(time[0]) / 1e6, 8.0 * M * N * K / conv2nanosec(time[0]),
+           conv2nanosec(time[1]) / 1e6, 8.0 * M * N * K / conv2nanosec(time[1]),
+           (maxElem > 0) ? maxDiff / maxElem : maxDiff);
+}
+
+TEST(GEMM_3M, perfCgemm) {
+    runGemm3MPerf<FloatComplex>("cgemm", 4096, 4096, 4096);
+}
+
+TEST(GEMM_3M, perfZgemm) {
+    if (!BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    runGemm3MPerf<DoubleComplex>("zgemm", 4096, 4096, 4096);
+}
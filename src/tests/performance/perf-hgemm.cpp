@@ -0,0 +1,149 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Half and mixed precision GEMM performance test: HGEMM and GEMMEX with
+ * half inputs and a float result, against SGEMM of the same size.
+ */
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define HGEMM_PERF_RUNS 10
+
+enum HalfGemmKind {
+    HALF_GEMM_SGEMM,
+    HALF_GEMM_HGEMM,
+    HALF_GEMM_MIXED
+};
+
+static const char *halfGemmKindName[] = { "sgemm", "hgemm", "gemmEx h/h/f" };
+
+class HalfGemmPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+
+public:
+    size_t M, N, K;
+    HalfGemmKind kind;
+    cl_mem A, B, C;
+
+    HalfGemmPerf(HalfGemmKind kind_, size_t M_, size_t N_, size_t K_) :
+        M(M_), N(N_), K(K_), kind(kind_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+        size_t sizeAB = (kind == HALF_GEMM_SGEMM) ? sizeof(cl_float)
+                                                  : sizeof(cl_half);
+        size_t sizeC = (kind == HALF_GEMM_HGEMM) ? sizeof(cl_half)
+                                                 : sizeof(cl_float);
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        A = buffer(M * K * sizeAB);
+        B = buffer(K * N * sizeAB);
+        C = buffer(M * N * sizeC);
+    }
+
+    ~HalfGemmPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        clReleaseMemObject(C);
+    }
+
+    cl_mem buffer(size_t size)
+    {
+        cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE, size,
+                                    NULL, NULL);
+        const cl_uchar zero = 0;
+
+        clEnqueueFillBuffer(queue, mem, &zero, sizeof(zero), 0, size,
+                            0, NULL, NULL);
+        return mem;
+    }
+
+    cl_int run(void)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        switch (kind) {
+        case HALF_GEMM_SGEMM:
+            err = clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                M, N, K, 1.0f, A, 0, M, B, 0, K, 1.0f, C, 0, M,
+                1, &queue, 0, NULL, &event);
+            break;
+        case HALF_GEMM_HGEMM:
+            err = clblasHgemm(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                M, N, K, 1.0f, A, 0, M, B, 0, K, 1.0f, C, 0, M,
+                1, &queue, 0, NULL, &event);
+            break;
+        default:
+            err = clblasGemmEx(clblasColumnMajor, clblasNoTrans, clblasNoTrans,
+                M, N, K, 1.0f, A, 0, M, B, 0, K, 1.0f, C, 0, M,
+                clblasDataHalf, clblasDataFloat,
+                1, &queue, 0, NULL, &event);
+            break;
+        }
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+};
+
+static void
+runHalfGemmPerf(size_t M, size_t N, size_t K)
+{
+    for (int kind = HALF_GEMM_SGEMM; kind <= HALF_GEMM_MIXED; kind++) {
+        HalfGemmPerf perf((HalfGemmKind)kind, M, N, K);
+        nano_time_t time;
+        double gflops;
+
+        // build kernels before timing
+        ASSERT_EQ(CL_SUCCESS, perf.run());
+
+        time = getCurrentTime();
+        for (int i = 0; i < HGEMM_PERF_RUNS; i++) {
+            ASSERT_EQ(CL_SUCCESS, perf.run());
+        }
+        time = (getCurrentTime() - time) / HGEMM_PERF_RUNS;
+
+        gflops = 2.0 * M * N * K / conv2nanosec(time);
+        printf("%-12s %lux%lux%lu: %.3f ms, %.1f GFLOPS\n",
+               halfGemmKindName[kind],
+               (unsigned long)M, (unsigned long)N, (unsigned long)K,
+               conv2nanosec(time) / 1e6, gflops);
+    }
+}
+
+TEST(HGEMM, perfSquare) {
+    runHalfGemmPerf(2048, 2048, 2048);
+}
+
+TEST(HGEMM, perfLarge) {
+    runHalfGemmPerf(4096, 4096, 4096);
+}
@@ -0,0 +1,221 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Host path latency test: small SGEMM, SGEMV, SDOT, SAXPY and SSCAL calls
+ * timed from the call to the completion of the event, on the device and
+ * on the host. The sizes where the host wins give the thresholds to set in
+ * the AMD_CLBLAS_*_HOST_THRESHOLD variables.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+extern "C" void hostPathSetup(void);
+
+#define HOST_PERF_RUNS 100
+
+static const char *thresholdVars[] = {
+    "AMD_CLBLAS_GEMM_HOST_THRESHOLD",
+    "AMD_CLBLAS_GEMV_HOST_THRESHOLD",
+    "AMD_CLBLAS_DOT_HOST_THRESHOLD",
+    "AMD_CLBLAS_AXPY_HOST_THRESHOLD",
+    "AMD_CLBLAS_SCAL_HOST_THRESHOLD"
+};
+
+static const char *hostPathModes[] = { "0", "100000000" };
+static const char *hostPathModeName[] = { "device", "host" };
+
+static void
+setThresholds(const char *value)
+{
+    for (size_t i = 0; i < sizeof(thresholdVars) / sizeof(thresholdVars[0]); i++) {
+        setenv(thresholdVars[i], value, 1);
+    }
+    hostPathSetup();
+}
+
+static bool
+hostPathAvailable(void)
+{
+    cl_command_queue queue = BlasBase::getInstance()->commandQueues()[0];
+    cl_device_id device;
+    cl_device_type type = 0;
+    cl_bool unified = CL_FALSE;
+
+    clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(device), &device, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(type), &type, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified),
+                    &unified, NULL);
+
+    if ((type & CL_DEVICE_TYPE_CPU) || (unified == CL_TRUE)) {
+        return true;
+    }
+    std::cerr << ">> WARNING: The target device shares no memory with "
+                 "the host" << std::endl << ">> Test skipped" << std::endl;
+    return false;
+}
+
+class HostPathPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+
+public:
+    size_t N;
+    cl_mem A, X, Y, R, scratch;
+
+    HostPathPerf(size_t N_) : N(N_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        A = buffer(N * N);
+        X = buffer(N);
+        Y = buffer(N);
+        R = buffer(1);
+        scratch = buffer(N);
+    }
+
+    ~HostPathPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(X);
+        clReleaseMemObject(Y);
+        clReleaseMemObject(R);
+        clReleaseMemObject(scratch);
+    }
+
+    cl_mem buffer(size_t nElems)
+    {
+        cl_mem mem = clCreateBuffer(context, CL_MEM_READ_WRITE,
+                                    nElems * sizeof(cl_float), NULL, NULL);
+        const cl_float one = 1;
+
+        clEnqueueFillBuffer(queue, mem, &one, sizeof(one), 0,
+                            nElems * sizeof(cl_float), 0, NULL, NULL);
+        return mem;
+    }
+
+    // GEMM uses A as all of its three N x N matrices
+    clblasStatus call(const char *func, cl_event *event)
+    {
+        switch (func[1]) {
+        case 'g':
+            if (func[3] == 'm') {
+                return clblasSgemm(clblasColumnMajor, clblasNoTrans,
+                    clblasNoTrans, N, N, N, 1.0f, A, 0, N, A, 0, N, 0.0f,
+                    A, 0, N, 1, &queue, 0, NULL, event);
+            }
+            return clblasSgemv(clblasColumnMajor, clblasNoTrans, N, N, 1.0f,
+                A, 0, N, X, 0, 1, 0.0f, Y, 0, 1, 1, &queue, 0, NULL, event);
+        case 'd':
+            return clblasSdot(N, R, 0, X, 0, 1, Y, 0, 1, scratch,
+                1, &queue, 0, NULL, event);
+        case 'a':
+            return clblasSaxpy(N, 1.0f, X, 0, 1, Y, 0, 1,
+                1, &queue, 0, NULL, event);
+        default:
+            return clblasSscal(N, 1.0f, X, 0, 1, 1, &queue, 0, NULL, event);
+        }
+    }
+
+    clblasStatus run(const char *func)
+    {
+        cl_event event = NULL;
+        clblasStatus status;
+
+        status = call(func, &event);
+        if (status == clblasSuccess) {
+            status = (clblasStatus)clWaitForEvents(1, &event);
+            clReleaseEvent(event);
+        }
+        return status;
+    }
+};
+
+static void
+runHostPathPerf(const char *func, const size_t *sizes, size_t nrSizes)
+{
+    if (!hostPathAvailable()) {
+        return;
+    }
+
+    for (size_t s = 0; s < nrSizes; s++) {
+        HostPathPerf perf(sizes[s]);
+
+        for (int mode = 0; mode < 2; mode++) {
+            nano_time_t time;
+
+            setThresholds(hostPathModes[mode]);
+
+            // build kernels before timing
+            ASSERT_EQ(clblasSuccess, perf.run(func));
+
+            time = getCurrentTime();
+            for (int i = 0; i < HOST_PERF_RUNS; i++) {
+                ASSERT_EQ(clblasSuccess, perf.run(func));
+            }
+            time = (getCurrentTime() - time) / HOST_PERF_RUNS;
+
+            printf("%s %-6s %5lu: %.1f us\n", func, hostPathModeName[mode],
+                   (unsigned long)sizes[s], conv2nanosec(time) / 1e3);
+        }
+    }
+    setThresholds("0");
+}
+
+TEST(HOST_PATH, perfSgemm) {
+    const size_t sizes[] = { 8, 16, 32, 64 };
+
+    runHostPathPerf("sgemm", sizes, sizeof(sizes) / sizeof(sizes[0]));
+}
+
+TEST(HOST_PATH, perfSgemv) {
+    const size_t sizes[] = { 16, 64, 256 };
+
+    runHostPathPerf("sgemv", sizes, sizeof(sizes) / sizeof(sizes[0]));
+}
+
+TEST(HOST_PATH, perfSdot) {
+    const size_t sizes[] = { 64, 1024, 16384 };
+
+    runHostPathPerf("sdot", sizes, sizeof(sizes) / sizeof(sizes[0]));
+}
+
+TEST(HOST_PATH, perfSaxpy) {
+    const size_t sizes[] = { 64, 1024, 16384 };
+
+    runHostPathPerf("saxpy", sizes, sizeof(sizes) / sizeof(sizes[0]));
+}
+
+TEST(HOST_PATH, perfSscal) {
+    const size_t sizes[] = { 64, 1024, 16384 };
+
+    runHostPathPerf("sscal", sizes, sizeof(sizes) / sizeof(sizes[0]));
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * Cost of the embedded kernel binaries: the size of the library file, the
+ * resident set size of the process, and the time and resident set size
+ * added by the first GEMM, which decodes and builds its kernels, against
+ * a second one. Sizes are only available on Linux.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+using namespace clMath;
+
+#define BLOB_PERF_N 1024
+
+// resident set size in kB, 0 if unknown
+static unsigned long
+residentKB(void)
+{
+    unsigned long pages = 0;
+
+#if defined(__linux__)
+    unsigned long size;
+    FILE *f = fopen("/proc/self/statm", "r");
+
+    if (f != NULL) {
+        if (fscanf(f, "%lu %lu", &size, &pages) != 2) {
+            pages = 0;
+        }
+        fclose(f);
+    }
+    return pages * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return pages;
+#endif
+}
+
+// size in kB of the file the library is mapped from, 0 if unknown
+static unsigned long
+libraryKB(void)
+{
+    unsigned long size = 0;
+
+#if defined(__linux__)
+    unsigned long addr = (unsigned long)&clblasSgemm;
+    unsigned long start, end;
+    char line[1024], path[1024];
+    struct stat st;
+    FILE *f = fopen("/proc/self/maps", "r");
+
+    if (f == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        path[0] = '\0';
+        if ((sscanf(line, "%lx-%lx %*s %*s %*s %*s %1023s", &start, &end,
+                    path) == 3) && (addr >= start) && (addr < end)) {
+            if (stat(path, &st) == 0) {
+                size = (unsigned long)st.st_size / 1024;
+            }
+            break;
+        }
+    }
+    fclose(f);
+#endif
+
+    return size;
+}
+
+static nano_time_t
+timeSgemm(cl_mem A, cl_mem B, cl_mem C)
+{
+    cl_command_queue queue = BlasBase::getInstance()->commandQueues()[0];
+    cl_event event = NULL;
+    nano_time_t time = getCurrentTime();
+
+    EXPECT_EQ(clblasSuccess, clblasSgemm(clblasColumnMajor, clblasNoTrans,
+        clblasNoTrans, BLOB_PERF_N, BLOB_PERF_N, BLOB_PERF_N, 1.0f,
+        A, 0, BLOB_PERF_N, B, 0, BLOB_PERF_N, 0.0f, C, 0, BLOB_PERF_N,
+        1, &queue, 0, NULL, &event));
+    EXPECT_EQ(CL_SUCCESS, clWaitForEvents(1, &event));
+    clReleaseEvent(event);
+
+    return getCurrentTime() - time;
+}
+
+TEST(KERNEL_BLOB, coldStart) {
+    cl_context context = BlasBase::getInstance()->context();
+    size_t size = BLOB_PERF_N * BLOB_PERF_N * sizeof(cl_float);
+    std::vector<cl_float> host(BLOB_PERF_N * BLOB_PERF_N, 1.0f);
+    unsigned long rss, firstRss, secondRss;
+    nano_time_t first, second;
+    cl_mem A, B, C;
+
+    A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                       size, &host[0], NULL);
+    B = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                       size, &host[0], NULL);
+    C = clCreateBuffer(context, CL_MEM_READ_WRITE, size, NULL, NULL);
+
+    rss = residentKB();
+    first = timeSgemm(A, B, C);
+    firstRss = residentKB();
+    second = timeSgemm(A, B, C);
+    secondRss = residentKB();
+
+    printf("library file: %lu kB, resident before the first sgemm: %lu kB\n",
+           libraryKB(), rss);
+    printf("first sgemm %d: %.3f ms, +%ld kB resident; second: %.3f ms, "
+           "+%ld kB resident\n", BLOB_PERF_N, conv2nanosec(first) / 1e6,
+           (long)(firstRss - rss), conv2nanosec(second) / 1e6,
+           (long)(secondRss - firstRss));
+
+    clReleaseMemObject(A);
+    clReleaseMemObject(B);
+    clReleaseMemObject(C);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * SPMV/HPMV performance test: the single pass kernel against the two
+ * passes of the solver framework. Both are bound by reading A, so the
+ * bandwidth is reported for one read of the stored triangle.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define SPMV_PERF_RUNS 10
+
+template <typename T>
+class SpmvPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+
+public:
+    size_t N;
+    cl_mem A, X, Y;
+
+    SpmvPerf(size_t N_) : N(N_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+        size_t sizeA = N * (N + 1) / 2;
+        T *hostA = new T[sizeA];
+        T *hostX = new T[N];
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        memset(hostA, 0, sizeA * sizeof(T));
+        memset(hostX, 0, N * sizeof(T));
+        A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           sizeA * sizeof(T), hostA, NULL);
+        X = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           N * sizeof(T), hostX, NULL);
+        Y = clCreateBuffer(context, CL_MEM_READ_WRITE, N * sizeof(T),
+                           NULL, NULL);
+        delete[] hostA;
+        delete[] hostX;
+    }
+
+    ~SpmvPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(X);
+        clReleaseMemObject(Y);
+    }
+
+    cl_int spmv(cl_event *event);
+
+    cl_int run()
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = spmv(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+};
+
+template <>
+cl_int SpmvPerf<float>::spmv(cl_event *event)
+{
+    return clblasSspmv(clblasColumnMajor, clblasLower, N, 1.0f, A, 0,
+        X, 0, 1, 0.0f, Y, 0, 1, 1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int SpmvPerf<FloatComplex>::spmv(cl_event *event)
+{
+    FloatComplex one = floatComplex(1.0f, 0.0f);
+    FloatComplex zero = floatComplex(0.0f, 0.0f);
+
+    return clblasChpmv(clblasColumnMajor, clblasLower, N, one, A, 0,
+        X, 0, 1, zero, Y, 0, 1, 1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static nano_time_t
+timeSpmv(SpmvPerf<T> &perf, const char *mode)
+{
+    nano_time_t time;
+
+    putenv((char*)mode);
+    // build kernels before timing
+    EXPECT_EQ(CL_SUCCESS, perf.run());
+
+    time = getCurrentTime();
+    for (int i = 0; i < SPMV_PERF_RUNS; i++) {
+        EXPECT_EQ(CL_SUCCESS, perf.run());
+    }
+    time = (getCurrentTime() - time) / SPMV_PERF_RUNS;
+    putenv((char*)"AMD_CLBLAS_SYMV_SINGLE_PASS=1");
+    return time;
+}
+
+template <typename T>
+static void
+runSpmvPerf(const char *name, size_t N)
+{
+    SpmvPerf<T> perf(N);
+    nano_time_t singleTime, twoPassTime;
+    double bytes = (double)N * (N + 1) / 2 * sizeof(T);
+
+    singleTime = timeSpmv(perf, "AMD_CLBLAS_SYMV_SINGLE_PASS=1");
+    twoPassTime = timeSpmv(perf, "AMD_CLBLAS_SYMV_SINGLE_PASS=0");
+
+    printf("%s %lu: single pass %.3f ms, %.1f GB/s; two passes %.3f ms, "
+           "%.1f GB/s\n", name, (unsigned long)N,
+           conv2nanosec(singleTime) / 1e6, bytes / conv2nanosec(singleTime),
+           conv2nanosec(twoPassTime) / 1e6, bytes / conv2nanosec(twoPassTime));
+}
+
+TEST(SPMV_SINGLE_PASS, perfSspmv) {
+    runSpmvPerf<float>("sspmv", 8192);
+}
+
+TEST(SPMV_SINGLE_PASS, perfChpmv) {
+    runSpmvPerf<FloatComplex>("chpmv", 8192);
+}
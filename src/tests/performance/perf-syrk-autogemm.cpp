@@ -0,0 +1,175 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * SYRK performance test: SSYRK and DSYRK on the triangular AutoGemm kernels
+ * and on the kernels of the solver framework, against the GEMM computing
+ * the whole of C from the same operands. SYRK does about half the flops of
+ * the GEMM, so its GFLOPS are counted as N*(N+1)*K.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define SYRK_PERF_RUNS 5
+
+template <typename T>
+class SyrkPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+    T *hostA;
+
+public:
+    size_t N, K;
+    cl_mem A, C;
+
+    SyrkPerf(size_t N_, size_t K_) : N(N_), K(K_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        hostA = new T[N * K];
+        for (size_t i = 0; i < N * K; i++) {
+            hostA[i] = T((i * 7) % 13) / T(13) - T(0.5);
+        }
+        A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           N * K * sizeof(T), hostA, NULL);
+        C = clCreateBuffer(context, CL_MEM_READ_WRITE, N * N * sizeof(T),
+                           NULL, NULL);
+    }
+
+    ~SyrkPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(C);
+        delete[] hostA;
+    }
+
+    cl_int gemm(cl_event *event);
+    cl_int syrk(cl_event *event);
+
+    cl_int run(bool useGemm)
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = useGemm ? gemm(&event) : syrk(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+};
+
+template <>
+cl_int SyrkPerf<float>::gemm(cl_event *event)
+{
+    return clblasSgemm(clblasColumnMajor, clblasNoTrans, clblasTrans,
+        N, N, K, 1.0f, A, 0, N, A, 0, N, 0.0f, C, 0, N,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int SyrkPerf<float>::syrk(cl_event *event)
+{
+    return clblasSsyrk(clblasColumnMajor, clblasLower, clblasNoTrans,
+        N, K, 1.0f, A, 0, N, 0.0f, C, 0, N, 1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int SyrkPerf<double>::gemm(cl_event *event)
+{
+    return clblasDgemm(clblasColumnMajor, clblasNoTrans, clblasTrans,
+        N, N, K, 1.0, A, 0, N, A, 0, N, 0.0, C, 0, N,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int SyrkPerf<double>::syrk(cl_event *event)
+{
+    return clblasDsyrk(clblasColumnMajor, clblasLower, clblasNoTrans,
+        N, K, 1.0, A, 0, N, 0.0, C, 0, N, 1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static nano_time_t
+timeSyrk(SyrkPerf<T> &perf, bool useGemm, const char *mode)
+{
+    nano_time_t time;
+
+    putenv((char*)mode);
+    // build kernels before timing
+    EXPECT_EQ(CL_SUCCESS, perf.run(useGemm));
+
+    time = getCurrentTime();
+    for (int i = 0; i < SYRK_PERF_RUNS; i++) {
+        EXPECT_EQ(CL_SUCCESS, perf.run(useGemm));
+    }
+    time = (getCurrentTime() - time) / SYRK_PERF_RUNS;
+    putenv((char*)"AMD_CLBLAS_SYRK_AUTOGEMM=1");
+    return time;
+}
+
+template <typename T>
+static void
+runSyrkPerf(const char *name, size_t N, size_t K)
+{
+    SyrkPerf<T> perf(N, K);
+    nano_time_t gemmTime, autoGemmTime, solverTime;
+    double syrkFlops = (double)N * (N + 1) * K;
+
+    gemmTime = timeSyrk(perf, true, "AMD_CLBLAS_SYRK_AUTOGEMM=1");
+    autoGemmTime = timeSyrk(perf, false, "AMD_CLBLAS_SYRK_AUTOGEMM=1");
+    solverTime = timeSyrk(perf, false, "AMD_CLBLAS_SYRK_AUTOGEMM=0");
+
+    printf("%s %lux%lu: gemm %.3f ms, %.1f GFLOPS; triangular %.3f ms, "
+           "%.1f GFLOPS; solver %.3f ms, %.1f GFLOPS\n", name,
+           (unsigned long)N, (unsigned long)K,
+           conv2nanosec(gemmTime) / 1e6,
+           2.0 * N * N * K / conv2nanosec(gemmTime),
+           conv2nanosec(autoGemmTime) / 1e6,
+           syrkFlops / conv2nanosec(autoGemmTime),
+           conv2nanosec(solverTime) / 1e6,
+           syrkFlops / conv2nanosec(solverTime));
+}
+
+TEST(SYRK_AUTOGEMM, perfSsyrk) {
+    runSyrkPerf<float>("ssyrk", 4096, 4096);
+}
+
+TEST(SYRK_AUTOGEMM, perfDsyrk) {
+    if (!BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    runSyrkPerf<double>("dsyrk", 4096, 4096);
+}
@@ -0,0 +1,165 @@
+/* ************************************************************************
+ * Copyright 2013 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ************************************************************************/
+
+
+/*
+ * TRSM performance test: STRSM and DTRSM with many right hand sides on the
+ * recursive GEMM-based path and on the previous kernels. A solve is M*M*N
+ * flops for an M x M triangle and N right hand sides.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <clBLAS.h>
+
+#include <BlasBase.h>
+#include <timer.h>
+
+using namespace std;
+using namespace clMath;
+
+#define TRSM_PERF_RUNS 5
+
+template <typename T>
+class TrsmPerf
+{
+    cl_context context;
+    cl_command_queue queue;
+    T *hostA, *hostB;
+
+public:
+    size_t M, N;
+    cl_mem A, B;
+
+    TrsmPerf(size_t M_, size_t N_) : M(M_), N(N_)
+    {
+        BlasBase *base = BlasBase::getInstance();
+
+        context = base->context();
+        queue = base->commandQueues()[0];
+
+        // a dominant diagonal keeps repeated solves finite
+        hostA = new T[M * M];
+        for (size_t i = 0; i < M * M; i++) {
+            hostA[i] = (T((i * 7) % 13) / T(13) - T(0.5)) / T(M);
+        }
+        for (size_t i = 0; i < M; i++) {
+            hostA[i * M + i] = T(1);
+        }
+        hostB = new T[M * N];
+        for (size_t i = 0; i < M * N; i++) {
+            hostB[i] = T((i * 11) % 13) / T(13) - T(0.5);
+        }
+        A = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           M * M * sizeof(T), hostA, NULL);
+        B = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                           M * N * sizeof(T), hostB, NULL);
+    }
+
+    ~TrsmPerf()
+    {
+        clReleaseMemObject(A);
+        clReleaseMemObject(B);
+        delete[] hostA;
+        delete[] hostB;
+    }
+
+    cl_int trsm(cl_event *event);
+
+    cl_int run()
+    {
+        cl_event event = NULL;
+        cl_int err;
+
+        err = trsm(&event);
+        if (err == CL_SUCCESS) {
+            err = clWaitForEvents(1, &event);
+        }
+        return err;
+    }
+};
+
+template <>
+cl_int TrsmPerf<float>::trsm(cl_event *event)
+{
+    return clblasStrsm(clblasColumnMajor, clblasLeft, clblasLower,
+        clblasNoTrans, clblasNonUnit, M, N, 1.0f, A, 0, M, B, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <>
+cl_int TrsmPerf<double>::trsm(cl_event *event)
+{
+    return clblasDtrsm(clblasColumnMajor, clblasLeft, clblasLower,
+        clblasNoTrans, clblasNonUnit, M, N, 1.0, A, 0, M, B, 0, M,
+        1, &queue, 0, NULL, event);
+}
+
+template <typename T>
+static nano_time_t
+timeTrsm(TrsmPerf<T> &perf, const char *mode)
+{
+    nano_time_t time;
+
+    putenv((char*)mode);
+    // build kernels before timing
+    EXPECT_EQ(CL_SUCCESS, perf.run());
+
+    time = getCurrentTime();
+    for (int i = 0; i < TRSM_PERF_RUNS; i++) {
+        EXPECT_EQ(CL_SUCCESS, perf.run());
+    }
+    time = (getCurrentTime() - time) / TRSM_PERF_RUNS;
+    putenv((char*)"AMD_CLBLAS_TRXM_RECURSIVE=1024");
+    return time;
+}
+
+template <typename T>
+static void
+runTrsmPerf(const char *name, size_t M, size_t N)
+{
+    TrsmPerf<T> perf(M, N);
+    nano_time_t recursiveTime, previousTime;
+    double flops = (double)M * M * N;
+
+    recursiveTime = timeTrsm(perf, "AMD_CLBLAS_TRXM_RECURSIVE=1024");
+    previousTime = timeTrsm(perf, "AMD_CLBLAS_TRXM_RECURSIVE=0");
+
+    printf("%s %lux%lu: recursive %.3f ms, %.1f GFLOPS; "
+           "previous %.3f ms, %.1f GFLOPS\n", name,
+           (unsigned long)M, (unsigned long)N,
+           conv2nanosec(recursiveTime) / 1e6,
+           flops / conv2nanosec(recursiveTime),
+           conv2nanosec(previousTime) / 1e6,
+           flops / conv2nanosec(previousTime));
+}
+
+TEST(TRSM_RECURSIVE, perfStrsm) {
+    runTrsmPerf<float>("strsm", 4096, 8192);
+}
+
+TEST(TRSM_RECURSIVE, perfDtrsm) {
+    if (!BlasBase::getInstance()->isDevSupportDoublePrecision()) {
+        ::std::cerr << ">> WARNING: The target device doesn't support native "
+                       "double precision floating point arithmetic."
+                    << ::std::endl << ">> Test skipped." << ::std::endl;
+        SUCCEED();
+        return;
+    }
+
+    runTrsmPerf<double>("dtrsm", 4096, 8192);
+}
@@ -658,6 +658,21 @@ INSTANTIATE_TEST_CASE_P(Custom, GEMM, Combine(
     ValuesIn(orderSet), ValuesIn(transSet), ValuesIn(transSet),
     Values(41*48), Values(41*48), Values(41*48),
     Values(ExtraTestSizes()), Values(1)));
+
+// small C with long K, run by splitting K across work groups
+const int splitKSizeRange[] = { 16, 64 };
+const int splitKRange[] = { 16384, 262144 };
+
+INSTANTIATE_TEST_CASE_P(SplitK, GEMM, Combine(
+    Values(clblasColumnMajor), ValuesIn(transSet), ValuesIn(transSet),
+    ValuesIn(splitKSizeRange), ValuesIn(splitKSizeRange), ValuesIn(splitKRange),
+    Values(ExtraTestSizes()), Values(1)));
+
+// K/(M*N) = 10^4
+INSTANTIATE_TEST_CASE_P(SplitKExtreme, GEMM, Combine(
+    Values(clblasColumnMajor), Values(clblasNoTrans), Values(clblasNoTrans),
+    Values(8), Values(8), Values(640000),
+    Values(ExtraTestSizes()), Values(1)));
 #endif
 
 #ifdef DO_TRMM
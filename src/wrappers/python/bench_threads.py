@@ -0,0 +1,97 @@
+################################################################################
+ # Copyright 2014 Advanced Micro Devices, Inc.
+ #
+ # Licensed under the Apache License, Version 2.0 (the "License");
+ # you may not use this file except in compliance with the License.
+ # You may obtain a copy of the License at
+ #
+ # http://www.apache.org/licenses/LICENSE-2.0
+ #
+ # Unless required by applicable law or agreed to in writing, software
+ # distributed under the License is distributed on an "AS IS" BASIS,
+ # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ # See the License for the specific language governing permissions and
+ # limitations under the License.
+################################################################################
+
+# Call throughput of pyclBLAS from several python threads.  Every thread
+# enqueues Sgemm( ) calls on its own command queues, spread over all the
+# devices of a platform, and the number of calls per second is printed for
+# each number of threads.  Since the wrappers release the GIL while clBLAS
+# enqueues, the throughput should grow with the threads until the devices
+# or the host cores are saturated.
+
+import argparse
+import threading
+import time
+import numpy
+import pyopencl
+import pyclBLAS
+
+def worker( queues, args, A, B, C, barrier, calls ):
+   barrier.wait( )
+   events = []
+   for i in range( args.calls ):
+      events = pyclBLAS.Sgemm( pyclBLAS.ColumnMajor, pyclBLAS.NoTrans, pyclBLAS.NoTrans,
+                               args.size, args.size, args.size, 1.0, A, 0, args.size,
+                               B, 0, args.size, 0.0, C, 0, args.size, queues )
+      # keep the queues from growing without bound
+      if( ( i + 1 ) % args.sync == 0 ):
+         pyopencl.wait_for_events( events )
+   pyopencl.wait_for_events( events )
+   calls.append( args.calls )
+
+def main( ):
+   parser = argparse.ArgumentParser( description='Measure the pyclBLAS call throughput from several python threads' )
+   parser.add_argument( '--platform', dest='platform', type=int, default=0,
+     help='Index of the OpenCL platform' )
+   parser.add_argument( '--size', dest='size', type=int, default=64,
+     help='Size of the square matrices; small sizes measure the call overhead' )
+   parser.add_argument( '--calls', dest='calls', type=int, default=500,
+     help='Calls made by every thread' )
+   parser.add_argument( '--sync', dest='sync', type=int, default=50,
+     help='Calls between waits for completion' )
+   parser.add_argument( '--threads', dest='threads', type=int, nargs='+', default=[ 1, 2, 4, 8 ],
+     help='Numbers of threads to measure' )
+   parser.add_argument( '--queues', dest='queues', type=int, default=1,
+     help='Command queues passed to every call' )
+   args = parser.parse_args( )
+
+   platform = pyopencl.get_platforms( )[ args.platform ]
+   devices = platform.get_devices( )
+   context = pyopencl.Context( devices )
+   print( "%s, %d device(s)" % ( platform.name, len( devices ) ) )
+
+   host = numpy.ones( args.size * args.size, dtype=numpy.float32 )
+   flags = pyopencl.mem_flags.READ_WRITE | pyopencl.mem_flags.COPY_HOST_PTR
+
+   pyclBLAS.Setup( )
+   for nrThreads in args.threads:
+      threads, calls = [], []
+      barrier = threading.Barrier( nrThreads + 1 )
+      for t in range( nrThreads ):
+         queues = [ pyopencl.CommandQueue( context, devices[ ( t * args.queues + q ) % len( devices ) ] )
+                    for q in range( args.queues ) ]
+         A = pyopencl.Buffer( context, flags, hostbuf=host )
+         B = pyopencl.Buffer( context, flags, hostbuf=host )
+         C = pyopencl.Buffer( context, flags, hostbuf=host )
+         # the first call builds the kernels, keep it out of the timing
+         pyopencl.wait_for_events( pyclBLAS.Sgemm( pyclBLAS.ColumnMajor, pyclBLAS.NoTrans,
+            pyclBLAS.NoTrans, args.size, args.size, args.size, 1.0, A, 0, args.size,
+            B, 0, args.size, 0.0, C, 0, args.size, queues ) )
+         threads.append( threading.Thread( target=worker,
+                                           args=( queues, args, A, B, C, barrier, calls ) ) )
+
+      for t in threads:
+         t.start( )
+      barrier.wait( )
+      start = time.time( )
+      for t in threads:
+         t.join( )
+      seconds = time.time( ) - start
+
+      print( "%2d threads: %8.0f calls/s" % ( nrThreads, sum( calls ) / seconds ) )
+   pyclBLAS.Teardown( )
+
+if __name__ == '__main__':
+    main( )
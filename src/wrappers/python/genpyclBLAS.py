@@ -0,0 +1,259 @@
+################################################################################
+ # Copyright 2014 Advanced Micro Devices, Inc.
+ #
+ # Licensed under the Apache License, Version 2.0 (the "License");
+ # you may not use this file except in compliance with the License.
+ # You may obtain a copy of the License at
+ #
+ # http://www.apache.org/licenses/LICENSE-2.0
+ #
+ # Unless required by applicable law or agreed to in writing, software
+ # distributed under the License is distributed on an "AS IS" BASIS,
+ # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ # See the License for the specific language governing permissions and
+ # limitations under the License.
+################################################################################
+
+# Generates pyclBLAS_api.pxi from clBLAS.h: the Cython declarations of the
+# enums, structs and functions of the header, a python constant for every
+# enum value, and a python wrapper for every function.
+#
+# A wrapper is named after its function without the 'clblas' prefix, e.g.
+# Sgemm( ) for clblasSgemm( ).  Its arguments are the ones of the function,
+# with these exceptions:
+#   - the count arguments numCommandQueues and numEventsInWaitList go away,
+#     they are the lengths of commandQueues and eventWaitList
+#   - commandQueues takes a pyopencl CommandQueue or a sequence of them
+#   - eventWaitList becomes the last argument and defaults to None; it takes
+#     an Event or a sequence of them
+#   - cl_mem arguments take pyopencl memory objects, host pointers take
+#     objects with the buffer interface, such as numpy arrays, or pyopencl
+#     SVM pointers
+#   - complex scalars take python complex numbers
+#   - output arguments (events, sizes, error codes) are returned instead
+# The events are returned as a list if commandQueues was a sequence, as a
+# single Event otherwise.  A status other than clblasSuccess raises
+# pyclBLAS.Error.  Every call into clBLAS releases the GIL.
+
+from os import path
+import argparse
+import re
+
+# Written by hand in pyclBLAS.pyx
+HAND_WRITTEN = [ 'clblasGetStatistics' ]
+
+SCALAR_TYPES = [ 'size_t', 'int', 'cl_int', 'cl_uint', 'cl_ulong', 'cl_bool',
+                 'cl_float', 'cl_double', 'float', 'double' ]
+
+COMPLEX_TYPES = { 'FloatComplex': '_floatComplex',
+                  'cl_float2': '_floatComplex',
+                  'DoubleComplex': '_doubleComplex',
+                  'cl_double2': '_doubleComplex' }
+
+HOST_TYPES = [ 'void', 'cl_float', 'cl_double', 'FloatComplex',
+               'DoubleComplex' ]
+
+OUTPUT_TYPES = [ 'size_t', 'cl_uint' ]
+
+################################################################################
+class Param:
+   def __init__( self, text ):
+      m = re.match( r'^(.*?)\s*(\w+)$', ' '.join( text.split( ) ) )
+      if( m is None ):
+         raise ValueError( "cannot parse parameter '%s'" % text )
+      self.name = m.group( 2 )
+      # normalize 'cl_uint*' and 'cl_uint * ' to 'cl_uint *'
+      self.ctype = re.sub( r'\s*\*', ' *', m.group( 1 ) ).strip( )
+      self.const = self.ctype.startswith( 'const ' )
+      self.base = self.ctype.replace( 'const ', '' ).replace( '*', '' ).strip( )
+      self.pointer = self.ctype.endswith( '*' )
+
+   def decl( self ):
+      return '%s %s' % ( self.ctype, self.name )
+
+class Function:
+   def __init__( self, ret, name, params ):
+      self.ret = ' '.join( ret.split( ) )
+      self.name = name
+      self.params = [ Param( p ) for p in params.split( ',' )
+                      if p.strip( ) not in ( '', 'void' ) ]
+
+   def decl( self ):
+      return '%s %s( %s )' % ( self.ret, self.name,
+                               ', '.join( p.decl( ) for p in self.params ) )
+
+################################################################################
+def parseHeader( text ):
+   text = re.sub( r'/\*.*?\*/', '', text, flags=re.S )
+   text = re.sub( r'//[^\n]*', '', text )
+   text = re.sub( r'^\s*#.*$', '', text, flags=re.M )
+   text = re.sub( r'extern\s+"C"\s*{', '', text )
+
+   enums = []
+   for body, name in re.findall( r'typedef\s+enum\s+\w*\s*{(.*?)}\s*(\w+)\s*;', text, re.S ):
+      values = [ v.split( '=' )[0].strip( ) for v in body.split( ',' ) ]
+      enums.append( ( name, [ v for v in values if v ] ) )
+
+   structs = []
+   for body, name in re.findall( r'typedef\s+struct\s+\w*\s*{(.*?)}\s*(\w+)\s*;', text, re.S ):
+      fields = [ ' '.join( f.split( ) ) for f in body.split( ';' ) ]
+      structs.append( ( name, [ f for f in fields if f ] ) )
+
+   text = re.sub( r'typedef\s+(enum|struct)\s+\w*\s*{.*?}\s*\w+\s*;', '', text, flags=re.S )
+   functions = [ Function( r, n, p ) for r, n, p in
+                 re.findall( r'([A-Za-z_][\w\s\*]*?)\b(clblas\w+)\s*\(([^;{}]*?)\)\s*;', text ) ]
+
+   return enums, structs, functions
+
+################################################################################
+def pyName( cName ):
+   return cName[ len( 'clblas' ): ]
+
+def writeDeclarations( out, enums, structs, functions ):
+   out.append( 'cdef extern from "clBLAS.h" nogil:' )
+   for name, values in enums:
+      out.append( '    ctypedef enum %s:' % name )
+      out.extend( '        %s' % v for v in values )
+      out.append( '' )
+   for name, fields in structs:
+      out.append( '    ctypedef struct %s:' % name )
+      out.extend( '        %s' % f for f in fields )
+      out.append( '' )
+   for f in functions:
+      out.append( '    %s' % f.decl( ) )
+   out.append( '' )
+
+def writeConstants( out, enums ):
+   for name, values in enums:
+      out.append( '# %s' % name )
+      out.extend( '%s = %s' % ( pyName( v ), v ) for v in values )
+      out.append( '' )
+
+   status = [ values for name, values in enums if name == 'clblasStatus' ][0]
+   out.append( '_statusNames = {' )
+   out.extend( '   %s: "%s",' % ( v, v ) for v in status )
+   out.append( '}' )
+   out.append( '' )
+
+################################################################################
+# Conversion of one parameter: the python argument, the code converting it
+# before the call and the C expression passed
+def convert( f, p, queues, enumNames ):
+   if( p.name == 'numCommandQueues' ):
+      return None, [], '_queues.count'
+   if( p.name == 'commandQueues' ):
+      return p.name, [ 'cdef _HandleList _queues = _HandleList( commandQueues, False )' ], \
+             '<cl_command_queue*>_queues.handles'
+   if( p.name == 'numEventsInWaitList' ):
+      return None, [], '_waits.count'
+   if( p.name == 'eventWaitList' ):
+      return 'eventWaitList=None', [ 'cdef _HandleList _waits = _HandleList( eventWaitList, True )' ], \
+             '<const cl_event*>_waits.handles'
+   if( p.base == 'cl_event' and not p.const ):
+      count = '_queues.count' if queues else '1'
+      return None, [ 'cdef _EventList _events = _EventList( %s )' % count ], \
+             '<cl_event*>_events.handles'
+
+   c = 'c_' + p.name
+   if( p.ctype in SCALAR_TYPES or p.ctype in enumNames ):
+      return '%s %s' % ( p.ctype, p.name ), [], p.name
+   if( p.ctype in COMPLEX_TYPES ):
+      return p.name, [ 'cdef %s %s = %s( %s )' % ( p.ctype, c, COMPLEX_TYPES[ p.ctype ], p.name ) ], c
+   if( p.base == 'cl_mem' and not p.pointer ):
+      return p.name, [ 'cdef cl_mem %s = _mem( %s )' % ( c, p.name ) ], c
+   if( p.ctype == 'cl_command_queue' ):
+      return p.name, [ 'cdef cl_command_queue %s = _queue( %s )' % ( c, p.name ) ], c
+   if( p.ctype == 'cl_context' ):
+      return p.name, [ 'cdef cl_context %s = _context( %s )' % ( c, p.name ) ], c
+   if( p.ctype == 'cl_device_id' ):
+      return p.name, [ 'cdef cl_device_id %s = _device( %s )' % ( c, p.name ) ], c
+   if( p.ctype == 'const clblasEpilogue *' ):
+      return p.name, [ 'cdef const clblasEpilogue *%s = _epilogue( %s )' % ( c, p.name ) ], c
+   if( p.pointer and p.base in HOST_TYPES ):
+      return p.name, [ 'cdef _HostBuffer _%s = _HostBuffer( %s, %s )' % ( p.name, p.name, not p.const ) ], \
+             '<%s>_%s.ptr' % ( p.ctype, p.name )
+   if( p.pointer and p.base in OUTPUT_TYPES and not p.const ):
+      return None, [ 'cdef %s %s = 0' % ( p.base, c ) ], '&' + c
+   if( p.ctype == 'cl_int *' and p.name == 'err' ):
+      return None, [ 'cdef cl_int %s = CL_SUCCESS' % c ], '&' + c
+
+   raise ValueError( "%s( ): no python conversion for '%s'" % ( f.name, p.decl( ) ) )
+
+def writeWrapper( out, f, enumNames ):
+   queues = any( p.name == 'commandQueues' for p in f.params )
+   args, pre, call, outputs = [], [], [], []
+   for p in f.params:
+      arg, code, expr = convert( f, p, queues, enumNames )
+      if( arg is not None ):
+         args.append( arg )
+      pre.extend( code )
+      call.append( expr )
+      if( expr.startswith( '&' ) and p.name != 'err' ):
+         outputs.append( expr[ 1: ] )
+
+   # the wait list comes last, since it has a default value
+   args.sort( key=lambda a: a == 'eventWaitList=None' )
+   callText = '%s( %s )' % ( f.name, ', '.join( call ) ) if call else f.name + '( )'
+
+   out.append( '#' * 80 )
+   out.append( 'def %s( %s ):' % ( pyName( f.name ), ', '.join( args ) ) if args else
+               'def %s( ):' % pyName( f.name ) )
+   out.extend( '   ' + c for c in pre )
+   if( f.ret == 'void' ):
+      out.append( '   with nogil:' )
+      out.append( '      %s' % callText )
+   else:
+      out.append( '   cdef %s _result' % f.ret )
+      out.append( '   with nogil:' )
+      out.append( '      _result = %s' % callText )
+   if( f.ret == 'clblasStatus' ):
+      out.append( '   _check( _result, "%s" )' % f.name )
+   elif( f.ret == 'cl_mem' ):
+      out.append( '   _check( c_err, "%s" )' % f.name )
+      outputs.insert( 0, '_memObject( _result )' )
+   elif( f.ret != 'void' ):
+      raise ValueError( "%s( ): no python conversion for the result '%s'" % ( f.name, f.ret ) )
+
+   if( any( p.base == 'cl_event' and not p.const for p in f.params ) ):
+      outputs.insert( 0, '_events.wrap( %s )' % ( '_queues.single' if queues else 'True' ) )
+   if( len( outputs ) == 1 ):
+      out.append( '   return %s' % outputs[0] )
+   elif( len( outputs ) > 1 ):
+      out.append( '   return %s' % ', '.join( outputs ) )
+   out.append( '' )
+
+################################################################################
+def generate( header, output ):
+   with open( header ) as f:
+      enums, structs, functions = parseHeader( f.read( ) )
+
+   names = set( pyName( v ) for name, values in enums for v in values )
+   for f in functions:
+      if( pyName( f.name ) in names ):
+         raise ValueError( "%s( ) clashes with an enum value" % f.name )
+
+   out = [ '# Generated by genpyclBLAS.py from %s, do not edit' % path.basename( header ), '' ]
+   writeDeclarations( out, enums, structs, functions )
+   writeConstants( out, enums )
+   enumNames = [ name for name, values in enums ]
+   for f in functions:
+      if( f.name not in HAND_WRITTEN ):
+         writeWrapper( out, f, enumNames )
+
+   with open( output, 'w' ) as f:
+      f.write( '\n'.join( out ) )
+
+   return len( functions )
+
+def main( ):
+   parser = argparse.ArgumentParser( description='Generate the pyclBLAS wrappers from clBLAS.h' )
+   parser.add_argument( 'header', help='Path of clBLAS.h' )
+   parser.add_argument( '-o', dest='output', default='pyclBLAS_api.pxi',
+     help='Generated file, pyclBLAS_api.pxi by default' )
+   args = parser.parse_args( )
+
+   count = generate( args.header, args.output )
+   print( "%s generated for %d clBLAS functions" % ( args.output, count ) )
+
+if __name__ == '__main__':
+    main( )
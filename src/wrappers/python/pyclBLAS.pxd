@@ -14,11 +14,12 @@
  # limitations under the License.
 ################################################################################
 
-# This pxd file defines all the enums and structs that we plan to use from
-# python.  It is used from pyclBLAS.pyx
+# This pxd file declares the OpenCL types and constants that clBLAS.h builds
+# on.  The declarations of clBLAS.h itself are generated into
+# pyclBLAS_api.pxi by genpyclBLAS.py
 from libc.stdint cimport intptr_t, uintptr_t
 
-cdef extern from "clBLAS.h":
+cdef extern from "clBLAS.h" nogil:
     # These are base OpenCL enumerations that clBLAS uses
     cdef enum:
         CL_SUCCESS                      = 0
@@ -34,52 +35,22 @@ cdef extern from "clBLAS.h":
         CL_COMPILER_NOT_AVAILABLE       = -3
         CL_BUILD_PROGRAM_FAILURE        = -11
 
-    cdef enum clblasStatus_:
-        clblasSuccess               = CL_SUCCESS
-        clblasInvalidValue          = CL_INVALID_VALUE
-        clblasInvalidCommandQueue   = CL_INVALID_COMMAND_QUEUE
-        clblasInvalidContext        = CL_INVALID_CONTEXT
-        clblasInvalidMemObject      = CL_INVALID_MEM_OBJECT
-        clblasInvalidDevice         = CL_INVALID_DEVICE
-        clblasInvalidEventWaitList  = CL_INVALID_EVENT_WAIT_LIST
-        clblasOutOfResources        = CL_OUT_OF_RESOURCES
-        clblasOutOfHostMemory       = CL_OUT_OF_HOST_MEMORY
-        clblasInvalidOperation      = CL_INVALID_OPERATION
-        clblasCompilerNotAvailable  = CL_COMPILER_NOT_AVAILABLE
-        clblasBuildProgramFailure   = CL_BUILD_PROGRAM_FAILURE
-        clblasNotImplemented        = -1024
-        clblasNotInitialized        = -1023
-        clblasInvalidMatA
-        clblasInvalidMatB
-        clblasInvalidMatC
-        clblasInvalidVecX
-        clblasInvalidVecY
-        clblasInvalidDim
-        clblasInvalidLeadDimA
-        clblasInvalidLeadDimB
-        clblasInvalidLeadDimC
-        clblasInvalidIncX
-        clblasInvalidIncY
-        clblasInsufficientMemMatA
-        clblasInsufficientMemMatB
-        clblasInsufficientMemMatC
-        clblasInsufficientMemVecX
-        clblasInsufficientMemVecY
-    ctypedef clblasStatus_ clblasStatus
-
-    cdef enum clblasOrder_:
-        clblasRowMajor             = 0
-        clblasColumnMajor          = 1
-    ctypedef clblasStatus_ clblasOrder
-
-    cdef enum clblasTranspose_:
-        clblasNoTrans             = 0
-        clblasTrans               = 1
-        clblasConjTrans           = 2
-    ctypedef clblasStatus_ clblasTranspose
-
+    ctypedef int cl_int
     ctypedef unsigned int cl_uint
+    ctypedef unsigned long long cl_ulong
+    ctypedef unsigned int cl_bool
     ctypedef float cl_float
+    ctypedef double cl_double
+
+    ctypedef union cl_float2:
+        cl_float s[2]
+    ctypedef union cl_double2:
+        cl_double s[2]
+    ctypedef cl_float2 FloatComplex
+    ctypedef cl_double2 DoubleComplex
+
     ctypedef void* cl_mem
+    ctypedef void* cl_context
+    ctypedef void* cl_device_id
     ctypedef void* cl_command_queue
     ctypedef void* cl_event
@@ -14,104 +14,205 @@
  # limitations under the License.
 ################################################################################
 
-cimport pyclBLAS
+from libc.stdlib cimport malloc, calloc, free
+from cpython.buffer cimport PyObject_GetBuffer, PyBuffer_Release, \
+     PyBUF_ANY_CONTIGUOUS, PyBUF_WRITABLE
 import pyopencl
 
-# These are prototypes from clBLAS.h that we wish to call from python
+# The declarations of clBLAS.h, the constants of its enums, e.g. RowMajor for
+# clblasRowMajor, and the wrappers of its functions, e.g. Sgemm( ) for
+# clblasSgemm( ).  See genpyclBLAS.py for how the arguments are passed.
+include "pyclBLAS_api.pxi"
+
 ################################################################################
 ################################################################################
-cdef extern from "clBLAS.h":
-   clblasStatus clblasGetVersion( cl_uint* major, cl_uint* minor, cl_uint* patch )
-
-   clblasStatus clblasSetup( )
-
-   void clblasTeardown( )
+# Conversions between python objects and the arguments of clBLAS
+class Error( RuntimeError ):
+   def __init__( self, status, function ):
+      RuntimeError.__init__( self, "%s( ) failed: %s" %
+                             ( function, _statusNames.get( status, status ) ) )
+      self.status = status
 
-   clblasStatus clblasSgemm( clblasOrder order, clblasTranspose transA, clblasTranspose transB,
-                size_t M, size_t N, size_t K, cl_float alpha, const cl_mem A, size_t offA, size_t lda,
-                const cl_mem B, size_t offB, size_t ldb, cl_float beta, cl_mem C, size_t offC, size_t ldc,
-                cl_uint numCommandQueues, cl_command_queue* commandQueues, cl_uint numEventsInWaitList,
-                const cl_event* eventWaitList, cl_event* events)
+cdef _check( int status, function ):
+   if( status != clblasSuccess ):
+      raise Error( status, function )
 
 ################################################################################
-################################################################################
-# enums to be accessed from python
-# TODO:  is there a better way to express enums?  I like how pyopencl does it,
-# they have layers of scoped constants cl.mem_flags.READ_ONLY
-# The enums below have global scope
-RowMajor    = pyclBLAS.clblasRowMajor
-ColumnMajor = pyclBLAS.clblasColumnMajor
-NoTrans     = pyclBLAS.clblasNoTrans
-Trans       = pyclBLAS.clblasTrans
-ConjTrans   = pyclBLAS.clblasConjTrans
+# Pyopencl objects contain an int_ptr attribute to get access to the internally
+# wrapped OpenCL object pointers
+cdef cl_mem _mem( obj ) except? NULL:
+   if( obj is None ):
+      return NULL
+   return <cl_mem><intptr_t>obj.int_ptr
+
+cdef cl_command_queue _queue( obj ) except NULL:
+   return <cl_command_queue><intptr_t>obj.int_ptr
+
+cdef cl_context _context( obj ) except NULL:
+   return <cl_context><intptr_t>obj.int_ptr
+
+cdef cl_device_id _device( obj ) except NULL:
+   return <cl_device_id><intptr_t>obj.int_ptr
+
+cdef _memObject( cl_mem mem ):
+   # clBLAS hands over its reference to the new buffer
+   return pyopencl.Buffer.from_int_ptr( <intptr_t>mem, retain=False )
+
+cdef FloatComplex _floatComplex( z ) except *:
+   cdef FloatComplex c
+   z = complex( z )
+   c.s[0] = z.real
+   c.s[1] = z.imag
+   return c
+
+cdef DoubleComplex _doubleComplex( z ) except *:
+   cdef DoubleComplex c
+   z = complex( z )
+   c.s[0] = z.real
+   c.s[1] = z.imag
+   return c
 
 ################################################################################
-################################################################################
-# The following functions are the python callable wrapper implementations
-def Setup( ):
-   result = clblasSetup( )
-   if( result != clblasSuccess ):
-      raise RuntimeError( "clblasSetup( ) failed initialization" )
-   return result
+# A C array of the handles of a pyopencl object, or of a sequence of them, such
+# as command queues or events
+cdef class _HandleList:
+   cdef void **handles
+   cdef cl_uint count
+   cdef bint single
+
+   def __cinit__( self, objs, bint allowNone ):
+      self.handles = NULL
+      self.count = 0
+      self.single = hasattr( objs, 'int_ptr' )
+      if( objs is None and allowNone ):
+         return
+      if( self.single ):
+         objs = [ objs ]
+      objs = list( objs )
+      if( len( objs ) == 0 ):
+         return
+      self.handles = <void**>malloc( len( objs ) * sizeof( void* ) )
+      if( self.handles == NULL ):
+         raise MemoryError( )
+      for obj in objs:
+         self.handles[ self.count ] = <void*><intptr_t>obj.int_ptr
+         self.count += 1
+
+   def __dealloc__( self ):
+      free( self.handles )
+
+# The events returned by a call, one per command queue
+cdef class _EventList:
+   cdef void **handles
+   cdef cl_uint count
+
+   def __cinit__( self, cl_uint count ):
+      self.count = count
+      self.handles = <void**>calloc( max( count, 1 ), sizeof( void* ) )
+      if( self.handles == NULL ):
+         raise MemoryError( )
+
+   def __dealloc__( self ):
+      free( self.handles )
+
+   def wrap( self, bint single ):
+      # clBLAS hands over its references to the events
+      events = [ pyopencl.Event.from_int_ptr( <intptr_t>self.handles[ i ], retain=False )
+                 for i in range( self.count ) if self.handles[ i ] != NULL ]
+      if( single ):
+         return events[0] if events else None
+      return events
+
+# A host pointer: an object with the buffer interface such as a numpy array,
+# a pyopencl SVM pointer, or a raw address
+cdef class _HostBuffer:
+   cdef Py_buffer view
+   cdef bint hasView
+   cdef void *ptr
+
+   def __cinit__( self, obj, bint writable ):
+      self.hasView = False
+      self.ptr = NULL
+      if( obj is None ):
+         return
+      if( hasattr( obj, 'svm_ptr' ) ):
+         self.ptr = <void*><intptr_t>obj.svm_ptr
+      elif( isinstance( obj, int ) ):
+         self.ptr = <void*><intptr_t>obj
+      else:
+         PyObject_GetBuffer( obj, &self.view,
+                             PyBUF_ANY_CONTIGUOUS | ( PyBUF_WRITABLE if writable else 0 ) )
+         self.hasView = True
+         self.ptr = self.view.buf
 
-################################################################################
-def Teardown( ):
-   clblasTeardown( )
-   return
+   def __dealloc__( self ):
+      if( self.hasView ):
+         PyBuffer_Release( &self.view )
 
 ################################################################################
-def GetVersion( ):
-   cdef pyclBLAS.cl_uint pyMajor
-   cdef pyclBLAS.cl_uint pyMinor
-   cdef pyclBLAS.cl_uint pyPatch
-   result = clblasGetVersion( &pyMajor, &pyMinor, &pyPatch )
-   if( result != clblasSuccess ):
-      raise RuntimeError( "clblasGetVersion( ) did not return version information" )
-   return pyMajor, pyMinor, pyPatch
+################################################################################
+# Python classes for the structures of clBLAS
+cdef class Epilogue:
+   """The epilogue of SgemmEx( ) and DgemmEx( ), see clblasEpilogue"""
+   cdef clblasEpilogue c
+   # the bias and scale buffers are kept alive with the epilogue
+   cdef object bias
+   cdef object scale
+
+   def __init__( self, biasMode=EpilogueNone, bias=None, size_t offBias=0,
+                 scaleMode=EpilogueNone, scale=None, size_t offScale=0,
+                 activation=ActivationNone, clamp=False, cl_double clampMin=0,
+                 cl_double clampMax=0 ):
+      self.bias = bias
+      self.scale = scale
+      self.c.biasMode = biasMode
+      self.c.bias = _mem( bias )
+      self.c.offBias = offBias
+      self.c.scaleMode = scaleMode
+      self.c.scale = _mem( scale )
+      self.c.offScale = offScale
+      self.c.activation = activation
+      self.c.clamp = clamp
+      self.c.clampMin = clampMin
+      self.c.clampMax = clampMax
+
+cdef const clblasEpilogue *_epilogue( Epilogue epilogue ):
+   if( epilogue is None ):
+      return NULL
+   return &epilogue.c
 
 ################################################################################
-# TODO:  Is there way to template these python callable functions, such that we
-# do not need to make a new function for every supported precision?
-def Sgemm( clblasOrder order, clblasTranspose transA, clblasTranspose transB,
-                size_t M, size_t N, size_t K, cl_float alpha, A, size_t offA, size_t lda,
-                B, size_t offB, size_t ldb, cl_float beta, C, size_t offC, size_t ldc,
-                cl_uint numCommandQueues, commandQueues, cl_uint numEventsInWaitList,
-                eventWaitList ):
-
-   # Simplify python wrapper to only handle 1 queue at this time
-   if( numCommandQueues != 1 ):
-      raise IndexError( "pyblasSgemm( ) requires the number of queues to be 1" )
-   cdef intptr_t pIntQueue = commandQueues.int_ptr
-   cdef cl_command_queue pcqQueue = <cl_command_queue>pIntQueue
-
-   # This logic does not yet work for numEventsInWaitList > (greater than) 1
-   # Need to figure out how python & pyopencl pass lists of objects
-   cdef intptr_t pIntWaitList = 0
-   cdef cl_event* pWaitList = NULL
-   if( numEventsInWaitList > 0 ):
-      if( numEventsInWaitList < 2 ):
-         pIntWaitList = eventWaitList.int_ptr
-         pWaitList = <cl_event*>pIntWaitList
-      else:
-         raise IndexError( "pyblasSgemm( ) requires numEventsInWaitList to be <= 1" )
-
-   # Pyopencl objects contain an int_ptr method to get access to the internally wrapped
-   # OpenCL object pointers
-   cdef cl_event outEvent = NULL
-   cdef intptr_t matA = A.int_ptr
-   cdef intptr_t matB = B.int_ptr
-   cdef intptr_t matC = C.int_ptr
-
-   # Transition execution to clBLAS
-   cdef clblasStatus result = clblasSgemm( order, transA, transB, M, N, K, alpha, <const cl_mem>matA, offA, lda,
-                         <const cl_mem>matB, offB, ldb, beta, <cl_mem>matC, offC, ldc,
-                         numCommandQueues, &pcqQueue, numEventsInWaitList,
-                         pWaitList, &outEvent )
-
-   if( result != clblasSuccess ):
-      raise RuntimeError( "clBLAS sgemm call failed" )
-
-   # Create a pyopencl Event object from the event returned from clBLAS and return
-   # it to the user
-   sgemmEvent = pyopencl.Event.from_int_ptr( <intptr_t>outEvent )
-   return sgemmEvent
+def GetStatistics( ):
+   """The runtime statistics of clBLAS, as a list of dictionaries with the
+   fields of clblasStatistics"""
+   cdef size_t count = 0
+   cdef clblasStatistics *stats = NULL
+
+   _check( clblasGetStatistics( NULL, &count ), "clblasGetStatistics" )
+   while True:
+      size = count
+      free( stats )
+      stats = <clblasStatistics*>malloc( max( size, 1 ) * sizeof( clblasStatistics ) )
+      if( stats == NULL ):
+         raise MemoryError( )
+      result = clblasGetStatistics( stats, &count )
+      if( result != clblasSuccess or count <= size ):
+         break
+
+   try:
+      _check( result, "clblasGetStatistics" )
+      return [ { 'function': stats[ i ].function.decode( ),
+                 'calls': stats[ i ].calls,
+                 'kernelLaunches': stats[ i ].kernelLaunches,
+                 'kernelCacheHits': stats[ i ].kernelCacheHits,
+                 'kernelCacheMisses': stats[ i ].kernelCacheMisses,
+                 'binaryCacheHits': stats[ i ].binaryCacheHits,
+                 'binaryCacheMisses': stats[ i ].binaryCacheMisses,
+                 'programBuilds': stats[ i ].programBuilds,
+                 'buildMilliseconds': stats[ i ].buildMilliseconds,
+                 'generatorInvocations': stats[ i ].generatorInvocations,
+                 'temporaryBytes': stats[ i ].temporaryBytes,
+                 'meanEnqueueMicroseconds': stats[ i ].meanEnqueueMicroseconds }
+               for i in range( count ) ]
+   finally:
+      free( stats )
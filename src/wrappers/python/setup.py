@@ -20,6 +20,7 @@ from Cython.Distutils import build_ext
 from os import path, environ
 import argparse
 import platform
+import genpyclBLAS
 
 def main():
    parser = argparse.ArgumentParser(description='Set up the pyclBLAS extension module')
@@ -71,6 +72,12 @@ def main():
      print( "or pass the command line option --clBlasRoot" )
      exit( )
 
+   # The wrappers are generated from the header of the clBLAS installation, so
+   # that they match the library linked
+   count = genpyclBLAS.generate( path.join( clBlasRootPath, 'include', 'clBLAS.h' ),
+                                 'pyclBLAS_api.pxi' )
+   print( "pyclBLAS_api.pxi generated for %d clBLAS functions" % count )
+
    # 64bit and 32bit have different library paths
    if( platform.architecture( )[0] == '64bit' ):
      libraryPath = 'lib64'
@@ -92,7 +99,7 @@ def main():
 
    setup(
       name = 'pyclBLAS',
-      version = '0.0.1',
+      version = '0.1.0',
       author = 'Kent Knox',
       description = 'Python wrapper for clBLAS',
       license = 'Apache License, Version 2.0',